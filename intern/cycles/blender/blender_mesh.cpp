@@ -768,17 +768,16 @@ static void create_mesh(Scene *scene,
   mesh->reserve_mesh(numverts, numtris);
   mesh->reserve_subd_faces(numfaces, numngons, numcorners);
 
-  /* create vertex coordinates and normals */
-  BL::Mesh::vertices_iterator v;
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v)
-    mesh->add_vertex(get_float3(v->co()));
-
+  /* create vertex coordinates and normals, in a single pass over the vertices */
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
   float3 *N = attr_N->data_float3();
 
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N)
+  BL::Mesh::vertices_iterator v;
+  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N) {
+    mesh->add_vertex(get_float3(v->co()));
     *N = get_float3(v->normal());
+  }
   N = attr_N->data_float3();
 
   /* create generated coordinates from undeformed coordinates */
@@ -801,14 +800,26 @@ static void create_mesh(Scene *scene,
 
   /* create faces */
   if (!subdivision) {
+    /* Gather polygon settings once, instead of looking up the polygon of every triangle. */
+    const int numpolys = b_mesh.polygons.length();
+    vector<int> poly_shader(numpolys);
+    vector<bool> poly_smooth(numpolys);
+
+    BL::Mesh::polygons_iterator p;
+    int poly_index = 0;
+    for (b_mesh.polygons.begin(p); p != b_mesh.polygons.end(); ++p, ++poly_index) {
+      poly_shader[poly_index] = clamp(p->material_index(), 0, used_shaders.size() - 1);
+      poly_smooth[poly_index] = p->use_smooth() || use_loop_normals;
+    }
+
     BL::Mesh::loop_triangles_iterator t;
 
     for (b_mesh.loop_triangles.begin(t); t != b_mesh.loop_triangles.end(); ++t) {
-      BL::MeshPolygon p = b_mesh.polygons[t->polygon_index()];
+      const int t_poly_index = t->polygon_index();
       int3 vi = get_int3(t->vertices());
 
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+      int shader = poly_shader[t_poly_index];
+      bool smooth = poly_smooth[t_poly_index];
 
       if (use_loop_normals) {
         BL::Array<float, 9> loop_normals = t->split_normals();
@@ -176,6 +176,13 @@ void BlenderSession::create_session()
 
 void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsgraph)
 {
+  /* With persistent data Blender keeps the depsgraph between the frames of an animation. The
+   * synchronization state is kept then as well, so only IDs updated by the frame change are
+   * synchronized again. */
+  const bool is_same_depsgraph = (sync != NULL) &&
+                                 (this->b_depsgraph.ptr.data == b_depsgraph.ptr.data) &&
+                                 (this->b_scene.ptr.data == b_depsgraph.scene_eval().ptr.data);
+
   this->b_data = b_data;
   this->b_depsgraph = b_depsgraph;
   this->b_scene = b_depsgraph.scene_eval();
@@ -235,14 +242,21 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
    */
   session->stats.mem_peak = session->stats.mem_used;
 
+  BL::SpaceView3D b_null_space_view3d(PointerRNA_NULL);
+  BL::RegionView3D b_null_region_view3d(PointerRNA_NULL);
+
   /* There is no single depsgraph to use for the entire render.
    * See note on create_session().
    */
-  /* sync object should be re-created */
-  sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  if (is_same_depsgraph) {
+    sync->sync_recalc(b_depsgraph, b_null_space_view3d);
+  }
+  else {
+    /* sync object should be re-created */
+    delete sync;
+    sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  }
 
-  BL::SpaceView3D b_null_space_view3d(PointerRNA_NULL);
-  BL::RegionView3D b_null_region_view3d(PointerRNA_NULL);
   BufferParams buffer_params = BlenderSync::get_buffer_params(
       b_render, b_null_space_view3d, b_null_region_view3d, scene->camera, width, height);
   session->reset(buffer_params, session_params.samples);
@@ -569,6 +583,11 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       RenderStats stats;
       session->collect_statistics(&stats);
       printf("Render statistics:\n%s\n", stats.full_report().c_str());
+
+      /* Store statistics in the render result as well, so they are written to
+       * file metadata and can be gathered per frame by pipeline tools. */
+      b_rr.stamp_data_add_field(("cycles." + b_rlay_name + ".render_stats").c_str(),
+                                stats.json_report().c_str());
     }
 
     if (session->progress.get_cancel())
@@ -865,7 +884,18 @@ void BlenderSession::synchronize(BL::Depsgraph &b_depsgraph_)
   }
 
   /* try to acquire mutex. if we don't want to or can't, come back later */
-  if (!session->ready_to_reset() || !session->scene->mutex.try_lock()) {
+  if (!session->ready_to_reset()) {
+    tag_update();
+    return;
+  }
+  if (!session->scene->mutex.try_lock()) {
+    /* The scene is being updated. When this brings new changes, stop that update early so the
+     * changes can be synchronized sooner, instead of waiting for an outdated update. */
+    BL::Depsgraph::updates_iterator b_update;
+    b_depsgraph_.updates.begin(b_update);
+    if (b_update != b_depsgraph_.updates.end()) {
+      session->scene->update_interrupt = true;
+    }
     tag_update();
     return;
   }
@@ -332,6 +332,13 @@ void BlenderSync::sync_integrator()
 
   if (integrator->modified(previntegrator))
     integrator->tag_update(scene);
+
+  /* Light distribution weights depend on whether all lights are sampled. */
+  if (integrator->method != previntegrator.method ||
+      integrator->sample_all_lights_direct != previntegrator.sample_all_lights_direct ||
+      integrator->sample_all_lights_indirect != previntegrator.sample_all_lights_indirect) {
+    scene->light_manager->tag_update(scene);
+  }
 }
 
 /* Film */
@@ -583,21 +583,7 @@ void BVHEmbree::add_triangles(Object *ob, int i)
   rtcSetGeometryBuildQuality(geom_id, build_quality);
   rtcSetGeometryTimeStepCount(geom_id, num_motion_steps);
 
-  unsigned *rtc_indices = (unsigned *)rtcSetNewGeometryBuffer(
-      geom_id, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(int) * 3, num_triangles);
-  assert(rtc_indices);
-  if (!rtc_indices) {
-    VLOG(1) << "Embree could not create new geometry buffer for mesh " << mesh->name.c_str()
-            << ".\n";
-    return;
-  }
-  for (size_t j = 0; j < num_triangles; ++j) {
-    Mesh::Triangle t = mesh->get_triangle(j);
-    rtc_indices[j * 3] = t.v[0];
-    rtc_indices[j * 3 + 1] = t.v[1];
-    rtc_indices[j * 3 + 2] = t.v[2];
-  }
-
+  update_tri_index_buffer(geom_id, mesh);
   update_tri_vertex_buffer(geom_id, mesh);
 
   size_t prim_object_size = pack.prim_object.size();
@@ -626,6 +612,20 @@ void BVHEmbree::add_triangles(Object *ob, int i)
   rtcReleaseGeometry(geom_id);
 }
 
+void BVHEmbree::update_tri_index_buffer(RTCGeometry geom_id, const Mesh *mesh)
+{
+  /* Embree reads the triangle indices directly from the mesh, which needs to stay alive and
+   * unmodified for as long as the BVH is in use, so no copy of them has to be kept. */
+  rtcSetSharedGeometryBuffer(geom_id,
+                             RTC_BUFFER_TYPE_INDEX,
+                             0,
+                             RTC_FORMAT_UINT3,
+                             &mesh->triangles[0],
+                             0,
+                             sizeof(int) * 3,
+                             mesh->num_triangles());
+}
+
 void BVHEmbree::update_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh)
 {
   const Attribute *attr_mP = NULL;
@@ -654,17 +654,17 @@ void BVHEmbree::update_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh)
       verts = &attr_mP->data_float3()[t_ * num_verts];
     }
 
-    float *rtc_verts = (float *)rtcSetNewGeometryBuffer(
-        geom_id, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT3, sizeof(float) * 3, num_verts + 1);
-    assert(rtc_verts);
-    if (rtc_verts) {
-      for (size_t j = 0; j < num_verts; ++j) {
-        rtc_verts[0] = verts[j].x;
-        rtc_verts[1] = verts[j].y;
-        rtc_verts[2] = verts[j].z;
-        rtc_verts += 3;
-      }
-    }
+    /* Share the vertex positions with Embree rather than copying them. Cycles float3 is padded
+     * to 16 bytes, which also satisfies the Embree requirement of the last vertex being readable
+     * with a 16 byte load. */
+    rtcSetSharedGeometryBuffer(geom_id,
+                               RTC_BUFFER_TYPE_VERTEX,
+                               t,
+                               RTC_FORMAT_FLOAT3,
+                               verts,
+                               0,
+                               sizeof(float3),
+                               num_verts);
   }
 }
 
@@ -947,18 +947,24 @@ void BVHEmbree::pack_nodes(const BVHNode *)
 
 void BVHEmbree::refit_nodes()
 {
-  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
+  /* Update all vertex buffers, then tell Embree to refit the BVHs. Topology is unchanged
+   * when refitting, so there is no need for Embree to rebuild the geometry BVHs from scratch. */
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
     if (!params.top_level || (ob->is_traceable() && !ob->mesh->is_instanced())) {
       if (params.primitive_mask & PRIMITIVE_ALL_TRIANGLE && ob->mesh->num_triangles() > 0) {
-        update_tri_vertex_buffer(rtcGetGeometry(scene, geom_id), ob->mesh);
-        rtcCommitGeometry(rtcGetGeometry(scene, geom_id));
+        RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+        update_tri_index_buffer(geom, ob->mesh);
+        update_tri_vertex_buffer(geom, ob->mesh);
+        rtcSetGeometryBuildQuality(geom, RTC_BUILD_QUALITY_REFIT);
+        rtcCommitGeometry(geom);
       }
 
       if (params.primitive_mask & PRIMITIVE_ALL_CURVE && ob->mesh->num_curves() > 0) {
-        update_curve_vertex_buffer(rtcGetGeometry(scene, geom_id + 1), ob->mesh);
-        rtcCommitGeometry(rtcGetGeometry(scene, geom_id + 1));
+        RTCGeometry geom = rtcGetGeometry(scene, geom_id + 1);
+        update_curve_vertex_buffer(geom, ob->mesh);
+        rtcSetGeometryBuildQuality(geom, RTC_BUILD_QUALITY_REFIT);
+        rtcCommitGeometry(geom);
       }
     }
     geom_id += 2;
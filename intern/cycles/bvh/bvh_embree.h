@@ -68,6 +68,7 @@ class BVHEmbree : public BVH {
 
  private:
   void delete_rtcScene();
+  void update_tri_index_buffer(RTCGeometry geom_id, const Mesh *mesh);
   void update_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh);
   void update_curve_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh);
 
@@ -113,7 +113,9 @@ class BVHParams {
     min_leaf_size = 1;
     max_triangle_leaf_size = 8;
     max_motion_triangle_leaf_size = 8;
-    max_curve_leaf_size = 1;
+    /* Allow a few curve segments per leaf, the SAH still decides whether a leaf is cheaper
+     * than splitting. One segment per leaf doubles the node count for dense hair. */
+    max_curve_leaf_size = 4;
     max_motion_curve_leaf_size = 4;
 
     top_level = false;
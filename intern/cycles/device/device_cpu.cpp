@@ -1198,7 +1198,9 @@ int2 CPUSplitKernel::split_kernel_global_size(device_memory & /*kg*/,
                                               device_memory & /*data*/,
                                               DeviceTask * /*task*/)
 {
-  return make_int2(1, 1);
+  /* Keep enough paths in flight for sorting by shader to give coherent shading batches,
+   * while keeping the per thread path state small enough to stay in cache. */
+  return make_int2(32, 32);
 }
 
 uint64_t CPUSplitKernel::state_buffer_size(device_memory &kernel_globals,
@@ -477,7 +477,7 @@ class CUDADevice : public Device {
 
     const string cubin_file = string_printf(
         "cycles_%s_sm%d%d_%s.cubin", name, major, minor, cubin_md5.c_str());
-    const string cubin = path_cache_get(path_join("kernels", cubin_file));
+    const string cubin = path_kernel_cache_get(cubin_file);
     VLOG(1) << "Testing for locally compiled kernel " << cubin << ".";
     if (path_exists(cubin)) {
       VLOG(1) << "Using locally compiled kernel.";
@@ -516,6 +516,10 @@ class CUDADevice : public Device {
 
     path_create_directories(cubin);
 
+    /* Compile to a temporary file which is moved in place when done, so other processes sharing
+     * the kernel cache never load a partially written cubin. */
+    const string cubin_temp = path_temporary_get(cubin);
+
     string command = string_printf(
         "\"%s\" "
         "-arch=sm_%d%d "
@@ -526,7 +530,7 @@ class CUDADevice : public Device {
         major,
         minor,
         kernel.c_str(),
-        cubin.c_str(),
+        cubin_temp.c_str(),
         common_cflags.c_str());
 
     printf("%s\n", command.c_str());
@@ -539,7 +543,8 @@ class CUDADevice : public Device {
     }
 
     /* Verify if compilation succeeded */
-    if (!path_exists(cubin)) {
+    if (!path_exists(cubin_temp) || !path_rename(cubin_temp, cubin)) {
+      path_remove(cubin_temp);
       cuda_error_message(
           "CUDA kernel compilation failed, "
           "see console for details.");
@@ -562,7 +562,7 @@ bool OpenCLDevice::OpenCLProgram::load()
 
     string basename = "cycles_kernel_" + program_name + "_" + device_md5 + "_" +
                       util_md5_string(source);
-    basename = path_cache_get(path_join("kernels", basename));
+    basename = path_kernel_cache_get(basename);
     string clbin = basename + ".clbin";
 
     /* If binary kernel exists already, try use it. */
@@ -608,7 +608,7 @@ void OpenCLDevice::OpenCLProgram::compile()
 
     string basename = "cycles_kernel_" + program_name + "_" + device_md5 + "_" +
                       util_md5_string(source);
-    basename = path_cache_get(path_join("kernels", basename));
+    basename = path_kernel_cache_get(basename);
     string clbin = basename + ".clbin";
 
     /* path to preprocessed source for debugging */
@@ -783,7 +783,7 @@ ccl_device bool lamp_light_eval(
     return false;
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= kernel_data.integrator.pdf_lights * klight->distribution_weight;
 
   return true;
 }
@@ -1137,6 +1137,17 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
     }
 
     lamp = -prim - 1;
+
+    if (UNLIKELY(light_select_reached_max_bounces(kg, lamp, bounce))) {
+      return false;
+    }
+
+    /* Lamps are picked from the distribution in proportion to their weight. */
+    if (!lamp_light_sample(kg, lamp, randu, randv, P, ls)) {
+      return false;
+    }
+    ls->pdf *= kernel_tex_fetch(__lights, lamp).distribution_weight;
+    return (ls->pdf > 0.0f);
   }
 
   if (UNLIKELY(light_select_reached_max_bounces(kg, lamp, bounce))) {
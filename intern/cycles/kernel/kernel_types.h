@@ -1507,7 +1507,7 @@ typedef struct KernelLight {
   float max_bounces;
   float random;
   float strength[3];
-  float pad1;
+  float distribution_weight;
   Transform tfm;
   Transform itfm;
   union {
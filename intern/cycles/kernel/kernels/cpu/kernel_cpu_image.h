@@ -236,12 +236,18 @@ template<typename T> struct TextureInterpolator {
 #undef DATA
   }
 
-  static ccl_always_inline float4 interp(const TextureInfo &info, float x, float y)
+  static ccl_always_inline float4 interp(const TextureInfo &info,
+                                         float x,
+                                         float y,
+                                         InterpolationType interp)
   {
     if (UNLIKELY(!info.data)) {
       return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
-    switch (info.interpolation) {
+    /* Closest interpolation is chosen for the look, never override it. */
+    const bool use_override = (interp != INTERPOLATION_NONE &&
+                               info.interpolation != INTERPOLATION_CLOSEST);
+    switch (use_override ? interp : info.interpolation) {
       case INTERPOLATION_CLOSEST:
         return interp_closest(info, x, y);
       case INTERPOLATION_LINEAR:
@@ -470,27 +476,28 @@ template<typename T> struct TextureInterpolator {
 #undef SET_CUBIC_SPLINE_WEIGHTS
 };
 
-ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, float y)
+ccl_device float4
+kernel_tex_image_interp(KernelGlobals *kg, int id, float x, float y, InterpolationType interp)
 {
   const TextureInfo &info = kernel_tex_fetch(__texture_info, id);
 
   switch (kernel_tex_type(id)) {
     case IMAGE_DATA_TYPE_HALF:
-      return TextureInterpolator<half>::interp(info, x, y);
+      return TextureInterpolator<half>::interp(info, x, y, interp);
     case IMAGE_DATA_TYPE_BYTE:
-      return TextureInterpolator<uchar>::interp(info, x, y);
+      return TextureInterpolator<uchar>::interp(info, x, y, interp);
     case IMAGE_DATA_TYPE_USHORT:
-      return TextureInterpolator<uint16_t>::interp(info, x, y);
+      return TextureInterpolator<uint16_t>::interp(info, x, y, interp);
     case IMAGE_DATA_TYPE_FLOAT:
-      return TextureInterpolator<float>::interp(info, x, y);
+      return TextureInterpolator<float>::interp(info, x, y, interp);
     case IMAGE_DATA_TYPE_HALF4:
-      return TextureInterpolator<half4>::interp(info, x, y);
+      return TextureInterpolator<half4>::interp(info, x, y, interp);
     case IMAGE_DATA_TYPE_BYTE4:
-      return TextureInterpolator<uchar4>::interp(info, x, y);
+      return TextureInterpolator<uchar4>::interp(info, x, y, interp);
     case IMAGE_DATA_TYPE_USHORT4:
-      return TextureInterpolator<ushort4>::interp(info, x, y);
+      return TextureInterpolator<ushort4>::interp(info, x, y, interp);
     case IMAGE_DATA_TYPE_FLOAT4:
-      return TextureInterpolator<float4>::interp(info, x, y);
+      return TextureInterpolator<float4>::interp(info, x, y, interp);
     default:
       assert(0);
       return make_float4(
@@ -118,16 +118,20 @@ ccl_device T kernel_tex_image_interp_bicubic_3d(
                 g1y * (g0x * tex3D<T>(tex, x0, y1, z1) + g1x * tex3D<T>(tex, x1, y1, z1)));
 }
 
-ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, float y)
+ccl_device float4
+kernel_tex_image_interp(KernelGlobals *kg, int id, float x, float y, InterpolationType interp)
 {
   const TextureInfo &info = kernel_tex_fetch(__texture_info, id);
   CUtexObject tex = (CUtexObject)info.data;
+  /* Closest and linear filtering is done by the texture unit, only cubic can be dropped. */
+  const bool use_cubic = (info.interpolation == INTERPOLATION_CUBIC &&
+                          (interp == INTERPOLATION_NONE || interp == INTERPOLATION_CUBIC));
 
   /* float4, byte4, ushort4 and half4 */
   const int texture_type = kernel_tex_type(id);
   if (texture_type == IMAGE_DATA_TYPE_FLOAT4 || texture_type == IMAGE_DATA_TYPE_BYTE4 ||
       texture_type == IMAGE_DATA_TYPE_HALF4 || texture_type == IMAGE_DATA_TYPE_USHORT4) {
-    if (info.interpolation == INTERPOLATION_CUBIC) {
+    if (use_cubic) {
       return kernel_tex_image_interp_bicubic<float4>(info, tex, x, y);
     }
     else {
@@ -138,7 +142,7 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, fl
   else {
     float f;
 
-    if (info.interpolation == INTERPOLATION_CUBIC) {
+    if (use_cubic) {
       f = kernel_tex_image_interp_bicubic<float>(info, tex, x, y);
     }
     else {
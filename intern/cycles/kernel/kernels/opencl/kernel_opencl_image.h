@@ -149,7 +149,8 @@ ccl_device_inline float svm_image_texture_frac(float x, int *ix)
   } \
   (void)0
 
-ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, float y)
+ccl_device float4
+kernel_tex_image_interp(KernelGlobals *kg, int id, float x, float y, int interp)
 {
   const ccl_global TextureInfo *info = kernel_tex_info(kg, id);
 
@@ -159,7 +160,13 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, fl
     }
   }
 
-  if (info->interpolation == INTERPOLATION_CLOSEST) {
+  /* Closest interpolation is chosen for the look, never override it. */
+  uint interpolation = (interp == INTERPOLATION_NONE ||
+                        info->interpolation == INTERPOLATION_CLOSEST) ?
+                           info->interpolation :
+                           interp;
+
+  if (interpolation == INTERPOLATION_CLOSEST) {
     /* Closest interpolation. */
     int ix, iy;
     svm_image_texture_frac(x * info->width, &ix);
@@ -167,7 +174,7 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, fl
 
     return svm_image_texture_read_2d(kg, id, ix, iy);
   }
-  else if (info->interpolation == INTERPOLATION_LINEAR) {
+  else if (interpolation == INTERPOLATION_LINEAR) {
     /* Bilinear interpolation. */
     int ix, iy;
     float tx = svm_image_texture_frac(x * info->width - 0.5f, &ix);
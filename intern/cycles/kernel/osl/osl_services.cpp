@@ -1111,7 +1111,8 @@ bool OSLRenderServices::texture(ustring filename,
     }
     case OSLTextureHandle::SVM: {
       /* Packed texture. */
-      float4 rgba = kernel_tex_image_interp(kernel_globals, handle->svm_slot, s, 1.0f - t);
+      float4 rgba = kernel_tex_image_interp(
+          kernel_globals, handle->svm_slot, s, 1.0f - t, INTERPOLATION_NONE);
 
       result[0] = rgba[0];
       if (nchannels > 1)
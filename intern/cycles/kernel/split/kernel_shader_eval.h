@@ -23,22 +23,13 @@ ccl_device void kernel_shader_eval(KernelGlobals *kg)
 {
 
   int ray_index = ccl_global_id(1) * ccl_global_size(0) + ccl_global_id(0);
-  /* Sorting on cuda split is not implemented */
-#ifdef __KERNEL_CUDA__
-  int queue_index = kernel_split_params.queue_index[QUEUE_ACTIVE_AND_REGENERATED_RAYS];
-#else
   int queue_index = kernel_split_params.queue_index[QUEUE_SHADER_SORTED_RAYS];
-#endif
   if (ray_index >= queue_index) {
     return;
   }
   ray_index = get_ray_index(kg,
                             ray_index,
-#ifdef __KERNEL_CUDA__
-                            QUEUE_ACTIVE_AND_REGENERATED_RAYS,
-#else
                             QUEUE_SHADER_SORTED_RAYS,
-#endif
                             kernel_split_state.queue_data,
                             kernel_split_params.queue_size,
                             0);
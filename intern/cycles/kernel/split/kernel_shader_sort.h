@@ -16,9 +16,53 @@
 
 CCL_NAMESPACE_BEGIN
 
+#ifdef __KERNEL_CPU__
+/* The CPU runs a single work item per block, so sort the whole block at once with an in-place
+ * heap sort. Ties are broken by index to keep the order deterministic. */
+ccl_device_inline bool shader_sort_index_less(const uint *local_value, ushort a, ushort b)
+{
+  return (local_value[a] < local_value[b]) || (local_value[a] == local_value[b] && a < b);
+}
+
+ccl_device_inline void shader_sort_sift_down(const uint *local_value,
+                                             ushort *local_index,
+                                             uint root,
+                                             uint num)
+{
+  while (2 * root + 1 < num) {
+    uint child = 2 * root + 1;
+    if (child + 1 < num &&
+        shader_sort_index_less(local_value, local_index[child], local_index[child + 1])) {
+      child++;
+    }
+    if (!shader_sort_index_less(local_value, local_index[root], local_index[child])) {
+      return;
+    }
+    ushort tmp = local_index[root];
+    local_index[root] = local_index[child];
+    local_index[child] = tmp;
+    root = child;
+  }
+}
+
+ccl_device_inline void shader_sort_local_indices(const uint *local_value,
+                                                 ushort *local_index,
+                                                 uint num)
+{
+  for (uint i = num / 2; i > 0; i--) {
+    shader_sort_sift_down(local_value, local_index, i - 1, num);
+  }
+  for (uint end = num; end > 1; end--) {
+    ushort tmp = local_index[0];
+    local_index[0] = local_index[end - 1];
+    local_index[end - 1] = tmp;
+    shader_sort_sift_down(local_value, local_index, 0, end - 1);
+  }
+}
+#endif /* __KERNEL_CPU__ */
+
 ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSortLocals *locals)
 {
-#ifndef __KERNEL_CUDA__
   int tid = ccl_global_id(1) * ccl_global_size(0) + ccl_global_id(0);
   uint qsize = kernel_split_params.queue_index[QUEUE_ACTIVE_AND_REGENERATED_RAYS];
   if (tid == 0) {
@@ -54,9 +98,7 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
   }
   ccl_barrier(CCL_LOCAL_MEM_FENCE);
 
-  /* skip sorting for cpu split kernel */
-#  ifdef __KERNEL_OPENCL__
-
+#ifndef __KERNEL_CPU__
   /* bitonic sort */
   for (uint length = 1; length < SHADER_SORT_BLOCK_SIZE; length <<= 1) {
     for (uint inc = length; inc > 0; inc >>= 1) {
@@ -77,7 +119,11 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
       }
     }
   }
-#  endif /* __KERNEL_OPENCL__ */
+#else
+  /* Entries past the queue size are never written out, no need to sort them. */
+  shader_sort_local_indices(
+      local_value, local_index, min((uint)SHADER_SORT_BLOCK_SIZE, qsize - offset));
+#endif /* __KERNEL_CPU__ */
 
   /* copy to destination */
   for (uint i = 0; i < SHADER_SORT_BLOCK_SIZE; i += SHADER_SORT_LOCAL_SIZE) {
@@ -91,7 +137,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
                                                               kernel_split_state.queue_data[ini];
     }
   }
-#endif /* __KERNEL_CUDA__ */
 }
 
 CCL_NAMESPACE_END
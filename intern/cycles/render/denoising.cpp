@@ -21,6 +21,7 @@
 #include "util/util_foreach.h"
 #include "util/util_map.h"
 #include "util/util_system.h"
+#include "util/util_thread.h"
 #include "util/util_time.h"
 
 #include <OpenImageIO/filesystem.h>
@@ -564,6 +565,10 @@ bool DenoiseTask::exec()
     printf("\n");
   }
 
+  /* Device memory is no longer needed for saving, free it here since saving may happen from
+   * another thread. */
+  input_pixels.free();
+
   return true;
 }
 
@@ -879,12 +884,46 @@ Denoiser::~Denoiser()
   TaskScheduler::exit();
 }
 
+static void denoise_task_save(DenoiseTask *task, bool *r_ok)
+{
+  *r_ok = task->save();
+}
+
+/* Wait for the frame being saved in the background to finish, and free it. */
+static bool denoise_task_save_wait(DenoiseTask *&task,
+                                   thread *&save_thread,
+                                   const bool &save_ok,
+                                   string &error)
+{
+  if (save_thread == NULL) {
+    return true;
+  }
+  save_thread->join();
+  delete save_thread;
+  save_thread = NULL;
+
+  const bool ok = save_ok;
+  if (!ok) {
+    error = task->error;
+  }
+  delete task;
+  task = NULL;
+  return ok;
+}
+
 bool Denoiser::run()
 {
   assert(input.size() == output.size());
 
   num_frames = output.size();
 
+  /* Denoised frames are saved in a separate thread, so writing one frame overlaps with loading
+   * and denoising the next one. */
+  DenoiseTask *save_task = NULL;
+  thread *save_thread = NULL;
+  bool save_ok = true;
+  int save_frame = -1;
+
   for (int frame = 0; frame < num_frames; frame++) {
     /* Skip empty output paths. */
     if (output[frame].empty()) {
@@ -899,27 +938,37 @@ bool Denoiser::run()
       }
     }
 
-    /* Execute task. */
-    DenoiseTask task(device, this, frame, neighbor_frames);
-    if (!task.load()) {
-      error = task.error;
-      return false;
+    /* When denoising in place, the frame being saved may be read as input of this frame. Wait
+     * for it to be written first, so the result is the same as without overlapping. */
+    if (save_thread) {
+      bool reads_saved_frame = (input[frame] == output[save_frame]);
+      foreach (int neighbor_frame, neighbor_frames) {
+        reads_saved_frame |= (input[neighbor_frame] == output[save_frame]);
+      }
+      if (reads_saved_frame && !denoise_task_save_wait(save_task, save_thread, save_ok, error)) {
+        return false;
+      }
     }
 
-    if (!task.exec()) {
-      error = task.error;
-      return false;
+    /* Execute task. */
+    DenoiseTask *task = new DenoiseTask(device, this, frame, neighbor_frames);
+    const bool ok = task->load() && task->exec();
+    if (!ok) {
+      error = task->error;
     }
 
-    if (!task.save()) {
-      error = task.error;
+    /* Wait for the previous frame, only one frame is kept in memory for saving. */
+    if (!denoise_task_save_wait(save_task, save_thread, save_ok, error) || !ok) {
+      delete task;
       return false;
     }
 
-    task.free();
+    save_task = task;
+    save_frame = frame;
+    save_thread = new thread(function_bind(&denoise_task_save, save_task, &save_ok));
   }
 
-  return true;
+  return denoise_task_save_wait(save_task, save_thread, save_ok, error);
 }
 
 CCL_NAMESPACE_END
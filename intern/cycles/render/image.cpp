@@ -564,6 +564,25 @@ bool ImageManager::file_load_image(Image *img,
   int depth = img->metadata.depth;
   int components = img->metadata.channels;
 
+  /* For files with MIP levels, such as tiled .tx files, read the first level which fits in the
+   * texture limit directly instead of loading the full resolution image and scaling it down. */
+  if (in && texture_limit > 0 && depth <= 1 && max(width, height) > texture_limit) {
+    ImageSpec mip_spec;
+    int miplevel = 0;
+    while (max(width, height) > texture_limit && in->seek_subimage(0, miplevel + 1, mip_spec)) {
+      miplevel++;
+      width = mip_spec.width;
+      height = mip_spec.height;
+    }
+    if (miplevel > 0) {
+      /* Make sure a failed seek past the last level did not change the current level. */
+      if (!in->seek_subimage(0, miplevel, mip_spec)) {
+        return false;
+      }
+      VLOG(1) << "Reading MIP level " << miplevel << " of image " << img->filename << ".";
+    }
+  }
+
   /* Read pixels. */
   vector<StorageType> pixels_storage;
   StorageType *pixels;
@@ -231,6 +231,59 @@ void LightManager::disable_ineffective_light(Scene *scene)
   }
 }
 
+/* Relative probability of picking each enabled light from the light distribution, with an
+ * average of one. Point, spot and area lights are picked in proportion to their power, other
+ * lights have units which can't be compared and keep a weight of one. Sampling all lights in the
+ * branched path integrator assumes every light is picked with the same probability. */
+static void light_distribution_weights(Scene *scene, vector<float> &weights)
+{
+  weights.clear();
+
+  size_t num_local_lights = 0;
+  float total_power = 0.0f;
+
+  foreach (Light *light, scene->lights) {
+    if (!light->is_enabled) {
+      continue;
+    }
+    /* Negative power marks lights which are not weighted. */
+    float power = -1.0f;
+    if (light->type == LIGHT_POINT || light->type == LIGHT_SPOT || light->type == LIGHT_AREA) {
+      power = average(fabs(light->strength));
+      total_power += power;
+      num_local_lights++;
+    }
+    weights.push_back(power);
+  }
+
+  const Integrator *integrator = scene->integrator;
+  const bool sample_all_lights = (integrator->method == Integrator::BRANCHED_PATH) &&
+                                 (integrator->sample_all_lights_direct ||
+                                  integrator->sample_all_lights_indirect);
+
+  if (sample_all_lights || num_local_lights < 2 || !(total_power > 0.0f)) {
+    foreach (float &weight, weights) {
+      weight = 1.0f;
+    }
+    return;
+  }
+
+  /* Keep a minimum probability, the emission of lights may also be driven by their shader. */
+  const float min_power = 0.01f * total_power / num_local_lights;
+  float clamped_total_power = 0.0f;
+  foreach (float &power, weights) {
+    if (power >= 0.0f) {
+      power = max(power, min_power);
+      clamped_total_power += power;
+    }
+  }
+
+  const float scale = num_local_lights / clamped_total_power;
+  foreach (float &power, weights) {
+    power = (power >= 0.0f) ? power * scale : 1.0f;
+  }
+}
+
 bool LightManager::object_usable_as_light(Object *object)
 {
   Mesh *mesh = object->mesh;
@@ -385,6 +438,9 @@ void LightManager::device_update_distribution(Device *,
   float lightarea = (totarea > 0.0f) ? totarea / num_lights : 1.0f;
   bool use_lamp_mis = false;
 
+  vector<float> light_weights;
+  light_distribution_weights(scene, light_weights);
+
   int light_index = 0;
   foreach (Light *light, scene->lights) {
     if (!light->is_enabled)
@@ -394,7 +450,7 @@ void LightManager::device_update_distribution(Device *,
     distribution[offset].prim = ~light_index;
     distribution[offset].lamp.pad = 1.0f;
     distribution[offset].lamp.size = light->size;
-    totarea += lightarea;
+    totarea += lightarea * light_weights[light_index];
 
     if (light->type == LIGHT_DISTANT) {
       use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
@@ -673,6 +729,9 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
     return;
   }
 
+  vector<float> light_weights;
+  light_distribution_weights(scene, light_weights);
+
   int light_index = 0;
 
   foreach (Light *light, scene->lights) {
@@ -711,6 +770,7 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
     klights[light_index].strength[0] = light->strength.x;
     klights[light_index].strength[1] = light->strength.y;
     klights[light_index].strength[2] = light->strength.z;
+    klights[light_index].distribution_weight = light_weights[light_index];
 
     if (light->type == LIGHT_POINT) {
       shader_id &= ~SHADER_AREA_LIGHT;
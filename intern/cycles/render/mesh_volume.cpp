@@ -451,18 +451,25 @@ void MeshManager::create_volume_mesh(Scene *scene, Mesh *mesh, Progress &progres
     for (int y = 0; y < resolution.y; ++y) {
       for (int x = 0; x < resolution.x; ++x) {
         size_t voxel_index = compute_voxel_index(resolution, x, y, z);
+        bool is_active = false;
 
-        for (size_t i = 0; i < voxel_grids.size(); ++i) {
+        /* Stop at the first grid channel above the isovalue, the voxel is active regardless of
+         * the other grids. */
+        for (size_t i = 0; i < voxel_grids.size() && !is_active; ++i) {
           const VoxelAttributeGrid &voxel_grid = voxel_grids[i];
           const int channels = voxel_grid.channels;
 
           for (int c = 0; c < channels; c++) {
             if (voxel_grid.data[voxel_index * channels + c] >= isovalue) {
-              builder.add_node_with_padding(x, y, z);
+              is_active = true;
               break;
             }
           }
         }
+
+        if (is_active) {
+          builder.add_node_with_padding(x, y, z);
+        }
       }
     }
   }
@@ -22,6 +22,7 @@
 #include "render/object.h"
 #include "render/particles.h"
 #include "render/scene.h"
+#include "render/shader.h"
 
 #include "util/util_foreach.h"
 #include "util/util_logging.h"
@@ -45,6 +46,9 @@ struct UpdateObjectTransformState {
   /* Type of the motion required by the scene settings. */
   Scene::MotionType need_motion;
 
+  /* Object surface area is only used by OSL shaders. */
+  bool need_surface_area;
+
   /* Mapping from particle system to a index in packed particle array.
    * Only used for read.
    */
@@ -379,48 +383,52 @@ void ObjectManager::device_update_object_transform(UpdateObjectTransformState *s
                            ob->particle_index + state->particle_offset[ob->particle_system] :
                            0;
 
-  if (transform_uniform_scale(tfm, uniform_scale)) {
-    map<Mesh *, float>::iterator it;
+  /* Surface area is only used by OSL. Computing it for non-uniformly scaled instances loops over
+   * all triangles of the mesh for every instance, so skip it when nothing reads it. */
+  if (state->need_surface_area) {
+    if (transform_uniform_scale(tfm, uniform_scale)) {
+      map<Mesh *, float>::iterator it;
 
-    /* NOTE: This isn't fully optimal and could in theory lead to multiple
-     * threads calculating area of the same mesh in parallel. However, this
-     * also prevents suspending all the threads when some mesh's area is
-     * not yet known.
-     */
-    state->surface_area_lock.lock();
-    it = state->surface_area_map.find(mesh);
-    state->surface_area_lock.unlock();
+      /* NOTE: This isn't fully optimal and could in theory lead to multiple
+       * threads calculating area of the same mesh in parallel. However, this
+       * also prevents suspending all the threads when some mesh's area is
+       * not yet known.
+       */
+      state->surface_area_lock.lock();
+      it = state->surface_area_map.find(mesh);
+      state->surface_area_lock.unlock();
 
-    if (it == state->surface_area_map.end()) {
-      size_t num_triangles = mesh->num_triangles();
-      for (size_t j = 0; j < num_triangles; j++) {
-        Mesh::Triangle t = mesh->get_triangle(j);
-        float3 p1 = mesh->verts[t.v[0]];
-        float3 p2 = mesh->verts[t.v[1]];
-        float3 p3 = mesh->verts[t.v[2]];
+      if (it == state->surface_area_map.end()) {
+        size_t num_triangles = mesh->num_triangles();
+        for (size_t j = 0; j < num_triangles; j++) {
+          Mesh::Triangle t = mesh->get_triangle(j);
+          float3 p1 = mesh->verts[t.v[0]];
+          float3 p2 = mesh->verts[t.v[1]];
+          float3 p3 = mesh->verts[t.v[2]];
 
-        surface_area += triangle_area(p1, p2, p3);
+          surface_area += triangle_area(p1, p2, p3);
+        }
+
+        state->surface_area_lock.lock();
+        state->surface_area_map[mesh] = surface_area;
+        state->surface_area_lock.unlock();
+      }
+      else {
+        surface_area = it->second;
       }
 
-      state->surface_area_lock.lock();
-      state->surface_area_map[mesh] = surface_area;
-      state->surface_area_lock.unlock();
+      surface_area *= uniform_scale;
     }
     else {
-      surface_area = it->second;
-    }
-
-    surface_area *= uniform_scale;
-  }
-  else {
-    size_t num_triangles = mesh->num_triangles();
-    for (size_t j = 0; j < num_triangles; j++) {
-      Mesh::Triangle t = mesh->get_triangle(j);
-      float3 p1 = transform_point(&tfm, mesh->verts[t.v[0]]);
-      float3 p2 = transform_point(&tfm, mesh->verts[t.v[1]]);
-      float3 p3 = transform_point(&tfm, mesh->verts[t.v[2]]);
+      size_t num_triangles = mesh->num_triangles();
+      for (size_t j = 0; j < num_triangles; j++) {
+        Mesh::Triangle t = mesh->get_triangle(j);
+        float3 p1 = transform_point(&tfm, mesh->verts[t.v[0]]);
+        float3 p2 = transform_point(&tfm, mesh->verts[t.v[1]]);
+        float3 p3 = transform_point(&tfm, mesh->verts[t.v[2]]);
 
-      surface_area += triangle_area(p1, p2, p3);
+        surface_area += triangle_area(p1, p2, p3);
+      }
     }
   }
 
@@ -549,6 +557,7 @@ void ObjectManager::device_update_transforms(DeviceScene *dscene, Scene *scene,
 {
   UpdateObjectTransformState state;
   state.need_motion = scene->need_motion();
+  state.need_surface_area = scene->shader_manager->use_osl();
   state.have_motion = false;
   state.have_curves = false;
   state.scene = scene;
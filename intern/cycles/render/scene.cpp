@@ -88,6 +88,9 @@ Scene::Scene(const SceneParams &params_, Device *device)
 {
   memset((void *)&dscene.data, 0, sizeof(dscene.data));
 
+  update_interrupt = false;
+  update_incomplete = false;
+
   camera = new Camera();
   dicing_camera = new Camera();
   lookup_tables = new LookupTables();
@@ -182,6 +185,10 @@ void Scene::device_update(Device *device_, Progress &progress)
 
   bool print_stats = need_data_update();
 
+  /* Cleared only when all stages ran, so an interrupted update is continued next time, including
+   * writing the constant memory. */
+  update_incomplete = true;
+
   /* The order of updates is important, because there's dependencies between
    * the different managers, using data computed by previous managers.
    *
@@ -196,96 +203,96 @@ void Scene::device_update(Device *device_, Progress &progress)
   progress.set_status("Updating Shaders");
   shader_manager->device_update(device, &dscene, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Background");
   background->device_update(device, &dscene, this);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Camera");
   camera->device_update(device, &dscene, this);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   mesh_manager->device_update_preprocess(device, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Objects");
   object_manager->device_update(device, &dscene, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Hair Systems");
   curve_system_manager->device_update(device, &dscene, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Particle Systems");
   particle_system_manager->device_update(device, &dscene, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Meshes");
   mesh_manager->device_update(device, &dscene, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Objects Flags");
   object_manager->device_update_flags(device, &dscene, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Images");
   image_manager->device_update(device, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Camera Volume");
   camera->device_update_volume(device, &dscene, this);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Lookup Tables");
   lookup_tables->device_update(device, &dscene);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Lights");
   light_manager->device_update(device, &dscene, this, progress);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Integrator");
   integrator->device_update(device, &dscene, this);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Film");
   film->device_update(device, &dscene, this);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Lookup Tables");
   lookup_tables->device_update(device, &dscene);
 
-  if (progress.get_cancel() || device->have_error())
+  if (progress.get_cancel() || device->have_error() || update_interrupt)
     return;
 
   progress.set_status("Updating Baking");
@@ -297,6 +304,7 @@ void Scene::device_update(Device *device_, Progress &progress)
   if (device->have_error() == false) {
     progress.set_status("Updating Device", "Writing constant memory");
     device->const_copy_to("__data", &dscene.data, sizeof(dscene.data));
+    update_incomplete = false;
   }
 
   if (print_stats) {
@@ -350,7 +358,7 @@ void Scene::need_global_attributes(AttributeRequestSet &attributes)
 
 bool Scene::need_update()
 {
-  return (need_reset() || film->need_update);
+  return (need_reset() || film->need_update || update_incomplete);
 }
 
 bool Scene::need_data_update()
@@ -244,6 +244,11 @@ class Scene {
   /* mutex must be locked manually by callers */
   thread_mutex mutex;
 
+  /* Set from another thread to stop an in-progress device update at the next stage, when new
+   * changes are waiting to be synchronized. Managers which were not updated yet stay tagged, so
+   * the next update continues where this one stopped. */
+  volatile bool update_interrupt;
+
   Scene(const SceneParams &params, Device *device);
   ~Scene();
 
@@ -271,6 +276,9 @@ class Scene {
   bool need_data_update();
 
   void free_memory(bool final);
+
+  /* The last device update stopped before all data was written to the device. */
+  bool update_incomplete;
 };
 
 CCL_NAMESPACE_END
@@ -78,6 +78,15 @@ Session::Session(const SessionParams &params_)
   reset_time = 0.0;
   last_update_time = 0.0;
 
+  num_gpu_devices = 0;
+  foreach (const DeviceInfo &info, params.device.multi_devices) {
+    if (info.type != DEVICE_CPU) {
+      num_gpu_devices++;
+    }
+  }
+  tile_time_sum[0] = tile_time_sum[1] = 0.0;
+  tile_time_num[0] = tile_time_num[1] = 0;
+
   delayed_reset.do_reset = false;
   delayed_reset.samples = 0;
 
@@ -285,6 +294,13 @@ void Session::run_gpu()
 
       if (progress.get_cancel())
         break;
+
+      /* Don't render the partially updated scene, keep the previous result on display until the
+       * new changes are synchronized. */
+      if (scene->update_interrupt) {
+        reset(tile_manager.params, params.samples);
+        continue;
+      }
     }
 
     if (!no_tiles) {
@@ -374,6 +390,27 @@ bool Session::draw_cpu(BufferParams &buffer_params, DeviceDrawParams &draw_param
   return false;
 }
 
+bool Session::leave_tiles_to_gpu()
+{
+  /* Only balance once both device types rendered tiles, so their throughput is known. */
+  if (num_gpu_devices == 0 || tile_time_num[0] == 0 || tile_time_num[1] == 0) {
+    return false;
+  }
+  /* Tiles are bound to devices, nothing to balance. */
+  if (tile_manager.state.render_tiles.size() != 1 ||
+      !tile_manager.state.denoising_tiles[0].empty()) {
+    return false;
+  }
+
+  /* A CPU thread is much slower per tile than a GPU. Once the GPUs would finish all remaining
+   * tiles before a CPU thread finishes a single one, taking another tile on the CPU would only
+   * delay the end of the render. */
+  const double cpu_tile_time = tile_time_sum[0] / tile_time_num[0];
+  const double gpu_tile_time = tile_time_sum[1] / tile_time_num[1];
+  const size_t num_tiles = tile_manager.state.render_tiles[0].size();
+  return num_tiles * gpu_tile_time < cpu_tile_time * num_gpu_devices;
+}
+
 bool Session::acquire_tile(Device *tile_device, RenderTile &rtile)
 {
   if (progress.get_cancel()) {
@@ -388,10 +425,17 @@ bool Session::acquire_tile(Device *tile_device, RenderTile &rtile)
   /* get next tile from manager */
   Tile *tile;
   int device_num = device->device_number(tile_device);
+  const bool on_cpu = (tile_device->info.type == DEVICE_CPU);
+
+  if (on_cpu && leave_tiles_to_gpu())
+    return false;
 
   if (!tile_manager.next_tile(tile, device_num))
     return false;
 
+  tile->start_time = time_dt();
+  tile->on_cpu = on_cpu;
+
   /* fill render tile */
   rtile.x = tile_manager.state.buffer.full_x + tile->x;
   rtile.y = tile_manager.state.buffer.full_y + tile->y;
@@ -467,6 +511,13 @@ void Session::release_tile(RenderTile &rtile)
 
   progress.add_finished_tile(rtile.task == RenderTile::DENOISE);
 
+  if (rtile.task == RenderTile::PATH_TRACE && num_gpu_devices > 0) {
+    const Tile &tile = tile_manager.state.tiles[rtile.tile_index];
+    const int device_type = tile.on_cpu ? 0 : 1;
+    tile_time_sum[device_type] += time_dt() - tile.start_time;
+    tile_time_num[device_type]++;
+  }
+
   bool delete_tile;
 
   if (tile_manager.finish_tile(rtile.tile_index, delete_tile)) {
@@ -640,6 +691,13 @@ void Session::run_cpu()
       if (progress.get_cancel())
         break;
 
+      /* Don't render the partially updated scene, keep the previous result on display until the
+       * new changes are synchronized. */
+      if (scene->update_interrupt) {
+        reset(tile_manager.params, params.samples);
+        continue;
+      }
+
       /* update status and timing */
       update_status_time();
 
@@ -822,6 +880,9 @@ void Session::reset_(BufferParams &buffer_params, int samples)
   tile_manager.reset(buffer_params, samples);
   progress.reset_sample();
 
+  tile_time_sum[0] = tile_time_sum[1] = 0.0;
+  tile_time_num[0] = tile_time_num[1] = 0;
+
   bool show_progress = params.background || tile_manager.get_num_effective_samples() != INT_MAX;
   progress.set_total_pixel_samples(show_progress ? tile_manager.state.total_pixel_samples : 0);
 
@@ -882,6 +943,9 @@ bool Session::update_scene()
 {
   thread_scoped_lock scene_lock(scene->mutex);
 
+  /* Only interrupt for changes which came in while this update runs. */
+  scene->update_interrupt = false;
+
   /* update camera if dimensions changed for progressive render. the camera
    * knows nothing about progressive or cropped rendering, it just gets the
    * image dimensions passed in */
@@ -1127,6 +1191,8 @@ void Session::device_free()
 void Session::collect_statistics(RenderStats *render_stats)
 {
   scene->collect_statistics(render_stats);
+  render_stats->device_mem_used = stats.mem_used;
+  render_stats->device_mem_peak = stats.mem_peak;
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
@@ -189,6 +189,7 @@ class Session {
   void reset_gpu(BufferParams &params, int samples);
 
   bool acquire_tile(Device *tile_device, RenderTile &tile);
+  bool leave_tiles_to_gpu();
   void update_tile_sample(RenderTile &tile);
   void release_tile(RenderTile &tile);
 
@@ -217,6 +218,11 @@ class Session {
 
   double reset_time;
 
+  /* Accumulated tile render times of CPU (0) and GPU (1) devices, for hybrid rendering. */
+  double tile_time_sum[2];
+  int tile_time_num[2];
+  int num_gpu_devices;
+
   /* progressive refine */
   double last_update_time;
   bool update_progressive_refine(bool cancel);
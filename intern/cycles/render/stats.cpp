@@ -45,6 +45,37 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+/* Quote and escape string for use in a JSON report. */
+string json_string(const string &str)
+{
+  string result = "\"";
+  foreach (const char c, str) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          result += string_printf("\\u%04x", (unsigned int)c);
+        }
+        else {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result + "\"";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0)
@@ -87,6 +118,19 @@ string NamedSizeStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSizeStats::json_report()
+{
+  string result = string_printf("{\"total_size\": %zu, \"entries\": [", total_size);
+  sort(entries.begin(), entries.end(), namedSizeEntryComparator);
+  for (size_t i = 0; i < entries.size(); i++) {
+    result += string_printf("%s{\"name\": %s, \"size\": %zu}",
+                            (i == 0) ? "" : ", ",
+                            json_string(entries[i].name).c_str(),
+                            entries[i].size);
+  }
+  return result + "]}";
+}
+
 /* Named time sample statistics. */
 
 NamedNestedSampleStats::NamedNestedSampleStats() : name(""), self_samples(0), sum_samples(0)
@@ -142,6 +186,25 @@ string NamedNestedSampleStats::full_report(int indent_level, uint64_t total_samp
   return result;
 }
 
+string NamedNestedSampleStats::json_report()
+{
+  update_sum();
+
+  string result = string_printf("{\"name\": %s, \"total_time\": %.3f, \"self_time\": %.3f",
+                                json_string(name).c_str(),
+                                sum_samples * 0.001,
+                                self_samples * 0.001);
+  if (!entries.empty()) {
+    result += ", \"entries\": [";
+    sort(entries.begin(), entries.end(), namedTimeSampleEntryComparator);
+    for (size_t i = 0; i < entries.size(); i++) {
+      result += ((i == 0) ? "" : ", ") + entries[i].json_report();
+    }
+    result += "]";
+  }
+  return result + "}";
+}
+
 /* Named sample count pairs. */
 
 NamedSampleCountPair::NamedSampleCountPair(const ustring &name, uint64_t samples, uint64_t hits)
@@ -196,6 +259,27 @@ string NamedSampleCountStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSampleCountStats::json_report()
+{
+  vector<NamedSampleCountPair> sorted_entries;
+  sorted_entries.reserve(entries.size());
+  foreach (entry_map::const_reference entry, entries) {
+    sorted_entries.push_back(entry.second);
+  }
+  sort(sorted_entries.begin(), sorted_entries.end(), namedSampleCountPairComparator);
+
+  string result = "[";
+  for (size_t i = 0; i < sorted_entries.size(); i++) {
+    const NamedSampleCountPair &entry = sorted_entries[i];
+    result += string_printf("%s{\"name\": %s, \"time\": %.3f, \"hits\": %llu}",
+                            (i == 0) ? "" : ", ",
+                            json_string(entry.name.string()).c_str(),
+                            entry.samples * 0.001,
+                            (unsigned long long)entry.hits);
+  }
+  return result + "]";
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats()
@@ -210,6 +294,11 @@ string MeshStats::full_report(int indent_level)
   return result;
 }
 
+string MeshStats::json_report()
+{
+  return "{\"geometry\": " + geometry.json_report() + "}";
+}
+
 /* Image statistics. */
 
 ImageStats::ImageStats()
@@ -224,11 +313,18 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+string ImageStats::json_report()
+{
+  return "{\"textures\": " + textures.json_report() + "}";
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  device_mem_used = 0;
+  device_mem_peak = 0;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -304,6 +400,9 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
 string RenderStats::full_report()
 {
   string result = "";
+  result += string_printf("Device memory: %s used, %s peak\n",
+                          string_human_readable_size(device_mem_used).c_str(),
+                          string_human_readable_size(device_mem_peak).c_str());
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
   if (has_profiling) {
@@ -317,4 +416,20 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  string result = "{";
+  result += string_printf("\"device\": {\"mem_used\": %zu, \"mem_peak\": %zu}",
+                          device_mem_used,
+                          device_mem_peak);
+  result += ", \"mesh\": " + mesh.json_report();
+  result += ", \"image\": " + image.json_report();
+  if (has_profiling) {
+    result += ", \"kernel\": " + kernel.json_report();
+    result += ", \"shaders\": " + shaders.json_report();
+    result += ", \"objects\": " + objects.json_report();
+  }
+  return result + "}";
+}
+
 CCL_NAMESPACE_END
@@ -55,6 +55,9 @@ class NamedSizeStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate machine-readable report as a JSON object. */
+  string json_report();
+
   /* Total size of all entries. */
   size_t total_size;
 
@@ -75,6 +78,7 @@ class NamedNestedSampleStats {
   void update_sum();
 
   string full_report(int indent_level = 0, uint64_t total_samples = 0);
+  string json_report();
 
   string name;
 
@@ -103,6 +107,7 @@ class NamedSampleCountStats {
   NamedSampleCountStats();
 
   string full_report(int indent_level = 0);
+  string json_report();
   void add(const ustring &name, uint64_t samples, uint64_t hits);
 
   typedef unordered_map<ustring, NamedSampleCountPair, ustringHash> entry_map;
@@ -117,6 +122,9 @@ class MeshStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate machine-readable report as a JSON object. */
+  string json_report();
+
   /* Input geometry statistics, this is what is coming as an input to render
    * from. say, Blender. This does not include runtime or engine specific
    * memory like BVH.
@@ -132,6 +140,9 @@ class ImageStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate machine-readable report as a JSON object. */
+  string json_report();
+
   NamedSizeStats textures;
 };
 
@@ -143,11 +154,19 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return full report as a single-line JSON object, meant for pipeline
+   * tools that gather render statistics per frame. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
   bool has_profiling;
 
+  /* Current and peak memory allocated on the render device. */
+  size_t device_mem_used;
+  size_t device_mem_peak;
+
   MeshStats mesh;
   ImageStats image;
   NamedNestedSampleStats kernel;
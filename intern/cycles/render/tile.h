@@ -39,13 +39,26 @@ class Tile {
   typedef enum { RENDER = 0, RENDERED, DENOISE, DENOISED, DONE } State;
   State state;
   RenderBuffers *buffers;
+  /* Time at which rendering of the tile started and whether it is rendered by the CPU, used to
+   * measure per device type throughput. */
+  double start_time;
+  bool on_cpu;
 
   Tile()
   {
   }
 
   Tile(int index_, int x_, int y_, int w_, int h_, int device_, State state_ = RENDER)
-      : index(index_), x(x_), y(y_), w(w_), h(h_), device(device_), state(state_), buffers(NULL)
+      : index(index_),
+        x(x_),
+        y(y_),
+        w(w_),
+        h(h_),
+        device(device_),
+        state(state_),
+        buffers(NULL),
+        start_time(0.0),
+        on_cpu(false)
   {
   }
 };
@@ -224,9 +224,9 @@ float QuadDice::scale_factor(Subpatch &sub, int Mu, int Mv)
   return S;
 }
 
-void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
+void QuadDice::set_grid_verts(Subpatch &sub, int Mu, int Mv, int offset)
 {
-  /* create inner grid */
+  /* set verts of inner grid */
   float du = 1.0f / (float)Mu;
   float dv = 1.0f / (float)Mv;
 
@@ -236,7 +236,15 @@ void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
       float v = j * dv;
 
       set_vert(sub, offset + (i - 1) + (j - 1) * (Mu - 1), u, v);
+    }
+  }
+}
 
+void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
+{
+  /* create inner grid triangles */
+  for (int j = 1; j < Mv; j++) {
+    for (int i = 1; i < Mu; i++) {
       if (i < Mu - 1 && j < Mv - 1) {
         int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
         int i2 = offset + i + (j - 1) * (Mu - 1);
@@ -250,11 +258,11 @@ void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
   }
 }
 
-void QuadDice::dice(Subpatch &sub)
+void QuadDice::grid_size(Subpatch &sub, int &Mu, int &Mv)
 {
   /* compute inner grid size with scale factor */
-  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
-  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
+  Mu = max(sub.edge_u0.T, sub.edge_u1.T);
+  Mv = max(sub.edge_v0.T, sub.edge_v1.T);
 
 #if 0 /* Doesn't work very well, especially at grazing angles. */
   float S = scale_factor(sub, ef, Mu, Mv);
@@ -264,6 +272,20 @@ void QuadDice::dice(Subpatch &sub)
 
   Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
   Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
+}
+
+void QuadDice::dice_grid_verts(Subpatch &sub)
+{
+  int Mu, Mv;
+  grid_size(sub, Mu, Mv);
+
+  set_grid_verts(sub, Mu, Mv, sub.inner_grid_vert_offset);
+}
+
+void QuadDice::dice(Subpatch &sub)
+{
+  int Mu, Mv;
+  grid_size(sub, Mu, Mv);
 
   /* inner grid */
   add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset);
@@ -88,13 +88,19 @@ class QuadDice : public EdgeDice {
   float2 map_uv(Subpatch &sub, float u, float v);
   void set_vert(Subpatch &sub, int index, float u, float v);
 
+  void set_grid_verts(Subpatch &sub, int Mu, int Mv, int offset);
   void add_grid(Subpatch &sub, int Mu, int Mv, int offset);
 
   void set_side(Subpatch &sub, int edge);
 
   float quad_area(const float3 &a, const float3 &b, const float3 &c, const float3 &d);
   float scale_factor(Subpatch &sub, int Mu, int Mv);
+  void grid_size(Subpatch &sub, int &Mu, int &Mv);
 
+  /* Evaluate the inner grid vertices of the subpatch. These are not shared with other
+   * subpatches, so this may run in parallel for different subpatches. */
+  void dice_grid_verts(Subpatch &sub);
+  /* Add the remaining vertices and all triangles, after dice_grid_verts(). */
   void dice(Subpatch &sub);
 };
 
@@ -25,6 +25,7 @@
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_math.h"
+#include "util/util_task.h"
 #include "util/util_types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -39,6 +40,13 @@ DiagSplit::DiagSplit(const SubdParams &params_) : params(params_)
 {
 }
 
+static void dice_grid_verts_task(QuadDice *dice, Subpatch *subpatches, size_t start, size_t end)
+{
+  for (size_t i = start; i < end; i++) {
+    dice->dice_grid_verts(subpatches[i]);
+  }
+}
+
 float3 DiagSplit::to_world(Patch *patch, float2 uv)
 {
   float3 P;
@@ -729,14 +737,34 @@ void DiagSplit::post_split()
 
   dice.reserve(num_verts, num_triangles);
 
-  for (size_t i = 0; i < subpatches.size(); i++) {
-    Subpatch &sub = subpatches[i];
-
+  foreach (Subpatch &sub, subpatches) {
     sub.edge_u0.T = max(sub.edge_u0.T, 1);
     sub.edge_u1.T = max(sub.edge_u1.T, 1);
     sub.edge_v0.T = max(sub.edge_v0.T, 1);
     sub.edge_v1.T = max(sub.edge_v1.T, 1);
+  }
+
+  /* Evaluating patches for the inner grid vertices is the most expensive part of dicing, do it
+   * in parallel. Edge vertices and triangles are added afterwards in order, so the result does
+   * not depend on the number of threads. */
+  const size_t num_subpatches = subpatches.size();
+  const size_t num_tasks = min((size_t)TaskScheduler::num_threads() * 4, num_subpatches / 64);
+  if (num_tasks > 1) {
+    TaskPool pool;
+    for (size_t i = 0; i < num_tasks; i++) {
+      pool.push(function_bind(&dice_grid_verts_task,
+                              &dice,
+                              subpatches.data(),
+                              (num_subpatches * i) / num_tasks,
+                              (num_subpatches * (i + 1)) / num_tasks));
+    }
+    pool.wait_work();
+  }
+  else {
+    dice_grid_verts_task(&dice, subpatches.data(), 0, num_subpatches);
+  }
 
+  foreach (Subpatch &sub, subpatches) {
     dice.dice(sub);
   }
 
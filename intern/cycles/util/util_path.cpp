@@ -382,6 +382,16 @@ string path_cache_get(const string &sub)
 #endif
 }
 
+string path_kernel_cache_get(const string &sub)
+{
+  /* Allows render farms to share compiled kernels between nodes, through a network directory. */
+  static const char *env_kernel_cache_path = getenv("CYCLES_KERNEL_CACHE_PATH");
+  if (env_kernel_cache_path != NULL && env_kernel_cache_path[0] != '\0') {
+    return path_join(env_kernel_cache_path, sub);
+  }
+  return path_cache_get(path_join("kernels", sub));
+}
+
 #if defined(__linux__) || defined(__APPLE__)
 string path_xdg_home_get(const string &sub = "");
 #endif
@@ -662,17 +672,25 @@ bool path_write_binary(const string &path, const vector<uint8_t> &binary)
 {
   path_create_directories(path);
 
-  /* write binary file from memory */
-  FILE *f = path_fopen(path, "wb");
+  /* Write to a temporary file first and move it in place afterwards, so other processes
+   * sharing the same directory never read a partially written file. */
+  const string temporary_path = path_temporary_get(path);
+  FILE *f = path_fopen(temporary_path, "wb");
 
   if (!f)
     return false;
 
+  bool success = true;
   if (binary.size() > 0)
-    fwrite(&binary[0], sizeof(uint8_t), binary.size(), f);
+    success = (fwrite(&binary[0], sizeof(uint8_t), binary.size(), f) == binary.size());
 
   fclose(f);
 
+  if (!success || !path_rename(temporary_path, path)) {
+    path_remove(temporary_path);
+    return false;
+  }
+
   return true;
 }
 
@@ -739,6 +757,18 @@ bool path_remove(const string &path)
   return remove(path.c_str()) == 0;
 }
 
+bool path_rename(const string &old_path, const string &new_path)
+{
+  /* Replaces an existing file, also on Windows. */
+  string error;
+  return OIIO::Filesystem::rename(old_path, new_path, error);
+}
+
+string path_temporary_get(const string &path)
+{
+  return OIIO::Filesystem::unique_path(path + ".%%%%-%%%%-%%%%.tmp");
+}
+
 struct SourceReplaceState {
   typedef map<string, string> ProcessedMapping;
   /* Base director for all relative include headers. */
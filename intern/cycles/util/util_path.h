@@ -36,6 +36,7 @@ void path_init(const string &path = "", const string &user_path = "");
 string path_get(const string &sub = "");
 string path_user_get(const string &sub = "");
 string path_cache_get(const string &sub = "");
+string path_kernel_cache_get(const string &sub = "");
 
 /* path string manipulation */
 string path_filename(const string &path);
@@ -64,6 +65,8 @@ bool path_read_text(const string &path, string &text);
 
 /* File manipulation. */
 bool path_remove(const string &path);
+bool path_rename(const string &old_path, const string &new_path);
+string path_temporary_get(const string &path);
 
 /* source code utility */
 string path_source_replace_includes(const string &source,
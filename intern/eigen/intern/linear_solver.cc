@@ -268,12 +268,8 @@ void EIG_linear_solver_right_hand_side_add(LinearSolver *solver, int rhs, int in
 
 /* Solve */
 
-bool EIG_linear_solver_solve(LinearSolver *solver)
+static bool linear_solver_factorize(LinearSolver *solver)
 {
-  /* nothing to solve, perhaps all variables were locked */
-  if (solver->m == 0 || solver->n == 0)
-    return true;
-
   bool result = true;
 
   assert(solver->state != LinearSolver::STATE_VARIABLES_CONSTRUCT);
@@ -302,6 +298,17 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
     solver->state = LinearSolver::STATE_MATRIX_SOLVED;
   }
 
+  return result;
+}
+
+bool EIG_linear_solver_solve(LinearSolver *solver)
+{
+  /* nothing to solve, perhaps all variables were locked */
+  if (solver->m == 0 || solver->n == 0)
+    return true;
+
+  bool result = linear_solver_factorize(solver);
+
   if (result) {
     /* solve for each right hand side */
     for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
@@ -344,6 +351,73 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
   return result;
 }
 
+bool EIG_linear_solver_factorize(LinearSolver *solver)
+{
+  if (solver->m == 0 || solver->n == 0)
+    return true;
+
+  return linear_solver_factorize(solver);
+}
+
+bool EIG_linear_solver_solve_array(const LinearSolver *solver, const double *b, double *x)
+{
+  if (solver->m == 0 || solver->n == 0)
+    return true;
+
+  assert(solver->state == LinearSolver::STATE_MATRIX_SOLVED);
+
+  /* right hand side is indexed by row for least squares, and by variable otherwise */
+  EigenVectorX vb(solver->m);
+
+  if (solver->least_squares) {
+    for (int i = 0; i < solver->m; i++)
+      vb[i] = b[i];
+  }
+  else {
+    for (int i = 0; i < solver->num_variables; i++) {
+      const LinearSolver::Variable *variable = &solver->variable[i];
+
+      if (!variable->locked)
+        vb[variable->index] = b[i];
+    }
+  }
+
+  /* modify for locked variables, their values are read from x */
+  for (int i = 0; i < solver->num_variables; i++) {
+    const LinearSolver::Variable *variable = &solver->variable[i];
+
+    if (variable->locked) {
+      const std::vector<LinearSolver::Coeff> &a = variable->a;
+
+      for (int j = 0; j < a.size(); j++)
+        vb[a[j].index] -= a[j].value * x[i];
+    }
+  }
+
+  /* solve, the factorization is only read so this is safe to run from multiple threads */
+  EigenVectorX vx;
+
+  if (solver->least_squares) {
+    EigenVectorX Mtb = solver->M.transpose() * vb;
+    vx = solver->sparseLU->solve(Mtb);
+  }
+  else {
+    vx = solver->sparseLU->solve(vb);
+  }
+
+  if (solver->sparseLU->info() != Eigen::Success)
+    return false;
+
+  for (int i = 0; i < solver->num_variables; i++) {
+    const LinearSolver::Variable *variable = &solver->variable[i];
+
+    if (!variable->locked)
+      x[i] = vx[variable->index];
+  }
+
+  return true;
+}
+
 /* Debugging */
 
 void EIG_linear_solver_print_matrix(LinearSolver *solver)
@@ -58,6 +58,16 @@ void EIG_linear_solver_right_hand_side_add(LinearSolver *solver, int rhs, int in
 
 bool EIG_linear_solver_solve(LinearSolver *solver);
 
+/* Solve for right hand side b, given as an array, into variables x. Both are indexed like the
+ * variables, or by row for b in least squares solvers, and locked variables are read from x.
+ * The variables and right hand sides stored in the solver are not used.
+ *
+ * After the matrix is factorized, solving only reads the solver data, so multiple right hand
+ * sides can be solved at the same time from different threads. */
+
+bool EIG_linear_solver_factorize(LinearSolver *solver);
+bool EIG_linear_solver_solve_array(const LinearSolver *solver, const double *b, double *x);
+
 /* Debugging */
 
 void EIG_linear_solver_print_matrix(LinearSolver *solver);
@@ -225,8 +225,9 @@ GHOST_ContextEGL::GHOST_ContextEGL(bool stereoVisual,
           choose_api(api, s_gl_sharedContext, s_gles_sharedContext, s_vg_sharedContext)),
       m_sharedCount(choose_api(api, s_gl_sharedCount, s_gles_sharedCount, s_vg_sharedCount))
 {
-  assert(m_nativeWindow != 0);
-  assert(m_nativeDisplay != NULL);
+  /* Without native window the context renders to a small pbuffer surface, which allows to use
+   * it offscreen without any windowing system, with #EGL_DEFAULT_DISPLAY as display. */
+  assert(m_nativeWindow == 0 || m_nativeDisplay != NULL);
 }
 
 GHOST_ContextEGL::~GHOST_ContextEGL()
@@ -307,8 +308,9 @@ GHOST_TSuccess GHOST_ContextEGL::releaseDrawingContext()
   if (m_display) {
     bindAPI(m_api);
 
-    return EGL_CHK(::eglMakeCurrent(m_display, None, None, NULL)) ? GHOST_kSuccess :
-                                                                    GHOST_kFailure;
+    return EGL_CHK(::eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT)) ?
+               GHOST_kSuccess :
+               GHOST_kFailure;
   }
   else {
     return GHOST_kFailure;
@@ -434,6 +436,11 @@ GHOST_TSuccess GHOST_ContextEGL::initializeDrawingContext()
   attrib_list.push_back(8);
 #endif
 
+  if (m_nativeWindow == 0) {
+    attrib_list.push_back(EGL_SURFACE_TYPE);
+    attrib_list.push_back(EGL_PBUFFER_BIT);
+  }
+
   attrib_list.push_back(EGL_NONE);
 
   EGLConfig config;
@@ -445,7 +452,14 @@ GHOST_TSuccess GHOST_ContextEGL::initializeDrawingContext()
   if (num_config != 1)  // num_config should be exactly 1
     goto error;
 
-  m_surface = ::eglCreateWindowSurface(m_display, config, m_nativeWindow, NULL);
+  if (m_nativeWindow != 0) {
+    m_surface = ::eglCreateWindowSurface(m_display, config, m_nativeWindow, NULL);
+  }
+  else {
+    /* Offscreen drawing goes to frame-buffer objects, the surface is never drawn to. */
+    static const EGLint pbuffer_attrib_list[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    m_surface = ::eglCreatePbufferSurface(m_display, config, pbuffer_attrib_list);
+  }
 
   if (!EGL_CHK(m_surface != EGL_NO_SURFACE))
     goto error;
@@ -27,6 +27,10 @@
 #include "GHOST_DisplayManagerNULL.h"
 #include "GHOST_WindowNULL.h"
 
+#ifdef WITH_GL_EGL
+#  include "GHOST_ContextEGL.h"
+#endif
+
 class GHOST_WindowNULL;
 
 class GHOST_SystemNULL : public GHOST_System {
@@ -84,11 +88,28 @@ class GHOST_SystemNULL : public GHOST_System {
   }
   GHOST_IContext *createOffscreenContext()
   {
+#ifdef WITH_GL_EGL
+    /* Surfaceless context for rendering without display server (render farm nodes).
+     * Try 4.x core profile, then 3.3 core profile like the other systems. */
+    for (int minor = 5; minor >= 0; --minor) {
+      GHOST_IContext *context = createOffscreenContextEGL(4, minor);
+      if (context) {
+        return context;
+      }
+    }
+    return createOffscreenContextEGL(3, 3);
+#else
     return NULL;
+#endif
   }
   GHOST_TSuccess disposeContext(GHOST_IContext *context)
   {
+#ifdef WITH_GL_EGL
+    delete context;
+    return GHOST_kSuccess;
+#else
     return GHOST_kFailure;
+#endif
   }
 
   GHOST_TSuccess init()
@@ -129,6 +150,27 @@ class GHOST_SystemNULL : public GHOST_System {
                                 type,
                                 ((glSettings.flags & GHOST_glStereoVisual) != 0));
   }
+
+#ifdef WITH_GL_EGL
+ private:
+  GHOST_IContext *createOffscreenContextEGL(int major, int minor)
+  {
+    GHOST_Context *context = new GHOST_ContextEGL(false,
+                                                  (EGLNativeWindowType)0,
+                                                  EGL_DEFAULT_DISPLAY,
+                                                  EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                                  major,
+                                                  minor,
+                                                  GHOST_OPENGL_EGL_CONTEXT_FLAGS,
+                                                  GHOST_OPENGL_EGL_RESET_NOTIFICATION_STRATEGY,
+                                                  EGL_OPENGL_API);
+    if (context->initializeDrawingContext()) {
+      return context;
+    }
+    delete context;
+    return NULL;
+  }
+#endif
 };
 
 #endif /* __GHOST_SYSTEMNULL_H__ */
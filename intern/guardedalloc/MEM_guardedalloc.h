@@ -230,6 +230,11 @@ extern const char *(*MEM_name_ptr)(void *vmemh);
 /* Switch allocator to slower but fully guarded mode. */
 void MEM_use_guarded_allocator(void);
 
+/* Cache small blocks for each thread in the lock-free allocator,
+ * reducing contention on the system allocator. No effect with the guarded allocator,
+ * or on platforms without thread local storage support. */
+void MEM_use_thread_cache(void);
+
 #ifdef __cplusplus
 /* alloc funcs for C++ only */
 #  define MEM_CXX_CLASS_ALLOC_FUNCS(_id) \
@@ -127,3 +127,10 @@ void MEM_use_guarded_allocator(void)
   MEM_name_ptr = MEM_guarded_name_ptr;
 #endif
 }
+
+void MEM_use_thread_cache(void)
+{
+  if (MEM_mallocN == MEM_lockfree_mallocN) {
+    MEM_lockfree_use_thread_cache();
+  }
+}
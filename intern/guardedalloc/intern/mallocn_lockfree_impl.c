@@ -59,8 +59,9 @@ enum {
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
-#define MEMHEAD_IS_MMAP(memhead) ((memhead)->len & (size_t)MEMHEAD_MMAP_FLAG)
-#define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
+#define MEMHEAD_FLAGS(memhead) ((memhead)->len & (size_t)(MEMHEAD_MMAP_FLAG | MEMHEAD_ALIGN_FLAG))
+#define MEMHEAD_IS_MMAP(memhead) (MEMHEAD_FLAGS(memhead) == (size_t)MEMHEAD_MMAP_FLAG)
+#define MEMHEAD_IS_ALIGNED(memhead) (MEMHEAD_FLAGS(memhead) == (size_t)MEMHEAD_ALIGN_FLAG)
 
 /* Uncomment this to have proper peak counter. */
 #define USE_ATOMIC_MAX
@@ -107,6 +108,345 @@ static void mem_unlock_thread(void)
 }
 #endif
 
+/* -------------------------------------------------------------------- */
+/* Thread cache
+ *
+ * Optional cache of small blocks for each thread, enabled by MEM_use_thread_cache().
+ *
+ * Freed blocks of small size classes are kept in a free list of the freeing thread
+ * and reused by allocations of the same class. When a thread has too many free blocks
+ * of a class they're moved in a batch to a central pool, where threads running out of
+ * blocks take batches from. Only when the central pool is full blocks are freed to
+ * the system.
+ *
+ * Memory counters of cached allocations are accumulated per thread, the getters sum
+ * the counters of all threads, so there are no shared atomic operations for most
+ * allocations.
+ */
+
+#if defined(__GNUC__) && !defined(_WIN32)
+#  define USE_THREAD_CACHE
+#endif
+
+#ifdef USE_THREAD_CACHE
+
+#  include <pthread.h>
+
+/* Both flags are never set for regular blocks: mmap'ed blocks are never aligned. */
+#  define MEMHEAD_CACHED_FLAGS ((size_t)(MEMHEAD_MMAP_FLAG | MEMHEAD_ALIGN_FLAG))
+#  define MEMHEAD_IS_CACHED(memhead) (MEMHEAD_FLAGS(memhead) == MEMHEAD_CACHED_FLAGS)
+
+/* Sizes of the cached classes, in bytes without the MemHead. */
+static const size_t cache_class_size[] = {
+    16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 768, 1024};
+#  define CACHE_NUM_CLASSES ((int)(sizeof(cache_class_size) / sizeof(*cache_class_size)))
+#  define CACHE_MAX_SIZE 1024
+
+/* Number of blocks moved at once between a thread and the central pool. */
+#  define CACHE_BATCH_SIZE 32
+/* Number of batches of each class the central pool keeps. */
+#  define CACHE_CENTRAL_MAX_BATCHES 64
+/* Flush the counters of a thread once they get larger than this, to keep the peak updated. */
+#  define CACHE_COUNTER_FLUSH (1 << 20)
+
+typedef struct MemCacheNode {
+  struct MemCacheNode *next;
+  /** Only used by the first node of a batch in the central pool. */
+  struct MemCacheNode *next_batch;
+} MemCacheNode;
+
+typedef struct MemCacheList {
+  MemCacheNode *first;
+  unsigned int len;
+} MemCacheList;
+
+typedef struct MemThreadCache {
+  struct MemThreadCache *next, *prev;
+  MemCacheList lists[CACHE_NUM_CLASSES];
+  /* Not flushed changes of the counters, may be negative (wrapping). */
+  size_t mem_in_use;
+  unsigned int totblock;
+} MemThreadCache;
+
+typedef struct MemCentralPool {
+  pthread_mutex_t mutex;
+  MemCacheNode *batches[CACHE_NUM_CLASSES];
+  unsigned int batches_len[CACHE_NUM_CLASSES];
+  /* All thread caches, to sum their counters. */
+  MemThreadCache *caches;
+} MemCentralPool;
+
+static bool use_thread_cache = false;
+static MemCentralPool central_pool = {PTHREAD_MUTEX_INITIALIZER};
+static pthread_key_t thread_cache_key;
+static __thread MemThreadCache *thread_cache = NULL;
+/* Lookup of the class for each 16 bytes step of the size. */
+static unsigned char cache_class_from_step[CACHE_MAX_SIZE / 16 + 1];
+
+MEM_INLINE int cache_class_index(size_t len)
+{
+  return cache_class_from_step[(len + 15) >> 4];
+}
+
+/* Caller must hold the central pool mutex, for the counters to always sum up correctly. */
+MEM_INLINE void cache_counters_flush(MemThreadCache *cache)
+{
+  atomic_add_and_fetch_z(&mem_in_use, cache->mem_in_use);
+  atomic_add_and_fetch_u(&totblock, cache->totblock);
+  cache->mem_in_use = 0;
+  cache->totblock = 0;
+}
+
+static void cache_central_push_batch(const int class_index, MemCacheNode *batch, unsigned int len)
+{
+  bool stored = false;
+
+  pthread_mutex_lock(&central_pool.mutex);
+  if (len == CACHE_BATCH_SIZE &&
+      central_pool.batches_len[class_index] < CACHE_CENTRAL_MAX_BATCHES) {
+    batch->next_batch = central_pool.batches[class_index];
+    central_pool.batches[class_index] = batch;
+    central_pool.batches_len[class_index]++;
+    stored = true;
+  }
+  pthread_mutex_unlock(&central_pool.mutex);
+
+  if (!stored) {
+    while (batch) {
+      MemCacheNode *next = batch->next;
+      free(batch);
+      batch = next;
+    }
+  }
+}
+
+static MemCacheNode *cache_central_pop_batch(const int class_index)
+{
+  MemCacheNode *batch = NULL;
+
+  /* Unlocked check, avoids locking when there is nothing to get. */
+  if (central_pool.batches_len[class_index] == 0) {
+    return NULL;
+  }
+
+  pthread_mutex_lock(&central_pool.mutex);
+  batch = central_pool.batches[class_index];
+  if (batch) {
+    central_pool.batches[class_index] = batch->next_batch;
+    central_pool.batches_len[class_index]--;
+  }
+  pthread_mutex_unlock(&central_pool.mutex);
+
+  return batch;
+}
+
+/* Called on thread exit, give the blocks and counters of the cache back. */
+static void cache_thread_exit(void *cache_v)
+{
+  MemThreadCache *cache = cache_v;
+
+  for (int i = 0; i < CACHE_NUM_CLASSES; i++) {
+    MemCacheList *list = &cache->lists[i];
+    while (list->first) {
+      MemCacheNode *batch = list->first;
+      MemCacheNode *last = batch;
+      unsigned int len = 1;
+      while (len < CACHE_BATCH_SIZE && last->next) {
+        last = last->next;
+        len++;
+      }
+      list->first = last->next;
+      last->next = NULL;
+      cache_central_push_batch(i, batch, len);
+    }
+  }
+
+  pthread_mutex_lock(&central_pool.mutex);
+  cache_counters_flush(cache);
+  if (cache->prev) {
+    cache->prev->next = cache->next;
+  }
+  else {
+    central_pool.caches = cache->next;
+  }
+  if (cache->next) {
+    cache->next->prev = cache->prev;
+  }
+  pthread_mutex_unlock(&central_pool.mutex);
+
+  thread_cache = NULL;
+  free(cache);
+}
+
+static MemThreadCache *cache_thread_ensure(void)
+{
+  MemThreadCache *cache = thread_cache;
+  if (LIKELY(cache)) {
+    return cache;
+  }
+
+  cache = calloc(1, sizeof(*cache));
+  if (UNLIKELY(cache == NULL)) {
+    return NULL;
+  }
+
+  pthread_mutex_lock(&central_pool.mutex);
+  cache->next = central_pool.caches;
+  if (cache->next) {
+    cache->next->prev = cache;
+  }
+  central_pool.caches = cache;
+  pthread_mutex_unlock(&central_pool.mutex);
+
+  pthread_setspecific(thread_cache_key, cache);
+  thread_cache = cache;
+  return cache;
+}
+
+/* Returns a block with MemHead for the (4 bytes aligned) len, NULL if not cached. */
+MEM_INLINE MemHead *cache_alloc(size_t len)
+{
+  if (!use_thread_cache || len > CACHE_MAX_SIZE) {
+    return NULL;
+  }
+
+  MemThreadCache *cache = cache_thread_ensure();
+  if (UNLIKELY(cache == NULL)) {
+    return NULL;
+  }
+
+  const int class_index = cache_class_index(len);
+  MemCacheList *list = &cache->lists[class_index];
+  MemHead *memh;
+
+  if (UNLIKELY(list->first == NULL)) {
+    list->first = cache_central_pop_batch(class_index);
+    list->len = list->first ? CACHE_BATCH_SIZE : 0;
+  }
+
+  if (list->first) {
+    memh = (MemHead *)list->first;
+    list->first = list->first->next;
+    list->len--;
+  }
+  else {
+    memh = malloc(sizeof(MemHead) + cache_class_size[class_index]);
+    if (UNLIKELY(memh == NULL)) {
+      return NULL;
+    }
+  }
+
+  memh->len = len | MEMHEAD_CACHED_FLAGS;
+  cache->totblock++;
+  cache->mem_in_use += len;
+  if (UNLIKELY(cache->mem_in_use > CACHE_COUNTER_FLUSH && cache->mem_in_use < SIZE_MAX / 2)) {
+    pthread_mutex_lock(&central_pool.mutex);
+    cache_counters_flush(cache);
+    pthread_mutex_unlock(&central_pool.mutex);
+    update_maximum(&peak_mem, mem_in_use);
+  }
+
+  return memh;
+}
+
+static void cache_free(MemHead *memh, size_t len)
+{
+  MemThreadCache *cache = cache_thread_ensure();
+
+  if (UNLIKELY(cache == NULL)) {
+    /* Can't cache, still a regular system block. */
+    atomic_sub_and_fetch_u(&totblock, 1);
+    atomic_sub_and_fetch_z(&mem_in_use, len);
+    free(memh);
+    return;
+  }
+
+  const int class_index = cache_class_index(len);
+  MemCacheList *list = &cache->lists[class_index];
+  MemCacheNode *node = (MemCacheNode *)memh;
+
+  node->next = list->first;
+  list->first = node;
+  list->len++;
+
+  cache->totblock--;
+  cache->mem_in_use -= len;
+
+  if (UNLIKELY(list->len >= CACHE_BATCH_SIZE * 2)) {
+    /* Move the least recently freed half to the central pool. */
+    MemCacheNode *last = list->first;
+    for (unsigned int i = 1; i < CACHE_BATCH_SIZE; i++) {
+      last = last->next;
+    }
+    cache_central_push_batch(class_index, last->next, CACHE_BATCH_SIZE);
+    last->next = NULL;
+    list->len = CACHE_BATCH_SIZE;
+  }
+}
+
+void MEM_lockfree_use_thread_cache(void)
+{
+  if (use_thread_cache) {
+    return;
+  }
+
+  for (int i = 0, step = 0; step <= CACHE_MAX_SIZE / 16; step++) {
+    while (cache_class_size[i] < (size_t)step * 16) {
+      i++;
+    }
+    cache_class_from_step[step] = (unsigned char)i;
+  }
+
+  if (pthread_key_create(&thread_cache_key, cache_thread_exit) == 0) {
+    use_thread_cache = true;
+  }
+}
+
+/* Counters including the changes of all threads which are not flushed yet. */
+static void cache_counters_total(size_t *r_mem_in_use, unsigned int *r_totblock)
+{
+  if (!use_thread_cache) {
+    *r_mem_in_use = mem_in_use;
+    *r_totblock = totblock;
+    return;
+  }
+
+  pthread_mutex_lock(&central_pool.mutex);
+  *r_mem_in_use = mem_in_use;
+  *r_totblock = totblock;
+  for (MemThreadCache *cache = central_pool.caches; cache; cache = cache->next) {
+    *r_mem_in_use += *(volatile size_t *)&cache->mem_in_use;
+    *r_totblock += *(volatile unsigned int *)&cache->totblock;
+  }
+  pthread_mutex_unlock(&central_pool.mutex);
+}
+
+#else /* USE_THREAD_CACHE */
+
+#  define MEMHEAD_IS_CACHED(memhead) false
+
+MEM_INLINE MemHead *cache_alloc(size_t UNUSED(len))
+{
+  return NULL;
+}
+
+static void cache_free(MemHead *UNUSED(memh), size_t UNUSED(len))
+{
+}
+
+void MEM_lockfree_use_thread_cache(void)
+{
+  /* Not supported, keep using the system allocator directly. */
+}
+
+static void cache_counters_total(size_t *r_mem_in_use, unsigned int *r_totblock)
+{
+  *r_mem_in_use = mem_in_use;
+  *r_totblock = totblock;
+}
+
+#endif /* USE_THREAD_CACHE */
+
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
@@ -130,6 +470,14 @@ void MEM_lockfree_freeN(void *vmemh)
     return;
   }
 
+  if (MEMHEAD_IS_CACHED(memh)) {
+    if (UNLIKELY(malloc_debug_memset && len)) {
+      memset(memh + 1, 255, len);
+    }
+    cache_free(memh, len);
+    return;
+  }
+
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, len);
 
@@ -264,6 +612,12 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
+  memh = cache_alloc(len);
+  if (memh) {
+    memset(memh + 1, 0, len);
+    return PTR_FROM_MEMHEAD(memh);
+  }
+
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
@@ -305,6 +659,14 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
+  memh = cache_alloc(len);
+  if (memh) {
+    if (UNLIKELY(malloc_debug_memset && len)) {
+      memset(memh + 1, 255, len);
+    }
+    return PTR_FROM_MEMHEAD(memh);
+  }
+
   memh = (MemHead *)malloc(len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
@@ -451,7 +813,8 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n",
+         (double)MEM_lockfree_get_memory_in_use() / (double)(1024 * 1024));
   printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
@@ -486,7 +849,10 @@ void MEM_lockfree_set_memory_debug(void)
 
 size_t MEM_lockfree_get_memory_in_use(void)
 {
-  return mem_in_use;
+  size_t r_mem_in_use;
+  unsigned int r_totblock;
+  cache_counters_total(&r_mem_in_use, &r_totblock);
+  return r_mem_in_use;
 }
 
 size_t MEM_lockfree_get_mapped_memory_in_use(void)
@@ -496,13 +862,16 @@ size_t MEM_lockfree_get_mapped_memory_in_use(void)
 
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void)
 {
-  return totblock;
+  size_t r_mem_in_use;
+  unsigned int r_totblock;
+  cache_counters_total(&r_mem_in_use, &r_totblock);
+  return r_totblock;
 }
 
 /* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  peak_mem = MEM_lockfree_get_memory_in_use();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
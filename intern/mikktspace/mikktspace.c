@@ -39,6 +39,9 @@
 
 #define INTERNAL_RND_SORT_SEED 39871946
 
+// below this number of triangles (or groups) the OpenMP overhead is not worth it
+#define MIKK_OPENMP_LIMIT 1024
+
 #ifdef _MSC_VER
 #  define MIKK_INLINE static __forceinline
 #else
@@ -313,6 +316,7 @@ tbool genTangSpace(const SMikkTSpaceContext *pContext, const float fAngularThres
   // Mark all degenerate triangles
   iTotTris = iNrTrianglesIn;
   iDegenTriangles = 0;
+#pragma omp parallel for reduction(+ : iDegenTriangles) if (iTotTris > MIKK_OPENMP_LIMIT)
   for (t = 0; t < iTotTris; t++) {
     const int i0 = piTriListIn[t * 3 + 0];
     const int i1 = piTriListIn[t * 3 + 1];
@@ -843,6 +847,7 @@ static void InitTriInfo(STriInfo pTriInfos[],
   // which is called before this function.
 
   // generate neighbor info list
+#pragma omp parallel for private(i) if (iNrTrianglesIn > MIKK_OPENMP_LIMIT)
   for (f = 0; f < iNrTrianglesIn; f++)
     for (i = 0; i < 3; i++) {
       pTriInfos[f].FaceNeighbors[i] = -1;
@@ -862,6 +867,7 @@ static void InitTriInfo(STriInfo pTriInfos[],
     }
 
   // evaluate first order derivatives
+#pragma omp parallel for if (iNrTrianglesIn > MIKK_OPENMP_LIMIT)
   for (f = 0; f < iNrTrianglesIn; f++) {
     // initial values
     const SVec3 v1 = GetPosition(pContext, piTriListIn[f * 3 + 0]);
@@ -1105,6 +1111,126 @@ static STSpace EvalTspace(int face_indices[],
                           const SMikkTSpaceContext *pContext,
                           const int iVertexRepresentitive);
 
+// evaluates the tangent space of every triangle of a group, see GenerateTSpaces().
+// the temporary buffers must hold at least pGroup->iNrFaces items.
+static tbool GenerateGroupTSpaces(STSpace pGroupTspaces[],
+                                  STSpace pSubGroupTspace[],
+                                  SSubGroup pUniSubGroups[],
+                                  int pTmpMembers[],
+                                  const STriInfo pTriInfos[],
+                                  const SGroup *pGroup,
+                                  const int piTriListIn[],
+                                  const float fThresCos,
+                                  const SMikkTSpaceContext *pContext)
+{
+  int iUniqueSubGroups = 0, s = 0, i = 0;
+
+  for (i = 0; i < pGroup->iNrFaces; i++)  // triangles
+  {
+    const int f = pGroup->pFaceIndices[i];  // triangle number
+    int index = -1, iVertIndex = -1, iOF_1 = -1, iMembers = 0, j = 0, l = 0;
+    SSubGroup tmp_group;
+    tbool bFound;
+    SVec3 n, vOs, vOt;
+    if (pTriInfos[f].AssignedGroup[0] == pGroup)
+      index = 0;
+    else if (pTriInfos[f].AssignedGroup[1] == pGroup)
+      index = 1;
+    else if (pTriInfos[f].AssignedGroup[2] == pGroup)
+      index = 2;
+    assert(index >= 0 && index < 3);
+
+    iVertIndex = piTriListIn[f * 3 + index];
+    assert(iVertIndex == pGroup->iVertexRepresentitive);
+
+    // is normalized already
+    n = GetNormal(pContext, iVertIndex);
+
+    // project
+    vOs = NormalizeSafe(vsub(pTriInfos[f].vOs, vscale(vdot(n, pTriInfos[f].vOs), n)));
+    vOt = NormalizeSafe(vsub(pTriInfos[f].vOt, vscale(vdot(n, pTriInfos[f].vOt), n)));
+
+    // original face number
+    iOF_1 = pTriInfos[f].iOrgFaceNumber;
+
+    iMembers = 0;
+    for (j = 0; j < pGroup->iNrFaces; j++) {
+      const int t = pGroup->pFaceIndices[j];  // triangle number
+      const int iOF_2 = pTriInfos[t].iOrgFaceNumber;
+
+      // project
+      SVec3 vOs2 = NormalizeSafe(vsub(pTriInfos[t].vOs, vscale(vdot(n, pTriInfos[t].vOs), n)));
+      SVec3 vOt2 = NormalizeSafe(vsub(pTriInfos[t].vOt, vscale(vdot(n, pTriInfos[t].vOt), n)));
+
+      {
+        const tbool bAny = ((pTriInfos[f].iFlag | pTriInfos[t].iFlag) & GROUP_WITH_ANY) != 0 ?
+                               TTRUE :
+                               TFALSE;
+        // make sure triangles which belong to the same quad are joined.
+        const tbool bSameOrgFace = iOF_1 == iOF_2 ? TTRUE : TFALSE;
+
+        const float fCosS = vdot(vOs, vOs2);
+        const float fCosT = vdot(vOt, vOt2);
+
+        assert(f != t || bSameOrgFace);  // sanity check
+        if (bAny || bSameOrgFace || (fCosS > fThresCos && fCosT > fThresCos))
+          pTmpMembers[iMembers++] = t;
+      }
+    }
+
+    // sort pTmpMembers
+    tmp_group.iNrFaces = iMembers;
+    tmp_group.pTriMembers = pTmpMembers;
+    if (iMembers > 1) {
+      unsigned int uSeed = INTERNAL_RND_SORT_SEED;  // could replace with a random seed?
+      QuickSort(pTmpMembers, 0, iMembers - 1, uSeed);
+    }
+
+    // look for an existing match
+    bFound = TFALSE;
+    l = 0;
+    while (l < iUniqueSubGroups && !bFound) {
+      bFound = CompareSubGroups(&tmp_group, &pUniSubGroups[l]);
+      if (!bFound)
+        ++l;
+    }
+
+    // assign tangent space index
+    assert(bFound || l == iUniqueSubGroups);
+    // piTempTangIndices[f*3+index] = iUniqueTspaces+l;
+
+    // if no match was found we allocate a new subgroup
+    if (!bFound) {
+      // insert new subgroup
+      int *pIndices = (int *)malloc(sizeof(int) * iMembers);
+      if (pIndices == NULL) {
+        // clean up and return false
+        for (s = 0; s < iUniqueSubGroups; s++)
+          free(pUniSubGroups[s].pTriMembers);
+        return TFALSE;
+      }
+      pUniSubGroups[iUniqueSubGroups].iNrFaces = iMembers;
+      pUniSubGroups[iUniqueSubGroups].pTriMembers = pIndices;
+      memcpy(pIndices, tmp_group.pTriMembers, sizeof(int) * iMembers);
+      pSubGroupTspace[iUniqueSubGroups] = EvalTspace(tmp_group.pTriMembers,
+                                                     iMembers,
+                                                     piTriListIn,
+                                                     pTriInfos,
+                                                     pContext,
+                                                     pGroup->iVertexRepresentitive);
+      ++iUniqueSubGroups;
+    }
+
+    pGroupTspaces[i] = pSubGroupTspace[l];
+  }
+
+  // clean up
+  for (s = 0; s < iUniqueSubGroups; s++)
+    free(pUniSubGroups[s].pTriMembers);
+
+  return TTRUE;
+}
+
 static tbool GenerateTSpaces(STSpace psTspace[],
                              const STriInfo pTriInfos[],
                              const SGroup pGroups[],
@@ -1113,43 +1239,87 @@ static tbool GenerateTSpaces(STSpace psTspace[],
                              const float fThresCos,
                              const SMikkTSpaceContext *pContext)
 {
-  STSpace *pSubGroupTspace = NULL;
-  SSubGroup *pUniSubGroups = NULL;
-  int *pTmpMembers = NULL;
-  int iMaxNrFaces = 0, iUniqueTspaces = 0, g = 0, i = 0;
-  for (g = 0; g < iNrActiveGroups; g++)
+  STSpace *pGroupTspaces = NULL;
+  int *piGroupOffsets = NULL;
+  int iMaxNrFaces = 0, iNrGroupFaces = 0, g = 0, i = 0;
+  tbool bRes = TTRUE;
+
+  if (iNrActiveGroups == 0)
+    return TTRUE;
+
+  // tangent spaces of all groups are evaluated first, each group independently.
+  // they are stored per group member, in the order they would have been output.
+  piGroupOffsets = (int *)malloc(sizeof(int) * iNrActiveGroups);
+  if (piGroupOffsets == NULL)
+    return TFALSE;
+  for (g = 0; g < iNrActiveGroups; g++) {
+    piGroupOffsets[g] = iNrGroupFaces;
+    iNrGroupFaces += pGroups[g].iNrFaces;
     if (iMaxNrFaces < pGroups[g].iNrFaces)
       iMaxNrFaces = pGroups[g].iNrFaces;
+  }
 
-  if (iMaxNrFaces == 0)
+  if (iMaxNrFaces == 0) {
+    free(piGroupOffsets);
     return TTRUE;
+  }
 
-  // make initial allocations
-  pSubGroupTspace = (STSpace *)malloc(sizeof(STSpace) * iMaxNrFaces);
-  pUniSubGroups = (SSubGroup *)malloc(sizeof(SSubGroup) * iMaxNrFaces);
-  pTmpMembers = (int *)malloc(sizeof(int) * iMaxNrFaces);
-  if (pSubGroupTspace == NULL || pUniSubGroups == NULL || pTmpMembers == NULL) {
+  pGroupTspaces = (STSpace *)malloc(sizeof(STSpace) * iNrGroupFaces);
+  if (pGroupTspaces == NULL) {
+    free(piGroupOffsets);
+    return TFALSE;
+  }
+
+#pragma omp parallel if (iNrActiveGroups > MIKK_OPENMP_LIMIT)
+  {
+    // make initial allocations, one set for each thread
+    STSpace *pSubGroupTspace = (STSpace *)malloc(sizeof(STSpace) * iMaxNrFaces);
+    SSubGroup *pUniSubGroups = (SSubGroup *)malloc(sizeof(SSubGroup) * iMaxNrFaces);
+    int *pTmpMembers = (int *)malloc(sizeof(int) * iMaxNrFaces);
+    const tbool bAllocated = pSubGroupTspace != NULL && pUniSubGroups != NULL &&
+                             pTmpMembers != NULL;
+    int iGroup = 0;
+
+#pragma omp for schedule(dynamic, 64)
+    for (iGroup = 0; iGroup < iNrActiveGroups; iGroup++) {
+      if (!bAllocated || !GenerateGroupTSpaces(&pGroupTspaces[piGroupOffsets[iGroup]],
+                                               pSubGroupTspace,
+                                               pUniSubGroups,
+                                               pTmpMembers,
+                                               pTriInfos,
+                                               &pGroups[iGroup],
+                                               piTriListIn,
+                                               fThresCos,
+                                               pContext)) {
+#pragma omp atomic write
+        bRes = TFALSE;
+      }
+    }
+
+    // clean up
     if (pSubGroupTspace != NULL)
       free(pSubGroupTspace);
     if (pUniSubGroups != NULL)
       free(pUniSubGroups);
     if (pTmpMembers != NULL)
       free(pTmpMembers);
+  }
+
+  if (!bRes) {
+    free(pGroupTspaces);
+    free(piGroupOffsets);
     return TFALSE;
   }
 
-  iUniqueTspaces = 0;
+  // output tspaces, in group order since both triangles of a quad can share a vertex
   for (g = 0; g < iNrActiveGroups; g++) {
     const SGroup *pGroup = &pGroups[g];
-    int iUniqueSubGroups = 0, s = 0;
+    const STSpace *pTspaces = &pGroupTspaces[piGroupOffsets[g]];
 
     for (i = 0; i < pGroup->iNrFaces; i++)  // triangles
     {
       const int f = pGroup->pFaceIndices[i];  // triangle number
-      int index = -1, iVertIndex = -1, iOF_1 = -1, iMembers = 0, j = 0, l = 0;
-      SSubGroup tmp_group;
-      tbool bFound;
-      SVec3 n, vOs, vOt;
+      int index = -1;
       if (pTriInfos[f].AssignedGroup[0] == pGroup)
         index = 0;
       else if (pTriInfos[f].AssignedGroup[1] == pGroup)
@@ -1158,91 +1328,6 @@ static tbool GenerateTSpaces(STSpace psTspace[],
         index = 2;
       assert(index >= 0 && index < 3);
 
-      iVertIndex = piTriListIn[f * 3 + index];
-      assert(iVertIndex == pGroup->iVertexRepresentitive);
-
-      // is normalized already
-      n = GetNormal(pContext, iVertIndex);
-
-      // project
-      vOs = NormalizeSafe(vsub(pTriInfos[f].vOs, vscale(vdot(n, pTriInfos[f].vOs), n)));
-      vOt = NormalizeSafe(vsub(pTriInfos[f].vOt, vscale(vdot(n, pTriInfos[f].vOt), n)));
-
-      // original face number
-      iOF_1 = pTriInfos[f].iOrgFaceNumber;
-
-      iMembers = 0;
-      for (j = 0; j < pGroup->iNrFaces; j++) {
-        const int t = pGroup->pFaceIndices[j];  // triangle number
-        const int iOF_2 = pTriInfos[t].iOrgFaceNumber;
-
-        // project
-        SVec3 vOs2 = NormalizeSafe(vsub(pTriInfos[t].vOs, vscale(vdot(n, pTriInfos[t].vOs), n)));
-        SVec3 vOt2 = NormalizeSafe(vsub(pTriInfos[t].vOt, vscale(vdot(n, pTriInfos[t].vOt), n)));
-
-        {
-          const tbool bAny = ((pTriInfos[f].iFlag | pTriInfos[t].iFlag) & GROUP_WITH_ANY) != 0 ?
-                                 TTRUE :
-                                 TFALSE;
-          // make sure triangles which belong to the same quad are joined.
-          const tbool bSameOrgFace = iOF_1 == iOF_2 ? TTRUE : TFALSE;
-
-          const float fCosS = vdot(vOs, vOs2);
-          const float fCosT = vdot(vOt, vOt2);
-
-          assert(f != t || bSameOrgFace);  // sanity check
-          if (bAny || bSameOrgFace || (fCosS > fThresCos && fCosT > fThresCos))
-            pTmpMembers[iMembers++] = t;
-        }
-      }
-
-      // sort pTmpMembers
-      tmp_group.iNrFaces = iMembers;
-      tmp_group.pTriMembers = pTmpMembers;
-      if (iMembers > 1) {
-        unsigned int uSeed = INTERNAL_RND_SORT_SEED;  // could replace with a random seed?
-        QuickSort(pTmpMembers, 0, iMembers - 1, uSeed);
-      }
-
-      // look for an existing match
-      bFound = TFALSE;
-      l = 0;
-      while (l < iUniqueSubGroups && !bFound) {
-        bFound = CompareSubGroups(&tmp_group, &pUniSubGroups[l]);
-        if (!bFound)
-          ++l;
-      }
-
-      // assign tangent space index
-      assert(bFound || l == iUniqueSubGroups);
-      // piTempTangIndices[f*3+index] = iUniqueTspaces+l;
-
-      // if no match was found we allocate a new subgroup
-      if (!bFound) {
-        // insert new subgroup
-        int *pIndices = (int *)malloc(sizeof(int) * iMembers);
-        if (pIndices == NULL) {
-          // clean up and return false
-          int s = 0;
-          for (s = 0; s < iUniqueSubGroups; s++)
-            free(pUniSubGroups[s].pTriMembers);
-          free(pUniSubGroups);
-          free(pTmpMembers);
-          free(pSubGroupTspace);
-          return TFALSE;
-        }
-        pUniSubGroups[iUniqueSubGroups].iNrFaces = iMembers;
-        pUniSubGroups[iUniqueSubGroups].pTriMembers = pIndices;
-        memcpy(pIndices, tmp_group.pTriMembers, sizeof(int) * iMembers);
-        pSubGroupTspace[iUniqueSubGroups] = EvalTspace(tmp_group.pTriMembers,
-                                                       iMembers,
-                                                       piTriListIn,
-                                                       pTriInfos,
-                                                       pContext,
-                                                       pGroup->iVertexRepresentitive);
-        ++iUniqueSubGroups;
-      }
-
       // output tspace
       {
         const int iOffs = pTriInfos[f].iTSpacesOffs;
@@ -1251,29 +1336,23 @@ static tbool GenerateTSpaces(STSpace psTspace[],
         assert(pTS_out->iCounter < 2);
         assert(((pTriInfos[f].iFlag & ORIENT_PRESERVING) != 0) == pGroup->bOrientPreservering);
         if (pTS_out->iCounter == 1) {
-          *pTS_out = AvgTSpace(pTS_out, &pSubGroupTspace[l]);
+          *pTS_out = AvgTSpace(pTS_out, &pTspaces[i]);
           pTS_out->iCounter = 2;  // update counter
           pTS_out->bOrient = pGroup->bOrientPreservering;
         }
         else {
           assert(pTS_out->iCounter == 0);
-          *pTS_out = pSubGroupTspace[l];
+          *pTS_out = pTspaces[i];
           pTS_out->iCounter = 1;  // update counter
           pTS_out->bOrient = pGroup->bOrientPreservering;
         }
       }
     }
-
-    // clean up and offset iUniqueTspaces
-    for (s = 0; s < iUniqueSubGroups; s++)
-      free(pUniSubGroups[s].pTriMembers);
-    iUniqueTspaces += iUniqueSubGroups;
   }
 
   // clean up
-  free(pUniSubGroups);
-  free(pTmpMembers);
-  free(pSubGroupTspace);
+  free(pGroupTspaces);
+  free(piGroupOffsets);
 
   return TTRUE;
 }
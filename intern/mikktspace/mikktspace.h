@@ -132,6 +132,8 @@ struct SMikkTSpaceContext {
 };
 
 // these are both thread safe!
+// when built with OpenMP the getters of the interface may be called from multiple threads,
+// results are the same as a serial run.
 // Default (recommended) fAngularThreshold is 180 degrees (which means threshold disabled)
 tbool genTangSpaceDefault(const SMikkTSpaceContext *pContext);
 tbool genTangSpace(const SMikkTSpaceContext *pContext, const float fAngularThreshold);
@@ -54,53 +54,119 @@ void OpenVDBLevelSet::mesh_to_level_set(const float *vertices,
       *xform, points, triangles, quads, 1);
 }
 
+/* Mesh adapter for #openvdb::tools::meshToVolume, reading the triangles from the callers arrays
+ * instead of copies in OpenVDB vectors. */
+class IndexedTriangleAdapter {
+ public:
+  IndexedTriangleAdapter(const float *vertices,
+                         const size_t vertex_stride,
+                         const unsigned int *loop_vertices,
+                         const size_t loop_stride,
+                         const unsigned int *triangle_loops,
+                         const size_t triangle_stride,
+                         const unsigned int totvertices,
+                         const unsigned int tottriangles,
+                         const openvdb::math::Transform &xform)
+      : vertices_((const char *)vertices),
+        vertex_stride_(vertex_stride),
+        loop_vertices_((const char *)loop_vertices),
+        loop_stride_(loop_stride),
+        triangle_loops_((const char *)triangle_loops),
+        triangle_stride_(triangle_stride),
+        totvertices_(totvertices),
+        tottriangles_(tottriangles),
+        xform_(xform)
+  {
+  }
+
+  size_t polygonCount() const
+  {
+    return tottriangles_;
+  }
+
+  size_t pointCount() const
+  {
+    return totvertices_;
+  }
+
+  size_t vertexCount(size_t /*n*/) const
+  {
+    return 3;
+  }
+
+  /* Called from the conversion threads. */
+  void getIndexSpacePoint(size_t n, size_t v, openvdb::Vec3d &pos) const
+  {
+    const unsigned int loop = ((const unsigned int *)(triangle_loops_ + n * triangle_stride_))[v];
+    const unsigned int vertex = *(const unsigned int *)(loop_vertices_ + loop * loop_stride_);
+    const float *co = (const float *)(vertices_ + vertex * vertex_stride_);
+    pos = xform_.worldToIndex(openvdb::Vec3d(co[0], co[1], co[2]));
+  }
+
+ private:
+  const char *vertices_;
+  size_t vertex_stride_;
+  const char *loop_vertices_;
+  size_t loop_stride_;
+  const char *triangle_loops_;
+  size_t triangle_stride_;
+  size_t totvertices_;
+  size_t tottriangles_;
+  const openvdb::math::Transform &xform_;
+};
+
+void OpenVDBLevelSet::mesh_to_level_set_indexed(const float *vertices,
+                                                const size_t vertex_stride,
+                                                const unsigned int *loop_vertices,
+                                                const size_t loop_stride,
+                                                const unsigned int *triangle_loops,
+                                                const size_t triangle_stride,
+                                                const unsigned int totvertices,
+                                                const unsigned int tottriangles,
+                                                const openvdb::math::Transform::Ptr &xform)
+{
+  const IndexedTriangleAdapter mesh(vertices,
+                                    vertex_stride,
+                                    loop_vertices,
+                                    loop_stride,
+                                    triangle_loops,
+                                    triangle_stride,
+                                    totvertices,
+                                    tottriangles,
+                                    *xform);
+
+  /* Same band width as #mesh_to_level_set. */
+  const float half_width = 1.0f;
+  this->grid = openvdb::tools::meshToVolume<openvdb::FloatGrid>(
+      mesh, *xform, half_width, half_width);
+}
+
 void OpenVDBLevelSet::volume_to_mesh(OpenVDBVolumeToMeshData *mesh,
                                      const double isovalue,
                                      const double adaptivity,
                                      const bool relax_disoriented_triangles)
 {
-  std::vector<openvdb::Vec3s> out_points;
-  std::vector<openvdb::Vec4I> out_quads;
-  std::vector<openvdb::Vec3I> out_tris;
+  /* The points and polygons are passed on as they are, without copying them into other
+   * arrays. Vectors of OpenVDB's Vec3 and Vec4 types are tightly packed arrays of their
+   * values. */
+  this->out_points.clear();
+  this->out_quads.clear();
+  this->out_tris.clear();
   openvdb::tools::volumeToMesh<openvdb::FloatGrid>(*this->grid,
-                                                   out_points,
-                                                   out_tris,
-                                                   out_quads,
+                                                   this->out_points,
+                                                   this->out_tris,
+                                                   this->out_quads,
                                                    isovalue,
                                                    adaptivity,
                                                    relax_disoriented_triangles);
-  mesh->vertices = (float *)MEM_malloc_arrayN(
-      out_points.size(), 3 * sizeof(float), "openvdb remesher out verts");
-  mesh->quads = (unsigned int *)MEM_malloc_arrayN(
-      out_quads.size(), 4 * sizeof(unsigned int), "openvdb remesh out quads");
-  mesh->triangles = NULL;
-  if (out_tris.size() > 0) {
-    mesh->triangles = (unsigned int *)MEM_malloc_arrayN(
-        out_tris.size(), 3 * sizeof(unsigned int), "openvdb remesh out tris");
-  }
 
-  mesh->totvertices = out_points.size();
-  mesh->tottriangles = out_tris.size();
-  mesh->totquads = out_quads.size();
+  mesh->totvertices = this->out_points.size();
+  mesh->tottriangles = this->out_tris.size();
+  mesh->totquads = this->out_quads.size();
 
-  for (size_t i = 0; i < out_points.size(); i++) {
-    mesh->vertices[i * 3] = out_points[i].x();
-    mesh->vertices[i * 3 + 1] = out_points[i].y();
-    mesh->vertices[i * 3 + 2] = out_points[i].z();
-  }
-
-  for (size_t i = 0; i < out_quads.size(); i++) {
-    mesh->quads[i * 4] = out_quads[i].x();
-    mesh->quads[i * 4 + 1] = out_quads[i].y();
-    mesh->quads[i * 4 + 2] = out_quads[i].z();
-    mesh->quads[i * 4 + 3] = out_quads[i].w();
-  }
-
-  for (size_t i = 0; i < out_tris.size(); i++) {
-    mesh->triangles[i * 3] = out_tris[i].x();
-    mesh->triangles[i * 3 + 1] = out_tris[i].y();
-    mesh->triangles[i * 3 + 2] = out_tris[i].z();
-  }
+  mesh->vertices = (mesh->totvertices > 0) ? this->out_points[0].asPointer() : NULL;
+  mesh->quads = (mesh->totquads > 0) ? this->out_quads[0].asPointer() : NULL;
+  mesh->triangles = (mesh->tottriangles > 0) ? this->out_tris[0].asPointer() : NULL;
 }
 
 void OpenVDBLevelSet::filter(OpenVDBLevelSet_FilterType filter_type,
@@ -31,6 +31,10 @@
 struct OpenVDBLevelSet {
  private:
   openvdb::FloatGrid::Ptr grid;
+  /* Result of #volume_to_mesh. */
+  std::vector<openvdb::Vec3s> out_points;
+  std::vector<openvdb::Vec4I> out_quads;
+  std::vector<openvdb::Vec3I> out_tris;
 
  public:
   OpenVDBLevelSet();
@@ -43,6 +47,15 @@ struct OpenVDBLevelSet {
                          const unsigned int totvertices,
                          const unsigned int totfaces,
                          const openvdb::math::Transform::Ptr &transform);
+  void mesh_to_level_set_indexed(const float *vertices,
+                                 const size_t vertex_stride,
+                                 const unsigned int *loop_vertices,
+                                 const size_t loop_stride,
+                                 const unsigned int *triangle_loops,
+                                 const size_t triangle_stride,
+                                 const unsigned int totvertices,
+                                 const unsigned int tottriangles,
+                                 const openvdb::math::Transform::Ptr &transform);
 
   void volume_to_mesh(struct OpenVDBVolumeToMeshData *mesh,
                       const double isovalue,
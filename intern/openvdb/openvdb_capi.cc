@@ -285,6 +285,28 @@ void OpenVDBLevelSet_mesh_to_level_set_transform(struct OpenVDBLevelSet *level_s
   level_set->mesh_to_level_set(vertices, faces, totvertices, totfaces, transform->get_transform());
 }
 
+void OpenVDBLevelSet_mesh_to_level_set_indexed(struct OpenVDBLevelSet *level_set,
+                                               const float *vertices,
+                                               const size_t vertex_stride,
+                                               const unsigned int *loop_vertices,
+                                               const size_t loop_stride,
+                                               const unsigned int *triangle_loops,
+                                               const size_t triangle_stride,
+                                               const unsigned int totvertices,
+                                               const unsigned int tottriangles,
+                                               OpenVDBTransform *xform)
+{
+  level_set->mesh_to_level_set_indexed(vertices,
+                                       vertex_stride,
+                                       loop_vertices,
+                                       loop_stride,
+                                       triangle_loops,
+                                       triangle_stride,
+                                       totvertices,
+                                       tottriangles,
+                                       xform->get_transform());
+}
+
 void OpenVDBLevelSet_volume_to_mesh(struct OpenVDBLevelSet *level_set,
                                     struct OpenVDBVolumeToMeshData *mesh,
                                     const double isovalue,
@@ -66,14 +66,15 @@ struct OpenVDBFloatGrid;
 struct OpenVDBIntGrid;
 struct OpenVDBVectorGrid;
 
+/* The arrays are owned by the level set, until it's freed or meshed again. */
 struct OpenVDBVolumeToMeshData {
   int tottriangles;
   int totquads;
   int totvertices;
 
-  float *vertices;
-  unsigned int *quads;
-  unsigned int *triangles;
+  const float *vertices;
+  const unsigned int *quads;
+  const unsigned int *triangles;
 };
 
 struct OpenVDBRemeshData {
@@ -199,6 +200,18 @@ void OpenVDBLevelSet_mesh_to_level_set_transform(struct OpenVDBLevelSet *level_s
                                                  const unsigned int totvertices,
                                                  const unsigned int totfaces,
                                                  struct OpenVDBTransform *transform);
+/* Triangles of loop indices, where every loop has a vertex index. All arrays are read in place
+ * with their stride, so the callers data doesn't have to be copied. */
+void OpenVDBLevelSet_mesh_to_level_set_indexed(struct OpenVDBLevelSet *level_set,
+                                               const float *vertices,
+                                               const size_t vertex_stride,
+                                               const unsigned int *loop_vertices,
+                                               const size_t loop_stride,
+                                               const unsigned int *triangle_loops,
+                                               const size_t triangle_stride,
+                                               const unsigned int totvertices,
+                                               const unsigned int tottriangles,
+                                               struct OpenVDBTransform *xform);
 void OpenVDBLevelSet_volume_to_mesh(struct OpenVDBLevelSet *level_set,
                                     struct OpenVDBVolumeToMeshData *mesh,
                                     const double isovalue,
@@ -43,8 +43,46 @@ def _initialize():
     path_list = paths()
     for path in path_list:
         _bpy.utils._sys_path_ensure_append(path)
+    addons_deferred = []
     for addon in _preferences.addons:
-        enable(addon.module)
+        if _bpy.app.background or not _defer_load_check(addon.module):
+            enable(addon.module)
+        else:
+            addons_deferred.append(addon.module)
+    if addons_deferred:
+        _enable_deferred(addons_deferred)
+
+
+def _defer_load_check(module_name):
+    """
+    Add-ons which don't have to be registered before the window is shown
+    can declare ``"defer_load": True`` in their ``bl_info``,
+    read here without importing the add-on.
+    """
+    import importlib.util
+    try:
+        spec = importlib.util.find_spec(module_name)
+    except (ImportError, ValueError):
+        return False
+    if spec is None or not spec.has_location:
+        return False
+    mod = _fake_module(module_name, spec.origin)
+    return bool(mod and mod.bl_info.get("defer_load", False))
+
+
+def _enable_deferred(module_names):
+    # Enable one add-on per timer call, so the window redraws in between.
+    module_names = list(module_names)
+
+    def enable_next():
+        module_name = module_names.pop(0)
+        is_enabled, is_loaded = check(module_name)
+        # Skip add-ons which were disabled or enabled in the meantime.
+        if is_enabled and not is_loaded:
+            enable(module_name)
+        return 0.0 if module_names else None
+
+    _bpy.app.timers.register(enable_next, first_interval=0.0, persistent=True)
 
 
 def paths():
@@ -58,102 +96,104 @@ def paths():
     return addon_paths
 
 
-def modules_refresh(module_cache=addons_fake_modules):
+# fake module importing
+def _fake_module(mod_name, mod_path, speedy=True, force_support=None):
     global error_encoding
     import os
 
-    error_encoding = False
-    error_duplicates.clear()
-
-    path_list = paths()
-
-    # fake module importing
-    def fake_module(mod_name, mod_path, speedy=True, force_support=None):
-        global error_encoding
-
-        if _bpy.app.debug_python:
-            print("fake_module", mod_path, mod_name)
-        import ast
-        ModuleType = type(ast)
-        try:
-            file_mod = open(mod_path, "r", encoding='UTF-8')
-        except OSError as ex:
-            print("Error opening file:", mod_path, ex)
-            return None
+    if _bpy.app.debug_python:
+        print("fake_module", mod_path, mod_name)
+    import ast
+    ModuleType = type(ast)
+    try:
+        file_mod = open(mod_path, "r", encoding='UTF-8')
+    except OSError as ex:
+        print("Error opening file:", mod_path, ex)
+        return None
+
+    with file_mod:
+        if speedy:
+            lines = []
+            line_iter = iter(file_mod)
+            l = ""
+            while not l.startswith("bl_info"):
+                try:
+                    l = line_iter.readline()
+                except UnicodeDecodeError as ex:
+                    if not error_encoding:
+                        error_encoding = True
+                        print("Error reading file as UTF-8:", mod_path, ex)
+                    return None
+
+                if len(l) == 0:
+                    break
+            while l.rstrip():
+                lines.append(l)
+                try:
+                    l = line_iter.readline()
+                except UnicodeDecodeError as ex:
+                    if not error_encoding:
+                        error_encoding = True
+                        print("Error reading file as UTF-8:", mod_path, ex)
+                    return None
+
+            data = "".join(lines)
 
-        with file_mod:
-            if speedy:
-                lines = []
-                line_iter = iter(file_mod)
-                l = ""
-                while not l.startswith("bl_info"):
-                    try:
-                        l = line_iter.readline()
-                    except UnicodeDecodeError as ex:
-                        if not error_encoding:
-                            error_encoding = True
-                            print("Error reading file as UTF-8:", mod_path, ex)
-                        return None
-
-                    if len(l) == 0:
+        else:
+            data = file_mod.read()
+    del file_mod
+
+    try:
+        ast_data = ast.parse(data, filename=mod_path)
+    except:
+        print("Syntax error 'ast.parse' can't read:", repr(mod_path))
+        import traceback
+        traceback.print_exc()
+        ast_data = None
+
+    body_info = None
+
+    if ast_data:
+        for body in ast_data.body:
+            if body.__class__ == ast.Assign:
+                if len(body.targets) == 1:
+                    if getattr(body.targets[0], "id", "") == "bl_info":
+                        body_info = body
                         break
-                while l.rstrip():
-                    lines.append(l)
-                    try:
-                        l = line_iter.readline()
-                    except UnicodeDecodeError as ex:
-                        if not error_encoding:
-                            error_encoding = True
-                            print("Error reading file as UTF-8:", mod_path, ex)
-                        return None
-
-                data = "".join(lines)
-
-            else:
-                data = file_mod.read()
-        del file_mod
 
+    if body_info:
         try:
-            ast_data = ast.parse(data, filename=mod_path)
+            mod = ModuleType(mod_name)
+            mod.bl_info = ast.literal_eval(body.value)
+            mod.__file__ = mod_path
+            mod.__time__ = os.path.getmtime(mod_path)
         except:
-            print("Syntax error 'ast.parse' can't read:", repr(mod_path))
+            print("AST error parsing bl_info for:", mod_name)
             import traceback
             traceback.print_exc()
-            ast_data = None
+            raise
 
-        body_info = None
+        if force_support is not None:
+            mod.bl_info["support"] = force_support
 
-        if ast_data:
-            for body in ast_data.body:
-                if body.__class__ == ast.Assign:
-                    if len(body.targets) == 1:
-                        if getattr(body.targets[0], "id", "") == "bl_info":
-                            body_info = body
-                            break
+        return mod
+    else:
+        print(
+            "fake_module: addon missing 'bl_info' "
+            "gives bad performance!:",
+            repr(mod_path),
+        )
+        return None
 
-        if body_info:
-            try:
-                mod = ModuleType(mod_name)
-                mod.bl_info = ast.literal_eval(body.value)
-                mod.__file__ = mod_path
-                mod.__time__ = os.path.getmtime(mod_path)
-            except:
-                print("AST error parsing bl_info for:", mod_name)
-                import traceback
-                traceback.print_exc()
-                raise
-
-            if force_support is not None:
-                mod.bl_info["support"] = force_support
-
-            return mod
-        else:
-            print(
-                "fake_module: addon missing 'bl_info' "
-                "gives bad performance!:",
-                repr(mod_path),
-            )
-            return None
+
+def modules_refresh(module_cache=addons_fake_modules):
+    global error_encoding
+    import os
+
+    error_encoding = False
+    error_duplicates.clear()
+
+    path_list = paths()
 
     modules_stale = set(module_cache.keys())
 
@@ -189,7 +229,7 @@ def modules_refresh(module_cache=addons_fake_modules):
                     mod = None
 
             if mod is None:
-                mod = fake_module(
+                mod = _fake_module(
                     mod_name,
                     mod_path,
                     force_support=force_support,
@@ -514,6 +554,7 @@ def module_bl_info(mod, info_basis=None):
             "warning": "",
             "show_expanded": False,
             "use_owner": True,
+            "defer_load": False,
         }
 
     addon_info = getattr(mod, "bl_info", {})
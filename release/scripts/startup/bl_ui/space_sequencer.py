@@ -1766,6 +1766,8 @@ class SEQUENCER_PT_cache_settings(SequencerButtonsPanel, Panel):
         col.prop(ed, "use_cache_composite")
         col.prop(ed, "use_cache_final")
         col.separator()
+        col.prop(ed, "use_cache_disk")
+        col.separator()
         col.prop(ed, "recycle_max_cost")
 
 
@@ -602,14 +602,25 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         flow = layout.grid_flow(row_major=False, columns=0, even_columns=True, even_rows=False, align=False)
 
         flow.prop(system, "memory_cache_limit", text="Sequencer Cache Limit")
+        flow.prop(system, "modifier_cache_limit", text="Modifier Cache Limit")
+        flow.prop(system, "compositor_cache_limit", text="Compositor Cache Limit")
         flow.prop(system, "scrollback", text="Console Scrollback Lines")
 
         layout.separator()
 
         flow = layout.grid_flow(row_major=False, columns=0, even_columns=True, even_rows=False, align=False)
 
+        flow.prop(system, "sequencer_disk_cache_dir", text="Sequencer Disk Cache")
+        flow.prop(system, "sequencer_disk_cache_size_limit", text="Disk Cache Limit")
+        flow.prop(system, "sequencer_disk_cache_compression", text="Disk Cache Compression")
+
+        layout.separator()
+
+        flow = layout.grid_flow(row_major=False, columns=0, even_columns=True, even_rows=False, align=False)
+
         flow.prop(system, "texture_time_out", text="Texture Time Out")
         flow.prop(system, "texture_collection_rate", text="Garbage Collection Rate")
+        flow.prop(system, "texture_memory_limit", text="Texture Memory Limit")
 
         layout.separator()
 
@@ -618,6 +629,12 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         flow.prop(system, "vbo_time_out", text="Vbo Time Out")
         flow.prop(system, "vbo_collection_rate", text="Garbage Collection Rate")
 
+        layout.separator()
+
+        flow = layout.grid_flow(row_major=False, columns=0, even_columns=True, even_rows=False, align=False)
+
+        flow.prop(system, "use_shader_cache")
+
 
 # -----------------------------------------------------------------------------
 # Viewport Panels
@@ -672,6 +689,8 @@ class USERPREF_PT_viewport_quality(ViewportPanel, CenterAlignMixIn, Panel):
         flow.prop(system, "gpencil_multi_sample", text="Grease Pencil Multisampling")
         flow.prop(system, "use_overlay_smooth_wire")
         flow.prop(system, "use_edit_mode_smooth_wire")
+        flow.prop(system, "use_compact_vertex_data")
+        flow.prop(system, "use_viewport_lod")
 
 
 class USERPREF_PT_viewport_textures(ViewportPanel, CenterAlignMixIn, Panel):
@@ -705,6 +705,11 @@ static void import_startjob(void *user_data, short *stop, short *do_update, floa
   chrono_t min_time = std::numeric_limits<chrono_t>::max();
   chrono_t max_time = std::numeric_limits<chrono_t>::min();
 
+  /* Readers only add objects and meshes, index their names to avoid going over the growing lists
+   * for every new one. */
+  BKE_id_new_name_index_begin(&data->bmain->objects);
+  BKE_id_new_name_index_begin(&data->bmain->meshes);
+
   ISampleSelector sample_sel(0.0f);
   std::vector<AbcObjectReader *>::iterator iter;
   for (iter = data->readers.begin(); iter != data->readers.end(); ++iter) {
@@ -726,10 +731,17 @@ static void import_startjob(void *user_data, short *stop, short *do_update, floa
 
     if (G.is_break) {
       data->was_cancelled = true;
-      return;
+      break;
     }
   }
 
+  BKE_id_new_name_index_end(&data->bmain->meshes);
+  BKE_id_new_name_index_end(&data->bmain->objects);
+
+  if (data->was_cancelled) {
+    return;
+  }
+
   if (data->settings.set_frame_range) {
     Scene *scene = data->scene;
 
@@ -124,6 +124,7 @@ void BLF_exit(void)
     }
   }
 
+  blf_glyph_atlas_clear();
   blf_font_exit();
 }
 
@@ -144,6 +145,9 @@ void BLF_cache_clear(void)
       blf_kerning_cache_clear(font);
     }
   }
+
+  /* no glyphs use the atlas anymore */
+  blf_glyph_atlas_clear();
 }
 
 static int blf_search(const char *name)
@@ -584,9 +588,6 @@ static void blf_draw_gl__start(FontBLF *font)
    * in BLF_position (old ui_rasterpos_safe).
    */
 
-  /* always bind the texture for the first glyph */
-  font->tex_bind_state = 0;
-
   if ((font->flags & (BLF_ROTATION | BLF_MATRIX | BLF_ASPECT)) == 0) {
     return; /* glyphs will be translated individually and batched. */
   }
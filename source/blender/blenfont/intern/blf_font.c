@@ -123,7 +123,7 @@ void blf_batch_draw_begin(FontBLF *font)
     blf_batch_draw_init();
   }
 
-  const bool font_changed = (g_batch.font != font);
+  /* Glyphs of all fonts share the same textures, switching font doesn't need a flush. */
   const bool simple_shader = ((font->flags & (BLF_ROTATION | BLF_MATRIX | BLF_ASPECT)) == 0);
   const bool shader_changed = (simple_shader != g_batch.simple_shader);
 
@@ -153,10 +153,9 @@ void blf_batch_draw_begin(FontBLF *font)
     }
 
     /* flush cache if config is not the same. */
-    if (mat_changed || font_changed || shader_changed) {
+    if (mat_changed || shader_changed) {
       blf_batch_draw();
       g_batch.simple_shader = simple_shader;
-      g_batch.font = font;
     }
     else {
       /* Nothing changed continue batching. */
@@ -172,7 +171,6 @@ void blf_batch_draw_begin(FontBLF *font)
   else {
     /* flush cache */
     blf_batch_draw();
-    g_batch.font = font;
     g_batch.simple_shader = simple_shader;
   }
 }
@@ -143,13 +143,6 @@ GlyphCacheBLF *blf_glyph_cache_new(FontBLF *font)
   memset(gc->glyph_ascii_table, 0, sizeof(gc->glyph_ascii_table));
   memset(gc->bucket, 0, sizeof(gc->bucket));
 
-  gc->textures = (GPUTexture **)MEM_callocN(sizeof(GPUTexture *) * 256, __func__);
-  gc->textures_len = 256;
-  gc->texture_current = BLF_TEXTURE_UNSET;
-  gc->offset_x = 3; /* enough padding for blur */
-  gc->offset_y = 3; /* enough padding for blur */
-  gc->pad = 6;
-
   gc->glyphs_len_max = (int)font->face->num_glyphs;
   gc->glyphs_len_free = (int)font->face->num_glyphs;
   gc->ascender = ((float)font->face->size->metrics.ascender) / 64.0f;
@@ -173,9 +166,6 @@ GlyphCacheBLF *blf_glyph_cache_new(FontBLF *font)
   CLAMP_MIN(gc->glyph_width_max, 1);
   CLAMP_MIN(gc->glyph_height_max, 1);
 
-  gc->p2_width = 0;
-  gc->p2_height = 0;
-
   BLI_addhead(&font->cache, gc);
   return gc;
 }
@@ -229,54 +219,98 @@ void blf_glyph_cache_free(GlyphCacheBLF *gc)
       blf_glyph_free(g);
     }
   }
-  for (i = 0; i < gc->textures_len; i++) {
-    if (gc->textures[i]) {
-      GPU_texture_free(gc->textures[i]);
-    }
-  }
-  MEM_freeN(gc->textures);
   MEM_freeN(gc);
 }
 
-static void blf_glyph_cache_texture(FontBLF *font, GlyphCacheBLF *gc)
+/* -------------------------------------------------------------------- */
+/** \name Glyph Atlas
+ *
+ * The glyphs of all the fonts and sizes are packed in rows into the same textures.
+ * The space of the glyphs of a freed cache is only reclaimed when all caches are cleared.
+ * \{ */
+
+static GlyphAtlasBLF g_atlas = {NULL, 0, BLF_TEXTURE_UNSET};
+
+static void blf_glyph_atlas_texture_add(FontBLF *font, int slot_width, int slot_height)
 {
-  int i;
   char error[256];
 
   /* move the index. */
-  gc->texture_current++;
-
-  if (UNLIKELY(gc->texture_current >= gc->textures_len)) {
-    gc->textures_len *= 2;
-    gc->textures = MEM_recallocN((void *)gc->textures, sizeof(GPUTexture *) * gc->textures_len);
-  }
+  g_atlas.texture_current++;
 
-  gc->p2_width = (int)blf_next_p2(
-      (unsigned int)((gc->glyphs_len_free * gc->glyph_width_max) + (gc->pad * 2)));
-  if (gc->p2_width > font->tex_size_max) {
-    gc->p2_width = font->tex_size_max;
+  if (UNLIKELY(g_atlas.texture_current >= g_atlas.textures_len)) {
+    g_atlas.textures_len = (g_atlas.textures_len == 0) ? 16 : g_atlas.textures_len * 2;
+    g_atlas.textures = MEM_recallocN_id(
+        g_atlas.textures, sizeof(GPUTexture *) * g_atlas.textures_len, __func__);
   }
 
-  i = (int)((gc->p2_width - (gc->pad * 2)) / gc->glyph_width_max);
-  gc->p2_height = (int)blf_next_p2(
-      (unsigned int)(((gc->glyphs_len_max / i) + 1) * gc->glyph_height_max + (gc->pad * 2)));
+  /* glyphs of very big fonts get a texture of their own */
+  int size = (int)blf_next_p2((unsigned int)max_ii(slot_width, slot_height));
+  size = min_ii(max_ii(size, BLF_ATLAS_SIZE), font->tex_size_max);
 
-  if (gc->p2_height > font->tex_size_max) {
-    gc->p2_height = font->tex_size_max;
-  }
+  g_atlas.width = size;
+  g_atlas.height = size;
+  g_atlas.offset_x = 0;
+  g_atlas.offset_y = 0;
+  g_atlas.row_height = 0;
 
-  unsigned char *pixels = MEM_callocN((size_t)gc->p2_width * (size_t)gc->p2_height,
-                                      "BLF texture init");
+  unsigned char *pixels = MEM_callocN((size_t)size * (size_t)size, "BLF texture init");
   GPUTexture *tex = GPU_texture_create_nD(
-      gc->p2_width, gc->p2_height, 0, 2, pixels, GPU_R8, GPU_DATA_UNSIGNED_BYTE, 0, false, error);
+      size, size, 0, 2, pixels, GPU_R8, GPU_DATA_UNSIGNED_BYTE, 0, false, error);
   MEM_freeN(pixels);
-  gc->textures[gc->texture_current] = tex;
+  g_atlas.textures[g_atlas.texture_current] = tex;
   GPU_texture_bind(tex, 0);
   GPU_texture_wrap_mode(tex, false);
   GPU_texture_filters(tex, GPU_NEAREST, GPU_LINEAR);
   GPU_texture_unbind(tex);
 }
 
+/* Reserve space for the glyph, sets its texture and offset inside of it. */
+static void blf_glyph_atlas_insert(FontBLF *font, GlyphBLF *g)
+{
+  const int slot_width = g->width + BLF_ATLAS_PAD * 2;
+  const int slot_height = g->height + BLF_ATLAS_PAD * 2;
+
+  if (g_atlas.texture_current == BLF_TEXTURE_UNSET) {
+    blf_glyph_atlas_texture_add(font, slot_width, slot_height);
+  }
+  else {
+    if (g_atlas.offset_x + slot_width > g_atlas.width) {
+      /* start a new row */
+      g_atlas.offset_x = 0;
+      g_atlas.offset_y += g_atlas.row_height;
+      g_atlas.row_height = 0;
+    }
+    if (g_atlas.offset_y + slot_height > g_atlas.height) {
+      blf_glyph_atlas_texture_add(font, slot_width, slot_height);
+    }
+  }
+
+  g->tex = g_atlas.textures[g_atlas.texture_current];
+  g->offset_x = g_atlas.offset_x + BLF_ATLAS_PAD;
+  g->offset_y = g_atlas.offset_y + BLF_ATLAS_PAD;
+
+  g_atlas.offset_x += slot_width;
+  g_atlas.row_height = max_ii(g_atlas.row_height, slot_height);
+}
+
+void blf_glyph_atlas_clear(void)
+{
+  for (unsigned int i = 0; i < g_atlas.textures_len; i++) {
+    if (g_atlas.textures[i]) {
+      GPU_texture_free(g_atlas.textures[i]);
+    }
+  }
+  MEM_SAFE_FREE(g_atlas.textures);
+  memset(&g_atlas, 0, sizeof(g_atlas));
+  g_atlas.texture_current = BLF_TEXTURE_UNSET;
+
+  /* the batch must not reference a freed texture */
+  g_batch.tex_bind_state = NULL;
+}
+
+/** \} */
+
 GlyphBLF *blf_glyph_search(GlyphCacheBLF *gc, unsigned int c)
 {
   GlyphBLF *p;
@@ -523,35 +557,19 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
       font->tex_size_max = GPU_max_texture_size();
     }
 
-    if (gc->texture_current == BLF_TEXTURE_UNSET) {
-      blf_glyph_cache_texture(font, gc);
-      gc->offset_x = gc->pad;
-      gc->offset_y = 3; /* enough padding for blur */
-    }
-
-    if (gc->offset_x > (gc->p2_width - gc->glyph_width_max)) {
-      gc->offset_x = gc->pad;
-      gc->offset_y += gc->glyph_height_max;
-
-      if (gc->offset_y > (gc->p2_height - gc->glyph_height_max)) {
-        gc->offset_y = 3; /* enough padding for blur */
-        blf_glyph_cache_texture(font, gc);
-      }
-    }
-
-    g->tex = gc->textures[gc->texture_current];
-    g->offset_x = gc->offset_x;
-    g->offset_y = gc->offset_y;
+    blf_glyph_atlas_insert(font, g);
+    const int tex_width = GPU_texture_width(g->tex);
+    const int tex_height = GPU_texture_height(g->tex);
 
     /* prevent glTexSubImage2D from failing if the character
      * asks for pixels out of bounds, this tends only to happen
      * with very small sizes (5px high or less) */
-    if (UNLIKELY((g->offset_x + g->width) > gc->p2_width)) {
-      g->width -= (g->offset_x + g->width) - gc->p2_width;
+    if (UNLIKELY((g->offset_x + g->width) > tex_width)) {
+      g->width -= (g->offset_x + g->width) - tex_width;
       BLI_assert(g->width > 0);
     }
-    if (UNLIKELY((g->offset_y + g->height) > gc->p2_height)) {
-      g->height -= (g->offset_y + g->height) - gc->p2_height;
+    if (UNLIKELY((g->offset_y + g->height) > tex_height)) {
+      g->height -= (g->offset_y + g->height) - tex_height;
       BLI_assert(g->height > 0);
     }
 
@@ -565,13 +583,10 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
                            g->height,
                            0);
 
-    g->uv[0][0] = ((float)g->offset_x) / ((float)gc->p2_width);
-    g->uv[0][1] = ((float)g->offset_y) / ((float)gc->p2_height);
-    g->uv[1][0] = ((float)(g->offset_x + g->width)) / ((float)gc->p2_width);
-    g->uv[1][1] = ((float)(g->offset_y + g->height)) / ((float)gc->p2_height);
-
-    /* update the x offset for the next glyph. */
-    gc->offset_x += (int)BLI_rctf_size_x(&g->box) + gc->pad;
+    g->uv[0][0] = ((float)g->offset_x) / ((float)tex_width);
+    g->uv[0][1] = ((float)g->offset_y) / ((float)tex_height);
+    g->uv[1][0] = ((float)(g->offset_x + g->width)) / ((float)tex_width);
+    g->uv[1][1] = ((float)(g->offset_y + g->height)) / ((float)tex_height);
 
     gc->glyphs_len_free--;
     g->build_tex = 1;
@@ -587,13 +602,15 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
     }
   }
 
-  if (font->tex_bind_state != g->tex) {
+  /* the batch can only hold glyphs of the same texture */
+  if (g_batch.tex_bind_state != g->tex) {
     blf_batch_draw();
-    font->tex_bind_state = g->tex;
-    GPU_texture_bind(font->tex_bind_state, 0);
+    g_batch.tex_bind_state = g->tex;
   }
 
-  g_batch.tex_bind_state = g->tex;
+  /* for blurring */
+  const int tex_width = GPU_texture_width(g->tex);
+  const int tex_height = GPU_texture_height(g->tex);
 
   if (font->flags & BLF_SHADOW) {
     rctf rect_ofs;
@@ -605,8 +622,8 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
     }
     else if (font->shadow <= 4) {
       blf_texture3_draw(font->shadow_color,
-                        gc->p2_width,
-                        gc->p2_height,
+                        tex_width,
+                        tex_height,
                         g->uv,
                         rect_ofs.xmin,
                         rect_ofs.ymin,
@@ -615,8 +632,8 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
     }
     else {
       blf_texture5_draw(font->shadow_color,
-                        gc->p2_width,
-                        gc->p2_height,
+                        tex_width,
+                        tex_height,
                         g->uv,
                         rect_ofs.xmin,
                         rect_ofs.ymin,
@@ -632,8 +649,8 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
   switch (font->blur) {
     case 3:
       blf_texture3_draw(font->color,
-                        gc->p2_width,
-                        gc->p2_height,
+                        tex_width,
+                        tex_height,
                         g->uv,
                         rect.xmin,
                         rect.ymin,
@@ -642,8 +659,8 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
       break;
     case 5:
       blf_texture5_draw(font->color,
-                        gc->p2_width,
-                        gc->p2_height,
+                        tex_width,
+                        tex_height,
                         g->uv,
                         rect.xmin,
                         rect.ymin,
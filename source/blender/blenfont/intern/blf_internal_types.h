@@ -30,7 +30,6 @@
 #define BLF_BATCH_DRAW_LEN_MAX 2048 /* in glyph */
 
 typedef struct BatchBLF {
-  struct FontBLF *font; /* can only batch glyph from the same font */
   struct GPUBatch *batch;
   struct GPUVertBuf *verts;
   struct GPUVertBufRaw pos_step, tex_step, col_step;
@@ -44,6 +43,30 @@ typedef struct BatchBLF {
 
 extern BatchBLF g_batch;
 
+#define BLF_ATLAS_SIZE 1024
+/* space around every glyph, enough for blurring */
+#define BLF_ATLAS_PAD 3
+
+/* Textures shared by the glyphs of every font and size, so strings using different
+ * fonts can be drawn with a single batch. */
+typedef struct GlyphAtlasBLF {
+  GPUTexture **textures;
+  unsigned int textures_len;
+  /* the last texture, aka. the one new glyphs are added to. */
+  unsigned int texture_current;
+
+  /* size of the current texture. */
+  int width;
+  int height;
+
+  /* position of the next glyph inside the current texture. */
+  int offset_x;
+  int offset_y;
+
+  /* height of the tallest glyph in the current row. */
+  int row_height;
+} GlyphAtlasBLF;
+
 typedef struct KerningCacheBLF {
   struct KerningCacheBLF *next, *prev;
 
@@ -71,31 +94,10 @@ typedef struct GlyphCacheBLF {
   /* fast ascii lookup */
   struct GlyphBLF *glyph_ascii_table[256];
 
-  /* texture array, to draw the glyphs. */
-  GPUTexture **textures;
-
-  /* size of the array. */
-  unsigned int textures_len;
-
-  /* and the last texture, aka. the current texture. */
-  unsigned int texture_current;
-
-  /* We draw every glyph in a big texture, so this is the
-   * current position inside the texture. */
-  int offset_x;
-  int offset_y;
-
-  /* and the space from one to other. */
-  int pad;
-
   /* and the bigger glyph in the font. */
   int glyph_width_max;
   int glyph_height_max;
 
-  /* next two integer power of two, to build the texture. */
-  int p2_width;
-  int p2_height;
-
   /* number of glyphs in the font. */
   int glyphs_len_max;
 
@@ -239,9 +241,6 @@ typedef struct FontBLF {
   /* max texture size. */
   int tex_size_max;
 
-  /* cache current OpenGL texture to save calls into the API */
-  GPUTexture *tex_bind_state;
-
   /* font options. */
   int flags;
 
@@ -299,6 +299,7 @@ void BKE_animsys_eval_driver(struct Depsgraph *depsgraph,
                              struct FCurve *fcu_orig);
 
 void BKE_animsys_update_driver_array(struct ID *id);
+void BKE_animsys_clear_rna_path_cache(struct ID *id);
 
 /* ************************************* */
 
@@ -164,6 +164,8 @@ enum {
 enum {
   G_FILE_AUTOPACK = (1 << 0),
   G_FILE_COMPRESS = (1 << 1),
+  /** Use (multi-threaded) block compression instead of gzip when compressing (needs LZO). */
+  G_FILE_COMPRESS_FAST = (1 << 2),
 
   G_FILE_USERPREFS = (1 << 9),
   G_FILE_NO_UI = (1 << 10),
@@ -205,6 +205,8 @@ void BKE_id_copy_ensure_local(struct Main *bmain, const struct ID *old_id, struc
 
 bool BKE_id_new_name_validate(struct ListBase *lb, struct ID *id, const char *name)
     ATTR_NONNULL(1, 2);
+void BKE_id_new_name_index_begin(struct ListBase *lb) ATTR_NONNULL();
+void BKE_id_new_name_index_end(struct ListBase *lb) ATTR_NONNULL();
 void id_clear_lib_data(struct Main *bmain, struct ID *id);
 void id_clear_lib_data_ex(struct Main *bmain, struct ID *id, const bool id_in_mainlist);
 
@@ -0,0 +1,65 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+#ifndef __BKE_MODIFIER_CACHE_H__
+#define __BKE_MODIFIER_CACHE_H__
+
+/** \file
+ * \ingroup bke
+ *
+ * Global cache of modifier stack results, keyed by a fingerprint of everything the
+ * stack evaluation depends on (input mesh, modifier settings, requested data).
+ * Allows objects with static inputs to skip re-evaluation when they are tagged for
+ * an update which does not affect their geometry.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct Mesh;
+
+typedef struct ModifierCacheKey {
+  uint32_t hash[2];
+} ModifierCacheKey;
+
+bool BKE_modifier_cache_is_enabled(void);
+
+/* Returns copies of the cached meshes owned by the caller, r_mesh_orco is set to NULL
+ * when no orco mesh was stored. */
+bool BKE_modifier_cache_lookup(const ModifierCacheKey *key,
+                               struct Mesh **r_mesh,
+                               struct Mesh **r_mesh_orco);
+/* Stores copies of the given meshes, mesh_orco is optional. */
+void BKE_modifier_cache_store(const ModifierCacheKey *key,
+                              const struct Mesh *mesh,
+                              const struct Mesh *mesh_orco);
+
+/* Apply the new size limit from the user preferences. */
+void BKE_modifier_cache_limit_update(void);
+void BKE_modifier_cache_clear(void);
+void BKE_modifier_cache_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BKE_MODIFIER_CACHE_H__ */
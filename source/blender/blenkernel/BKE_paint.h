@@ -242,6 +242,13 @@ typedef struct SculptSession {
   struct PBVH *pbvh;
   bool show_mask;
 
+  /* Tessellation taken from the PBVH when a depsgraph update only moved vertices, reused by
+   * the evaluated mesh and the next PBVH instead of tessellating the whole mesh again. */
+  struct MLoopTri *looptri;
+  int looptri_num;
+  /* The next depsgraph update of the mesh only moves vertices. */
+  bool keep_looptri;
+
   /* Painting on deformed mesh */
   bool deform_modifiers_active; /* object is deformed with some modifiers */
   float (*orig_cos)[3];         /* coords of undeformed mesh */
@@ -180,7 +180,7 @@ typedef struct ParticleThreadContext {
 
 typedef struct ParticleTask {
   ParticleThreadContext *ctx;
-  struct RNG *rng, *rng_path;
+  struct RNG *rng;
   int begin, end;
 } ParticleTask;
 
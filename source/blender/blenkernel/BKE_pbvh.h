@@ -117,6 +117,7 @@ void BKE_pbvh_build_bmesh(PBVH *bvh,
                           const int cd_vert_node_offset,
                           const int cd_face_node_offset);
 void BKE_pbvh_free(PBVH *bvh);
+struct MLoopTri *BKE_pbvh_looptri_take(PBVH *bvh, int *r_looptri_num);
 void BKE_pbvh_free_layer_disp(PBVH *bvh);
 
 /* Hierarchical Search in the BVH, two methods:
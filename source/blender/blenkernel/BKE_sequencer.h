@@ -304,6 +304,7 @@ void BKE_sequencer_proxy_rebuild(struct SeqIndexBuildContext *context,
                                  short *do_update,
                                  float *num_frames_prefetched);
 void BKE_sequencer_proxy_rebuild_finish(struct SeqIndexBuildContext *context, bool stop);
+bool BKE_sequencer_proxy_rebuild_is_threadsafe(const struct SeqIndexBuildContext *context);
 
 void BKE_sequencer_proxy_set(struct Sequence *seq, bool value);
 /* **********************************************************************
@@ -333,6 +334,7 @@ bool BKE_sequencer_cache_put_if_possible(const SeqRenderData *context,
 bool BKE_sequencer_cache_recycle_item(struct Scene *scene);
 void BKE_sequencer_cache_free_temp_cache(struct Scene *scene, short id, int cfra);
 void BKE_sequencer_cache_destruct(struct Scene *scene);
+void BKE_sequencer_disk_cache_free(void);
 void BKE_sequencer_cache_cleanup_all(struct Main *bmain);
 void BKE_sequencer_cache_cleanup(struct Scene *scene);
 void BKE_sequencer_cache_cleanup_sequence(struct Scene *scene,
@@ -404,6 +406,7 @@ struct Sequence *BKE_sequence_metastrip(ListBase *seqbase /* = ed->seqbase */,
                                         struct Sequence *seq);
 
 void BKE_sequencer_offset_animdata(struct Scene *scene, struct Sequence *seq, int ofs);
+bool BKE_sequencer_has_animdata(struct Scene *scene, struct Sequence *seq);
 void BKE_sequencer_dupe_animdata(struct Scene *scene, const char *name_src, const char *name_dst);
 bool BKE_sequence_base_shuffle_ex(struct ListBase *seqbasep,
                                   struct Sequence *test,
@@ -27,6 +27,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "DNA_cloth_types.h"
+#include "DNA_curveprofile_types.h"
 #include "DNA_customdata_types.h"
 #include "DNA_key_types.h"
 #include "DNA_material_types.h"
@@ -38,6 +39,7 @@
 #include "BLI_array.h"
 #include "BLI_blenlib.h"
 #include "BLI_bitmap.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 #include "BLI_linklist.h"
@@ -51,6 +53,7 @@
 #include "BKE_library.h"
 #include "BKE_material.h"
 #include "BKE_modifier.h"
+#include "BKE_modifier_cache.h"
 #include "BKE_mesh.h"
 #include "BKE_mesh_iterators.h"
 #include "BKE_mesh_mapping.h"
@@ -65,6 +68,8 @@
 
 #include "BLI_sys_types.h" /* for intptr_t support */
 
+#include "PIL_time.h"
+
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
 #include "BKE_shrinkwrap.h"
@@ -869,6 +874,307 @@ static void mesh_calc_finalize(const Mesh *mesh_input, Mesh *mesh_eval)
   mesh_eval->edit_mesh = mesh_input->edit_mesh;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Modifier Result Cache
+ *
+ * Fingerprints of the inputs of a modifier stack evaluation, one for the state of the mesh
+ * after each modifier. They are used to reuse the result of an earlier evaluation when an object
+ * gets tagged without any of its inputs changing, and to only evaluate the modifiers following
+ * the first changed one when tweaking settings. Only modifiers which depend on nothing but the
+ * input mesh, their own settings and explicitly hashed operands qualify.
+ * \{ */
+
+/* Don't store the mesh after modifiers which were cheaper than this to evaluate (in seconds).
+ * The result of the whole stack is always stored. */
+#define MODIFIER_CACHE_MIN_EVAL_TIME 0.005
+
+typedef struct ModifierCacheHash {
+  /* Two independently seeded hashes make up the 64 bit key. */
+  BLI_HashMurmur2A mm2[2];
+} ModifierCacheHash;
+
+static void modifier_cache_hash_add(ModifierCacheHash *hash, const void *data, const size_t len)
+{
+  BLI_hash_mm2a_add(&hash->mm2[0], data, len);
+  BLI_hash_mm2a_add(&hash->mm2[1], data, len);
+}
+
+static void modifier_cache_hash_add_int(ModifierCacheHash *hash, const int data)
+{
+  BLI_hash_mm2a_add_int(&hash->mm2[0], data);
+  BLI_hash_mm2a_add_int(&hash->mm2[1], data);
+}
+
+static void modifier_cache_hash_add_string(ModifierCacheHash *hash, const char *str)
+{
+  modifier_cache_hash_add(hash, str, strlen(str) + 1);
+}
+
+static void modifier_cache_hash_get_key(const ModifierCacheHash *hash, ModifierCacheKey *r_key)
+{
+  /* Finalizing modifies the state, work on a copy so hashing can continue. */
+  ModifierCacheHash hash_end = *hash;
+  r_key->hash[0] = BLI_hash_mm2a_end(&hash_end.mm2[0]);
+  r_key->hash[1] = BLI_hash_mm2a_end(&hash_end.mm2[1]);
+}
+
+static bool modifier_cache_hash_customdata(ModifierCacheHash *hash,
+                                           const CustomData *data,
+                                           const int totelem)
+{
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+
+    switch (layer->type) {
+      case CD_MDISPS:
+      case CD_GRID_PAINT_MASK:
+      case CD_BM_ELEM_PYPTR:
+        /* Layers pointing to data outside of the layer itself, not worth hashing. */
+        return false;
+    }
+
+    modifier_cache_hash_add_int(hash, layer->type);
+    modifier_cache_hash_add_string(hash, layer->name);
+    if (layer->data == NULL) {
+      continue;
+    }
+    if (layer->type == CD_MDEFORMVERT) {
+      const MDeformVert *dvert = layer->data;
+      for (int j = 0; j < totelem; j++, dvert++) {
+        modifier_cache_hash_add_int(hash, dvert->totweight);
+        if (dvert->dw != NULL) {
+          modifier_cache_hash_add(hash, dvert->dw, sizeof(*dvert->dw) * dvert->totweight);
+        }
+      }
+    }
+    else {
+      modifier_cache_hash_add(hash, layer->data, (size_t)CustomData_sizeof(layer->type) * totelem);
+    }
+  }
+  return true;
+}
+
+static bool modifier_cache_hash_mesh(ModifierCacheHash *hash, const Mesh *mesh)
+{
+  modifier_cache_hash_add_int(hash, mesh->totvert);
+  modifier_cache_hash_add_int(hash, mesh->totedge);
+  modifier_cache_hash_add_int(hash, mesh->totface);
+  modifier_cache_hash_add_int(hash, mesh->totloop);
+  modifier_cache_hash_add_int(hash, mesh->totpoly);
+  modifier_cache_hash_add_int(hash, mesh->totcol);
+  modifier_cache_hash_add_int(hash, mesh->flag);
+  modifier_cache_hash_add_int(hash, mesh->cd_flag);
+  modifier_cache_hash_add(hash, &mesh->smoothresh, sizeof(mesh->smoothresh));
+  return (modifier_cache_hash_customdata(hash, &mesh->vdata, mesh->totvert) &&
+          modifier_cache_hash_customdata(hash, &mesh->edata, mesh->totedge) &&
+          modifier_cache_hash_customdata(hash, &mesh->fdata, mesh->totface) &&
+          modifier_cache_hash_customdata(hash, &mesh->ldata, mesh->totloop) &&
+          modifier_cache_hash_customdata(hash, &mesh->pdata, mesh->totpoly));
+}
+
+static void modifier_cache_hash_object_materials(ModifierCacheHash *hash, Object *ob)
+{
+  modifier_cache_hash_add_int(hash, ob->totcol);
+  for (short i = 1; i <= ob->totcol; i++) {
+    const Material *ma = give_current_material(ob, i);
+    modifier_cache_hash_add_string(hash, (ma != NULL) ? ma->id.name : "");
+  }
+}
+
+static void modifier_cache_id_link_cb(void *userData,
+                                      Object *UNUSED(ob),
+                                      ID **idpoin,
+                                      int UNUSED(cb_flag))
+{
+  if (*idpoin != NULL) {
+    *((bool *)userData) = true;
+  }
+}
+
+static bool modifier_cache_is_supported(Object *ob, ModifierData *md)
+{
+  const ModifierTypeInfo *mti = modifierType_getInfo(md->type);
+
+  switch ((ModifierType)md->type) {
+    case eModifierType_Boolean:
+      /* The operand is hashed explicitly. */
+      return true;
+    case eModifierType_Array:
+    case eModifierType_Bevel:
+    case eModifierType_Cast:
+    case eModifierType_Decimate:
+    case eModifierType_EdgeSplit:
+    case eModifierType_LaplacianSmooth:
+    case eModifierType_Mirror:
+    case eModifierType_Remesh:
+    case eModifierType_Screw:
+    case eModifierType_SimpleDeform:
+    case eModifierType_Skin:
+    case eModifierType_Smooth:
+    case eModifierType_Solidify:
+    case eModifierType_Subsurf:
+    case eModifierType_Triangulate:
+    case eModifierType_WeightedNormal:
+    case eModifierType_Weld:
+    case eModifierType_Wireframe:
+      break;
+    default:
+      return false;
+  }
+
+  if (mti->dependsOnTime && mti->dependsOnTime(md)) {
+    return false;
+  }
+
+  bool has_links = false;
+  if (mti->foreachIDLink) {
+    mti->foreachIDLink(md, ob, modifier_cache_id_link_cb, &has_links);
+  }
+  else if (mti->foreachObjectLink) {
+    mti->foreachObjectLink(md, ob, (ObjectWalkFunc)modifier_cache_id_link_cb, &has_links);
+  }
+  return !has_links;
+}
+
+static bool modifier_cache_hash_modifier(ModifierCacheHash *hash, Object *ob, ModifierData *md)
+{
+  const ModifierTypeInfo *mti = modifierType_getInfo(md->type);
+  /* Settings follow the common header. Pointers in there are either runtime data, which is
+   * excluded from the range, or links to other data-blocks, which must be unset. */
+  size_t settings_end = mti->structSize;
+
+  switch ((ModifierType)md->type) {
+    case eModifierType_Subsurf:
+      settings_end = offsetof(SubsurfModifierData, emCache);
+      break;
+    case eModifierType_Bevel: {
+      const CurveProfile *profile = ((BevelModifierData *)md)->custom_profile;
+      settings_end = offsetof(BevelModifierData, custom_profile);
+      if (profile != NULL) {
+        modifier_cache_hash_add_int(hash, profile->preset);
+        modifier_cache_hash_add_int(hash, profile->segments_len);
+        modifier_cache_hash_add_int(hash, profile->flag);
+        modifier_cache_hash_add_int(hash, profile->path_len);
+        if (profile->path != NULL) {
+          modifier_cache_hash_add(hash, profile->path, sizeof(*profile->path) * profile->path_len);
+        }
+      }
+      break;
+    }
+    case eModifierType_Boolean: {
+      /* The result depends on the evaluated operand and the transform relative to it. */
+      Object *ob_operand = ((BooleanModifierData *)md)->object;
+      const Mesh *mesh_operand = BKE_modifier_get_evaluated_mesh_from_evaluated_object(
+          ob_operand, false);
+      modifier_cache_hash_add_int(hash, mesh_operand != NULL);
+      if (mesh_operand != NULL && !modifier_cache_hash_mesh(hash, mesh_operand)) {
+        return false;
+      }
+      modifier_cache_hash_add(hash, ob->obmat, sizeof(ob->obmat));
+      modifier_cache_hash_add(hash, ob_operand->obmat, sizeof(ob_operand->obmat));
+      modifier_cache_hash_object_materials(hash, ob);
+      modifier_cache_hash_object_materials(hash, ob_operand);
+      modifier_cache_hash_add(hash,
+                              &((BooleanModifierData *)md)->operation,
+                              mti->structSize - offsetof(BooleanModifierData, operation));
+      settings_end = sizeof(ModifierData);
+      break;
+    }
+    default:
+      break;
+  }
+
+  modifier_cache_hash_add_int(hash, md->type);
+  modifier_cache_hash_add_int(hash, md->mode);
+  modifier_cache_hash_add(
+      hash, (const char *)md + sizeof(ModifierData), settings_end - sizeof(ModifierData));
+  return true;
+}
+
+/**
+ * Compute the cache keys of the mesh state after each modifier, indexed like the modifiers
+ * list. Returns the number of leading modifiers which have a valid key.
+ */
+static int mesh_calc_modifiers_cache_keys(Scene *scene,
+                                          Object *ob,
+                                          const Mesh *mesh_input,
+                                          ModifierData *firstmd,
+                                          const CDMaskLink *datamasks,
+                                          const int required_mode,
+                                          const int useDeform,
+                                          const bool need_mapping,
+                                          const CustomData_MeshMasks *final_datamask,
+                                          const bool use_cache,
+                                          ModifierCacheKey *r_keys)
+{
+  /* Virtual modifiers (shape keys, parent deform) depend on other data. */
+  if (firstmd != ob->modifiers.first) {
+    return 0;
+  }
+
+  /* Avoid hashing the input mesh if the first modifier does not qualify already. */
+  ModifierData *md = firstmd;
+  while (md && !modifier_isEnabled(scene, md, required_mode)) {
+    md = md->next;
+  }
+  if (md == NULL || !modifier_cache_is_supported(ob, md)) {
+    return 0;
+  }
+
+  ModifierCacheHash hash;
+  BLI_hash_mm2a_init(&hash.mm2[0], 0);
+  BLI_hash_mm2a_init(&hash.mm2[1], 0x9e3779b9);
+
+  /* Evaluation settings. */
+  modifier_cache_hash_add_int(&hash, required_mode);
+  modifier_cache_hash_add_int(&hash, useDeform);
+  modifier_cache_hash_add_int(&hash, need_mapping);
+  modifier_cache_hash_add_int(&hash, use_cache);
+  modifier_cache_hash_add(&hash, final_datamask, sizeof(*final_datamask));
+  modifier_cache_hash_add_int(&hash, scene->r.mode & R_SIMPLIFY);
+  modifier_cache_hash_add_int(&hash, scene->r.simplify_subsurf);
+  modifier_cache_hash_add_int(&hash, scene->r.simplify_subsurf_render);
+
+  /* Object data used by modifiers: vertex group names and material count. */
+  LISTBASE_FOREACH (const bDeformGroup *, dg, &ob->defbase) {
+    modifier_cache_hash_add_string(&hash, dg->name);
+  }
+  modifier_cache_hash_add_int(&hash, ob->totcol);
+
+  if (!modifier_cache_hash_mesh(&hash, mesh_input)) {
+    return 0;
+  }
+
+  int keys_len = 0;
+  const CDMaskLink *md_datamask = datamasks;
+  for (md = firstmd; md; md = md->next, md_datamask = md_datamask->next, keys_len++) {
+    if (modifier_isEnabled(scene, md, required_mode)) {
+      if (!modifier_cache_is_supported(ob, md) || !modifier_cache_hash_modifier(&hash, ob, md)) {
+        break;
+      }
+      /* Layers kept by a modifier depend on what the following modifiers need. */
+      const CustomData_MeshMasks *nextmask = md_datamask->next ? &md_datamask->next->mask :
+                                                                 final_datamask;
+      modifier_cache_hash_add(&hash, &md_datamask->mask, sizeof(md_datamask->mask));
+      modifier_cache_hash_add(&hash, nextmask, sizeof(*nextmask));
+    }
+    modifier_cache_hash_get_key(&hash, &r_keys[keys_len]);
+  }
+  return keys_len;
+}
+
+static bool modifiers_have_errors(Object *ob)
+{
+  LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+    if (md->error != NULL) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** \} */
+
 static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
                                 Scene *scene,
                                 Object *ob,
@@ -955,6 +1261,35 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Clear errors before evaluation. */
   modifiers_clearErrors(ob);
 
+  /* Fingerprints of the mesh after each modifier, used to reuse results of earlier evaluations
+   * and only evaluate the modifiers following the last cached state. */
+  ModifierCacheKey *cache_keys = NULL;
+  const ModifierCacheKey *cache_stored_key = NULL;
+  const int cache_modifiers_len = BLI_listbase_count(&ob->modifiers);
+  int cache_keys_len = 0;
+  int cache_resume_index = -1;
+  Mesh *cache_mesh = NULL, *cache_mesh_orco = NULL;
+  if (index == -1 && !sculpt_mode && cache_modifiers_len != 0 && BKE_modifier_cache_is_enabled()) {
+    cache_keys = MEM_malloc_arrayN(cache_modifiers_len, sizeof(*cache_keys), __func__);
+    cache_keys_len = mesh_calc_modifiers_cache_keys(scene,
+                                                    ob,
+                                                    mesh_input,
+                                                    firstmd,
+                                                    datamasks,
+                                                    required_mode,
+                                                    useDeform,
+                                                    need_mapping,
+                                                    &final_datamask,
+                                                    use_cache,
+                                                    cache_keys);
+    for (int i = cache_keys_len - 1; i >= 0; i--) {
+      if (BKE_modifier_cache_lookup(&cache_keys[i], &cache_mesh, &cache_mesh_orco)) {
+        cache_resume_index = i;
+        break;
+      }
+    }
+  }
+
   /* Apply all leading deform modifiers. */
   if (useDeform) {
     for (; md; md = md->next, md_datamask = md_datamask->next) {
@@ -1008,6 +1343,36 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
 
   /* Apply all remaining constructive and deforming modifiers. */
   bool have_non_onlydeform_modifiers_appled = false;
+
+  if (cache_resume_index != -1) {
+    /* The cached mesh includes the leading deform modifiers, they only had to be evaluated for
+     * the deform mesh. */
+    if (mesh_final) {
+      BKE_id_free(NULL, mesh_final);
+    }
+    MEM_SAFE_FREE(deformed_verts);
+    isPrevDeform = false;
+
+    /* Cached meshes don't reference materials of the input mesh. */
+    mesh_final = cache_mesh;
+    BKE_mesh_copy_settings(mesh_final, mesh_input);
+    mesh_final->runtime.deformed_only = false;
+    mesh_orco = cache_mesh_orco;
+    if (mesh_orco) {
+      BKE_mesh_copy_settings(mesh_orco, mesh_input);
+    }
+    have_non_onlydeform_modifiers_appled = true;
+
+    /* Continue with the modifier following the cached state. */
+    md = firstmd;
+    md_datamask = datamasks;
+    for (int i = 0; i <= cache_resume_index; i++) {
+      md = md->next;
+      md_datamask = md_datamask->next;
+    }
+  }
+
+  double cache_segment_start = PIL_check_seconds_timer();
   for (; md; md = md->next, md_datamask = md_datamask->next) {
     const ModifierTypeInfo *mti = modifierType_getInfo(md->type);
 
@@ -1267,6 +1632,19 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       }
 
       mesh_final->runtime.deformed_only = false;
+
+      /* Store the mesh after expensive modifiers, so tweaking the following ones does not
+       * evaluate them again. The whole stack result is stored afterwards. */
+      if (cache_keys_len != 0 && deformed_verts == NULL && md->next != NULL) {
+        const int md_index = BLI_findindex(&ob->modifiers, md);
+        if (md_index < cache_keys_len &&
+            PIL_check_seconds_timer() - cache_segment_start >= MODIFIER_CACHE_MIN_EVAL_TIME &&
+            !modifiers_have_errors(ob)) {
+          BKE_modifier_cache_store(&cache_keys[md_index], mesh_final, mesh_orco);
+          cache_stored_key = &cache_keys[md_index];
+          cache_segment_start = PIL_check_seconds_timer();
+        }
+      }
     }
 
     isPrevDeform = (mti->type == eModifierTypeType_OnlyDeform);
@@ -1309,6 +1687,15 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
     deformed_verts = NULL;
   }
 
+  if (cache_keys_len == cache_modifiers_len && cache_resume_index != cache_keys_len - 1 &&
+      have_non_onlydeform_modifiers_appled && !modifiers_have_errors(ob)) {
+    const ModifierCacheKey *cache_key = &cache_keys[cache_keys_len - 1];
+    if (cache_stored_key == NULL || memcmp(cache_stored_key, cache_key, sizeof(*cache_key))) {
+      BKE_modifier_cache_store(cache_key, mesh_final, mesh_orco);
+    }
+  }
+  MEM_SAFE_FREE(cache_keys);
+
   /* Denotes whether the object which the modifier stack came from owns the mesh or whether the
    * mesh is shared across multiple objects since there are no effective modifiers. */
   const bool is_own_mesh = (mesh_final != mesh_input);
@@ -1344,6 +1731,11 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       BLI_mutex_lock(runtime->eval_mutex);
       if (runtime->mesh_eval == NULL) {
         mesh_final = BKE_mesh_copy_for_eval(mesh_input, true);
+        if (sculpt_mode && ob->sculpt->looptri != NULL) {
+          /* Only vertices moved since the last PBVH build, reuse its updated tessellation. */
+          BKE_mesh_runtime_looptri_copy_from(
+              mesh_final, ob->sculpt->looptri, ob->sculpt->looptri_num);
+        }
         mesh_calc_modifier_final_normals(mesh_input, &final_datamask, sculpt_dyntopo, mesh_final);
         mesh_calc_finalize(mesh_input, mesh_final);
         runtime->mesh_eval = mesh_final;
@@ -1569,11 +1961,11 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
       /* apply vertex coordinates or build a DerivedMesh as necessary */
       if (mesh_final) {
         if (deformed_verts) {
-          Mesh *mesh_tmp = BKE_mesh_copy_for_eval(mesh_final, false);
-          if (mesh_final != mesh_cage) {
-            BKE_id_free(NULL, mesh_final);
+          /* Only the cage has to be kept intact, otherwise the coordinates can be applied in
+           * place, without duplicating all other layers. */
+          if (mesh_final == mesh_cage) {
+            mesh_final = BKE_mesh_copy_for_eval(mesh_final, false);
           }
-          mesh_final = mesh_tmp;
           BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
         }
         else if (mesh_final == mesh_cage) {
@@ -1776,6 +2168,75 @@ static void mesh_runtime_check_normals_valid(const Mesh *mesh)
   BLI_assert(!(mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL));
 }
 
+/* When the modifier stack only moves vertices, like armature deformation during playback, the
+ * new result has the topology of the previous one. Its batch cache is kept then, so the draw
+ * code only extracts and uploads the buffers which depend on vertex positions again. */
+static bool mesh_build_data_can_keep_batch_cache(const Depsgraph *depsgraph,
+                                                 Scene *scene,
+                                                 Object *ob,
+                                                 const CustomData_MeshMasks *dataMask,
+                                                 const bool need_mapping)
+{
+  const Mesh *mesh_eval = ob->runtime.mesh_eval;
+  const Mesh *mesh_orig = ob->runtime.mesh_orig;
+
+  if (!DEG_is_active(depsgraph) || (ob->mode & OB_MODE_ALL_SCULPT)) {
+    return false;
+  }
+  if (mesh_eval == NULL || !ob->runtime.is_mesh_eval_owned ||
+      mesh_eval->runtime.batch_cache == NULL || mesh_orig == NULL) {
+    return false;
+  }
+  /* Edits of the object or of its mesh can change anything, they come with a copy-on-write
+   * update. Updates flushed from other objects, like a posed armature, do not. */
+  if ((ob->id.recalc & ID_RECALC_COPY_ON_WRITE) ||
+      (mesh_orig->id.recalc & (ID_RECALC_GEOMETRY | ID_RECALC_COPY_ON_WRITE))) {
+    return false;
+  }
+  if (ob->runtime.last_need_mapping != need_mapping ||
+      !CustomData_MeshMasks_are_matching(&ob->runtime.last_data_mask, dataMask) ||
+      !CustomData_MeshMasks_are_matching(dataMask, &ob->runtime.last_data_mask)) {
+    return false;
+  }
+
+  const bool use_render = (DEG_get_mode(depsgraph) == DAG_EVAL_RENDER);
+  const int required_mode = use_render ? eModifierMode_Render : eModifierMode_Realtime;
+  VirtualModifierData virtualModifierData;
+  ModifierData *md = modifiers_getVirtualModifierList(ob, &virtualModifierData);
+  bool has_deform = false;
+  for (; md; md = md->next) {
+    if (!modifier_isEnabled(scene, md, required_mode)) {
+      continue;
+    }
+    if (modifierType_getInfo(md->type)->type != eModifierTypeType_OnlyDeform) {
+      return false;
+    }
+    has_deform = true;
+  }
+  return has_deform;
+}
+
+static bool mesh_topology_len_equals(const Mesh *a, const Mesh *b)
+{
+  return (a->totvert == b->totvert && a->totedge == b->totedge && a->totloop == b->totloop &&
+          a->totpoly == b->totpoly);
+}
+
+/* Move the batch cache of the previous result to the new one, see
+ * #mesh_build_data_can_keep_batch_cache. */
+static void mesh_build_data_keep_batch_cache(Object *ob, Mesh *mesh_eval_prev)
+{
+  Mesh *mesh_eval = ob->runtime.mesh_eval;
+  if (mesh_eval == NULL || !ob->runtime.is_mesh_eval_owned ||
+      mesh_eval->runtime.batch_cache != NULL || mesh_eval->edit_mesh != NULL ||
+      !mesh_topology_len_equals(mesh_eval, mesh_eval_prev)) {
+    return;
+  }
+  mesh_eval->runtime.batch_cache = mesh_eval_prev->runtime.batch_cache;
+  mesh_eval_prev->runtime.batch_cache = NULL;
+  BKE_mesh_batch_cache_dirty_tag(mesh_eval, BKE_MESH_BATCH_DIRTY_DEFORM);
+}
+
 static void mesh_build_data(struct Depsgraph *depsgraph,
                             Scene *scene,
                             Object *ob,
@@ -1788,6 +2249,13 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  /* Keep the previous result until the new one is there, to move its batch cache over. */
+  Mesh *mesh_eval_prev = NULL;
+  if (mesh_build_data_can_keep_batch_cache(depsgraph, scene, ob, dataMask, need_mapping)) {
+    mesh_eval_prev = ob->runtime.mesh_eval;
+    ob->runtime.mesh_eval = NULL;
+  }
+
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1818,6 +2286,11 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
 
   assign_object_mesh_eval(ob);
 
+  if (mesh_eval_prev != NULL) {
+    mesh_build_data_keep_batch_cache(ob, mesh_eval_prev);
+    BKE_mesh_eval_delete(mesh_eval_prev);
+  }
+
   ob->runtime.last_data_mask = *dataMask;
   ob->runtime.last_need_mapping = need_mapping;
 
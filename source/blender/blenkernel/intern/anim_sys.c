@@ -33,6 +33,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_alloca.h"
 #include "BLI_dynstr.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_string_utils.h"
 #include "BLI_math_rotation.h"
@@ -241,6 +242,30 @@ bool BKE_animdata_set_action(ReportList *reports, ID *id, bAction *act)
 
 /* Freeing -------------------------------------------- */
 
+/* Resolved path of an F-Curve, stored in the evaluated #AnimData. */
+typedef struct AnimRNAPathCacheEntry {
+  /* The F-Curve the entry was created for could have been freed since, its memory re-used by an
+   * F-Curve with another path, so the path is compared on lookup. */
+  char *rna_path;
+  int array_index;
+  PathResolvedRNA anim_rna;
+} AnimRNAPathCacheEntry;
+
+static void animsys_rna_path_cache_entry_free(void *entry_v)
+{
+  AnimRNAPathCacheEntry *entry = entry_v;
+  MEM_freeN(entry->rna_path);
+  MEM_freeN(entry);
+}
+
+static void animsys_rna_path_cache_free(AnimData *adt)
+{
+  if (adt->rna_path_cache != NULL) {
+    BLI_ghash_free(adt->rna_path_cache, NULL, animsys_rna_path_cache_entry_free);
+    adt->rna_path_cache = NULL;
+  }
+}
+
 /* Free AnimData used by the nominated ID-block, and clear ID-block's AnimData pointer */
 void BKE_animdata_free(ID *id, const bool do_id_user)
 {
@@ -273,6 +298,9 @@ void BKE_animdata_free(ID *id, const bool do_id_user)
       /* free driver array cache */
       MEM_SAFE_FREE(adt->driver_array);
 
+      /* free resolved paths cache */
+      animsys_rna_path_cache_free(adt);
+
       /* free overrides */
       /* TODO... */
 
@@ -341,6 +369,7 @@ AnimData *BKE_animdata_copy(Main *bmain, AnimData *adt, const int flag)
   /* duplicate drivers (F-Curves) */
   copy_fcurves(&dadt->drivers, &adt->drivers);
   dadt->driver_array = NULL;
+  dadt->rna_path_cache = NULL;
 
   /* don't copy overrides */
   BLI_listbase_clear(&dadt->overrides);
@@ -1714,6 +1743,64 @@ static bool animsys_store_rna_setting(PointerRNA *ptr,
   return success;
 }
 
+/* Resolved paths are only cached for copy-on-write data-blocks, the layout of their data only
+ * changes when they are copied again, which also replaces the animation data. Original
+ * data-blocks can be modified at any moment. */
+static GHash *animsys_rna_path_cache_ensure(PointerRNA *ptr)
+{
+  ID *id = ptr->owner_id;
+  if (id == NULL || ptr->data != id || (id->tag & LIB_TAG_COPIED_ON_WRITE) == 0) {
+    return NULL;
+  }
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt == NULL) {
+    return NULL;
+  }
+  if (adt->rna_path_cache == NULL) {
+    adt->rna_path_cache = BLI_ghash_ptr_new(__func__);
+  }
+  return adt->rna_path_cache;
+}
+
+static bool animsys_store_rna_setting_cached(PointerRNA *ptr,
+                                             GHash *rna_path_cache,
+                                             FCurve *fcu,
+                                             PathResolvedRNA *r_result)
+{
+  if (rna_path_cache == NULL || fcu->rna_path == NULL) {
+    return animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, r_result);
+  }
+
+  AnimRNAPathCacheEntry *entry = BLI_ghash_lookup(rna_path_cache, fcu);
+  if (entry != NULL && entry->array_index == fcu->array_index &&
+      STREQ(entry->rna_path, fcu->rna_path)) {
+    *r_result = entry->anim_rna;
+    return true;
+  }
+
+  if (!animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, r_result)) {
+    return false;
+  }
+
+  /* Data of other data-blocks can be re-allocated without this one being copied again. */
+  if (r_result->ptr.owner_id != ptr->owner_id) {
+    return true;
+  }
+
+  if (entry == NULL) {
+    entry = MEM_mallocN(sizeof(*entry), __func__);
+    BLI_ghash_insert(rna_path_cache, fcu, entry);
+  }
+  else {
+    MEM_freeN(entry->rna_path);
+  }
+  entry->rna_path = BLI_strdup(fcu->rna_path);
+  entry->array_index = fcu->array_index;
+  entry->anim_rna = *r_result;
+
+  return true;
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > ((1.0f - FLT_EPSILON)))
 
@@ -1895,6 +1982,7 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      float ctime,
                                      bool flush_to_original)
 {
+  GHash *rna_path_cache = animsys_rna_path_cache_ensure(ptr);
   /* Calculate then execute each curve. */
   for (FCurve *fcu = list->first; fcu; fcu = fcu->next) {
     /* Check if this F-Curve doesn't belong to a muted group. */
@@ -1910,7 +1998,7 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
       continue;
     }
     PathResolvedRNA anim_rna;
-    if (animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_store_rna_setting_cached(ptr, rna_path_cache, fcu, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, ctime);
       BKE_animsys_write_rna_setting(&anim_rna, curval);
       if (flush_to_original) {
@@ -4069,6 +4157,14 @@ void BKE_animsys_eval_animdata(Depsgraph *depsgraph, ID *id)
   BKE_animsys_evaluate_animdata(scene, id, adt, ctime, ADT_RECALC_ANIM, flush_to_original);
 }
 
+void BKE_animsys_clear_rna_path_cache(ID *id)
+{
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt != NULL) {
+    animsys_rna_path_cache_free(adt);
+  }
+}
+
 void BKE_animsys_update_driver_array(ID *id)
 {
   AnimData *adt = BKE_animdata_from_id(id);
@@ -2721,6 +2721,9 @@ void BKE_pose_rebuild(Main *bmain, Object *ob, bArmature *arm, const bool do_id_
   }
   pose = ob->pose;
 
+  /* Paths resolved to pose channels which are about to be freed. */
+  BKE_animsys_clear_rna_path_cache(&ob->id);
+
   /* clear */
   BKE_pose_clear_pointers(pose);
 
@@ -60,6 +60,8 @@ static bool collection_child_add(Collection *parent,
 static bool collection_child_remove(Collection *parent, Collection *collection);
 static bool collection_object_add(
     Main *bmain, Collection *collection, Object *ob, int flag, const bool add_us);
+static void collection_object_add_nocheck(
+    Main *bmain, Collection *collection, Object *ob, int flag, const bool add_us);
 static bool collection_object_remove(Main *bmain,
                                      Collection *collection,
                                      Object *ob,
@@ -225,7 +227,7 @@ void BKE_collection_copy_data(Main *bmain,
     collection_child_add(collection_dst, child->collection, flag, false);
   }
   for (CollectionObject *cob = collection_src->gobject.first; cob; cob = cob->next) {
-    collection_object_add(bmain, collection_dst, cob->ob, flag, false);
+    collection_object_add_nocheck(bmain, collection_dst, cob->ob, flag, false);
   }
 }
 
@@ -635,22 +637,13 @@ static void collection_tag_update_parent_recursive(Main *bmain,
   }
 }
 
-static bool collection_object_add(
+/* Add an object known to be valid and not in the collection yet, like when copying the objects of
+ * another collection. Avoids the lookups of #collection_object_add, which are linear with the
+ * number of objects in the collection. */
+static void collection_object_add_nocheck(
     Main *bmain, Collection *collection, Object *ob, int flag, const bool add_us)
 {
-  if (ob->instance_collection) {
-    /* Cyclic dependency check. */
-    if (collection_find_child_recursive(ob->instance_collection, collection)) {
-      return false;
-    }
-  }
-
-  CollectionObject *cob = BLI_findptr(&collection->gobject, ob, offsetof(CollectionObject, ob));
-  if (cob) {
-    return false;
-  }
-
-  cob = MEM_callocN(sizeof(CollectionObject), __func__);
+  CollectionObject *cob = MEM_callocN(sizeof(CollectionObject), __func__);
   cob->ob = ob;
   BLI_addtail(&collection->gobject, cob);
   BKE_collection_object_cache_free(collection);
@@ -666,7 +659,23 @@ static bool collection_object_add(
   if ((flag & LIB_ID_CREATE_NO_MAIN) == 0) {
     BKE_rigidbody_main_collection_object_add(bmain, collection, ob);
   }
+}
+
+static bool collection_object_add(
+    Main *bmain, Collection *collection, Object *ob, int flag, const bool add_us)
+{
+  if (ob->instance_collection) {
+    /* Cyclic dependency check. */
+    if (collection_find_child_recursive(ob->instance_collection, collection)) {
+      return false;
+    }
+  }
+
+  if (BLI_findptr(&collection->gobject, ob, offsetof(CollectionObject, ob))) {
+    return false;
+  }
 
+  collection_object_add_nocheck(bmain, collection, ob, flag, add_us);
   return true;
 }
 
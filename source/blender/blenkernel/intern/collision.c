@@ -129,6 +129,42 @@ BVHTree *bvhtree_build_from_mvert(const MVert *mvert,
   return tree;
 }
 
+typedef struct BVHTreeUpdateFromMVertData {
+  BVHTree *bvhtree;
+  const MVert *mvert;
+  const MVert *mvert_moving;
+  const MVertTri *tri;
+} BVHTreeUpdateFromMVertData;
+
+static void bvhtree_update_from_mvert_task_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHTreeUpdateFromMVertData *data = userdata;
+  const MVert *mvert = data->mvert;
+  const MVert *mvert_moving = data->mvert_moving;
+  const MVertTri *vt = &data->tri[i];
+  float co[3][3];
+
+  copy_v3_v3(co[0], mvert[vt->tri[0]].co);
+  copy_v3_v3(co[1], mvert[vt->tri[1]].co);
+  copy_v3_v3(co[2], mvert[vt->tri[2]].co);
+
+  /* copy new locations into array */
+  if (mvert_moving != NULL) {
+    float co_moving[3][3];
+    /* update moving positions */
+    copy_v3_v3(co_moving[0], mvert_moving[vt->tri[0]].co);
+    copy_v3_v3(co_moving[1], mvert_moving[vt->tri[1]].co);
+    copy_v3_v3(co_moving[2], mvert_moving[vt->tri[2]].co);
+
+    BLI_bvhtree_update_node(data->bvhtree, i, &co[0][0], &co_moving[0][0], 3);
+  }
+  else {
+    BLI_bvhtree_update_node(data->bvhtree, i, &co[0][0], NULL, 3);
+  }
+}
+
 void bvhtree_update_from_mvert(BVHTree *bvhtree,
                                const MVert *mvert,
                                const MVert *mvert_moving,
@@ -136,9 +172,6 @@ void bvhtree_update_from_mvert(BVHTree *bvhtree,
                                int tri_num,
                                bool moving)
 {
-  const MVertTri *vt;
-  int i;
-
   if ((bvhtree == NULL) || (mvert == NULL)) {
     return;
   }
@@ -147,33 +180,22 @@ void bvhtree_update_from_mvert(BVHTree *bvhtree,
     moving = false;
   }
 
-  for (i = 0, vt = tri; i < tri_num; i++, vt++) {
-    float co[3][3];
-    bool ret;
-
-    copy_v3_v3(co[0], mvert[vt->tri[0]].co);
-    copy_v3_v3(co[1], mvert[vt->tri[1]].co);
-    copy_v3_v3(co[2], mvert[vt->tri[2]].co);
-
-    /* copy new locations into array */
-    if (moving) {
-      float co_moving[3][3];
-      /* update moving positions */
-      copy_v3_v3(co_moving[0], mvert_moving[vt->tri[0]].co);
-      copy_v3_v3(co_moving[1], mvert_moving[vt->tri[1]].co);
-      copy_v3_v3(co_moving[2], mvert_moving[vt->tri[2]].co);
+  /* Only refit the tree, the topology of the mesh didn't change. Every triangle only updates
+   * its own node, so that can run in parallel. */
+  BVHTreeUpdateFromMVertData data = {
+      .bvhtree = bvhtree,
+      .mvert = mvert,
+      .mvert_moving = moving ? mvert_moving : NULL,
+      .tri = tri,
+  };
 
-      ret = BLI_bvhtree_update_node(bvhtree, i, &co[0][0], &co_moving[0][0], 3);
-    }
-    else {
-      ret = BLI_bvhtree_update_node(bvhtree, i, &co[0][0], NULL, 3);
-    }
+  /* The tree can't hold more nodes than it was created with. */
+  tri_num = min_ii(tri_num, BLI_bvhtree_get_len(bvhtree));
 
-    /* check if tree is already full */
-    if (ret == false) {
-      break;
-    }
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, tri_num, &data, bvhtree_update_from_mvert_task_cb, &settings);
 
   BLI_bvhtree_update_tree(bvhtree);
 }
@@ -1136,19 +1158,17 @@ void BKE_collider_cache_free(ListBase **colliders)
 
 static bool cloth_bvh_objcollisions_nearcheck(ClothModifierData *clmd,
                                               CollisionModifierData *collmd,
-                                              CollPair **collisions,
+                                              CollPair *collisions,
                                               int numresult,
                                               BVHTreeOverlap *overlap,
                                               bool culling,
                                               bool use_normal)
 {
-  *collisions = (CollPair *)MEM_mallocN(sizeof(CollPair) * numresult, "collision array");
-
   ColDetectData data = {
       .clmd = clmd,
       .collmd = collmd,
       .overlap = overlap,
-      .collisions = *collisions,
+      .collisions = collisions,
       .culling = culling,
       .use_normal = use_normal,
       .collided = false,
@@ -1291,6 +1311,8 @@ int cloth_bvh_collision(
   BVHTreeOverlap **overlap_obj = NULL;
   uint coll_count_self = 0;
   BVHTreeOverlap *overlap_self = NULL;
+  CollPair **collisions_obj = NULL;
+  CollPair *collisions_self = NULL;
 
   if ((clmd->sim_parms->flags & CLOTH_SIMSETTINGS_FLAG_COLLOBJ) || cloth_bvh == NULL) {
     return 0;
@@ -1308,6 +1330,7 @@ int cloth_bvh_collision(
     if (collobjs) {
       coll_counts_obj = MEM_callocN(sizeof(uint) * numcollobj, "CollCounts");
       overlap_obj = MEM_callocN(sizeof(*overlap_obj) * numcollobj, "BVHOverlap");
+      collisions_obj = MEM_callocN(sizeof(*collisions_obj) * numcollobj, "CollPair");
 
       for (i = 0; i < numcollobj; i++) {
         Object *collob = collobjs[i];
@@ -1323,6 +1346,13 @@ int cloth_bvh_collision(
 
         overlap_obj[i] = BLI_bvhtree_overlap(
             cloth_bvh, collmd->bvhtree, &coll_counts_obj[i], NULL, NULL);
+
+        /* The overlap pairs don't change between rounds, so the contact buffer is allocated
+         * once and every round overwrites it. */
+        if (coll_counts_obj[i] && overlap_obj[i]) {
+          collisions_obj[i] = MEM_mallocN(sizeof(CollPair) * coll_counts_obj[i],
+                                          "collision array");
+        }
       }
     }
   }
@@ -1332,6 +1362,10 @@ int cloth_bvh_collision(
 
     overlap_self = BLI_bvhtree_overlap(
         cloth->bvhselftree, cloth->bvhselftree, &coll_count_self, NULL, NULL);
+
+    if (coll_count_self && overlap_self) {
+      collisions_self = MEM_mallocN(sizeof(CollPair) * coll_count_self, "collision array");
+    }
   }
 
   do {
@@ -1339,11 +1373,8 @@ int cloth_bvh_collision(
 
     /* Object collisions. */
     if ((clmd->coll_parms->flags & CLOTH_COLLSETTINGS_FLAG_ENABLED) && collobjs) {
-      CollPair **collisions;
       bool collided = false;
 
-      collisions = MEM_callocN(sizeof(CollPair *) * numcollobj, "CollPair");
-
       for (i = 0; i < numcollobj; i++) {
         Object *collob = collobjs[i];
         CollisionModifierData *collmd = (CollisionModifierData *)modifiers_findByType(
@@ -1353,11 +1384,11 @@ int cloth_bvh_collision(
           continue;
         }
 
-        if (coll_counts_obj[i] && overlap_obj[i]) {
+        if (collisions_obj[i]) {
           collided = cloth_bvh_objcollisions_nearcheck(
                          clmd,
                          collmd,
-                         &collisions[i],
+                         collisions_obj[i],
                          coll_counts_obj[i],
                          overlap_obj[i],
                          (collob->pd->flag & PFIELD_CLOTH_USE_CULLING),
@@ -1368,38 +1399,23 @@ int cloth_bvh_collision(
 
       if (collided) {
         ret += cloth_bvh_objcollisions_resolve(
-            clmd, collobjs, collisions, coll_counts_obj, numcollobj, dt);
+            clmd, collobjs, collisions_obj, coll_counts_obj, numcollobj, dt);
         ret2 += ret;
       }
-
-      for (i = 0; i < numcollobj; i++) {
-        MEM_SAFE_FREE(collisions[i]);
-      }
-
-      MEM_freeN(collisions);
     }
 
     /* Self collisions. */
     if (clmd->coll_parms->flags & CLOTH_COLLSETTINGS_FLAG_SELF) {
-      CollPair *collisions = NULL;
-
       verts = cloth->verts;
       mvert_num = cloth->mvert_num;
 
-      if (cloth->bvhselftree) {
-        if (coll_count_self && overlap_self) {
-          collisions = (CollPair *)MEM_mallocN(sizeof(CollPair) * coll_count_self,
-                                               "collision array");
-
-          if (cloth_bvh_selfcollisions_nearcheck(
-                  clmd, collisions, coll_count_self, overlap_self)) {
-            ret += cloth_bvh_selfcollisions_resolve(clmd, collisions, coll_count_self, dt);
-            ret2 += ret;
-          }
+      if (cloth->bvhselftree && collisions_self) {
+        if (cloth_bvh_selfcollisions_nearcheck(
+                clmd, collisions_self, coll_count_self, overlap_self)) {
+          ret += cloth_bvh_selfcollisions_resolve(clmd, collisions_self, coll_count_self, dt);
+          ret2 += ret;
         }
       }
-
-      MEM_SAFE_FREE(collisions);
     }
 
     /* Apply all collision resolution. */
@@ -1421,14 +1437,17 @@ int cloth_bvh_collision(
   if (overlap_obj) {
     for (i = 0; i < numcollobj; i++) {
       MEM_SAFE_FREE(overlap_obj[i]);
+      MEM_SAFE_FREE(collisions_obj[i]);
     }
 
     MEM_freeN(overlap_obj);
+    MEM_freeN(collisions_obj);
   }
 
   MEM_SAFE_FREE(coll_counts_obj);
 
   MEM_SAFE_FREE(overlap_self);
+  MEM_SAFE_FREE(collisions_self);
 
   BKE_collision_objects_free(collobjs);
 
@@ -3432,7 +3432,11 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
   }
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+/**
+ * Allocate a block without initializing its data. Not thread safe since it uses the memory pool,
+ * filling in the data afterwards is.
+ */
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
 
   if (*block) {
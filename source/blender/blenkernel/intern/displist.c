@@ -39,6 +39,7 @@
 #include "BLI_scanfill.h"
 #include "BLI_utildefines.h"
 #include "BLI_linklist.h"
+#include "BLI_task.h"
 
 #include "BKE_displist.h"
 #include "BKE_cdderivedmesh.h"
@@ -1515,6 +1516,299 @@ static void calc_bevfac_mapping(Curve *cu,
   }
 }
 
+/**
+ * Sweeps the bevel profile along one spline, the display lists are added to \a dispbase,
+ * the filled caps to \a capbase (in reverse order, like #BKE_displist_fill does).
+ */
+static void curve_bevel_spline_to_displist(Depsgraph *depsgraph,
+                                           Scene *scene,
+                                           Curve *cu,
+                                           BevList *bl,
+                                           Nurb *nu,
+                                           ListBase *dlbev,
+                                           const float widfac,
+                                           ListBase *dispbase,
+                                           ListBase *capbase)
+{
+  DispList *dl;
+  float *data;
+  int a;
+
+  if (bl->nr == 0) { /* blank bevel lists can happen */
+    return;
+  }
+
+  /* exception handling; curve without bevel or extrude, with width correction */
+  if (BLI_listbase_is_empty(dlbev)) {
+    BevPoint *bevp;
+    dl = MEM_callocN(sizeof(DispList), "makeDispListbev");
+    dl->verts = MEM_mallocN(sizeof(float[3]) * bl->nr, "dlverts");
+    BLI_addtail(dispbase, dl);
+
+    if (bl->poly != -1) {
+      dl->type = DL_POLY;
+    }
+    else {
+      dl->type = DL_SEGM;
+    }
+
+    if (dl->type == DL_SEGM) {
+      dl->flag = (DL_FRONT_CURVE | DL_BACK_CURVE);
+    }
+
+    dl->parts = 1;
+    dl->nr = bl->nr;
+    dl->col = nu->mat_nr;
+    dl->charidx = nu->charidx;
+
+    /* dl->rt will be used as flag for render face and */
+    /* CU_2D conflicts with R_NOPUNOFLIP */
+    dl->rt = nu->flag & ~CU_2D;
+
+    a = dl->nr;
+    bevp = bl->bevpoints;
+    data = dl->verts;
+    while (a--) {
+      data[0] = bevp->vec[0] + widfac * bevp->sina;
+      data[1] = bevp->vec[1] + widfac * bevp->cosa;
+      data[2] = bevp->vec[2];
+      bevp++;
+      data += 3;
+    }
+  }
+  else {
+    DispList *dlb;
+    ListBase bottom_capbase = {NULL, NULL};
+    ListBase top_capbase = {NULL, NULL};
+    float bottom_no[3] = {0.0f};
+    float top_no[3] = {0.0f};
+    float firstblend = 0.0f, lastblend = 0.0f;
+    int i, start = 0, steps = 0;
+
+    if (nu->flagu & CU_NURB_CYCLIC) {
+      calc_bevfac_mapping_default(bl, &start, &firstblend, &steps, &lastblend);
+    }
+    else {
+      if (fabsf(cu->bevfac2 - cu->bevfac1) < FLT_EPSILON) {
+        return;
+      }
+
+      calc_bevfac_mapping(cu, bl, nu, &start, &firstblend, &steps, &lastblend);
+    }
+
+    for (dlb = dlbev->first; dlb; dlb = dlb->next) {
+      BevPoint *bevp_first, *bevp_last;
+      BevPoint *bevp;
+
+      /* for each part of the bevel use a separate displblock */
+      dl = MEM_callocN(sizeof(DispList), "makeDispListbev1");
+      dl->verts = data = MEM_mallocN(sizeof(float[3]) * dlb->nr * steps, "dlverts");
+      BLI_addtail(dispbase, dl);
+
+      dl->type = DL_SURF;
+
+      dl->flag = dlb->flag & (DL_FRONT_CURVE | DL_BACK_CURVE);
+      if (dlb->type == DL_POLY) {
+        dl->flag |= DL_CYCL_U;
+      }
+      if ((bl->poly >= 0) && (steps > 2)) {
+        dl->flag |= DL_CYCL_V;
+      }
+
+      dl->parts = steps;
+      dl->nr = dlb->nr;
+      dl->col = nu->mat_nr;
+      dl->charidx = nu->charidx;
+
+      /* dl->rt will be used as flag for render face and */
+      /* CU_2D conflicts with R_NOPUNOFLIP */
+      dl->rt = nu->flag & ~CU_2D;
+
+      dl->bevel_split = BLI_BITMAP_NEW(steps, "bevel_split");
+
+      /* for each point of poly make a bevel piece */
+      bevp_first = bl->bevpoints;
+      bevp_last = &bl->bevpoints[bl->nr - 1];
+      bevp = &bl->bevpoints[start];
+      for (i = start, a = 0; a < steps; i++, bevp++, a++) {
+        float fac = 1.0;
+        float *cur_data = data;
+
+        if (cu->taperobj == NULL) {
+          fac = bevp->radius;
+        }
+        else {
+          float len, taper_fac;
+
+          if (cu->flag & CU_MAP_TAPER) {
+            len = (steps - 3) + firstblend + lastblend;
+
+            if (a == 0) {
+              taper_fac = 0.0f;
+            }
+            else if (a == steps - 1) {
+              taper_fac = 1.0f;
+            }
+            else {
+              taper_fac = ((float)a - (1.0f - firstblend)) / len;
+            }
+          }
+          else {
+            len = bl->nr - 1;
+            taper_fac = (float)i / len;
+
+            if (a == 0) {
+              taper_fac += (1.0f - firstblend) / len;
+            }
+            else if (a == steps - 1) {
+              taper_fac -= (1.0f - lastblend) / len;
+            }
+          }
+
+          fac = displist_calc_taper(depsgraph, scene, cu->taperobj, taper_fac);
+        }
+
+        if (bevp->split_tag) {
+          BLI_BITMAP_ENABLE(dl->bevel_split, a);
+        }
+
+        /* rotate bevel piece and write in data */
+        if ((a == 0) && (bevp != bevp_last)) {
+          rotateBevelPiece(cu, bevp, bevp + 1, dlb, 1.0f - firstblend, widfac, fac, &data);
+        }
+        else if ((a == steps - 1) && (bevp != bevp_first)) {
+          rotateBevelPiece(cu, bevp, bevp - 1, dlb, 1.0f - lastblend, widfac, fac, &data);
+        }
+        else {
+          rotateBevelPiece(cu, bevp, NULL, dlb, 0.0f, widfac, fac, &data);
+        }
+
+        if (cu->bevobj && (cu->flag & CU_FILL_CAPS) && !(nu->flagu & CU_NURB_CYCLIC)) {
+          if (a == 1) {
+            fillBevelCap(nu, dlb, cur_data - 3 * dlb->nr, &bottom_capbase);
+            copy_v3_v3(bottom_no, bevp->dir);
+          }
+          if (a == steps - 1) {
+            fillBevelCap(nu, dlb, cur_data, &top_capbase);
+            negate_v3_v3(top_no, bevp->dir);
+          }
+        }
+      }
+
+      /* gl array drawing: using indices */
+      displist_surf_indices(dl);
+    }
+
+    if (bottom_capbase.first) {
+      BKE_displist_fill(&bottom_capbase, capbase, bottom_no, false);
+      BKE_displist_fill(&top_capbase, capbase, top_no, false);
+      BKE_displist_free(&bottom_capbase);
+      BKE_displist_free(&top_capbase);
+    }
+  }
+}
+
+typedef struct CurveBevelSplinesData {
+  Depsgraph *depsgraph;
+  Scene *scene;
+  Curve *cu;
+  BevList **bevlists;
+  Nurb **nurbs;
+  ListBase *dlbev;
+  float widfac;
+  /* Output of every spline, joined in order afterwards. */
+  ListBase *dispbases;
+  ListBase *capbases;
+} CurveBevelSplinesData;
+
+static void curve_bevel_splines_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CurveBevelSplinesData *data = userdata;
+
+  curve_bevel_spline_to_displist(data->depsgraph,
+                                 data->scene,
+                                 data->cu,
+                                 data->bevlists[i],
+                                 data->nurbs[i],
+                                 data->dlbev,
+                                 data->widfac,
+                                 &data->dispbases[i],
+                                 &data->capbases[i]);
+}
+
+/**
+ * Splines are swept independently of each other, so this is done in parallel,
+ * the result is the same as sweeping them one after the other.
+ */
+static void curve_bevel_splines_to_displist(Depsgraph *depsgraph,
+                                            Scene *scene,
+                                            Object *ob,
+                                            ListBase *nubase,
+                                            ListBase *dlbev,
+                                            ListBase *dispbase)
+{
+  Curve *cu = ob->data;
+  const int splines_len = min_ii(BLI_listbase_count(&ob->runtime.curve_cache->bev),
+                                 BLI_listbase_count(nubase));
+  BevList *bl = ob->runtime.curve_cache->bev.first;
+  Nurb *nu = nubase->first;
+  bool use_threading = true;
+  int i;
+
+  if (splines_len == 0) {
+    return;
+  }
+
+  /* The taper curve is evaluated on first use, make sure this doesn't happen from threads. */
+  if (cu->taperobj) {
+    Object *taperobj = cu->taperobj;
+    displist_calc_taper(depsgraph, scene, taperobj, 0.0f);
+    if (taperobj->type == OB_CURVE && (taperobj->runtime.curve_cache == NULL ||
+                                       taperobj->runtime.curve_cache->disp.first == NULL)) {
+      use_threading = false;
+    }
+  }
+
+  CurveBevelSplinesData data = {
+      .depsgraph = depsgraph,
+      .scene = scene,
+      .cu = cu,
+      .bevlists = MEM_malloc_arrayN(splines_len, sizeof(BevList *), __func__),
+      .nurbs = MEM_malloc_arrayN(splines_len, sizeof(Nurb *), __func__),
+      .dlbev = dlbev,
+      .widfac = cu->width - 1.0f,
+      .dispbases = MEM_calloc_arrayN(splines_len, sizeof(ListBase), __func__),
+      .capbases = MEM_calloc_arrayN(splines_len, sizeof(ListBase), __func__),
+  };
+
+  for (i = 0; i < splines_len; i++, bl = bl->next, nu = nu->next) {
+    data.bevlists[i] = bl;
+    data.nurbs[i] = nu;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = use_threading;
+  settings.min_iter_per_thread = 4;
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  BLI_task_parallel_range(0, splines_len, &data, curve_bevel_splines_cb, &settings);
+
+  /* Caps are filled at the head of the list, so the last spline's come first. */
+  for (i = 0; i < splines_len; i++) {
+    BLI_movelisttolist(dispbase, &data.dispbases[i]);
+  }
+  for (i = 0; i < splines_len; i++) {
+    BLI_movelisttolist_reverse(dispbase, &data.capbases[i]);
+  }
+
+  MEM_freeN(data.bevlists);
+  MEM_freeN(data.nurbs);
+  MEM_freeN(data.dispbases);
+  MEM_freeN(data.capbases);
+}
+
 static void do_makeDispListCurveTypes(Depsgraph *depsgraph,
                                       Scene *scene,
                                       Object *ob,
@@ -1571,187 +1865,7 @@ static void do_makeDispListCurveTypes(Depsgraph *depsgraph,
       curve_to_displist(cu, &nubase, dispbase, for_render);
     }
     else {
-      float widfac = cu->width - 1.0f;
-      BevList *bl = ob->runtime.curve_cache->bev.first;
-      Nurb *nu = nubase.first;
-
-      for (; bl && nu; bl = bl->next, nu = nu->next) {
-        DispList *dl;
-        float *data;
-        int a;
-
-        if (bl->nr) { /* blank bevel lists can happen */
-
-          /* exception handling; curve without bevel or extrude, with width correction */
-          if (BLI_listbase_is_empty(&dlbev)) {
-            BevPoint *bevp;
-            dl = MEM_callocN(sizeof(DispList), "makeDispListbev");
-            dl->verts = MEM_mallocN(sizeof(float[3]) * bl->nr, "dlverts");
-            BLI_addtail(dispbase, dl);
-
-            if (bl->poly != -1) {
-              dl->type = DL_POLY;
-            }
-            else {
-              dl->type = DL_SEGM;
-            }
-
-            if (dl->type == DL_SEGM) {
-              dl->flag = (DL_FRONT_CURVE | DL_BACK_CURVE);
-            }
-
-            dl->parts = 1;
-            dl->nr = bl->nr;
-            dl->col = nu->mat_nr;
-            dl->charidx = nu->charidx;
-
-            /* dl->rt will be used as flag for render face and */
-            /* CU_2D conflicts with R_NOPUNOFLIP */
-            dl->rt = nu->flag & ~CU_2D;
-
-            a = dl->nr;
-            bevp = bl->bevpoints;
-            data = dl->verts;
-            while (a--) {
-              data[0] = bevp->vec[0] + widfac * bevp->sina;
-              data[1] = bevp->vec[1] + widfac * bevp->cosa;
-              data[2] = bevp->vec[2];
-              bevp++;
-              data += 3;
-            }
-          }
-          else {
-            DispList *dlb;
-            ListBase bottom_capbase = {NULL, NULL};
-            ListBase top_capbase = {NULL, NULL};
-            float bottom_no[3] = {0.0f};
-            float top_no[3] = {0.0f};
-            float firstblend = 0.0f, lastblend = 0.0f;
-            int i, start, steps = 0;
-
-            if (nu->flagu & CU_NURB_CYCLIC) {
-              calc_bevfac_mapping_default(bl, &start, &firstblend, &steps, &lastblend);
-            }
-            else {
-              if (fabsf(cu->bevfac2 - cu->bevfac1) < FLT_EPSILON) {
-                continue;
-              }
-
-              calc_bevfac_mapping(cu, bl, nu, &start, &firstblend, &steps, &lastblend);
-            }
-
-            for (dlb = dlbev.first; dlb; dlb = dlb->next) {
-              BevPoint *bevp_first, *bevp_last;
-              BevPoint *bevp;
-
-              /* for each part of the bevel use a separate displblock */
-              dl = MEM_callocN(sizeof(DispList), "makeDispListbev1");
-              dl->verts = data = MEM_mallocN(sizeof(float[3]) * dlb->nr * steps, "dlverts");
-              BLI_addtail(dispbase, dl);
-
-              dl->type = DL_SURF;
-
-              dl->flag = dlb->flag & (DL_FRONT_CURVE | DL_BACK_CURVE);
-              if (dlb->type == DL_POLY) {
-                dl->flag |= DL_CYCL_U;
-              }
-              if ((bl->poly >= 0) && (steps > 2)) {
-                dl->flag |= DL_CYCL_V;
-              }
-
-              dl->parts = steps;
-              dl->nr = dlb->nr;
-              dl->col = nu->mat_nr;
-              dl->charidx = nu->charidx;
-
-              /* dl->rt will be used as flag for render face and */
-              /* CU_2D conflicts with R_NOPUNOFLIP */
-              dl->rt = nu->flag & ~CU_2D;
-
-              dl->bevel_split = BLI_BITMAP_NEW(steps, "bevel_split");
-
-              /* for each point of poly make a bevel piece */
-              bevp_first = bl->bevpoints;
-              bevp_last = &bl->bevpoints[bl->nr - 1];
-              bevp = &bl->bevpoints[start];
-              for (i = start, a = 0; a < steps; i++, bevp++, a++) {
-                float fac = 1.0;
-                float *cur_data = data;
-
-                if (cu->taperobj == NULL) {
-                  fac = bevp->radius;
-                }
-                else {
-                  float len, taper_fac;
-
-                  if (cu->flag & CU_MAP_TAPER) {
-                    len = (steps - 3) + firstblend + lastblend;
-
-                    if (a == 0) {
-                      taper_fac = 0.0f;
-                    }
-                    else if (a == steps - 1) {
-                      taper_fac = 1.0f;
-                    }
-                    else {
-                      taper_fac = ((float)a - (1.0f - firstblend)) / len;
-                    }
-                  }
-                  else {
-                    len = bl->nr - 1;
-                    taper_fac = (float)i / len;
-
-                    if (a == 0) {
-                      taper_fac += (1.0f - firstblend) / len;
-                    }
-                    else if (a == steps - 1) {
-                      taper_fac -= (1.0f - lastblend) / len;
-                    }
-                  }
-
-                  fac = displist_calc_taper(depsgraph, scene, cu->taperobj, taper_fac);
-                }
-
-                if (bevp->split_tag) {
-                  BLI_BITMAP_ENABLE(dl->bevel_split, a);
-                }
-
-                /* rotate bevel piece and write in data */
-                if ((a == 0) && (bevp != bevp_last)) {
-                  rotateBevelPiece(cu, bevp, bevp + 1, dlb, 1.0f - firstblend, widfac, fac, &data);
-                }
-                else if ((a == steps - 1) && (bevp != bevp_first)) {
-                  rotateBevelPiece(cu, bevp, bevp - 1, dlb, 1.0f - lastblend, widfac, fac, &data);
-                }
-                else {
-                  rotateBevelPiece(cu, bevp, NULL, dlb, 0.0f, widfac, fac, &data);
-                }
-
-                if (cu->bevobj && (cu->flag & CU_FILL_CAPS) && !(nu->flagu & CU_NURB_CYCLIC)) {
-                  if (a == 1) {
-                    fillBevelCap(nu, dlb, cur_data - 3 * dlb->nr, &bottom_capbase);
-                    copy_v3_v3(bottom_no, bevp->dir);
-                  }
-                  if (a == steps - 1) {
-                    fillBevelCap(nu, dlb, cur_data, &top_capbase);
-                    negate_v3_v3(top_no, bevp->dir);
-                  }
-                }
-              }
-
-              /* gl array drawing: using indices */
-              displist_surf_indices(dl);
-            }
-
-            if (bottom_capbase.first) {
-              BKE_displist_fill(&bottom_capbase, dispbase, bottom_no, false);
-              BKE_displist_fill(&top_capbase, dispbase, top_no, false);
-              BKE_displist_free(&bottom_capbase);
-              BKE_displist_free(&top_capbase);
-            }
-          }
-        }
-      }
+      curve_bevel_splines_to_displist(depsgraph, scene, ob, &nubase, &dlbev, dispbase);
       BKE_displist_free(&dlbev);
     }
 
@@ -2734,7 +2734,31 @@ static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime
      *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
      *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
      */
-    a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+    const float threshold = 0.0001f;
+    const unsigned int hint = (unsigned int)max_ii(fcu->segment_hint, 0);
+
+    /* Consecutive frames usually stay in the same segment or move on to the next one, check
+     * those before searching. Only a time that is not within search threshold of either key
+     * is accepted, as the search would not find an exact match for it either. Different users
+     * of the same F-Curve may update the hint concurrently, which is fine since it's validated
+     * before use. */
+    if ((hint > 0) && (hint < fcu->totvert) &&
+        (bezts[hint - 1].vec[1][0] <= evaltime - threshold) &&
+        (evaltime + threshold <= bezts[hint].vec[1][0])) {
+      a = hint;
+    }
+    else if ((hint > 0) && (hint + 1 < fcu->totvert) &&
+             (bezts[hint].vec[1][0] <= evaltime - threshold) &&
+             (evaltime + threshold <= bezts[hint + 1].vec[1][0])) {
+      a = hint + 1;
+    }
+    else {
+      a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+    }
+
+    if (!exact) {
+      fcu->segment_hint = (int)a;
+    }
 
     if (exact) {
       /* index returned must be interpreted differently when it sits on top of an existing keyframe
@@ -3088,14 +3088,133 @@ static void update_effectors(
   BKE_effectors_free(effectors);
 }
 
-static Mesh *create_liquid_geometry(FluidDomainSettings *mds, Mesh *orgmesh, Object *ob)
-{
-  Mesh *me;
+typedef struct LiquidMeshData {
+  FluidDomainSettings *mds;
   MVert *mverts;
+  short (*normals)[3];
   MPoly *mpolys;
   MLoop *mloops;
-  short *normals, *no_s;
+  FluidDomainVertexVelocity *velarray;
+  short mp_mat_nr;
+  char mp_flag;
+  float max_size;
+  float ob_scale[3];
+  float time_mult;
+} LiquidMeshData;
+
+static void create_liquid_geometry_verts_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LiquidMeshData *data = userdata;
+  FluidDomainSettings *mds = data->mds;
+  MVert *mverts = &data->mverts[i];
+
+  // read raw data. is normalized cube around domain origin
+  mverts->co[0] = manta_liquid_get_vertex_x_at(mds->fluid, i);
+  mverts->co[1] = manta_liquid_get_vertex_y_at(mds->fluid, i);
+  mverts->co[2] = manta_liquid_get_vertex_z_at(mds->fluid, i);
+
+  // if reading raw data directly from manta, normalize now, otherwise omit this, ie when reading
+  // from files
+  {
+    // normalize to unit cube around 0
+    mverts->co[0] -= ((float)mds->res[0] * mds->mesh_scale) * 0.5f;
+    mverts->co[1] -= ((float)mds->res[1] * mds->mesh_scale) * 0.5f;
+    mverts->co[2] -= ((float)mds->res[2] * mds->mesh_scale) * 0.5f;
+    mverts->co[0] *= mds->dx / mds->mesh_scale;
+    mverts->co[1] *= mds->dx / mds->mesh_scale;
+    mverts->co[2] *= mds->dx / mds->mesh_scale;
+  }
+
+  mverts->co[0] *= data->max_size / fabsf(data->ob_scale[0]);
+  mverts->co[1] *= data->max_size / fabsf(data->ob_scale[1]);
+  mverts->co[2] *= data->max_size / fabsf(data->ob_scale[2]);
+#  ifdef DEBUG_PRINT
+  /* Debugging: Print coordinates of vertices. */
+  printf("mverts->co[0]: %f, mverts->co[1]: %f, mverts->co[2]: %f\n",
+         mverts->co[0],
+         mverts->co[1],
+         mverts->co[2]);
+#  endif
+}
+
+static void create_liquid_geometry_normals_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LiquidMeshData *data = userdata;
+  FluidDomainSettings *mds = data->mds;
+  short *no_s = data->normals[i];
   float no[3];
+
+  no[0] = manta_liquid_get_normal_x_at(mds->fluid, i);
+  no[1] = manta_liquid_get_normal_y_at(mds->fluid, i);
+  no[2] = manta_liquid_get_normal_z_at(mds->fluid, i);
+
+  normal_float_to_short_v3(no_s, no);
+#  ifdef DEBUG_PRINT
+  /* Debugging: Print coordinates of normals. */
+  printf("no_s[0]: %d, no_s[1]: %d, no_s[2]: %d\n", no_s[0], no_s[1], no_s[2]);
+#  endif
+}
+
+static void create_liquid_geometry_faces_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LiquidMeshData *data = userdata;
+  FluidDomainSettings *mds = data->mds;
+  MPoly *mpolys = &data->mpolys[i];
+  MLoop *mloops = &data->mloops[i * 3];
+
+  /* initialize from existing face */
+  mpolys->mat_nr = data->mp_mat_nr;
+  mpolys->flag = data->mp_flag;
+
+  mpolys->loopstart = i * 3;
+  mpolys->totloop = 3;
+
+  mloops[0].v = manta_liquid_get_triangle_x_at(mds->fluid, i);
+  mloops[1].v = manta_liquid_get_triangle_y_at(mds->fluid, i);
+  mloops[2].v = manta_liquid_get_triangle_z_at(mds->fluid, i);
+#  ifdef DEBUG_PRINT
+  /* Debugging: Print mesh faces. */
+  printf("mloops[0].v: %d, mloops[1].v: %d, mloops[2].v: %d\n",
+         mloops[0].v,
+         mloops[1].v,
+         mloops[2].v);
+#  endif
+}
+
+static void create_liquid_geometry_velocities_cb(void *__restrict userdata,
+                                                 const int i,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LiquidMeshData *data = userdata;
+  FluidDomainSettings *mds = data->mds;
+  FluidDomainVertexVelocity *velarray = data->velarray;
+  const float time_mult = data->time_mult;
+
+  velarray[i].vel[0] = manta_liquid_get_vertvel_x_at(mds->fluid, i) * (mds->dx / time_mult);
+  velarray[i].vel[1] = manta_liquid_get_vertvel_y_at(mds->fluid, i) * (mds->dx / time_mult);
+  velarray[i].vel[2] = manta_liquid_get_vertvel_z_at(mds->fluid, i) * (mds->dx / time_mult);
+#  ifdef DEBUG_PRINT
+  /* Debugging: Print velocities of vertices. */
+  printf("velarray[%d].vel[0]: %f, velarray[%d].vel[1]: %f, velarray[%d].vel[2]: %f\n",
+         i,
+         velarray[i].vel[0],
+         i,
+         velarray[i].vel[1],
+         i,
+         velarray[i].vel[2]);
+#  endif
+}
+
+static Mesh *create_liquid_geometry(FluidDomainSettings *mds, Mesh *orgmesh, Object *ob)
+{
+  Mesh *me;
+  short(*normals)[3];
   float min[3];
   float max[3];
   float size[3];
@@ -3111,10 +3230,6 @@ static Mesh *create_liquid_geometry(FluidDomainSettings *mds, Mesh *orgmesh, Obj
   }
   /* else leave NULL'd */
 
-  const short mp_mat_nr = mp_example.mat_nr;
-  const char mp_flag = mp_example.flag;
-
-  int i;
   int num_verts, num_normals, num_faces;
 
   if (!mds->fluid) {
@@ -3135,9 +3250,6 @@ static Mesh *create_liquid_geometry(FluidDomainSettings *mds, Mesh *orgmesh, Obj
   }
 
   me = BKE_mesh_new_nomain(num_verts, 0, 0, num_faces * 3, num_faces);
-  mverts = me->mvert;
-  mpolys = me->mpoly;
-  mloops = me->mloop;
   if (!me) {
     return NULL;
   }
@@ -3149,79 +3261,39 @@ static Mesh *create_liquid_geometry(FluidDomainSettings *mds, Mesh *orgmesh, Obj
   madd_v3fl_v3fl_v3fl_v3i(max, mds->p0, cell_size_scaled, mds->res_max);
   sub_v3_v3v3(size, max, min);
 
-  // Biggest dimension will be used for upscaling
-  float max_size = MAX3(size[0], size[1], size[2]);
+  normals = MEM_callocN(sizeof(short) * num_normals * 3, "Fluidmesh_tmp_normals");
+
+  /* The mesh elements are read from the solver independently of each other. */
+  LiquidMeshData data = {
+      .mds = mds,
+      .mverts = me->mvert,
+      .normals = normals,
+      .mpolys = me->mpoly,
+      .mloops = me->mloop,
+      .mp_mat_nr = mp_example.mat_nr,
+      .mp_flag = mp_example.flag,
+      // Biggest dimension will be used for upscaling
+      .max_size = MAX3(size[0], size[1], size[2]),
+      .time_mult = 25.f * DT_DEFAULT,
+  };
+  copy_v3_v3(data.ob_scale, ob->scale);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4096;
 
   // Vertices
-  for (i = 0; i < num_verts; i++, mverts++) {
-    // read raw data. is normalized cube around domain origin
-    mverts->co[0] = manta_liquid_get_vertex_x_at(mds->fluid, i);
-    mverts->co[1] = manta_liquid_get_vertex_y_at(mds->fluid, i);
-    mverts->co[2] = manta_liquid_get_vertex_z_at(mds->fluid, i);
-
-    // if reading raw data directly from manta, normalize now, otherwise omit this, ie when reading
-    // from files
-    {
-      // normalize to unit cube around 0
-      mverts->co[0] -= ((float)mds->res[0] * mds->mesh_scale) * 0.5f;
-      mverts->co[1] -= ((float)mds->res[1] * mds->mesh_scale) * 0.5f;
-      mverts->co[2] -= ((float)mds->res[2] * mds->mesh_scale) * 0.5f;
-      mverts->co[0] *= mds->dx / mds->mesh_scale;
-      mverts->co[1] *= mds->dx / mds->mesh_scale;
-      mverts->co[2] *= mds->dx / mds->mesh_scale;
-    }
-
-    mverts->co[0] *= max_size / fabsf(ob->scale[0]);
-    mverts->co[1] *= max_size / fabsf(ob->scale[1]);
-    mverts->co[2] *= max_size / fabsf(ob->scale[2]);
-#  ifdef DEBUG_PRINT
-    /* Debugging: Print coordinates of vertices. */
-    printf("mverts->co[0]: %f, mverts->co[1]: %f, mverts->co[2]: %f\n",
-           mverts->co[0],
-           mverts->co[1],
-           mverts->co[2]);
-#  endif
-  }
+  BLI_task_parallel_range(0, num_verts, &data, create_liquid_geometry_verts_cb, &settings);
 
   // Normals
-  normals = MEM_callocN(sizeof(short) * num_normals * 3, "Fluidmesh_tmp_normals");
-
-  for (i = 0, no_s = normals; i < num_normals; no_s += 3, i++) {
-    no[0] = manta_liquid_get_normal_x_at(mds->fluid, i);
-    no[1] = manta_liquid_get_normal_y_at(mds->fluid, i);
-    no[2] = manta_liquid_get_normal_z_at(mds->fluid, i);
-
-    normal_float_to_short_v3(no_s, no);
-#  ifdef DEBUG_PRINT
-    /* Debugging: Print coordinates of normals. */
-    printf("no_s[0]: %d, no_s[1]: %d, no_s[2]: %d\n", no_s[0], no_s[1], no_s[2]);
-#  endif
-  }
+  BLI_task_parallel_range(0, num_normals, &data, create_liquid_geometry_normals_cb, &settings);
 
   // Triangles
-  for (i = 0; i < num_faces; i++, mpolys++, mloops += 3) {
-    /* initialize from existing face */
-    mpolys->mat_nr = mp_mat_nr;
-    mpolys->flag = mp_flag;
-
-    mpolys->loopstart = i * 3;
-    mpolys->totloop = 3;
-
-    mloops[0].v = manta_liquid_get_triangle_x_at(mds->fluid, i);
-    mloops[1].v = manta_liquid_get_triangle_y_at(mds->fluid, i);
-    mloops[2].v = manta_liquid_get_triangle_z_at(mds->fluid, i);
-#  ifdef DEBUG_PRINT
-    /* Debugging: Print mesh faces. */
-    printf("mloops[0].v: %d, mloops[1].v: %d, mloops[2].v: %d\n",
-           mloops[0].v,
-           mloops[1].v,
-           mloops[2].v);
-#  endif
-  }
+  BLI_task_parallel_range(0, num_faces, &data, create_liquid_geometry_faces_cb, &settings);
 
   BKE_mesh_ensure_normals(me);
   BKE_mesh_calc_edges(me, false, false);
-  BKE_mesh_vert_normals_apply(me, (short(*)[3])normals);
+  BKE_mesh_vert_normals_apply(me, (const short(*)[3])normals);
 
   MEM_freeN(normals);
 
@@ -3238,26 +3310,8 @@ static Mesh *create_liquid_geometry(FluidDomainSettings *mds, Mesh *orgmesh, Obj
       num_verts, sizeof(FluidDomainVertexVelocity), "Fluidmesh_vertvelocities");
   mds->totvert = num_verts;
 
-  FluidDomainVertexVelocity *velarray = NULL;
-  velarray = mds->mesh_velocities;
-
-  float time_mult = 25.f * DT_DEFAULT;
-
-  for (i = 0; i < num_verts; i++, mverts++) {
-    velarray[i].vel[0] = manta_liquid_get_vertvel_x_at(mds->fluid, i) * (mds->dx / time_mult);
-    velarray[i].vel[1] = manta_liquid_get_vertvel_y_at(mds->fluid, i) * (mds->dx / time_mult);
-    velarray[i].vel[2] = manta_liquid_get_vertvel_z_at(mds->fluid, i) * (mds->dx / time_mult);
-#  ifdef DEBUG_PRINT
-    /* Debugging: Print velocities of vertices. */
-    printf("velarray[%d].vel[0]: %f, velarray[%d].vel[1]: %f, velarray[%d].vel[2]: %f\n",
-           i,
-           velarray[i].vel[0],
-           i,
-           velarray[i].vel[1],
-           i,
-           velarray[i].vel[2]);
-#  endif
-  }
+  data.velarray = mds->mesh_velocities;
+  BLI_task_parallel_range(0, num_verts, &data, create_liquid_geometry_velocities_cb, &settings);
 
   return me;
 }
@@ -30,6 +30,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -526,6 +527,31 @@ static void rel_flerp(int tot, float *in, float *ref, float *out, float fac)
   }
 }
 
+/* Same as rel_flerp for an array of coordinates, simple enough for the compiler to vectorize. */
+static void rel_flerp_v3_array(int tot,
+                               float (*in)[3],
+                               const float (*ref)[3],
+                               const float (*out)[3],
+                               const float *weights,
+                               float fac)
+{
+  if (weights) {
+    for (int a = 0; a < tot; a++) {
+      const float weight = weights[a] * fac;
+      in[a][0] -= weight * (ref[a][0] - out[a][0]);
+      in[a][1] -= weight * (ref[a][1] - out[a][1]);
+      in[a][2] -= weight * (ref[a][2] - out[a][2]);
+    }
+  }
+  else {
+    for (int a = 0; a < tot; a++) {
+      in[a][0] -= fac * (ref[a][0] - out[a][0]);
+      in[a][1] -= fac * (ref[a][1] - out[a][1]);
+      in[a][2] -= fac * (ref[a][2] - out[a][2]);
+    }
+  }
+}
+
 static char *key_block_get_data(Key *key, KeyBlock *actkb, KeyBlock *kb, char **freedata)
 {
   if (kb == actkb) {
@@ -835,8 +861,25 @@ static void key_evaluate_relative(const int start,
         poin += start * poinsize;
         reffrom += key->elemsize * start;  // key elemsize yes!
         from += key->elemsize * start;
+        if (weights) {
+          weights += start;
+        }
+        b = start;
+
+        /* Mesh and lattice keys only contain coordinates. */
+        if (mode != KEY_MODE_BEZTRIPLE && step == 1 && key->elemstr[0] == 1 &&
+            key->elemstr[1] == IPO_FLOAT && key->elemstr[2] == 0 &&
+            elemsize == sizeof(float[KEYELEM_FLOAT_LEN_COORD]) && poinsize == elemsize) {
+          rel_flerp_v3_array(end - start,
+                             (float(*)[3])poin,
+                             (const float(*)[3])reffrom,
+                             (const float(*)[3])from,
+                             weights,
+                             icuval);
+          b = end;
+        }
 
-        for (b = start; b < end; b += step) {
+        for (; b < end; b += step) {
 
           weight = weights ? (*weights * icuval) : icuval;
 
@@ -1296,6 +1339,34 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+/* Number of vertices all relative keys are applied to before moving on to the next ones. */
+#define KEY_RELATIVE_CHUNK_SIZE 4096
+
+typedef struct KeyEvaluateRelativeData {
+  Key *key;
+  KeyBlock *actkb;
+  float **per_keyblock_weights;
+  char *out;
+  int tot;
+} KeyEvaluateRelativeData;
+
+static void key_evaluate_relative_chunk_cb(void *__restrict userdata,
+                                           const int chunk,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KeyEvaluateRelativeData *data = userdata;
+  const int start = chunk * KEY_RELATIVE_CHUNK_SIZE;
+
+  key_evaluate_relative(start,
+                        start + KEY_RELATIVE_CHUNK_SIZE,
+                        data->tot,
+                        data->out,
+                        data->key,
+                        data->actkb,
+                        data->per_keyblock_weights,
+                        KEY_MODE_DUMMY);
+}
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1306,8 +1377,33 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, NULL};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+
+    /* Chunks of vertices are evaluated in parallel, each with all keys applied to it while the
+     * output stays in cache. In edit-mode the data of the active key is copied from the edit
+     * mesh on every call, so that's done once for the whole mesh instead. */
+    const Mesh *me = ob->data;
+    if (me->edit_mesh == NULL) {
+      KeyEvaluateRelativeData data = {
+          .key = key,
+          .actkb = actkb,
+          .per_keyblock_weights = per_keyblock_weights,
+          .out = out,
+          .tot = tot,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1;
+      BLI_task_parallel_range(0,
+                              (tot + KEY_RELATIVE_CHUNK_SIZE - 1) / KEY_RELATIVE_CHUNK_SIZE,
+                              &data,
+                              key_evaluate_relative_chunk_cb,
+                              &settings);
+    }
+    else {
+      key_evaluate_relative(
+          0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    }
+
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
@@ -1104,6 +1104,7 @@ void BKE_main_id_repair_duplicate_names_listbase(ListBase *lb)
   /* Fill an array because renaming sorts. */
   ID **id_array = MEM_mallocN(sizeof(*id_array) * lb_len, __func__);
   GSet *gset = BLI_gset_str_new_ex(__func__, lb_len);
+  BKE_id_new_name_index_begin(lb);
   int i = 0;
   for (ID *id = lb->first; id; id = id->next) {
     if (id->lib == NULL) {
@@ -1116,6 +1117,7 @@ void BKE_main_id_repair_duplicate_names_listbase(ListBase *lb)
       BKE_id_new_name_validate(lb, id_array[i], NULL);
     }
   }
+  BKE_id_new_name_index_end(lb);
   BLI_gset_free(gset, NULL);
   MEM_freeN(id_array);
 }
@@ -1688,6 +1690,189 @@ static bool id_name_final_build(char *name, char *base_name, size_t base_name_le
   return true;
 }
 
+/* Index of the names used in an ID list, see #BKE_id_new_name_index_begin. */
+typedef struct IDNameIndexBase {
+  /* Highest number used as suffix of the base name, and the ID using it (if known). */
+  int max_number;
+  ID *max_number_id;
+  /* Numbers smaller than MAX_NUMBERS_IN_USE used as suffix, allocated on first use. */
+  BLI_bitmap *numbers_in_use;
+} IDNameIndexBase;
+
+typedef struct IDNameIndex {
+  struct IDNameIndex *next, *prev;
+  ListBase *lb;
+  /* All names in use including their number suffix, values are the IDs using them. */
+  GHash *names;
+  /* Base names without number suffix, values are #IDNameIndexBase. */
+  GHash *base_names;
+  MemArena *arena;
+} IDNameIndex;
+
+static ListBase id_name_indices = {NULL, NULL};
+
+static IDNameIndex *id_name_index_find(ListBase *lb)
+{
+  for (IDNameIndex *index = id_name_indices.first; index; index = index->next) {
+    if (index->lb == lb) {
+      return index;
+    }
+  }
+  return NULL;
+}
+
+static char *id_name_index_strdup(IDNameIndex *index, const char *str, const size_t str_len)
+{
+  char *str_copy = BLI_memarena_alloc(index->arena, str_len + 1);
+  memcpy(str_copy, str, str_len + 1);
+  return str_copy;
+}
+
+static void id_name_index_add(IDNameIndex *index, ID *id, const char *name)
+{
+  char base_name[MAX_ID_NAME - 2];
+  int number;
+  const size_t base_name_len = BLI_split_name_num(base_name, &number, name, '.');
+
+  void **id_p = BLI_ghash_lookup_p(index->names, name);
+  if (id_p == NULL) {
+    BLI_ghash_insert(index->names, id_name_index_strdup(index, name, strlen(name)), id);
+  }
+  else if (*id_p == NULL || !STREQ(((ID *)*id_p)->name + 2, name)) {
+    /* Keep the first ID when there are duplicates, so the others get renamed. */
+    *id_p = id;
+  }
+
+  IDNameIndexBase *base = BLI_ghash_lookup(index->base_names, base_name);
+  if (base == NULL) {
+    base = BLI_memarena_calloc(index->arena, sizeof(*base));
+    BLI_ghash_insert(
+        index->base_names, id_name_index_strdup(index, base_name, base_name_len), base);
+  }
+
+  if (number >= MIN_NUMBER && number < MAX_NUMBERS_IN_USE) {
+    if (base->numbers_in_use == NULL) {
+      base->numbers_in_use = BLI_BITMAP_NEW_MEMARENA(index->arena, MAX_NUMBERS_IN_USE);
+    }
+    BLI_BITMAP_ENABLE(base->numbers_in_use, number);
+  }
+  if (number >= base->max_number) {
+    base->max_number = number;
+    base->max_number_id = id;
+  }
+}
+
+static bool id_name_index_is_used(IDNameIndex *index, ID *id, const char *name)
+{
+  void **id_p = BLI_ghash_lookup_p(index->names, name);
+  if (id_p == NULL) {
+    return false;
+  }
+  ID *id_test = *id_p;
+  if (id_test == NULL) {
+    /* Name was only requested, without an actual ID. */
+    return true;
+  }
+  /* The ID may have been renamed since it was indexed. */
+  return (id_test != id) && STREQ(id_test->name + 2, name);
+}
+
+/**
+ * Same as #check_for_dupid, using the name index instead of going over the whole list.
+ */
+static bool id_name_index_check(IDNameIndex *index, ID *id, char *name, ID **r_id_sorting_hint)
+{
+  bool is_name_changed = false;
+
+  while (true) {
+    if (!id_name_index_is_used(index, id, name)) {
+      id_name_index_add(index, id, name);
+      return is_name_changed;
+    }
+
+    char base_name[MAX_ID_NAME - 2];
+    int number = MIN_NUMBER;
+    size_t base_name_len = BLI_split_name_num(base_name, &number, name, '.');
+
+    if (number >= MAX_NUMBER || number < MIN_NUMBER) {
+      number = MIN_NUMBER;
+    }
+
+    /* The name is used, so its base name is known too. */
+    IDNameIndexBase *base = BLI_ghash_lookup(index->base_names, base_name);
+    BLI_assert(base != NULL);
+
+    if (number <= base->max_number) {
+      number = base->max_number + 1;
+      *r_id_sorting_hint = base->max_number_id;
+    }
+
+    /* Use the smallest unused number if possible, like #check_for_dupid. */
+    for (int i = MIN_NUMBER; i < MAX_NUMBERS_IN_USE; i++) {
+      if (base->numbers_in_use == NULL || !BLI_BITMAP_TEST(base->numbers_in_use, i)) {
+        number = i;
+        *r_id_sorting_hint = NULL;
+        break;
+      }
+    }
+
+    is_name_changed = true;
+
+    if (!id_name_final_build(name, base_name, base_name_len, number)) {
+      continue;
+    }
+
+    id_name_index_add(index, id, name);
+    return is_name_changed;
+  }
+}
+
+/**
+ * Start indexing the names used in given list, so that unique names for new IDs are found without
+ * going over the whole list. Meant for code adding lots of IDs at once.
+ *
+ * \warning Until #BKE_id_new_name_index_end is called, IDs of the list may only be renamed through
+ * #BKE_id_new_name_validate, and no ID may be removed from it.
+ * Renaming may leave numbers marked as used, so those won't be reused while indexing.
+ */
+void BKE_id_new_name_index_begin(ListBase *lb)
+{
+  BLI_assert(id_name_index_find(lb) == NULL);
+
+  IDNameIndex *index = MEM_callocN(sizeof(*index), __func__);
+  index->lb = lb;
+  index->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+
+  int lb_len = 0;
+  for (ID *id = lb->first; id; id = id->next) {
+    if (!ID_IS_LINKED(id)) {
+      lb_len++;
+    }
+  }
+  index->names = BLI_ghash_str_new_ex(__func__, (unsigned int)lb_len);
+  index->base_names = BLI_ghash_str_new_ex(__func__, (unsigned int)lb_len);
+
+  for (ID *id = lb->first; id; id = id->next) {
+    if (!ID_IS_LINKED(id)) {
+      id_name_index_add(index, id, id->name + 2);
+    }
+  }
+
+  BLI_addtail(&id_name_indices, index);
+}
+
+void BKE_id_new_name_index_end(ListBase *lb)
+{
+  IDNameIndex *index = id_name_index_find(lb);
+  BLI_assert(index != NULL);
+
+  BLI_remlink(&id_name_indices, index);
+  BLI_ghash_free(index->names, NULL, NULL);
+  BLI_ghash_free(index->base_names, NULL, NULL);
+  BLI_memarena_free(index->arena);
+  MEM_freeN(index);
+}
+
 /**
  * Check to see if an ID name is already used, and find a new one if so.
  * Return true if a new name was created (returned in name).
@@ -1702,6 +1887,11 @@ static bool check_for_dupid(ListBase *lb, ID *id, char *name, ID **r_id_sorting_
 
   *r_id_sorting_hint = NULL;
 
+  IDNameIndex *index = id_name_indices.first ? id_name_index_find(lb) : NULL;
+  if (index != NULL) {
+    return id_name_index_check(index, id, name, r_id_sorting_hint);
+  }
+
   ID *id_test = lb->first;
   bool is_name_changed = false;
 
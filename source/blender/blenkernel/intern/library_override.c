@@ -39,6 +39,7 @@
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "RNA_access.h"
 #include "RNA_types.h"
@@ -708,19 +709,99 @@ bool BKE_override_library_operations_create(Main *bmain, ID *local, const bool f
   return ret;
 }
 
+typedef struct OverrideLibraryOperationsCreateData {
+  Main *bmain;
+  bool force_auto;
+} OverrideLibraryOperationsCreateData;
+
+typedef struct OverrideLibraryOperationsCreateTask {
+  ID *id;
+  /* Local data differs from its reference, it may have to be restored. */
+  bool needs_restore;
+} OverrideLibraryOperationsCreateTask;
+
+static void override_library_operations_create_cb(TaskPool *__restrict pool,
+                                                  void *taskdata,
+                                                  int UNUSED(threadid))
+{
+  OverrideLibraryOperationsCreateData *data = BLI_task_pool_userdata(pool);
+  OverrideLibraryOperationsCreateTask *task = taskdata;
+  ID *local = task->id;
+
+  if (!(data->force_auto || local->override_library->flag & OVERRIDE_LIBRARY_AUTO) ||
+      local->override_library->reference == NULL ||
+      ID_MISSING(local->override_library->reference)) {
+    return;
+  }
+
+  PointerRNA rnaptr_local, rnaptr_reference;
+  RNA_id_pointer_create(local, &rnaptr_local);
+  RNA_id_pointer_create(local->override_library->reference, &rnaptr_reference);
+
+  /* Only the override rules of this ID get modified here. Restoring values from the reference
+   * may change user counts of other IDs, so that is left to the caller. */
+  task->needs_restore = !RNA_struct_override_matches(data->bmain,
+                                                     &rnaptr_local,
+                                                     &rnaptr_reference,
+                                                     NULL,
+                                                     local->override_library,
+                                                     RNA_OVERRIDE_COMPARE_CREATE,
+                                                     NULL);
+}
+
 /** Check all overrides from given \a bmain and create/update overriding operations as needed. */
 void BKE_main_override_library_operations_create(Main *bmain, const bool force_auto)
 {
   ID *id;
+  int tasks_len = 0;
 
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if ((ID_IS_OVERRIDE_LIBRARY(id) && force_auto) ||
         (ID_IS_OVERRIDE_LIBRARY_AUTO(id) && (id->tag & LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH))) {
-      BKE_override_library_operations_create(bmain, id, force_auto);
+      tasks_len++;
+    }
+  }
+  FOREACH_MAIN_ID_END;
+
+  if (tasks_len == 0) {
+    return;
+  }
+
+  OverrideLibraryOperationsCreateTask *tasks = MEM_calloc_arrayN(
+      (size_t)tasks_len, sizeof(*tasks), __func__);
+  int i = 0;
+
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if ((ID_IS_OVERRIDE_LIBRARY(id) && force_auto) ||
+        (ID_IS_OVERRIDE_LIBRARY_AUTO(id) && (id->tag & LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH))) {
+      tasks[i++].id = id;
       id->tag &= ~LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH;
     }
   }
   FOREACH_MAIN_ID_END;
+
+  /* Each override is only compared to its own reference, so they can be diffed in parallel. */
+  OverrideLibraryOperationsCreateData data = {
+      .bmain = bmain,
+      .force_auto = force_auto,
+  };
+  TaskPool *task_pool = BLI_task_pool_create(BLI_task_scheduler_get(), &data);
+  for (i = 0; i < tasks_len; i++) {
+    BLI_task_pool_push(
+        task_pool, override_library_operations_create_cb, &tasks[i], false, TASK_PRIORITY_HIGH);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+
+  /* Unchanged overrides match their reference, only the others are compared again, this time
+   * also restoring values from the reference. */
+  for (i = 0; i < tasks_len; i++) {
+    if (tasks[i].needs_restore) {
+      BKE_override_library_operations_create(bmain, tasks[i].id, force_auto);
+    }
+  }
+
+  MEM_freeN(tasks);
 }
 
 /** Update given override from its reference (re-applying overridden properties). */
@@ -39,6 +39,7 @@
 #include "BLI_string_utils.h"
 #include "BLI_utildefines.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -130,6 +131,10 @@ typedef struct process {     /* parameters, storage */
   unsigned int totvertex;   /* memory size */
   unsigned int curvertex;   /* currently added vertices */
 
+  /* Corners of the edge each vertex lies on, positions and normals are computed from these
+   * in parallel once all cubes are processed, see #polygonize_vertices. */
+  const CORNER *(*vert_corners)[2];
+
   /* memory allocation from common pool */
   MemArena *pgn_elements;
 } PROCESS;
@@ -138,7 +143,11 @@ typedef struct process {     /* parameters, storage */
 static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2);
 static void add_cube(PROCESS *process, int i, int j, int k);
 static void make_face(PROCESS *process, int i1, int i2, int i3, int i4);
-static void converge(PROCESS *process, const CORNER *c1, const CORNER *c2, float r_p[3]);
+static void converge(PROCESS *process,
+                     MetaballBVHNode **bvh_queue,
+                     const CORNER *c1,
+                     const CORNER *c2,
+                     float r_p[3]);
 
 /* ******************* SIMPLE BVH ********************* */
 
@@ -406,24 +415,26 @@ static float densfunc(const MetaElem *ball, float x, float y, float z)
 /**
  * Computes density at given position form all metaballs which contain this point in their box.
  * Traverses BVH using a queue.
+ *
+ * \param bvh_queue: Of #PROCESS.bvh_queue_size items, each thread needs its own.
  */
-static float metaball(PROCESS *process, float x, float y, float z)
+static float metaball(PROCESS *process, MetaballBVHNode **bvh_queue, float x, float y, float z)
 {
   int i;
   float dens = 0.0f;
   unsigned int front = 0, back = 0;
   MetaballBVHNode *node;
 
-  process->bvh_queue[front++] = &process->metaball_bvh;
+  bvh_queue[front++] = &process->metaball_bvh;
 
   while (front != back) {
-    node = process->bvh_queue[back++];
+    node = bvh_queue[back++];
 
     for (i = 0; i < 2; i++) {
       if ((node->bb[i].min[0] <= x) && (node->bb[i].max[0] >= x) && (node->bb[i].min[1] <= y) &&
           (node->bb[i].max[1] >= y) && (node->bb[i].min[2] <= z) && (node->bb[i].max[2] >= z)) {
         if (node->child[i]) {
-          process->bvh_queue[front++] = node->child[i];
+          bvh_queue[front++] = node->child[i];
         }
         else {
           dens += densfunc(node->bb[i].ml, x, y, z);
@@ -442,10 +453,6 @@ static void make_face(PROCESS *process, int i1, int i2, int i3, int i4)
 {
   int *cur;
 
-#ifdef USE_ACCUM_NORMAL
-  float n[3];
-#endif
-
   if (UNLIKELY(process->totindex == process->curindex)) {
     process->totindex += 4096;
     process->indices = MEM_reallocN(process->indices, sizeof(int[4]) * process->totindex);
@@ -459,33 +466,6 @@ static void make_face(PROCESS *process, int i1, int i2, int i3, int i4)
   cur[1] = i2;
   cur[2] = i3;
   cur[3] = i4;
-
-#ifdef USE_ACCUM_NORMAL
-  if (i4 == i3) {
-    normal_tri_v3(n, process->co[i1], process->co[i2], process->co[i3]);
-    accumulate_vertex_normals_v3(process->no[i1],
-                                 process->no[i2],
-                                 process->no[i3],
-                                 NULL,
-                                 n,
-                                 process->co[i1],
-                                 process->co[i2],
-                                 process->co[i3],
-                                 NULL);
-  }
-  else {
-    normal_quad_v3(n, process->co[i1], process->co[i2], process->co[i3], process->co[i4]);
-    accumulate_vertex_normals_v3(process->no[i1],
-                                 process->no[i2],
-                                 process->no[i3],
-                                 process->no[i4],
-                                 n,
-                                 process->co[i1],
-                                 process->co[i2],
-                                 process->co[i3],
-                                 process->co[i4]);
-  }
-#endif
 }
 
 /* Frees allocated memory */
@@ -506,6 +486,9 @@ static void freepolygonize(PROCESS *process)
   if (process->bvh_queue) {
     MEM_freeN(process->bvh_queue);
   }
+  if (process->vert_corners) {
+    MEM_freeN(process->vert_corners);
+  }
   if (process->pgn_elements) {
     BLI_memarena_free(process->pgn_elements);
   }
@@ -697,7 +680,7 @@ static CORNER *setcorner(PROCESS *process, int i, int j, int k)
   c->k = k;
   c->co[2] = ((float)k - 0.5f) * process->size;
 
-  c->value = metaball(process, c->co[0], c->co[1], c->co[2]);
+  c->value = metaball(process, process->bvh_queue, c->co[0], c->co[1], c->co[2]);
 
   c->next = process->corners[index];
   process->corners[index] = c;
@@ -945,18 +928,21 @@ static int getedge(EDGELIST *table[], int i1, int j1, int k1, int i2, int j2, in
 }
 
 /**
- * Adds a vertex, expands memory if needed.
+ * Adds a vertex between two corners, expands memory if needed.
+ * Its position and normal are computed later, by #polygonize_vertices.
  */
-static void addtovertices(PROCESS *process, const float v[3], const float no[3])
+static void addtovertices(PROCESS *process, const CORNER *c1, const CORNER *c2)
 {
   if (process->curvertex == process->totvertex) {
     process->totvertex += 4096;
     process->co = MEM_reallocN(process->co, process->totvertex * sizeof(float[3]));
     process->no = MEM_reallocN(process->no, process->totvertex * sizeof(float[3]));
+    process->vert_corners = MEM_reallocN(process->vert_corners,
+                                         process->totvertex * sizeof(*process->vert_corners));
   }
 
-  copy_v3_v3(process->co[process->curvertex], v);
-  copy_v3_v3(process->no[process->curvertex], no);
+  process->vert_corners[process->curvertex][0] = c1;
+  process->vert_corners[process->curvertex][1] = c2;
 
   process->curvertex++;
 }
@@ -967,40 +953,34 @@ static void addtovertices(PROCESS *process, const float v[3], const float no[3])
  *
  * \note Doesn't do normalization!
  */
-static void vnormal(PROCESS *process, const float point[3], float r_no[3])
+static void vnormal(PROCESS *process,
+                    MetaballBVHNode **bvh_queue,
+                    const float point[3],
+                    float r_no[3])
 {
   const float delta = process->delta;
-  const float f = metaball(process, point[0], point[1], point[2]);
+  const float f = metaball(process, bvh_queue, point[0], point[1], point[2]);
 
-  r_no[0] = metaball(process, point[0] + delta, point[1], point[2]) - f;
-  r_no[1] = metaball(process, point[0], point[1] + delta, point[2]) - f;
-  r_no[2] = metaball(process, point[0], point[1], point[2] + delta) - f;
+  r_no[0] = metaball(process, bvh_queue, point[0] + delta, point[1], point[2]) - f;
+  r_no[1] = metaball(process, bvh_queue, point[0], point[1] + delta, point[2]) - f;
+  r_no[2] = metaball(process, bvh_queue, point[0], point[1], point[2] + delta) - f;
 }
 #endif /* USE_ACCUM_NORMAL */
 
 /**
  * \return the id of vertex between two corners.
  *
- * If it wasn't previously computed, does #converge() and adds vertex to process.
+ * If it wasn't previously added, adds vertex to process.
  */
 static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2)
 {
-  float v[3], no[3];
   int vid = getedge(process->edges, c1->i, c1->j, c1->k, c2->i, c2->j, c2->k);
 
   if (vid != -1) {
     return vid; /* previously computed */
   }
 
-  converge(process, c1, c2, v); /* position */
-
-#ifdef USE_ACCUM_NORMAL
-  zero_v3(no);
-#else
-  vnormal(process, v, no);
-#endif
-
-  addtovertices(process, v, no); /* save vertex */
+  addtovertices(process, c1, c2); /* save vertex */
   vid = (int)process->curvertex - 1;
   setedge(process, c1->i, c1->j, c1->k, c2->i, c2->j, c2->k, vid);
 
@@ -1011,7 +991,11 @@ static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2)
  * Given two corners, computes approximation of surface intersection point between them.
  * In case of small threshold, do bisection.
  */
-static void converge(PROCESS *process, const CORNER *c1, const CORNER *c2, float r_p[3])
+static void converge(PROCESS *process,
+                     MetaballBVHNode **bvh_queue,
+                     const CORNER *c1,
+                     const CORNER *c2,
+                     float r_p[3])
 {
   float tmp, dens;
   unsigned int i;
@@ -1033,7 +1017,7 @@ static void converge(PROCESS *process, const CORNER *c1, const CORNER *c2, float
 
   for (i = 0; i < process->converge_res; i++) {
     interp_v3_v3v3(r_p, c1_co, c2_co, 0.5f);
-    dens = metaball(process, r_p[0], r_p[1], r_p[2]);
+    dens = metaball(process, bvh_queue, r_p[0], r_p[1], r_p[2]);
 
     if (dens > 0.0f) {
       c1_value = dens;
@@ -1144,6 +1128,103 @@ static void find_first_points(PROCESS *process, const unsigned int em)
   }
 }
 
+typedef struct PolygonizeVerticesTLS {
+  MetaballBVHNode **bvh_queue;
+} PolygonizeVerticesTLS;
+
+static void polygonize_vertices_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict tls)
+{
+  PROCESS *process = userdata;
+  PolygonizeVerticesTLS *tls_data = tls->userdata_chunk;
+  const CORNER *c1 = process->vert_corners[i][0];
+  const CORNER *c2 = process->vert_corners[i][1];
+
+  if (tls_data->bvh_queue == NULL) {
+    tls_data->bvh_queue = MEM_mallocN(sizeof(MetaballBVHNode *) * process->bvh_queue_size,
+                                      __func__);
+  }
+
+  converge(process, tls_data->bvh_queue, c1, c2, process->co[i]); /* position */
+
+#ifdef USE_ACCUM_NORMAL
+  zero_v3(process->no[i]);
+#else
+  vnormal(process, tls_data->bvh_queue, process->co[i], process->no[i]);
+#endif
+}
+
+static void polygonize_vertices_finalize(void *__restrict UNUSED(userdata),
+                                         void *__restrict userdata_chunk)
+{
+  PolygonizeVerticesTLS *tls_data = userdata_chunk;
+  MEM_SAFE_FREE(tls_data->bvh_queue);
+}
+
+#ifdef USE_ACCUM_NORMAL
+/**
+ * Accumulates face normals into the vertex normals, once all vertex positions are known.
+ */
+static void accumulate_face_normals(PROCESS *process)
+{
+  float n[3];
+  unsigned int a;
+
+  for (a = 0; a < process->curindex; a++) {
+    const int *cur = process->indices[a];
+    const int i1 = cur[0], i2 = cur[1], i3 = cur[2], i4 = cur[3];
+
+    if (i4 == i3) {
+      normal_tri_v3(n, process->co[i1], process->co[i2], process->co[i3]);
+      accumulate_vertex_normals_v3(process->no[i1],
+                                   process->no[i2],
+                                   process->no[i3],
+                                   NULL,
+                                   n,
+                                   process->co[i1],
+                                   process->co[i2],
+                                   process->co[i3],
+                                   NULL);
+    }
+    else {
+      normal_quad_v3(n, process->co[i1], process->co[i2], process->co[i3], process->co[i4]);
+      accumulate_vertex_normals_v3(process->no[i1],
+                                   process->no[i2],
+                                   process->no[i3],
+                                   process->no[i4],
+                                   n,
+                                   process->co[i1],
+                                   process->co[i2],
+                                   process->co[i3],
+                                   process->co[i4]);
+    }
+  }
+}
+#endif /* USE_ACCUM_NORMAL */
+
+/**
+ * Computes positions and normals of all vertices, this is where most of the field is evaluated.
+ * Unlike the cube continuation, which needs the corner and edge hashes, vertices don't depend
+ * on each other, so they are computed in parallel.
+ */
+static void polygonize_vertices(PROCESS *process)
+{
+  PolygonizeVerticesTLS tls_data = {NULL};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_finalize = polygonize_vertices_finalize;
+  BLI_task_parallel_range(0, (int)process->curvertex, process, polygonize_vertices_cb, &settings);
+
+#ifdef USE_ACCUM_NORMAL
+  accumulate_face_normals(process);
+#endif
+}
+
 /**
  * The main polygonization proc.
  * Allocates memory, makes cubetable,
@@ -1173,6 +1254,8 @@ static void polygonize(PROCESS *process)
 
     docube(process, &c);
   }
+
+  polygonize_vertices(process);
 }
 
 /**
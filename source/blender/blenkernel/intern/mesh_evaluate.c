@@ -1408,6 +1408,116 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
   }
 }
 
+/**
+ * Same as #loop_split_generator_check_cyclic_smooth_fan, but without any shared state,
+ * so that it can be called for all loops in parallel.
+ * The entry point of a cyclic smooth fan is the loop the serial generator would reach first,
+ * i.e. the one of the lowest poly index, then of the lowest loop index.
+ */
+static bool loop_split_generator_is_cyclic_smooth_fan_entry(const MLoop *mloops,
+                                                            const MPoly *mpolys,
+                                                            const int (*edge_to_loops)[2],
+                                                            const int *loop_to_poly,
+                                                            const int *e2l_prev,
+                                                            const MLoop *ml_curr,
+                                                            const MLoop *ml_prev,
+                                                            const int ml_curr_index,
+                                                            const int ml_prev_index,
+                                                            const int mp_curr_index,
+                                                            const int max_steps)
+{
+  const unsigned int mv_pivot_index = ml_curr->v; /* The vertex we are "fanning" around! */
+  const int *e2lfan_curr;
+  const MLoop *mlfan_curr;
+  int mlfan_curr_index, mlfan_vert_index, mpfan_curr_index;
+
+  e2lfan_curr = e2l_prev;
+  if (IS_EDGE_SHARP(e2lfan_curr)) {
+    /* Sharp loop, so not a cyclic smooth fan... */
+    return false;
+  }
+
+  mlfan_curr = ml_prev;
+  mlfan_curr_index = ml_prev_index;
+  mlfan_vert_index = ml_curr_index;
+  mpfan_curr_index = mp_curr_index;
+
+  /* Steps are limited to stay safe on degenerated topology, where the fan could never
+   * get back to its initial loop. */
+  for (int step = 0; step < max_steps; step++) {
+    BKE_mesh_loop_manifold_fan_around_vert_next(mloops,
+                                                mpolys,
+                                                loop_to_poly,
+                                                e2lfan_curr,
+                                                mv_pivot_index,
+                                                &mlfan_curr,
+                                                &mlfan_curr_index,
+                                                &mlfan_vert_index,
+                                                &mpfan_curr_index);
+
+    e2lfan_curr = edge_to_loops[mlfan_curr->e];
+
+    if (IS_EDGE_SHARP(e2lfan_curr)) {
+      /* Sharp loop/edge, so not a cyclic smooth fan... */
+      return false;
+    }
+    if (mlfan_vert_index == ml_curr_index) {
+      /* We walked around the whole cyclic smooth fan without finding a better entry point. */
+      return true;
+    }
+    if ((mpfan_curr_index < mp_curr_index) ||
+        (mpfan_curr_index == mp_curr_index && mlfan_vert_index < ml_curr_index)) {
+      /* The fan will be processed from another loop. */
+      return false;
+    }
+  }
+  return false;
+}
+
+typedef struct LoopSplitGeneratorTaskData {
+  const LoopSplitTaskDataCommon *common_data;
+  /** Whether a loop is the start of a 'single' or a 'fan' task. */
+  bool *task_loops;
+} LoopSplitGeneratorTaskData;
+
+static void loop_split_generator_tag_task_cb(void *__restrict userdata,
+                                             const int mp_index,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopSplitGeneratorTaskData *data = userdata;
+  const LoopSplitTaskDataCommon *common_data = data->common_data;
+  const MLoop *mloops = common_data->mloops;
+  const MPoly *mp = &common_data->mpolys[mp_index];
+  const int(*edge_to_loops)[2] = common_data->edge_to_loops;
+
+  const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
+  int ml_curr_index = mp->loopstart;
+  int ml_prev_index = ml_last_index;
+
+  for (; ml_curr_index <= ml_last_index; ml_curr_index++) {
+    const MLoop *ml_curr = &mloops[ml_curr_index];
+    const MLoop *ml_prev = &mloops[ml_prev_index];
+    const int *e2l_curr = edge_to_loops[ml_curr->e];
+    const int *e2l_prev = edge_to_loops[ml_prev->e];
+
+    data->task_loops[ml_curr_index] = IS_EDGE_SHARP(e2l_curr) ||
+                                      loop_split_generator_is_cyclic_smooth_fan_entry(
+                                          mloops,
+                                          common_data->mpolys,
+                                          edge_to_loops,
+                                          common_data->loop_to_poly,
+                                          e2l_prev,
+                                          ml_curr,
+                                          ml_prev,
+                                          ml_curr_index,
+                                          ml_prev_index,
+                                          mp_index,
+                                          common_data->numLoops);
+
+    ml_prev_index = ml_curr_index;
+  }
+}
+
 static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common_data)
 {
   MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
@@ -1428,7 +1538,9 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
   int ml_curr_index;
   int ml_prev_index;
 
-  BLI_bitmap *skip_loops = BLI_BITMAP_NEW(numLoops, __func__);
+  BLI_bitmap *skip_loops = NULL;
+  /* Only used when multi-threading, tasks are then detected in parallel. */
+  bool *task_loops = NULL;
 
   LoopSplitTaskData *data_buff = NULL;
   int data_idx = 0;
@@ -1445,6 +1557,20 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
     if (lnors_spacearr) {
       edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
     }
+    skip_loops = BLI_BITMAP_NEW(numLoops, __func__);
+  }
+  else {
+    task_loops = MEM_malloc_arrayN((size_t)numLoops, sizeof(*task_loops), __func__);
+
+    LoopSplitGeneratorTaskData data = {
+        .common_data = common_data,
+        .task_loops = task_loops,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, numPolys, &data, loop_split_generator_tag_task_cb, &settings);
   }
 
   /* We now know edges that can be smoothed (with their vector, and their two loops),
@@ -1483,18 +1609,26 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
        * the code, add more memory usage, and despite its logical complexity,
        * loop_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
        * so really think it's not worth it. */
-      if (!IS_EDGE_SHARP(e2l_curr) && (BLI_BITMAP_TEST(skip_loops, ml_curr_index) ||
-                                       !loop_split_generator_check_cyclic_smooth_fan(mloops,
-                                                                                     mpolys,
-                                                                                     edge_to_loops,
-                                                                                     loop_to_poly,
-                                                                                     e2l_prev,
-                                                                                     skip_loops,
-                                                                                     ml_curr,
-                                                                                     ml_prev,
-                                                                                     ml_curr_index,
-                                                                                     ml_prev_index,
-                                                                                     mp_index))) {
+      bool is_skipped;
+      if (task_loops) {
+        is_skipped = !task_loops[ml_curr_index];
+      }
+      else {
+        is_skipped = !IS_EDGE_SHARP(e2l_curr) &&
+                     (BLI_BITMAP_TEST(skip_loops, ml_curr_index) ||
+                      !loop_split_generator_check_cyclic_smooth_fan(mloops,
+                                                                    mpolys,
+                                                                    edge_to_loops,
+                                                                    loop_to_poly,
+                                                                    e2l_prev,
+                                                                    skip_loops,
+                                                                    ml_curr,
+                                                                    ml_prev,
+                                                                    ml_curr_index,
+                                                                    ml_prev_index,
+                                                                    mp_index));
+      }
+      if (is_skipped) {
         //              printf("SKIPPING!\n");
       }
       else {
@@ -1578,7 +1712,8 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
   if (edge_vectors) {
     BLI_stack_free(edge_vectors);
   }
-  MEM_freeN(skip_loops);
+  MEM_SAFE_FREE(skip_loops);
+  MEM_SAFE_FREE(task_loops);
 
 #ifdef DEBUG_TIME
   TIMEIT_END_AVERAGED(loop_split_generator);
@@ -3222,37 +3357,30 @@ int BKE_mesh_tessface_calc_ex(CustomData *fdata,
 #undef ML_TO_MF_QUAD
 }
 
-/**
- * Calculate tessellation into #MLoopTri which exist only for this purpose.
- */
-void BKE_mesh_recalc_looptri(const MLoop *mloop,
-                             const MPoly *mpoly,
-                             const MVert *mvert,
-                             int totloop,
-                             int totpoly,
-                             MLoopTri *mlooptri)
-{
-  /* use this to avoid locking pthread for _every_ polygon
-   * and calling the fill function */
-
+/* use this to avoid locking pthread for _every_ polygon
+ * and calling the fill function */
 #define USE_TESSFACE_SPEEDUP
 
-  const MPoly *mp;
+/* Tessellate a single polygon into the triangles starting at mlooptri_index. */
+static void mesh_recalc_looptri_poly(const MLoop *mloop,
+                                     const MPoly *mpoly,
+                                     const MVert *mvert,
+                                     const int poly_index,
+                                     int mlooptri_index,
+                                     MLoopTri *mlooptri,
+                                     MemArena **arena_p)
+{
+  const MPoly *mp = &mpoly[poly_index];
   const MLoop *ml;
   MLoopTri *mlt;
-  MemArena *arena = NULL;
-  int poly_index, mlooptri_index;
+  const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
+  const unsigned int mp_totloop = (unsigned int)mp->totloop;
+  unsigned int l1, l2, l3;
   unsigned int j;
 
-  mlooptri_index = 0;
-  mp = mpoly;
-  for (poly_index = 0; poly_index < totpoly; poly_index++, mp++) {
-    const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
-    const unsigned int mp_totloop = (unsigned int)mp->totloop;
-    unsigned int l1, l2, l3;
-    if (mp_totloop < 3) {
-      /* do nothing */
-    }
+  if (mp_totloop < 3) {
+    /* do nothing */
+  }
 
 #ifdef USE_TESSFACE_SPEEDUP
 
@@ -3267,101 +3395,144 @@ void BKE_mesh_recalc_looptri(const MLoop *mloop,
     } \
     ((void)0)
 
-    else if (mp_totloop == 3) {
-      ML_TO_MLT(0, 1, 2);
-      mlooptri_index++;
-    }
-    else if (mp_totloop == 4) {
-      ML_TO_MLT(0, 1, 2);
-      MLoopTri *mlt_a = mlt;
-      mlooptri_index++;
-      ML_TO_MLT(0, 2, 3);
-      MLoopTri *mlt_b = mlt;
-      mlooptri_index++;
-
-      if (UNLIKELY(is_quad_flip_v3_first_third_fast(mvert[mloop[mlt_a->tri[0]].v].co,
-                                                    mvert[mloop[mlt_a->tri[1]].v].co,
-                                                    mvert[mloop[mlt_a->tri[2]].v].co,
-                                                    mvert[mloop[mlt_b->tri[2]].v].co))) {
-        /* flip out of degenerate 0-2 state. */
-        mlt_a->tri[2] = mlt_b->tri[2];
-        mlt_b->tri[0] = mlt_a->tri[1];
-      }
+  else if (mp_totloop == 3) {
+    ML_TO_MLT(0, 1, 2);
+  }
+  else if (mp_totloop == 4) {
+    ML_TO_MLT(0, 1, 2);
+    MLoopTri *mlt_a = mlt;
+    mlooptri_index++;
+    ML_TO_MLT(0, 2, 3);
+    MLoopTri *mlt_b = mlt;
+
+    if (UNLIKELY(is_quad_flip_v3_first_third_fast(mvert[mloop[mlt_a->tri[0]].v].co,
+                                                  mvert[mloop[mlt_a->tri[1]].v].co,
+                                                  mvert[mloop[mlt_a->tri[2]].v].co,
+                                                  mvert[mloop[mlt_b->tri[2]].v].co))) {
+      /* flip out of degenerate 0-2 state. */
+      mlt_a->tri[2] = mlt_b->tri[2];
+      mlt_b->tri[0] = mlt_a->tri[1];
     }
+  }
+#  undef ML_TO_MLT
 #endif /* USE_TESSFACE_SPEEDUP */
-    else {
-      const float *co_curr, *co_prev;
+  else {
+    const float *co_curr, *co_prev;
 
-      float normal[3];
+    float normal[3];
 
-      float axis_mat[3][3];
-      float(*projverts)[2];
-      unsigned int(*tris)[3];
+    float axis_mat[3][3];
+    float(*projverts)[2];
+    unsigned int(*tris)[3];
 
-      const unsigned int totfilltri = mp_totloop - 2;
+    const unsigned int totfilltri = mp_totloop - 2;
 
-      if (UNLIKELY(arena == NULL)) {
-        arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
-      }
+    if (UNLIKELY(*arena_p == NULL)) {
+      *arena_p = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+    }
+    MemArena *arena = *arena_p;
 
-      tris = BLI_memarena_alloc(arena, sizeof(*tris) * (size_t)totfilltri);
-      projverts = BLI_memarena_alloc(arena, sizeof(*projverts) * (size_t)mp_totloop);
+    tris = BLI_memarena_alloc(arena, sizeof(*tris) * (size_t)totfilltri);
+    projverts = BLI_memarena_alloc(arena, sizeof(*projverts) * (size_t)mp_totloop);
 
-      zero_v3(normal);
+    zero_v3(normal);
 
-      /* calc normal, flipped: to get a positive 2d cross product */
-      ml = mloop + mp_loopstart;
-      co_prev = mvert[ml[mp_totloop - 1].v].co;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        co_curr = mvert[ml->v].co;
-        add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
-        co_prev = co_curr;
-      }
-      if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
-        normal[2] = 1.0f;
-      }
+    /* calc normal, flipped: to get a positive 2d cross product */
+    ml = mloop + mp_loopstart;
+    co_prev = mvert[ml[mp_totloop - 1].v].co;
+    for (j = 0; j < mp_totloop; j++, ml++) {
+      co_curr = mvert[ml->v].co;
+      add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
+      co_prev = co_curr;
+    }
+    if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+      normal[2] = 1.0f;
+    }
 
-      /* project verts to 2d */
-      axis_dominant_v3_to_m3_negate(axis_mat, normal);
+    /* project verts to 2d */
+    axis_dominant_v3_to_m3_negate(axis_mat, normal);
 
-      ml = mloop + mp_loopstart;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
-      }
+    ml = mloop + mp_loopstart;
+    for (j = 0; j < mp_totloop; j++, ml++) {
+      mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
+    }
 
-      BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, arena);
+    BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, arena);
 
-      /* apply fill */
-      for (j = 0; j < totfilltri; j++) {
-        unsigned int *tri = tris[j];
+    /* apply fill */
+    for (j = 0; j < totfilltri; j++) {
+      unsigned int *tri = tris[j];
 
-        mlt = &mlooptri[mlooptri_index];
+      mlt = &mlooptri[mlooptri_index];
 
-        /* set loop indices, transformed to vert indices later */
-        l1 = mp_loopstart + tri[0];
-        l2 = mp_loopstart + tri[1];
-        l3 = mp_loopstart + tri[2];
+      /* set loop indices, transformed to vert indices later */
+      l1 = mp_loopstart + tri[0];
+      l2 = mp_loopstart + tri[1];
+      l3 = mp_loopstart + tri[2];
 
-        ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3);
-        mlt->poly = (unsigned int)poly_index;
+      ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3);
+      mlt->poly = (unsigned int)poly_index;
 
-        mlooptri_index++;
-      }
+      mlooptri_index++;
+    }
 
-      BLI_memarena_clear(arena);
+    BLI_memarena_clear(arena);
+  }
+}
+
+#undef USE_TESSFACE_SPEEDUP
+
+/**
+ * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ */
+void BKE_mesh_recalc_looptri(const MLoop *mloop,
+                             const MPoly *mpoly,
+                             const MVert *mvert,
+                             int totloop,
+                             int totpoly,
+                             MLoopTri *mlooptri)
+{
+  MemArena *arena = NULL;
+  int mlooptri_index = 0;
+
+  for (int poly_index = 0; poly_index < totpoly; poly_index++) {
+    mesh_recalc_looptri_poly(mloop, mpoly, mvert, poly_index, mlooptri_index, mlooptri, &arena);
+    if (mpoly[poly_index].totloop >= 3) {
+      mlooptri_index += mpoly[poly_index].totloop - 2;
     }
   }
 
   if (arena) {
     BLI_memarena_free(arena);
-    arena = NULL;
   }
 
   BLI_assert(mlooptri_index == poly_to_tri_count(totpoly, totloop));
   UNUSED_VARS_NDEBUG(totloop);
+}
 
-#undef USE_TESSFACE_SPEEDUP
-#undef ML_TO_MLT
+/**
+ * Recalculate the tessellation of the given polygons only, for example after their vertices
+ * moved. The other triangles of \a mlooptri are left as they are, the polygons are expected
+ * to be stored in loop order like #BKE_mesh_recalc_looptri assumes.
+ */
+void BKE_mesh_recalc_looptri_polys(const MLoop *mloop,
+                                   const MPoly *mpoly,
+                                   const MVert *mvert,
+                                   const int *poly_indices,
+                                   int poly_indices_num,
+                                   MLoopTri *mlooptri)
+{
+  MemArena *arena = NULL;
+
+  for (int i = 0; i < poly_indices_num; i++) {
+    const int poly_index = poly_indices[i];
+    const int mlooptri_index = poly_to_tri_count(poly_index, mpoly[poly_index].loopstart);
+    mesh_recalc_looptri_poly(mloop, mpoly, mvert, poly_index, mlooptri_index, mlooptri, &arena);
+  }
+
+  if (arena) {
+    BLI_memarena_free(arena);
+  }
 }
 
 static void bm_corners_to_loops_ex(ID *id,
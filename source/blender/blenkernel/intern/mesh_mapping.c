@@ -1080,6 +1080,10 @@ static bool mesh_calc_islands_loop_poly_uv(MVert *UNUSED(verts),
   int *loop_indices;
   int num_pidx, num_lidx;
 
+  /* Polys sorted by group, so that each group only has to visit its own polys. */
+  int *group_poly_offsets;
+  int *group_polys;
+
   /* Those are used to detect 'inner cuts', i.e. edges that are borders,
    * and yet have two or more polys of a same group using them
    * (typical case: seam used to unwrap properly a cylinder). */
@@ -1133,7 +1137,7 @@ static bool mesh_calc_islands_loop_poly_uv(MVert *UNUSED(verts),
   }
 
   if (num_edge_borders) {
-    edge_border_count = MEM_mallocN(sizeof(*edge_border_count) * (size_t)totedge, __func__);
+    edge_border_count = MEM_callocN(sizeof(*edge_border_count) * (size_t)totedge, __func__);
     edge_innercut_indices = MEM_mallocN(sizeof(*edge_innercut_indices) * (size_t)num_edge_borders,
                                         __func__);
   }
@@ -1141,21 +1145,35 @@ static bool mesh_calc_islands_loop_poly_uv(MVert *UNUSED(verts),
   poly_indices = MEM_mallocN(sizeof(*poly_indices) * (size_t)totpoly, __func__);
   loop_indices = MEM_mallocN(sizeof(*loop_indices) * (size_t)totloop, __func__);
 
+  /* Counting sort of the polys by group, keeping their order inside of each group. */
+  group_poly_offsets = MEM_callocN(sizeof(*group_poly_offsets) * (size_t)(num_poly_groups + 2),
+                                   __func__);
+  group_polys = MEM_mallocN(sizeof(*group_polys) * (size_t)totpoly, __func__);
+  for (p_idx = 0; p_idx < totpoly; p_idx++) {
+    group_poly_offsets[poly_groups[p_idx] + 1]++;
+  }
+  for (grp_idx = 1; grp_idx <= num_poly_groups + 1; grp_idx++) {
+    group_poly_offsets[grp_idx] += group_poly_offsets[grp_idx - 1];
+  }
+  for (p_idx = 0; p_idx < totpoly; p_idx++) {
+    group_polys[group_poly_offsets[poly_groups[p_idx]]++] = p_idx;
+  }
+  /* Offsets were shifted by one group while filling. */
+  for (grp_idx = num_poly_groups + 1; grp_idx > 0; grp_idx--) {
+    group_poly_offsets[grp_idx] = group_poly_offsets[grp_idx - 1];
+  }
+  group_poly_offsets[0] = 0;
+
   /* Note: here we ignore '0' invalid group - this should *never* happen in this case anyway? */
   for (grp_idx = 1; grp_idx <= num_poly_groups; grp_idx++) {
+    const int grp_poly_end = group_poly_offsets[grp_idx + 1];
     num_pidx = num_lidx = 0;
-    if (num_edge_borders) {
-      num_einnercuts = 0;
-      memset(edge_border_count, 0, sizeof(*edge_border_count) * (size_t)totedge);
-    }
+    num_einnercuts = 0;
 
-    for (p_idx = 0; p_idx < totpoly; p_idx++) {
+    for (int i = group_poly_offsets[grp_idx]; i < grp_poly_end; i++) {
       MPoly *mp;
 
-      if (poly_groups[p_idx] != grp_idx) {
-        continue;
-      }
-
+      p_idx = group_polys[i];
       mp = &polys[p_idx];
       poly_indices[num_pidx++] = p_idx;
       for (l_idx = mp->loopstart, pl_idx = 0; pl_idx < mp->totloop; l_idx++, pl_idx++) {
@@ -1178,8 +1196,18 @@ static bool mesh_calc_islands_loop_poly_uv(MVert *UNUSED(verts),
                               poly_indices,
                               num_einnercuts,
                               edge_innercut_indices);
+
+    if (num_edge_borders) {
+      /* Only reset the counters of the edges used by this group. */
+      for (int i = 0; i < num_lidx; i++) {
+        edge_border_count[loops[loop_indices[i]].e] = 0;
+      }
+    }
   }
 
+  MEM_freeN(group_poly_offsets);
+  MEM_freeN(group_polys);
+
   MEM_freeN(edge_poly_map);
   MEM_freeN(edge_poly_mem);
 
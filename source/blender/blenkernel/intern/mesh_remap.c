@@ -37,6 +37,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 
 #include "BKE_bvhutils.h"
 #include "BKE_customdata.h"
@@ -112,6 +113,118 @@ static bool mesh_remap_bvhtree_query_raycast(BVHTreeFromMesh *treedata,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched queries.
+ *
+ * Query the tree for all destination items at once, from multiple threads.
+ * Every item is queried without the local proximity heuristic of
+ * #mesh_remap_bvhtree_query_nearest, so results don't depend on how items are split over threads.
+ * \{ */
+
+typedef struct MeshRemapQueryNearestData {
+  BVHTreeFromMesh *treedata;
+  const float (*cos)[3];
+  float max_dist_sq;
+  BVHTreeNearest *nearests;
+} MeshRemapQueryNearestData;
+
+static void mesh_remap_bvhtree_query_nearest_cb(void *__restrict userdata,
+                                                const int i,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MeshRemapQueryNearestData *data = userdata;
+  BVHTreeNearest *nearest = &data->nearests[i];
+  float hit_dist;
+
+  nearest->index = -1;
+  if (!mesh_remap_bvhtree_query_nearest(
+          data->treedata, nearest, data->cos[i], data->max_dist_sq, &hit_dist)) {
+    nearest->index = -1;
+  }
+}
+
+/**
+ * \param r_nearests: One per item, the index is -1 when nothing is within \a max_dist_sq.
+ */
+static void mesh_remap_bvhtree_query_nearest_batch(BVHTreeFromMesh *treedata,
+                                                   const float (*cos)[3],
+                                                   const int items_num,
+                                                   const float max_dist_sq,
+                                                   BVHTreeNearest *r_nearests)
+{
+  MeshRemapQueryNearestData data = {
+      .treedata = treedata,
+      .cos = cos,
+      .max_dist_sq = max_dist_sq,
+      .nearests = r_nearests,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, items_num, &data, mesh_remap_bvhtree_query_nearest_cb, &settings);
+}
+
+/**
+ * Batched version of #mesh_remap_bvhtree_query_raycast, casting in both directions.
+ *
+ * \param r_rayhits: One per item, the index is -1 when nothing is hit within \a max_dist.
+ */
+static void mesh_remap_bvhtree_query_raycast_batch(BVHTreeFromMesh *treedata,
+                                                   const float (*cos)[3],
+                                                   const float (*nos)[3],
+                                                   const int items_num,
+                                                   const float radius,
+                                                   const float max_dist,
+                                                   BVHTreeRayHit *r_rayhits)
+{
+  const size_t items_len = (size_t)items_num;
+  BVHTreeRayHit *rayhits_inv = MEM_mallocN(sizeof(*rayhits_inv) * items_len, __func__);
+  float(*inv_nos)[3] = MEM_mallocN(sizeof(*inv_nos) * items_len, __func__);
+  const int flag = BVH_RAYCAST_DEFAULT | BVH_RAYCAST_USE_THREADING;
+  int i;
+
+  for (i = 0; i < items_num; i++) {
+    r_rayhits[i].index = -1;
+    r_rayhits[i].dist = max_dist;
+    rayhits_inv[i] = r_rayhits[i];
+    negate_v3_v3(inv_nos[i], nos[i]);
+  }
+
+  BLI_bvhtree_ray_cast_batch(treedata->tree,
+                             cos,
+                             nos,
+                             items_num,
+                             radius,
+                             r_rayhits,
+                             treedata->raycast_callback,
+                             treedata,
+                             flag);
+  /* Also cast in the other direction! */
+  BLI_bvhtree_ray_cast_batch(treedata->tree,
+                             cos,
+                             (const float(*)[3])inv_nos,
+                             items_num,
+                             radius,
+                             rayhits_inv,
+                             treedata->raycast_callback,
+                             treedata,
+                             flag);
+
+  for (i = 0; i < items_num; i++) {
+    BVHTreeRayHit *rayhit = &r_rayhits[i];
+    if (rayhits_inv[i].dist < rayhit->dist) {
+      *rayhit = rayhits_inv[i];
+    }
+    if (rayhit->dist > max_dist) {
+      rayhit->index = -1;
+    }
+  }
+
+  MEM_freeN(rayhits_inv);
+  MEM_freeN(inv_nos);
+}
+
 /** \} */
 
 /**
@@ -519,54 +632,61 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
     float hit_dist;
-    float tmp_co[3], tmp_no[3];
+
+    /* Destination vertices in tree coordinates. */
+    float(*cos_dst)[3] = MEM_mallocN(sizeof(*cos_dst) * (size_t)numverts_dst, __func__);
+    for (i = 0; i < numverts_dst; i++) {
+      copy_v3_v3(cos_dst[i], verts_dst[i].co);
+
+      /* Convert the vertex to tree coordinates, if needed. */
+      if (space_transform) {
+        BLI_space_transform_apply(space_transform, cos_dst[i]);
+      }
+    }
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
+      BVHTreeNearest *nearests = MEM_mallocN(sizeof(*nearests) * (size_t)numverts_dst, __func__);
+
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
+      mesh_remap_bvhtree_query_nearest_batch(
+          &treedata, (const float(*)[3])cos_dst, numverts_dst, max_dist_sq, nearests);
 
       for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+        const BVHTreeNearest *nearest = &nearests[i];
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
+        if (nearest->index != -1) {
+          hit_dist = sqrtf(nearest->dist_sq);
+          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest->index, &full_weight);
         }
         else {
           /* No source for this dest vertex! */
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(nearests);
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
+      BVHTreeNearest *nearests = MEM_mallocN(sizeof(*nearests) * (size_t)numverts_dst, __func__);
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
+      mesh_remap_bvhtree_query_nearest_batch(
+          &treedata, (const float(*)[3])cos_dst, numverts_dst, max_dist_sq, nearests);
 
       for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+        const float *tmp_co = cos_dst[i];
+        const BVHTreeNearest *nearest = &nearests[i];
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          MEdge *me = &edges_src[nearest.index];
+        if (nearest->index != -1) {
+          MEdge *me = &edges_src[nearest->index];
           const float *v1cos = vcos_src[me->v1];
           const float *v2cos = vcos_src[me->v2];
 
+          hit_dist = sqrtf(nearest->dist_sq);
+
           if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
             const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
             const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
@@ -595,6 +715,7 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       }
 
       MEM_freeN(vcos_src);
+      MEM_freeN(nearests);
     }
     else if (ELEM(mode,
                   MREMAP_MODE_VERT_POLY_NEAREST,
@@ -612,24 +733,36 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
 
       if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
+        float(*nos_dst)[3] = MEM_mallocN(sizeof(*nos_dst) * (size_t)numverts_dst, __func__);
+        BVHTreeRayHit *rayhits = MEM_mallocN(sizeof(*rayhits) * (size_t)numverts_dst, __func__);
+
         for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-          normal_short_to_float_v3(tmp_no, verts_dst[i].no);
+          normal_short_to_float_v3(nos_dst[i], verts_dst[i].no);
 
-          /* Convert the vertex to tree coordinates, if needed. */
+          /* Convert the normal to tree coordinates, if needed. */
           if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-            BLI_space_transform_apply_normal(space_transform, tmp_no);
+            BLI_space_transform_apply_normal(space_transform, nos_dst[i]);
           }
+        }
+
+        mesh_remap_bvhtree_query_raycast_batch(&treedata,
+                                               (const float(*)[3])cos_dst,
+                                               (const float(*)[3])nos_dst,
+                                               numverts_dst,
+                                               ray_radius,
+                                               max_dist,
+                                               rayhits);
+
+        for (i = 0; i < numverts_dst; i++) {
+          const BVHTreeRayHit *rayhit = &rayhits[i];
 
-          if (mesh_remap_bvhtree_query_raycast(
-                  &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[rayhit.index];
+          if (rayhit->index != -1) {
+            const MLoopTri *lt = &treedata.looptri[rayhit->index];
             MPoly *mp_src = &polys_src[lt->poly];
             const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
                                                                     loops_src,
                                                                     (const float(*)[3])vcos_src,
-                                                                    rayhit.co,
+                                                                    rayhit->co,
                                                                     &tmp_buff_size,
                                                                     &vcos,
                                                                     false,
@@ -638,6 +771,7 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                                                     true,
                                                                     NULL);
 
+            hit_dist = rayhit->dist;
             mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
           }
           else {
@@ -645,29 +779,32 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
             BKE_mesh_remap_item_define_invalid(r_map, i);
           }
         }
+
+        MEM_freeN(nos_dst);
+        MEM_freeN(rayhits);
       }
       else {
-        nearest.index = -1;
+        BVHTreeNearest *nearests = MEM_mallocN(sizeof(*nearests) * (size_t)numverts_dst,
+                                               __func__);
 
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
+        mesh_remap_bvhtree_query_nearest_batch(
+            &treedata, (const float(*)[3])cos_dst, numverts_dst, max_dist_sq, nearests);
 
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
+        for (i = 0; i < numverts_dst; i++) {
+          const BVHTreeNearest *nearest = &nearests[i];
 
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[nearest.index];
+          if (nearest->index != -1) {
+            const MLoopTri *lt = &treedata.looptri[nearest->index];
             MPoly *mp = &polys_src[lt->poly];
 
+            hit_dist = sqrtf(nearest->dist_sq);
+
             if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
               int index;
               mesh_remap_interp_poly_data_get(mp,
                                               loops_src,
                                               (const float(*)[3])vcos_src,
-                                              nearest.co,
+                                              nearest->co,
                                               &tmp_buff_size,
                                               &vcos,
                                               false,
@@ -682,7 +819,7 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
               const int sources_num = mesh_remap_interp_poly_data_get(mp,
                                                                       loops_src,
                                                                       (const float(*)[3])vcos_src,
-                                                                      nearest.co,
+                                                                      nearest->co,
                                                                       &tmp_buff_size,
                                                                       &vcos,
                                                                       false,
@@ -699,6 +836,8 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
             BKE_mesh_remap_item_define_invalid(r_map, i);
           }
         }
+
+        MEM_freeN(nearests);
       }
 
       MEM_freeN(vcos_src);
@@ -711,6 +850,7 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numverts_dst);
     }
 
+    MEM_freeN(cos_dst);
     free_bvhtree_from_mesh(&treedata);
   }
 }
@@ -2246,57 +2386,64 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
     BVHTreeRayHit rayhit = {0};
     float hit_dist;
 
     BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
 
-    if (mode == MREMAP_MODE_POLY_NEAREST) {
-      nearest.index = -1;
+    if (ELEM(mode, MREMAP_MODE_POLY_NEAREST, MREMAP_MODE_POLY_NOR)) {
+      /* Destination poly centers (and normals) in tree coordinates. */
+      float(*cos_dst)[3] = MEM_mallocN(sizeof(*cos_dst) * (size_t)numpolys_dst, __func__);
+      float(*nos_dst)[3] = NULL;
+      BVHTreeNearest *nearests = NULL;
+      BVHTreeRayHit *rayhits = NULL;
+
+      if (mode == MREMAP_MODE_POLY_NOR) {
+        BLI_assert(poly_nors_dst);
+        nos_dst = MEM_mallocN(sizeof(*nos_dst) * (size_t)numpolys_dst, __func__);
+      }
 
       for (i = 0; i < numpolys_dst; i++) {
         MPoly *mp = &polys_dst[i];
 
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
+        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, cos_dst[i]);
+        if (nos_dst) {
+          copy_v3_v3(nos_dst[i], poly_nors_dst[i]);
+        }
 
         /* Convert the vertex to tree coordinates, if needed. */
         if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
+          BLI_space_transform_apply(space_transform, cos_dst[i]);
+          if (nos_dst) {
+            BLI_space_transform_apply_normal(space_transform, nos_dst[i]);
+          }
         }
+      }
 
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[nearest.index];
-          const int poly_index = (int)lt->poly;
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
-        }
-        else {
-          /* No source for this dest poly! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
+      if (mode == MREMAP_MODE_POLY_NEAREST) {
+        nearests = MEM_mallocN(sizeof(*nearests) * (size_t)numpolys_dst, __func__);
+        mesh_remap_bvhtree_query_nearest_batch(
+            &treedata, (const float(*)[3])cos_dst, numpolys_dst, max_dist_sq, nearests);
+      }
+      else {
+        rayhits = MEM_mallocN(sizeof(*rayhits) * (size_t)numpolys_dst, __func__);
+        mesh_remap_bvhtree_query_raycast_batch(&treedata,
+                                               (const float(*)[3])cos_dst,
+                                               (const float(*)[3])nos_dst,
+                                               numpolys_dst,
+                                               ray_radius,
+                                               max_dist,
+                                               rayhits);
       }
-    }
-    else if (mode == MREMAP_MODE_POLY_NOR) {
-      BLI_assert(poly_nors_dst);
 
       for (i = 0; i < numpolys_dst; i++) {
-        MPoly *mp = &polys_dst[i];
+        const int index = nearests ? nearests[i].index : rayhits[i].index;
 
-        BKE_mesh_calc_poly_center(mp, &loops_dst[mp->loopstart], verts_dst, tmp_co);
-        copy_v3_v3(tmp_no, poly_nors_dst[i]);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-          BLI_space_transform_apply_normal(space_transform, tmp_no);
-        }
-
-        if (mesh_remap_bvhtree_query_raycast(
-                &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-          const MLoopTri *lt = &treedata.looptri[rayhit.index];
+        if (index != -1) {
+          const MLoopTri *lt = &treedata.looptri[index];
           const int poly_index = (int)lt->poly;
 
+          hit_dist = nearests ? sqrtf(nearests[i].dist_sq) : rayhits[i].dist;
           mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &poly_index, &full_weight);
         }
         else {
@@ -2304,6 +2451,11 @@ void BKE_mesh_remap_calc_polys_from_mesh(const int mode,
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(cos_dst);
+      MEM_SAFE_FREE(nos_dst);
+      MEM_SAFE_FREE(nearests);
+      MEM_SAFE_FREE(rayhits);
     }
     else if (mode == MREMAP_MODE_POLY_POLYINTERP_PNORPROJ) {
       /* We cast our rays randomly, with a pseudo-even distribution
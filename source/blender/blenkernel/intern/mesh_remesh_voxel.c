@@ -32,6 +32,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_object_types.h"
@@ -62,39 +63,71 @@ struct OpenVDBLevelSet *BKE_mesh_remesh_voxel_ovdb_mesh_to_level_set_create(
 {
   BKE_mesh_runtime_looptri_recalc(mesh);
   const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(mesh);
-  MVertTri *verttri = MEM_callocN(sizeof(*verttri) * BKE_mesh_runtime_looptri_len(mesh),
-                                  "remesh_looptri");
-  BKE_mesh_runtime_verttri_from_looptri(
-      verttri, mesh->mloop, looptri, BKE_mesh_runtime_looptri_len(mesh));
-
-  unsigned int totfaces = BKE_mesh_runtime_looptri_len(mesh);
-  unsigned int totverts = mesh->totvert;
-  float *verts = (float *)MEM_malloc_arrayN(totverts * 3, sizeof(float), "remesh_input_verts");
-  unsigned int *faces = (unsigned int *)MEM_malloc_arrayN(
-      totfaces * 3, sizeof(unsigned int), "remesh_intput_faces");
+  const int looptri_len = BKE_mesh_runtime_looptri_len(mesh);
 
-  for (unsigned int i = 0; i < totverts; i++) {
-    MVert *mvert = &mesh->mvert[i];
-    verts[i * 3] = mvert->co[0];
-    verts[i * 3 + 1] = mvert->co[1];
-    verts[i * 3 + 2] = mvert->co[2];
+  /* The vertices, loops and triangles are read in place by the (threaded) conversion, copies of
+   * them would be as large as the mesh itself. */
+  struct OpenVDBLevelSet *level_set = OpenVDBLevelSet_create(false, NULL);
+  if (looptri_len > 0) {
+    OpenVDBLevelSet_mesh_to_level_set_indexed(level_set,
+                                              mesh->mvert[0].co,
+                                              sizeof(*mesh->mvert),
+                                              &mesh->mloop[0].v,
+                                              sizeof(*mesh->mloop),
+                                              looptri[0].tri,
+                                              sizeof(*looptri),
+                                              (unsigned int)mesh->totvert,
+                                              (unsigned int)looptri_len,
+                                              transform);
   }
 
-  for (unsigned int i = 0; i < totfaces; i++) {
-    MVertTri *vt = &verttri[i];
-    faces[i * 3] = vt->tri[0];
-    faces[i * 3 + 1] = vt->tri[1];
-    faces[i * 3 + 2] = vt->tri[2];
-  }
+  return level_set;
+}
 
-  struct OpenVDBLevelSet *level_set = OpenVDBLevelSet_create(false, NULL);
-  OpenVDBLevelSet_mesh_to_level_set(level_set, verts, faces, totverts, totfaces, transform);
+typedef struct VolumeToMeshData {
+  const struct OpenVDBVolumeToMeshData *output_mesh;
+  Mesh *mesh;
+} VolumeToMeshData;
 
-  MEM_freeN(verts);
-  MEM_freeN(faces);
-  MEM_freeN(verttri);
+static void volume_to_mesh_verts_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const VolumeToMeshData *data = userdata;
+  copy_v3_v3(data->mesh->mvert[i].co, &data->output_mesh->vertices[i * 3]);
+}
 
-  return level_set;
+/* Quads come first, followed by the triangles. The winding is reversed. */
+static void volume_to_mesh_polys_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const VolumeToMeshData *data = userdata;
+  const struct OpenVDBVolumeToMeshData *output_mesh = data->output_mesh;
+  MPoly *mp = &data->mesh->mpoly[i];
+
+  if (i < output_mesh->totquads) {
+    const unsigned int *quad = &output_mesh->quads[i * 4];
+    mp->loopstart = i * 4;
+    mp->totloop = 4;
+
+    MLoop *ml = &data->mesh->mloop[mp->loopstart];
+    ml[0].v = quad[3];
+    ml[1].v = quad[2];
+    ml[2].v = quad[1];
+    ml[3].v = quad[0];
+  }
+  else {
+    const int tri_index = i - output_mesh->totquads;
+    const unsigned int *tri = &output_mesh->triangles[tri_index * 3];
+    mp->loopstart = output_mesh->totquads * 4 + tri_index * 3;
+    mp->totloop = 3;
+
+    MLoop *ml = &data->mesh->mloop[mp->loopstart];
+    ml[0].v = tri[2];
+    ml[1].v = tri[1];
+    ml[2].v = tri[0];
+  }
 }
 
 Mesh *BKE_mesh_remesh_voxel_ovdb_volume_to_mesh_nomain(struct OpenVDBLevelSet *level_set,
@@ -108,47 +141,27 @@ Mesh *BKE_mesh_remesh_voxel_ovdb_volume_to_mesh_nomain(struct OpenVDBLevelSet *l
       level_set, &output_mesh, isovalue, adaptivity, relax_disoriented_triangles);
 #  endif
 
+  const int totpoly = output_mesh.totquads + output_mesh.tottriangles;
   Mesh *mesh = BKE_mesh_new_nomain(output_mesh.totvertices,
                                    0,
                                    0,
                                    (output_mesh.totquads * 4) + (output_mesh.tottriangles * 3),
-                                   output_mesh.totquads + output_mesh.tottriangles);
-
-  for (int i = 0; i < output_mesh.totvertices; i++) {
-    copy_v3_v3(mesh->mvert[i].co, &output_mesh.vertices[i * 3]);
-  }
-
-  MPoly *mp = mesh->mpoly;
-  MLoop *ml = mesh->mloop;
-  for (int i = 0; i < output_mesh.totquads; i++, mp++, ml += 4) {
-    mp->loopstart = (int)(ml - mesh->mloop);
-    mp->totloop = 4;
-
-    ml[0].v = output_mesh.quads[i * 4 + 3];
-    ml[1].v = output_mesh.quads[i * 4 + 2];
-    ml[2].v = output_mesh.quads[i * 4 + 1];
-    ml[3].v = output_mesh.quads[i * 4];
-  }
-
-  for (int i = 0; i < output_mesh.tottriangles; i++, mp++, ml += 3) {
-    mp->loopstart = (int)(ml - mesh->mloop);
-    mp->totloop = 3;
+                                   totpoly);
 
-    ml[0].v = output_mesh.triangles[i * 3 + 2];
-    ml[1].v = output_mesh.triangles[i * 3 + 1];
-    ml[2].v = output_mesh.triangles[i * 3];
-  }
+  /* The output arrays are owned by the level set, copy straight into the mesh. */
+  VolumeToMeshData data = {
+      .output_mesh = &output_mesh,
+      .mesh = mesh,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4096;
+  BLI_task_parallel_range(0, output_mesh.totvertices, &data, volume_to_mesh_verts_cb, &settings);
+  BLI_task_parallel_range(0, totpoly, &data, volume_to_mesh_polys_cb, &settings);
 
   BKE_mesh_calc_edges(mesh, false, false);
   BKE_mesh_calc_normals(mesh);
 
-  MEM_freeN(output_mesh.quads);
-  MEM_freeN(output_mesh.vertices);
-
-  if (output_mesh.tottriangles > 0) {
-    MEM_freeN(output_mesh.triangles);
-  }
-
   return mesh;
 }
 #endif
@@ -316,6 +329,29 @@ Mesh *BKE_mesh_remesh_voxel_to_mesh_nomain(Mesh *mesh,
   return new_mesh;
 }
 
+typedef struct ReprojectPaintMaskData {
+  BVHTreeFromMesh *bvhtree;
+  const MVert *target_verts;
+  float *target_mask;
+  const float *source_mask;
+} ReprojectPaintMaskData;
+
+static void reproject_paint_mask_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ReprojectPaintMaskData *data = userdata;
+  BVHTreeFromMesh *bvhtree = data->bvhtree;
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  BLI_bvhtree_find_nearest(
+      bvhtree->tree, data->target_verts[i].co, &nearest, bvhtree->nearest_callback, bvhtree);
+  if (nearest.index != -1) {
+    data->target_mask[i] = data->source_mask[nearest.index];
+  }
+}
+
 void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
 {
   BVHTreeFromMesh bvhtree = {
@@ -342,17 +378,18 @@ void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
         &source->vdata, CD_PAINT_MASK, CD_CALLOC, NULL, source->totvert);
   }
 
-  for (int i = 0; i < target->totvert; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    copy_v3_v3(from_co, target_verts[i].co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_mask[i] = source_mask[nearest.index];
-    }
-  }
+  /* The nearest vertex lookups only read the tree, every target vertex is done in parallel. */
+  ReprojectPaintMaskData data = {
+      .bvhtree = &bvhtree,
+      .target_verts = target_verts,
+      .target_mask = target_mask,
+      .source_mask = source_mask,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, target->totvert, &data, reproject_paint_mask_cb, &settings);
+
   free_bvhtree_from_mesh(&bvhtree);
 }
 
@@ -178,6 +178,29 @@ const MLoopTri *BKE_mesh_runtime_looptri_ensure(Mesh *mesh)
   return looptri;
 }
 
+/**
+ * Use a tessellation which was calculated elsewhere for the same topology and coordinates,
+ * instead of recalculating it on demand. Does nothing when the number of triangles does not
+ * match, or the mesh already has its tessellation.
+ */
+void BKE_mesh_runtime_looptri_copy_from(Mesh *mesh, const MLoopTri *looptri, int looptri_num)
+{
+  if (looptri_num != poly_to_tri_count(mesh->totpoly, mesh->totloop) || looptri_num == 0) {
+    return;
+  }
+
+  BLI_rw_mutex_lock(&loops_cache_lock, THREAD_LOCK_WRITE);
+  if (mesh->runtime.looptris.array == NULL) {
+    mesh_ensure_looptri_data(mesh);
+    memcpy(mesh->runtime.looptris.array_wip, looptri, sizeof(*looptri) * (size_t)looptri_num);
+    atomic_cas_ptr((void **)&mesh->runtime.looptris.array,
+                   mesh->runtime.looptris.array,
+                   mesh->runtime.looptris.array_wip);
+    mesh->runtime.looptris.array_wip = NULL;
+  }
+  BLI_rw_mutex_unlock(&loops_cache_lock);
+}
+
 /* This is a copy of DM_verttri_from_looptri(). */
 void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
                                            const MLoop *mloop,
@@ -0,0 +1,241 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup bke
+ *
+ * Least recently used cache of evaluated modifier stack results. The cache owns
+ * copies of the meshes, all access goes through a single lock since lookups only
+ * happen once per mesh evaluation.
+ */
+
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_customdata_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BLI_utildefines.h"
+
+#include "BLI_ghash.h"
+#include "BLI_listbase.h"
+#include "BLI_math_base.h"
+#include "BLI_threads.h"
+
+#include "BKE_customdata.h"
+#include "BKE_library.h"
+#include "BKE_mesh.h"
+#include "BKE_modifier_cache.h"
+
+typedef struct ModifierCacheEntry {
+  struct ModifierCacheEntry *next, *prev;
+  ModifierCacheKey key;
+  Mesh *mesh;
+  Mesh *mesh_orco;
+  size_t memory_size;
+} ModifierCacheEntry;
+
+typedef struct ModifierCache {
+  /* ModifierCacheKey -> ModifierCacheEntry. */
+  GHash *entries;
+  /* Entries ordered from the most to the least recently used. */
+  ListBase lru;
+  size_t memory_size;
+} ModifierCache;
+
+static ModifierCache modifier_cache = {NULL};
+static ThreadMutex modifier_cache_lock = BLI_MUTEX_INITIALIZER;
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Utilities
+ * \{ */
+
+static uint modifier_cache_key_hash(const void *key)
+{
+  const ModifierCacheKey *cache_key = key;
+  return cache_key->hash[0];
+}
+
+static bool modifier_cache_key_cmp(const void *a, const void *b)
+{
+  return memcmp(a, b, sizeof(ModifierCacheKey)) != 0;
+}
+
+static size_t modifier_cache_limit_get(void)
+{
+  return (size_t)max_ii(U.modifier_cache_limit, 0) * 1024 * 1024;
+}
+
+static size_t customdata_memory_size(const CustomData *data, const int totelem)
+{
+  size_t memory_size = 0;
+  for (int i = 0; i < data->totlayer; i++) {
+    memory_size += (size_t)CustomData_sizeof(data->layers[i].type) * totelem;
+  }
+  return memory_size;
+}
+
+static size_t mesh_memory_size(const Mesh *mesh)
+{
+  if (mesh == NULL) {
+    return 0;
+  }
+  return sizeof(Mesh) + customdata_memory_size(&mesh->vdata, mesh->totvert) +
+         customdata_memory_size(&mesh->edata, mesh->totedge) +
+         customdata_memory_size(&mesh->fdata, mesh->totface) +
+         customdata_memory_size(&mesh->ldata, mesh->totloop) +
+         customdata_memory_size(&mesh->pdata, mesh->totpoly);
+}
+
+/* Copy which does not reference any data of the source, nor any other ID. */
+static Mesh *mesh_copy_for_cache(const Mesh *mesh)
+{
+  if (mesh == NULL) {
+    return NULL;
+  }
+  Mesh *mesh_copy = BKE_mesh_copy_for_eval((Mesh *)mesh, false);
+  /* Materials and other ID pointers are restored from the input mesh on lookup. */
+  MEM_SAFE_FREE(mesh_copy->mat);
+  mesh_copy->key = NULL;
+  mesh_copy->texcomesh = NULL;
+  mesh_copy->edit_mesh = NULL;
+  return mesh_copy;
+}
+
+static void modifier_cache_entry_free(ModifierCacheEntry *entry)
+{
+  BKE_id_free(NULL, entry->mesh);
+  if (entry->mesh_orco != NULL) {
+    BKE_id_free(NULL, entry->mesh_orco);
+  }
+  MEM_freeN(entry);
+}
+
+static void modifier_cache_entry_remove(ModifierCacheEntry *entry)
+{
+  BLI_ghash_remove(modifier_cache.entries, &entry->key, NULL, NULL);
+  BLI_remlink(&modifier_cache.lru, entry);
+  modifier_cache.memory_size -= entry->memory_size;
+  modifier_cache_entry_free(entry);
+}
+
+/* Evict least recently used entries until the cache fits into the given size. */
+static void modifier_cache_trim(const size_t memory_limit)
+{
+  while (modifier_cache.memory_size > memory_limit && modifier_cache.lru.last != NULL) {
+    modifier_cache_entry_remove(modifier_cache.lru.last);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Public API
+ * \{ */
+
+bool BKE_modifier_cache_is_enabled(void)
+{
+  return U.modifier_cache_limit > 0;
+}
+
+bool BKE_modifier_cache_lookup(const ModifierCacheKey *key, Mesh **r_mesh, Mesh **r_mesh_orco)
+{
+  bool found = false;
+
+  BLI_mutex_lock(&modifier_cache_lock);
+  ModifierCacheEntry *entry = (modifier_cache.entries != NULL) ?
+                                  BLI_ghash_lookup(modifier_cache.entries, key) :
+                                  NULL;
+  if (entry != NULL) {
+    /* Copy while holding the lock, the entry might be evicted by another thread otherwise. */
+    *r_mesh = BKE_mesh_copy_for_eval(entry->mesh, false);
+    *r_mesh_orco = (entry->mesh_orco != NULL) ? BKE_mesh_copy_for_eval(entry->mesh_orco, false) :
+                                                NULL;
+    BLI_remlink(&modifier_cache.lru, entry);
+    BLI_addhead(&modifier_cache.lru, entry);
+    found = true;
+  }
+  BLI_mutex_unlock(&modifier_cache_lock);
+
+  return found;
+}
+
+void BKE_modifier_cache_store(const ModifierCacheKey *key,
+                              const Mesh *mesh,
+                              const Mesh *mesh_orco)
+{
+  const size_t memory_limit = modifier_cache_limit_get();
+  const size_t memory_size = sizeof(ModifierCacheEntry) + mesh_memory_size(mesh) +
+                             mesh_memory_size(mesh_orco);
+  if (memory_size > memory_limit) {
+    return;
+  }
+
+  /* Do the expensive copying outside of the lock. */
+  ModifierCacheEntry *entry = MEM_callocN(sizeof(ModifierCacheEntry), __func__);
+  entry->key = *key;
+  entry->mesh = mesh_copy_for_cache(mesh);
+  entry->mesh_orco = mesh_copy_for_cache(mesh_orco);
+  entry->memory_size = memory_size;
+
+  BLI_mutex_lock(&modifier_cache_lock);
+  if (modifier_cache.entries == NULL) {
+    modifier_cache.entries = BLI_ghash_new(
+        modifier_cache_key_hash, modifier_cache_key_cmp, "modifier cache entries");
+  }
+  void **entry_p;
+  if (BLI_ghash_ensure_p(modifier_cache.entries, &entry->key, &entry_p)) {
+    /* Stored by another thread evaluating the same stack. */
+    BLI_mutex_unlock(&modifier_cache_lock);
+    modifier_cache_entry_free(entry);
+    return;
+  }
+  *entry_p = entry;
+  BLI_addhead(&modifier_cache.lru, entry);
+  modifier_cache.memory_size += memory_size;
+  modifier_cache_trim(memory_limit);
+  BLI_mutex_unlock(&modifier_cache_lock);
+}
+
+void BKE_modifier_cache_limit_update(void)
+{
+  BLI_mutex_lock(&modifier_cache_lock);
+  modifier_cache_trim(modifier_cache_limit_get());
+  BLI_mutex_unlock(&modifier_cache_lock);
+}
+
+void BKE_modifier_cache_clear(void)
+{
+  BLI_mutex_lock(&modifier_cache_lock);
+  modifier_cache_trim(0);
+  BLI_mutex_unlock(&modifier_cache_lock);
+}
+
+void BKE_modifier_cache_exit(void)
+{
+  BKE_modifier_cache_clear();
+  if (modifier_cache.entries != NULL) {
+    BLI_ghash_free(modifier_cache.entries, NULL, NULL);
+    modifier_cache.entries = NULL;
+  }
+}
+
+/** \} */
@@ -52,6 +52,7 @@
 #include "BKE_material.h"
 #include "BKE_mball.h"
 #include "BKE_mesh.h"
+#include "BKE_modifier.h"
 #include "BKE_object.h"
 #include "BKE_particle.h"
 #include "BKE_pointcache.h"
@@ -351,11 +352,45 @@ void BKE_object_batch_cache_dirty_tag(Object *ob)
   }
 }
 
+/* Vertices of the edit mesh were moved without any other change, see ID_RECALC_GEOMETRY_DEFORM.
+ * With a modifier stack which keeps the topology the draw cache only needs to update the
+ * buffers which depend on vertex positions. */
+static bool object_editmesh_is_deform_update(Scene *scene, Object *ob)
+{
+  const Mesh *mesh = ob->data;
+  if (mesh->edit_mesh == NULL || mesh->edit_mesh->ob != ob) {
+    return false;
+  }
+  /* Any other edit of the object or of its mesh comes with a copy-on-write update. */
+  if (!(mesh->id.recalc & ID_RECALC_GEOMETRY_DEFORM) ||
+      (mesh->id.recalc & ID_RECALC_COPY_ON_WRITE) || (ob->id.recalc & ID_RECALC_COPY_ON_WRITE)) {
+    return false;
+  }
+  VirtualModifierData virtualModifierData;
+  ModifierData *md = modifiers_getVirtualModifierList(ob, &virtualModifierData);
+  for (; md; md = md->next) {
+    if (modifier_isEnabled(scene, md, eModifierMode_Realtime | eModifierMode_Editmode) &&
+        modifierType_getInfo(md->type)->type != eModifierTypeType_OnlyDeform) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void BKE_object_eval_uber_data(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
   DEG_debug_print_eval(depsgraph, __func__, ob->id.name, ob);
   BLI_assert(ob->type != OB_ARMATURE);
   BKE_object_handle_data_update(depsgraph, scene, ob);
+  /* A mesh owned by the object is created by the evaluation above. Its batch cache is either
+   * empty or was kept from the previous result and tagged already, see mesh_build_data(). */
+  if (ob->type == OB_MESH && ob->runtime.mesh_eval != NULL && ob->runtime.is_mesh_eval_owned) {
+    return;
+  }
+  if (ob->type == OB_MESH && object_editmesh_is_deform_update(scene, ob)) {
+    BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_DEFORM);
+    return;
+  }
   BKE_object_batch_cache_dirty_tag(ob);
 }
 
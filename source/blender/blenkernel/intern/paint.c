@@ -1030,6 +1030,21 @@ static void sculptsession_free_pbvh(Object *object)
   }
 }
 
+/* Keep the tessellation of the PBVH for the next evaluation when only the coordinates changed,
+ * otherwise discard any tessellation kept before. */
+static void sculptsession_looptri_keep(Object *object)
+{
+  SculptSession *ss = object->sculpt;
+
+  MEM_SAFE_FREE(ss->looptri);
+  ss->looptri_num = 0;
+
+  if (ss->keep_looptri && ss->pbvh) {
+    ss->looptri = BKE_pbvh_looptri_take(ss->pbvh, &ss->looptri_num);
+  }
+  ss->keep_looptri = false;
+}
+
 void BKE_sculptsession_bm_to_me_for_render(Object *object)
 {
   if (object && object->sculpt) {
@@ -1063,6 +1078,7 @@ void BKE_sculptsession_free(Object *ob)
     }
 
     sculptsession_free_pbvh(ob);
+    MEM_SAFE_FREE(ss->looptri);
 
     MEM_SAFE_FREE(ss->pmap);
     MEM_SAFE_FREE(ss->pmap_mem);
@@ -1317,6 +1333,7 @@ void BKE_sculpt_update_object_before_eval(Object *ob)
       /* We free pbvh on changes, except in the middle of drawing a stroke
        * since it can't deal with changing PVBH node organization, we hope
        * topology does not change in the meantime .. weak. */
+      sculptsession_looptri_keep(ob);
       sculptsession_free_pbvh(ob);
 
       BKE_sculptsession_free_deformMats(ob->sculpt);
@@ -1349,6 +1366,11 @@ void BKE_sculpt_update_object_after_eval(Depsgraph *depsgraph, Object *ob_eval)
   BLI_assert(me_eval != NULL);
 
   sculpt_update_object(depsgraph, ob_orig, me_eval, false, false);
+
+  /* Only valid for this evaluation, in case no new PBVH took the tessellation over. */
+  SculptSession *ss = ob_orig->sculpt;
+  MEM_SAFE_FREE(ss->looptri);
+  ss->looptri_num = 0;
 }
 
 void BKE_sculpt_update_object_for_edit(Depsgraph *depsgraph,
@@ -1502,10 +1524,21 @@ static PBVH *build_pbvh_from_regular_mesh(Object *ob, Mesh *me_eval_deform)
   Mesh *me = BKE_object_get_original_mesh(ob);
   const int looptris_num = poly_to_tri_count(me->totpoly, me->totloop);
   PBVH *pbvh = BKE_pbvh_new();
+  SculptSession *ss = ob->sculpt;
 
-  MLoopTri *looptri = MEM_malloc_arrayN(looptris_num, sizeof(*looptri), __func__);
-
-  BKE_mesh_recalc_looptri(me->mloop, me->mpoly, me->mvert, me->totloop, me->totpoly, looptri);
+  MLoopTri *looptri;
+  if (ss->looptri != NULL && ss->looptri_num == looptris_num) {
+    /* Tessellation of the previous PBVH, still valid. */
+    looptri = ss->looptri;
+    ss->looptri = NULL;
+    ss->looptri_num = 0;
+  }
+  else {
+    MEM_SAFE_FREE(ss->looptri);
+    ss->looptri_num = 0;
+    looptri = MEM_malloc_arrayN(looptris_num, sizeof(*looptri), __func__);
+    BKE_mesh_recalc_looptri(me->mloop, me->mpoly, me->mvert, me->totloop, me->totpoly, looptri);
+  }
 
   BKE_pbvh_build_mesh(pbvh,
                       me,
@@ -2398,21 +2398,12 @@ static bool psys_thread_context_init_path(ParticleThreadContext *ctx,
   return true;
 }
 
-static void psys_task_init_path(ParticleTask *task, ParticleSimulationData *sim)
-{
-  /* init random number generator */
-  int seed = 31415926 + sim->psys->seed;
-
-  task->rng_path = BLI_rng_new(seed);
-}
-
 /* note: this function must be thread safe, except for branching! */
-static void psys_thread_create_path(ParticleTask *task,
+static void psys_thread_create_path(ParticleThreadContext *ctx,
                                     struct ChildParticle *cpa,
                                     ParticleCacheKey *child_keys,
                                     int i)
 {
-  ParticleThreadContext *ctx = task->ctx;
   Object *ob = ctx->sim.ob;
   ParticleSystem *psys = ctx->sim.psys;
   ParticleSettings *part = psys->part;
@@ -2740,22 +2731,15 @@ static void psys_thread_create_path(ParticleTask *task,
   }
 }
 
-static void exec_child_path_cache(TaskPool *__restrict UNUSED(pool),
-                                  void *taskdata,
-                                  int UNUSED(threadid))
+static void psys_cache_child_path_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  ParticleTask *task = taskdata;
-  ParticleThreadContext *ctx = task->ctx;
+  ParticleThreadContext *ctx = userdata;
   ParticleSystem *psys = ctx->sim.psys;
-  ParticleCacheKey **cache = psys->childcache;
-  ChildParticle *cpa;
-  int i;
 
-  cpa = psys->child + task->begin;
-  for (i = task->begin; i < task->end; i++, cpa++) {
-    BLI_assert(i < psys->totchildcache);
-    psys_thread_create_path(task, cpa, cache[i], i);
-  }
+  BLI_assert(i < psys->totchildcache);
+  psys_thread_create_path(ctx, &psys->child[i], psys->childcache[i], i);
 }
 
 void psys_cache_child_paths(ParticleSimulationData *sim,
@@ -2763,24 +2747,17 @@ void psys_cache_child_paths(ParticleSimulationData *sim,
                             const bool editupdate,
                             const bool use_render_params)
 {
-  TaskScheduler *task_scheduler;
-  TaskPool *task_pool;
   ParticleThreadContext ctx;
-  ParticleTask *tasks_parent, *tasks_child;
-  int numtasks_parent, numtasks_child;
-  int i, totchild, totparent;
+  int totchild, totparent;
 
   if (sim->psys->flag & PSYS_GLOBAL_HAIR) {
     return;
   }
 
-  /* create a task pool for child path tasks */
   if (!psys_thread_context_init_path(&ctx, sim, sim->scene, cfra, editupdate, use_render_params)) {
     return;
   }
 
-  task_scheduler = BLI_task_scheduler_get();
-  task_pool = BLI_task_pool_create(task_scheduler, &ctx);
   totchild = ctx.totchild;
   totparent = ctx.totparent;
 
@@ -2796,32 +2773,20 @@ void psys_cache_child_paths(ParticleSimulationData *sim,
     sim->psys->totchildcache = totchild;
   }
 
+  /* The cost of a child depends on its kink, clumping and roughness,
+   * dynamic scheduling balances the work between threads. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  settings.min_iter_per_thread = 64;
+
   /* cache parent paths */
   ctx.parent_pass = 1;
-  psys_tasks_create(&ctx, 0, totparent, &tasks_parent, &numtasks_parent);
-  for (i = 0; i < numtasks_parent; i++) {
-    ParticleTask *task = &tasks_parent[i];
-
-    psys_task_init_path(task, sim);
-    BLI_task_pool_push(task_pool, exec_child_path_cache, task, false, TASK_PRIORITY_LOW);
-  }
-  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_parallel_range(0, totparent, &ctx, psys_cache_child_path_cb, &settings);
 
-  /* cache child paths */
+  /* cache child paths, interpolated children read the parent paths cached above */
   ctx.parent_pass = 0;
-  psys_tasks_create(&ctx, totparent, totchild, &tasks_child, &numtasks_child);
-  for (i = 0; i < numtasks_child; i++) {
-    ParticleTask *task = &tasks_child[i];
-
-    psys_task_init_path(task, sim);
-    BLI_task_pool_push(task_pool, exec_child_path_cache, task, false, TASK_PRIORITY_LOW);
-  }
-  BLI_task_pool_work_and_wait(task_pool);
-
-  BLI_task_pool_free(task_pool);
-
-  psys_tasks_free(tasks_parent, numtasks_parent);
-  psys_tasks_free(tasks_child, numtasks_child);
+  BLI_task_parallel_range(totparent, totchild, &ctx, psys_cache_child_path_cb, &settings);
 
   psys_thread_context_free(&ctx);
 }
@@ -882,6 +882,107 @@ static void distribute_invalid(ParticleSimulationData *sim, int from)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Threaded Distribution Setup
+ *
+ * Only the per element work runs in parallel, sums and random number generation stay serial
+ * so distributions don't depend on the number of threads.
+ * \{ */
+
+typedef struct DistributeSetupData {
+  Mesh *mesh;
+  ParticleSystem *psys;
+  const float (*orcodata)[3];
+  /* Texture space of the original mesh, to transform orcos from normalized 0..1 to object space,
+   * read once since #BKE_mesh_texspace_get isn't thread safe. */
+  float orco_loc[3], orco_size[3];
+
+  float *element_weight;
+  float *element_sum;
+  int totmapped;
+  const float *particle_pos;
+  int *particle_element;
+  const int *element_map;
+  float (*parent_co)[3];
+} DistributeSetupData;
+
+static void distribute_setup_orco_transform(const DistributeSetupData *data, float co[3])
+{
+  madd_v3_v3v3v3(co, data->orco_loc, co, data->orco_size);
+}
+
+static void distribute_face_area_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DistributeSetupData *data = userdata;
+  const Mesh *mesh = data->mesh;
+  const MFace *mf = &mesh->mface[i];
+  float co1[3], co2[3], co3[3], co4[3];
+
+  if (data->orcodata) {
+    /* Transform orcos from normalized 0..1 to object space. */
+    copy_v3_v3(co1, data->orcodata[mf->v1]);
+    copy_v3_v3(co2, data->orcodata[mf->v2]);
+    copy_v3_v3(co3, data->orcodata[mf->v3]);
+    distribute_setup_orco_transform(data, co1);
+    distribute_setup_orco_transform(data, co2);
+    distribute_setup_orco_transform(data, co3);
+    if (mf->v4) {
+      copy_v3_v3(co4, data->orcodata[mf->v4]);
+      distribute_setup_orco_transform(data, co4);
+    }
+  }
+  else {
+    copy_v3_v3(co1, mesh->mvert[mf->v1].co);
+    copy_v3_v3(co2, mesh->mvert[mf->v2].co);
+    copy_v3_v3(co3, mesh->mvert[mf->v3].co);
+    if (mf->v4) {
+      copy_v3_v3(co4, mesh->mvert[mf->v4].co);
+    }
+  }
+
+  data->element_weight[i] = mf->v4 ? area_quad_v3(co1, co2, co3, co4) :
+                                     area_tri_v3(co1, co2, co3);
+}
+
+static void distribute_random_element_cb(void *__restrict userdata,
+                                         const int p,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DistributeSetupData *data = userdata;
+  const float pos = data->particle_pos[p];
+  const int eidx = distribute_binary_search(data->element_sum, data->totmapped, pos);
+
+  data->particle_element[p] = data->element_map[eidx];
+  BLI_assert(pos <= data->element_sum[eidx]);
+  BLI_assert(eidx ? (pos > data->element_sum[eidx - 1]) : (pos >= 0.0f));
+}
+
+static void distribute_parent_co_cb(void *__restrict userdata,
+                                    const int p,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DistributeSetupData *data = userdata;
+  ParticleData *pa = &data->psys->particles[p];
+  float co[3], nor[3];
+
+  psys_particle_on_dm(data->mesh,
+                      data->psys->part->from,
+                      pa->num,
+                      pa->num_dmcache,
+                      pa->fuv,
+                      pa->foffset,
+                      co,
+                      nor,
+                      0,
+                      0,
+                      data->parent_co[p]);
+  distribute_setup_orco_transform(data, data->parent_co[p]);
+}
+
+/** \} */
+
 /* Creates a distribution of coordinates on a Mesh */
 static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
                                                ParticleSimulationData *sim,
@@ -891,7 +992,7 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
   Mesh *final_mesh = sim->psmd->mesh_final;
   Object *ob = sim->ob;
   ParticleSystem *psys = sim->psys;
-  ParticleData *pa = 0, *tpars = 0;
+  ParticleData *tpars = 0;
   ParticleSettings *part;
   ParticleSeam *seams = 0;
   KDTree_3d *tree = 0;
@@ -902,7 +1003,7 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
   int totelem = 0, totpart, *particle_element = 0, children = 0, totseam = 0;
   int jitlevel = 1, distr;
   float *element_weight = NULL, *jitter_offset = NULL, *vweight = NULL;
-  float cur, maxweight = 0.0, tweight, totweight, inv_totweight, co[3], nor[3], orco[3];
+  float cur, maxweight = 0.0, tweight, totweight, inv_totweight, co[3];
   RNG *rng = NULL;
 
   if (ELEM(NULL, ob, psys, psys->part)) {
@@ -962,6 +1063,19 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
     }
   }
 
+  DistributeSetupData setup_data = {
+      .psys = psys,
+  };
+  {
+    Mesh *me = ob->data;
+    BKE_mesh_texspace_get(
+        me->texcomesh ? me->texcomesh : me, setup_data.orco_loc, setup_data.orco_size);
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+
   /* Create trees and original coordinates if needed */
   if (from == PART_FROM_CHILD) {
     distr = PART_DISTR_RAND;
@@ -975,12 +1089,15 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
 
     tree = BLI_kdtree_3d_new(totpart);
 
-    for (p = 0, pa = psys->particles; p < totpart; p++, pa++) {
-      psys_particle_on_dm(
-          mesh, part->from, pa->num, pa->num_dmcache, pa->fuv, pa->foffset, co, nor, 0, 0, orco);
-      BKE_mesh_orco_verts_transform(ob->data, &orco, 1, 1);
-      BLI_kdtree_3d_insert(tree, p, orco);
+    setup_data.mesh = mesh;
+    setup_data.parent_co = MEM_malloc_arrayN(totpart, sizeof(*setup_data.parent_co), __func__);
+    BLI_task_parallel_range(0, totpart, &setup_data, distribute_parent_co_cb, &settings);
+
+    for (p = 0; p < totpart; p++) {
+      BLI_kdtree_3d_insert(tree, p, setup_data.parent_co[p]);
     }
+    MEM_freeN(setup_data.parent_co);
+    setup_data.parent_co = NULL;
 
     BLI_kdtree_3d_balance(tree);
 
@@ -1057,48 +1174,20 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
 
   /* Calculate weights from face areas */
   if ((part->flag & PART_EDISTR || children) && from != PART_FROM_VERT) {
-    MVert *v1, *v2, *v3, *v4;
-    float totarea = 0.f, co1[3], co2[3], co3[3], co4[3];
-    float(*orcodata)[3];
+    float totarea = 0.f;
 
-    orcodata = CustomData_get_layer(&mesh->vdata, CD_ORCO);
+    setup_data.mesh = mesh;
+    setup_data.orcodata = CustomData_get_layer(&mesh->vdata, CD_ORCO);
+    setup_data.element_weight = element_weight;
+    BLI_task_parallel_range(0, totelem, &setup_data, distribute_face_area_cb, &settings);
 
     for (i = 0; i < totelem; i++) {
-      MFace *mf = &mesh->mface[i];
-
-      if (orcodata) {
-        /* Transform orcos from normalized 0..1 to object space. */
-        copy_v3_v3(co1, orcodata[mf->v1]);
-        copy_v3_v3(co2, orcodata[mf->v2]);
-        copy_v3_v3(co3, orcodata[mf->v3]);
-        BKE_mesh_orco_verts_transform(ob->data, &co1, 1, 1);
-        BKE_mesh_orco_verts_transform(ob->data, &co2, 1, 1);
-        BKE_mesh_orco_verts_transform(ob->data, &co3, 1, 1);
-        if (mf->v4) {
-          copy_v3_v3(co4, orcodata[mf->v4]);
-          BKE_mesh_orco_verts_transform(ob->data, &co4, 1, 1);
-        }
-      }
-      else {
-        v1 = &mesh->mvert[mf->v1];
-        v2 = &mesh->mvert[mf->v2];
-        v3 = &mesh->mvert[mf->v3];
-        copy_v3_v3(co1, v1->co);
-        copy_v3_v3(co2, v2->co);
-        copy_v3_v3(co3, v3->co);
-        if (mf->v4) {
-          v4 = &mesh->mvert[mf->v4];
-          copy_v3_v3(co4, v4->co);
-        }
-      }
-
-      cur = mf->v4 ? area_quad_v3(co1, co2, co3, co4) : area_tri_v3(co1, co2, co3);
+      cur = element_weight[i];
 
       if (cur > maxweight) {
         maxweight = cur;
       }
 
-      element_weight[i] = cur;
       totarea += cur;
     }
 
@@ -1199,16 +1288,27 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
 
   /* Finally assign elements to particles */
   if (part->flag & PART_TRAND) {
+    float *particle_pos = MEM_malloc_arrayN(totpart, sizeof(*particle_pos), __func__);
+
     for (p = 0; p < totpart; p++) {
       /* In theory element_sum[totmapped - 1] should be 1.0,
        * but due to float errors this is not necessarily always true, so scale pos accordingly. */
-      const float pos = BLI_rng_get_float(rng) * element_sum[totmapped - 1];
-      const int eidx = distribute_binary_search(element_sum, totmapped, pos);
-      particle_element[p] = element_map[eidx];
-      BLI_assert(pos <= element_sum[eidx]);
-      BLI_assert(eidx ? (pos > element_sum[eidx - 1]) : (pos >= 0.0f));
-      jitter_offset[particle_element[p]] = pos;
+      particle_pos[p] = BLI_rng_get_float(rng) * element_sum[totmapped - 1];
     }
+
+    setup_data.element_sum = element_sum;
+    setup_data.totmapped = totmapped;
+    setup_data.particle_pos = particle_pos;
+    setup_data.particle_element = particle_element;
+    setup_data.element_map = element_map;
+    BLI_task_parallel_range(0, totpart, &setup_data, distribute_random_element_cb, &settings);
+
+    /* Serial, the last particle of an element sets its offset. */
+    for (p = 0; p < totpart; p++) {
+      jitter_offset[particle_element[p]] = particle_pos[p];
+    }
+
+    MEM_freeN(particle_pos);
   }
   else {
     double step, pos;
@@ -250,53 +250,48 @@ void pbvh_grow_nodes(PBVH *bvh, int totnode)
   bvh->totnode = totnode;
 }
 
-/* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *bvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
-{
-  void *key, **value_p;
-
-  key = POINTER_FROM_INT(vertex);
-  if (!BLI_ghash_ensure_p(map, key, &value_p)) {
-    int value_i;
-    if (BLI_BITMAP_TEST(bvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(bvh->vert_bitmap, vertex);
-      value_i = *uniq_verts;
-      (*uniq_verts)++;
-    }
-    else {
-      value_i = ~(*face_verts);
-      (*face_verts)++;
-    }
-    *value_p = POINTER_FROM_INT(value_i);
-    return value_i;
-  }
-  else {
-    return POINTER_AS_INT(*value_p);
-  }
-}
-
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *bvh, PBVHNode *node)
+typedef struct PBVHLeafBuildData {
+  PBVH *bvh;
+  PBVHNode **leaves;
+  /* Vertices used by each leaf in order of first use, and their index in the vert_indices
+   * array of the leaf once the unique vertices are known. */
+  int **leaf_verts;
+  int **leaf_verts_index;
+  int *leaf_verts_len;
+} PBVHLeafBuildData;
+
+/* Find vertices used by the faces in this node, face_vert_indices first refers to the order
+ * in which the vertices are used by the faces. */
+static void build_mesh_leaf_node_verts_cb(void *__restrict userdata,
+                                          const int n,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
 {
+  PBVHLeafBuildData *data = userdata;
+  PBVH *bvh = data->bvh;
+  PBVHNode *node = data->leaves[n];
   bool has_visible = false;
 
-  node->uniq_verts = node->face_verts = 0;
   const int totface = node->totprim;
 
   /* reserve size is rough guess */
   GHash *map = BLI_ghash_int_new_ex("build_mesh_leaf_node gh", 2 * totface);
 
   int(*face_vert_indices)[3] = MEM_mallocN(sizeof(int[3]) * totface, "bvh node face vert indices");
+  int *verts = MEM_mallocN(sizeof(int) * 3 * totface, __func__);
+  int verts_len = 0;
 
   node->face_vert_indices = (const int(*)[3])face_vert_indices;
 
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &bvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          bvh, map, &node->face_verts, &node->uniq_verts, bvh->mloop[lt->tri[j]].v);
+      const int vertex = bvh->mloop[lt->tri[j]].v;
+      void **value_p;
+      if (!BLI_ghash_ensure_p(map, POINTER_FROM_INT(vertex), &value_p)) {
+        *value_p = POINTER_FROM_INT(verts_len);
+        verts[verts_len++] = vertex;
+      }
+      face_vert_indices[i][j] = POINTER_AS_INT(*value_p);
     }
 
     if (!paint_is_face_hidden(lt, bvh->verts, bvh->mloop)) {
@@ -304,38 +299,97 @@ static void build_mesh_leaf_node(PBVH *bvh, PBVHNode *node)
     }
   }
 
-  int *vert_indices = MEM_callocN(sizeof(int) * (node->uniq_verts + node->face_verts),
-                                  "bvh node vert indices");
-  node->vert_indices = vert_indices;
+  data->leaf_verts[n] = verts;
+  data->leaf_verts_len[n] = verts_len;
 
-  /* Build the vertex list, unique verts first */
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, map) {
-    void *value = BLI_ghashIterator_getValue(&gh_iter);
-    int ndx = POINTER_AS_INT(value);
+  BKE_pbvh_node_mark_rebuild_draw(node);
 
-    if (ndx < 0) {
-      ndx = -ndx + node->uniq_verts - 1;
-    }
+  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
 
-    vert_indices[ndx] = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+  BLI_ghash_free(map, NULL, NULL);
+}
+
+/* A vertex is unique to the first leaf using it, done in leaf order so the result does not
+ * depend on threading. */
+static void build_mesh_leaf_node_unique_verts(PBVHLeafBuildData *data, const int n)
+{
+  PBVH *bvh = data->bvh;
+  PBVHNode *node = data->leaves[n];
+  const int *verts = data->leaf_verts[n];
+  const int verts_len = data->leaf_verts_len[n];
+  int *verts_index = MEM_mallocN(sizeof(int) * verts_len, __func__);
+
+  node->uniq_verts = node->face_verts = 0;
+
+  /* Positive values for unique vertices and negative values for additional vertices. */
+  for (int i = 0; i < verts_len; i++) {
+    if (BLI_BITMAP_TEST(bvh->vert_bitmap, verts[i]) == 0) {
+      BLI_BITMAP_ENABLE(bvh->vert_bitmap, verts[i]);
+      verts_index[i] = node->uniq_verts++;
+    }
+    else {
+      verts_index[i] = ~(int)(node->face_verts++);
+    }
   }
 
-  for (int i = 0; i < totface; i++) {
-    const int sides = 3;
+  data->leaf_verts_index[n] = verts_index;
+}
 
-    for (int j = 0; j < sides; j++) {
-      if (face_vert_indices[i][j] < 0) {
-        face_vert_indices[i][j] = -face_vert_indices[i][j] + node->uniq_verts - 1;
-      }
+/* Build the vertex list, unique verts first */
+static void build_mesh_leaf_node_vert_indices_cb(void *__restrict userdata,
+                                                 const int n,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHLeafBuildData *data = userdata;
+  PBVHNode *node = data->leaves[n];
+  const int *verts = data->leaf_verts[n];
+  int *verts_index = data->leaf_verts_index[n];
+  const int verts_len = data->leaf_verts_len[n];
+
+  int *vert_indices = MEM_mallocN(sizeof(int) * verts_len, "bvh node vert indices");
+  node->vert_indices = vert_indices;
+
+  for (int i = 0; i < verts_len; i++) {
+    if (verts_index[i] < 0) {
+      verts_index[i] = ~verts_index[i] + (int)node->uniq_verts;
     }
+    vert_indices[verts_index[i]] = verts[i];
   }
 
-  BKE_pbvh_node_mark_rebuild_draw(node);
+  int(*face_vert_indices)[3] = (int(*)[3])node->face_vert_indices;
+  for (int i = 0; i < node->totprim; i++) {
+    for (int j = 0; j < 3; j++) {
+      face_vert_indices[i][j] = verts_index[face_vert_indices[i][j]];
+    }
+  }
 
-  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
+  MEM_freeN(data->leaf_verts[n]);
+  MEM_freeN(data->leaf_verts_index[n]);
+}
 
-  BLI_ghash_free(map, NULL, NULL);
+static void build_mesh_leaf_nodes(PBVH *bvh, PBVHNode **leaves, int totleaf)
+{
+  PBVHLeafBuildData data = {
+      .bvh = bvh,
+      .leaves = leaves,
+      .leaf_verts = MEM_mallocN(sizeof(*data.leaf_verts) * totleaf, __func__),
+      .leaf_verts_index = MEM_mallocN(sizeof(*data.leaf_verts_index) * totleaf, __func__),
+      .leaf_verts_len = MEM_mallocN(sizeof(*data.leaf_verts_len) * totleaf, __func__),
+  };
+
+  PBVHParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totleaf);
+  BKE_pbvh_parallel_range(0, totleaf, &data, build_mesh_leaf_node_verts_cb, &settings);
+
+  for (int n = 0; n < totleaf; n++) {
+    build_mesh_leaf_node_unique_verts(&data, n);
+  }
+
+  BKE_pbvh_parallel_range(0, totleaf, &data, build_mesh_leaf_node_vert_indices_cb, &settings);
+
+  MEM_freeN(data.leaf_verts);
+  MEM_freeN(data.leaf_verts_index);
+  MEM_freeN(data.leaf_verts_len);
 }
 
 static void update_vb(PBVH *bvh, PBVHNode *node, BBC *prim_bbc, int offset, int count)
@@ -380,14 +434,33 @@ int BKE_pbvh_count_grid_quads(BLI_bitmap **grid_hidden,
   return totquad;
 }
 
-static void build_grid_leaf_node(PBVH *bvh, PBVHNode *node)
+static void build_grid_leaf_node_cb(void *__restrict userdata,
+                                    const int n,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
 {
+  PBVHLeafBuildData *data = userdata;
+  PBVH *bvh = data->bvh;
+  PBVHNode *node = data->leaves[n];
+
   int totquads = BKE_pbvh_count_grid_quads(
       bvh->grid_hidden, node->prim_indices, node->totprim, bvh->gridkey.grid_size);
   BKE_pbvh_node_fully_hidden_set(node, (totquads == 0));
   BKE_pbvh_node_mark_rebuild_draw(node);
 }
 
+static void build_grid_leaf_nodes(PBVH *bvh, PBVHNode **leaves, int totleaf)
+{
+  PBVHLeafBuildData data = {
+      .bvh = bvh,
+      .leaves = leaves,
+  };
+
+  PBVHParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totleaf);
+  BKE_pbvh_parallel_range(0, totleaf, &data, build_grid_leaf_node_cb, &settings);
+}
+
+/* The leaf data is built for all leaves at once by #pbvh_build, once the tree is complete. */
 static void build_leaf(PBVH *bvh, int node_index, BBC *prim_bbc, int offset, int count)
 {
   bvh->nodes[node_index].flag |= PBVH_Leaf;
@@ -397,13 +470,6 @@ static void build_leaf(PBVH *bvh, int node_index, BBC *prim_bbc, int offset, int
 
   /* Still need vb for searches */
   update_vb(bvh, &bvh->nodes[node_index], prim_bbc, offset, count);
-
-  if (bvh->looptri) {
-    build_mesh_leaf_node(bvh, bvh->nodes + node_index);
-  }
-  else {
-    build_grid_leaf_node(bvh, bvh->nodes + node_index);
-  }
 }
 
 /* Return zero if all primitives in the node can be drawn with the
@@ -525,6 +591,24 @@ static void pbvh_build(PBVH *bvh, BB *cb, BBC *prim_bbc, int totprim)
 
   bvh->totnode = 1;
   build_sub(bvh, 0, cb, prim_bbc, 0, totprim);
+
+  /* Build the leaf data in parallel, the nodes array does not change size anymore. */
+  PBVHNode **leaves = MEM_mallocN(sizeof(*leaves) * bvh->totnode, __func__);
+  int totleaf = 0;
+  for (int n = 0; n < bvh->totnode; n++) {
+    if (bvh->nodes[n].flag & PBVH_Leaf) {
+      leaves[totleaf++] = &bvh->nodes[n];
+    }
+  }
+
+  if (bvh->looptri) {
+    build_mesh_leaf_nodes(bvh, leaves, totleaf);
+  }
+  else {
+    build_grid_leaf_nodes(bvh, leaves, totleaf);
+  }
+
+  MEM_freeN(leaves);
 }
 
 /**
@@ -684,6 +768,8 @@ void BKE_pbvh_free(PBVH *bvh)
     MEM_freeN((void *)bvh->looptri);
   }
 
+  MEM_SAFE_FREE(bvh->looptri_dirty_polys);
+
   if (bvh->nodes) {
     MEM_freeN(bvh->nodes);
   }
@@ -1120,7 +1206,9 @@ static void pbvh_update_mask_redraw_task_cb(void *__restrict userdata,
     if (node->flag & PBVH_Leaf) {
       PBVHVertexIter vd;
 
-      BKE_pbvh_vertex_iter_begin(bvh, node, vd, PBVH_ITER_UNIQUE)
+      /* Include the vertices shared with other nodes, so every vertex of a fully (un)masked
+       * node also only has such neighbors within the node's own faces. */
+      BKE_pbvh_vertex_iter_begin(bvh, node, vd, PBVH_ITER_ALL)
       {
         if (vd.mask && *vd.mask < 1.0f) {
           has_unmasked = true;
@@ -1301,6 +1389,10 @@ static void pbvh_update_draw_buffers(
   PBVHParallelSettings settings;
   BKE_pbvh_parallel_range_settings(&settings, true, totnode);
   BKE_pbvh_parallel_range(0, totnode, &data, pbvh_update_draw_buffer_cb, &settings);
+
+  for (int n = 0; n < totnode; n++) {
+    nodes[n]->draw_update_id = bvh->draw_id;
+  }
 }
 
 static int pbvh_flush_bb(PBVH *bvh, PBVHNode *node, int flag)
@@ -1336,6 +1428,28 @@ static int pbvh_flush_bb(PBVH *bvh, PBVHNode *node, int flag)
   return update;
 }
 
+/* Remember the polygons of nodes with moved vertices, so their tessellation can be updated
+ * when the looptri array is passed on, see #BKE_pbvh_looptri_take. */
+static void pbvh_looptri_tag_dirty(PBVH *bvh, PBVHNode **nodes, int totnode)
+{
+  if (bvh->type != PBVH_FACES || bvh->looptri == NULL) {
+    return;
+  }
+
+  for (int n = 0; n < totnode; n++) {
+    PBVHNode *node = nodes[n];
+    if (!(node->flag & PBVH_UpdateOriginalBB)) {
+      continue;
+    }
+    if (bvh->looptri_dirty_polys == NULL) {
+      bvh->looptri_dirty_polys = BLI_BITMAP_NEW(bvh->mesh->totpoly, __func__);
+    }
+    for (int i = 0; i < node->totprim; i++) {
+      BLI_BITMAP_ENABLE(bvh->looptri_dirty_polys, bvh->looptri[node->prim_indices[i]].poly);
+    }
+  }
+}
+
 void BKE_pbvh_update_bounds(PBVH *bvh, int flag)
 {
   if (!bvh->nodes) {
@@ -1347,6 +1461,10 @@ void BKE_pbvh_update_bounds(PBVH *bvh, int flag)
 
   BKE_pbvh_search_gather(bvh, update_search_cb, POINTER_FROM_INT(flag), &nodes, &totnode);
 
+  if (flag & PBVH_UpdateOriginalBB) {
+    pbvh_looptri_tag_dirty(bvh, nodes, totnode);
+  }
+
   if (flag & (PBVH_UpdateBB | PBVH_UpdateOriginalBB | PBVH_UpdateRedraw)) {
     pbvh_update_BB_redraw(bvh, nodes, totnode, flag);
   }
@@ -1358,6 +1476,49 @@ void BKE_pbvh_update_bounds(PBVH *bvh, int flag)
   MEM_SAFE_FREE(nodes);
 }
 
+/**
+ * Pass the tessellation of the mesh on to the caller, with the polygons whose vertices moved
+ * since the PBVH was built tessellated again. Afterwards the PBVH can only be freed.
+ * Returns NULL when the PBVH does not tessellate the original mesh coordinates.
+ */
+MLoopTri *BKE_pbvh_looptri_take(PBVH *bvh, int *r_looptri_num)
+{
+  *r_looptri_num = 0;
+
+  if (bvh->type != PBVH_FACES || bvh->deformed || bvh->looptri == NULL || !bvh->nodes) {
+    return NULL;
+  }
+
+  /* Include nodes modified after the last bounds update. */
+  PBVHNode **nodes;
+  int totnode;
+  BKE_pbvh_search_gather(
+      bvh, update_search_cb, POINTER_FROM_INT(PBVH_UpdateOriginalBB), &nodes, &totnode);
+  pbvh_looptri_tag_dirty(bvh, nodes, totnode);
+  MEM_SAFE_FREE(nodes);
+
+  MLoopTri *looptri = (MLoopTri *)bvh->looptri;
+
+  if (bvh->looptri_dirty_polys) {
+    const int totpoly = bvh->mesh->totpoly;
+    int *poly_indices = MEM_malloc_arrayN(totpoly, sizeof(int), __func__);
+    int poly_indices_num = 0;
+    for (int i = 0; i < totpoly; i++) {
+      if (BLI_BITMAP_TEST(bvh->looptri_dirty_polys, i)) {
+        poly_indices[poly_indices_num++] = i;
+      }
+    }
+    BKE_mesh_recalc_looptri_polys(
+        bvh->mloop, bvh->mpoly, bvh->verts, poly_indices, poly_indices_num, looptri);
+    MEM_freeN(poly_indices);
+    MEM_SAFE_FREE(bvh->looptri_dirty_polys);
+  }
+
+  bvh->looptri = NULL;
+  *r_looptri_num = bvh->totprim;
+  return looptri;
+}
+
 void BKE_pbvh_update_vertex_data(PBVH *bvh, int flag)
 {
   if (!bvh->nodes) {
@@ -2431,6 +2592,96 @@ typedef struct PBVHDrawSearchData {
   int accum_update_flag;
 } PBVHDrawSearchData;
 
+/* Draw buffers of nodes that have not been drawn for this many draws are freed. */
+#define PBVH_DRAW_BUFFERS_FREE_DELAY 1000
+/* Maximum number of vertices to update draw buffers for in a single draw while painting. */
+#define PBVH_DRAW_UPDATE_BUDGET (1 << 20)
+
+typedef struct PBVHDrawUpdateNode {
+  PBVHNode *node;
+  /* Number of draws since the buffers of the node were updated. */
+  uint age;
+} PBVHDrawUpdateNode;
+
+static int pbvh_draw_update_node_cmp(const void *a_v, const void *b_v)
+{
+  const PBVHDrawUpdateNode *a = a_v;
+  const PBVHDrawUpdateNode *b = b_v;
+  if (a->age > b->age) {
+    return -1;
+  }
+  else if (a->age < b->age) {
+    return 1;
+  }
+  return 0;
+}
+
+static int pbvh_node_draw_update_cost(const PBVH *bvh, const PBVHNode *node)
+{
+  switch (bvh->type) {
+    case PBVH_GRIDS:
+      return (int)node->totprim * bvh->gridkey.grid_area;
+    case PBVH_FACES:
+      return (int)(node->uniq_verts + node->face_verts);
+    case PBVH_BMESH:
+      return BLI_gset_len(node->bm_faces) * 3;
+  }
+  return 0;
+}
+
+/**
+ * Gather the nodes to update within #PBVH_DRAW_UPDATE_BUDGET, so a large stroke does not update
+ * all of its nodes in a single frame. The most outdated buffers are updated first, the others
+ * keep drawing their current buffers and are updated by the following draws.
+ * Nodes without draw buffers or to rebuild are never deferred.
+ */
+static int pbvh_draw_update_nodes_budget(PBVH *bvh,
+                                         PBVHNode **nodes,
+                                         int totnode,
+                                         PBVHNode **r_update_nodes)
+{
+  PBVHDrawUpdateNode *deferrable = MEM_mallocN(sizeof(*deferrable) * totnode, __func__);
+  int deferrable_len = 0;
+  int update_len = 0;
+  int cost = 0;
+
+  for (int n = 0; n < totnode; n++) {
+    PBVHNode *node = nodes[n];
+    if (node->draw_buffers == NULL || (node->flag & PBVH_RebuildDrawBuffers)) {
+      r_update_nodes[update_len++] = node;
+      cost += pbvh_node_draw_update_cost(bvh, node);
+    }
+    else if (node->flag & PBVH_UpdateDrawBuffers) {
+      deferrable[deferrable_len].node = node;
+      deferrable[deferrable_len].age = bvh->draw_id - node->draw_update_id;
+      deferrable_len++;
+    }
+  }
+
+  qsort(deferrable, deferrable_len, sizeof(*deferrable), pbvh_draw_update_node_cmp);
+
+  for (int n = 0; n < deferrable_len; n++) {
+    /* Always make some progress, even if a single node is above the budget. */
+    if (cost >= PBVH_DRAW_UPDATE_BUDGET && update_len != 0) {
+      break;
+    }
+    r_update_nodes[update_len++] = deferrable[n].node;
+    cost += pbvh_node_draw_update_cost(bvh, deferrable[n].node);
+  }
+
+  MEM_freeN(deferrable);
+  return update_len;
+}
+
+static bool pbvh_draw_update_search_cb(PBVHNode *node, void *data_v)
+{
+  /* Nodes without draw buffers only get them once they are visible. */
+  if ((node->flag & PBVH_Leaf) && node->draw_buffers == NULL) {
+    return false;
+  }
+  return update_search_cb(node, data_v);
+}
+
 static bool pbvh_draw_search_cb(PBVHNode *node, void *data_v)
 {
   PBVHDrawSearchData *data = data_v;
@@ -2454,12 +2705,25 @@ void BKE_pbvh_draw_cb(PBVH *bvh,
 
   const int update_flag = PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
 
+  bvh->draw_id++;
+
   if (!update_only_visible) {
-    /* Update all draw buffers, also those outside the view. */
-    BKE_pbvh_search_gather(bvh, update_search_cb, POINTER_FROM_INT(update_flag), &nodes, &totnode);
+    /* Update all existing draw buffers, also those outside the view. */
+    BKE_pbvh_search_gather(
+        bvh, pbvh_draw_update_search_cb, POINTER_FROM_INT(update_flag), &nodes, &totnode);
 
     if (totnode) {
       pbvh_update_draw_buffers(bvh, nodes, totnode, show_vcol, update_flag);
+
+      /* Flush here since nodes outside the view are not drawn below,
+       * keeping the flags would rebuild them again on the next draw. */
+      for (int a = 0; a < totnode; a++) {
+        PBVHNode *node = nodes[a];
+        if (node->flag & PBVH_UpdateDrawBuffers) {
+          GPU_pbvh_buffers_update_flush(node->draw_buffers);
+        }
+        node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+      }
     }
 
     MEM_SAFE_FREE(nodes);
@@ -2469,21 +2733,34 @@ void BKE_pbvh_draw_cb(PBVH *bvh,
   PBVHDrawSearchData data = {.frustum = frustum, .accum_update_flag = 0};
   BKE_pbvh_search_gather(bvh, pbvh_draw_search_cb, &data, &nodes, &totnode);
 
-  if (update_only_visible && (data.accum_update_flag & update_flag)) {
+  if (data.accum_update_flag & update_flag) {
     /* Update draw buffers in visible nodes. */
-    pbvh_update_draw_buffers(bvh, nodes, totnode, show_vcol, data.accum_update_flag);
+    if (update_only_visible) {
+      PBVHNode **update_nodes = MEM_mallocN(sizeof(*update_nodes) * totnode, __func__);
+      const int update_totnode = pbvh_draw_update_nodes_budget(bvh, nodes, totnode, update_nodes);
+      pbvh_update_draw_buffers(
+          bvh, update_nodes, update_totnode, show_vcol, data.accum_update_flag);
+      MEM_freeN(update_nodes);
+    }
+    else {
+      pbvh_update_draw_buffers(bvh, nodes, totnode, show_vcol, data.accum_update_flag);
+    }
   }
 
   /* Draw. */
   for (int a = 0; a < totnode; a++) {
     PBVHNode *node = nodes[a];
 
-    if (node->flag & PBVH_UpdateDrawBuffers) {
-      /* Flush buffers uses OpenGL, so not in parallel. */
-      GPU_pbvh_buffers_update_flush(node->draw_buffers);
-    }
+    /* Keep the flags of nodes deferred by the update budget. */
+    if (node->draw_update_id == bvh->draw_id) {
+      if (node->flag & PBVH_UpdateDrawBuffers) {
+        /* Flush buffers uses OpenGL, so not in parallel. */
+        GPU_pbvh_buffers_update_flush(node->draw_buffers);
+      }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+      node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    }
+    node->draw_id = bvh->draw_id;
 
     if (!(node->flag & PBVH_FullyHidden)) {
       draw_fn(user_data, node->draw_buffers);
@@ -2491,6 +2768,16 @@ void BKE_pbvh_draw_cb(PBVH *bvh,
   }
 
   MEM_SAFE_FREE(nodes);
+
+  /* Free draw buffers of nodes which stayed out of view, they are built again once visible. */
+  for (int n = 0; n < bvh->totnode; n++) {
+    PBVHNode *node = &bvh->nodes[n];
+    if (node->draw_buffers && (bvh->draw_id - node->draw_id) > PBVH_DRAW_BUFFERS_FREE_DELAY) {
+      GPU_pbvh_buffers_free(node->draw_buffers);
+      node->draw_buffers = NULL;
+      node->flag |= PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
+    }
+  }
 }
 
 void BKE_pbvh_draw_debug_cb(
@@ -26,6 +26,7 @@
 #include "BLI_heap_simple.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_ccg.h"
 #include "BKE_DerivedMesh.h"
@@ -939,54 +940,127 @@ static void short_edge_queue_edge_add(EdgeQueueContext *eq_ctx, BMEdge *e)
   }
 }
 
+/* The face is known to be front facing and in range, see #edge_queue_faces_in_range_gather. */
 static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  /* Check each edge of the face */
+  BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  BMLoop *l_iter = l_first;
+  do {
+#ifdef USE_EDGEQUEUE_EVEN_SUBDIV
+    const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+    if (len_sq > eq_ctx->q->limit_len_squared) {
+      long_edge_queue_edge_add_recursive(
+          eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
     }
-  }
+#else
+    long_edge_queue_edge_add(eq_ctx, l_iter->e);
 #endif
+  } while ((l_iter = l_iter->next) != l_first);
+}
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    /* Check each edge of the face */
-    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    BMLoop *l_iter = l_first;
-    do {
-#ifdef USE_EDGEQUEUE_EVEN_SUBDIV
-      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
-      if (len_sq > eq_ctx->q->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
+/* The face is known to be front facing and in range, see #edge_queue_faces_in_range_gather. */
+static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  BMLoop *l_iter;
+  BMLoop *l_first;
+
+  /* Check each edge of the face */
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    short_edge_queue_edge_add(eq_ctx, l_iter->e);
+  } while ((l_iter = l_iter->next) != l_first);
+}
+
+typedef struct EdgeQueueGatherData {
+  const EdgeQueue *q;
+  PBVHNode **nodes;
+  /* Faces in range for each node, in the order of the node's face set. */
+  BMFace ***node_faces;
+  int *node_faces_len;
+} EdgeQueueGatherData;
+
+static void edge_queue_faces_in_range_task_cb(void *__restrict userdata,
+                                              const int n,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  EdgeQueueGatherData *data = userdata;
+  const EdgeQueue *q = data->q;
+  PBVHNode *node = data->nodes[n];
+
+  BMFace **faces = MEM_mallocN(sizeof(*faces) * BLI_gset_len(node->bm_faces), __func__);
+  int faces_len = 0;
+
+  GSetIterator gs_iter;
+  GSET_ITER (gs_iter, node->bm_faces) {
+    BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
+
+#ifdef USE_EDGEQUEUE_FRONTFACE
+    if (q->use_view_normal) {
+      if (dot_v3v3(f->no, q->view_normal) < 0.0f) {
+        continue;
       }
-#else
-      long_edge_queue_edge_add(eq_ctx, l_iter->e);
+    }
 #endif
-    } while ((l_iter = l_iter->next) != l_first);
+
+    if (q->edge_queue_tri_in_range(q, f)) {
+      faces[faces_len++] = f;
+    }
   }
+
+  data->node_faces[n] = faces;
+  data->node_faces_len[n] = faces_len;
 }
 
-static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/* Add the edges of the faces in range of the leaf nodes marked for topology update.
+ *
+ * Testing every face of the nodes against the brush is read-only and done in parallel, adding
+ * the edges tags them and is done afterwards in the original node and face order, so the queue
+ * is the same as when it is built on a single thread. */
+static void edge_queue_faces_in_range_gather(EdgeQueueContext *eq_ctx,
+                                             PBVH *bvh,
+                                             void (*face_add)(EdgeQueueContext *eq_ctx,
+                                                              BMFace *f))
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  PBVHNode **nodes = MEM_mallocN(sizeof(*nodes) * bvh->totnode, __func__);
+  int totnode = 0;
+
+  for (int n = 0; n < bvh->totnode; n++) {
+    PBVHNode *node = &bvh->nodes[n];
+
+    /* Check leaf nodes marked for topology update */
+    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
+        !(node->flag & PBVH_FullyHidden)) {
+      nodes[totnode++] = node;
     }
   }
-#endif
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
+  if (totnode == 0) {
+    MEM_freeN(nodes);
+    return;
+  }
 
-    /* Check each edge of the face */
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
-    } while ((l_iter = l_iter->next) != l_first);
+  EdgeQueueGatherData data = {
+      .q = eq_ctx->q,
+      .nodes = nodes,
+      .node_faces = MEM_mallocN(sizeof(*data.node_faces) * totnode, __func__),
+      .node_faces_len = MEM_mallocN(sizeof(*data.node_faces_len) * totnode, __func__),
+  };
+
+  PBVHParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totnode);
+  BKE_pbvh_parallel_range(0, totnode, &data, edge_queue_faces_in_range_task_cb, &settings);
+
+  for (int n = 0; n < totnode; n++) {
+    for (int i = 0; i < data.node_faces_len[n]; i++) {
+      face_add(eq_ctx, data.node_faces[n][i]);
+    }
+    MEM_freeN(data.node_faces[n]);
   }
+
+  MEM_freeN(data.node_faces);
+  MEM_freeN(data.node_faces_len);
+  MEM_freeN(nodes);
 }
 
 /* Create a priority queue containing vertex pairs connected by a long
@@ -1034,22 +1108,7 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(bvh);
 #endif
 
-  for (int n = 0; n < bvh->totnode; n++) {
-    PBVHNode *node = &bvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_faces_in_range_gather(eq_ctx, bvh, long_edge_queue_face_add);
 }
 
 /* Create a priority queue containing vertex pairs connected by a
@@ -1093,22 +1152,7 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (int n = 0; n < bvh->totnode; n++) {
-    PBVHNode *node = &bvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_faces_in_range_gather(eq_ctx, bvh, short_edge_queue_face_add);
 }
 
 /*************************** Topology update **************************/
@@ -92,6 +92,11 @@ struct PBVHNode {
   /* Used for raycasting: how close bb is to the ray point. */
   float tmin;
 
+  /* Value of PBVH.draw_id when the node was last drawn, to free unused draw buffers. */
+  uint draw_id;
+  /* Value of PBVH.draw_id when the draw buffers were last updated. */
+  uint draw_update_id;
+
   /* Scalar displacements for sculpt mode's layer brush. */
   float *layer_disp;
 
@@ -147,6 +152,10 @@ struct PBVH {
    * don't need to remain valid after */
   BLI_bitmap *vert_bitmap;
 
+  /* Polygons with moved vertices since the PBVH was built, their tessellation in looptri is
+   * older than the coordinates. */
+  BLI_bitmap *looptri_dirty_polys;
+
 #ifdef PERFCNTRS
   int perf_modified;
 #endif
@@ -155,6 +164,9 @@ struct PBVH {
   bool deformed;
   bool show_mask;
 
+  /* Incremented for every draw. */
+  uint draw_id;
+
   /* Dynamic topology */
   BMesh *bm;
   float bm_max_edge_len;
@@ -45,6 +45,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -2255,24 +2256,38 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
 
   return r;
 }
-static int ptcache_file_compressed_write(
-    PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode)
+/* Result of compressing one block of cache data, kept separate from writing it to the file so
+ * that several blocks can be compressed at the same time. */
+typedef struct PTCacheCompressedBlock {
+  unsigned char *in;
+  unsigned int in_len;
+  unsigned char *out;
+  size_t out_len;
+  unsigned char props[16];
+  size_t props_len;
+  unsigned char compressed;
+  int r;
+} PTCacheCompressedBlock;
+
+static void ptcache_block_compress(PTCacheCompressedBlock *block, int mode)
 {
   int r = 0;
   unsigned char compressed = 0;
   size_t out_len = 0;
-  unsigned char *props = MEM_callocN(16 * sizeof(char), "tmp");
   size_t sizeOfIt = 5;
 
   (void)mode; /* unused when building w/o compression */
 
+  memset(block->props, 0, sizeof(block->props));
+
 #ifdef WITH_LZO
-  out_len = LZO_OUT_LEN(in_len);
+  out_len = LZO_OUT_LEN(block->in_len);
   if (mode == 1) {
     LZO_HEAP_ALLOC(wrkmem, LZO1X_MEM_COMPRESS);
 
-    r = lzo1x_1_compress(in, (lzo_uint)in_len, out, (lzo_uint *)&out_len, wrkmem);
-    if (!(r == LZO_E_OK) || (out_len >= in_len)) {
+    r = lzo1x_1_compress(
+        block->in, (lzo_uint)block->in_len, block->out, (lzo_uint *)&out_len, wrkmem);
+    if (!(r == LZO_E_OK) || (out_len >= block->in_len)) {
       compressed = 0;
     }
     else {
@@ -2283,11 +2298,11 @@ static int ptcache_file_compressed_write(
 #ifdef WITH_LZMA
   if (mode == 2) {
 
-    r = LzmaCompress(out,
+    r = LzmaCompress(block->out,
                      &out_len,
-                     in,
-                     in_len,  // assume sizeof(char)==1....
-                     props,
+                     block->in,
+                     block->in_len,  // assume sizeof(char)==1....
+                     block->props,
                      &sizeOfIt,
                      5,
                      1 << 24,
@@ -2297,7 +2312,7 @@ static int ptcache_file_compressed_write(
                      32,
                      2);
 
-    if (!(r == SZ_OK) || (out_len >= in_len)) {
+    if (!(r == SZ_OK) || (out_len >= block->in_len)) {
       compressed = 0;
     }
     else {
@@ -2306,25 +2321,42 @@ static int ptcache_file_compressed_write(
   }
 #endif
 
-  ptcache_file_write(pf, &compressed, 1, sizeof(unsigned char));
-  if (compressed) {
-    unsigned int size = out_len;
+  block->out_len = out_len;
+  block->props_len = sizeOfIt;
+  block->compressed = compressed;
+  block->r = r;
+}
+static void ptcache_file_compressed_block_write(PTCacheFile *pf, PTCacheCompressedBlock *block)
+{
+  ptcache_file_write(pf, &block->compressed, 1, sizeof(unsigned char));
+  if (block->compressed) {
+    unsigned int size = block->out_len;
     ptcache_file_write(pf, &size, 1, sizeof(unsigned int));
-    ptcache_file_write(pf, out, out_len, sizeof(unsigned char));
+    ptcache_file_write(pf, block->out, block->out_len, sizeof(unsigned char));
   }
   else {
-    ptcache_file_write(pf, in, in_len, sizeof(unsigned char));
+    ptcache_file_write(pf, block->in, block->in_len, sizeof(unsigned char));
   }
 
-  if (compressed == 2) {
-    unsigned int size = sizeOfIt;
-    ptcache_file_write(pf, &sizeOfIt, 1, sizeof(unsigned int));
-    ptcache_file_write(pf, props, size, sizeof(unsigned char));
+  if (block->compressed == 2) {
+    unsigned int size = block->props_len;
+    ptcache_file_write(pf, &block->props_len, 1, sizeof(unsigned int));
+    ptcache_file_write(pf, block->props, size, sizeof(unsigned char));
   }
+}
+static int ptcache_file_compressed_write(
+    PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode)
+{
+  PTCacheCompressedBlock block = {
+      .in = in,
+      .in_len = in_len,
+      .out = out,
+  };
 
-  MEM_freeN(props);
+  ptcache_block_compress(&block, mode);
+  ptcache_file_compressed_block_write(pf, &block);
 
-  return r;
+  return block.r;
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size)
 {
@@ -2717,6 +2749,19 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
 
   return pm;
 }
+typedef struct PTCacheCompressTaskData {
+  PTCacheCompressedBlock *blocks;
+  int mode;
+} PTCacheCompressTaskData;
+
+static void ptcache_compress_task_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PTCacheCompressTaskData *data = userdata;
+  ptcache_block_compress(&data->blocks[i], data->mode);
+}
+
 static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 {
   PTCacheFile *pf = NULL;
@@ -2752,16 +2797,34 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
   if (!error) {
     if (pid->cache->compression) {
+      /* Compress all data types at once, then write them in their usual order. */
+      PTCacheCompressedBlock blocks[BPHYS_TOT_DATA];
+      unsigned int totblock = 0;
+
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
-          unsigned int in_len = pm->totpoint * ptcache_data_size[i];
-          unsigned char *out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
-                                                            "pointcache_lzo_buffer");
-          ptcache_file_compressed_write(
-              pf, (unsigned char *)(pm->data[i]), in_len, out, pid->cache->compression);
-          MEM_freeN(out);
+          PTCacheCompressedBlock *block = &blocks[totblock++];
+          block->in = (unsigned char *)(pm->data[i]);
+          block->in_len = pm->totpoint * ptcache_data_size[i];
+          block->out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(block->in_len) * 4,
+                                                    "pointcache_lzo_buffer");
         }
       }
+
+      PTCacheCompressTaskData data = {
+          .blocks = blocks,
+          .mode = pid->cache->compression,
+      };
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (pm->totpoint > 10000);
+      BLI_task_parallel_range(0, totblock, &data, ptcache_compress_task_cb, &settings);
+
+      for (i = 0; i < totblock; i++) {
+        ptcache_file_compressed_block_write(pf, &blocks[i]);
+        MEM_freeN(blocks[i].out);
+      }
     }
     else {
       BKE_ptcache_mem_pointers_init(pm);
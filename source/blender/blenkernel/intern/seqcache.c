@@ -23,11 +23,16 @@
 #include <stddef.h>
 #include <memory.h>
 
+#include "zlib.h"
+
 #include "MEM_guardedalloc.h"
 
+#include "DNA_color_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
+#include "IMB_colormanagement.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
 
@@ -35,7 +40,13 @@
 #include "BLI_threads.h"
 #include "BLI_listbase.h"
 #include "BLI_ghash.h"
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_hash_mm2a.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
 
+#include "BKE_appdir.h"
 #include "BKE_sequencer.h"
 #include "BKE_scene.h"
 #include "BKE_main.h"
@@ -63,6 +74,17 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Disk cache:
+ * Raw and preprocessed images can additionally be kept on disk, so they survive reopening the
+ * file. Files are named after a hash of everything the image depends on: render size, frame,
+ * strip and effect settings, modifiers, source files and their modification time, recursively
+ * for effect inputs and meta strip contents. Editing a strip therefore creates new files instead
+ * of invalidating old ones, files are removed least recently used first when the size limit from
+ * the user preferences is exceeded.
+ * Images are written by the thread putting them into the cache, so prefetching fills the disk
+ * cache in the background. Strips that depend on data which can't be hashed (scenes, clips,
+ * masks, animated strips...) are not stored, composite and final images stay in memory only.
  */
 
 typedef struct SeqCache {
@@ -172,6 +194,16 @@ static size_t seq_cache_get_mem_total(void)
   return ((size_t)U.memcachelimit) * 1024 * 1024;
 }
 
+/* Image types which are kept in the cache instead of being freed after rendering the frame. */
+static int seq_cache_get_stored_types(Scene *scene, Sequence *seq)
+{
+  if (seq->cache_flag & SEQ_CACHE_OVERRIDE) {
+    return seq->cache_flag | (scene->ed->cache_flag & SEQ_CACHE_STORE_FINAL_OUT);
+  }
+
+  return scene->ed->cache_flag;
+}
+
 static void seq_cache_keyfree(void *val)
 {
   SeqCacheKey *key = val;
@@ -447,6 +479,574 @@ static void BKE_sequencer_cache_create(Scene *scene)
   BLI_mutex_unlock(&cache_create_lock);
 }
 
+/* ***************************** Disk Cache ****************************** */
+
+#define SEQ_DISK_CACHE_MAGIC "BSEQDC"
+#define SEQ_DISK_CACHE_VERSION 1
+#define SEQ_DISK_CACHE_EXT ".bseqcache"
+
+typedef struct SeqDiskCacheHeader {
+  char magic[8];
+  int version;
+  int x, y, planes;
+  /* IB_rectfloat or IB_rect */
+  int type;
+  /* ImBuf.flags alpha mode */
+  int flags;
+  char colorspace[64];
+} SeqDiskCacheHeader;
+
+typedef struct SeqDiskCacheFile {
+  struct SeqDiskCacheFile *next, *prev;
+  char path[FILE_MAX];
+  size_t size;
+  int64_t mtime;
+} SeqDiskCacheFile;
+
+typedef struct SeqDiskCache {
+  /* Directory the files were scanned from, scanned again when the preference changes. */
+  char dir[FILE_MAX];
+  /* Files ordered from the least to the most recently used. */
+  ListBase files;
+  struct GHash *files_hash;
+  size_t size_used;
+  unsigned int temp_file_counter;
+} SeqDiskCache;
+
+typedef struct SeqDiskCacheHash {
+  BLI_HashMurmur2A mm2[2];
+} SeqDiskCacheHash;
+
+static SeqDiskCache seq_disk_cache = {{0}};
+static ThreadMutex seq_disk_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static void seq_disk_hash_init(SeqDiskCacheHash *hash)
+{
+  BLI_hash_mm2a_init(&hash->mm2[0], 0);
+  BLI_hash_mm2a_init(&hash->mm2[1], 0x9e3779b9);
+}
+
+static void seq_disk_hash_add(SeqDiskCacheHash *hash, const void *data, size_t len)
+{
+  BLI_hash_mm2a_add(&hash->mm2[0], (const unsigned char *)data, len);
+  BLI_hash_mm2a_add(&hash->mm2[1], (const unsigned char *)data, len);
+}
+
+static void seq_disk_hash_add_int(SeqDiskCacheHash *hash, int data)
+{
+  BLI_hash_mm2a_add_int(&hash->mm2[0], data);
+  BLI_hash_mm2a_add_int(&hash->mm2[1], data);
+}
+
+static void seq_disk_hash_add_float(SeqDiskCacheHash *hash, float data)
+{
+  seq_disk_hash_add(hash, &data, sizeof(data));
+}
+
+static void seq_disk_hash_add_string(SeqDiskCacheHash *hash, const char *str)
+{
+  seq_disk_hash_add(hash, str, strlen(str) + 1);
+}
+
+static void seq_disk_hash_add_curve_mapping(SeqDiskCacheHash *hash, const CurveMapping *cumap)
+{
+  seq_disk_hash_add_int(hash, cumap->flag);
+  seq_disk_hash_add(hash, &cumap->clipr, sizeof(cumap->clipr));
+  seq_disk_hash_add(hash, cumap->black, sizeof(cumap->black));
+  seq_disk_hash_add(hash, cumap->white, sizeof(cumap->white));
+  seq_disk_hash_add_int(hash, cumap->tone);
+
+  for (int i = 0; i < CM_TOT; i++) {
+    const CurveMap *cuma = &cumap->cm[i];
+
+    seq_disk_hash_add_int(hash, cuma->totpoint);
+    seq_disk_hash_add(hash, cuma->ext_in, sizeof(cuma->ext_in));
+    seq_disk_hash_add(hash, cuma->ext_out, sizeof(cuma->ext_out));
+    if (cuma->curve) {
+      seq_disk_hash_add(hash, cuma->curve, sizeof(CurveMapPoint) * cuma->totpoint);
+    }
+  }
+}
+
+static bool seq_disk_hash_add_modifiers(SeqDiskCacheHash *hash, Sequence *seq)
+{
+  for (SequenceModifierData *smd = seq->modifiers.first; smd; smd = smd->next) {
+    const SequenceModifierTypeInfo *smti = BKE_sequence_modifier_type_info_get(smd->type);
+
+    if (smti == NULL || smd->mask_sequence || smd->mask_id || smd->type == seqModifierType_Mask) {
+      return false;
+    }
+
+    seq_disk_hash_add_int(hash, smd->type);
+    seq_disk_hash_add_int(hash, smd->flag & ~SEQUENCE_MODIFIER_EXPANDED);
+
+    switch (smd->type) {
+      case seqModifierType_Curves:
+        seq_disk_hash_add_curve_mapping(hash, &((CurvesModifierData *)smd)->curve_mapping);
+        break;
+      case seqModifierType_HueCorrect:
+        seq_disk_hash_add_curve_mapping(hash, &((HueCorrectModifierData *)smd)->curve_mapping);
+        break;
+      default:
+        /* Settings of the other modifiers are plain values. */
+        seq_disk_hash_add(hash,
+                          (const char *)smd + sizeof(SequenceModifierData),
+                          smti->struct_size - sizeof(SequenceModifierData));
+        break;
+    }
+  }
+
+  return true;
+}
+
+/* Hash everything the image of the strip at given frame depends on,
+ * returns false when that is not possible. */
+static bool seq_disk_hash_add_sequence(SeqDiskCacheHash *hash,
+                                       const SeqRenderData *context,
+                                       Sequence *seq,
+                                       float cfra)
+{
+  Strip *strip = seq->strip;
+
+  if (ELEM(seq->type,
+           SEQ_TYPE_SCENE,
+           SEQ_TYPE_MOVIECLIP,
+           SEQ_TYPE_MASK,
+           SEQ_TYPE_SOUND_RAM,
+           SEQ_TYPE_SOUND_HD,
+           SEQ_TYPE_MULTICAM,
+           SEQ_TYPE_ADJUSTMENT,
+           SEQ_TYPE_SPEED,
+           SEQ_TYPE_TEXT)) {
+    return false;
+  }
+
+  if (BKE_sequencer_has_animdata(context->scene, seq)) {
+    return false;
+  }
+
+  seq_disk_hash_add_string(hash, seq->name);
+  seq_disk_hash_add_int(hash, seq->type);
+  seq_disk_hash_add_int(hash, seq->flag & ~(SEQ_ALLSEL | SEQ_OVERLAP | SEQ_LOCK));
+  seq_disk_hash_add_int(hash, seq->len);
+  seq_disk_hash_add_int(hash, seq->start);
+  seq_disk_hash_add_int(hash, seq->startofs);
+  seq_disk_hash_add_int(hash, seq->endofs);
+  seq_disk_hash_add_int(hash, seq->startstill);
+  seq_disk_hash_add_int(hash, seq->endstill);
+  seq_disk_hash_add_int(hash, seq->anim_startofs);
+  seq_disk_hash_add_int(hash, seq->anim_endofs);
+  seq_disk_hash_add_int(hash, seq->streamindex);
+  seq_disk_hash_add_int(hash, seq->blend_mode);
+  seq_disk_hash_add_int(hash, seq->alpha_mode);
+  seq_disk_hash_add_int(hash, seq->views_format);
+  seq_disk_hash_add_float(hash, seq->sat);
+  seq_disk_hash_add_float(hash, seq->mul);
+  seq_disk_hash_add_float(hash, seq->strobe);
+  seq_disk_hash_add_float(hash, seq->blend_opacity);
+  seq_disk_hash_add_float(hash, seq->effect_fader);
+
+  if (strip) {
+    seq_disk_hash_add_string(hash, strip->colorspace_settings.name);
+    if (strip->transform) {
+      seq_disk_hash_add(hash, strip->transform, sizeof(StripTransform));
+    }
+    if (strip->crop) {
+      seq_disk_hash_add(hash, strip->crop, sizeof(StripCrop));
+    }
+    if (strip->proxy && (seq->flag & SEQ_USE_PROXY)) {
+      seq_disk_hash_add_string(hash, strip->proxy->dir);
+      seq_disk_hash_add_string(hash, strip->proxy->file);
+      seq_disk_hash_add_int(hash, strip->proxy->tc);
+      seq_disk_hash_add_int(hash, strip->proxy->storage);
+      seq_disk_hash_add_int(hash, context->scene->ed->proxy_storage);
+      seq_disk_hash_add_string(hash, context->scene->ed->proxy_dir);
+    }
+  }
+
+  /* The source file, its modification time and size stand in for the pixels. */
+  if (ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    StripElem *s_elem = (seq->type == SEQ_TYPE_IMAGE) ?
+                            BKE_sequencer_give_stripelem(seq, (int)cfra) :
+                            (strip ? strip->stripdata : NULL);
+    char name[FILE_MAX];
+    BLI_stat_t st;
+
+    if (s_elem == NULL) {
+      return false;
+    }
+
+    BLI_join_dirfile(name, sizeof(name), strip->dir, s_elem->name);
+    BLI_path_abs(name, BKE_main_blendfile_path(context->bmain));
+
+    if (BLI_stat(name, &st) != 0) {
+      return false;
+    }
+
+    seq_disk_hash_add_string(hash, name);
+    seq_disk_hash_add(hash, &st.st_mtime, sizeof(st.st_mtime));
+    seq_disk_hash_add(hash, &st.st_size, sizeof(st.st_size));
+  }
+
+  if (seq->effectdata) {
+    seq_disk_hash_add(hash, seq->effectdata, MEM_allocN_len(seq->effectdata));
+  }
+
+  if (!seq_disk_hash_add_modifiers(hash, seq)) {
+    return false;
+  }
+
+  Sequence *inputs[3] = {seq->seq1, seq->seq2, seq->seq3};
+  for (int i = 0; i < 3; i++) {
+    seq_disk_hash_add_int(hash, inputs[i] != NULL);
+    if (inputs[i] && !seq_disk_hash_add_sequence(hash, context, inputs[i], cfra)) {
+      return false;
+    }
+  }
+
+  for (Sequence *seq_child = seq->seqbase.first; seq_child; seq_child = seq_child->next) {
+    seq_disk_hash_add_int(hash, seq_child->machine);
+    if (!seq_disk_hash_add_sequence(hash, context, seq_child, cfra)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void seq_disk_cache_get_dir(char r_dir[FILE_MAX])
+{
+  if (U.sequencer_disk_cache_dir[0] != '\0') {
+    BLI_strncpy(r_dir, U.sequencer_disk_cache_dir, FILE_MAX);
+    BLI_path_abs(r_dir, BKE_main_blendfile_path_from_global());
+  }
+  else {
+    BLI_join_dirfile(r_dir, FILE_MAX, BKE_tempdir_base(), "blender_sequencer_cache");
+  }
+  /* Matches the directory part of the file paths. */
+  BLI_add_slash(r_dir);
+}
+
+static bool seq_disk_cache_get_path(const SeqRenderData *context,
+                                    Sequence *seq,
+                                    float cfra,
+                                    int type,
+                                    char r_path[FILE_MAX])
+{
+  SeqDiskCacheHash hash;
+  char dir[FILE_MAX];
+  char filename[FILE_MAXFILE];
+
+  seq_disk_hash_init(&hash);
+  seq_disk_hash_add_int(&hash, SEQ_DISK_CACHE_VERSION);
+  seq_disk_hash_add_int(&hash, type);
+  seq_disk_hash_add_float(&hash, cfra);
+  seq_disk_hash_add_int(&hash, context->rectx);
+  seq_disk_hash_add_int(&hash, context->recty);
+  seq_disk_hash_add_int(&hash, context->preview_render_size);
+  seq_disk_hash_add_int(&hash, context->view_id);
+  seq_disk_hash_add_int(&hash, context->scene->r.views_format);
+  seq_disk_hash_add_string(&hash, context->scene->sequencer_colorspace_settings.name);
+
+  if (!seq_disk_hash_add_sequence(&hash, context, seq, cfra)) {
+    return false;
+  }
+
+  seq_disk_cache_get_dir(dir);
+  BLI_snprintf(filename,
+               sizeof(filename),
+               "%08x%08x" SEQ_DISK_CACHE_EXT,
+               BLI_hash_mm2a_end(&hash.mm2[0]),
+               BLI_hash_mm2a_end(&hash.mm2[1]));
+  BLI_join_dirfile(r_path, FILE_MAX, dir, filename);
+  return true;
+}
+
+static bool seq_disk_cache_is_enabled(const SeqRenderData *context, Sequence *seq, int type)
+{
+  Scene *scene = context->scene;
+
+  if (!(scene->ed->cache_flag & SEQ_CACHE_DISK_CACHE_ENABLE) ||
+      U.sequencer_disk_cache_size_limit <= 0) {
+    return false;
+  }
+
+  if (context->skip_cache || context->is_proxy_render) {
+    return false;
+  }
+
+  /* Composite and final images depend on the entire stack,
+   * which is not covered by the hash of the strip. */
+  type &= SEQ_CACHE_STORE_RAW | SEQ_CACHE_STORE_PREPROCESSED;
+
+  return (seq_cache_get_stored_types(scene, seq) & type) != 0;
+}
+
+static int seq_disk_cache_file_cmp(const void *a_, const void *b_)
+{
+  const SeqDiskCacheFile *a = a_;
+  const SeqDiskCacheFile *b = b_;
+
+  return (a->mtime > b->mtime) - (a->mtime < b->mtime);
+}
+
+static void seq_disk_cache_add_file(const char *path, size_t size, int64_t mtime)
+{
+  SeqDiskCacheFile *file = MEM_callocN(sizeof(SeqDiskCacheFile), "SeqDiskCacheFile");
+
+  BLI_strncpy(file->path, path, sizeof(file->path));
+  file->size = size;
+  file->mtime = mtime;
+  BLI_addtail(&seq_disk_cache.files, file);
+  BLI_ghash_insert(seq_disk_cache.files_hash, file->path, file);
+  seq_disk_cache.size_used += size;
+}
+
+static void seq_disk_cache_remove_file(SeqDiskCacheFile *file)
+{
+  BLI_ghash_remove(seq_disk_cache.files_hash, file->path, NULL, NULL);
+  BLI_remlink(&seq_disk_cache.files, file);
+  seq_disk_cache.size_used -= file->size;
+  MEM_freeN(file);
+}
+
+static void seq_disk_cache_free_files(void)
+{
+  if (seq_disk_cache.files_hash) {
+    BLI_ghash_free(seq_disk_cache.files_hash, NULL, NULL);
+    seq_disk_cache.files_hash = NULL;
+  }
+  BLI_freelistN(&seq_disk_cache.files);
+  seq_disk_cache.size_used = 0;
+  seq_disk_cache.dir[0] = '\0';
+}
+
+/* Scan the cache directory for files of previous sessions, must be called with the lock held. */
+static void seq_disk_cache_ensure_dir(const char *dir)
+{
+  struct direntry *filelist;
+  unsigned int totfile;
+
+  if (seq_disk_cache.files_hash && STREQ(seq_disk_cache.dir, dir)) {
+    return;
+  }
+
+  seq_disk_cache_free_files();
+  BLI_strncpy(seq_disk_cache.dir, dir, sizeof(seq_disk_cache.dir));
+  seq_disk_cache.files_hash = BLI_ghash_str_new("SeqDiskCache hash");
+
+  if (!BLI_dir_create_recursive(dir)) {
+    return;
+  }
+
+  totfile = BLI_filelist_dir_contents(dir, &filelist);
+  for (unsigned int i = 0; i < totfile; i++) {
+    if (BLI_path_extension_check(filelist[i].relname, SEQ_DISK_CACHE_EXT)) {
+      seq_disk_cache_add_file(
+          filelist[i].path, (size_t)filelist[i].s.st_size, (int64_t)filelist[i].s.st_mtime);
+    }
+  }
+  BLI_filelist_free(filelist, totfile);
+
+  BLI_listbase_sort(&seq_disk_cache.files, seq_disk_cache_file_cmp);
+}
+
+/* Must be called with the lock held. */
+static void seq_disk_cache_trim(void)
+{
+  const size_t size_limit = (size_t)U.sequencer_disk_cache_size_limit * 1024 * 1024 * 1024;
+
+  while (seq_disk_cache.size_used > size_limit && seq_disk_cache.files.first) {
+    SeqDiskCacheFile *file = seq_disk_cache.files.first;
+
+    BLI_delete(file->path, false, false);
+    seq_disk_cache_remove_file(file);
+  }
+}
+
+/* Must be called with the lock held. */
+static SeqDiskCacheFile *seq_disk_cache_lookup_file(const char *path)
+{
+  char dir[FILE_MAX];
+
+  BLI_split_dir_part(path, dir, sizeof(dir));
+  seq_disk_cache_ensure_dir(dir);
+
+  return BLI_ghash_lookup(seq_disk_cache.files_hash, path);
+}
+
+static bool seq_disk_cache_has_file(const char *path)
+{
+  bool found;
+
+  BLI_mutex_lock(&seq_disk_cache_lock);
+  found = seq_disk_cache_lookup_file(path) != NULL;
+  BLI_mutex_unlock(&seq_disk_cache_lock);
+
+  return found;
+}
+
+static void seq_disk_cache_write_file(const char *path, ImBuf *ibuf)
+{
+  SeqDiskCacheHeader header = {{0}};
+  const char *colorspace;
+  void *pixels;
+  size_t pixels_size;
+  char dir[FILE_MAX];
+  char temp_path[FILE_MAX];
+  char mode[8];
+  gzFile gzfile;
+  bool ok;
+
+  BLI_split_dir_part(path, dir, sizeof(dir));
+
+  if (ibuf->rect_float && ibuf->channels == 4) {
+    header.type = IB_rectfloat;
+    pixels = ibuf->rect_float;
+    pixels_size = sizeof(float[4]) * ibuf->x * ibuf->y;
+    colorspace = IMB_colormanagement_get_float_colorspace(ibuf);
+  }
+  else if (ibuf->rect && ibuf->rect_float == NULL) {
+    header.type = IB_rect;
+    pixels = ibuf->rect;
+    pixels_size = sizeof(unsigned int) * ibuf->x * ibuf->y;
+    colorspace = IMB_colormanagement_get_rect_colorspace(ibuf);
+  }
+  else {
+    return;
+  }
+
+  STRNCPY(header.magic, SEQ_DISK_CACHE_MAGIC);
+  header.version = SEQ_DISK_CACHE_VERSION;
+  header.x = ibuf->x;
+  header.y = ibuf->y;
+  header.planes = ibuf->planes;
+  header.flags = ibuf->flags & (IB_alphamode_premul | IB_alphamode_ignore);
+  if (colorspace) {
+    STRNCPY(header.colorspace, colorspace);
+  }
+
+  switch (U.sequencer_disk_cache_compression) {
+    case USER_SEQ_DISK_CACHE_COMPRESSION_NONE:
+      STRNCPY(mode, "wb0");
+      break;
+    case USER_SEQ_DISK_CACHE_COMPRESSION_HIGH:
+      STRNCPY(mode, "wb9");
+      break;
+    default:
+      STRNCPY(mode, "wb1");
+      break;
+  }
+
+  /* Compress outside of the lock into a file of our own, and only rename it into place once it
+   * is complete, so readers never see partially written files. */
+  BLI_mutex_lock(&seq_disk_cache_lock);
+  seq_disk_cache_ensure_dir(dir);
+  BLI_snprintf(
+      temp_path, sizeof(temp_path), "%s.%u.tmp", path, seq_disk_cache.temp_file_counter++);
+  BLI_mutex_unlock(&seq_disk_cache_lock);
+
+  gzfile = BLI_gzopen(temp_path, mode);
+  if (gzfile == NULL) {
+    return;
+  }
+  ok = gzwrite(gzfile, &header, sizeof(header)) == sizeof(header);
+  ok = ok && gzwrite(gzfile, pixels, (unsigned int)pixels_size) == (int)pixels_size;
+  ok = (gzclose(gzfile) == Z_OK) && ok;
+
+  if (!ok) {
+    BLI_delete(temp_path, false, false);
+    return;
+  }
+
+  size_t size = BLI_file_size(temp_path);
+
+  BLI_mutex_lock(&seq_disk_cache_lock);
+  if (!STREQ(seq_disk_cache.dir, dir) || BLI_ghash_haskey(seq_disk_cache.files_hash, path) ||
+      BLI_rename(temp_path, path) != 0) {
+    BLI_delete(temp_path, false, false);
+  }
+  else {
+    seq_disk_cache_add_file(path, size, 0);
+    seq_disk_cache_trim();
+  }
+  BLI_mutex_unlock(&seq_disk_cache_lock);
+}
+
+static ImBuf *seq_disk_cache_read_file(const char *path)
+{
+  SeqDiskCacheHeader header;
+  SeqDiskCacheFile *file;
+  ImBuf *ibuf = NULL;
+  gzFile gzfile;
+
+  BLI_mutex_lock(&seq_disk_cache_lock);
+  file = seq_disk_cache_lookup_file(path);
+  if (file) {
+    /* Most recently used files are recycled last. */
+    BLI_remlink(&seq_disk_cache.files, file);
+    BLI_addtail(&seq_disk_cache.files, file);
+  }
+  BLI_mutex_unlock(&seq_disk_cache_lock);
+
+  if (file == NULL) {
+    return NULL;
+  }
+
+  gzfile = BLI_gzopen(path, "rb");
+  if (gzfile == NULL) {
+    return NULL;
+  }
+
+  if (gzread(gzfile, &header, sizeof(header)) == sizeof(header) &&
+      STREQLEN(header.magic, SEQ_DISK_CACHE_MAGIC, sizeof(header.magic)) &&
+      header.version == SEQ_DISK_CACHE_VERSION && header.x > 0 && header.y > 0 &&
+      ELEM(header.type, IB_rectfloat, IB_rect)) {
+    ibuf = IMB_allocImBuf(header.x, header.y, header.planes, header.type);
+  }
+
+  if (ibuf) {
+    void *pixels = (header.type == IB_rectfloat) ? (void *)ibuf->rect_float : (void *)ibuf->rect;
+    size_t pixels_size = ((header.type == IB_rectfloat) ? sizeof(float[4]) :
+                                                          sizeof(unsigned int)) *
+                         ibuf->x * ibuf->y;
+
+    if (gzread(gzfile, pixels, (unsigned int)pixels_size) != (int)pixels_size) {
+      IMB_freeImBuf(ibuf);
+      ibuf = NULL;
+    }
+  }
+  gzclose(gzfile);
+
+  if (ibuf == NULL) {
+    /* Unreadable files are of no further use. */
+    BLI_mutex_lock(&seq_disk_cache_lock);
+    file = seq_disk_cache_lookup_file(path);
+    if (file) {
+      BLI_delete(file->path, false, false);
+      seq_disk_cache_remove_file(file);
+    }
+    BLI_mutex_unlock(&seq_disk_cache_lock);
+    return NULL;
+  }
+
+  ibuf->flags |= header.flags;
+  header.colorspace[sizeof(header.colorspace) - 1] = '\0';
+  if (header.colorspace[0] != '\0') {
+    if (header.type == IB_rectfloat) {
+      IMB_colormanagement_assign_float_colorspace(ibuf, header.colorspace);
+    }
+    else {
+      IMB_colormanagement_assign_rect_colorspace(ibuf, header.colorspace);
+    }
+  }
+
+  /* Keep the order of use for the next session. */
+  BLI_file_touch(path);
+
+  return ibuf;
+}
+
 /* ***************************** API ****************************** */
 
 void BKE_sequencer_cache_free_temp_cache(Scene *scene, short id, int cfra)
@@ -486,6 +1086,13 @@ void BKE_sequencer_cache_destruct(Scene *scene)
   scene->ed->cache = NULL;
 }
 
+void BKE_sequencer_disk_cache_free(void)
+{
+  BLI_mutex_lock(&seq_disk_cache_lock);
+  seq_disk_cache_free_files();
+  BLI_mutex_unlock(&seq_disk_cache_lock);
+}
+
 void BKE_sequencer_cache_cleanup_all(Main *bmain)
 {
   for (Scene *scene = bmain->scenes.first; scene != NULL; scene = scene->id.next) {
@@ -572,6 +1179,28 @@ void BKE_sequencer_cache_cleanup_sequence(Scene *scene,
   seq_cache_unlock(scene);
 }
 
+static ImBuf *seq_cache_get_from_memory(
+    Scene *scene, const SeqRenderData *context, Sequence *seq, float cfra, int type)
+{
+  seq_cache_lock(scene);
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  ImBuf *ibuf = NULL;
+
+  if (cache && seq) {
+    SeqCacheKey key;
+
+    key.seq = seq;
+    key.context = *context;
+    key.nfra = cfra - seq->start;
+    key.type = type;
+
+    ibuf = seq_cache_get(cache, &key);
+  }
+  seq_cache_unlock(scene);
+
+  return ibuf;
+}
+
 struct ImBuf *BKE_sequencer_cache_get(const SeqRenderData *context,
                                       Sequence *seq,
                                       float cfra,
@@ -587,24 +1216,21 @@ struct ImBuf *BKE_sequencer_cache_get(const SeqRenderData *context,
 
   if (!scene->ed->cache) {
     BKE_sequencer_cache_create(scene);
-    return NULL;
   }
 
-  seq_cache_lock(scene);
-  SeqCache *cache = seq_cache_get_from_scene(scene);
-  ImBuf *ibuf = NULL;
+  ImBuf *ibuf = seq_cache_get_from_memory(scene, context, seq, cfra, type);
 
-  if (cache && seq) {
-    SeqCacheKey key;
+  /* Try to load from the disk cache, the image is kept in memory for next time. */
+  if (ibuf == NULL && seq && seq_disk_cache_is_enabled(context, seq, type)) {
+    char path[FILE_MAX];
 
-    key.seq = seq;
-    key.context = *context;
-    key.nfra = cfra - seq->start;
-    key.type = type;
-
-    ibuf = seq_cache_get(cache, &key);
+    if (seq_disk_cache_get_path(context, seq, cfra, type, path)) {
+      ibuf = seq_disk_cache_read_file(path);
+      if (ibuf) {
+        BKE_sequencer_cache_put(context, seq, cfra, type, ibuf, 0.0f);
+      }
+    }
   }
-  seq_cache_unlock(scene);
 
   return ibuf;
 }
@@ -647,7 +1273,7 @@ void BKE_sequencer_cache_put(
   }
 
   /* Prevent reinserting, it breaks cache key linking */
-  ImBuf *test = BKE_sequencer_cache_get(context, seq, cfra, type);
+  ImBuf *test = seq_cache_get_from_memory(scene, context, seq, cfra, type);
   if (test) {
     IMB_freeImBuf(test);
     return;
@@ -660,15 +1286,7 @@ void BKE_sequencer_cache_put(
   seq_cache_lock(scene);
 
   SeqCache *cache = seq_cache_get_from_scene(scene);
-  int flag;
-
-  if (seq->cache_flag & SEQ_CACHE_OVERRIDE) {
-    flag = seq->cache_flag;
-    flag |= scene->ed->cache_flag & SEQ_CACHE_STORE_FINAL_OUT;
-  }
-  else {
-    flag = scene->ed->cache_flag;
-  }
+  int flag = seq_cache_get_stored_types(scene, seq);
 
   if (cost > SEQ_CACHE_COST_MAX) {
     cost = SEQ_CACHE_COST_MAX;
@@ -715,6 +1333,15 @@ void BKE_sequencer_cache_put(
   }
 
   seq_cache_unlock(scene);
+
+  if ((flag & type) && seq_disk_cache_is_enabled(context, seq, type)) {
+    char path[FILE_MAX];
+
+    if (seq_disk_cache_get_path(context, seq, cfra, type, path) &&
+        !seq_disk_cache_has_file(path)) {
+      seq_disk_cache_write_file(path, i);
+    }
+  }
 }
 
 void BKE_sequencer_cache_iterate(
@@ -2170,6 +2170,8 @@ static void do_wipe_effect_byte(Sequence *seq,
                                 float UNUSED(facf1),
                                 int x,
                                 int y,
+                                int start_line,
+                                int total_lines,
                                 unsigned char *rect1,
                                 unsigned char *rect2,
                                 unsigned char *out)
@@ -2186,8 +2188,8 @@ static void do_wipe_effect_byte(Sequence *seq,
   rt = out;
 
   xo = x;
-  yo = y;
-  for (y = 0; y < yo; y++) {
+  yo = start_line + total_lines;
+  for (y = start_line; y < yo; y++) {
     for (x = 0; x < xo; x++) {
       float check = check_zone(&wipezone, x, y, seq, facf0);
       if (check) {
@@ -2242,6 +2244,8 @@ static void do_wipe_effect_float(Sequence *seq,
                                  float UNUSED(facf1),
                                  int x,
                                  int y,
+                                 int start_line,
+                                 int total_lines,
                                  float *rect1,
                                  float *rect2,
                                  float *out)
@@ -2258,8 +2262,8 @@ static void do_wipe_effect_float(Sequence *seq,
   rt = out;
 
   xo = x;
-  yo = y;
-  for (y = 0; y < yo; y++) {
+  yo = start_line + total_lines;
+  for (y = start_line; y < yo; y++) {
     for (x = 0; x < xo; x++) {
       float check = check_zone(&wipezone, x, y, seq, facf0);
       if (check) {
@@ -2302,39 +2306,52 @@ static void do_wipe_effect_float(Sequence *seq,
   }
 }
 
-static ImBuf *do_wipe_effect(const SeqRenderData *context,
-                             Sequence *seq,
-                             float UNUSED(cfra),
-                             float facf0,
-                             float facf1,
-                             ImBuf *ibuf1,
-                             ImBuf *ibuf2,
-                             ImBuf *ibuf3)
+static void do_wipe_effect(const SeqRenderData *context,
+                           Sequence *seq,
+                           float UNUSED(cfra),
+                           float facf0,
+                           float facf1,
+                           ImBuf *ibuf1,
+                           ImBuf *ibuf2,
+                           ImBuf *UNUSED(ibuf3),
+                           int start_line,
+                           int total_lines,
+                           ImBuf *out)
 {
-  ImBuf *out = prepare_effect_imbufs(context, ibuf1, ibuf2, ibuf3);
-
   if (out->rect_float) {
+    float *rect1 = NULL, *rect2 = NULL, *rect_out = NULL;
+
+    slice_get_float_buffers(
+        context, ibuf1, ibuf2, NULL, out, start_line, &rect1, &rect2, NULL, &rect_out);
+
     do_wipe_effect_float(seq,
                          facf0,
                          facf1,
                          context->rectx,
                          context->recty,
-                         ibuf1->rect_float,
-                         ibuf2->rect_float,
-                         out->rect_float);
+                         start_line,
+                         total_lines,
+                         rect1,
+                         rect2,
+                         rect_out);
   }
   else {
+    unsigned char *rect1 = NULL, *rect2 = NULL, *rect_out = NULL;
+
+    slice_get_byte_buffers(
+        context, ibuf1, ibuf2, NULL, out, start_line, &rect1, &rect2, NULL, &rect_out);
+
     do_wipe_effect_byte(seq,
                         facf0,
                         facf1,
                         context->rectx,
                         context->recty,
-                        (unsigned char *)ibuf1->rect,
-                        (unsigned char *)ibuf2->rect,
-                        (unsigned char *)out->rect);
+                        start_line,
+                        total_lines,
+                        rect1,
+                        rect2,
+                        rect_out);
   }
-
-  return out;
 }
 
 /*********************** Transform *************************/
@@ -2384,6 +2401,8 @@ static void copy_transform_effect(Sequence *dst, Sequence *src, const int UNUSED
 
 static void transform_image(int x,
                             int y,
+                            int start_line,
+                            int total_lines,
                             ImBuf *ibuf1,
                             ImBuf *out,
                             float scale_x,
@@ -2404,7 +2423,7 @@ static void transform_image(int x,
   s = sinf(rotate);
   c = cosf(rotate);
 
-  for (yi = 0; yi < yo; yi++) {
+  for (yi = start_line; yi < start_line + total_lines; yi++) {
     for (xi = 0; xi < xo; xi++) {
       /* translate point */
       xt = xi - translate_x;
@@ -2438,8 +2457,15 @@ static void transform_image(int x,
   }
 }
 
-static void do_transform(
-    Scene *scene, Sequence *seq, float UNUSED(facf0), int x, int y, ImBuf *ibuf1, ImBuf *out)
+static void do_transform(Scene *scene,
+                         Sequence *seq,
+                         float UNUSED(facf0),
+                         int x,
+                         int y,
+                         int start_line,
+                         int total_lines,
+                         ImBuf *ibuf1,
+                         ImBuf *out)
 {
   TransformVars *transform = (TransformVars *)seq->effectdata;
   float scale_x, scale_y, translate_x, translate_y, rotate_radians;
@@ -2470,6 +2496,8 @@ static void do_transform(
 
   transform_image(x,
                   y,
+                  start_line,
+                  total_lines,
                   ibuf1,
                   out,
                   scale_x,
@@ -2480,20 +2508,27 @@ static void do_transform(
                   transform->interpolation);
 }
 
-static ImBuf *do_transform_effect(const SeqRenderData *context,
-                                  Sequence *seq,
-                                  float UNUSED(cfra),
-                                  float facf0,
-                                  float UNUSED(facf1),
-                                  ImBuf *ibuf1,
-                                  ImBuf *ibuf2,
-                                  ImBuf *ibuf3)
+static void do_transform_effect(const SeqRenderData *context,
+                                Sequence *seq,
+                                float UNUSED(cfra),
+                                float facf0,
+                                float UNUSED(facf1),
+                                ImBuf *ibuf1,
+                                ImBuf *UNUSED(ibuf2),
+                                ImBuf *UNUSED(ibuf3),
+                                int start_line,
+                                int total_lines,
+                                ImBuf *out)
 {
-  ImBuf *out = prepare_effect_imbufs(context, ibuf1, ibuf2, ibuf3);
-
-  do_transform(context->scene, seq, facf0, context->rectx, context->recty, ibuf1, out);
-
-  return out;
+  do_transform(context->scene,
+               seq,
+               facf0,
+               context->rectx,
+               context->recty,
+               start_line,
+               total_lines,
+               ibuf1,
+               out);
 }
 
 /*********************** Glow *************************/
@@ -4173,13 +4208,14 @@ static struct SeqEffectHandle get_sequence_effect_impl(int seq_type)
       rval.execute_slice = do_alphaunder_effect;
       break;
     case SEQ_TYPE_WIPE:
+      rval.multithreaded = true;
       rval.init = init_wipe_effect;
       rval.num_inputs = num_inputs_wipe;
       rval.free = free_wipe_effect;
       rval.copy = copy_wipe_effect;
       rval.early_out = early_out_fade;
       rval.get_default_fac = get_default_fac_fade;
-      rval.execute = do_wipe_effect;
+      rval.execute_slice = do_wipe_effect;
       break;
     case SEQ_TYPE_GLOW:
       rval.init = init_glow_effect;
@@ -4189,11 +4225,12 @@ static struct SeqEffectHandle get_sequence_effect_impl(int seq_type)
       rval.execute = do_glow_effect;
       break;
     case SEQ_TYPE_TRANSFORM:
+      rval.multithreaded = true;
       rval.init = init_transform_effect;
       rval.num_inputs = num_inputs_transform;
       rval.free = free_transform_effect;
       rval.copy = copy_transform_effect;
-      rval.execute = do_transform_effect;
+      rval.execute_slice = do_transform_effect;
       break;
     case SEQ_TYPE_SPEED:
       rval.init = init_speed_effect;
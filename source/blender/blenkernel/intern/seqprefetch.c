@@ -406,7 +406,11 @@ static PrefetchJob *seq_prefetch_start(const SeqRenderData *context, float cfra)
       seq_prefetch_init_depsgraph(pfjob);
     }
   }
-  seq_prefetch_update_scene(context->scene);
+  else {
+    /* Depsgraph of a new job is already up to date, only rebuild it for a
+     * job which is restarted after the scene might have changed. */
+    seq_prefetch_update_scene(context->scene);
+  }
   seq_prefetch_update_context(context);
 
   pfjob->cfra = cfra;
@@ -2235,6 +2235,13 @@ void BKE_sequencer_proxy_rebuild(SeqIndexBuildContext *context,
   }
 }
 
+/* Movie proxies are built from their own decoder and encoders, so several can be built at once.
+ * Other strips render through the sequencer, one at a time. */
+bool BKE_sequencer_proxy_rebuild_is_threadsafe(const SeqIndexBuildContext *context)
+{
+  return context->seq->type == SEQ_TYPE_MOVIE && context->index_context != NULL;
+}
+
 void BKE_sequencer_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop)
 {
   if (context->index_context) {
@@ -5190,6 +5197,36 @@ static size_t sequencer_rna_path_prefix(char str[SEQ_RNAPATH_MAXSTR], const char
       str, SEQ_RNAPATH_MAXSTR, "sequence_editor.sequences_all[\"%s\"]", name_esc);
 }
 
+/* Check whether any F-Curve or driver of the scene animates the strip or its modifiers. */
+bool BKE_sequencer_has_animdata(Scene *scene, Sequence *seq)
+{
+  char str[SEQ_RNAPATH_MAXSTR];
+  size_t str_len;
+  FCurve *fcu;
+
+  if (scene->adt == NULL) {
+    return false;
+  }
+
+  str_len = sequencer_rna_path_prefix(str, seq->name + 2);
+
+  if (scene->adt->action) {
+    for (fcu = scene->adt->action->curves.first; fcu; fcu = fcu->next) {
+      if (STREQLEN(fcu->rna_path, str, str_len)) {
+        return true;
+      }
+    }
+  }
+
+  for (fcu = scene->adt->drivers.first; fcu; fcu = fcu->next) {
+    if (STREQLEN(fcu->rna_path, str, str_len)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /* XXX - hackish function needed for transforming strips! TODO - have some better solution */
 void BKE_sequencer_offset_animdata(Scene *scene, Sequence *seq, int ofs)
 {
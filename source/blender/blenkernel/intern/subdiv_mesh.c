@@ -471,8 +471,8 @@ static void subdiv_accumulate_vertex_normal_and_displacement(SubdivMeshContext *
 {
   Subdiv *subdiv = ctx->subdiv;
   const int subdiv_vertex_index = subdiv_vert - ctx->subdiv_mesh->mvert;
-  float dummy_P[3], dPdu[3], dPdv[3], D[3];
-  BKE_subdiv_eval_limit_point_and_derivatives(subdiv, ptex_face_index, u, v, dummy_P, dPdu, dPdv);
+  float P[3], dPdu[3], dPdv[3], D[3];
+  BKE_subdiv_eval_limit_point_and_derivatives(subdiv, ptex_face_index, u, v, P, dPdu, dPdv);
   /* Accumulate normal. */
   if (ctx->can_evaluate_normals) {
     float N[3];
@@ -487,6 +487,11 @@ static void subdiv_accumulate_vertex_normal_and_displacement(SubdivMeshContext *
     BKE_subdiv_eval_displacement(subdiv, ptex_face_index, u, v, dPdu, dPdv, D);
     add_v3_v3(subdiv_vert->co, D);
   }
+  else {
+    /* The limit point is the same from all faces, store it so the vertex evaluation does not
+     * need to evaluate it again. */
+    copy_v3_v3(subdiv_vert->co, P);
+  }
   ++ctx->accumulated_counters[subdiv_vertex_index];
 }
 
@@ -558,18 +563,20 @@ static void evaluate_vertex_and_apply_displacement_copy(const SubdivMeshContext
 {
   const int subdiv_vertex_index = subdiv_vert - ctx->subdiv_mesh->mvert;
   const float inv_num_accumulated = 1.0f / ctx->accumulated_counters[subdiv_vertex_index];
-  /* Displacement is accumulated in subdiv vertex position.
-   * Needs to be backed up before copying data from original vertex. */
-  float D[3] = {0.0f, 0.0f, 0.0f};
-  if (ctx->have_displacement) {
-    copy_v3_v3(D, subdiv_vert->co);
-    mul_v3_fl(D, inv_num_accumulated);
-  }
+  /* Displacement, or the limit point when there is no displacement, is accumulated in subdiv
+   * vertex position. Needs to be backed up before copying data from original vertex. */
+  float accumulated_co[3];
+  copy_v3_v3(accumulated_co, subdiv_vert->co);
   /* Copy custom data and evaluate position. */
   subdiv_vertex_data_copy(ctx, coarse_vert, subdiv_vert);
-  BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
-  /* Apply displacement. */
-  add_v3_v3(subdiv_vert->co, D);
+  if (ctx->have_displacement) {
+    BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+    /* Apply displacement. */
+    madd_v3_v3fl(subdiv_vert->co, accumulated_co, inv_num_accumulated);
+  }
+  else {
+    copy_v3_v3(subdiv_vert->co, accumulated_co);
+  }
   /* Copy normal from accumulated storage. */
   if (ctx->can_evaluate_normals) {
     float N[3];
@@ -591,18 +598,20 @@ static void evaluate_vertex_and_apply_displacement_interpolate(
 {
   const int subdiv_vertex_index = subdiv_vert - ctx->subdiv_mesh->mvert;
   const float inv_num_accumulated = 1.0f / ctx->accumulated_counters[subdiv_vertex_index];
-  /* Displacement is accumulated in subdiv vertex position.
-   * Needs to be backed up before copying data from original vertex. */
-  float D[3] = {0.0f, 0.0f, 0.0f};
-  if (ctx->have_displacement) {
-    copy_v3_v3(D, subdiv_vert->co);
-    mul_v3_fl(D, inv_num_accumulated);
-  }
+  /* Displacement, or the limit point when there is no displacement, is accumulated in subdiv
+   * vertex position. Needs to be backed up before copying data from original vertex. */
+  float accumulated_co[3];
+  copy_v3_v3(accumulated_co, subdiv_vert->co);
   /* Interpolate custom data and evaluate position. */
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, vertex_interpolation, u, v);
-  BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
-  /* Apply displacement. */
-  add_v3_v3(subdiv_vert->co, D);
+  if (ctx->have_displacement) {
+    BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+    /* Apply displacement. */
+    madd_v3_v3fl(subdiv_vert->co, accumulated_co, inv_num_accumulated);
+  }
+  else {
+    copy_v3_v3(subdiv_vert->co, accumulated_co);
+  }
   /* Copy normal from accumulated storage. */
   if (ctx->can_evaluate_normals) {
     float N[3];
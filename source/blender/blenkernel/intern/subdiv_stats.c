@@ -25,8 +25,22 @@
 
 #include <stdio.h>
 
+#include "BLI_trace.h"
+
 #include "PIL_time.h"
 
+/* Names of the values in the trace, in order of #eSubdivStatsValue. */
+static const char *subdiv_stats_value_names[NUM_SUBDIV_STATS_VALUES] = {
+    "Subdiv Topology Refiner",
+    "Subdiv To Mesh",
+    "Subdiv To Mesh Geometry",
+    "Subdiv Evaluator Create",
+    "Subdiv Evaluator Refine",
+    "Subdiv To CCG",
+    "Subdiv To CCG Elements",
+    "Subdiv Topology Compare",
+};
+
 void BKE_subdiv_stats_init(SubdivStats *stats)
 {
   stats->topology_refiner_creation_time = 0.0;
@@ -46,7 +60,10 @@ void BKE_subdiv_stats_begin(SubdivStats *stats, eSubdivStatsValue value)
 
 void BKE_subdiv_stats_end(SubdivStats *stats, eSubdivStatsValue value)
 {
-  stats->values_[value] = PIL_check_seconds_timer() - stats->begin_timestamp_[value];
+  const double end_timestamp = PIL_check_seconds_timer();
+  stats->values_[value] = end_timestamp - stats->begin_timestamp_[value];
+  BLI_trace_zone_add(
+      subdiv_stats_value_names[value], stats->begin_timestamp_[value], end_timestamp);
 }
 
 void BKE_subdiv_stats_reset(SubdivStats *stats, eSubdivStatsValue value)
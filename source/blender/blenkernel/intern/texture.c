@@ -30,6 +30,7 @@
 
 #include "BLI_math.h"
 #include "BLI_kdopbvh.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "BLI_math_color.h"
 
@@ -645,19 +646,13 @@ bool BKE_texture_dependsOnTime(const struct Tex *texture)
 
 /* ------------------------------------------------------------------------- */
 
-void BKE_texture_get_value_ex(const Scene *scene,
-                              Tex *texture,
-                              float *tex_co,
-                              TexResult *texres,
-                              struct ImagePool *pool,
-                              bool use_color_management)
+static void texture_get_value_intern(Tex *texture,
+                                     float *tex_co,
+                                     TexResult *texres,
+                                     struct ImagePool *pool,
+                                     const bool do_color_manage)
 {
   int result_type;
-  bool do_color_manage = false;
-
-  if (scene && use_color_management) {
-    do_color_manage = BKE_scene_check_color_management_enabled(scene);
-  }
 
   /* no node textures for now */
   result_type = multitex_ext_safe(texture, tex_co, texres, pool, do_color_manage, false);
@@ -674,12 +669,89 @@ void BKE_texture_get_value_ex(const Scene *scene,
   }
 }
 
+void BKE_texture_get_value_ex(const Scene *scene,
+                              Tex *texture,
+                              float *tex_co,
+                              TexResult *texres,
+                              struct ImagePool *pool,
+                              bool use_color_management)
+{
+  bool do_color_manage = false;
+
+  if (scene && use_color_management) {
+    do_color_manage = BKE_scene_check_color_management_enabled(scene);
+  }
+
+  texture_get_value_intern(texture, tex_co, texres, pool, do_color_manage);
+}
+
 void BKE_texture_get_value(
     const Scene *scene, Tex *texture, float *tex_co, TexResult *texres, bool use_color_management)
 {
   BKE_texture_get_value_ex(scene, texture, tex_co, texres, NULL, use_color_management);
 }
 
+typedef struct TextureGetValuesData {
+  Tex *texture;
+  const float (*tex_co)[3];
+  TexResult *texres;
+  struct ImagePool *pool;
+  bool do_color_manage;
+} TextureGetValuesData;
+
+static void texture_get_values_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TextureGetValuesData *data = userdata;
+  TexResult *texres = &data->texres[i];
+
+  texres->nor = NULL;
+  texture_get_value_intern(
+      data->texture, (float *)data->tex_co[i], texres, data->pool, data->do_color_manage);
+}
+
+/**
+ * Evaluate \a texture at all \a tex_co_len coordinates, like #BKE_texture_get_value would one
+ * by one. Big arrays are evaluated in parallel, image textures then use an image pool so they
+ * can be sampled from multiple threads.
+ *
+ * \param r_texres: Array of \a tex_co_len results, normals are not computed.
+ */
+void BKE_texture_get_values(const Scene *scene,
+                            Tex *texture,
+                            const float (*tex_co)[3],
+                            const int tex_co_len,
+                            TexResult *r_texres,
+                            bool use_color_management)
+{
+  TextureGetValuesData data = {
+      .texture = texture,
+      .tex_co = tex_co,
+      .texres = r_texres,
+      .pool = NULL,
+      .do_color_manage = scene && use_color_management &&
+                         BKE_scene_check_color_management_enabled(scene),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* The noise texture draws from the random numbers of one render thread. */
+  settings.use_threading = (tex_co_len > 512) && (texture->type != TEX_NOISE);
+
+  /* Node textures are not evaluated here, only image textures sample images. */
+  if (settings.use_threading && BKE_texture_is_image_user(texture)) {
+    data.pool = BKE_image_pool_new();
+    BKE_texture_fetch_images_for_pool(texture, data.pool);
+  }
+
+  BLI_task_parallel_range(0, tex_co_len, &data, texture_get_values_cb, &settings);
+
+  if (data.pool != NULL) {
+    BKE_image_pool_free(data.pool);
+  }
+}
+
 static void texture_nodes_fetch_images_for_pool(Tex *texture,
                                                 bNodeTree *ntree,
                                                 struct ImagePool *pool)
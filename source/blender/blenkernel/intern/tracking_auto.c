@@ -80,6 +80,9 @@ typedef struct AutoTrackContext {
   bool first_sync;
   SpinLock spin_lock;
 
+  /* Loads the frame after the one being tracked to while tracking happens. */
+  TaskPool *prefetch_pool;
+
   bool step_ok;
 } AutoTrackContext;
 
@@ -372,9 +375,19 @@ AutoTrackContext *BKE_autotrack_context_new(MovieClip *clip,
   fill_autotrack_tracks(frame_width, frame_height, tracksbase, backwards, context->autotrack);
   /* Create per-track tracking options. */
   create_per_track_tracking_options(clip, user, tracksbase, context);
+  context->prefetch_pool = BLI_task_pool_create(BLI_task_scheduler_get(), context);
   return context;
 }
 
+static void autotrack_context_prefetch_cb(TaskPool *__restrict pool,
+                                          void *taskdata,
+                                          int UNUSED(threadid))
+{
+  AutoTrackContext *context = BLI_task_pool_userdata(pool);
+  const int frame = POINTER_AS_INT(taskdata);
+  tracking_image_accessor_prefetch(context->image_accessor, 0, frame);
+}
+
 static void autotrack_context_step_cb(void *__restrict userdata,
                                       const int track,
                                       const TaskParallelTLS *__restrict UNUSED(tls))
@@ -444,8 +457,22 @@ static void autotrack_context_step_cb(void *__restrict userdata,
 bool BKE_autotrack_context_step(AutoTrackContext *context)
 {
   const int frame_delta = context->backwards ? -1 : 1;
+  const int frame = BKE_movieclip_remap_scene_to_clip_frame(context->clips[0],
+                                                            context->user.framenr);
   context->step_ok = false;
 
+  /* Decode the frame being tracked to once, instead of having every track wait for it.
+   * Meanwhile the frame after it is loaded in the background, for the next step. */
+  BLI_task_pool_work_and_wait(context->prefetch_pool);
+  tracking_image_accessor_prefetch(context->image_accessor, 0, frame + frame_delta);
+  if (context->sequence) {
+    BLI_task_pool_push(context->prefetch_pool,
+                       autotrack_context_prefetch_cb,
+                       POINTER_FROM_INT(frame + 2 * frame_delta),
+                       false,
+                       TASK_PRIORITY_LOW);
+  }
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (context->num_tracks > 1);
@@ -546,6 +573,8 @@ void BKE_autotrack_context_finish(AutoTrackContext *context)
 
 void BKE_autotrack_context_free(AutoTrackContext *context)
 {
+  BLI_task_pool_work_and_wait(context->prefetch_pool);
+  BLI_task_pool_free(context->prefetch_pool);
   libmv_autoTrackDestroy(context->autotrack);
   tracking_image_accessor_destroy(context->image_accessor);
   MEM_freeN(context->options);
@@ -648,6 +648,25 @@ static ImBuf *accesscache_get(TrackingImageAccessor *accessor,
   return IMB_moviecache_get(accessor->cache, &key);
 }
 
+static ImBuf *accessor_get_prefetched_ibuf(TrackingImageAccessor *accessor,
+                                           int clip_index,
+                                           int frame)
+{
+  ImBuf *ibuf = NULL;
+  BLI_spin_lock(&accessor->cache_lock);
+  for (int i = 0; i < MAX_ACCESSOR_PREFETCH; i++) {
+    TrackingPrefetchedFrame *prefetched = &accessor->prefetched[i];
+    if (prefetched->ibuf != NULL && prefetched->clip_index == clip_index &&
+        prefetched->frame == frame) {
+      ibuf = prefetched->ibuf;
+      IMB_refImBuf(ibuf);
+      break;
+    }
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+  return ibuf;
+}
+
 static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
                                              int clip_index,
                                              int frame)
@@ -659,6 +678,13 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
 
   BLI_assert(clip_index < accessor->num_clips);
 
+  /* Prefetched frames are used without going through the clip, so tracks reading the same
+   * frame don't all wait for the movie clip lock. */
+  ibuf = accessor_get_prefetched_ibuf(accessor, clip_index, frame);
+  if (ibuf != NULL) {
+    return ibuf;
+  }
+
   clip = accessor->clips[clip_index];
   scene_frame = BKE_movieclip_remap_clip_to_scene_frame(clip, frame);
   BKE_movieclip_user_set_frame(&user, scene_frame);
@@ -994,8 +1020,42 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
 
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor)
 {
+  for (int i = 0; i < MAX_ACCESSOR_PREFETCH; i++) {
+    if (accessor->prefetched[i].ibuf != NULL) {
+      IMB_freeImBuf(accessor->prefetched[i].ibuf);
+    }
+  }
   IMB_moviecache_free(accessor->cache);
   libmv_FrameAccessorDestroy(accessor->libmv_accessor);
   BLI_spin_end(&accessor->cache_lock);
   MEM_freeN(accessor);
 }
+
+/* Load original frame and keep it referenced until MAX_ACCESSOR_PREFETCH other frames are
+ * prefetched. Can be called from a thread while tracking happens. */
+void tracking_image_accessor_prefetch(TrackingImageAccessor *accessor, int clip_index, int frame)
+{
+  ImBuf *ibuf = accessor_get_prefetched_ibuf(accessor, clip_index, frame);
+  if (ibuf != NULL) {
+    IMB_freeImBuf(ibuf);
+    return;
+  }
+
+  ibuf = accessor_get_preprocessed_ibuf(accessor, clip_index, frame);
+  if (ibuf == NULL) {
+    return;
+  }
+
+  BLI_spin_lock(&accessor->cache_lock);
+  TrackingPrefetchedFrame *prefetched = &accessor->prefetched[accessor->prefetch_next];
+  ImBuf *old_ibuf = prefetched->ibuf;
+  prefetched->clip_index = clip_index;
+  prefetched->frame = frame;
+  prefetched->ibuf = ibuf;
+  accessor->prefetch_next = (accessor->prefetch_next + 1) % MAX_ACCESSOR_PREFETCH;
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  if (old_ibuf != NULL) {
+    IMB_freeImBuf(old_ibuf);
+  }
+}
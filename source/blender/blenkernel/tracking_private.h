@@ -127,6 +127,15 @@ float *tracking_track_get_mask_for_region(int frame_width,
 struct libmv_FrameAccessor;
 
 #define MAX_ACCESSOR_CLIP 64
+#define MAX_ACCESSOR_PREFETCH 4
+
+/* Original frame kept referenced by the accessor, see tracking_image_accessor_prefetch. */
+typedef struct TrackingPrefetchedFrame {
+  int clip_index;
+  int frame;
+  struct ImBuf *ibuf;
+} TrackingPrefetchedFrame;
+
 typedef struct TrackingImageAccessor {
   struct MovieCache *cache;
   struct MovieClip *clips[MAX_ACCESSOR_CLIP];
@@ -136,6 +145,9 @@ typedef struct TrackingImageAccessor {
   int start_frame;
   struct libmv_FrameAccessor *libmv_accessor;
   SpinLock cache_lock;
+  /* Protected by cache_lock. */
+  TrackingPrefetchedFrame prefetched[MAX_ACCESSOR_PREFETCH];
+  int prefetch_next;
 } TrackingImageAccessor;
 
 TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR_CLIP],
@@ -144,5 +156,6 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
                                                    int num_tracks,
                                                    int start_frame);
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor);
+void tracking_image_accessor_prefetch(TrackingImageAccessor *accessor, int clip_index, int frame);
 
 #endif /* __TRACKING_PRIVATE_H__ */
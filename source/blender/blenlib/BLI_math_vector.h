@@ -433,6 +433,9 @@ void minmax_v3v3_v3(float min[3], float max[3], const float vec[3]);
 void minmax_v2v2_v2(float min[2], float max[2], const float vec[2]);
 
 void minmax_v3v3_v3_array(float r_min[3], float r_max[3], const float (*vec_arr)[3], int nbr);
+void normalize_v3_array(float (*vec_arr)[3], int nbr);
+void interp_v3_v3v3_array(
+    float (*r)[3], const float (*a)[3], const float (*b)[3], const float *t, int nbr);
 
 void dist_ensure_v3_v3fl(float v1[3], const float v2[3], const float dist);
 void dist_ensure_v2_v2fl(float v1[2], const float v2[2], const float dist);
@@ -0,0 +1,57 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/** \file
+ * \ingroup bli
+ *
+ * A set of #MemArena, one for each thread using it.
+ *
+ * Meant for scratch memory of algorithms running in many threads at once, which is all
+ * freed at a known point, like the end of a dependency graph evaluation. Allocating is as
+ * cheap as with a #MemArena, since each thread only uses its own arena without locking.
+ *
+ * The arenas may only be cleared or freed when no thread is allocating from them.
+ */
+
+#ifndef __BLI_MEMARENA_THREADED_H__
+#define __BLI_MEMARENA_THREADED_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_sys_types.h"
+
+struct MemArenaThreaded;
+typedef struct MemArenaThreaded MemArenaThreaded;
+
+MemArenaThreaded *BLI_memarena_threaded_new(const char *name) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void BLI_memarena_threaded_free(MemArenaThreaded *arena) ATTR_NONNULL(1);
+void *BLI_memarena_threaded_alloc(MemArenaThreaded *arena, size_t size) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1) ATTR_MALLOC ATTR_ALLOC_SIZE(2);
+void *BLI_memarena_threaded_calloc(MemArenaThreaded *arena, size_t size) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1) ATTR_MALLOC ATTR_ALLOC_SIZE(2);
+void BLI_memarena_threaded_clear(MemArenaThreaded *arena) ATTR_NONNULL(1);
+size_t BLI_memarena_threaded_allocated_size(MemArenaThreaded *arena) ATTR_NONNULL(1);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_MEMARENA_THREADED_H__ */
@@ -58,6 +58,18 @@ void *BLI_mempool_as_arrayN(BLI_mempool *pool,
                             const char *allocstr) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL(1, 2);
 
+/* Allocation from multiple threads, see BLI_mempool.c for usage. */
+typedef struct BLI_mempool_thread_cache BLI_mempool_thread_cache;
+
+BLI_mempool_thread_cache *BLI_mempool_thread_cache_create(BLI_mempool *pool)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void *BLI_mempool_thread_cache_alloc(BLI_mempool_thread_cache *cache) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void *BLI_mempool_thread_cache_calloc(BLI_mempool_thread_cache *cache) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void BLI_mempool_thread_cache_free(BLI_mempool_thread_cache *cache, void *addr) ATTR_NONNULL(1, 2);
+void BLI_mempool_thread_cache_merge(BLI_mempool_thread_cache *cache) ATTR_NONNULL(1);
+
 #ifndef NDEBUG
 void BLI_mempool_set_memory_debug(void);
 #endif
@@ -0,0 +1,94 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __BLI_OPENHASH_H__
+#define __BLI_OPENHASH_H__
+
+/** \file
+ * \ingroup bli
+ * \brief Open addressing hash tables, for hot paths of C code which use #GHash.
+ *
+ * Unlike #GHash (chained buckets allocated from a mempool, hashing and comparing
+ * through function pointers), entries are stored in a single array and
+ * hashing/comparing is inlined for each key type, reducing cache misses for lookups.
+ * The API matches BLI_ghash.h, keys are never freed by the map.
+ *
+ * - #PtrMap: pointer keys.
+ * - #IntMap: integer keys.
+ * - #StrMap: string keys (the strings must stay valid while in the map).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Pointer keys. */
+#define OHASH_PREFIX_ID BLI_ptrmap
+#define OHASH_KEY_TYPE const void *
+#define OHashMap PtrMap
+#define OHashMapEntry PtrMapEntry
+#define OHashMapIterator PtrMapIterator
+#include "BLI_openhash_impl.h"
+#undef OHASH_PREFIX_ID
+#undef OHASH_KEY_TYPE
+#undef OHashMap
+#undef OHashMapEntry
+#undef OHashMapIterator
+
+/* Integer keys. */
+#define OHASH_PREFIX_ID BLI_intmap
+#define OHASH_KEY_TYPE int
+#define OHashMap IntMap
+#define OHashMapEntry IntMapEntry
+#define OHashMapIterator IntMapIterator
+#include "BLI_openhash_impl.h"
+#undef OHASH_PREFIX_ID
+#undef OHASH_KEY_TYPE
+#undef OHashMap
+#undef OHashMapEntry
+#undef OHashMapIterator
+
+/* String keys. */
+#define OHASH_PREFIX_ID BLI_strmap
+#define OHASH_KEY_TYPE const char *
+#define OHASH_STORE_HASH
+#define OHashMap StrMap
+#define OHashMapEntry StrMapEntry
+#define OHashMapIterator StrMapIterator
+#include "BLI_openhash_impl.h"
+#undef OHASH_PREFIX_ID
+#undef OHASH_KEY_TYPE
+#undef OHASH_STORE_HASH
+#undef OHashMap
+#undef OHashMapEntry
+#undef OHashMapIterator
+
+#define PTRMAP_ITER(iter_, map_) \
+  for (BLI_ptrmap_iter_init(&iter_, map_); BLI_ptrmap_iter_done(&iter_) == false; \
+       BLI_ptrmap_iter_step(&iter_))
+#define INTMAP_ITER(iter_, map_) \
+  for (BLI_intmap_iter_init(&iter_, map_); BLI_intmap_iter_done(&iter_) == false; \
+       BLI_intmap_iter_step(&iter_))
+#define STRMAP_ITER(iter_, map_) \
+  for (BLI_strmap_iter_init(&iter_, map_); BLI_strmap_iter_done(&iter_) == false; \
+       BLI_strmap_iter_step(&iter_))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_OPENHASH_H__ */
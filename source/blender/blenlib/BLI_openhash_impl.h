@@ -0,0 +1,112 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/** \file
+ * \ingroup bli
+ * \brief Open addressing hash table, type specialized version of #GHash.
+ *
+ * Included by BLI_openhash.h once per key type, with these defines set:
+ * - #OHASH_PREFIX_ID: prefix of the functions.
+ * - #OHASH_KEY_TYPE: type of the keys.
+ * - #OHashMap, #OHashMapEntry, #OHashMapIterator: names of the types.
+ * - #OHASH_STORE_HASH: optionally keep the hash of each key in its entry.
+ */
+
+#include "BLI_compiler_attrs.h"
+
+#define _BLI_CONCAT_AUX(MACRO_ARG1, MACRO_ARG2) MACRO_ARG1##MACRO_ARG2
+#define _BLI_CONCAT(MACRO_ARG1, MACRO_ARG2) _BLI_CONCAT_AUX(MACRO_ARG1, MACRO_ARG2)
+#define BLI_ohash_nd_(id) _BLI_CONCAT(OHASH_PREFIX_ID, _##id)
+
+#ifndef __BLI_OPENHASH_FREEFP__
+#  define __BLI_OPENHASH_FREEFP__
+typedef void (*OHashFreeFP)(void *value);
+#endif
+
+struct OHashMap;
+typedef struct OHashMap OHashMap;
+
+typedef struct OHashMapEntry {
+  OHASH_KEY_TYPE key;
+  void *value;
+#ifdef OHASH_STORE_HASH
+  unsigned int hash;
+#endif
+} OHashMapEntry;
+
+typedef struct OHashMapIterator {
+  OHashMapEntry *entries;
+  unsigned int length;
+  unsigned int index;
+} OHashMapIterator;
+
+OHashMap *BLI_ohash_nd_(new_ex)(const char *info, const unsigned int nentries_reserve)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+OHashMap *BLI_ohash_nd_(new)(const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+void BLI_ohash_nd_(free)(OHashMap *map, OHashFreeFP valfreefp) ATTR_NONNULL(1);
+void BLI_ohash_nd_(reserve)(OHashMap *map, const unsigned int nentries_reserve) ATTR_NONNULL(1);
+void BLI_ohash_nd_(insert)(OHashMap *map, OHASH_KEY_TYPE key, void *val) ATTR_NONNULL(1);
+bool BLI_ohash_nd_(reinsert)(OHashMap *map, OHASH_KEY_TYPE key, void *val) ATTR_NONNULL(1);
+void *BLI_ohash_nd_(lookup)(const OHashMap *map, OHASH_KEY_TYPE key) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void *BLI_ohash_nd_(lookup_default)(const OHashMap *map,
+                                    OHASH_KEY_TYPE key,
+                                    void *val_default) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void **BLI_ohash_nd_(lookup_p)(OHashMap *map, OHASH_KEY_TYPE key) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+bool BLI_ohash_nd_(ensure_p)(OHashMap *map, OHASH_KEY_TYPE key, void ***r_val)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1, 3);
+bool BLI_ohash_nd_(remove)(OHashMap *map, OHASH_KEY_TYPE key, OHashFreeFP valfreefp)
+    ATTR_NONNULL(1);
+void *BLI_ohash_nd_(popkey)(OHashMap *map, OHASH_KEY_TYPE key) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+bool BLI_ohash_nd_(haskey)(const OHashMap *map, OHASH_KEY_TYPE key) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+unsigned int BLI_ohash_nd_(len)(const OHashMap *map) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void BLI_ohash_nd_(clear_ex)(OHashMap *map,
+                             OHashFreeFP valfreefp,
+                             const unsigned int nentries_reserve) ATTR_NONNULL(1);
+void BLI_ohash_nd_(clear)(OHashMap *map, OHashFreeFP valfreefp) ATTR_NONNULL(1);
+
+/* Iteration follows the order of insertion, as long as no keys are removed.
+ * The map must not be modified while iterating, except for the values. */
+void BLI_ohash_nd_(iter_init)(OHashMapIterator *iter, OHashMap *map) ATTR_NONNULL(1, 2);
+
+BLI_INLINE void BLI_ohash_nd_(iter_step)(OHashMapIterator *iter)
+{
+  iter->index++;
+}
+BLI_INLINE bool BLI_ohash_nd_(iter_done)(const OHashMapIterator *iter)
+{
+  return iter->index >= iter->length;
+}
+BLI_INLINE OHASH_KEY_TYPE BLI_ohash_nd_(iter_key)(const OHashMapIterator *iter)
+{
+  return iter->entries[iter->index].key;
+}
+BLI_INLINE void *BLI_ohash_nd_(iter_value)(const OHashMapIterator *iter)
+{
+  return iter->entries[iter->index].value;
+}
+BLI_INLINE void **BLI_ohash_nd_(iter_value_p)(OHashMapIterator *iter)
+{
+  return &iter->entries[iter->index].value;
+}
+
+#undef _BLI_CONCAT_AUX
+#undef _BLI_CONCAT
+#undef BLI_ohash_nd_
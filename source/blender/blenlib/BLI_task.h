@@ -36,8 +36,10 @@ struct BLI_mempool;
 
 /* Task Scheduler
  *
- * Central scheduler that holds running threads ready to execute tasks. A single
- * queue holds the task from all pools.
+ * Central scheduler that holds running threads ready to execute tasks. A global
+ * queue holds the tasks pushed from outside of the scheduler threads, tasks pushed
+ * from within other tasks go to a work-stealing deque of the pushing thread, from
+ * where idle threads steal them.
  *
  * Init/exit must be called before/after any task pools are created/freed, and
  * must be called from the main threads. All other scheduler and pool functions
@@ -67,6 +69,12 @@ int BLI_task_scheduler_num_threads(TaskScheduler *scheduler);
  * pool with smaller tasks. When other threads are busy they will continue
  * working on their own tasks, if not they will join in, no new threads will
  * be launched.
+ *
+ * A pool created from within a running task is nested into the pool of that
+ * task. When the thread waiting for the nested pool runs out of its tasks, it
+ * executes tasks of the parent pool instead of sleeping. This means a task
+ * calling BLI_task_pool_work_and_wait() must not hold locks which other tasks
+ * of its own pool might need.
  */
 
 typedef enum TaskPriority {
@@ -153,6 +161,10 @@ typedef struct TaskParallelTLS {
 typedef void (*TaskParallelFinalizeFunc)(void *__restrict userdata,
                                          void *__restrict userdata_chunk);
 
+typedef void (*TaskParallelReduceFunc)(const void *__restrict userdata,
+                                       void *__restrict chunk_join,
+                                       void *__restrict chunk);
+
 typedef void (*TaskParallelRangeFunc)(void *__restrict userdata,
                                       const int iter,
                                       const TaskParallelTLS *__restrict tls);
@@ -176,6 +188,13 @@ typedef struct TaskParallelSettings {
    * processed.
    */
   TaskParallelFinalizeFunc func_finalize;
+  /* Function called from calling thread once whole range have been
+   * processed, to join every thread's chunk into the original userdata_chunk
+   * memory. This requires the initial content of userdata_chunk to be the
+   * identity of the reduction (zero for sums, FLT_MAX for minimum, etc.).
+   * Called before func_finalize of the same chunk.
+   */
+  TaskParallelReduceFunc func_reduce;
   /* Minimum allowed number of range iterators to be handled by a single
    * thread. This allows to achieve following:
    * - Reduce amount of threading overhead.
@@ -209,6 +228,25 @@ void BLI_task_parallel_range_pool_push(struct TaskParallelRangePool *range_pool,
 void BLI_task_parallel_range_pool_work_and_wait(struct TaskParallelRangePool *range_pool);
 void BLI_task_parallel_range_pool_free(struct TaskParallelRangePool *range_pool);
 
+/* Parallel scan and compaction.
+ *
+ * Only use_threading and min_iter_per_thread of the settings are used. */
+
+int BLI_task_parallel_prefix_sum_int(const int *src,
+                                     int *dst,
+                                     const int len,
+                                     const bool exclusive,
+                                     const TaskParallelSettings *settings);
+
+typedef bool (*TaskParallelFilterFunc)(void *__restrict userdata, const int iter);
+
+int BLI_task_parallel_filter_indices(const int start,
+                                     const int stop,
+                                     void *userdata,
+                                     TaskParallelFilterFunc func,
+                                     int *r_indices,
+                                     const TaskParallelSettings *settings);
+
 /* This data is shared between all tasks, its access needs thread lock or similar protection.
  */
 typedef struct TaskParallelIteratorStateShared {
@@ -0,0 +1,91 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * Timeline of zones, the begin and end time of a named piece of work on a thread, written as
+ * a Chrome trace file (the JSON trace event format) which can be opened in `chrome://tracing`
+ * or Perfetto. Meant to see how work of different modules interleaves, unlike the statistics
+ * which modules collect for themselves.
+ *
+ * Enabled with the `--debug-trace <file>` command line argument, the file is written on exit.
+ * Every thread records into its own ring buffer without locking, which keeps the last
+ * #BLI_TRACE_EVENTS_PER_THREAD zones of the thread. When tracing is disabled a zone costs a
+ * single check.
+ *
+ * \code{.c}
+ * BLI_TRACE_ZONE_BEGIN(read);
+ * ...
+ * BLI_TRACE_ZONE_END(read, "Read File");
+ * \endcode
+ */
+
+#ifndef __BLI_TRACE_H__
+#define __BLI_TRACE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_compiler_compat.h"
+#include "BLI_sys_types.h"
+
+#include "PIL_time.h"
+
+#define BLI_TRACE_EVENTS_PER_THREAD (1 << 15)
+/* Longer names are truncated. */
+#define BLI_TRACE_NAME_MAX 96
+
+/* Only to be read through #BLI_trace_is_enabled. */
+extern bool bli_trace_enabled;
+
+void BLI_trace_init(const char *filepath) ATTR_NONNULL(1);
+void BLI_trace_exit(void);
+
+/* Add a zone of the calling thread, times are from #PIL_check_seconds_timer. The name is
+ * copied. Does nothing when tracing is disabled. */
+void BLI_trace_zone_add(const char *name, const double start, const double end)
+    ATTR_NONNULL(1);
+
+BLI_INLINE bool BLI_trace_is_enabled(void)
+{
+  return bli_trace_enabled;
+}
+
+/* Start time of a zone, zero when tracing is disabled. */
+BLI_INLINE double BLI_trace_zone_start(void)
+{
+  return bli_trace_enabled ? PIL_check_seconds_timer() : 0.0;
+}
+
+/* End a zone started with #BLI_trace_zone_start. */
+BLI_INLINE void BLI_trace_zone_end(const char *name, const double start)
+{
+  if (start != 0.0) {
+    BLI_trace_zone_add(name, start, PIL_check_seconds_timer());
+  }
+}
+
+#define BLI_TRACE_ZONE_BEGIN(var) const double _trace_zone_##var = BLI_trace_zone_start()
+#define BLI_TRACE_ZONE_END(var, name) BLI_trace_zone_end(name, _trace_zone_##var)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_TRACE_H__ */
@@ -26,6 +26,7 @@
 #define __PIL_TIME_UTILDEFINES_H__
 
 #include "PIL_time.h"        /* for PIL_check_seconds_timer */
+#include "BLI_trace.h"       /* for BLI_trace_zone_end */
 #include "BLI_utildefines.h" /* for AT */
 
 #define TIMEIT_START(var) \
@@ -53,6 +54,7 @@
 
 #define TIMEIT_END(var) \
   } \
+  BLI_trace_zone_end(#var, BLI_trace_is_enabled() ? _timeit_##var : 0.0); \
   printf("time end   (" #var \
          "): %.6f" \
          "  " AT "\n", \
@@ -80,6 +82,7 @@
 
 #define TIMEIT_END_AVERAGED(var) \
   } \
+  BLI_trace_zone_end(#var, BLI_trace_is_enabled() ? _timeit_##var : 0.0); \
   const float _delta_##var = TIMEIT_VALUE(var); \
   _sum_##var += _delta_##var; \
   _num_##var++; \
@@ -47,6 +47,7 @@
 #include "BLI_stack.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_math.h"
+#include "BLI_math_bits.h"
 #include "BLI_task.h"
 #include "BLI_heap_simple.h"
 
@@ -372,33 +373,89 @@ static void create_kdop_hull(
   }
 }
 
+/**
+ * Join \a node_bv into \a bv, only uses min/max so the compiler can keep this branchless.
+ */
+BLI_INLINE void kdop_hull_join(const BVHTree *tree,
+                               float *__restrict bv,
+                               const float *__restrict node_bv)
+{
+  for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    bv[(2 * axis_iter)] = min_ff(node_bv[(2 * axis_iter)], bv[(2 * axis_iter)]);
+    bv[(2 * axis_iter) + 1] = max_ff(node_bv[(2 * axis_iter) + 1], bv[(2 * axis_iter) + 1]);
+  }
+}
+
+/* Number of leafs joined by one task when refitting large ranges. */
+#define KDOPBVH_REFIT_BLOCK_SIZE 4096
+
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+  int start, end;
+} BVHRefitData;
+
+typedef struct BVHRefitChunk {
+  float bv[13 * 2];
+} BVHRefitChunk;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int block,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHRefitData *data = userdata;
+  BVHRefitChunk *chunk = tls->userdata_chunk;
+  const int start = data->start + block * KDOPBVH_REFIT_BLOCK_SIZE;
+  const int end = min_ii(start + KDOPBVH_REFIT_BLOCK_SIZE, data->end);
+
+  for (int j = start; j < end; j++) {
+    kdop_hull_join(data->tree, chunk->bv, data->tree->nodes[j]->bv);
+  }
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const BVHRefitData *data = userdata;
+  kdop_hull_join(data->tree, ((BVHRefitChunk *)chunk_join)->bv, ((BVHRefitChunk *)chunk)->bv);
+}
+
 /**
  * \note depends on the fact that the BVH's for each face is already built
  */
 static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
 {
-  float newmin, newmax;
   float *__restrict bv = node->bv;
-  int j;
-  axis_t axis_iter;
 
   node_minmax_init(tree, node);
 
-  for (j = start; j < end; j++) {
-    float *__restrict node_bv = tree->nodes[j]->bv;
-
-    /* for all Axes. */
-    for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
-      newmin = node_bv[(2 * axis_iter)];
-      if ((newmin < bv[(2 * axis_iter)])) {
-        bv[(2 * axis_iter)] = newmin;
-      }
+  /* The top levels of the tree contain most or all leafs,
+   * join those in parallel so they don't make building the tree single threaded. */
+  if (end - start > KDOPBVH_REFIT_BLOCK_SIZE * 2) {
+    BVHRefitData data = {.tree = tree, .start = start, .end = end};
+    /* Start as empty bounds, like the node after #node_minmax_init. */
+    BVHRefitChunk chunk = {{0.0f}};
+    for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+      chunk.bv[(2 * axis_iter)] = FLT_MAX;
+      chunk.bv[(2 * axis_iter) + 1] = -FLT_MAX;
+    }
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.userdata_chunk = &chunk;
+    settings.userdata_chunk_size = sizeof(chunk);
+    settings.func_reduce = refit_kdop_hull_reduce;
+    settings.min_iter_per_thread = 1;
+    const int num_blocks = (end - start + KDOPBVH_REFIT_BLOCK_SIZE - 1) /
+                           KDOPBVH_REFIT_BLOCK_SIZE;
+    BLI_task_parallel_range(0, num_blocks, &data, refit_kdop_hull_task_cb, &settings);
+
+    kdop_hull_join(tree, bv, chunk.bv);
+    return;
+  }
 
-      newmax = node_bv[(2 * axis_iter) + 1];
-      if ((newmax > bv[(2 * axis_iter) + 1])) {
-        bv[(2 * axis_iter) + 1] = newmax;
-      }
-    }
+  for (int j = start; j < end; j++) {
+    kdop_hull_join(tree, bv, tree->nodes[j]->bv);
   }
 }
 
@@ -436,23 +493,12 @@ static char get_largest_axis(const float *bv)
 static void node_join(BVHTree *tree, BVHNode *node)
 {
   int i;
-  axis_t axis_iter;
 
   node_minmax_init(tree, node);
 
   for (i = 0; i < tree->tree_type; i++) {
     if (node->children[i]) {
-      for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
-        /* update minimum */
-        if (node->children[i]->bv[(2 * axis_iter)] < node->bv[(2 * axis_iter)]) {
-          node->bv[(2 * axis_iter)] = node->children[i]->bv[(2 * axis_iter)];
-        }
-
-        /* update maximum */
-        if (node->children[i]->bv[(2 * axis_iter) + 1] > node->bv[(2 * axis_iter) + 1]) {
-          node->bv[(2 * axis_iter) + 1] = node->children[i]->bv[(2 * axis_iter) + 1];
-        }
-      }
+      kdop_hull_join(tree, node->bv, node->children[i]->bv);
     }
     else {
       break;
@@ -1032,6 +1078,14 @@ bool BLI_bvhtree_update_node(
   return true;
 }
 
+static void bvhtree_update_tree_task_cb(void *__restrict userdata,
+                                        const int j,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHTree *tree = userdata;
+  node_join(tree, tree->nodes[tree->totleaf + j]);
+}
+
 /* call BLI_bvhtree_update_node() first for every node/point/triangle */
 void BLI_bvhtree_update_tree(BVHTree *tree)
 {
@@ -1039,6 +1093,30 @@ void BLI_bvhtree_update_tree(BVHTree *tree)
    * TRICKY: the way we build the tree all the childs have an index greater than the parent
    * This allows us todo a bottom up update by starting on the bigger numbered branch */
 
+  if (tree->totleaf > KDOPBVH_THREAD_LEAF_THRESHOLD) {
+    /* Branches on the same level of the implicit tree don't depend on each other,
+     * so each level can be updated in parallel, starting with the deepest one.
+     * See #non_recursive_bvh_div_nodes for the level layout. */
+    const int tree_offset = 2 - tree->tree_type;
+    int level_start[32];
+    int levels_num = 0;
+    for (int i = 1; i <= tree->totbranch && levels_num < (int)ARRAY_SIZE(level_start);
+         i = i * tree->tree_type + tree_offset) {
+      level_start[levels_num++] = i - 1;
+    }
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+    int level_stop = tree->totbranch;
+    while (levels_num--) {
+      BLI_task_parallel_range(
+          level_start[levels_num], level_stop, tree, bvhtree_update_tree_task_cb, &settings);
+      level_stop = level_start[levels_num];
+    }
+    return;
+  }
+
   BVHNode **root = tree->nodes + tree->totleaf;
   BVHNode **index = tree->nodes + tree->totleaf + tree->totbranch - 1;
 
@@ -1046,6 +1124,7 @@ void BLI_bvhtree_update_tree(BVHTree *tree)
     node_join(tree, *index);
   }
 }
+
 /**
  * Number of times #BLI_bvhtree_insert has been called.
  * mainly useful for asserts functions to check we added the correct number.
@@ -1894,6 +1973,228 @@ int BLI_bvhtree_ray_cast(BVHTree *tree,
       tree, co, dir, radius, hit, callback, userdata, BVH_RAYCAST_DEFAULT);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name BLI_bvhtree_ray_cast_batch
+ *
+ * Rays are traversed in packets of four, testing the bounds of a node against all rays of the
+ * packet at once with SSE2. A child is only visited when at least one of the rays needs it, so
+ * coherent rays share most of the traversal.
+ * \{ */
+
+#define BVH_RAY_PACKET_SIZE 4
+
+typedef struct BVHRayCastPacket {
+  BVHRayCastData rays[BVH_RAY_PACKET_SIZE];
+  int rays_num;
+#ifdef __SSE2__
+  /* Same data as #fast_ray_nearest_hit uses, one lane per ray. */
+  __m128 origin[3];
+  __m128 idot_axis[3];
+  /* Lanes where the ray goes in negative direction of the axis. */
+  __m128 negative[3];
+#endif
+} BVHRayCastPacket;
+
+#ifdef __SSE2__
+/**
+ * Does #fast_ray_nearest_hit for all rays of the packet,
+ * returns a bit-mask of the rays which need to visit the node.
+ */
+static int packet_ray_nearest_hit(const BVHRayCastPacket *packet,
+                                  const BVHNode *node,
+                                  float r_dist[BVH_RAY_PACKET_SIZE])
+{
+  const float *bv = node->bv;
+  __m128 t1[3], t2[3];
+  for (int i = 0; i < 3; i++) {
+    const __m128 ta = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bv[2 * i]), packet->origin[i]),
+                                 packet->idot_axis[i]);
+    const __m128 tb = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bv[2 * i + 1]), packet->origin[i]),
+                                 packet->idot_axis[i]);
+    t1[i] = _bli_math_blend_sse(packet->negative[i], tb, ta);
+    t2[i] = _bli_math_blend_sse(packet->negative[i], ta, tb);
+  }
+
+  const __m128 hit_dist = _mm_setr_ps(packet->rays[0].hit.dist,
+                                      packet->rays[1].hit.dist,
+                                      packet->rays[2].hit.dist,
+                                      packet->rays[3].hit.dist);
+  const __m128 zero = _mm_setzero_ps();
+  __m128 miss = _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(t1[0], t2[1]), _mm_cmplt_ps(t2[0], t1[1])),
+                          _mm_or_ps(_mm_cmpgt_ps(t1[0], t2[2]), _mm_cmplt_ps(t2[0], t1[2])));
+  miss = _mm_or_ps(miss,
+                   _mm_or_ps(_mm_cmpgt_ps(t1[1], t2[2]), _mm_cmplt_ps(t2[1], t1[2])));
+  miss = _mm_or_ps(miss,
+                   _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(t2[0], zero), _mm_cmplt_ps(t2[1], zero)),
+                             _mm_cmplt_ps(t2[2], zero)));
+  miss = _mm_or_ps(
+      miss,
+      _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(t1[0], hit_dist), _mm_cmpgt_ps(t1[1], hit_dist)),
+                _mm_cmpgt_ps(t1[2], hit_dist)));
+
+  const __m128 dist = _mm_max_ps(_mm_max_ps(t1[0], t1[1]), t1[2]);
+  /* The node is skipped when `dist >= hit.dist`, written so NaN behaves the same. */
+  miss = _mm_or_ps(miss, _mm_cmpge_ps(dist, hit_dist));
+
+  _mm_storeu_ps(r_dist, dist);
+  return ~_mm_movemask_ps(miss) & ((1 << packet->rays_num) - 1);
+}
+
+static void dfs_raycast_packet(BVHRayCastPacket *packet, const BVHNode *node, int ray_mask)
+{
+  float dist[BVH_RAY_PACKET_SIZE];
+  ray_mask &= packet_ray_nearest_hit(packet, node, dist);
+  if (ray_mask == 0) {
+    return;
+  }
+
+  if (node->totnode == 0) {
+    for (int i = 0; i < packet->rays_num; i++) {
+      if ((ray_mask & (1 << i)) == 0) {
+        continue;
+      }
+      BVHRayCastData *data = &packet->rays[i];
+      if (data->callback) {
+        data->callback(data->userdata, node->index, &data->ray, &data->hit);
+      }
+      else {
+        data->hit.index = node->index;
+        data->hit.dist = dist[i];
+        madd_v3_v3v3fl(data->hit.co, data->ray.origin, data->ray.direction, dist[i]);
+      }
+    }
+  }
+  else {
+    /* Pick the loop direction by the first ray which is still traversing. */
+    const BVHRayCastData *data = &packet->rays[bitscan_forward_i(ray_mask)];
+    if (data->ray_dot_axis[node->main_axis] > 0.0f) {
+      for (int i = 0; i != node->totnode; i++) {
+        dfs_raycast_packet(packet, node->children[i], ray_mask);
+      }
+    }
+    else {
+      for (int i = node->totnode - 1; i >= 0; i--) {
+        dfs_raycast_packet(packet, node->children[i], ray_mask);
+      }
+    }
+  }
+}
+#endif /* __SSE2__ */
+
+typedef struct BVHRayCastBatchData {
+  const BVHTree *tree;
+  const float (*co)[3];
+  const float (*dir)[3];
+  int rays_num;
+  float radius;
+  BVHTreeRayHit *hits;
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+  int flag;
+} BVHRayCastBatchData;
+
+static void bvhtree_ray_cast_batch_task_cb(void *__restrict userdata,
+                                           const int packet_index,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHRayCastBatchData *batch = userdata;
+  const BVHTree *tree = batch->tree;
+  BVHNode *root = tree->nodes[tree->totleaf];
+  const int ray_start = packet_index * BVH_RAY_PACKET_SIZE;
+
+  BVHRayCastPacket packet;
+  packet.rays_num = min_ii(BVH_RAY_PACKET_SIZE, batch->rays_num - ray_start);
+
+  for (int i = 0; i < packet.rays_num; i++) {
+    BVHRayCastData *data = &packet.rays[i];
+    BLI_ASSERT_UNIT_V3(batch->dir[ray_start + i]);
+
+    data->tree = tree;
+    data->callback = batch->callback;
+    data->userdata = batch->userdata;
+    copy_v3_v3(data->ray.origin, batch->co[ray_start + i]);
+    copy_v3_v3(data->ray.direction, batch->dir[ray_start + i]);
+    data->ray.radius = batch->radius;
+    bvhtree_ray_cast_data_precalc(data, batch->flag);
+    data->hit = batch->hits[ray_start + i];
+  }
+
+  if (root) {
+#ifdef __SSE2__
+    if (batch->radius == 0.0f) {
+      /* Unused lanes get a copy of the first ray, they are masked out. */
+      for (int i = 0; i < 3; i++) {
+        float origin[BVH_RAY_PACKET_SIZE], idot_axis[BVH_RAY_PACKET_SIZE];
+        for (int j = 0; j < BVH_RAY_PACKET_SIZE; j++) {
+          const BVHRayCastData *data = &packet.rays[j < packet.rays_num ? j : 0];
+          origin[j] = data->ray.origin[i];
+          idot_axis[j] = data->idot_axis[i];
+        }
+        packet.origin[i] = _mm_loadu_ps(origin);
+        packet.idot_axis[i] = _mm_loadu_ps(idot_axis);
+        packet.negative[i] = _mm_cmplt_ps(packet.idot_axis[i], _mm_setzero_ps());
+      }
+      for (int j = packet.rays_num; j < BVH_RAY_PACKET_SIZE; j++) {
+        packet.rays[j].hit.dist = 0.0f;
+      }
+      dfs_raycast_packet(&packet, root, (1 << packet.rays_num) - 1);
+    }
+    else
+#endif
+    {
+      for (int i = 0; i < packet.rays_num; i++) {
+        dfs_raycast(&packet.rays[i], root);
+      }
+    }
+  }
+
+  for (int i = 0; i < packet.rays_num; i++) {
+    batch->hits[ray_start + i] = packet.rays[i].hit;
+  }
+}
+
+/**
+ * Cast many rays at once, giving the same results as calling #BLI_bvhtree_ray_cast_ex for every
+ * ray, except for equally near hits of rays that travel in the same packet.
+ *
+ * \param hits: Must be initialized like the hit of a single ray cast, one per ray.
+ * \param callback: Is called from multiple threads when #BVH_RAYCAST_USE_THREADING is set.
+ */
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                int rays_num,
+                                float radius,
+                                BVHTreeRayHit *hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag)
+{
+  BVHRayCastBatchData batch = {
+      .tree = tree,
+      .co = co,
+      .dir = dir,
+      .rays_num = rays_num,
+      .radius = radius,
+      .hits = hits,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (flag & BVH_RAYCAST_USE_THREADING) != 0;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0,
+                          (rays_num + BVH_RAY_PACKET_SIZE - 1) / BVH_RAY_PACKET_SIZE,
+                          &batch,
+                          bvhtree_ray_cast_batch_task_cb,
+                          &settings);
+}
+
+/** \} */
+
 float BLI_bvhtree_bb_raycast(const float bv[6],
                              const float light_start[3],
                              const float light_end[3],
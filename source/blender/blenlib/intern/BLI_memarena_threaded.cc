@@ -0,0 +1,168 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_memarena.h"
+#include "BLI_memarena_threaded.h"
+#include "BLI_vector.h"
+
+using namespace BLI;
+
+/* Large buffers, since these arenas are meant for array sized temporaries. */
+constexpr size_t THREAD_ARENA_BUFSIZE = MEM_SIZE_OPTIMAL(1 << 20);
+/* Free the memory of an arena on clear when it used more than this,
+ * to not keep memory of a single heavy evaluation around. */
+constexpr size_t THREAD_ARENA_RETAIN_MAX = 64 * 1024 * 1024;
+
+struct ThreadArena {
+  std::thread::id thread_id;
+  MemArena *arena;
+  /* Allocated since the last clear. */
+  size_t allocated;
+};
+
+struct MemArenaThreaded {
+  const char *name;
+  /* Unique identifier, so the thread local lookup can't be fooled by a reused address. */
+  uint64_t id;
+  std::mutex mutex;
+  Vector<ThreadArena *> thread_arenas;
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("MemArenaThreaded")
+};
+
+struct ThreadArenaLookup {
+  uint64_t id = 0;
+  ThreadArena *thread_arena = nullptr;
+};
+
+static std::atomic<uint64_t> next_arena_id(1);
+/* Last used arena of each thread, avoids locking in the common case. */
+static thread_local ThreadArenaLookup local_lookup;
+
+static MemArena *thread_arena_create(const char *name)
+{
+  MemArena *arena = BLI_memarena_new(THREAD_ARENA_BUFSIZE, name);
+  /* Temporaries are often used for vectors, keep them aligned for SIMD. */
+  BLI_memarena_use_align(arena, 16);
+  return arena;
+}
+
+static ThreadArena *thread_arena_get(MemArenaThreaded *arena)
+{
+  if (local_lookup.id == arena->id) {
+    return local_lookup.thread_arena;
+  }
+
+  const std::thread::id thread_id = std::this_thread::get_id();
+  ThreadArena *thread_arena = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(arena->mutex);
+    for (ThreadArena *item : arena->thread_arenas) {
+      if (item->thread_id == thread_id) {
+        thread_arena = item;
+        break;
+      }
+    }
+    if (thread_arena == nullptr) {
+      thread_arena = (ThreadArena *)MEM_mallocN(sizeof(*thread_arena), __func__);
+      thread_arena->thread_id = thread_id;
+      thread_arena->arena = thread_arena_create(arena->name);
+      thread_arena->allocated = 0;
+      arena->thread_arenas.append(thread_arena);
+    }
+  }
+
+  local_lookup.id = arena->id;
+  local_lookup.thread_arena = thread_arena;
+  return thread_arena;
+}
+
+MemArenaThreaded *BLI_memarena_threaded_new(const char *name)
+{
+  MemArenaThreaded *arena = new MemArenaThreaded();
+  arena->name = name;
+  arena->id = next_arena_id++;
+  return arena;
+}
+
+void BLI_memarena_threaded_free(MemArenaThreaded *arena)
+{
+  for (ThreadArena *thread_arena : arena->thread_arenas) {
+    BLI_memarena_free(thread_arena->arena);
+    MEM_freeN(thread_arena);
+  }
+  delete arena;
+}
+
+/**
+ * Allocate from the arena of the calling thread.
+ * The memory stays valid until the next #BLI_memarena_threaded_clear.
+ */
+void *BLI_memarena_threaded_alloc(MemArenaThreaded *arena, size_t size)
+{
+  ThreadArena *thread_arena = thread_arena_get(arena);
+  thread_arena->allocated += size;
+  return BLI_memarena_alloc(thread_arena->arena, size);
+}
+
+void *BLI_memarena_threaded_calloc(MemArenaThreaded *arena, size_t size)
+{
+  ThreadArena *thread_arena = thread_arena_get(arena);
+  thread_arena->allocated += size;
+  return BLI_memarena_calloc(thread_arena->arena, size);
+}
+
+/**
+ * Free everything allocated from all threads, keeping buffers around for reuse.
+ */
+void BLI_memarena_threaded_clear(MemArenaThreaded *arena)
+{
+  std::lock_guard<std::mutex> lock(arena->mutex);
+  for (ThreadArena *thread_arena : arena->thread_arenas) {
+    if (thread_arena->allocated > THREAD_ARENA_RETAIN_MAX) {
+      BLI_memarena_free(thread_arena->arena);
+      thread_arena->arena = thread_arena_create(arena->name);
+    }
+    else if (thread_arena->allocated != 0) {
+      BLI_memarena_clear(thread_arena->arena);
+    }
+    thread_arena->allocated = 0;
+  }
+}
+
+/**
+ * Total size allocated from all threads since the last clear.
+ */
+size_t BLI_memarena_threaded_allocated_size(MemArenaThreaded *arena)
+{
+  std::lock_guard<std::mutex> lock(arena->mutex);
+  size_t allocated = 0;
+  for (ThreadArena *thread_arena : arena->thread_arenas) {
+    allocated += thread_arena->allocated;
+  }
+  return allocated;
+}
@@ -765,6 +765,207 @@ void BLI_mempool_destroy(BLI_mempool *pool)
   MEM_freeN(pool);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Thread Cache
+ *
+ * Allows allocating and freeing elements of a single pool from multiple threads.
+ * Each thread uses its own #BLI_mempool_thread_cache, which owns the chunks it allocates
+ * and keeps its own free list, so no locking is needed while the threads run.
+ * #BLI_mempool_thread_cache_merge then hands the chunks and free elements over to the pool.
+ *
+ * While any cache of a pool exists, the pool itself must not be modified
+ * (no alloc, free or clear), iterating over it only gives the elements allocated before.
+ * \{ */
+
+struct BLI_mempool_thread_cache {
+  BLI_mempool *pool;
+  /** Chunks allocated by this cache, appended to the pool on merge. */
+  BLI_mempool_chunk *chunks;
+  BLI_mempool_chunk *chunk_tail;
+  /** Free element list, may also contain elements of the pool freed from this thread. */
+  BLI_freenode *free;
+  /** Last node of \a free, only valid when \a free isn't NULL. */
+  BLI_freenode *free_tail;
+  /** Change to #BLI_mempool.totused (negative when more elements were freed). */
+  int totused_delta;
+};
+
+/**
+ * Create a cache to allocate elements of \a pool from the calling thread,
+ * the cache must be merged back using #BLI_mempool_thread_cache_merge.
+ */
+BLI_mempool_thread_cache *BLI_mempool_thread_cache_create(BLI_mempool *pool)
+{
+  BLI_mempool_thread_cache *cache = MEM_mallocN(sizeof(*cache), __func__);
+
+  cache->pool = pool;
+  cache->chunks = NULL;
+  cache->chunk_tail = NULL;
+  cache->free = NULL;
+  cache->free_tail = NULL;
+  cache->totused_delta = 0;
+
+  return cache;
+}
+
+/**
+ * Same as #mempool_chunk_add, except the chunk goes into the cache and never
+ * touches the shared pool data.
+ */
+static void mempool_thread_cache_chunk_add(BLI_mempool_thread_cache *cache,
+                                           BLI_mempool_chunk *mpchunk)
+{
+  const BLI_mempool *pool = cache->pool;
+  const uint esize = pool->esize;
+  BLI_freenode *curnode = CHUNK_DATA(mpchunk);
+  uint j;
+
+  BLI_assert(cache->free == NULL);
+
+  if (cache->chunk_tail) {
+    cache->chunk_tail->next = mpchunk;
+  }
+  else {
+    cache->chunks = mpchunk;
+  }
+  mpchunk->next = NULL;
+  cache->chunk_tail = mpchunk;
+
+  cache->free = curnode;
+
+  j = pool->pchunk;
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    while (j--) {
+      curnode->next = NODE_STEP_NEXT(curnode);
+      curnode->freeword = FREEWORD;
+      curnode = curnode->next;
+    }
+  }
+  else {
+    while (j--) {
+      curnode->next = NODE_STEP_NEXT(curnode);
+      curnode = curnode->next;
+    }
+  }
+
+  curnode = NODE_STEP_PREV(curnode);
+  curnode->next = NULL;
+  cache->free_tail = curnode;
+}
+
+void *BLI_mempool_thread_cache_alloc(BLI_mempool_thread_cache *cache)
+{
+  const BLI_mempool *pool = cache->pool;
+  BLI_freenode *free_pop;
+
+  if (UNLIKELY(cache->free == NULL)) {
+    /* Need to allocate a new chunk, the guarded allocator is thread-safe. */
+    BLI_mempool_chunk *mpchunk = MEM_mallocN(sizeof(BLI_mempool_chunk) + (size_t)pool->csize,
+                                             "BLI_Mempool Chunk");
+    mempool_thread_cache_chunk_add(cache, mpchunk);
+  }
+
+  free_pop = cache->free;
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    free_pop->freeword = USEDWORD;
+  }
+
+  cache->free = free_pop->next;
+  cache->totused_delta++;
+
+  return (void *)free_pop;
+}
+
+void *BLI_mempool_thread_cache_calloc(BLI_mempool_thread_cache *cache)
+{
+  void *retval = BLI_mempool_thread_cache_alloc(cache);
+  memset(retval, 0, (size_t)cache->pool->esize);
+  return retval;
+}
+
+/**
+ * Free an element allocated from the pool,
+ * either before the threaded work started or from any cache of that pool.
+ *
+ * \note Unlike #BLI_mempool_free, chunks are never freed here, only on merge.
+ */
+void BLI_mempool_thread_cache_free(BLI_mempool_thread_cache *cache, void *addr)
+{
+  const BLI_mempool *pool = cache->pool;
+  BLI_freenode *newhead = addr;
+
+#ifndef NDEBUG
+  /* Elements may belong to chunks of other caches, which can't be searched safely,
+   * so unlike #BLI_mempool_free there is no check the element is part of the pool. */
+  if (UNLIKELY(mempool_debug_memset)) {
+    memset(addr, 255, pool->esize);
+  }
+#endif
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+#ifndef NDEBUG
+    BLI_assert(newhead->freeword != FREEWORD);
+#endif
+    newhead->freeword = FREEWORD;
+  }
+
+  if (cache->free == NULL) {
+    cache->free_tail = newhead;
+  }
+  newhead->next = cache->free;
+  cache->free = newhead;
+
+  cache->totused_delta--;
+}
+
+/**
+ * Give the chunks and free elements of \a cache to its pool, and free the cache.
+ *
+ * Merging must not happen concurrently with other merges or operations on the pool,
+ * typically it's done from the calling thread once all threads are done
+ * (#TaskParallelSettings.func_finalize for example).
+ *
+ * New chunks are appended in the order of merging,
+ * so iteration over the pool afterwards behaves as if the elements were allocated serially.
+ */
+void BLI_mempool_thread_cache_merge(BLI_mempool_thread_cache *cache)
+{
+  BLI_mempool *pool = cache->pool;
+  BLI_mempool_chunk *mpchunk;
+
+  if (cache->chunks) {
+    if (pool->chunk_tail) {
+      pool->chunk_tail->next = cache->chunks;
+    }
+    else {
+      BLI_assert(pool->chunks == NULL);
+      pool->chunks = cache->chunks;
+    }
+    pool->chunk_tail = cache->chunk_tail;
+
+#ifdef USE_TOTALLOC
+    for (mpchunk = cache->chunks; mpchunk; mpchunk = mpchunk->next) {
+      pool->totalloc += pool->pchunk;
+    }
+#else
+    UNUSED_VARS(mpchunk);
+#endif
+  }
+
+  if (cache->free) {
+    cache->free_tail->next = pool->free;
+    pool->free = cache->free;
+  }
+
+  BLI_assert((int)pool->totused + cache->totused_delta >= 0);
+  pool->totused = (uint)((int)pool->totused + cache->totused_delta);
+
+  MEM_freeN(cache);
+}
+
+/** \} */
+
 #ifndef NDEBUG
 void BLI_mempool_set_memory_debug(void)
 {
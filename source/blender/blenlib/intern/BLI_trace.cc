@@ -0,0 +1,190 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_threads.h"
+#include "BLI_trace.h"
+#include "BLI_vector.h"
+
+using namespace BLI;
+
+struct TraceEvent {
+  char name[BLI_TRACE_NAME_MAX];
+  double start, end;
+};
+
+struct TraceThreadBuffer {
+  /* Index of the thread in the trace, in order of the first recorded zone. */
+  int thread_index;
+  bool is_main;
+  /* Number of recorded zones, only the last #BLI_TRACE_EVENTS_PER_THREAD are kept. */
+  uint64_t events_num;
+  TraceEvent events[BLI_TRACE_EVENTS_PER_THREAD];
+};
+
+struct TraceThreadLookup {
+  uint64_t session = 0;
+  TraceThreadBuffer *buffer = nullptr;
+};
+
+bool bli_trace_enabled = false;
+
+static struct {
+  char filepath[FILE_MAX];
+  double start_time;
+  /* Unique identifier, so the thread local lookup doesn't use buffers of a previous trace. */
+  uint64_t session;
+  std::mutex mutex;
+  Vector<TraceThreadBuffer *> buffers;
+} trace;
+
+static std::atomic<uint64_t> next_trace_session(1);
+static thread_local TraceThreadLookup local_lookup;
+
+static TraceThreadBuffer *trace_thread_buffer_get(void)
+{
+  if (local_lookup.session == trace.session) {
+    return local_lookup.buffer;
+  }
+
+  TraceThreadBuffer *buffer = (TraceThreadBuffer *)MEM_mallocN(sizeof(*buffer), __func__);
+  buffer->is_main = BLI_thread_is_main();
+  buffer->events_num = 0;
+  {
+    std::lock_guard<std::mutex> lock(trace.mutex);
+    buffer->thread_index = (int)trace.buffers.size();
+    trace.buffers.append(buffer);
+  }
+
+  local_lookup.session = trace.session;
+  local_lookup.buffer = buffer;
+  return buffer;
+}
+
+void BLI_trace_init(const char *filepath)
+{
+  if (bli_trace_enabled) {
+    BLI_trace_exit();
+  }
+  BLI_strncpy(trace.filepath, filepath, sizeof(trace.filepath));
+  trace.start_time = PIL_check_seconds_timer();
+  trace.session = next_trace_session++;
+  bli_trace_enabled = true;
+}
+
+void BLI_trace_zone_add(const char *name, const double start, const double end)
+{
+  if (!bli_trace_enabled) {
+    return;
+  }
+  TraceThreadBuffer *buffer = trace_thread_buffer_get();
+  TraceEvent *event = &buffer->events[buffer->events_num % BLI_TRACE_EVENTS_PER_THREAD];
+  BLI_strncpy(event->name, name, sizeof(event->name));
+  event->start = start;
+  event->end = end;
+  buffer->events_num++;
+}
+
+/* Names are mostly identifiers, only escape what would break the JSON string. */
+static void trace_write_name(FILE *file, const char *name)
+{
+  for (const char *c = name; *c; c++) {
+    if (*c == '"' || *c == '\\') {
+      fprintf(file, "\\%c", *c);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      fputc(' ', file);
+    }
+    else {
+      fputc(*c, file);
+    }
+  }
+}
+
+static void trace_write(FILE *file)
+{
+  bool first = true;
+  fprintf(file, "{\"traceEvents\": [");
+
+  for (const TraceThreadBuffer *buffer : trace.buffers) {
+    if (buffer->is_main) {
+      fprintf(file,
+              "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+              "\"args\": {\"name\": \"Main\"}}",
+              first ? "" : ",",
+              buffer->thread_index);
+      first = false;
+    }
+
+    /* Oldest first, when the ring buffer is full it starts at the oldest kept zone. */
+    const uint64_t events_len = std::min<uint64_t>(buffer->events_num,
+                                                   BLI_TRACE_EVENTS_PER_THREAD);
+    const uint64_t events_first = buffer->events_num - events_len;
+    for (uint64_t i = 0; i < events_len; i++) {
+      const TraceEvent *event =
+          &buffer->events[(events_first + i) % BLI_TRACE_EVENTS_PER_THREAD];
+      fprintf(file, "%s\n{\"name\": \"", first ? "" : ",");
+      trace_write_name(file, event->name);
+      /* Time stamps are in microseconds. */
+      fprintf(file,
+              "\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+              buffer->thread_index,
+              (event->start - trace.start_time) * 1e6,
+              (event->end - event->start) * 1e6);
+      first = false;
+    }
+  }
+
+  fprintf(file, "\n]}\n");
+}
+
+/* Writes the trace file, no thread may be adding zones anymore. */
+void BLI_trace_exit(void)
+{
+  if (!bli_trace_enabled) {
+    return;
+  }
+  bli_trace_enabled = false;
+
+  FILE *file = BLI_fopen(trace.filepath, "w");
+  if (file != NULL) {
+    trace_write(file);
+    fclose(file);
+    printf("Trace written to '%s'\n", trace.filepath);
+  }
+  else {
+    printf("Error: unable to write trace to '%s'\n", trace.filepath);
+  }
+
+  for (TraceThreadBuffer *buffer : trace.buffers) {
+    MEM_freeN(buffer);
+  }
+  trace.buffers.clear();
+  trace.session = 0;
+}
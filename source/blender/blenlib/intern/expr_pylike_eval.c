@@ -72,6 +72,8 @@ typedef enum eOpCode {
   OPCODE_FUNC1,
   /* 2 argument function call: (a b -> func2(a,b)) */
   OPCODE_FUNC2,
+  /* 3 argument function call: (a b c -> func3(a,b,c)) */
+  OPCODE_FUNC3,
   /* Parameter access: (-> params[ival]) */
   OPCODE_PARAMETER,
   /* Minimum of multiple inputs: (a b c... -> min); ival = arg count */
@@ -92,6 +94,7 @@ typedef enum eOpCode {
 
 typedef double (*UnaryOpFunc)(double);
 typedef double (*BinaryOpFunc)(double, double);
+typedef double (*TernaryOpFunc)(double, double, double);
 
 typedef struct ExprOp {
   eOpCode opcode;
@@ -104,6 +107,7 @@ typedef struct ExprOp {
     void *ptr;
     UnaryOpFunc func1;
     BinaryOpFunc func2;
+    TernaryOpFunc func3;
   } arg;
 } ExprOp;
 
@@ -198,6 +202,11 @@ eExprPyLike_EvalStatus BLI_expr_pylike_eval(ExprPyLike_Parsed *expr,
         stack[sp - 2] = ops[pc].arg.func2(stack[sp - 2], stack[sp - 1]);
         sp--;
         break;
+      case OPCODE_FUNC3:
+        FAIL_IF(sp < 3);
+        stack[sp - 3] = ops[pc].arg.func3(stack[sp - 3], stack[sp - 2], stack[sp - 1]);
+        sp -= 2;
+        break;
       case OPCODE_MIN:
         FAIL_IF(sp < ops[pc].arg.ival);
         for (int j = 1; j < ops[pc].arg.ival; j++, sp--) {
@@ -308,6 +317,16 @@ static double op_degrees(double arg)
   return arg * 180.0 / M_PI;
 }
 
+static double op_clamp(double arg, double minv, double maxv)
+{
+  return min_dd(max_dd(arg, minv), maxv);
+}
+
+static double op_lerp(double a, double b, double t)
+{
+  return a + (b - a) * t;
+}
+
 static double op_not(double a)
 {
   return a ? 0.0 : 1.0;
@@ -385,6 +404,7 @@ static BuiltinOpDef builtin_ops[] = {
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"lerp", OPCODE_FUNC3, op_lerp},
     {NULL, OPCODE_CONST, NULL},
 };
 
@@ -542,6 +562,27 @@ static bool parse_add_func(ExprParseState *state, eOpCode code, int args, void *
       }
       break;
 
+    case OPCODE_FUNC3:
+      CHECK_ERROR(args == 3);
+
+      if (jmp_gap >= 3 && prev_ops[-3].opcode == OPCODE_CONST &&
+          prev_ops[-2].opcode == OPCODE_CONST && prev_ops[-1].opcode == OPCODE_CONST) {
+        TernaryOpFunc func = funcptr;
+
+        /* volatile because some compilers overly aggressive optimize this call out.
+         * see D6012 for details. */
+        volatile double result = func(
+            prev_ops[-3].arg.dval, prev_ops[-2].arg.dval, prev_ops[-1].arg.dval);
+
+        if (fetestexcept(FE_DIVBYZERO | FE_INVALID) == 0) {
+          prev_ops[-3].arg.dval = result;
+          state->ops_count -= 2;
+          state->stack_ptr -= 2;
+          return true;
+        }
+      }
+      break;
+
     default:
       BLI_assert(false);
       return false;
@@ -758,6 +799,19 @@ static bool parse_unary(ExprParseState *state)
         return true;
       }
 
+      /* Clamp to the 0..1 range by default, like the Python driver namespace. */
+      if (STREQ(state->tokenbuf, "clamp")) {
+        int cnt = parse_function_args(state);
+        CHECK_ERROR(cnt == 1 || cnt == 3);
+
+        if (cnt == 1) {
+          parse_add_op(state, OPCODE_CONST, 1)->arg.dval = 0.0;
+          parse_add_op(state, OPCODE_CONST, 1)->arg.dval = 1.0;
+        }
+
+        return parse_add_func(state, OPCODE_FUNC3, 3, op_clamp);
+      }
+
       return false;
 
     default:
@@ -675,6 +675,42 @@ MALWAYS_INLINE __m128 _bli_math_blend_sse(const __m128 mask, const __m128 a, con
   return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
 }
 
+/* Split four packed 3D vectors, loaded as `[x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3]`,
+ * into one register per component. */
+MALWAYS_INLINE void _bli_math_load_v3_array_soa(const float (*v)[3],
+                                                __m128 *r_x,
+                                                __m128 *r_y,
+                                                __m128 *r_z)
+{
+  const __m128 a = _mm_loadu_ps(v[0]);
+  const __m128 b = _mm_loadu_ps(v[1] + 1);
+  const __m128 c = _mm_loadu_ps(v[2] + 2);
+  /* [x2 y2 x3 y3] and [y0 z0 y1 z1]. */
+  const __m128 u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+  const __m128 t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+  *r_x = _mm_shuffle_ps(a, u, _MM_SHUFFLE(2, 0, 3, 0));
+  *r_y = _mm_shuffle_ps(t, u, _MM_SHUFFLE(3, 1, 2, 0));
+  *r_z = _mm_shuffle_ps(t, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+/* Inverse of #_bli_math_load_v3_array_soa. */
+MALWAYS_INLINE void _bli_math_store_v3_array_soa(float (*r)[3],
+                                                 const __m128 x,
+                                                 const __m128 y,
+                                                 const __m128 z)
+{
+  /* [x0 x1 y0 y1], [z0 z1 x0 x1], [y0 y1 z0 z1], [x2 x3 y2 y3], [z2 z3 x2 x3], [y2 y3 z2 z3]. */
+  const __m128 xy_lo = _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m128 zx_lo = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m128 yz_lo = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m128 xy_hi = _mm_shuffle_ps(x, y, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m128 zx_hi = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m128 yz_hi = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 2, 3, 2));
+  _mm_storeu_ps(r[0], _mm_shuffle_ps(xy_lo, zx_lo, _MM_SHUFFLE(3, 0, 2, 0)));
+  _mm_storeu_ps(r[1] + 1, _mm_shuffle_ps(yz_lo, xy_hi, _MM_SHUFFLE(2, 0, 3, 1)));
+  _mm_storeu_ps(r[2] + 2, _mm_shuffle_ps(zx_hi, yz_hi, _MM_SHUFFLE(3, 1, 3, 0)));
+}
+
 #endif /* __SSE2__ */
 
 /* Low level conversion functions */
@@ -698,6 +698,36 @@ void mul_v3_m4v3(float r[3], const float mat[4][4], const float vec[3])
   r[2] = x * mat[0][2] + y * mat[1][2] + mat[2][2] * vec[2] + mat[3][2];
 }
 
+/**
+ * Same as calling #mul_v3_m4v3 on every vector.
+ * \param r: May be the same array as \a v.
+ */
+void mul_v3_m4v3_array(float (*r)[3], const float mat[4][4], const float (*v)[3], int len)
+{
+#ifdef __SSE2__
+  __m128 m[4][3];
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      m[i][j] = _mm_set1_ps(mat[i][j]);
+    }
+  }
+  for (; len >= 4; len -= 4, r += 4, v += 4) {
+    __m128 x, y, z;
+    _bli_math_load_v3_array_soa(v, &x, &y, &z);
+    __m128 r_xyz[3];
+    for (int j = 0; j < 3; j++) {
+      r_xyz[j] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m[0][j]), _mm_mul_ps(y, m[1][j])),
+                                       _mm_mul_ps(m[2][j], z)),
+                            m[3][j]);
+    }
+    _bli_math_store_v3_array_soa(r, r_xyz[0], r_xyz[1], r_xyz[2]);
+  }
+#endif
+  for (; len > 0; len--, r++, v++) {
+    mul_v3_m4v3(*r, mat, *v);
+  }
+}
+
 void mul_v3_m4v3_db(double r[3], const double mat[4][4], const double vec[3])
 {
   const double x = vec[0];
@@ -997,13 +997,118 @@ void minmax_v2v2_v2(float min[2], float max[2], const float vec[2])
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Array Functions
+ *
+ * Operations on arrays of vectors, like the coordinates passed to deform modifiers.
+ * With SSE2 these handle four vectors at once, which are loaded as three registers:
+ * `[x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3]`, see #_bli_math_load_v3_array_soa.
+ * \{ */
+
 void minmax_v3v3_v3_array(float r_min[3], float r_max[3], const float (*vec_arr)[3], int nbr)
 {
+#ifdef __SSE2__
+  if (nbr >= 4) {
+    /* Every lane of the three registers always holds the same component,
+     * so the loop needs no shuffling, only the final reduction does. */
+    __m128 min_a = _mm_setr_ps(r_min[0], r_min[1], r_min[2], r_min[0]);
+    __m128 min_b = _mm_setr_ps(r_min[1], r_min[2], r_min[0], r_min[1]);
+    __m128 min_c = _mm_setr_ps(r_min[2], r_min[0], r_min[1], r_min[2]);
+    __m128 max_a = _mm_setr_ps(r_max[0], r_max[1], r_max[2], r_max[0]);
+    __m128 max_b = _mm_setr_ps(r_max[1], r_max[2], r_max[0], r_max[1]);
+    __m128 max_c = _mm_setr_ps(r_max[2], r_max[0], r_max[1], r_max[2]);
+    for (; nbr >= 4; nbr -= 4, vec_arr += 4) {
+      const __m128 a = _mm_loadu_ps(vec_arr[0]);
+      const __m128 b = _mm_loadu_ps(vec_arr[1] + 1);
+      const __m128 c = _mm_loadu_ps(vec_arr[2] + 2);
+      min_a = _mm_min_ps(min_a, a);
+      min_b = _mm_min_ps(min_b, b);
+      min_c = _mm_min_ps(min_c, c);
+      max_a = _mm_max_ps(max_a, a);
+      max_b = _mm_max_ps(max_b, b);
+      max_c = _mm_max_ps(max_c, c);
+    }
+    float a[4], b[4], c[4];
+    _mm_storeu_ps(a, min_a);
+    _mm_storeu_ps(b, min_b);
+    _mm_storeu_ps(c, min_c);
+    r_min[0] = min_ff(min_ff(a[0], a[3]), min_ff(b[2], c[1]));
+    r_min[1] = min_ff(min_ff(a[1], b[0]), min_ff(b[3], c[2]));
+    r_min[2] = min_ff(min_ff(a[2], b[1]), min_ff(c[0], c[3]));
+    _mm_storeu_ps(a, max_a);
+    _mm_storeu_ps(b, max_b);
+    _mm_storeu_ps(c, max_c);
+    r_max[0] = max_ff(max_ff(a[0], a[3]), max_ff(b[2], c[1]));
+    r_max[1] = max_ff(max_ff(a[1], b[0]), max_ff(b[3], c[2]));
+    r_max[2] = max_ff(max_ff(a[2], b[1]), max_ff(c[0], c[3]));
+  }
+#endif
   while (nbr--) {
     minmax_v3v3_v3(r_min, r_max, *vec_arr++);
   }
 }
 
+/**
+ * Same as calling #normalize_v3 on every vector.
+ */
+void normalize_v3_array(float (*vec_arr)[3], int nbr)
+{
+#ifdef __SSE2__
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 eps = _mm_set1_ps(1.0e-35f);
+  for (; nbr >= 4; nbr -= 4, vec_arr += 4) {
+    __m128 x, y, z;
+    _bli_math_load_v3_array_soa(vec_arr, &x, &y, &z);
+    const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                _mm_mul_ps(z, z));
+    /* Zero the vectors which are too short, as #normalize_v3 does. */
+    const __m128 mask = _mm_cmpgt_ps(d, eps);
+    const __m128 fac = _mm_and_ps(mask, _mm_div_ps(one, _mm_sqrt_ps(d)));
+    _bli_math_store_v3_array_soa(vec_arr, _mm_mul_ps(x, fac), _mm_mul_ps(y, fac), _mm_mul_ps(z, fac));
+  }
+#endif
+  while (nbr--) {
+    normalize_v3(*vec_arr++);
+  }
+}
+
+/**
+ * Same as calling #interp_v3_v3v3 on every vector, with a factor per vector.
+ * \param r: May be the same array as \a a or \a b.
+ */
+void interp_v3_v3v3_array(
+    float (*r)[3], const float (*a)[3], const float (*b)[3], const float *t, int nbr)
+{
+#ifdef __SSE2__
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (; nbr >= 4; nbr -= 4, r += 4, a += 4, b += 4, t += 4) {
+    const __m128 t4 = _mm_loadu_ps(t);
+    /* Factors matching the components of the three registers. */
+    const __m128 t_lanes[3] = {
+        _mm_shuffle_ps(t4, t4, _MM_SHUFFLE(1, 0, 0, 0)),
+        _mm_shuffle_ps(t4, t4, _MM_SHUFFLE(2, 2, 1, 1)),
+        _mm_shuffle_ps(t4, t4, _MM_SHUFFLE(3, 3, 3, 2)),
+    };
+    __m128 result[3];
+    for (int i = 0; i < 3; i++) {
+      const __m128 va = _mm_loadu_ps(a[i] + i);
+      const __m128 vb = _mm_loadu_ps(b[i] + i);
+      const __m128 s = _mm_sub_ps(one, t_lanes[i]);
+      result[i] = _mm_add_ps(_mm_mul_ps(s, va), _mm_mul_ps(t_lanes[i], vb));
+    }
+    /* Store after all loads, \a r may overlap the inputs. */
+    for (int i = 0; i < 3; i++) {
+      _mm_storeu_ps(r[i] + i, result[i]);
+    }
+  }
+#endif
+  while (nbr--) {
+    interp_v3_v3v3(*r++, *a++, *b++, *t++);
+  }
+}
+
+/** \} */
+
 /** ensure \a v1 is \a dist from \a v2 */
 void dist_ensure_v3_v3fl(float v1[3], const float v2[3], const float dist)
 {
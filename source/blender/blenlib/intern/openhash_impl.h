@@ -0,0 +1,438 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/** \file
+ * \ingroup bli
+ *
+ * Open addressing hash table, included by a C file for each key type.
+ *
+ * Entries are stored in insertion order in a dense array,
+ * a separate map of twice the size holds the entry indices.
+ * This is the same layout as #EdgeHash, see edgehash.c.
+ *
+ * Besides the defines required by BLI_openhash_impl.h, these must be set:
+ * - #OHASH_KEY_HASH(key): returns the hash of a key as unsigned int.
+ * - #OHASH_KEY_EQ(key_a, key_b): true when both keys are equal.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+#include "BLI_openhash_impl.h"
+#include "BLI_strict_flags.h"
+
+#define _CONCAT_AUX(MACRO_ARG1, MACRO_ARG2) MACRO_ARG1##MACRO_ARG2
+#define _CONCAT(MACRO_ARG1, MACRO_ARG2) _CONCAT_AUX(MACRO_ARG1, MACRO_ARG2)
+#define BLI_ohash_nd_(id) _CONCAT(OHASH_PREFIX_ID, _##id)
+
+struct OHashMap {
+  OHashMapEntry *entries;
+  int32_t *map;
+  uint32_t slot_mask;
+  uint capacity_exp;
+  uint length;
+  uint dummy_count;
+};
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Helper Macros & Defines
+ * \{ */
+
+#define ENTRIES_CAPACITY(container) (uint)(1 << (container)->capacity_exp)
+#define MAP_CAPACITY(container) (uint)(1 << ((container)->capacity_exp + 1))
+#define CLEAR_MAP(container) \
+  memset((container)->map, 0xFF, sizeof(int32_t) * MAP_CAPACITY(container))
+#define UPDATE_SLOT_MASK(container) \
+  { \
+    (container)->slot_mask = MAP_CAPACITY(container) - 1; \
+  } \
+  ((void)0)
+#define PERTURB_SHIFT 5
+
+#define ITER_SLOTS(CONTAINER, HASH, SLOT, INDEX) \
+  uint32_t mask = (CONTAINER)->slot_mask; \
+  uint32_t perturb = (HASH); \
+  int32_t *map = (CONTAINER)->map; \
+  uint32_t SLOT = mask & (HASH); \
+  int INDEX = map[SLOT]; \
+  for (;; SLOT = mask & ((5 * SLOT) + 1 + perturb), perturb >>= PERTURB_SHIFT, INDEX = map[SLOT])
+
+#define SLOT_EMPTY -1
+#define SLOT_DUMMY -2
+
+#define CAPACITY_EXP_DEFAULT 3
+
+#ifdef OHASH_STORE_HASH
+#  define ENTRY_HASH(entry) ((entry)->hash)
+#  define ENTRY_HAS_KEY(entry, key_hash, key) \
+    (((entry)->hash == (key_hash)) && OHASH_KEY_EQ((entry)->key, key))
+#else
+#  define ENTRY_HASH(entry) OHASH_KEY_HASH((entry)->key)
+#  define ENTRY_HAS_KEY(entry, key_hash, key) OHASH_KEY_EQ((entry)->key, key)
+#endif
+
+#define INDEX_HAS_KEY(container, index, key_hash, key) \
+  ((index) >= 0 && ENTRY_HAS_KEY(&(container)->entries[index], key_hash, key))
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Utility API
+ * \{ */
+
+static uint calc_capacity_exp_for_reserve(uint reserve)
+{
+  uint result = 1;
+  while (reserve >>= 1) {
+    result++;
+  }
+  return result;
+}
+
+static void ohash_free_values(OHashMap *oh, OHashFreeFP free_value)
+{
+  if (free_value) {
+    for (uint i = 0; i < oh->length; i++) {
+      free_value(oh->entries[i].value);
+    }
+  }
+}
+
+BLI_INLINE void ohash_insert_index(OHashMap *oh, const uint32_t hash, uint entry_index)
+{
+  ITER_SLOTS (oh, hash, slot, index) {
+    if (index == SLOT_EMPTY) {
+      oh->map[slot] = (int32_t)entry_index;
+      break;
+    }
+  }
+}
+
+static void ohash_rebuild_map(OHashMap *oh)
+{
+  CLEAR_MAP(oh);
+  oh->dummy_count = 0;
+  for (uint i = 0; i < oh->length; i++) {
+    ohash_insert_index(oh, ENTRY_HASH(&oh->entries[i]), i);
+  }
+}
+
+static void ohash_resize(OHashMap *oh, uint capacity_exp)
+{
+  oh->capacity_exp = capacity_exp;
+  UPDATE_SLOT_MASK(oh);
+  oh->entries = MEM_reallocN(oh->entries, sizeof(OHashMapEntry) * ENTRIES_CAPACITY(oh));
+  oh->map = MEM_reallocN(oh->map, sizeof(int32_t) * MAP_CAPACITY(oh));
+  ohash_rebuild_map(oh);
+}
+
+BLI_INLINE OHashMapEntry *ohash_insert_at_slot(
+    OHashMap *oh, uint slot, OHASH_KEY_TYPE key, const uint32_t hash, void *value)
+{
+  OHashMapEntry *entry = &oh->entries[oh->length];
+  entry->key = key;
+  entry->value = value;
+#ifdef OHASH_STORE_HASH
+  entry->hash = hash;
+#else
+  UNUSED_VARS(hash);
+#endif
+  oh->map[slot] = (int32_t)oh->length;
+  oh->length++;
+  return entry;
+}
+
+/**
+ * Grow the oh (or remove dummy slots) when there is no room for another key.
+ * \return true when the oh was rebuilt, invalidating any slot found before.
+ */
+BLI_INLINE bool ohash_ensure_can_insert(OHashMap *oh)
+{
+  if (UNLIKELY(ENTRIES_CAPACITY(oh) <= oh->length + oh->dummy_count)) {
+    if (ENTRIES_CAPACITY(oh) <= oh->length) {
+      ohash_resize(oh, oh->capacity_exp + 1);
+    }
+    else {
+      /* Only removed keys are in the way, no need to grow. */
+      ohash_rebuild_map(oh);
+    }
+    return true;
+  }
+  return false;
+}
+
+BLI_INLINE OHashMapEntry *ohash_insert(OHashMap *oh,
+                                       OHASH_KEY_TYPE key,
+                                       const uint32_t hash,
+                                       void *value)
+{
+  ITER_SLOTS (oh, hash, slot, index) {
+    if (index == SLOT_EMPTY) {
+      return ohash_insert_at_slot(oh, slot, key, hash, value);
+    }
+    else if (index == SLOT_DUMMY) {
+      oh->dummy_count--;
+      return ohash_insert_at_slot(oh, slot, key, hash, value);
+    }
+  }
+}
+
+BLI_INLINE OHashMapEntry *ohash_lookup_entry(const OHashMap *oh, OHASH_KEY_TYPE key)
+{
+  const uint32_t hash = OHASH_KEY_HASH(key);
+
+  ITER_SLOTS (oh, hash, slot, index) {
+    if (INDEX_HAS_KEY(oh, index, hash, key)) {
+      return &oh->entries[index];
+    }
+    else if (index == SLOT_EMPTY) {
+      return NULL;
+    }
+  }
+}
+
+BLI_INLINE void ohash_change_index(OHashMap *oh,
+                                   const uint32_t hash,
+                                   const int old_index,
+                                   const int new_index)
+{
+  ITER_SLOTS (oh, hash, slot, index) {
+    if (index == old_index) {
+      oh->map[slot] = new_index;
+      break;
+    }
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Public API
+ * \{ */
+
+OHashMap *BLI_ohash_nd_(new_ex)(const char *info, const uint nentries_reserve)
+{
+  OHashMap *oh = MEM_mallocN(sizeof(OHashMap), info);
+  oh->capacity_exp = calc_capacity_exp_for_reserve(nentries_reserve);
+  UPDATE_SLOT_MASK(oh);
+  oh->length = 0;
+  oh->dummy_count = 0;
+  oh->entries = MEM_malloc_arrayN(ENTRIES_CAPACITY(oh), sizeof(OHashMapEntry), "ohash entries");
+  oh->map = MEM_malloc_arrayN(MAP_CAPACITY(oh), sizeof(int32_t), "ohash map");
+  CLEAR_MAP(oh);
+  return oh;
+}
+
+OHashMap *BLI_ohash_nd_(new)(const char *info)
+{
+  return BLI_ohash_nd_(new_ex)(info, 1 << CAPACITY_EXP_DEFAULT);
+}
+
+void BLI_ohash_nd_(free)(OHashMap *oh, OHashFreeFP valfreefp)
+{
+  ohash_free_values(oh, valfreefp);
+  MEM_freeN(oh->map);
+  MEM_freeN(oh->entries);
+  MEM_freeN(oh);
+}
+
+/**
+ * Make room for \a nentries_reserve keys in total, avoiding resizing on insertion.
+ */
+void BLI_ohash_nd_(reserve)(OHashMap *oh, const uint nentries_reserve)
+{
+  const uint capacity_exp = calc_capacity_exp_for_reserve(nentries_reserve);
+  if (capacity_exp > oh->capacity_exp) {
+    ohash_resize(oh, capacity_exp);
+  }
+}
+
+/**
+ * Insert a key/value pair, does not check for duplicates.
+ */
+void BLI_ohash_nd_(insert)(OHashMap *oh, OHASH_KEY_TYPE key, void *val)
+{
+  BLI_assert(ohash_lookup_entry(oh, key) == NULL);
+  ohash_ensure_can_insert(oh);
+  ohash_insert(oh, key, OHASH_KEY_HASH(key), val);
+}
+
+/**
+ * Assign a new value to a key that may already be in the oh.
+ * \return true if a new key has been added.
+ */
+bool BLI_ohash_nd_(reinsert)(OHashMap *oh, OHASH_KEY_TYPE key, void *val)
+{
+  const uint32_t hash = OHASH_KEY_HASH(key);
+
+  ITER_SLOTS (oh, hash, slot, index) {
+    if (INDEX_HAS_KEY(oh, index, hash, key)) {
+      oh->entries[index].value = val;
+      return false;
+    }
+    else if (index == SLOT_EMPTY) {
+      if (ohash_ensure_can_insert(oh)) {
+        ohash_insert(oh, key, hash, val);
+      }
+      else {
+        ohash_insert_at_slot(oh, slot, key, hash, val);
+      }
+      return true;
+    }
+  }
+}
+
+/**
+ * Lookup the value of \a key, NULL when not found.
+ * Use #lookup_p to differentiate between a NULL value and a missing key.
+ */
+void *BLI_ohash_nd_(lookup)(const OHashMap *oh, OHASH_KEY_TYPE key)
+{
+  OHashMapEntry *entry = ohash_lookup_entry(oh, key);
+  return entry ? entry->value : NULL;
+}
+
+void *BLI_ohash_nd_(lookup_default)(const OHashMap *oh, OHASH_KEY_TYPE key, void *val_default)
+{
+  OHashMapEntry *entry = ohash_lookup_entry(oh, key);
+  return entry ? entry->value : val_default;
+}
+
+/**
+ * Lookup a pointer to the value of \a key, NULL when not found.
+ */
+void **BLI_ohash_nd_(lookup_p)(OHashMap *oh, OHASH_KEY_TYPE key)
+{
+  OHashMapEntry *entry = ohash_lookup_entry(oh, key);
+  return entry ? &entry->value : NULL;
+}
+
+/**
+ * Ensure \a key exists in the oh, see #BLI_ghash_ensure_p.
+ *
+ * \returns true when the value didn't need to be added.
+ * (when false, the caller _must_ initialize the value).
+ */
+bool BLI_ohash_nd_(ensure_p)(OHashMap *oh, OHASH_KEY_TYPE key, void ***r_val)
+{
+  const uint32_t hash = OHASH_KEY_HASH(key);
+
+  ITER_SLOTS (oh, hash, slot, index) {
+    if (INDEX_HAS_KEY(oh, index, hash, key)) {
+      *r_val = &oh->entries[index].value;
+      return true;
+    }
+    else if (index == SLOT_EMPTY) {
+      if (ohash_ensure_can_insert(oh)) {
+        *r_val = &ohash_insert(oh, key, hash, NULL)->value;
+      }
+      else {
+        *r_val = &ohash_insert_at_slot(oh, slot, key, hash, NULL)->value;
+      }
+      return false;
+    }
+  }
+}
+
+/**
+ * Remove \a key from the oh.
+ *
+ * \param valfreefp: Optional callback to free the value.
+ * \return true if \a key was removed.
+ */
+bool BLI_ohash_nd_(remove)(OHashMap *oh, OHASH_KEY_TYPE key, OHashFreeFP valfreefp)
+{
+  const uint old_length = oh->length;
+  void *value = BLI_ohash_nd_(popkey)(oh, key);
+  if (valfreefp && value) {
+    valfreefp(value);
+  }
+  return old_length > oh->length;
+}
+
+/**
+ * Remove \a key from the oh, returning its value or NULL if the key wasn't found.
+ *
+ * \note The last entry is moved into the place of the removed one,
+ * so the order of iteration changes.
+ */
+void *BLI_ohash_nd_(popkey)(OHashMap *oh, OHASH_KEY_TYPE key)
+{
+  const uint32_t hash = OHASH_KEY_HASH(key);
+
+  ITER_SLOTS (oh, hash, slot, index) {
+    if (INDEX_HAS_KEY(oh, index, hash, key)) {
+      void *value = oh->entries[index].value;
+      oh->length--;
+      oh->dummy_count++;
+      oh->map[slot] = SLOT_DUMMY;
+      if ((uint)index < oh->length) {
+        oh->entries[index] = oh->entries[oh->length];
+        ohash_change_index(
+            oh, ENTRY_HASH(&oh->entries[index]), (int)oh->length, (int)index);
+      }
+      return value;
+    }
+    else if (index == SLOT_EMPTY) {
+      return NULL;
+    }
+  }
+}
+
+bool BLI_ohash_nd_(haskey)(const OHashMap *oh, OHASH_KEY_TYPE key)
+{
+  return ohash_lookup_entry(oh, key) != NULL;
+}
+
+uint BLI_ohash_nd_(len)(const OHashMap *oh)
+{
+  return oh->length;
+}
+
+/**
+ * Remove all keys, keeping room for \a nentries_reserve keys.
+ */
+void BLI_ohash_nd_(clear_ex)(OHashMap *oh, OHashFreeFP valfreefp, const uint nentries_reserve)
+{
+  ohash_free_values(oh, valfreefp);
+  oh->length = 0;
+
+  const uint capacity_exp = calc_capacity_exp_for_reserve(nentries_reserve);
+  if (capacity_exp != oh->capacity_exp) {
+    ohash_resize(oh, capacity_exp);
+  }
+  else {
+    ohash_rebuild_map(oh);
+  }
+}
+
+void BLI_ohash_nd_(clear)(OHashMap *oh, OHashFreeFP valfreefp)
+{
+  BLI_ohash_nd_(clear_ex)(oh, valfreefp, 1 << CAPACITY_EXP_DEFAULT);
+}
+
+void BLI_ohash_nd_(iter_init)(OHashMapIterator *iter, OHashMap *oh)
+{
+  iter->entries = oh->entries;
+  iter->length = oh->length;
+  iter->index = 0;
+}
+
+/** \} */
@@ -0,0 +1,34 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_utildefines.h"
+
+#include "BLI_ghash.h"
+
+#define OHASH_PREFIX_ID BLI_strmap
+#define OHASH_KEY_TYPE const char *
+#define OHASH_STORE_HASH
+#define OHashMap StrMap
+#define OHashMapEntry StrMapEntry
+#define OHashMapIterator StrMapIterator
+#define OHASH_KEY_HASH(key) ((uint32_t)BLI_ghashutil_strhash_p(key))
+#define OHASH_KEY_EQ(key_a, key_b) (((key_a) == (key_b)) || STREQ(key_a, key_b))
+#include "openhash_impl.h"
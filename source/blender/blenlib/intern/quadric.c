@@ -124,19 +124,34 @@ void BLI_quadric_clear(Quadric *q)
   memset(q, 0, sizeof(*q));
 }
 
+/* Quadrics are accumulated in the inner loops of decimation, these use fixed size forward loops
+ * over non-aliasing arrays (rather than the generic `_vn_` functions) so they vectorize. */
+
 void BLI_quadric_add_qu_qu(Quadric *a, const Quadric *b)
 {
-  add_vn_vn_d((double *)a, (double *)b, QUADRIC_FLT_TOT);
+  double *__restrict a_db = (double *)a;
+  const double *__restrict b_db = (const double *)b;
+  for (uint i = 0; i < QUADRIC_FLT_TOT; i++) {
+    a_db[i] += b_db[i];
+  }
 }
 
 void BLI_quadric_add_qu_ququ(Quadric *r, const Quadric *a, const Quadric *b)
 {
-  add_vn_vnvn_d((double *)r, (const double *)a, (const double *)b, QUADRIC_FLT_TOT);
+  double *__restrict r_db = (double *)r;
+  const double *__restrict a_db = (const double *)a;
+  const double *__restrict b_db = (const double *)b;
+  for (uint i = 0; i < QUADRIC_FLT_TOT; i++) {
+    r_db[i] = a_db[i] + b_db[i];
+  }
 }
 
 void BLI_quadric_mul(Quadric *a, const double scalar)
 {
-  mul_vn_db((double *)a, QUADRIC_FLT_TOT, scalar);
+  double *__restrict a_db = (double *)a;
+  for (uint i = 0; i < QUADRIC_FLT_TOT; i++) {
+    a_db[i] *= scalar;
+  }
 }
 
 double BLI_quadric_evaluate(const Quadric *q, const double v[3])
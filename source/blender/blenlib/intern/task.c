@@ -58,6 +58,22 @@
  */
 #define DELAYED_QUEUE_SIZE 4096
 
+/* Number of tasks which fit into a per-thread work-stealing deque.
+ *
+ * Must be a power of two. When deque is full tasks are pushed to the
+ * scheduler's global queue. More details can be found at TaskDeque.
+ */
+#define TASK_DEQUE_SIZE 1024
+#define TASK_DEQUE_MASK (TASK_DEQUE_SIZE - 1)
+
+/* Maximum number of tasks from parent pools which a thread executes recursively
+ * while waiting for nested pools.
+ *
+ * Every such task is executed on top of the stack of the waiting one, so this
+ * avoids stack overflow with deeply nested pools.
+ */
+#define NESTED_POOL_MAX_DEPTH 32
+
 #ifndef NDEBUG
 #  define ASSERT_THREAD_ID(scheduler, thread_id) \
     do { \
@@ -155,11 +171,56 @@ typedef struct TaskThreadLocalStorage {
   bool do_delayed_push;
   int num_delayed_queue;
   Task *delayed_queue[DELAYED_QUEUE_SIZE];
+
+  /* Pool of the task which is currently executed by this thread, pools created
+   * from within this task are nested into this pool.
+   */
+  TaskPool *running_pool;
+  /* Number of tasks from parent pools executed from within work_and_wait()
+   * which are currently on the stack of this thread.
+   */
+  int nested_depth;
 } TaskThreadLocalStorage;
 
+/* Lock-free work-stealing deque (Chase-Lev), one per scheduler thread.
+ *
+ * Only the owner thread pushes and pops at the bottom of the deque, other
+ * threads steal from the top. This avoids going through the scheduler's
+ * global queue mutex for tasks pushed from within other tasks.
+ *
+ * The pool of every task is stored next to the task pointer, so threads which
+ * are only allowed to run tasks of a specific pool (work_and_wait(), cancel())
+ * can check the slot without touching memory of a task which might have been
+ * executed and freed by another thread already.
+ *
+ * The deque has a fixed size and never grows, which avoids any memory
+ * reclamation issues: it is up to the caller to fall back to the global queue
+ * when the push fails.
+ */
+typedef struct TaskDequeSlot {
+  Task *task;
+  TaskPool *pool;
+} TaskDequeSlot;
+
+typedef struct TaskDeque {
+  /* Index of the oldest task, advanced by stealing threads using CAS. */
+  int64_t top;
+  /* Keep top and bottom on separate cache lines. */
+  char pad[64 - sizeof(int64_t)];
+  /* Index past the newest task, only modified by the owner thread. */
+  int64_t bottom;
+  TaskDequeSlot slots[TASK_DEQUE_SIZE];
+} TaskDeque;
+
 struct TaskPool {
   TaskScheduler *scheduler;
 
+  /* Pool of the task from within which this pool was created, if any.
+   * While waiting for tasks of this pool to be done, tasks of the parent pools
+   * are executed instead of sleeping.
+   */
+  TaskPool *parent;
+
   volatile size_t num;
   ThreadMutex num_mutex;
   ThreadCondition num_cond;
@@ -217,6 +278,17 @@ struct TaskScheduler {
 
   volatile bool do_exit;
 
+  /* When set, tasks pushed from scheduler threads go to their work-stealing
+   * deques. Disabled in the background-only mode, where the single worker
+   * thread must only pick up tasks from background pools.
+   */
+  bool use_deques;
+  /* Number of worker threads which are about to sleep or are sleeping on
+   * queue_cond. Used to avoid locking queue_mutex when pushing to a deque
+   * while all workers are busy.
+   */
+  int num_sleeping;
+
   /* NOTE: In pthread's TLS we store the whole TaskThread structure. */
   pthread_key_t tls_id_key;
 };
@@ -225,6 +297,7 @@ typedef struct TaskThread {
   TaskScheduler *scheduler;
   int id;
   TaskThreadLocalStorage tls;
+  TaskDeque deque;
 } TaskThread;
 
 /* Helper */
@@ -326,6 +399,88 @@ static void task_free(TaskPool *pool, Task *task, const int thread_id)
   }
 }
 
+/* Work-stealing deque */
+
+BLI_INLINE void task_deque_init(TaskDeque *deque)
+{
+  deque->top = 0;
+  deque->bottom = 0;
+}
+
+/* Push task to the bottom of the deque, must only be called by the owner thread.
+ * Returns false if there is no space left in the deque. */
+static bool task_deque_push(TaskDeque *deque, Task *task)
+{
+  const int64_t bottom = deque->bottom;
+  const int64_t top = *(volatile int64_t *)&deque->top;
+  if (bottom - top >= TASK_DEQUE_SIZE) {
+    return false;
+  }
+  TaskDequeSlot *slot = &deque->slots[bottom & TASK_DEQUE_MASK];
+  slot->task = task;
+  slot->pool = task->pool;
+  /* Full barrier, ensures slot is visible to other threads before the new bottom. */
+  atomic_add_and_fetch_int64(&deque->bottom, 1);
+  return true;
+}
+
+/* Pop the newest task from the bottom of the deque, must only be called by the owner thread. */
+static Task *task_deque_pop(TaskDeque *deque)
+{
+  const int64_t bottom = deque->bottom - 1;
+  /* Only the owner adds tasks, so an empty deque can not become non-empty behind our back. */
+  if (bottom < *(volatile int64_t *)&deque->top) {
+    return NULL;
+  }
+  /* Full barrier, new bottom must be visible to thieves before top is read. */
+  atomic_sub_and_fetch_int64(&deque->bottom, 1);
+  const int64_t top = *(volatile int64_t *)&deque->top;
+  Task *task = deque->slots[bottom & TASK_DEQUE_MASK].task;
+  if (top < bottom) {
+    return task;
+  }
+  if (top == bottom) {
+    /* This is the last task in the deque, race against thieves for it. */
+    if (atomic_cas_int64(&deque->top, top, top + 1) != top) {
+      task = NULL;
+    }
+  }
+  else {
+    /* Last task has been stolen already. */
+    task = NULL;
+  }
+  *(volatile int64_t *)&deque->bottom = bottom + 1;
+  return task;
+}
+
+/* Steal the oldest task from the top of the deque, can be called from any thread.
+ * If pool is not NULL only a task of that pool will be stolen. */
+static Task *task_deque_steal(TaskDeque *deque, TaskPool *pool)
+{
+  for (;;) {
+    /* Cheap check first, so idle threads scanning all deques do not write to shared memory. */
+    if (*(volatile int64_t *)&deque->bottom <= *(volatile int64_t *)&deque->top) {
+      return NULL;
+    }
+    /* Full barrier, top must be read before bottom. */
+    const int64_t top = atomic_fetch_and_add_int64(&deque->top, 0);
+    const int64_t bottom = *(volatile int64_t *)&deque->bottom;
+    if (top >= bottom) {
+      return NULL;
+    }
+    /* The slot can only be re-used by the owner once top has moved past it, in which case the
+     * CAS below fails and values read here are ignored. */
+    volatile TaskDequeSlot *slot = &deque->slots[top & TASK_DEQUE_MASK];
+    Task *task = slot->task;
+    if (pool != NULL && slot->pool != pool) {
+      return NULL;
+    }
+    if (atomic_cas_int64(&deque->top, top, top + 1) == top) {
+      return task;
+    }
+  }
+}
+
 /* Task Scheduler */
 
 static void task_pool_num_decrease(TaskPool *pool, size_t done)
@@ -353,14 +508,149 @@ static void task_pool_num_increase(TaskPool *pool, size_t new)
   BLI_mutex_unlock(&pool->num_mutex);
 }
 
-static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, Task **task)
+/* Wake up worker threads after tasks were pushed to a deque. */
+static void task_scheduler_notify_sleeping(TaskScheduler *scheduler, const bool notify_all)
 {
-  bool found_task = false;
+  /* NOTE: Pushing to a deque implies a full barrier, so there is no need in
+   * atomic read here. Worker threads increment the counter before their last
+   * check of the deques, so they either see the new task or get notified. */
+  if (*(volatile int *)&scheduler->num_sleeping == 0) {
+    return;
+  }
   BLI_mutex_lock(&scheduler->queue_mutex);
+  if (notify_all) {
+    BLI_condition_notify_all(&scheduler->queue_cond);
+  }
+  else {
+    BLI_condition_notify_one(&scheduler->queue_cond);
+  }
+  BLI_mutex_unlock(&scheduler->queue_mutex);
+}
 
-  while (!scheduler->queue.first && !scheduler->do_exit) {
-    BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+/* Steal a task from deques of all threads, starting with the one next to the given thread.
+ * If pool is not NULL only tasks of that pool are stolen. */
+static Task *task_scheduler_steal(TaskScheduler *scheduler, TaskPool *pool, const int thread_id)
+{
+  const int num_deques = scheduler->num_threads + 1;
+  for (int i = 1; i <= num_deques; i++) {
+    TaskDeque *deque = &scheduler->task_threads[(thread_id + i) % num_deques].deque;
+    Task *task = task_deque_steal(deque, pool);
+    if (task != NULL) {
+      return task;
+    }
   }
+  return NULL;
+}
+
+/* Add task to the global queue, the task is expected to be accounted in its pool already. */
+static void task_scheduler_queue_add(TaskScheduler *scheduler, Task *task, TaskPriority priority)
+{
+  BLI_mutex_lock(&scheduler->queue_mutex);
+
+  if (priority == TASK_PRIORITY_HIGH) {
+    BLI_addhead(&scheduler->queue, task);
+  }
+  else {
+    BLI_addtail(&scheduler->queue, task);
+  }
+
+  BLI_condition_notify_one(&scheduler->queue_cond);
+  BLI_mutex_unlock(&scheduler->queue_mutex);
+}
+
+/* Pop a task of the given pool from the deque owned by the calling thread.
+ * If use_parent is set, tasks of the pool this one is nested into are popped as well.
+ *
+ * Tasks of other pools found at the bottom of the deque are moved to the global
+ * queue, so they are not stuck behind a thread which waits for its own pool. */
+static Task *task_scheduler_deque_pop_for_pool(TaskScheduler *scheduler,
+                                               TaskDeque *deque,
+                                               TaskPool *pool,
+                                               const bool use_parent)
+{
+  Task *task;
+  while ((task = task_deque_pop(deque)) != NULL) {
+    if (task->pool == pool || (use_parent && task->pool == pool->parent)) {
+      return task;
+    }
+    task_scheduler_queue_add(scheduler, task, TASK_PRIORITY_HIGH);
+  }
+  return NULL;
+}
+
+/* Find a task to be executed by a thread which waits for the given pool.
+ *
+ * Tasks of the pool itself are preferred. If there are none and use_parent is set,
+ * a task of the pool this one is nested into is returned, so the waiting thread keeps
+ * doing useful work instead of sleeping. */
+static Task *task_scheduler_pop_for_pool(TaskScheduler *scheduler,
+                                         TaskDeque *deque,
+                                         TaskPool *pool,
+                                         const bool use_parent)
+{
+  Task *task = NULL;
+
+  if (deque != NULL) {
+    task = task_scheduler_deque_pop_for_pool(scheduler, deque, pool, use_parent);
+    if (task != NULL) {
+      return task;
+    }
+  }
+
+  if (scheduler->use_deques) {
+    task = task_scheduler_steal(scheduler, pool, pool->thread_id);
+    if (task == NULL && use_parent) {
+      task = task_scheduler_steal(scheduler, pool->parent, pool->thread_id);
+    }
+    if (task != NULL) {
+      return task;
+    }
+  }
+
+  BLI_mutex_lock(&scheduler->queue_mutex);
+
+  Task *parent_task = NULL;
+  for (Task *current_task = scheduler->queue.first; current_task != NULL;
+       current_task = current_task->next) {
+    if (current_task->pool == pool) {
+      task = current_task;
+      break;
+    }
+    if (parent_task == NULL && use_parent && current_task->pool == pool->parent) {
+      parent_task = current_task;
+    }
+  }
+  if (task == NULL) {
+    task = parent_task;
+  }
+  if (task != NULL) {
+    BLI_remlink(&scheduler->queue, task);
+  }
+
+  BLI_mutex_unlock(&scheduler->queue_mutex);
+
+  return task;
+}
+
+static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler,
+                                           TaskThread *thread,
+                                           Task **task)
+{
+  bool found_task = false;
+
+  /* Tasks pushed by this thread first, then try to steal from other threads.
+   * Both do not involve any locks. */
+  if (scheduler->use_deques) {
+    *task = task_deque_pop(&thread->deque);
+    if (*task == NULL) {
+      *task = task_scheduler_steal(scheduler, NULL, thread->id);
+    }
+    if (*task != NULL) {
+      return true;
+    }
+  }
+
+  BLI_mutex_lock(&scheduler->queue_mutex);
 
   do {
     Task *current_task;
@@ -394,7 +684,20 @@ static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, Task **task
       BLI_remlink(&scheduler->queue, *task);
       break;
     }
-    if (!found_task) {
+    if (!found_task && scheduler->use_deques) {
+      /* Announce that we are going to sleep before the last check of the deques,
+       * so threads pushing to a deque after this check will notify us. */
+      atomic_add_and_fetch_int32(&scheduler->num_sleeping, 1);
+      *task = task_scheduler_steal(scheduler, NULL, thread->id);
+      if (*task != NULL) {
+        found_task = true;
+      }
+      else {
+        BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+      }
+      atomic_sub_and_fetch_int32(&scheduler->num_sleeping, 1);
+    }
+    else if (!found_task) {
       BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
     }
   } while (!found_task);
@@ -404,6 +707,14 @@ static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, Task **task
   return true;
 }
 
+BLI_INLINE void task_run(TaskThreadLocalStorage *tls, Task *task, const int thread_id)
+{
+  TaskPool *previous_running_pool = tls->running_pool;
+  tls->running_pool = task->pool;
+  task->run(task->pool, task->taskdata, thread_id);
+  tls->running_pool = previous_running_pool;
+}
+
 BLI_INLINE void handle_local_queue(TaskThreadLocalStorage *tls, const int thread_id)
 {
   BLI_assert(!tls->do_delayed_push);
@@ -417,7 +728,7 @@ BLI_INLINE void handle_local_queue(TaskThreadLocalStorage *tls, const int thread
      * pool tasks.
      */
     TaskPool *local_pool = local_task->pool;
-    local_task->run(local_pool, local_task->taskdata, thread_id);
+    task_run(tls, local_task, thread_id);
     task_free(local_pool, local_task, thread_id);
   }
   BLI_assert(!tls->do_delayed_push);
@@ -442,12 +753,12 @@ static void *task_scheduler_thread_run(void *thread_p)
   BLI_mutex_unlock(&scheduler->startup_mutex);
 
   /* keep popping off tasks */
-  while (task_scheduler_thread_wait_pop(scheduler, &task)) {
+  while (task_scheduler_thread_wait_pop(scheduler, thread, &task)) {
     TaskPool *pool = task->pool;
 
     /* run task */
     BLI_assert(!tls->do_delayed_push);
-    task->run(pool, task->taskdata, thread_id);
+    task_run(tls, task, thread_id);
     BLI_assert(!tls->do_delayed_push);
 
     /* delete task */
@@ -496,9 +807,18 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
   scheduler->task_threads = MEM_mallocN(sizeof(TaskThread) * (num_threads + 1),
                                         "TaskScheduler task threads");
 
+  scheduler->use_deques = !scheduler->background_thread_only;
+  scheduler->num_sleeping = 0;
+
   /* Initialize TLS for main thread. */
   initialize_task_tls(&scheduler->task_threads[0].tls);
 
+  /* Deques of all threads are to be initialized before any of the threads is
+   * started, since worker threads steal from each other. */
+  for (int i = 0; i < num_threads + 1; i++) {
+    task_deque_init(&scheduler->task_threads[i].deque);
+  }
+
   pthread_key_create(&scheduler->tls_id_key, NULL);
 
   /* launch threads that will be waiting for work */
@@ -564,6 +884,14 @@ void BLI_task_scheduler_free(TaskScheduler *scheduler)
     for (int i = 0; i < scheduler->num_threads + 1; i++) {
       TaskThreadLocalStorage *tls = &scheduler->task_threads[i].tls;
       free_task_tls(tls);
+
+      /* Leftover tasks in the work-stealing deque. */
+      TaskDeque *deque = &scheduler->task_threads[i].deque;
+      for (int64_t index = deque->top; index < deque->bottom; index++) {
+        task = deque->slots[index & TASK_DEQUE_MASK].task;
+        task_data_free(task, 0);
+        MEM_freeN(task);
+      }
     }
 
     MEM_freeN(scheduler->task_threads);
@@ -594,21 +922,14 @@ static void task_scheduler_push(TaskScheduler *scheduler, Task *task, TaskPriori
   task_pool_num_increase(task->pool, 1);
 
   /* add task to queue */
-  BLI_mutex_lock(&scheduler->queue_mutex);
-
-  if (priority == TASK_PRIORITY_HIGH) {
-    BLI_addhead(&scheduler->queue, task);
-  }
-  else {
-    BLI_addtail(&scheduler->queue, task);
-  }
-
-  BLI_condition_notify_one(&scheduler->queue_cond);
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+  task_scheduler_queue_add(scheduler, task, priority);
 }
 
+/* Push all given tasks at once. When deque is not NULL, it is filled first and
+ * only tasks which did not fit into it go to the global queue. */
 static void task_scheduler_push_all(TaskScheduler *scheduler,
                                     TaskPool *pool,
+                                    TaskDeque *deque,
                                     Task **tasks,
                                     int num_tasks)
 {
@@ -618,6 +939,16 @@ static void task_scheduler_push_all(TaskScheduler *scheduler,
 
   task_pool_num_increase(pool, num_tasks);
 
+  if (deque != NULL) {
+    while (num_tasks > 0 && task_deque_push(deque, tasks[num_tasks - 1])) {
+      num_tasks--;
+    }
+    task_scheduler_notify_sleeping(scheduler, true);
+    if (num_tasks == 0) {
+      return;
+    }
+  }
+
   BLI_mutex_lock(&scheduler->queue_mutex);
 
   for (int i = 0; i < num_tasks; i++) {
@@ -649,6 +980,18 @@ static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
 
   BLI_mutex_unlock(&scheduler->queue_mutex);
 
+  /* Discard tasks of this pool which are at the top of work-stealing deques.
+   * Remaining ones will be executed by the deque owners, same as tasks from
+   * the local queues. */
+  if (scheduler->use_deques) {
+    while ((task = task_scheduler_steal(scheduler, pool, pool->thread_id)) != NULL) {
+      task_data_free(task, pool->thread_id);
+      MEM_freeN(task);
+
+      done++;
+    }
+  }
+
   /* notify done */
   task_pool_num_decrease(pool, done);
 }
@@ -685,6 +1028,7 @@ static TaskPool *task_pool_create_ex(TaskScheduler *scheduler,
   pool->suspended_queue.first = pool->suspended_queue.last = NULL;
   pool->run_in_background = is_background;
   pool->use_local_tls = false;
+  pool->parent = NULL;
 
   BLI_mutex_init(&pool->num_mutex);
   BLI_condition_init(&pool->num_cond);
@@ -715,6 +1059,12 @@ static TaskPool *task_pool_create_ex(TaskScheduler *scheduler,
     }
   }
 
+  /* Pools created from within a running task are nested into the pool of that
+   * task. Background pools are never waited for so they are not nested. */
+  if (!pool->use_local_tls && !is_background) {
+    pool->parent = scheduler->task_threads[pool->thread_id].tls.running_pool;
+  }
+
 #ifdef DEBUG_STATS
   pool->mempool_stats = MEM_callocN(sizeof(*pool->mempool_stats) * (scheduler->num_threads + 1),
                                     "per-taskpool mempool stats");
@@ -801,6 +1151,21 @@ BLI_INLINE bool task_can_use_local_queues(TaskPool *pool, int thread_id)
   return (thread_id != -1 && (thread_id != pool->thread_id || pool->do_work));
 }
 
+/* Get work-stealing deque of the calling thread, NULL if it has none.
+ *
+ * Deque of thread 0 belongs to the main thread. Other threads which are not
+ * managed by the scheduler also identify themselves as thread 0, but they
+ * never drain the deque so they must not push to it.
+ */
+BLI_INLINE TaskDeque *task_pool_get_deque(TaskPool *pool, int thread_id)
+{
+  TaskScheduler *scheduler = pool->scheduler;
+  if (!scheduler->use_deques || (thread_id == 0 && !BLI_thread_is_main())) {
+    return NULL;
+  }
+  return &scheduler->task_threads[thread_id].deque;
+}
+
 static void task_pool_push(TaskPool *pool,
                            TaskRunFunction run,
                            void *taskdata,
@@ -848,6 +1213,21 @@ static void task_pool_push(TaskPool *pool,
       tls->num_delayed_queue++;
       return;
     }
+    /* Push to the work-stealing deque of this thread. It is processed by
+     * this thread once it's done with the current task, idle threads will
+     * steal tasks from it without any locks.
+     */
+    TaskDeque *deque = task_pool_get_deque(pool, thread_id);
+    if (deque != NULL) {
+      task_pool_num_increase(pool, 1);
+      if (task_deque_push(deque, task)) {
+        task_scheduler_notify_sleeping(pool->scheduler, false);
+      }
+      else {
+        task_scheduler_queue_add(pool->scheduler, task, priority);
+      }
+      return;
+    }
   }
   /* Do push to a global execution pool, slowest possible method,
    * causes quite reasonable amount of threading overhead.
@@ -885,16 +1265,33 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 {
   TaskThreadLocalStorage *tls = get_task_tls(pool, pool->thread_id);
   TaskScheduler *scheduler = pool->scheduler;
+  TaskDeque *deque = task_pool_get_deque(pool, pool->thread_id);
 
   if (atomic_fetch_and_and_uint8((uint8_t *)&pool->is_suspended, 0)) {
     if (pool->num_suspended) {
       task_pool_num_increase(pool, pool->num_suspended);
-      BLI_mutex_lock(&scheduler->queue_mutex);
 
-      BLI_movelisttolist(&scheduler->queue, &pool->suspended_queue);
+      /* Move as many tasks as possible to the deque of this thread, other
+       * threads will steal them from there without locking the queue. */
+      if (deque != NULL) {
+        Task *task;
+        while ((task = BLI_pophead(&pool->suspended_queue)) != NULL) {
+          if (!task_deque_push(deque, task)) {
+            BLI_addhead(&pool->suspended_queue, task);
+            break;
+          }
+        }
+        task_scheduler_notify_sleeping(scheduler, true);
+      }
 
-      BLI_condition_notify_all(&scheduler->queue_cond);
-      BLI_mutex_unlock(&scheduler->queue_mutex);
+      if (pool->suspended_queue.first != NULL) {
+        BLI_mutex_lock(&scheduler->queue_mutex);
+
+        BLI_movelisttolist(&scheduler->queue, &pool->suspended_queue);
+
+        BLI_condition_notify_all(&scheduler->queue_cond);
+        BLI_mutex_unlock(&scheduler->queue_mutex);
+      }
 
       pool->num_suspended = 0;
     }
@@ -909,42 +1306,41 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
   BLI_mutex_lock(&pool->num_mutex);
 
   while (pool->num != 0) {
-    Task *task, *work_task = NULL;
-    bool found_task = false;
-
     BLI_mutex_unlock(&pool->num_mutex);
 
-    BLI_mutex_lock(&scheduler->queue_mutex);
-
-    /* find task from this pool. if we get a task from another pool,
-     * we can get into deadlock */
-
-    for (task = scheduler->queue.first; task; task = task->next) {
-      if (task->pool == pool) {
-        work_task = task;
-        found_task = true;
-        BLI_remlink(&scheduler->queue, task);
-        break;
-      }
-    }
-
-    BLI_mutex_unlock(&scheduler->queue_mutex);
+    /* find task from this pool or the pool it is nested into. if we get a
+     * task from any other pool, we can get into deadlock.
+     *
+     * Parent pool is only used while one of its tasks is running on this
+     * thread, which guarantees the parent pool is still alive. */
+    const bool use_parent = (pool->parent != NULL && pool->parent == tls->running_pool &&
+                             tls->nested_depth < NESTED_POOL_MAX_DEPTH);
+    Task *work_task = task_scheduler_pop_for_pool(scheduler, deque, pool, use_parent);
 
     /* if found task, do it, otherwise wait until other tasks are done */
-    if (found_task) {
+    if (work_task != NULL) {
+      TaskPool *work_pool = work_task->pool;
+      const bool is_parent_task = (work_pool != pool);
+
       /* run task */
       BLI_assert(!tls->do_delayed_push);
-      work_task->run(pool, work_task->taskdata, pool->thread_id);
+      if (is_parent_task) {
+        tls->nested_depth++;
+      }
+      task_run(tls, work_task, pool->thread_id);
+      if (is_parent_task) {
+        tls->nested_depth--;
+      }
       BLI_assert(!tls->do_delayed_push);
 
       /* delete task */
-      task_free(pool, task, pool->thread_id);
+      task_free(work_pool, work_task, pool->thread_id);
 
       /* Handle all tasks from local queue. */
       handle_local_queue(tls, pool->thread_id);
 
       /* notify pool task was done */
-      task_pool_num_decrease(pool, 1);
+      task_pool_num_decrease(work_pool, 1);
     }
 
     BLI_mutex_lock(&pool->num_mutex);
@@ -952,7 +1348,7 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
       break;
     }
 
-    if (!found_task) {
+    if (work_task == NULL) {
       BLI_condition_wait(&pool->num_cond, &pool->num_mutex);
     }
   }
@@ -1016,7 +1412,11 @@ void BLI_task_pool_delayed_push_end(TaskPool *pool, int thread_id)
     ASSERT_THREAD_ID(pool->scheduler, thread_id);
     TaskThreadLocalStorage *tls = get_task_tls(pool, thread_id);
     BLI_assert(tls->do_delayed_push);
-    task_scheduler_push_all(pool->scheduler, pool, tls->delayed_queue, tls->num_delayed_queue);
+    task_scheduler_push_all(pool->scheduler,
+                            pool,
+                            task_pool_get_deque(pool, thread_id),
+                            tls->delayed_queue,
+                            tls->num_delayed_queue);
     tls->do_delayed_push = false;
     tls->num_delayed_queue = 0;
   }
@@ -1068,6 +1468,8 @@ typedef struct TaskParallelRangeState {
 
   /* Function called from calling thread once whole range have been processed. */
   TaskParallelFinalizeFunc func_finalize;
+  /* Function joining 'tls' copies into initial_tls_memory once whole range have been processed. */
+  TaskParallelReduceFunc func_reduce;
 
   /* Current value of the iterator, shared between all threads (atomically updated). */
   int iter_value;
@@ -1257,6 +1659,9 @@ static void parallel_range_single_thread(TaskParallelRangePool *range_pool)
     for (int i = start; i < stop; i++) {
       func(userdata, i, &tls);
     }
+    if (use_tls_data && state->func_reduce != NULL) {
+      state->func_reduce(userdata, initial_tls_memory, flatten_tls_storage);
+    }
     if (state->func_finalize != NULL) {
       state->func_finalize(userdata, flatten_tls_storage);
     }
@@ -1292,6 +1697,7 @@ void BLI_task_parallel_range(const int start,
       .initial_tls_memory = settings->userdata_chunk,
       .tls_data_size = settings->userdata_chunk_size,
       .func_finalize = settings->func_finalize,
+      .func_reduce = settings->func_reduce,
   };
   TaskParallelRangePool range_pool = {
       .pool = NULL, .parallel_range_states = &state, .current_state = NULL, .settings = settings};
@@ -1359,6 +1765,12 @@ void BLI_task_parallel_range(const int start,
   BLI_task_pool_free(task_pool);
 
   if (use_tls_data) {
+    if (settings->func_reduce != NULL) {
+      for (i = 0; i < num_tasks; i++) {
+        void *userdata_chunk_local = (char *)flatten_tls_storage + (tls_data_size * (size_t)i);
+        settings->func_reduce(userdata, tls_data, userdata_chunk_local);
+      }
+    }
     if (settings->func_finalize != NULL) {
       for (i = 0; i < num_tasks; i++) {
         void *userdata_chunk_local = (char *)flatten_tls_storage + (tls_data_size * (size_t)i);
@@ -1383,6 +1795,7 @@ TaskParallelRangePool *BLI_task_parallel_range_pool_init(const TaskParallelSetti
 
   BLI_assert(settings->userdata_chunk == NULL);
   BLI_assert(settings->func_finalize == NULL);
+  BLI_assert(settings->func_reduce == NULL);
   range_pool->settings = MEM_mallocN(sizeof(*range_pool->settings), __func__);
   *range_pool->settings = *settings;
 
@@ -1422,6 +1835,7 @@ void BLI_task_parallel_range_pool_push(TaskParallelRangePool *range_pool,
   state->initial_tls_memory = settings->userdata_chunk;
   state->tls_data_size = settings->userdata_chunk_size;
   state->func_finalize = settings->func_finalize;
+  state->func_reduce = settings->func_reduce;
 
   state->next = range_pool->parallel_range_states;
   range_pool->parallel_range_states = state;
@@ -1436,7 +1850,12 @@ static void parallel_range_func_finalize(TaskPool *__restrict pool,
 
   for (int i = 0; i < range_pool->num_tasks; i++) {
     void *tls_data = (char *)state->flatten_tls_storage + (state->tls_data_size * (size_t)i);
-    state->func_finalize(state->userdata_shared, tls_data);
+    if (state->func_reduce != NULL) {
+      state->func_reduce(state->userdata_shared, state->initial_tls_memory, tls_data);
+    }
+    if (state->func_finalize != NULL) {
+      state->func_finalize(state->userdata_shared, tls_data);
+    }
   }
 }
 
@@ -1526,7 +1945,7 @@ void BLI_task_parallel_range_pool_work_and_wait(TaskParallelRangePool *range_poo
       continue;
     }
 
-    if (state->func_finalize != NULL) {
+    if (state->func_finalize != NULL || state->func_reduce != NULL) {
       BLI_task_pool_push_from_thread(task_pool,
                                      parallel_range_func_finalize,
                                      state,
@@ -1573,6 +1992,240 @@ void BLI_task_parallel_range_pool_free(TaskParallelRangePool *range_pool)
   MEM_freeN(range_pool);
 }
 
+/* Parallel scan and compaction routines
+ *
+ * Both are done in three passes: every block of the range is processed
+ * independently, then offsets of the blocks are computed from the per-block
+ * results, and finally each block is processed again knowing its offset.
+ */
+
+/* Minimum number of items in a block, below that threading is not worth it. */
+#define PARALLEL_SCAN_MIN_BLOCK_SIZE 4096
+
+typedef struct TaskParallelScanState {
+  int start, len;
+  int block_size;
+  /* Per-block sums or counts, turned into offsets by the middle pass. */
+  int *block_offsets;
+
+  /* Prefix sum. */
+  const int *src;
+  int *dst;
+  bool exclusive;
+
+  /* Compaction. */
+  void *userdata;
+  TaskParallelFilterFunc filter_func;
+  int *block_indices;
+  int *r_indices;
+} TaskParallelScanState;
+
+/* Get number of blocks to split given amount of items into, 1 meaning no threading. */
+static int parallel_scan_num_blocks_get(const int len,
+                                        const TaskParallelSettings *settings,
+                                        int *r_block_size)
+{
+  if (!settings->use_threading || len <= 0) {
+    *r_block_size = len;
+    return 1;
+  }
+  TaskScheduler *task_scheduler = BLI_task_scheduler_get();
+  const int num_threads = BLI_task_scheduler_num_threads(task_scheduler);
+  const int min_block_size = max_ii(settings->min_iter_per_thread, PARALLEL_SCAN_MIN_BLOCK_SIZE);
+  /* Few more blocks than threads, to compensate for uneven load. */
+  const int num_blocks = max_ii(1, min_ii(num_threads * 4, len / min_block_size));
+  *r_block_size = (len + num_blocks - 1) / num_blocks;
+  return (len + *r_block_size - 1) / *r_block_size;
+}
+
+static void parallel_scan_run(TaskParallelScanState *state,
+                              const int num_blocks,
+                              TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, num_blocks, state, func, &settings);
+}
+
+/* Turn per-block values into exclusive offsets, returns the total. */
+static int parallel_scan_block_offsets(int *block_offsets, const int num_blocks)
+{
+  int offset = 0;
+  for (int i = 0; i < num_blocks; i++) {
+    const int value = block_offsets[i];
+    block_offsets[i] = offset;
+    offset += value;
+  }
+  return offset;
+}
+
+static void parallel_prefix_sum_block_sum_func(void *__restrict userdata,
+                                               const int block,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TaskParallelScanState *state = userdata;
+  const int start = block * state->block_size;
+  const int stop = min_ii(start + state->block_size, state->len);
+  int sum = 0;
+  for (int i = start; i < stop; i++) {
+    sum += state->src[i];
+  }
+  state->block_offsets[block] = sum;
+}
+
+BLI_INLINE int parallel_prefix_sum_block(
+    const int *src, int *dst, const int start, const int stop, int sum, const bool exclusive)
+{
+  if (exclusive) {
+    for (int i = start; i < stop; i++) {
+      const int value = src[i];
+      dst[i] = sum;
+      sum += value;
+    }
+  }
+  else {
+    for (int i = start; i < stop; i++) {
+      sum += src[i];
+      dst[i] = sum;
+    }
+  }
+  return sum;
+}
+
+static void parallel_prefix_sum_block_scan_func(void *__restrict userdata,
+                                                const int block,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TaskParallelScanState *state = userdata;
+  const int start = block * state->block_size;
+  const int stop = min_ii(start + state->block_size, state->len);
+  parallel_prefix_sum_block(
+      state->src, state->dst, start, stop, state->block_offsets[block], state->exclusive);
+}
+
+/**
+ * Compute prefix sum of \a src into \a dst, which may be the same array.
+ *
+ * With \a exclusive, every item of \a dst receives the sum of all previous items of \a src,
+ * otherwise the item itself is included as well. Exclusive scan is handy to compute offsets
+ * from element counts, e.g. to build compact (CSR) adjacency arrays.
+ *
+ * \return Sum of all items of \a src.
+ */
+int BLI_task_parallel_prefix_sum_int(const int *src,
+                                     int *dst,
+                                     const int len,
+                                     const bool exclusive,
+                                     const TaskParallelSettings *settings)
+{
+  int block_size;
+  const int num_blocks = parallel_scan_num_blocks_get(len, settings, &block_size);
+
+  if (num_blocks == 1) {
+    return parallel_prefix_sum_block(src, dst, 0, len, 0, exclusive);
+  }
+
+  int *block_offsets = MEM_mallocN(sizeof(*block_offsets) * (size_t)num_blocks, __func__);
+  TaskParallelScanState state = {
+      .len = len,
+      .block_size = block_size,
+      .block_offsets = block_offsets,
+      .src = src,
+      .dst = dst,
+      .exclusive = exclusive,
+  };
+
+  parallel_scan_run(&state, num_blocks, parallel_prefix_sum_block_sum_func);
+  const int total = parallel_scan_block_offsets(block_offsets, num_blocks);
+  parallel_scan_run(&state, num_blocks, parallel_prefix_sum_block_scan_func);
+
+  MEM_freeN(block_offsets);
+  return total;
+}
+
+static void parallel_filter_block_gather_func(void *__restrict userdata,
+                                              const int block,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TaskParallelScanState *state = userdata;
+  const int start = block * state->block_size;
+  const int stop = min_ii(start + state->block_size, state->len);
+  int *indices = state->block_indices + start;
+  int count = 0;
+  for (int i = start; i < stop; i++) {
+    const int iter = state->start + i;
+    if (state->filter_func(state->userdata, iter)) {
+      indices[count++] = iter;
+    }
+  }
+  state->block_offsets[block] = count;
+}
+
+static void parallel_filter_block_copy_func(void *__restrict userdata,
+                                            const int block,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TaskParallelScanState *state = userdata;
+  const int start = block * state->block_size;
+  const int offset = state->block_offsets[block];
+  const int count = state->block_offsets[block + 1] - offset;
+  memcpy(state->r_indices + offset, state->block_indices + start, sizeof(int) * (size_t)count);
+}
+
+/**
+ * Store all values of the [start, stop[ range for which \a func returns true into
+ * \a r_indices, in increasing order.
+ *
+ * \a r_indices must be large enough to hold all values of the range.
+ * \return Number of values stored in \a r_indices.
+ */
+int BLI_task_parallel_filter_indices(const int start,
+                                     const int stop,
+                                     void *userdata,
+                                     TaskParallelFilterFunc func,
+                                     int *r_indices,
+                                     const TaskParallelSettings *settings)
+{
+  BLI_assert(start <= stop);
+  const int len = stop - start;
+  int block_size;
+  const int num_blocks = parallel_scan_num_blocks_get(len, settings, &block_size);
+
+  if (num_blocks == 1) {
+    int count = 0;
+    for (int iter = start; iter < stop; iter++) {
+      if (func(userdata, iter)) {
+        r_indices[count++] = iter;
+      }
+    }
+    return count;
+  }
+
+  /* One more offset, so the end of every block is known in the copy pass. */
+  int *block_offsets = MEM_mallocN(sizeof(*block_offsets) * (size_t)(num_blocks + 1), __func__);
+  int *block_indices = MEM_mallocN(sizeof(*block_indices) * (size_t)len, __func__);
+  TaskParallelScanState state = {
+      .start = start,
+      .len = len,
+      .block_size = block_size,
+      .block_offsets = block_offsets,
+      .userdata = userdata,
+      .filter_func = func,
+      .block_indices = block_indices,
+      .r_indices = r_indices,
+  };
+
+  parallel_scan_run(&state, num_blocks, parallel_filter_block_gather_func);
+  const int total = parallel_scan_block_offsets(block_offsets, num_blocks);
+  block_offsets[num_blocks] = total;
+  parallel_scan_run(&state, num_blocks, parallel_filter_block_copy_func);
+
+  MEM_freeN(block_indices);
+  MEM_freeN(block_offsets);
+  return total;
+}
+
 typedef struct TaskParallelIteratorState {
   void *userdata;
   TaskParallelIteratorIterFunc iter_func;
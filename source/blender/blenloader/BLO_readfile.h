@@ -96,6 +96,7 @@ BlendFileData *BLO_read_from_memory(const void *mem,
 BlendFileData *BLO_read_from_memfile(struct Main *oldmain,
                                      const char *filename,
                                      struct MemFile *memfile,
+                                     const struct MemFile *memfile_current,
                                      eBLOReadSkip skip_flags,
                                      struct ReportList *reports);
 
@@ -151,6 +152,8 @@ int BLO_library_link_copypaste(struct Main *mainl,
 
 void *BLO_library_read_struct(struct FileData *fd, struct BHead *bh, const char *blockname);
 
+void BLO_library_filedata_cache_clear(void);
+
 /* internal function but we need to expose it */
 void blo_lib_link_restore(struct Main *oldmain,
                           struct Main *newmain,
@@ -25,6 +25,7 @@
  * \ingroup blenloader
  */
 
+struct GHash;
 struct Scene;
 
 typedef struct {
@@ -32,6 +33,8 @@ typedef struct {
   const char *buf;
   /** Size in bytes. */
   unsigned int size;
+  /** Hash of the contents of #MemFileChunk.buf, to find identical chunks at other positions. */
+  unsigned int hash;
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
 } MemFileChunk;
@@ -47,20 +50,37 @@ typedef struct MemFileUndoData {
   size_t undo_size;
 } MemFileUndoData;
 
+/** State used while writing a #MemFile, de-duplicating its chunks with a reference #MemFile. */
+typedef struct MemFileWriteData {
+  MemFile *written_memfile;
+  MemFile *reference_memfile;
+
+  /** The chunk of the reference at the same position as the next chunk to write. */
+  MemFileChunk *reference_current_chunk;
+  /** #MemFileChunk.hash -> #MemFileChunk of the reference, for chunks that moved. */
+  struct GHash *reference_chunks_hash;
+} MemFileWriteData;
+
 /* actually only used writefile.c */
-extern void memfile_chunk_add(MemFile *memfile,
-                              const char *buf,
-                              unsigned int size,
-                              MemFileChunk **compchunk_step);
+extern void BLO_memfile_write_init(MemFileWriteData *mem_data,
+                                   MemFile *written_memfile,
+                                   MemFile *reference_memfile);
+extern void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
+extern void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, unsigned int size);
 
 /* exports */
 extern void BLO_memfile_free(MemFile *memfile);
 extern void BLO_memfile_merge(MemFile *first, MemFile *second);
+extern MemFile *BLO_memfile_copy(const MemFile *memfile);
 
 /* utilities */
 extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                          struct Main *bmain,
                                          struct Scene **r_scene);
 extern bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename);
+extern bool BLO_memfile_write_file_ex(struct MemFile *memfile,
+                                      const char *filename,
+                                      const bool use_compress,
+                                      const short *stop);
 
 #endif /* __BLO_UNDOFILE_H__ */
@@ -36,6 +36,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_trace.h"
 
 #include "DNA_genfile.h"
 #include "DNA_sdna_types.h"
@@ -144,6 +145,20 @@ LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh, int ofblocktype,
   BHead *bhead;
   int tot = 0;
 
+  if (fd->index != NULL) {
+    /* Avoids reading all blocks of the file. */
+    const BlendFileIndexEntry *entry = BLEND_FILE_INDEX_ENTRIES(fd->index);
+    for (uint i = 0; i < fd->index->entries_num; i++, entry++) {
+      if (entry->code == ofblocktype) {
+        BLI_linklist_prepend(&names, strdup(entry->name + 2));
+        tot++;
+      }
+    }
+
+    *tot_names = tot;
+    return names;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ofblocktype) {
       const char *idname = blo_bhead_id_name(fd, bhead);
@@ -160,6 +175,68 @@ LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh, int ofblocktype,
   return names;
 }
 
+static bool blendhandle_idcode_has_preview(const short idcode)
+{
+  switch (idcode) {
+    case ID_MA:  /* fall through */
+    case ID_TE:  /* fall through */
+    case ID_IM:  /* fall through */
+    case ID_WO:  /* fall through */
+    case ID_LA:  /* fall through */
+    case ID_OB:  /* fall through */
+    case ID_GR:  /* fall through */
+    case ID_SCE: /* fall through */
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Read a preview at an offset from the #FileData.index,
+ * the pixels are stored in the blocks directly after it (see #write_previews).
+ */
+static void blendhandle_read_preview_at_offset(FileData *fd,
+                                               uint64_t offset,
+                                               PreviewImage *new_prv)
+{
+  const char *rect_allocname[NUM_ICON_SIZES] = {"PreviewImage Icon Rect",
+                                                "PreviewImage Image Rect"};
+  BHead *bhead = blo_bhead_read_at_offset(fd, offset);
+  if (bhead == NULL) {
+    return;
+  }
+
+  if ((bhead->code == DATA) &&
+      (bhead->SDNAnr == DNA_struct_find_nr(fd->filesdna, "PreviewImage"))) {
+    PreviewImage *prv = BLO_library_read_struct(fd, bhead, "PreviewImage");
+    if (prv) {
+      memcpy(new_prv, prv, sizeof(PreviewImage));
+      offset += sizeof(BHead) + (uint64_t)bhead->len;
+
+      for (int i = 0; i < NUM_ICON_SIZES; i++) {
+        new_prv->rect[i] = NULL;
+        if (prv->rect[i] && prv->w[i] && prv->h[i]) {
+          BHead *bhead_rect = blo_bhead_read_at_offset(fd, offset);
+          if (bhead_rect != NULL) {
+            if (bhead_rect->len == prv->w[i] * prv->h[i] * sizeof(uint)) {
+              new_prv->rect[i] = BLO_library_read_struct(fd, bhead_rect, rect_allocname[i]);
+              offset += sizeof(BHead) + (uint64_t)bhead_rect->len;
+            }
+            blo_bhead_free(bhead_rect);
+          }
+        }
+        if (new_prv->rect[i] == NULL) {
+          new_prv->w[i] = new_prv->h[i] = 0;
+        }
+      }
+      MEM_freeN(prv);
+    }
+  }
+
+  blo_bhead_free(bhead);
+}
+
 /**
  * Gets the previews of all the data-blocks in a file of a certain type
  * (e.g. all the scene previews in a file).
@@ -179,25 +256,32 @@ LinkNode *BLO_blendhandle_get_previews(BlendHandle *bh, int ofblocktype, int *to
   PreviewImage *new_prv = NULL;
   int tot = 0;
 
+  if (fd->index != NULL) {
+    /* Only read the previews themselves. */
+    const BlendFileIndexEntry *entry = BLEND_FILE_INDEX_ENTRIES(fd->index);
+    for (uint i = 0; i < fd->index->entries_num; i++, entry++) {
+      if ((entry->code == ofblocktype) && blendhandle_idcode_has_preview(GS(entry->name))) {
+        new_prv = MEM_callocN(sizeof(PreviewImage), "newpreview");
+        BLI_linklist_prepend(&previews, new_prv);
+        tot++;
+        if (entry->preview_offset != 0) {
+          blendhandle_read_preview_at_offset(fd, entry->preview_offset, new_prv);
+        }
+      }
+    }
+
+    *tot_prev = tot;
+    return previews;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ofblocktype) {
       const char *idname = blo_bhead_id_name(fd, bhead);
-      switch (GS(idname)) {
-        case ID_MA:  /* fall through */
-        case ID_TE:  /* fall through */
-        case ID_IM:  /* fall through */
-        case ID_WO:  /* fall through */
-        case ID_LA:  /* fall through */
-        case ID_OB:  /* fall through */
-        case ID_GR:  /* fall through */
-        case ID_SCE: /* fall through */
-          new_prv = MEM_callocN(sizeof(PreviewImage), "newpreview");
-          BLI_linklist_prepend(&previews, new_prv);
-          tot++;
-          looking = 1;
-          break;
-        default:
-          break;
+      if (blendhandle_idcode_has_preview(GS(idname))) {
+        new_prv = MEM_callocN(sizeof(PreviewImage), "newpreview");
+        BLI_linklist_prepend(&previews, new_prv);
+        tot++;
+        looking = 1;
       }
     }
     else if (bhead->code == DATA) {
@@ -264,6 +348,22 @@ LinkNode *BLO_blendhandle_get_linkable_groups(BlendHandle *bh)
   LinkNode *names = NULL;
   BHead *bhead;
 
+  if (fd->index != NULL) {
+    const BlendFileIndexEntry *entry = BLEND_FILE_INDEX_ENTRIES(fd->index);
+    for (uint i = 0; i < fd->index->entries_num; i++, entry++) {
+      if (BKE_idcode_is_linkable(entry->code)) {
+        const char *str = BKE_idcode_to_name(entry->code);
+
+        if (BLI_gset_add(gathered, (void *)str)) {
+          BLI_linklist_prepend(&names, strdup(str));
+        }
+      }
+    }
+
+    BLI_gset_free(gathered, NULL);
+    return names;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ENDB) {
       break;
@@ -317,7 +417,9 @@ BlendFileData *BLO_read_from_file(const char *filepath,
   if (fd) {
     fd->reports = reports;
     fd->skip_flags = skip_flags;
+    BLI_TRACE_ZONE_BEGIN(read);
     bfd = blo_read_file_internal(fd, filepath);
+    BLI_TRACE_ZONE_END(read, "Read File");
     blo_filedata_free(fd);
   }
 
@@ -345,7 +447,9 @@ BlendFileData *BLO_read_from_memory(const void *mem,
   if (fd) {
     fd->reports = reports;
     fd->skip_flags = skip_flags;
+    BLI_TRACE_ZONE_BEGIN(read);
     bfd = blo_read_file_internal(fd, "");
+    BLI_TRACE_ZONE_END(read, "Read Memory");
     blo_filedata_free(fd);
   }
 
@@ -359,10 +463,13 @@ BlendFileData *BLO_read_from_memory(const void *mem,
  * \param oldmain: old main,
  * from which we will keep libraries and other data-blocks that should not have changed.
  * \param filename: current file, only for retrieving library data.
+ * \param memfile_current: The memfile of the current state of \a oldmain (optional),
+ * data-blocks which didn't change since are kept from \a oldmain instead of being read again.
  */
 BlendFileData *BLO_read_from_memfile(Main *oldmain,
                                      const char *filename,
                                      MemFile *memfile,
+                                     const MemFile *memfile_current,
                                      eBLOReadSkip skip_flags,
                                      ReportList *reports)
 {
@@ -370,7 +477,7 @@ BlendFileData *BLO_read_from_memfile(Main *oldmain,
   FileData *fd;
   ListBase old_mainlist;
 
-  fd = blo_filedata_from_memfile(memfile, reports);
+  fd = blo_filedata_from_memfile(memfile, memfile_current, reports);
   if (fd) {
     fd->reports = reports;
     fd->skip_flags = skip_flags;
@@ -398,7 +505,9 @@ BlendFileData *BLO_read_from_memfile(Main *oldmain,
 
     /* removed packed data from this trick - it's internal data that needs saves */
 
+    BLI_TRACE_ZONE_BEGIN(read);
     bfd = blo_read_file_internal(fd, filename);
+    BLI_TRACE_ZONE_END(read, "Read Undo");
 
     /* ensures relinked light caches are not freed */
     blo_end_scene_pointer_map(fd, oldmain);
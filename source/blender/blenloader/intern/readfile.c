@@ -34,6 +34,7 @@
 #include "BLI_utildefines.h"
 #ifndef WIN32
 #  include <unistd.h>  // for read close
+#  include <sys/mman.h> // for mmap, munmap
 #else
 #  include <io.h>  // for open close read
 #  include "winsock2.h"
@@ -100,12 +101,14 @@
 #include "BLI_math.h"
 #include "BLI_threads.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "BLI_ghash.h"
 
 #include "BLT_translation.h"
 
 #include "BKE_action.h"
 #include "BKE_armature.h"
+#include "BKE_blender.h"
 #include "BKE_brush.h"
 #include "BKE_collection.h"
 #include "BKE_colortools.h"
@@ -160,6 +163,14 @@
 
 #include <errno.h>
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#endif
+
 /* Make preferences read-only. */
 #define U (*((const UserDef *)&U))
 
@@ -222,12 +233,50 @@
  */
 #define USE_BHEAD_READ_ON_DEMAND
 
+/**
+ * Map uncompressed files into memory instead of reading them with system calls.
+ * Data read on demand is then taken straight from the mapping, structs which need
+ * DNA reconstruction are converted from it without an intermediate copy.
+ *
+ * \note Only used along with #USE_BHEAD_READ_ON_DEMAND,
+ * disabled on WIN32 where the mmap wrapper isn't thread-safe.
+ */
+#if defined(USE_BHEAD_READ_ON_DEMAND) && !defined(WIN32)
+#  define USE_BHEAD_READ_MMAP
+#endif
+
+/**
+ * Read (and convert) the data-blocks of an ID in parallel when the file is mapped,
+ * since #read_struct doesn't depend on the file position in that case.
+ */
+#ifdef USE_BHEAD_READ_MMAP
+#  define USE_READ_DATA_PARALLEL
+#endif
+
 /* use GHash for BHead name-based lookups (speeds up linking) */
 #define USE_GHASH_BHEAD
 
+/**
+ * Keep the #FileData of library files once loading is done, so opening another file
+ * linking from the same libraries doesn't parse their DNA and index their blocks again.
+ *
+ * \note Only done for files which are read on demand, so the data of unused
+ * blocks isn't kept in memory. Disabled on WIN32, where open files can't be replaced.
+ */
+#if defined(USE_BHEAD_READ_ON_DEMAND) && defined(USE_GHASH_BHEAD) && !defined(WIN32)
+#  define USE_LIBRARY_FILEDATA_CACHE
+#endif
+
 /* Use GHash for restoring pointers by name */
 #define USE_GHASH_RESTORE_POINTER
 
+/**
+ * On undo, keep the data-blocks which didn't change since the current state
+ * (their memfile chunks are shared with the memfile of the current state),
+ * instead of reading them again, see #read_undo_reused_ids_find.
+ */
+#define USE_UNDO_REUSE_IDS
+
 /* Define this to have verbose debug prints. */
 //#define USE_DEBUG_PRINT
 
@@ -258,6 +307,8 @@ typedef struct BHeadN {
   /** When set, the remainder of this allocation is the data, otherwise it needs to be read. */
   bool has_data;
 #endif
+  /** Undo: the block is read from memfile chunks shared with the current state. */
+  bool is_memchunk_identical;
   struct BHead bhead;
 } BHeadN;
 
@@ -779,6 +830,9 @@ static BHeadN *get_bhead(FileData *fd)
       BHead4 bhead4 = {0};
       BHead bhead = {0};
 
+      /* Cleared by #fd_read_from_memfile when reading data changed since the current state. */
+      fd->is_memchunk_identical = true;
+
       /* First read the bhead structure.
        * Depending on the platform the file was written on this can
        * be a big or little endian BHead4 or BHead8 structure.
@@ -852,6 +906,7 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->next = new_bhead->prev = NULL;
           new_bhead->file_offset = fd->file_offset;
           new_bhead->has_data = false;
+          new_bhead->is_memchunk_identical = false;
           new_bhead->bhead = bhead;
           off64_t seek_new = fd->seek(fd, bhead.len, SEEK_CUR);
           if (seek_new == -1) {
@@ -883,6 +938,9 @@ static BHeadN *get_bhead(FileData *fd)
             MEM_freeN(new_bhead);
             new_bhead = NULL;
           }
+          else {
+            new_bhead->is_memchunk_identical = fd->is_memchunk_identical;
+          }
         }
         else {
           fd->is_eof = true;
@@ -983,12 +1041,30 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
   new_bhead_data->bhead = new_bhead->bhead;
   new_bhead_data->file_offset = new_bhead->file_offset;
   new_bhead_data->has_data = true;
+  new_bhead_data->is_memchunk_identical = false;
   if (!blo_bhead_read_data(fd, thisblock, new_bhead_data + 1)) {
     MEM_freeN(new_bhead_data);
     return NULL;
   }
   return &new_bhead_data->bhead;
 }
+
+#  ifdef USE_BHEAD_READ_MMAP
+/**
+ * Return the data of a block which hasn't been read yet directly from the file mapping,
+ * or NULL when the file isn't mapped (or the block lies outside of it).
+ */
+static const void *blo_bhead_data_from_mmap(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if ((fd->mmap_buffer == NULL) ||
+      ((size_t)new_bhead->file_offset + (size_t)new_bhead->bhead.len > fd->mmap_size)) {
+    return NULL;
+  }
+  return fd->mmap_buffer + new_bhead->file_offset;
+}
+#  endif
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
 /* Warning! Caller's responsibility to ensure given bhead **is** and ID one! */
@@ -997,6 +1073,51 @@ const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead)
   return (const char *)POINTER_OFFSET(bhead, sizeof(*bhead) + fd->id_name_offs);
 }
 
+/**
+ * Read the block at \a offset (as stored in the #FileData.index),
+ * without adding it to the list of blocks or changing the current read position.
+ *
+ * \return The block, to be freed with #blo_bhead_free, or NULL on failure.
+ */
+BHead *blo_bhead_read_at_offset(FileData *fd, uint64_t offset)
+{
+  /* Ensured by #read_file_index. */
+  BLI_assert(fd->seek != NULL);
+  BLI_assert((fd->flags & (FD_FLAGS_SWITCH_ENDIAN | FD_FLAGS_POINTSIZE_DIFFERS)) == 0);
+
+  const off64_t offset_backup = fd->file_offset;
+  BHeadN *new_bhead = NULL;
+  BHead bhead;
+
+  if ((fd->seek(fd, (off64_t)offset, SEEK_SET) != -1) &&
+      (fd->read(fd, &bhead, sizeof(bhead)) == sizeof(bhead)) && (bhead.len >= 0)) {
+    new_bhead = MEM_mallocN(sizeof(BHeadN) + bhead.len, "new_bhead");
+    new_bhead->next = new_bhead->prev = NULL;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    new_bhead->file_offset = (off64_t)offset + sizeof(bhead);
+    new_bhead->has_data = true;
+#endif
+    new_bhead->is_memchunk_identical = false;
+    new_bhead->bhead = bhead;
+
+    if (fd->read(fd, new_bhead + 1, bhead.len) != bhead.len) {
+      MEM_freeN(new_bhead);
+      new_bhead = NULL;
+    }
+  }
+
+  if (fd->seek(fd, offset_backup, SEEK_SET) == -1) {
+    fd->is_eof = true;
+  }
+
+  return new_bhead ? &new_bhead->bhead : NULL;
+}
+
+void blo_bhead_free(BHead *bhead)
+{
+  MEM_freeN(BHEADN_FROM_BHEAD(bhead));
+}
+
 static void decode_blender_header(FileData *fd)
 {
   char header[SIZEOFBLENDERHEADER], num[4];
@@ -1037,6 +1158,29 @@ static void decode_blender_header(FileData *fd)
   }
 }
 
+static bool read_file_dna_decode(FileData *fd,
+                                 const BHead *bhead,
+                                 const int subversion,
+                                 const char **r_error_message)
+{
+  const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
+
+  fd->filesdna = DNA_sdna_from_data(&bhead[1], bhead->len, do_endian_swap, true, r_error_message);
+  if (fd->filesdna) {
+    blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
+    fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
+    fd->reconstruct_info = DNA_reconstruct_info_create(
+        fd->filesdna, fd->memsdna, fd->compflags, do_endian_swap);
+    /* used to retrieve ID names from (bhead+1) */
+    fd->id_name_offs = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
+
+    return true;
+  }
+  else {
+    return false;
+  }
+}
+
 /**
  * \return Success if the file is read correctly, else set \a r_error_message.
  */
@@ -1060,24 +1204,28 @@ static bool read_file_dna(FileData *fd, const char **r_error_message)
       memcpy(num, fg->subvstr, 4);
       num[4] = 0;
       subversion = atoi(num);
-    }
-    else if (bhead->code == DNA1) {
-      const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
 
-      fd->filesdna = DNA_sdna_from_data(
-          &bhead[1], bhead->len, do_endian_swap, true, r_error_message);
-      if (fd->filesdna) {
-        blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
-        fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
-        /* used to retrieve ID names from (bhead+1) */
-        fd->id_name_offs = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
-
-        return true;
-      }
-      else {
-        return false;
+      if (fd->index != NULL) {
+        /* Avoid reading all blocks to find the DNA which is written at the end. */
+        BHead *bhead_dna = blo_bhead_read_at_offset(fd, fd->index->dna_offset);
+        if (bhead_dna != NULL) {
+          bool success = false;
+          if (bhead_dna->code == DNA1) {
+            success = read_file_dna_decode(fd, bhead_dna, subversion, r_error_message);
+          }
+          blo_bhead_free(bhead_dna);
+          if (success) {
+            return true;
+          }
+        }
+        /* The index doesn't match the file contents, don't use it. */
+        MEM_freeN(fd->index);
+        fd->index = NULL;
       }
     }
+    else if (bhead->code == DNA1) {
+      return read_file_dna_decode(fd, bhead, subversion, r_error_message);
+    }
     else if (bhead->code == ENDB) {
       break;
     }
@@ -1087,6 +1235,74 @@ static bool read_file_dna(FileData *fd, const char **r_error_message)
   return false;
 }
 
+static bool read_file_index_is_valid(BlendFileIndexHeader *index,
+                                     const uint index_len,
+                                     const off64_t index_offset)
+{
+  if ((memcmp(index->magic, BLEND_FILE_INDEX_MAGIC, sizeof(index->magic)) != 0) ||
+      (index->version != BLEND_FILE_INDEX_VERSION) ||
+      (index_len != sizeof(BlendFileIndexHeader) +
+                        (sizeof(BlendFileIndexEntry) * (uint64_t)index->entries_num) +
+                        sizeof(BlendFileIndexFooter)) ||
+      (index->dna_offset >= (uint64_t)index_offset)) {
+    return false;
+  }
+
+  BlendFileIndexEntry *entry = BLEND_FILE_INDEX_ENTRIES(index);
+  for (uint i = 0; i < index->entries_num; i++, entry++) {
+    if ((entry->offset >= (uint64_t)index_offset) ||
+        (entry->preview_offset >= (uint64_t)index_offset)) {
+      return false;
+    }
+    entry->name[sizeof(entry->name) - 1] = '\0';
+  }
+  return true;
+}
+
+/**
+ * Read the data-block index (see #BlendFileIndexHeader) from the end of the file.
+ *
+ * Only used when seeking is supported (not for gzip compressed files) and the file
+ * has the same pointer size & endianness, otherwise all blocks are read as before.
+ */
+static void read_file_index(FileData *fd)
+{
+  if ((fd->seek == NULL) || (fd->memfile != NULL) ||
+      (fd->flags & (FD_FLAGS_SWITCH_ENDIAN | FD_FLAGS_POINTSIZE_DIFFERS))) {
+    return;
+  }
+
+  const off64_t offset_backup = fd->file_offset;
+  BlendFileIndexHeader *index = NULL;
+  BlendFileIndexFooter footer;
+
+  /* The index is followed by the #ENDB block header. */
+  const off64_t file_len = fd->seek(fd, 0, SEEK_END);
+  const off64_t footer_offset = file_len - (off64_t)(sizeof(BHead) + sizeof(footer));
+
+  if ((file_len != -1) && (footer_offset > SIZEOFBLENDERHEADER) &&
+      (fd->seek(fd, footer_offset, SEEK_SET) != -1) &&
+      (fd->read(fd, &footer, sizeof(footer)) == sizeof(footer)) &&
+      (memcmp(footer.magic, BLEND_FILE_INDEX_MAGIC, sizeof(footer.magic)) == 0) &&
+      (footer.len >= sizeof(BlendFileIndexHeader) + sizeof(footer)) &&
+      ((off64_t)footer.len <= footer_offset + (off64_t)sizeof(footer) - SIZEOFBLENDERHEADER)) {
+    const off64_t index_offset = footer_offset + (off64_t)sizeof(footer) - footer.len;
+    index = MEM_mallocN(footer.len, "BlendFileIndex");
+    if ((fd->seek(fd, index_offset, SEEK_SET) == -1) ||
+        (fd->read(fd, index, footer.len) != (int)footer.len) ||
+        !read_file_index_is_valid(index, footer.len, index_offset)) {
+      MEM_freeN(index);
+      index = NULL;
+    }
+  }
+
+  if (fd->seek(fd, offset_backup, SEEK_SET) == -1) {
+    fd->is_eof = true;
+  }
+
+  fd->index = index;
+}
+
 static int *read_file_thumbnail(FileData *fd)
 {
   BHead *bhead;
@@ -1155,6 +1371,72 @@ static off64_t fd_seek_data_from_file(FileData *filedata, off64_t offset, int wh
   return filedata->file_offset;
 }
 
+#ifdef USE_BHEAD_READ_MMAP
+/* Memory mapped file reading. */
+
+static int fd_read_from_mmap(FileData *filedata, void *buffer, uint size)
+{
+  /* don't read more bytes then there are available in the mapping */
+  const size_t size_available = filedata->mmap_size - (size_t)filedata->file_offset;
+  const int readsize = (int)MIN2((size_t)size, size_available);
+
+  memcpy(buffer, filedata->mmap_buffer + filedata->file_offset, (size_t)readsize);
+  filedata->file_offset += readsize;
+
+  return readsize;
+}
+
+static off64_t fd_seek_from_mmap(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t offset_new;
+  switch (whence) {
+    case SEEK_SET:
+      offset_new = offset;
+      break;
+    case SEEK_CUR:
+      offset_new = filedata->file_offset + offset;
+      break;
+    case SEEK_END:
+      offset_new = (off64_t)filedata->mmap_size + offset;
+      break;
+    default:
+      return -1;
+  }
+  if ((offset_new < 0) || ((size_t)offset_new > filedata->mmap_size)) {
+    return -1;
+  }
+  filedata->file_offset = offset_new;
+  return filedata->file_offset;
+}
+
+/**
+ * Map the whole (uncompressed) file, on failure the caller falls back to regular reading.
+ */
+static bool fd_mmap_init(FileData *filedata)
+{
+  const size_t size = BLI_file_descriptor_size(filedata->filedes);
+  if ((size == (size_t)-1) || (size < SIZEOFBLENDERHEADER)) {
+    return false;
+  }
+
+  void *mem = mmap(NULL, size, PROT_READ, MAP_PRIVATE, filedata->filedes, 0);
+  if (mem == MAP_FAILED) {
+    return false;
+  }
+#  ifdef MADV_SEQUENTIAL
+  /* Blocks are mostly read in file order, read-ahead helps a lot. */
+  madvise(mem, size, MADV_SEQUENTIAL);
+#  endif
+
+  filedata->mmap_buffer = mem;
+  filedata->mmap_size = size;
+  filedata->file_offset = 0;
+  filedata->read = fd_read_from_mmap;
+  filedata->seek = fd_seek_from_mmap;
+  return true;
+}
+#endif /* USE_BHEAD_READ_MMAP */
+
 /* GZip file reading. */
 
 static int fd_read_gzip_from_file(FileData *filedata, void *buffer, uint size)
@@ -1171,6 +1453,212 @@ static int fd_read_gzip_from_file(FileData *filedata, void *buffer, uint size)
   return (readsize);
 }
 
+#ifdef WITH_LZO
+/* Fast block compressed file reading (see #BLEND_LZO_MAGIC). */
+
+typedef struct FileDataLZO {
+  BlendLZOFrame *frames;
+  /** Offset of each frame in the file, `frames_len + 1` items. */
+  off64_t *frames_offset;
+  int frames_len;
+  uint frame_size;
+  /** Size of the uncompressed data. */
+  off64_t len;
+
+  /** Range of frames which are decompressed (in parallel) into #FileDataLZO.window. */
+  int window_frame_first, window_frames_len;
+  int window_frames_len_max;
+  uchar *window;
+  uchar *window_compressed;
+  bool window_error;
+} FileDataLZO;
+
+static bool fd_lzo_read_uint32(int file, uint32_t *r_value)
+{
+  if (read(file, r_value, sizeof(*r_value)) != sizeof(*r_value)) {
+    return false;
+  }
+#  ifdef __BIG_ENDIAN__
+  BLI_endian_switch_uint32(r_value);
+#  endif
+  return true;
+}
+
+static void fd_lzo_free(FileDataLZO *lzo)
+{
+  MEM_SAFE_FREE(lzo->frames);
+  MEM_SAFE_FREE(lzo->frames_offset);
+  MEM_SAFE_FREE(lzo->window);
+  MEM_SAFE_FREE(lzo->window_compressed);
+  MEM_freeN(lzo);
+}
+
+/**
+ * Read the frame table from the end of the file.
+ */
+static FileDataLZO *fd_lzo_init(int file)
+{
+  char magic[BLEND_LZO_MAGIC_LEN];
+  uint32_t frame_size, frames_len;
+
+  if ((lseek(file, BLEND_LZO_MAGIC_LEN, SEEK_SET) == -1) ||
+      !fd_lzo_read_uint32(file, &frame_size) || (frame_size == 0) ||
+      (frame_size > BLEND_LZO_FRAME_SIZE * 16) ||
+      (lseek(file, -BLEND_LZO_FOOTER_LEN, SEEK_END) == -1) ||
+      !fd_lzo_read_uint32(file, &frames_len) ||
+      (read(file, magic, sizeof(magic)) != sizeof(magic)) ||
+      (memcmp(magic, BLEND_LZO_MAGIC, BLEND_LZO_MAGIC_LEN) != 0) || (frames_len > INT_MAX / 2)) {
+    return NULL;
+  }
+
+  const off64_t table_len = (off64_t)sizeof(BlendLZOFrame) * frames_len;
+  if (lseek(file, -(BLEND_LZO_FOOTER_LEN + table_len), SEEK_END) == -1) {
+    return NULL;
+  }
+
+  FileDataLZO *lzo = MEM_callocN(sizeof(*lzo), __func__);
+  lzo->frames_len = (int)frames_len;
+  lzo->frame_size = frame_size;
+  lzo->frames = MEM_mallocN(sizeof(*lzo->frames) * frames_len, __func__);
+  lzo->frames_offset = MEM_mallocN(sizeof(*lzo->frames_offset) * (frames_len + 1), __func__);
+
+  off64_t offset = BLEND_LZO_HEADER_LEN;
+  for (int i = 0; i < lzo->frames_len; i++) {
+    BlendLZOFrame *frame = &lzo->frames[i];
+    if (!fd_lzo_read_uint32(file, &frame->compressed_len) ||
+        !fd_lzo_read_uint32(file, &frame->len) ||
+        /* Only the last frame may be smaller. */
+        ((i + 1 != lzo->frames_len) ? (frame->len != frame_size) : (frame->len > frame_size)) ||
+        (frame->compressed_len > frame->len)) {
+      fd_lzo_free(lzo);
+      return NULL;
+    }
+    lzo->frames_offset[i] = offset;
+    lzo->len += frame->len;
+    offset += frame->compressed_len;
+  }
+  lzo->frames_offset[lzo->frames_len] = offset;
+
+  /* Enough frames to keep all threads busy. */
+  lzo->window_frames_len_max = max_ii(BLI_system_thread_count() * 2, 2);
+  lzo->window_frame_first = -1;
+
+  return lzo;
+}
+
+static void fd_lzo_decompress_frame_cb(void *__restrict userdata,
+                                       const int index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  FileDataLZO *lzo = userdata;
+  const int frame_index = lzo->window_frame_first + index;
+  const BlendLZOFrame *frame = &lzo->frames[frame_index];
+  const uchar *in = lzo->window_compressed + (lzo->frames_offset[frame_index] -
+                                              lzo->frames_offset[lzo->window_frame_first]);
+  uchar *out = lzo->window + (size_t)index * lzo->frame_size;
+
+  if (frame->compressed_len == frame->len) {
+    memcpy(out, in, frame->len);
+  }
+  else {
+    lzo_uint out_len = frame->len;
+    if ((lzo1x_decompress_safe(in, frame->compressed_len, out, &out_len, NULL) != LZO_E_OK) ||
+        (out_len != frame->len)) {
+      lzo->window_error = true;
+    }
+  }
+}
+
+/**
+ * Read and decompress (in parallel) a range of frames starting at \a frame_index.
+ */
+static bool fd_lzo_window_load(FileData *filedata, int frame_index)
+{
+  FileDataLZO *lzo = filedata->lzo;
+
+  if (lzo->window == NULL) {
+    const size_t window_size = (size_t)lzo->window_frames_len_max * lzo->frame_size;
+    lzo->window = MEM_mallocN(window_size, __func__);
+    lzo->window_compressed = MEM_mallocN(window_size, __func__);
+  }
+
+  lzo->window_frame_first = frame_index;
+  lzo->window_frames_len = min_ii(lzo->window_frames_len_max, lzo->frames_len - frame_index);
+  lzo->window_error = false;
+
+  /* Frames are stored contiguously, read them all at once. */
+  const off64_t offset = lzo->frames_offset[frame_index];
+  const size_t size = (size_t)(lzo->frames_offset[frame_index + lzo->window_frames_len] -
+                               offset);
+  if ((lseek(filedata->filedes, offset, SEEK_SET) == -1) ||
+      ((size_t)read(filedata->filedes, lzo->window_compressed, size) != size)) {
+    lzo->window_frame_first = -1;
+    return false;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, lzo->window_frames_len, lzo, fd_lzo_decompress_frame_cb, &settings);
+
+  if (lzo->window_error) {
+    lzo->window_frame_first = -1;
+    return false;
+  }
+  return true;
+}
+
+static int fd_read_lzo_from_file(FileData *filedata, void *buffer, uint size)
+{
+  FileDataLZO *lzo = filedata->lzo;
+  uint readsize = 0;
+
+  while ((readsize < size) && (filedata->file_offset < lzo->len)) {
+    const int frame_index = (int)(filedata->file_offset / lzo->frame_size);
+    if ((lzo->window_frame_first == -1) || (frame_index < lzo->window_frame_first) ||
+        (frame_index >= lzo->window_frame_first + lzo->window_frames_len)) {
+      if (!fd_lzo_window_load(filedata, frame_index)) {
+        return EOF;
+      }
+    }
+
+    const uint frame_offset = (uint)(filedata->file_offset % lzo->frame_size);
+    const uint len = MIN2(size - readsize, lzo->frames[frame_index].len - frame_offset);
+    memcpy((char *)buffer + readsize,
+           lzo->window + (size_t)(frame_index - lzo->window_frame_first) * lzo->frame_size +
+               frame_offset,
+           len);
+    readsize += len;
+    filedata->file_offset += len;
+  }
+
+  return (int)readsize;
+}
+
+static off64_t fd_seek_lzo_from_file(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t offset_new;
+  switch (whence) {
+    case SEEK_SET:
+      offset_new = offset;
+      break;
+    case SEEK_CUR:
+      offset_new = filedata->file_offset + offset;
+      break;
+    case SEEK_END:
+      offset_new = filedata->lzo->len + offset;
+      break;
+    default:
+      return -1;
+  }
+  if ((offset_new < 0) || (offset_new > filedata->lzo->len)) {
+    return -1;
+  }
+  filedata->file_offset = offset_new;
+  return filedata->file_offset;
+}
+#endif /* WITH_LZO */
+
 /* Memory reading. */
 
 static int fd_read_from_memory(FileData *filedata, void *buffer, uint size)
@@ -1228,6 +1716,11 @@ static int fd_read_from_memfile(FileData *filedata, void *buffer, uint size)
         return 0;
       }
 
+      if (filedata->undo_current_chunks != NULL &&
+          !BLI_gset_haskey(filedata->undo_current_chunks, chunk->buf)) {
+        filedata->is_memchunk_identical = false;
+      }
+
       chunkoffset = seek - offset;
       readsize = size - totread;
 
@@ -1272,6 +1765,7 @@ static FileData *blo_decode_and_check(FileData *fd, ReportList *reports)
 
   if (fd->flags & FD_FLAGS_FILE_OK) {
     const char *error_message = NULL;
+    read_file_index(fd);
     if (read_file_dna(fd, &error_message) == false) {
       BKE_reportf(
           reports, RPT_ERROR, "Failed to read blend file '%s': %s", fd->relabase, error_message);
@@ -1297,6 +1791,9 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   FileDataSeekFn *seek_fn = NULL; /* Optional. */
 
   gzFile gzfile = (gzFile)Z_NULL;
+#ifdef WITH_LZO
+  FileDataLZO *lzo = NULL;
+#endif
 
   char header[7];
 
@@ -1320,6 +1817,26 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
     seek_fn = fd_seek_data_from_file;
   }
 
+  /* Fast block compressed file. */
+  if ((read_fn == NULL) && (memcmp(header, BLEND_LZO_MAGIC, BLEND_LZO_MAGIC_LEN) == 0)) {
+#ifdef WITH_LZO
+    lzo = fd_lzo_init(file);
+    if (lzo == NULL) {
+      BKE_reportf(reports, RPT_WARNING, "Unable to read '%s': %s", filepath, TIP_("corrupt file"));
+      return NULL;
+    }
+    read_fn = fd_read_lzo_from_file;
+    seek_fn = fd_seek_lzo_from_file;
+#else
+    BKE_reportf(reports,
+                RPT_WARNING,
+                "Unable to read '%s': %s",
+                filepath,
+                TIP_("fast compression is not supported (built without LZO)"));
+    return NULL;
+#endif
+  }
+
   /* Gzip file. */
   errno = 0;
   if ((read_fn == NULL) &&
@@ -1351,10 +1868,19 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   fd->filedes = file;
   fd->gzfiledes = gzfile;
+#ifdef WITH_LZO
+  fd->lzo = lzo;
+#endif
 
   fd->read = read_fn;
   fd->seek = seek_fn;
 
+#ifdef USE_BHEAD_READ_MMAP
+  if (read_fn == fd_read_data_from_file) {
+    fd_mmap_init(fd);
+  }
+#endif
+
   return fd;
 }
 
@@ -1479,7 +2005,13 @@ FileData *blo_filedata_from_memory(const void *mem, int memsize, ReportList *rep
   }
 }
 
-FileData *blo_filedata_from_memfile(MemFile *memfile, ReportList *reports)
+/**
+ * \param memfile_current: The memfile of the current state (optional),
+ * blocks read from chunks it shares with \a memfile are known not to have changed.
+ */
+FileData *blo_filedata_from_memfile(MemFile *memfile,
+                                    const MemFile *memfile_current,
+                                    ReportList *reports)
 {
   if (!memfile) {
     BKE_report(reports, RPT_WARNING, "Unable to open blend <memory>");
@@ -1489,6 +2021,18 @@ FileData *blo_filedata_from_memfile(MemFile *memfile, ReportList *reports)
     FileData *fd = filedata_new();
     fd->memfile = memfile;
 
+#ifdef USE_UNDO_REUSE_IDS
+    if (memfile_current != NULL) {
+      fd->undo_current_chunks = BLI_gset_ptr_new_ex(
+          __func__, (uint)BLI_listbase_count(&memfile_current->chunks));
+      LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile_current->chunks) {
+        BLI_gset_add(fd->undo_current_chunks, (void *)chunk->buf);
+      }
+    }
+#else
+    UNUSED_VARS(memfile_current);
+#endif
+
     fd->read = fd_read_from_memfile;
     fd->flags |= FD_FLAGS_NOT_MY_BUFFER;
 
@@ -1507,6 +2051,19 @@ void blo_filedata_free(FileData *fd)
       gzclose(fd->gzfiledes);
     }
 
+#ifdef USE_BHEAD_READ_MMAP
+    if (fd->mmap_buffer != NULL) {
+      munmap((void *)fd->mmap_buffer, fd->mmap_size);
+      fd->mmap_buffer = NULL;
+    }
+#endif
+
+#ifdef WITH_LZO
+    if (fd->lzo != NULL) {
+      fd_lzo_free(fd->lzo);
+    }
+#endif
+
     if (fd->strm.next_in) {
       if (inflateEnd(&fd->strm) != Z_OK) {
         printf("close gzip stream error\n");
@@ -1534,6 +2091,9 @@ void blo_filedata_free(FileData *fd)
     if (fd->filesdna) {
       DNA_sdna_free(fd->filesdna);
     }
+    if (fd->reconstruct_info) {
+      DNA_reconstruct_info_free(fd->reconstruct_info);
+    }
     if (fd->compflags) {
       MEM_freeN((void *)fd->compflags);
     }
@@ -1565,6 +2125,9 @@ void blo_filedata_free(FileData *fd)
     if (fd->bheadmap) {
       MEM_freeN(fd->bheadmap);
     }
+    if (fd->index) {
+      MEM_freeN(fd->index);
+    }
 
 #ifdef USE_GHASH_BHEAD
     if (fd->bhead_idname_hash) {
@@ -1572,6 +2135,13 @@ void blo_filedata_free(FileData *fd)
     }
 #endif
 
+    if (fd->undo_current_chunks) {
+      BLI_gset_free(fd->undo_current_chunks, NULL);
+    }
+    if (fd->undo_reused_ids) {
+      BLI_gset_free(fd->undo_reused_ids, NULL);
+    }
+
     MEM_freeN(fd);
   }
 }
@@ -2212,22 +2782,6 @@ void blo_add_library_pointer_map(ListBase *old_mainlist, FileData *fd)
 /** \name DNA Struct Loading
  * \{ */
 
-static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
-{
-  int blocksize, nblocks;
-  char *data;
-
-  data = (char *)(bhead + 1);
-  blocksize = filesdna->types_size[filesdna->structs[bhead->SDNAnr][0]];
-
-  nblocks = bhead->nr;
-  while (nblocks--) {
-    DNA_struct_switch_endian(filesdna, bhead->SDNAnr, data);
-
-    data += blocksize;
-  }
-}
-
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = NULL;
@@ -2248,22 +2802,30 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
         }
       }
 #endif
-      switch_endian_structs(fd->filesdna, bh);
+      DNA_struct_switch_endian_blocks(fd->reconstruct_info, bh->SDNAnr, bh->nr, (char *)(bh + 1));
     }
 
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+        const void *data = (bh + 1);
 #ifdef USE_BHEAD_READ_ON_DEMAND
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == NULL)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
-            return NULL;
+          data = NULL;
+#  ifdef USE_BHEAD_READ_MMAP
+          /* Reconstruct straight from the mapped file, without an intermediate copy. */
+          data = blo_bhead_data_from_mmap(fd, bh);
+#  endif
+          if (data == NULL) {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == NULL)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              return NULL;
+            }
+            data = (bh + 1);
           }
         }
 #endif
-        temp = DNA_struct_reconstruct(
-            fd->memsdna, fd->filesdna, fd->compflags, bh->SDNAnr, bh->nr, (bh + 1));
+        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, data);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -2272,6 +2834,20 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
         if (BHEADN_FROM_BHEAD(bh)->has_data) {
           memcpy(temp, (bh + 1), bh->len);
         }
+#  ifdef USE_BHEAD_READ_MMAP
+        /* Copy from the mapped file, without seeking (needed for #USE_READ_DATA_PARALLEL). */
+        else if (fd->mmap_buffer != NULL) {
+          const void *data = blo_bhead_data_from_mmap(fd, bh);
+          if (LIKELY(data != NULL)) {
+            memcpy(temp, data, bh->len);
+          }
+          else {
+            fd->flags &= ~FD_FLAGS_FILE_OK;
+            MEM_freeN(temp);
+            temp = NULL;
+          }
+        }
+#  endif
         else {
           /* Instead of allocating the bhead, then copying it,
            * read the data from the file directly into the memory. */
@@ -3296,6 +3872,7 @@ static void direct_link_animdata(FileData *fd, AnimData *adt)
   link_list(fd, &adt->drivers);
   direct_link_fcurves(fd, &adt->drivers);
   adt->driver_array = NULL;
+  adt->rna_path_cache = NULL;
 
   /* link overrides */
   // TODO...
@@ -9286,8 +9863,99 @@ static const char *dataname(short id_code)
   return "Data from Lib Block";
 }
 
+#ifdef USE_READ_DATA_PARALLEL
+/* Only worth the threading overhead for big data-blocks (mesh arrays mainly). */
+#  define READ_DATA_PARALLEL_MIN_BLOCKS 4
+#  define READ_DATA_PARALLEL_MIN_SIZE (1 << 20)
+
+typedef struct ReadDataParallelData {
+  FileData *fd;
+  BHead **bheads;
+  void **data;
+  const char *allocname;
+} ReadDataParallelData;
+
+static void read_data_parallel_cb(void *__restrict userdata,
+                                  const int index,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadDataParallelData *data = userdata;
+  data->data[index] = read_struct(data->fd, data->bheads[index], data->allocname);
+}
+
+/**
+ * Version of #read_data_into_oldnewmap which reads the blocks in parallel,
+ * only inserting them into the map from the calling thread.
+ *
+ * \param r_bhead: The ID block, set to the block following its data on success.
+ * \return false when the blocks are not worth reading in parallel,
+ * the caller then reads them as usual.
+ */
+static bool read_data_into_oldnewmap_parallel(FileData *fd,
+                                              BHead **r_bhead,
+                                              const char *allocname)
+{
+  BHead *bhead = *r_bhead;
+
+  /* Reading from the file without seeking is only possible when endian switching
+   * doesn't need a (full) copy of the block, see #read_struct. */
+  if ((fd->mmap_buffer == NULL) || (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    return false;
+  }
+
+  /* Read all block headers first, data stays in the mapped file. */
+  int bheads_len = 0;
+  size_t data_size = 0;
+  BHead *bhead_end;
+  for (bhead_end = blo_bhead_next(fd, bhead); bhead_end && bhead_end->code == DATA;
+       bhead_end = blo_bhead_next(fd, bhead_end)) {
+    bheads_len++;
+    data_size += (size_t)bhead_end->len;
+  }
+  if ((bheads_len < READ_DATA_PARALLEL_MIN_BLOCKS) || (data_size < READ_DATA_PARALLEL_MIN_SIZE)) {
+    return false;
+  }
+
+  ReadDataParallelData data = {
+      .fd = fd,
+      .bheads = MEM_mallocN(sizeof(*data.bheads) * (size_t)bheads_len, __func__),
+      .data = MEM_mallocN(sizeof(*data.data) * (size_t)bheads_len, __func__),
+      .allocname = allocname,
+  };
+  int i = 0;
+  for (bhead = blo_bhead_next(fd, bhead); bhead != bhead_end; bhead = blo_bhead_next(fd, bhead)) {
+    data.bheads[i++] = bhead;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, bheads_len, &data, read_data_parallel_cb, &settings);
+
+  /* Insert in file order, as done when reading sequentially. */
+  for (i = 0; i < bheads_len; i++) {
+    if (data.data[i]) {
+      oldnewmap_insert(fd->datamap, data.bheads[i]->old, data.data[i], 0);
+    }
+  }
+
+  MEM_freeN(data.bheads);
+  MEM_freeN(data.data);
+
+  *r_bhead = bhead_end;
+  return true;
+}
+#endif /* USE_READ_DATA_PARALLEL */
+
 static BHead *read_data_into_oldnewmap(FileData *fd, BHead *bhead, const char *allocname)
 {
+#ifdef USE_READ_DATA_PARALLEL
+  if (read_data_into_oldnewmap_parallel(fd, &bhead, allocname)) {
+    return bhead;
+  }
+#endif
+
   bhead = blo_bhead_next(fd, bhead);
 
   while (bhead && bhead->code == DATA) {
@@ -9313,6 +9981,179 @@ static BHead *read_data_into_oldnewmap(FileData *fd, BHead *bhead, const char *a
   return bhead;
 }
 
+#ifdef USE_UNDO_REUSE_IDS
+static bool read_undo_id_can_reuse(FileData *fd, BHead *bhead, ID *id_old)
+{
+  const short idcode = GS(id_old->name);
+
+  if ((idcode != bhead->code) || !STREQ(id_old->name, blo_bhead_id_name(fd, bhead))) {
+    return false;
+  }
+  /* The UI is kept from the old main separately, libraries are handled by #read_libblock. */
+  if (ELEM(idcode, ID_WM, ID_SCR, ID_WS, ID_LI)) {
+    return false;
+  }
+  if ((id_old->lib != NULL) || (id_old->override_library != NULL)) {
+    return false;
+  }
+  if (idcode == ID_OB) {
+    const Object *ob = (const Object *)id_old;
+    /* Proxies are set up when lib-linking, sculpt sessions use the evaluated data. */
+    if ((ob->proxy != NULL) || (ob->sculpt != NULL)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int read_undo_reused_id_check_cb(void *user_data,
+                                        ID *id_self,
+                                        ID **id_pointer,
+                                        int cb_flag)
+{
+  bool *r_is_valid = user_data;
+  ID *id = *id_pointer;
+
+  /* Linked data is kept on undo, embedded data is part of its owner. */
+  if ((id == NULL) || (id == id_self) || ID_IS_LINKED(id) || (cb_flag & IDWALK_CB_PRIVATE)) {
+    return IDWALK_RET_NOP;
+  }
+  if ((id->tag & LIB_TAG_UNDO_OLD_ID_REUSED) == 0) {
+    *r_is_valid = false;
+    return IDWALK_RET_STOP_ITER;
+  }
+  return IDWALK_RET_NOP;
+}
+
+/**
+ * Find the IDs of the old main which can be kept as is on undo (see #USE_UNDO_REUSE_IDS),
+ * they are tagged with #LIB_TAG_UNDO_OLD_ID_REUSED and added to #FileData.undo_reused_ids.
+ *
+ * Those are the IDs whose blocks are all read from chunks shared with the memfile
+ * of the current state (so they didn't change), and which only use other local IDs kept as is,
+ * since the pointers to IDs which are read again would be invalid.
+ */
+static void read_undo_reused_ids_find(FileData *fd)
+{
+  Main *old_main = fd->old_mainlist->first;
+  ListBase *lbarray[MAX_LIBARRAY];
+  const int lb_len = set_listbasepointers(old_main, lbarray);
+
+  /* IDs are written with their address, which is used to find the old ones. */
+  GHash *old_ids = BLI_ghash_ptr_new(__func__);
+  for (int i = 0; i < lb_len; i++) {
+    LISTBASE_FOREACH (ID *, id, lbarray[i]) {
+      BLI_ghash_insert(old_ids, id, id);
+    }
+  }
+
+  ID **ids = MEM_mallocN(sizeof(*ids) * MAX2(BLI_ghash_len(old_ids), 1), __func__);
+  int ids_len = 0;
+
+  BHead *bhead = blo_bhead_first(fd);
+  while (bhead && bhead->code != ENDB) {
+    if (!BKE_idcode_is_valid(bhead->code)) {
+      bhead = blo_bhead_next(fd, bhead);
+      continue;
+    }
+
+    BHead *bhead_id = bhead;
+    bool is_identical = BHEADN_FROM_BHEAD(bhead_id)->is_memchunk_identical;
+    for (bhead = blo_bhead_next(fd, bhead); bhead && bhead->code == DATA;
+         bhead = blo_bhead_next(fd, bhead)) {
+      is_identical = is_identical && BHEADN_FROM_BHEAD(bhead)->is_memchunk_identical;
+    }
+
+    if (is_identical) {
+      ID *id_old = BLI_ghash_lookup(old_ids, bhead_id->old);
+      if ((id_old != NULL) && (id_old->tag & LIB_TAG_UNDO_OLD_ID_REUSED) == 0 &&
+          read_undo_id_can_reuse(fd, bhead_id, id_old)) {
+        id_old->tag |= LIB_TAG_UNDO_OLD_ID_REUSED;
+        ids[ids_len++] = id_old;
+      }
+    }
+  }
+
+  BLI_ghash_free(old_ids, NULL, NULL);
+
+  /* Untag the IDs using other IDs which are read again, until none are left. */
+  bool is_changed;
+  do {
+    is_changed = false;
+    for (int i = 0; i < ids_len; i++) {
+      ID *id = ids[i];
+      if (id->tag & LIB_TAG_UNDO_OLD_ID_REUSED) {
+        bool is_valid = true;
+        BKE_library_foreach_ID_link(
+            old_main, id, read_undo_reused_id_check_cb, &is_valid, IDWALK_READONLY);
+        if (!is_valid) {
+          id->tag &= ~LIB_TAG_UNDO_OLD_ID_REUSED;
+          is_changed = true;
+        }
+      }
+    }
+  } while (is_changed);
+
+  for (int i = 0; i < ids_len; i++) {
+    ID *id = ids[i];
+    if (id->tag & LIB_TAG_UNDO_OLD_ID_REUSED) {
+      if (fd->undo_reused_ids == NULL) {
+        fd->undo_reused_ids = BLI_gset_ptr_new(__func__);
+      }
+      BLI_gset_add(fd->undo_reused_ids, id);
+    }
+  }
+
+  MEM_freeN(ids);
+}
+
+/**
+ * Move an ID found by #read_undo_reused_ids_find from the old main, instead of reading it.
+ */
+static BHead *read_libblock_undo_reuse(FileData *fd, Main *main, BHead *bhead, ID **r_id)
+{
+  Main *old_main = fd->old_mainlist->first;
+  ID *id = (ID *)bhead->old;
+  const short idcode = GS(id->name);
+
+  BLI_assert(id->tag & LIB_TAG_UNDO_OLD_ID_REUSED);
+
+  BLI_remlink(which_libbase(old_main, idcode), id);
+  BLI_addtail(which_libbase(main, idcode), id);
+
+  /* So the IDs which are read again find it (at the same address). */
+  oldnewmap_insert(fd->libmap, bhead->old, id, bhead->code);
+
+  if (idcode == ID_SCE) {
+    /* Depsgraphs also reference the IDs which are read again, they are built again. */
+    BKE_scene_free_depsgraph_hash((Scene *)id);
+  }
+
+  if (r_id) {
+    *r_id = id;
+  }
+
+  /* Skip the data of the ID. */
+  for (bhead = blo_bhead_next(fd, bhead); bhead && bhead->code == DATA;
+       bhead = blo_bhead_next(fd, bhead)) {
+    /* pass */
+  }
+  return bhead;
+}
+
+/**
+ * Finish reading after lib-linking, when IDs were kept by #read_libblock_undo_reuse.
+ */
+static void read_undo_reused_ids_finalize(Main *bmain)
+{
+  /* The user counts of the IDs which are kept include users from the old main,
+   * which is freed without updating them. */
+  BKE_main_id_refcount_recompute(bmain, false);
+
+  BKE_main_id_tag_all(bmain, LIB_TAG_UNDO_OLD_ID_REUSED, false);
+}
+#endif /* USE_UNDO_REUSE_IDS */
+
 static BHead *read_libblock(FileData *fd,
                             Main *main,
                             BHead *bhead,
@@ -9389,6 +10230,12 @@ static BHead *read_libblock(FileData *fd,
     }
   }
 
+#ifdef USE_UNDO_REUSE_IDS
+  if ((fd->undo_reused_ids != NULL) && BLI_gset_haskey(fd->undo_reused_ids, bhead->old)) {
+    return read_libblock_undo_reuse(fd, main, bhead, r_id);
+  }
+#endif
+
   /* read libblock */
   id = read_struct(fd, bhead, "lib block");
 
@@ -9606,6 +10453,8 @@ static BHead *read_global(BlendFileData *bfd, FileData *fd, BHead *bhead)
   BLI_strncpy(bfd->main->build_hash, fg->build_hash, sizeof(bfd->main->build_hash));
 
   bfd->fileflags = fg->fileflags;
+  /* Based on how the file was actually written, keep it when saving over. */
+  SET_FLAG_FROM_TEST(bfd->fileflags, fd->lzo != NULL, G_FILE_COMPRESS_FAST);
   bfd->globalf = fg->globalf;
   BLI_strncpy(bfd->filename, fg->filename, sizeof(bfd->filename));
 
@@ -9977,6 +10826,13 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+#ifdef USE_UNDO_REUSE_IDS
+  if ((fd->undo_current_chunks != NULL) && (fd->old_mainlist != NULL) &&
+      (fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    read_undo_reused_ids_find(fd);
+  }
+#endif
+
   while (bhead) {
     switch (bhead->code) {
       case DATA:
@@ -10046,6 +10902,12 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
     lib_link_all(fd, bfd->main);
 
+#ifdef USE_UNDO_REUSE_IDS
+    if (fd->undo_reused_ids != NULL) {
+      read_undo_reused_ids_finalize(bfd->main);
+    }
+#endif
+
     /* Skip in undo case. */
     if (fd->memfile == NULL) {
       /* Yep, second splitting... but this is a very cheap operation, so no big deal. */
@@ -12055,6 +12917,148 @@ static void read_library_clear_weak_links(FileData *basefd, ListBase *mainlist,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Library File Data Cache
+ * \{ */
+
+#ifdef USE_LIBRARY_FILEDATA_CACHE
+/* Limits the number of open files, the oldest entries are freed first. */
+#  define LIBRARY_FILEDATA_CACHE_MAX 32
+
+typedef struct LibraryFileDataCache {
+  struct LibraryFileDataCache *next, *prev;
+  FileData *fd;
+  /** Used to detect the file changed on disk since it was cached. */
+  int64_t mtime;
+  int64_t size;
+} LibraryFileDataCache;
+
+static ListBase library_filedata_cache = {NULL, NULL};
+static ThreadMutex library_filedata_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static bool library_filedata_cache_stat(const char *filepath, int64_t *r_mtime, int64_t *r_size)
+{
+  BLI_stat_t st;
+  if (BLI_stat(filepath, &st) == -1) {
+    return false;
+  }
+  *r_mtime = (int64_t)st.st_mtime;
+  *r_size = (int64_t)st.st_size;
+  return true;
+}
+
+static void library_filedata_cache_clear_cb(void *UNUSED(user_data))
+{
+  BLO_library_filedata_cache_clear();
+}
+
+/**
+ * Take the cached file data of \a filepath (if any),
+ * it's removed from the cache while in use, so it's never shared between threads.
+ */
+static FileData *library_filedata_cache_pop(const char *filepath)
+{
+  LibraryFileDataCache *cache = NULL;
+
+  BLI_mutex_lock(&library_filedata_cache_lock);
+  LISTBASE_FOREACH (LibraryFileDataCache *, cache_iter, &library_filedata_cache) {
+    if (BLI_path_cmp(cache_iter->fd->relabase, filepath) == 0) {
+      cache = cache_iter;
+      BLI_remlink(&library_filedata_cache, cache);
+      break;
+    }
+  }
+  BLI_mutex_unlock(&library_filedata_cache_lock);
+
+  if (cache == NULL) {
+    return NULL;
+  }
+
+  FileData *fd = cache->fd;
+  int64_t mtime, size;
+  if (!library_filedata_cache_stat(filepath, &mtime, &size) || (mtime != cache->mtime) ||
+      (size != cache->size)) {
+    blo_filedata_free(fd);
+    fd = NULL;
+  }
+  MEM_freeN(cache);
+  return fd;
+}
+
+/**
+ * Cache or free \a fd once reading a library is done.
+ */
+static void library_filedata_cache_push(FileData *fd)
+{
+  int64_t mtime, size;
+
+  /* Data read in memory (packed & compressed libraries) would be kept around,
+   * endian switching is done in-place on the blocks read in memory. */
+  if ((fd->seek == NULL) || (fd->buffer != NULL) || (fd->memfile != NULL) ||
+      (fd->flags & FD_FLAGS_SWITCH_ENDIAN) || !(fd->flags & FD_FLAGS_FILE_OK) ||
+      (fd->bhead_idname_hash == NULL) ||
+      !library_filedata_cache_stat(fd->relabase, &mtime, &size)) {
+    blo_filedata_free(fd);
+    return;
+  }
+
+  /* Clear everything only valid while reading the current file. */
+  oldnewmap_clear(fd->datamap);
+  if (fd->libmap) {
+    oldnewmap_clear(fd->libmap);
+  }
+  fd->mainlist = NULL;
+  fd->old_mainlist = NULL;
+  fd->reports = NULL;
+
+  LibraryFileDataCache *cache = MEM_mallocN(sizeof(*cache), __func__);
+  cache->fd = fd;
+  cache->mtime = mtime;
+  cache->size = size;
+
+  FileData *fd_free = NULL;
+  BLI_mutex_lock(&library_filedata_cache_lock);
+  if (BLI_listbase_is_empty(&library_filedata_cache)) {
+    static bool is_atexit_registered = false;
+    if (!is_atexit_registered) {
+      BKE_blender_atexit_register(library_filedata_cache_clear_cb, NULL);
+      is_atexit_registered = true;
+    }
+  }
+  BLI_addhead(&library_filedata_cache, cache);
+  if (BLI_listbase_count_at_most(&library_filedata_cache, LIBRARY_FILEDATA_CACHE_MAX + 1) >
+      LIBRARY_FILEDATA_CACHE_MAX) {
+    LibraryFileDataCache *cache_last = library_filedata_cache.last;
+    BLI_remlink(&library_filedata_cache, cache_last);
+    fd_free = cache_last->fd;
+    MEM_freeN(cache_last);
+  }
+  BLI_mutex_unlock(&library_filedata_cache_lock);
+
+  if (fd_free) {
+    blo_filedata_free(fd_free);
+  }
+}
+#endif /* USE_LIBRARY_FILEDATA_CACHE */
+
+/**
+ * Free the file data of libraries kept from previously loaded files.
+ */
+void BLO_library_filedata_cache_clear(void)
+{
+#ifdef USE_LIBRARY_FILEDATA_CACHE
+  BLI_mutex_lock(&library_filedata_cache_lock);
+  LISTBASE_FOREACH_MUTABLE (LibraryFileDataCache *, cache, &library_filedata_cache) {
+    blo_filedata_free(cache->fd);
+    MEM_freeN(cache);
+  }
+  BLI_listbase_clear(&library_filedata_cache);
+  BLI_mutex_unlock(&library_filedata_cache_lock);
+#endif
+}
+
+/** \} */
+
 static FileData *read_library_file_data(FileData *basefd,
                                         ListBase *mainlist,
                                         Main *mainl,
@@ -12089,7 +13093,13 @@ static FileData *read_library_file_data(FileData *basefd,
                      mainptr->curlib->filepath,
                      mainptr->curlib->name,
                      library_parent_filepath(mainptr->curlib));
-    fd = blo_filedata_from_file(mainptr->curlib->filepath, basefd->reports);
+#ifdef USE_LIBRARY_FILEDATA_CACHE
+    fd = library_filedata_cache_pop(mainptr->curlib->filepath);
+    if (fd == NULL)
+#endif
+    {
+      fd = blo_filedata_from_file(mainptr->curlib->filepath, basefd->reports);
+    }
   }
 
   if (fd) {
@@ -12113,7 +13123,10 @@ static FileData *read_library_file_data(FileData *basefd,
     /* subversion */
     read_file_version(fd, mainptr);
 #ifdef USE_GHASH_BHEAD
-    read_file_bhead_idname_map_create(fd);
+    /* Already created when the file data is cached. */
+    if (fd->bhead_idname_hash == NULL) {
+      read_file_bhead_idname_map_create(fd);
+    }
 #endif
   }
   else {
@@ -12210,7 +13223,15 @@ static void read_libraries(FileData *basefd, ListBase *mainlist)
 
     /* Free file data we no longer need. */
     if (mainptr->curlib->filedata) {
-      blo_filedata_free(mainptr->curlib->filedata);
+#ifdef USE_LIBRARY_FILEDATA_CACHE
+      if (mainptr->curlib->packedfile == NULL) {
+        library_filedata_cache_push(mainptr->curlib->filedata);
+      }
+      else
+#endif
+      {
+        blo_filedata_free(mainptr->curlib->filedata);
+      }
     }
     mainptr->curlib->filedata = NULL;
   }
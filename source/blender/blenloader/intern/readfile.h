@@ -30,6 +30,9 @@
 #include "DNA_space_types.h"
 #include "DNA_windowmanager_types.h" /* for ReportType */
 
+struct BlendFileIndexHeader;
+struct FileDataLZO;
+struct GSet;
 struct Key;
 struct MemFile;
 struct Object;
@@ -74,15 +77,25 @@ typedef struct FileData {
   /** Regular file reading. */
   int filedes;
 
+  /** Variables needed for reading from a memory mapped file (see #USE_BHEAD_READ_MMAP). */
+  const char *mmap_buffer;
+  size_t mmap_size;
+
   /** Variables needed for reading from memory / stream. */
   const char *buffer;
   /** Variables needed for reading from memfile (undo). */
   struct MemFile *memfile;
+  /** Buffers of the #MemFileChunk of the current state (see #USE_UNDO_REUSE_IDS). */
+  struct GSet *undo_current_chunks;
+  /** Cleared when a block being read isn't shared with the current state. */
+  bool is_memchunk_identical;
 
   /** Variables needed for reading from file. */
   gzFile gzfiledes;
   /** Gzip stream for memory decompression. */
   z_stream strm;
+  /** Variables needed for reading from a file with fast block compression. */
+  struct FileDataLZO *lzo;
 
   /** Now only in use for library appending. */
   char relabase[FILE_MAX];
@@ -92,6 +105,8 @@ typedef struct FileData {
   const struct SDNA *memsdna;
   /** Array of #eSDNA_StructCompare. */
   const char *compflags;
+  /** Conversion plans for the structs which differ, see #DNA_reconstruct_info_create. */
+  struct DNA_ReconstructInfo *reconstruct_info;
 
   int fileversion;
   /** Used to retrieve ID names from (bhead+1). */
@@ -117,6 +132,12 @@ typedef struct FileData {
   /** See: #USE_GHASH_BHEAD. */
   struct GHash *bhead_idname_hash;
 
+  /** See: #BlendFileIndexHeader, NULL when the file has no (valid) index. */
+  struct BlendFileIndexHeader *index;
+
+  /** Addresses of the IDs of the old main which are kept as is on undo. */
+  struct GSet *undo_reused_ids;
+
   ListBase *mainlist;
   /** Used for undo. */
   ListBase *old_mainlist;
@@ -126,6 +147,76 @@ typedef struct FileData {
 
 #define SIZEOFBLENDERHEADER 12
 
+/**
+ * Fast block compression (see #G_FILE_COMPRESS_FAST).
+ *
+ * The file is split into frames which are compressed independently,
+ * so they can be (de)compressed in parallel and read in any order.
+ * All values are stored little endian:
+ *
+ * - Header: #BLEND_LZO_MAGIC, frame size (uncompressed, `uint32_t`).
+ * - The compressed frames.
+ * - Table: a #BlendLZOFrame for each frame.
+ * - Footer: number of frames (`uint32_t`), #BLEND_LZO_MAGIC.
+ *
+ * Only the last frame may be smaller than the frame size.
+ */
+#define BLEND_LZO_MAGIC "BLZO"
+#define BLEND_LZO_MAGIC_LEN 4
+#define BLEND_LZO_HEADER_LEN (BLEND_LZO_MAGIC_LEN + 4)
+#define BLEND_LZO_FOOTER_LEN (4 + BLEND_LZO_MAGIC_LEN)
+#define BLEND_LZO_FRAME_SIZE (1 << 20)
+
+typedef struct BlendLZOFrame {
+  /** When equal to `len` the frame is stored uncompressed. */
+  uint32_t compressed_len;
+  uint32_t len;
+} BlendLZOFrame;
+
+/**
+ * Index of the data-blocks in a file, so listing them doesn't need to scan the whole file.
+ *
+ * Written as the data of a #REND block between #DNA1 and #ENDB
+ * (older versions skip #REND blocks), since the footer is at a known location
+ * from the end of the file it can be found without reading anything else.
+ * Values use the byte order of the file, offsets are from the start of the (uncompressed) file:
+ *
+ * - #BlendFileIndexHeader
+ * - #BlendFileIndexEntry for each ID, in file order.
+ * - #BlendFileIndexFooter
+ */
+#define BLEND_FILE_INDEX_MAGIC "BIDX"
+#define BLEND_FILE_INDEX_VERSION 1
+
+typedef struct BlendFileIndexHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t entries_num;
+  uint32_t _pad;
+  /** Offset of the #DNA1 #BHead. */
+  uint64_t dna_offset;
+} BlendFileIndexHeader;
+
+typedef struct BlendFileIndexEntry {
+  /** #BHead.code of the ID. */
+  int32_t code;
+  uint32_t _pad;
+  /** Offset of the ID #BHead. */
+  uint64_t offset;
+  /** Offset of the #PreviewImage #BHead, zero when the ID has no preview. */
+  uint64_t preview_offset;
+  char name[MAX_ID_NAME];
+  char _pad1[6];
+} BlendFileIndexEntry;
+
+typedef struct BlendFileIndexFooter {
+  /** Size of the whole index (including header and footer). */
+  uint32_t len;
+  char magic[4];
+} BlendFileIndexFooter;
+
+#define BLEND_FILE_INDEX_ENTRIES(index) ((BlendFileIndexEntry *)((index) + 1))
+
 /***/
 struct Main;
 void blo_join_main(ListBase *mainlist);
@@ -135,7 +226,9 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath);
 
 FileData *blo_filedata_from_file(const char *filepath, struct ReportList *reports);
 FileData *blo_filedata_from_memory(const void *buffer, int buffersize, struct ReportList *reports);
-FileData *blo_filedata_from_memfile(struct MemFile *memfile, struct ReportList *reports);
+FileData *blo_filedata_from_memfile(struct MemFile *memfile,
+                                    const struct MemFile *memfile_current,
+                                    struct ReportList *reports);
 
 void blo_clear_proxy_pointers_from_lib(struct Main *oldmain);
 void blo_make_image_pointer_map(FileData *fd, struct Main *oldmain);
@@ -157,6 +250,8 @@ BHead *blo_bhead_next(FileData *fd, BHead *thisblock);
 BHead *blo_bhead_prev(FileData *fd, BHead *thisblock);
 
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead);
+BHead *blo_bhead_read_at_offset(FileData *fd, uint64_t offset);
+void blo_bhead_free(BHead *bhead);
 
 /* do versions stuff */
 
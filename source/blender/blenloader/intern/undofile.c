@@ -36,11 +36,15 @@
 #  include <io.h>
 #endif
 
+#include "zlib.h"
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_undofile.h"
 #include "BLO_readfile.h"
@@ -70,46 +74,99 @@ void BLO_memfile_free(MemFile *memfile)
 /* result is that 'first' is being freed */
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
-  MemFileChunk *fc, *sc;
+  /* Chunks of 'second' may share any chunk of 'first' (not only the one at the same position),
+   * so ownership is transferred by buffer instead of by position. */
+  GHash *buf_to_chunk = BLI_ghash_ptr_new_ex(__func__, (uint)BLI_listbase_count(&first->chunks));
+
+  LISTBASE_FOREACH (MemFileChunk *, fc, &first->chunks) {
+    if (fc->is_identical == false) {
+      BLI_ghash_insert(buf_to_chunk, (void *)fc->buf, fc);
+    }
+  }
 
-  fc = first->chunks.first;
-  sc = second->chunks.first;
-  while (fc || sc) {
-    if (fc && sc) {
-      if (sc->is_identical) {
+  LISTBASE_FOREACH (MemFileChunk *, sc, &second->chunks) {
+    if (sc->is_identical) {
+      MemFileChunk *fc = BLI_ghash_lookup(buf_to_chunk, sc->buf);
+      if (fc != NULL && fc->is_identical == false) {
         sc->is_identical = false;
         fc->is_identical = true;
       }
     }
-    if (fc) {
-      fc = fc->next;
-    }
-    if (sc) {
-      sc = sc->next;
-    }
   }
 
+  BLI_ghash_free(buf_to_chunk, NULL, NULL);
+
   BLO_memfile_free(first);
 }
 
-void memfile_chunk_add(MemFile *memfile, const char *buf, uint size, MemFileChunk **compchunk_step)
+void BLO_memfile_write_init(MemFileWriteData *mem_data,
+                            MemFile *written_memfile,
+                            MemFile *reference_memfile)
 {
+  mem_data->written_memfile = written_memfile;
+  mem_data->reference_memfile = reference_memfile;
+  mem_data->reference_current_chunk = reference_memfile ? reference_memfile->chunks.first : NULL;
+  mem_data->reference_chunks_hash = NULL;
+
+  if (reference_memfile != NULL) {
+    GHash *chunks_hash = BLI_ghash_int_new_ex(
+        __func__, (uint)BLI_listbase_count(&reference_memfile->chunks));
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &reference_memfile->chunks) {
+      void **val_p;
+      /* On (unlikely) hash collisions only the first chunk can be found again. */
+      if (!BLI_ghash_ensure_p(chunks_hash, POINTER_FROM_UINT(chunk->hash), &val_p)) {
+        *val_p = chunk;
+      }
+    }
+    mem_data->reference_chunks_hash = chunks_hash;
+  }
+}
+
+void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
+{
+  if (mem_data->reference_chunks_hash != NULL) {
+    BLI_ghash_free(mem_data->reference_chunks_hash, NULL, NULL);
+    mem_data->reference_chunks_hash = NULL;
+  }
+}
+
+BLI_INLINE bool memfile_chunk_is_identical(const MemFileChunk *chunk,
+                                           const char *buf,
+                                           const uint size,
+                                           const uint hash)
+{
+  return (chunk->hash == hash) && (chunk->size == size) && (memcmp(chunk->buf, buf, size) == 0);
+}
+
+void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, uint size)
+{
+  MemFile *memfile = mem_data->written_memfile;
   MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
   curchunk->size = size;
   curchunk->buf = NULL;
+  curchunk->hash = BLI_hash_mm2((const uchar *)buf, size, 0);
   curchunk->is_identical = false;
   BLI_addtail(&memfile->chunks, curchunk);
 
-  /* we compare compchunk with buf */
-  if (*compchunk_step != NULL) {
-    MemFileChunk *compchunk = *compchunk_step;
-    if (compchunk->size == curchunk->size) {
-      if (memcmp(compchunk->buf, buf, size) == 0) {
-        curchunk->buf = compchunk->buf;
-        curchunk->is_identical = true;
+  if (mem_data->reference_memfile != NULL) {
+    /* We compare the chunk at the same position first (the common case)... */
+    MemFileChunk *compchunk = mem_data->reference_current_chunk;
+    if (compchunk != NULL) {
+      mem_data->reference_current_chunk = compchunk->next;
+    }
+    /* ... then any chunk with the same contents,
+     * so data that moved (e.g. after an ID was added or removed) is still shared. */
+    if (compchunk == NULL || !memfile_chunk_is_identical(compchunk, buf, size, curchunk->hash)) {
+      compchunk = BLI_ghash_lookup(mem_data->reference_chunks_hash,
+                                   POINTER_FROM_UINT(curchunk->hash));
+      if (compchunk != NULL && !memfile_chunk_is_identical(compchunk, buf, size, curchunk->hash)) {
+        compchunk = NULL;
       }
     }
-    *compchunk_step = compchunk->next;
+    if (compchunk != NULL) {
+      curchunk->buf = compchunk->buf;
+      curchunk->is_identical = true;
+    }
   }
 
   /* not equal... */
@@ -121,13 +178,36 @@ void memfile_chunk_add(MemFile *memfile, const char *buf, uint size, MemFileChun
   }
 }
 
+/**
+ * Copy all data of \a memfile, so the copy can be used (e.g. written from another thread)
+ * without depending on the undo steps which \a memfile shares chunks with.
+ */
+MemFile *BLO_memfile_copy(const MemFile *memfile)
+{
+  MemFile *memfile_copy = MEM_callocN(sizeof(MemFile), __func__);
+
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    MemFileChunk *chunk_copy = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
+    char *buf_new = MEM_mallocN(chunk->size, "Chunk buffer");
+    memcpy(buf_new, chunk->buf, chunk->size);
+    chunk_copy->buf = buf_new;
+    chunk_copy->size = chunk->size;
+    chunk_copy->hash = chunk->hash;
+    chunk_copy->is_identical = false;
+    BLI_addtail(&memfile_copy->chunks, chunk_copy);
+    memfile_copy->size += chunk->size;
+  }
+
+  return memfile_copy;
+}
+
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Main *oldmain,
                                   struct Scene **r_scene)
 {
   struct Main *bmain_undo = NULL;
   BlendFileData *bfd = BLO_read_from_memfile(
-      oldmain, BKE_main_blendfile_path(oldmain), memfile, BLO_READ_SKIP_NONE, NULL);
+      oldmain, BKE_main_blendfile_path(oldmain), memfile, NULL, BLO_READ_SKIP_NONE, NULL);
 
   if (bfd) {
     bmain_undo = bfd->main;
@@ -144,12 +224,22 @@ struct Main *BLO_memfile_main_get(struct MemFile *memfile,
 /**
  * Saves .blend using undo buffer.
  *
+ * The file is written next to \a filename first and renamed when complete,
+ * so a failed write (or crash) never leaves an incomplete file behind.
+ *
+ * \param use_compress: Write a gzip compressed file.
+ * \param stop: When set (from another thread), writing is canceled (can be NULL).
  * \return success.
  */
-bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
+bool BLO_memfile_write_file_ex(struct MemFile *memfile,
+                               const char *filename,
+                               const bool use_compress,
+                               const short *stop)
 {
   MemFileChunk *chunk;
+  char tempname[FILE_MAX + 1];
   int file, oflags;
+  gzFile gzfile = NULL;
 
   /* note: This is currently used for autosave and 'quit.blend',
    * where _not_ following symlinks is OK,
@@ -157,6 +247,8 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
    * we may want to allow writing to symlinks.
    */
 
+  BLI_snprintf(tempname, sizeof(tempname), "%s@", filename);
+
   oflags = O_BINARY | O_WRONLY | O_CREAT | O_TRUNC;
 #ifdef O_NOFOLLOW
   /* use O_NOFOLLOW to avoid writing to a symlink - use 'O_EXCL' (CVE-2008-1103) */
@@ -167,7 +259,15 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
 #    warning "Symbolic links will be followed on undo save, possibly causing CVE-2008-1103"
 #  endif
 #endif
-  file = BLI_open(filename, oflags, 0666);
+  file = BLI_open(tempname, oflags, 0666);
+
+  if (file != -1 && use_compress) {
+    gzfile = gzdopen(file, "wb1");
+    if (gzfile == NULL) {
+      close(file);
+      file = -1;
+    }
+  }
 
   if (file == -1) {
     fprintf(stderr,
@@ -178,19 +278,57 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
   }
 
   for (chunk = memfile->chunks.first; chunk; chunk = chunk->next) {
-    if ((size_t)write(file, chunk->buf, chunk->size) != chunk->size) {
+    if (stop && *stop) {
+      break;
+    }
+    if (gzfile) {
+      if (gzwrite(gzfile, chunk->buf, chunk->size) != (int)chunk->size) {
+        break;
+      }
+    }
+    else if ((size_t)write(file, chunk->buf, chunk->size) != chunk->size) {
       break;
     }
   }
 
-  close(file);
+  bool ok = (chunk == NULL);
+  if (gzfile) {
+    /* Also closes the file. */
+    if (gzclose(gzfile) != Z_OK) {
+      ok = false;
+    }
+  }
+  else if (close(file) == -1) {
+    ok = false;
+  }
 
-  if (chunk) {
-    fprintf(stderr,
-            "Unable to save '%s': %s\n",
-            filename,
-            errno ? strerror(errno) : "Unknown error writing file");
+  if (ok) {
+#ifdef WIN32
+    if (BLI_rename(tempname, filename) != 0) {
+      ok = false;
+    }
+#else
+    /* Unlike #BLI_rename, atomically replaces an existing file. */
+    if (rename(tempname, filename) != 0) {
+      ok = false;
+    }
+#endif
+  }
+
+  if (!ok) {
+    if (!(stop && *stop)) {
+      fprintf(stderr,
+              "Unable to save '%s': %s\n",
+              filename,
+              errno ? strerror(errno) : "Unknown error writing file");
+    }
+    BLI_delete(tempname, false, false);
     return false;
   }
   return true;
 }
+
+bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
+{
+  return BLO_memfile_write_file_ex(memfile, filename, false, NULL);
+}
@@ -703,6 +703,16 @@ void BLO_version_defaults_userpref_blend(Main *bmain, UserDef *userdef)
    */
   {
     /* Keep this block, even when empty. */
+    if (userdef->modifier_cache_limit == 0) {
+      userdef->modifier_cache_limit = U_default.modifier_cache_limit;
+    }
+    if (userdef->compositor_cache_limit == 0) {
+      userdef->compositor_cache_limit = U_default.compositor_cache_limit;
+    }
+    if (userdef->sequencer_disk_cache_size_limit == 0) {
+      userdef->sequencer_disk_cache_size_limit = U_default.sequencer_disk_cache_size_limit;
+      userdef->sequencer_disk_cache_compression = U_default.sequencer_disk_cache_compression;
+    }
   }
 
   if (userdef->pixelsize == 0.0f) {
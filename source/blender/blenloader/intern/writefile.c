@@ -144,7 +144,11 @@
 #include "MEM_guardedalloc.h"  // MEM_freeN
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
+#include "BLI_endian_switch.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BKE_action.h"
 #include "BKE_blender_version.h"
@@ -181,6 +185,14 @@
 
 #include <errno.h>
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#endif
+
 /* Make preferences read-only. */
 #define U (*((const UserDef *)&U))
 
@@ -193,6 +205,13 @@
 /** Use if we want to store how many bytes have been written to the file. */
 // #define USE_WRITE_DATA_LEN
 
+/**
+ * Write the ID's of each type in parallel into separate buffers,
+ * which are then written to the file in order (see #write_id_list_parallel).
+ * Not used for undo, which de-duplicates against the previous step while writing.
+ */
+#define USE_WRITE_PARALLEL
+
 /* -------------------------------------------------------------------- */
 /** \name Internal Write Wrapper's (Abstracts Compression)
  * \{ */
@@ -200,8 +219,13 @@
 typedef enum {
   WW_WRAP_NONE = 1,
   WW_WRAP_ZLIB,
+#ifdef WITH_LZO
+  WW_WRAP_LZO,
+#endif
 } eWriteWrapType;
 
+struct WriteWrapLZO;
+
 typedef struct WriteWrap WriteWrap;
 struct WriteWrap {
   /* callbacks */
@@ -216,6 +240,7 @@ struct WriteWrap {
   union {
     int file_handle;
     gzFile gz_handle;
+    struct WriteWrapLZO *lzo_handle;
   } _user_data;
 };
 
@@ -273,6 +298,180 @@ static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
+#ifdef WITH_LZO
+/* lzo (see #BLEND_LZO_MAGIC for the file layout) */
+#  define FILE_HANDLE(ww) (ww)->_user_data.lzo_handle
+
+#  define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
+
+typedef struct WriteWrapLZOFrame {
+  uchar *in, *out;
+  /** Work memory for #lzo1x_1_compress. */
+  void *wrkmem;
+  uint len, compressed_len;
+} WriteWrapLZOFrame;
+
+typedef struct WriteWrapLZO {
+  int file_handle;
+  bool error;
+
+  /** Frames are compressed in parallel, then written in order. */
+  WriteWrapLZOFrame *frames;
+  int frames_len;
+  /** Frame currently being filled, all previous frames are full. */
+  int frame_active;
+
+  /** Sizes of all written frames, for the table at the end of the file. */
+  BlendLZOFrame *table;
+  uint table_len, table_len_alloc;
+} WriteWrapLZO;
+
+static bool ww_write_lzo_raw(WriteWrapLZO *lzo, const void *buf, size_t buf_len)
+{
+  if (lzo->error == false) {
+    if ((size_t)write(lzo->file_handle, buf, buf_len) != buf_len) {
+      lzo->error = true;
+    }
+  }
+  return (lzo->error == false);
+}
+
+static bool ww_write_lzo_uint32(WriteWrapLZO *lzo, uint32_t value)
+{
+#  ifdef __BIG_ENDIAN__
+  BLI_endian_switch_uint32(&value);
+#  endif
+  return ww_write_lzo_raw(lzo, &value, sizeof(value));
+}
+
+static void ww_lzo_compress_frame_cb(void *__restrict userdata,
+                                     const int index,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  WriteWrapLZO *lzo = userdata;
+  WriteWrapLZOFrame *frame = &lzo->frames[index];
+  lzo_uint out_len = LZO_OUT_LEN(frame->len);
+
+  const int r = lzo1x_1_compress(frame->in, frame->len, frame->out, &out_len, frame->wrkmem);
+  /* Store as is when it doesn't compress. */
+  frame->compressed_len = ((r == LZO_E_OK) && (out_len < frame->len)) ? (uint)out_len :
+                                                                         frame->len;
+}
+
+/**
+ * Compress & write all filled frames (including the active one).
+ */
+static void ww_lzo_flush(WriteWrapLZO *lzo)
+{
+  const int frames_len = lzo->frame_active + (lzo->frames[lzo->frame_active].len != 0 ? 1 : 0);
+  if (frames_len == 0) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, frames_len, lzo, ww_lzo_compress_frame_cb, &settings);
+
+  for (int i = 0; i < frames_len; i++) {
+    WriteWrapLZOFrame *frame = &lzo->frames[i];
+    const bool is_compressed = frame->compressed_len != frame->len;
+    ww_write_lzo_raw(lzo, is_compressed ? frame->out : frame->in, frame->compressed_len);
+
+    if (lzo->table_len == lzo->table_len_alloc) {
+      lzo->table_len_alloc = MAX2(lzo->table_len_alloc * 2, 64);
+      lzo->table = MEM_reallocN(lzo->table, sizeof(*lzo->table) * lzo->table_len_alloc);
+    }
+    lzo->table[lzo->table_len++] = (BlendLZOFrame){frame->compressed_len, frame->len};
+    frame->len = 0;
+  }
+  lzo->frame_active = 0;
+}
+
+static bool ww_open_lzo(WriteWrap *ww, const char *filepath)
+{
+  int file;
+
+  file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
+
+  if (file == -1) {
+    return false;
+  }
+
+  WriteWrapLZO *lzo = MEM_callocN(sizeof(*lzo), __func__);
+  lzo->file_handle = file;
+  /* Enough frames to keep all threads busy. */
+  lzo->frames_len = MAX2(BLI_system_thread_count() * 2, 2);
+  lzo->frames = MEM_callocN(sizeof(*lzo->frames) * (size_t)lzo->frames_len, __func__);
+  for (int i = 0; i < lzo->frames_len; i++) {
+    WriteWrapLZOFrame *frame = &lzo->frames[i];
+    frame->in = MEM_mallocN(BLEND_LZO_FRAME_SIZE, __func__);
+    frame->out = MEM_mallocN(LZO_OUT_LEN(BLEND_LZO_FRAME_SIZE), __func__);
+    frame->wrkmem = MEM_mallocN(LZO1X_1_MEM_COMPRESS, __func__);
+  }
+
+  ww_write_lzo_raw(lzo, BLEND_LZO_MAGIC, BLEND_LZO_MAGIC_LEN);
+  ww_write_lzo_uint32(lzo, BLEND_LZO_FRAME_SIZE);
+
+  FILE_HANDLE(ww) = lzo;
+  return true;
+}
+static bool ww_close_lzo(WriteWrap *ww)
+{
+  WriteWrapLZO *lzo = FILE_HANDLE(ww);
+
+  ww_lzo_flush(lzo);
+
+  for (uint i = 0; i < lzo->table_len; i++) {
+    ww_write_lzo_uint32(lzo, lzo->table[i].compressed_len);
+    ww_write_lzo_uint32(lzo, lzo->table[i].len);
+  }
+  ww_write_lzo_uint32(lzo, lzo->table_len);
+  ww_write_lzo_raw(lzo, BLEND_LZO_MAGIC, BLEND_LZO_MAGIC_LEN);
+
+  bool ok = (lzo->error == false);
+  if (close(lzo->file_handle) == -1) {
+    ok = false;
+  }
+
+  for (int i = 0; i < lzo->frames_len; i++) {
+    WriteWrapLZOFrame *frame = &lzo->frames[i];
+    MEM_freeN(frame->in);
+    MEM_freeN(frame->out);
+    MEM_freeN(frame->wrkmem);
+  }
+  MEM_freeN(lzo->frames);
+  MEM_SAFE_FREE(lzo->table);
+  MEM_freeN(lzo);
+  return ok;
+}
+static size_t ww_write_lzo(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  WriteWrapLZO *lzo = FILE_HANDLE(ww);
+  size_t buf_offset = 0;
+
+  while (buf_offset < buf_len) {
+    WriteWrapLZOFrame *frame = &lzo->frames[lzo->frame_active];
+    const size_t len = MIN2(buf_len - buf_offset, (size_t)(BLEND_LZO_FRAME_SIZE - frame->len));
+    memcpy(frame->in + frame->len, buf + buf_offset, len);
+    frame->len += (uint)len;
+    buf_offset += len;
+
+    if (frame->len == BLEND_LZO_FRAME_SIZE) {
+      if (lzo->frame_active + 1 == lzo->frames_len) {
+        ww_lzo_flush(lzo);
+      }
+      else {
+        lzo->frame_active++;
+      }
+    }
+  }
+
+  return (lzo->error == false) ? buf_len : 0;
+}
+#  undef FILE_HANDLE
+#endif /* WITH_LZO */
+
 /* --- end compression types --- */
 
 static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
@@ -287,6 +486,15 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
       r_ww->use_buf = false;
       break;
     }
+#ifdef WITH_LZO
+    case WW_WRAP_LZO: {
+      r_ww->open = ww_open_lzo;
+      r_ww->close = ww_close_lzo;
+      r_ww->write = ww_write_lzo;
+      r_ww->use_buf = false;
+      break;
+    }
+#endif
     default: {
       r_ww->open = ww_open_none;
       r_ww->close = ww_close_none;
@@ -316,16 +524,25 @@ typedef struct {
   size_t write_len;
 #endif
 
+  /** Offset of the next byte to write (in the uncompressed file). */
+  uint64_t file_offset;
+
+  /** Index of the data-blocks, written at the end of the file (see #BlendFileIndexHeader). */
+  struct {
+    BlendFileIndexEntry *entries;
+    uint entries_num;
+    uint entries_len_alloc;
+    /** Offset of the #DNA1 block. */
+    uint64_t dna_offset;
+    /** Not needed for undo. */
+    bool use;
+  } index;
+
   /** Set on unlikely case of an error (ignores further file writing).  */
   bool error;
 
   /** #MemFile writing (used for undo). */
-  struct {
-    MemFile *current;
-    MemFile *compare;
-    /** Use to de-duplicate chunks when writing. */
-    MemFileChunk *compare_chunk;
-  } mem;
+  MemFileWriteData mem;
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
   bool use_memfile;
 
@@ -362,9 +579,9 @@ static void writedata_do_write(WriteData *wd, const void *mem, int memlen)
     return;
   }
 
-  /* memory based save */
-  if (wd->use_memfile) {
-    memfile_chunk_add(wd->mem.current, mem, memlen, &wd->mem.compare_chunk);
+  /* memory based save (also used for parallel writing, see #USE_WRITE_PARALLEL) */
+  if (wd->mem.written_memfile != NULL) {
+    BLO_memfile_chunk_add(&wd->mem, mem, (uint)memlen);
   }
   else {
     if (wd->ww->write(wd->ww, mem, memlen) != memlen) {
@@ -378,6 +595,9 @@ static void writedata_free(WriteData *wd)
   if (wd->buf) {
     MEM_freeN(wd->buf);
   }
+  if (wd->index.entries) {
+    MEM_freeN(wd->index.entries);
+  }
   MEM_freeN(wd);
 }
 
@@ -418,6 +638,7 @@ static void mywrite(WriteData *wd, const void *adr, int len)
 #ifdef USE_WRITE_DATA_LEN
   wd->write_len += len;
 #endif
+  wd->file_offset += (uint64_t)len;
 
   if (wd->buf == NULL) {
     writedata_do_write(wd, adr, len);
@@ -465,9 +686,7 @@ static WriteData *mywrite_begin(WriteWrap *ww, MemFile *compare, MemFile *curren
   WriteData *wd = writedata_new(ww);
 
   if (current != NULL) {
-    wd->mem.current = current;
-    wd->mem.compare = compare;
-    wd->mem.compare_chunk = compare ? compare->chunks.first : NULL;
+    BLO_memfile_write_init(&wd->mem, current, compare);
     wd->use_memfile = true;
   }
 
@@ -487,6 +706,10 @@ static bool mywrite_end(WriteData *wd)
     wd->buf_used_len = 0;
   }
 
+  if (wd->use_memfile) {
+    BLO_memfile_write_finalize(&wd->mem);
+  }
+
   const bool err = wd->error;
   writedata_free(wd);
 
@@ -495,6 +718,56 @@ static bool mywrite_end(WriteData *wd)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Data-Block Index Writing
+ * \{ */
+
+static BlendFileIndexEntry *writedata_index_entry_new(WriteData *wd)
+{
+  if (wd->index.entries_num == wd->index.entries_len_alloc) {
+    wd->index.entries_len_alloc = MAX2(wd->index.entries_len_alloc * 2, 64);
+    wd->index.entries = MEM_reallocN(wd->index.entries,
+                                     sizeof(*wd->index.entries) * wd->index.entries_len_alloc);
+  }
+
+  BlendFileIndexEntry *entry = &wd->index.entries[wd->index.entries_num++];
+  memset(entry, 0, sizeof(*entry));
+  return entry;
+}
+
+/**
+ * Add the ID about to be written at the current offset to the index.
+ */
+static void writedata_index_add(WriteData *wd, int filecode, const void *data)
+{
+  if (!BKE_idcode_is_valid(filecode)) {
+    /* #GLOB, #USER, link placeholders... etc. */
+    return;
+  }
+
+  BlendFileIndexEntry *entry = writedata_index_entry_new(wd);
+  entry->code = filecode;
+  entry->offset = wd->file_offset;
+  BLI_strncpy(entry->name, ((const ID *)data)->name, sizeof(entry->name));
+}
+
+/**
+ * The preview of the ID being written is stored at the current offset.
+ */
+static void writedata_index_add_preview(WriteData *wd)
+{
+  if (wd->index.use && wd->index.entries_num != 0) {
+    BlendFileIndexEntry *entry = &wd->index.entries[wd->index.entries_num - 1];
+    /* Keep the first one, the preview of embedded ID's (scene master collection)
+     * may be written afterwards. */
+    if (entry->preview_offset == 0) {
+      entry->preview_offset = wd->file_offset;
+    }
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Generic DNA File Writing
  * \{ */
@@ -525,6 +798,10 @@ static void writestruct_at_address_nr(
     return;
   }
 
+  if (UNLIKELY(wd->index.use) && (filecode != DATA)) {
+    writedata_index_add(wd, filecode, data);
+  }
+
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, data, bh.len);
 }
@@ -747,6 +1024,7 @@ static void write_previews(WriteData *wd, const PreviewImage *prv_orig)
       prv.h[1] = 0;
       prv.rect[1] = NULL;
     }
+    writedata_index_add_preview(wd);
     writestruct_at_address(wd, DATA, PreviewImage, 1, prv_orig, &prv);
     if (prv.rect[0]) {
       writedata(wd, DATA, prv.w[0] * prv.h[0] * sizeof(uint), prv.rect[0]);
@@ -3774,6 +4052,282 @@ static void write_thumb(WriteData *wd, const BlendThumbnail *thumb)
 /** \name File Writing (Private)
  * \{ */
 
+static void write_id(WriteData *wd, ID *id)
+{
+  switch ((ID_Type)GS(id->name)) {
+    case ID_WM:
+      write_windowmanager(wd, (wmWindowManager *)id);
+      break;
+    case ID_WS:
+      write_workspace(wd, (WorkSpace *)id);
+      break;
+    case ID_SCR:
+      write_screen(wd, (bScreen *)id);
+      break;
+    case ID_MC:
+      write_movieclip(wd, (MovieClip *)id);
+      break;
+    case ID_MSK:
+      write_mask(wd, (Mask *)id);
+      break;
+    case ID_SCE:
+      write_scene(wd, (Scene *)id);
+      break;
+    case ID_CU:
+      write_curve(wd, (Curve *)id);
+      break;
+    case ID_MB:
+      write_mball(wd, (MetaBall *)id);
+      break;
+    case ID_IM:
+      write_image(wd, (Image *)id);
+      break;
+    case ID_CA:
+      write_camera(wd, (Camera *)id);
+      break;
+    case ID_LA:
+      write_light(wd, (Light *)id);
+      break;
+    case ID_LT:
+      write_lattice(wd, (Lattice *)id);
+      break;
+    case ID_VF:
+      write_vfont(wd, (VFont *)id);
+      break;
+    case ID_KE:
+      write_key(wd, (Key *)id);
+      break;
+    case ID_WO:
+      write_world(wd, (World *)id);
+      break;
+    case ID_TXT:
+      write_text(wd, (Text *)id);
+      break;
+    case ID_SPK:
+      write_speaker(wd, (Speaker *)id);
+      break;
+    case ID_LP:
+      write_probe(wd, (LightProbe *)id);
+      break;
+    case ID_SO:
+      write_sound(wd, (bSound *)id);
+      break;
+    case ID_GR:
+      write_collection(wd, (Collection *)id);
+      break;
+    case ID_AR:
+      write_armature(wd, (bArmature *)id);
+      break;
+    case ID_AC:
+      write_action(wd, (bAction *)id);
+      break;
+    case ID_OB:
+      write_object(wd, (Object *)id);
+      break;
+    case ID_MA:
+      write_material(wd, (Material *)id);
+      break;
+    case ID_TE:
+      write_texture(wd, (Tex *)id);
+      break;
+    case ID_ME:
+      write_mesh(wd, (Mesh *)id);
+      break;
+    case ID_PA:
+      write_particlesettings(wd, (ParticleSettings *)id);
+      break;
+    case ID_NT:
+      write_nodetree(wd, (bNodeTree *)id);
+      break;
+    case ID_BR:
+      write_brush(wd, (Brush *)id);
+      break;
+    case ID_PAL:
+      write_palette(wd, (Palette *)id);
+      break;
+    case ID_PC:
+      write_paintcurve(wd, (PaintCurve *)id);
+      break;
+    case ID_GD:
+      write_gpencil(wd, (bGPdata *)id);
+      break;
+    case ID_LS:
+      write_linestyle(wd, (FreestyleLineStyle *)id);
+      break;
+    case ID_CF:
+      write_cachefile(wd, (CacheFile *)id);
+      break;
+    case ID_LI:
+      /* Do nothing, handled by #write_libraries - and should never be reached. */
+      BLI_assert(0);
+      break;
+    case ID_IP:
+      /* Do nothing, deprecated. */
+      break;
+    default:
+      /* Should never be reached. */
+      BLI_assert(0);
+      break;
+  }
+}
+
+#ifdef USE_WRITE_PARALLEL
+/**
+ * Window-manager & UI data-blocks are few and not self contained
+ * (windows reference screens and workspaces), keep writing them from a single thread.
+ */
+static bool write_id_type_use_parallel(const short idcode)
+{
+  return !ELEM(idcode, ID_WM, ID_WS, ID_SCR);
+}
+
+typedef struct WriteIDParallelData {
+  const WriteData *wd;
+  ID **ids;
+  /** Output of each ID, stored in a #MemFile. */
+  WriteData **wd_ids;
+} WriteIDParallelData;
+
+static void write_id_parallel_cb(void *__restrict userdata,
+                                 const int index,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  WriteIDParallelData *data = userdata;
+  WriteData *wd_id = writedata_new(NULL);
+
+  /* Offsets in the index are relative to the start of this ID, see #writedata_append. */
+  wd_id->index.use = data->wd->index.use;
+  BLO_memfile_write_init(&wd_id->mem, MEM_callocN(sizeof(MemFile), __func__), NULL);
+
+  write_id(wd_id, data->ids[index]);
+  mywrite_flush(wd_id);
+
+  data->wd_ids[index] = wd_id;
+}
+
+/**
+ * Write the output of \a wd_id (written by #write_id_parallel_cb) and free it.
+ */
+static void writedata_append(WriteData *wd, WriteData *wd_id)
+{
+  if (wd_id->error) {
+    wd->error = true;
+  }
+
+  for (uint i = 0; i < wd_id->index.entries_num; i++) {
+    BlendFileIndexEntry *entry = writedata_index_entry_new(wd);
+    *entry = wd_id->index.entries[i];
+    entry->offset += wd->file_offset;
+    if (entry->preview_offset != 0) {
+      entry->preview_offset += wd->file_offset;
+    }
+  }
+
+  MemFile *memfile = wd_id->mem.written_memfile;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    mywrite(wd, chunk->buf, (int)chunk->size);
+  }
+  BLO_memfile_free(memfile);
+  MEM_freeN(memfile);
+  writedata_free(wd_id);
+}
+
+static void write_ids_parallel(WriteData *wd, ID **ids, const int ids_len)
+{
+  WriteIDParallelData data = {
+      .wd = wd,
+      .ids = ids,
+      .wd_ids = MEM_mallocN(sizeof(*data.wd_ids) * (size_t)ids_len, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, ids_len, &data, write_id_parallel_cb, &settings);
+
+  /* Keep the file order. */
+  for (int i = 0; i < ids_len; i++) {
+    writedata_append(wd, data.wd_ids[i]);
+  }
+  MEM_freeN(data.wd_ids);
+}
+
+/**
+ * Write all ID's of a list starting at \a id,
+ * in batches (limiting memory used for the buffers) which are written in parallel.
+ */
+static void write_id_list_parallel(WriteData *wd,
+                                   ID *id,
+                                   Main *bmain,
+                                   OverrideLibraryStorage *override_storage)
+{
+  const int batch_len_max = MAX2(BLI_system_thread_count() * 4, 4);
+  ID **batch = MEM_mallocN(sizeof(*batch) * (size_t)batch_len_max, __func__);
+  int batch_len = 0;
+
+  for (; id; id = id->next) {
+    BLI_assert(
+        (id->tag & (LIB_TAG_NO_MAIN | LIB_TAG_NO_USER_REFCOUNT | LIB_TAG_NOT_ALLOCATED)) == 0);
+
+    const bool do_override = !ELEM(override_storage, NULL, bmain) && id->override_library;
+
+    if (do_override == false) {
+      batch[batch_len++] = id;
+      if (batch_len == batch_len_max) {
+        write_ids_parallel(wd, batch, batch_len);
+        batch_len = 0;
+      }
+      continue;
+    }
+
+    /* Storing override operations modifies the ID, write it on its own. */
+    if (batch_len != 0) {
+      write_ids_parallel(wd, batch, batch_len);
+      batch_len = 0;
+    }
+    BKE_override_library_operations_store_start(bmain, override_storage, id);
+    write_id(wd, id);
+    BKE_override_library_operations_store_end(override_storage, id);
+  }
+
+  if (batch_len != 0) {
+    write_ids_parallel(wd, batch, batch_len);
+  }
+  MEM_freeN(batch);
+}
+#endif /* USE_WRITE_PARALLEL */
+
+/* Write the data-block index (see #BlendFileIndexHeader). */
+static void writedata_index_write(WriteData *wd)
+{
+  const uint index_len = sizeof(BlendFileIndexHeader) +
+                         (sizeof(BlendFileIndexEntry) * wd->index.entries_num) +
+                         sizeof(BlendFileIndexFooter);
+  BlendFileIndexHeader *index = MEM_callocN(index_len, __func__);
+
+  memcpy(index->magic, BLEND_FILE_INDEX_MAGIC, sizeof(index->magic));
+  index->version = BLEND_FILE_INDEX_VERSION;
+  index->entries_num = wd->index.entries_num;
+  index->dna_offset = wd->index.dna_offset;
+  if (wd->index.entries_num != 0) {
+    memcpy(BLEND_FILE_INDEX_ENTRIES(index),
+           wd->index.entries,
+           sizeof(BlendFileIndexEntry) * wd->index.entries_num);
+  }
+
+  BlendFileIndexFooter *footer = (BlendFileIndexFooter *)POINTER_OFFSET(
+      index, index_len - sizeof(*footer));
+  footer->len = index_len;
+  memcpy(footer->magic, BLEND_FILE_INDEX_MAGIC, sizeof(footer->magic));
+
+  /* Not an ID (which older versions would attempt to read), #REND blocks are skipped. */
+  BLI_assert((index_len & 3) == 0);
+  writedata(wd, REND, index_len, index);
+
+  MEM_freeN(index);
+}
+
 /* if MemFile * there's filesave to memory */
 static bool write_file_handle(Main *mainvar,
                               WriteWrap *ww,
@@ -3790,6 +4344,7 @@ static bool write_file_handle(Main *mainvar,
   blo_split_main(&mainlist, mainvar);
 
   wd = mywrite_begin(ww, compare, current);
+  wd->index.use = !wd->use_memfile;
 
   sprintf(buf,
           "BLENDER%c%c%.3d",
@@ -3824,6 +4379,14 @@ static bool write_file_handle(Main *mainvar,
         continue; /* Libraries are handled separately below. */
       }
 
+#ifdef USE_WRITE_PARALLEL
+      if (id && id->next && !wd->use_memfile && write_id_type_use_parallel(GS(id->name))) {
+        write_id_list_parallel(wd, id, bmain, override_storage);
+        mywrite_flush(wd);
+        continue;
+      }
+#endif
+
       for (; id; id = id->next) {
         /* We should never attempt to write non-regular IDs
          * (i.e. all kind of temp/runtime ones). */
@@ -3836,125 +4399,17 @@ static bool write_file_handle(Main *mainvar,
           BKE_override_library_operations_store_start(bmain, override_storage, id);
         }
 
-        switch ((ID_Type)GS(id->name)) {
-          case ID_WM:
-            write_windowmanager(wd, (wmWindowManager *)id);
-            break;
-          case ID_WS:
-            write_workspace(wd, (WorkSpace *)id);
-            break;
-          case ID_SCR:
-            write_screen(wd, (bScreen *)id);
-            break;
-          case ID_MC:
-            write_movieclip(wd, (MovieClip *)id);
-            break;
-          case ID_MSK:
-            write_mask(wd, (Mask *)id);
-            break;
-          case ID_SCE:
-            write_scene(wd, (Scene *)id);
-            break;
-          case ID_CU:
-            write_curve(wd, (Curve *)id);
-            break;
-          case ID_MB:
-            write_mball(wd, (MetaBall *)id);
-            break;
-          case ID_IM:
-            write_image(wd, (Image *)id);
-            break;
-          case ID_CA:
-            write_camera(wd, (Camera *)id);
-            break;
-          case ID_LA:
-            write_light(wd, (Light *)id);
-            break;
-          case ID_LT:
-            write_lattice(wd, (Lattice *)id);
-            break;
-          case ID_VF:
-            write_vfont(wd, (VFont *)id);
-            break;
-          case ID_KE:
-            write_key(wd, (Key *)id);
-            break;
-          case ID_WO:
-            write_world(wd, (World *)id);
-            break;
-          case ID_TXT:
-            write_text(wd, (Text *)id);
-            break;
-          case ID_SPK:
-            write_speaker(wd, (Speaker *)id);
-            break;
-          case ID_LP:
-            write_probe(wd, (LightProbe *)id);
-            break;
-          case ID_SO:
-            write_sound(wd, (bSound *)id);
-            break;
-          case ID_GR:
-            write_collection(wd, (Collection *)id);
-            break;
-          case ID_AR:
-            write_armature(wd, (bArmature *)id);
-            break;
-          case ID_AC:
-            write_action(wd, (bAction *)id);
-            break;
-          case ID_OB:
-            write_object(wd, (Object *)id);
-            break;
-          case ID_MA:
-            write_material(wd, (Material *)id);
-            break;
-          case ID_TE:
-            write_texture(wd, (Tex *)id);
-            break;
-          case ID_ME:
-            write_mesh(wd, (Mesh *)id);
-            break;
-          case ID_PA:
-            write_particlesettings(wd, (ParticleSettings *)id);
-            break;
-          case ID_NT:
-            write_nodetree(wd, (bNodeTree *)id);
-            break;
-          case ID_BR:
-            write_brush(wd, (Brush *)id);
-            break;
-          case ID_PAL:
-            write_palette(wd, (Palette *)id);
-            break;
-          case ID_PC:
-            write_paintcurve(wd, (PaintCurve *)id);
-            break;
-          case ID_GD:
-            write_gpencil(wd, (bGPdata *)id);
-            break;
-          case ID_LS:
-            write_linestyle(wd, (FreestyleLineStyle *)id);
-            break;
-          case ID_CF:
-            write_cachefile(wd, (CacheFile *)id);
-            break;
-          case ID_LI:
-            /* Do nothing, handled below - and should never be reached. */
-            BLI_assert(0);
-            break;
-          case ID_IP:
-            /* Do nothing, deprecated. */
-            break;
-          default:
-            /* Should never be reached. */
-            BLI_assert(0);
-            break;
-        }
+        write_id(wd, id);
 
         if (do_override) {
           BKE_override_library_operations_store_end(override_storage, id);
         }
+
+        if (wd->use_memfile) {
+          /* Start a new chunk for each ID, so changes to one ID
+           * don't shift the chunks of the following ones (and they can still be shared). */
+          mywrite_flush(wd);
+        }
       }
 
       mywrite_flush(wd);
@@ -3980,8 +4435,14 @@ static bool write_file_handle(Main *mainvar,
    *
    * Note that we *borrow* the pointer to 'DNAstr',
    * so writing each time uses the same address and doesn't cause unnecessary undo overhead. */
+  wd->index.dna_offset = wd->file_offset;
   writedata(wd, DNA1, wd->sdna->data_len, wd->sdna->data);
 
+  /* Written last, so it can be found from the end of the file. */
+  if (wd->index.use) {
+    writedata_index_write(wd);
+  }
+
   /* end of file */
   memset(&bhead, 0, sizeof(BHead));
   bhead.code = ENDB;
@@ -4067,7 +4528,11 @@ bool BLO_write_file(Main *mainvar,
   BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
 
   if (write_flags & G_FILE_COMPRESS) {
+#ifdef WITH_LZO
+    ww_type = (write_flags & G_FILE_COMPRESS_FAST) ? WW_WRAP_LZO : WW_WRAP_ZLIB;
+#else
     ww_type = WW_WRAP_ZLIB;
+#endif
   }
   else {
     ww_type = WW_WRAP_NONE;
@@ -4117,7 +4582,9 @@ bool BLO_write_file(Main *mainvar,
   }
 
   /* actual file writing */
+  BLI_TRACE_ZONE_BEGIN(write);
   const bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, thumb);
+  BLI_TRACE_ZONE_END(write, "Write File");
 
   ww.close(&ww);
 
@@ -4163,7 +4630,9 @@ bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int w
 {
   write_flags &= ~G_FILE_USERPREFS;
 
+  BLI_TRACE_ZONE_BEGIN(write);
   const bool err = write_file_handle(mainvar, NULL, compare, current, write_flags, NULL);
+  BLI_TRACE_ZONE_END(write, "Write Undo");
 
   return (err == 0);
 }
@@ -567,6 +567,17 @@ void *BMO_slot_buffer_get_single(BMOpSlot *slot);
 
 /* counts number of elements inside a slot array. */
 int BMO_slot_buffer_count(BMOpSlot slot_args[BMO_OP_MAX_SLOTS], const char *slot_name);
+
+/* Called with each element of a slot buffer and its index in the buffer. */
+typedef void (*BMOSlotBufferParallelFunc)(void *__restrict userdata,
+                                          void *ele,
+                                          const int index);
+void BMO_slot_buffer_parallel(BMOpSlot slot_args[BMO_OP_MAX_SLOTS],
+                              const char *slot_name,
+                              const char restrict_flag,
+                              BMOSlotBufferParallelFunc func,
+                              void *userdata,
+                              const bool use_threading);
 int BMO_slot_map_count(BMOpSlot slot_args[BMO_OP_MAX_SLOTS], const char *slot_name);
 
 void BMO_slot_map_insert(BMOperator *op, BMOpSlot *slot, const void *element, const void *data);
@@ -28,6 +28,7 @@
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -704,6 +705,59 @@ int BMO_slot_buffer_count(BMOpSlot slot_args[BMO_OP_MAX_SLOTS], const char *slot
   return slot->len;
 }
 
+typedef struct BMOSlotBufferParallelData {
+  BMHeader **buf;
+  char restrict_flag;
+  BMOSlotBufferParallelFunc func;
+  void *userdata;
+} BMOSlotBufferParallelData;
+
+static void bmo_slot_buffer_parallel_cb(void *__restrict userdata,
+                                        const int index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMOSlotBufferParallelData *data = userdata;
+  BMHeader *ele = data->buf[index];
+
+  if (data->restrict_flag && !(ele->htype & data->restrict_flag)) {
+    return;
+  }
+  data->func(data->userdata, ele, index);
+}
+
+/**
+ * Run \a func for all elements of a slot buffer, possibly on multiple threads.
+ *
+ * Only meant for the parts of operators which read the mesh and write their results by buffer
+ * index, creating or removing elements is not thread safe.
+ */
+void BMO_slot_buffer_parallel(BMOpSlot slot_args[BMO_OP_MAX_SLOTS],
+                              const char *slot_name,
+                              const char restrict_flag,
+                              BMOSlotBufferParallelFunc func,
+                              void *userdata,
+                              const bool use_threading)
+{
+  BMOpSlot *slot = BMO_slot_get(slot_args, slot_name);
+  BLI_assert(slot->slot_type == BMO_OP_SLOT_ELEMENT_BUF);
+
+  if (slot->slot_type != BMO_OP_SLOT_ELEMENT_BUF || slot->len == 0) {
+    return;
+  }
+
+  BMOSlotBufferParallelData data = {
+      .buf = slot->data.buf,
+      .restrict_flag = restrict_flag,
+      .func = func,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = use_threading;
+  BLI_task_parallel_range(0, slot->len, &data, bmo_slot_buffer_parallel_cb, &settings);
+}
+
 int BMO_slot_map_count(BMOpSlot slot_args[BMO_OP_MAX_SLOTS], const char *slot_name)
 {
   BMOpSlot *slot = BMO_slot_get(slot_args, slot_name);
@@ -351,61 +351,75 @@ void bmo_region_extend_exec(BMesh *bm, BMOperator *op)
   BMO_slot_buffer_from_enabled_flag(bm, op, op->slots_out, "geom.out", BM_ALL_NOLOOP, SEL_FLAG);
 }
 
-void bmo_smooth_vert_exec(BMesh *UNUSED(bm), BMOperator *op)
+typedef struct SmoothVertData {
+  float (*cos)[3];
+  float clip_dist;
+  float fac;
+  bool clip[3];
+} SmoothVertData;
+
+static void bmo_smooth_vert_calc_co_cb(void *__restrict userdata, void *ele, const int index)
 {
-  BMOIter siter;
+  SmoothVertData *data = userdata;
+  BMVert *v = ele;
   BMIter iter;
-  BMVert *v;
   BMEdge *e;
-  float(*cos)[3] = MEM_mallocN(sizeof(*cos) * BMO_slot_buffer_count(op->slots_in, "verts"),
-                               __func__);
-  float *co, *co2, clip_dist = BMO_slot_float_get(op->slots_in, "clip_dist");
-  const float fac = BMO_slot_float_get(op->slots_in, "factor");
-  int i, j, clipx, clipy, clipz;
-  int xaxis, yaxis, zaxis;
-
-  clipx = BMO_slot_bool_get(op->slots_in, "mirror_clip_x");
-  clipy = BMO_slot_bool_get(op->slots_in, "mirror_clip_y");
-  clipz = BMO_slot_bool_get(op->slots_in, "mirror_clip_z");
+  float *co = data->cos[index];
+  int j = 0;
 
-  xaxis = BMO_slot_bool_get(op->slots_in, "use_axis_x");
-  yaxis = BMO_slot_bool_get(op->slots_in, "use_axis_y");
-  zaxis = BMO_slot_bool_get(op->slots_in, "use_axis_z");
+  zero_v3(co);
 
-  i = 0;
-  BMO_ITER (v, &siter, op->slots_in, "verts", BM_VERT) {
+  BM_ITER_ELEM (e, &iter, v, BM_EDGES_OF_VERT) {
+    add_v3_v3(co, BM_edge_other_vert(e, v)->co);
+    j += 1;
+  }
 
-    co = cos[i];
-    zero_v3(co);
+  if (!j) {
+    copy_v3_v3(co, v->co);
+    return;
+  }
 
-    j = 0;
-    BM_ITER_ELEM (e, &iter, v, BM_EDGES_OF_VERT) {
-      co2 = BM_edge_other_vert(e, v)->co;
-      add_v3_v3v3(co, co, co2);
-      j += 1;
-    }
+  mul_v3_fl(co, 1.0f / (float)j);
+  interp_v3_v3v3(co, v->co, co, data->fac);
 
-    if (!j) {
-      copy_v3_v3(co, v->co);
-      i++;
-      continue;
+  for (int axis = 0; axis < 3; axis++) {
+    if (data->clip[axis] && fabsf(v->co[axis]) <= data->clip_dist) {
+      co[axis] = 0.0f;
     }
+  }
+}
 
-    mul_v3_fl(co, 1.0f / (float)j);
-    interp_v3_v3v3(co, v->co, co, fac);
+void bmo_smooth_vert_exec(BMesh *UNUSED(bm), BMOperator *op)
+{
+  BMOIter siter;
+  BMVert *v;
+  const int verts_len = BMO_slot_buffer_count(op->slots_in, "verts");
+  float(*cos)[3] = MEM_mallocN(sizeof(*cos) * verts_len, __func__);
+  int i, xaxis, yaxis, zaxis;
+
+  SmoothVertData data = {
+      .cos = cos,
+      .clip_dist = BMO_slot_float_get(op->slots_in, "clip_dist"),
+      .fac = BMO_slot_float_get(op->slots_in, "factor"),
+      .clip =
+          {
+              BMO_slot_bool_get(op->slots_in, "mirror_clip_x"),
+              BMO_slot_bool_get(op->slots_in, "mirror_clip_y"),
+              BMO_slot_bool_get(op->slots_in, "mirror_clip_z"),
+          },
+  };
 
-    if (clipx && fabsf(v->co[0]) <= clip_dist) {
-      co[0] = 0.0f;
-    }
-    if (clipy && fabsf(v->co[1]) <= clip_dist) {
-      co[1] = 0.0f;
-    }
-    if (clipz && fabsf(v->co[2]) <= clip_dist) {
-      co[2] = 0.0f;
-    }
+  xaxis = BMO_slot_bool_get(op->slots_in, "use_axis_x");
+  yaxis = BMO_slot_bool_get(op->slots_in, "use_axis_y");
+  zaxis = BMO_slot_bool_get(op->slots_in, "use_axis_z");
 
-    i++;
-  }
+  /* All new coordinates are calculated from the old ones before applying them. */
+  BMO_slot_buffer_parallel(op->slots_in,
+                           "verts",
+                           BM_VERT,
+                           bmo_smooth_vert_calc_co_cb,
+                           &data,
+                           verts_len >= BM_OMP_LIMIT);
 
   i = 0;
   BMO_ITER (v, &siter, op->slots_in, "verts", BM_VERT) {
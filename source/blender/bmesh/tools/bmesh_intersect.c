@@ -950,6 +950,64 @@ static int isect_bvhtree_point_v3(BVHTree *tree, const float **looptris, const f
  * \param boolean_mode: -1: no-boolean, 0: intersection... see #BMESH_ISECT_BOOLEAN_ISECT.
  * \return true if the mesh is changed (intersections cut or faces removed from boolean).
  */
+#ifdef USE_BVH
+
+struct ISectOverlapData {
+  BMLoop *(*looptris)[3];
+  /* Larger than any distance at which #bm_isect_tri_tri still finds an intersection. */
+  float dist_margin;
+};
+
+/**
+ * True when all vertices of \a tri_cos are further than \a dist_margin away from the plane of
+ * \a plane_cos, on the same side.
+ */
+static bool bm_isect_tri_plane_separated(const float *plane_cos[3],
+                                         const float *tri_cos[3],
+                                         const float dist_margin)
+{
+  float plane[4];
+  float no[3];
+
+  if (normal_tri_v3(no, UNPACK3(plane_cos)) == 0.0f) {
+    return false;
+  }
+  plane_from_point_normal_v3(plane, plane_cos[0], no);
+
+  const float side[3] = {
+      plane_point_side_v3(plane, tri_cos[0]),
+      plane_point_side_v3(plane, tri_cos[1]),
+      plane_point_side_v3(plane, tri_cos[2]),
+  };
+  return (min_fff(UNPACK3(side)) > dist_margin) || (max_fff(UNPACK3(side)) < -dist_margin);
+}
+
+/**
+ * Skip the pairs found by the BVH overlap which can't intersect. This runs on multiple threads
+ * while finding the overlaps, leaving less work for the serial #bm_isect_tri_tri.
+ */
+static bool bm_isect_overlap_cb(void *userdata, int index_a, int index_b, int UNUSED(thread))
+{
+  struct ISectOverlapData *data = userdata;
+  BMLoop **a = data->looptris[index_a];
+  BMLoop **b = data->looptris[index_b];
+  BMVert *fv_a[3] = {UNPACK3_EX(, a, ->v)};
+  BMVert *fv_b[3] = {UNPACK3_EX(, b, ->v)};
+  const float *f_a_cos[3] = {UNPACK3_EX(, fv_a, ->co)};
+  const float *f_b_cos[3] = {UNPACK3_EX(, fv_b, ->co)};
+
+  /* Connected triangles are skipped by #bm_isect_tri_tri too. */
+  if (UNLIKELY(ELEM(fv_a[0], UNPACK3(fv_b)) || ELEM(fv_a[1], UNPACK3(fv_b)) ||
+               ELEM(fv_a[2], UNPACK3(fv_b)))) {
+    return false;
+  }
+
+  return !(bm_isect_tri_plane_separated(f_a_cos, f_b_cos, data->dist_margin) ||
+           bm_isect_tri_plane_separated(f_b_cos, f_a_cos, data->dist_margin));
+}
+
+#endif /* USE_BVH */
+
 bool BM_mesh_intersect(BMesh *bm,
                        struct BMLoop *(*looptris)[3],
                        const int looptris_tot,
@@ -1082,7 +1140,14 @@ bool BM_mesh_intersect(BMesh *bm,
     tree_b = tree_a;
   }
 
-  overlap = BLI_bvhtree_overlap(tree_b, tree_a, &tree_overlap_tot, NULL, NULL);
+  {
+    struct ISectOverlapData overlap_data = {
+        .looptris = looptris,
+        .dist_margin = s.epsilon.eps_margin * 2.0f,
+    };
+    overlap = BLI_bvhtree_overlap(
+        tree_b, tree_a, &tree_overlap_tot, bm_isect_overlap_cb, &overlap_data);
+  }
 
   if (overlap) {
     uint i;
@@ -107,6 +107,29 @@ typedef enum OrderOfChunks {
 #define COM_NUM_CHANNELS_VECTOR 3
 #define COM_NUM_CHANNELS_COLOR 4
 
+/**
+ * \brief number of channels stored for each pixel of a data type
+ * \ingroup Model
+ */
+inline unsigned int COM_num_channels_for_datatype(DataType datatype)
+{
+  switch (datatype) {
+    case COM_DT_VALUE:
+      return COM_NUM_CHANNELS_VALUE;
+    case COM_DT_VECTOR:
+      return COM_NUM_CHANNELS_VECTOR;
+    case COM_DT_COLOR:
+    default:
+      return COM_NUM_CHANNELS_COLOR;
+  }
+}
+
+/**
+ * \brief number of pixels operations process at once when executing a row.
+ * Inputs are read into buffers on the stack of this size, see SocketReader.executeRowSampled
+ */
+#define COM_ROW_SPAN_PIXELS 32
+
 #define COM_BLUR_BOKEH_PIXELS 512
 
 #endif /* __COM_DEFINES_H__ */
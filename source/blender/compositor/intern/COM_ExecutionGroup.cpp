@@ -53,6 +53,9 @@ ExecutionGroup::ExecutionGroup()
   this->m_numberOfXChunks = 0;
   this->m_numberOfYChunks = 0;
   this->m_numberOfChunks = 0;
+  this->m_chunkSize = 0;
+  this->m_chunkWidth = 0;
+  this->m_chunkHeight = 0;
   this->m_initialized = false;
   this->m_openCL = false;
   this->m_singleThreaded = false;
@@ -179,11 +182,24 @@ void ExecutionGroup::determineNumberOfChunks()
     this->m_numberOfChunks = 1;
   }
   else {
-    const float chunkSizef = this->m_chunkSize;
     const int border_width = BLI_rcti_size_x(&this->m_viewerBorder);
     const int border_height = BLI_rcti_size_y(&this->m_viewerBorder);
-    this->m_numberOfXChunks = ceil(border_width / chunkSizef);
-    this->m_numberOfYChunks = ceil(border_height / chunkSizef);
+    const NodeOperation *operation = this->getOutputOperation();
+
+    this->m_chunkWidth = this->m_chunkSize;
+    this->m_chunkHeight = this->m_chunkSize;
+    if (!operation->isViewerOperation() && !operation->isPreviewOperation() &&
+        border_width > 0) {
+      /* Only viewers draw chunks as they finish, everything else is evaluated for the whole
+       * frame in blocks of full rows. These contain as many pixels as a square chunk, but have
+       * no vertical seams: operations read their inputs row by row and the areas of interest
+       * of neighboring chunks overlap much less. */
+      this->m_chunkWidth = border_width;
+      this->m_chunkHeight = max(this->m_chunkSize * this->m_chunkSize / border_width, 1u);
+    }
+
+    this->m_numberOfXChunks = ceil(border_width / (float)this->m_chunkWidth);
+    this->m_numberOfYChunks = ceil(border_height / (float)this->m_chunkHeight);
     this->m_numberOfChunks = this->m_numberOfXChunks * this->m_numberOfYChunks;
   }
 }
@@ -450,15 +466,15 @@ inline void ExecutionGroup::determineChunkRect(rcti *rect,
         rect, this->m_viewerBorder.xmin, border_width, this->m_viewerBorder.ymin, border_height);
   }
   else {
-    const unsigned int minx = xChunk * this->m_chunkSize + this->m_viewerBorder.xmin;
-    const unsigned int miny = yChunk * this->m_chunkSize + this->m_viewerBorder.ymin;
+    const unsigned int minx = xChunk * this->m_chunkWidth + this->m_viewerBorder.xmin;
+    const unsigned int miny = yChunk * this->m_chunkHeight + this->m_viewerBorder.ymin;
     const unsigned int width = min((unsigned int)this->m_viewerBorder.xmax, this->m_width);
     const unsigned int height = min((unsigned int)this->m_viewerBorder.ymax, this->m_height);
     BLI_rcti_init(rect,
                   min(minx, this->m_width),
-                  min(minx + this->m_chunkSize, width),
+                  min(minx + this->m_chunkWidth, width),
                   min(miny, this->m_height),
-                  min(miny + this->m_chunkSize, height));
+                  min(miny + this->m_chunkHeight, height));
   }
 }
 
@@ -494,10 +510,10 @@ bool ExecutionGroup::scheduleAreaWhenPossible(ExecutionSystem *graph, rcti *area
   int maxx = min_ii(area->xmax - m_viewerBorder.xmin, m_viewerBorder.xmax - m_viewerBorder.xmin);
   int miny = max_ii(area->ymin - m_viewerBorder.ymin, 0);
   int maxy = min_ii(area->ymax - m_viewerBorder.ymin, m_viewerBorder.ymax - m_viewerBorder.ymin);
-  int minxchunk = minx / (int)m_chunkSize;
-  int maxxchunk = (maxx + (int)m_chunkSize - 1) / (int)m_chunkSize;
-  int minychunk = miny / (int)m_chunkSize;
-  int maxychunk = (maxy + (int)m_chunkSize - 1) / (int)m_chunkSize;
+  int minxchunk = minx / (int)m_chunkWidth;
+  int maxxchunk = (maxx + (int)m_chunkWidth - 1) / (int)m_chunkWidth;
+  int minychunk = miny / (int)m_chunkHeight;
+  int maxychunk = (maxy + (int)m_chunkHeight - 1) / (int)m_chunkHeight;
   minxchunk = max_ii(minxchunk, 0);
   minychunk = max_ii(minychunk, 0);
   maxxchunk = min_ii(maxxchunk, (int)m_numberOfXChunks);
@@ -515,6 +531,23 @@ bool ExecutionGroup::scheduleAreaWhenPossible(ExecutionSystem *graph, rcti *area
   return result;
 }
 
+bool ExecutionGroup::isExecuted() const
+{
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ExecutionGroup::setExecuted()
+{
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+  }
+}
+
 bool ExecutionGroup::scheduleChunk(unsigned int chunkNumber)
 {
   if (this->m_chunkExecutionStates[chunkNumber] == COM_ES_NOT_SCHEDULED) {
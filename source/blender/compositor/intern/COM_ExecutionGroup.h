@@ -94,6 +94,14 @@ class ExecutionGroup {
    */
   unsigned int m_chunkSize;
 
+  /**
+   * \brief width and height of the chunks this group is actually split into.
+   * Groups that don't show progressive feedback are split into blocks of full rows instead of
+   * square tiles, see determineNumberOfChunks().
+   */
+  unsigned int m_chunkWidth;
+  unsigned int m_chunkHeight;
+
   /**
    * \brief number of chunks in the x-axis
    */
@@ -203,6 +211,7 @@ class ExecutionGroup {
   /**
    * \brief determine the number of chunks, based on the chunkSize, width and height.
    * \note The result are stored in the fields numberOfChunks, numberOfXChunks, numberOfYChunks
+   * \note also determines chunkWidth and chunkHeight.
    */
   void determineNumberOfChunks();
 
@@ -323,6 +332,16 @@ class ExecutionGroup {
     return m_complex;
   }
 
+  /**
+   * \brief have all chunks of this ExecutionGroup been executed
+   */
+  bool isExecuted() const;
+
+  /**
+   * \brief mark all chunks as executed, used when the result was restored from the ResultCache
+   */
+  void setExecuted();
+
   /**
    * \brief get the output operation of this ExecutionGroup
    * \return NodeOperation *output operation
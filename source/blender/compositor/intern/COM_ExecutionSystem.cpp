@@ -18,6 +18,9 @@
 
 #include "COM_ExecutionSystem.h"
 
+#include <map>
+#include <typeinfo>
+
 #include "PIL_time.h"
 #include "BLI_utildefines.h"
 extern "C" {
@@ -32,6 +35,8 @@ extern "C" {
 #include "COM_ExecutionGroup.h"
 #include "COM_WorkScheduler.h"
 #include "COM_ReadBufferOperation.h"
+#include "COM_ResultCache.h"
+#include "COM_WriteBufferOperation.h"
 #include "COM_Debug.h"
 
 #ifdef WITH_CXX_GUARDEDALLOC
@@ -178,6 +183,8 @@ void ExecutionSystem::execute()
     executionGroup->initExecution();
   }
 
+  restoreCachedResults();
+
   WorkScheduler::start(this->m_context);
 
   executeGroups(COM_PRIORITY_HIGH);
@@ -189,6 +196,8 @@ void ExecutionSystem::execute()
   WorkScheduler::finish();
   WorkScheduler::stop();
 
+  storeCachedResults();
+
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -200,6 +209,123 @@ void ExecutionSystem::execute()
   }
 }
 
+typedef std::map<NodeOperation *, uint64_t> ResultKeys;
+
+/* Key of the result of an operation, combining its own hash with those of its inputs.
+ * Returns 0 when the result depends on anything that is not hashed. */
+static uint64_t determine_result_key(const ResultHash &context_hash,
+                                     NodeOperation *operation,
+                                     ResultKeys &keys)
+{
+  ResultKeys::const_iterator found = keys.find(operation);
+  if (found != keys.end()) {
+    return found->second;
+  }
+
+  uint64_t key = 0;
+  if (operation->isReadBufferOperation()) {
+    MemoryProxy *memoryProxy = ((ReadBufferOperation *)operation)->getMemoryProxy();
+    key = determine_result_key(context_hash, memoryProxy->getWriteBufferOperation(), keys);
+  }
+  else {
+    ResultHash hash = context_hash;
+    hash.addString(typeid(*operation).name());
+    hash.addInt(operation->getWidth());
+    hash.addInt(operation->getHeight());
+
+    bool cacheable = operation->determineResultHash(hash);
+    for (unsigned int i = 0; cacheable && i < operation->getNumberOfInputSockets(); i++) {
+      NodeOperationInput *input = operation->getInputSocket(i);
+      if (input->isConnected()) {
+        const uint64_t input_key = determine_result_key(
+            context_hash, &input->getLink()->getOperation(), keys);
+        hash.addKey(input_key);
+        cacheable = (input_key != 0);
+      }
+      else {
+        hash.addInt(-1);
+      }
+    }
+
+    if (cacheable) {
+      /* Zero is reserved for results that are not cached. */
+      key = hash.getKey();
+      if (key == 0) {
+        key = 1;
+      }
+    }
+  }
+
+  keys[operation] = key;
+  return key;
+}
+
+void ExecutionSystem::restoreCachedResults()
+{
+  this->m_resultKeys.assign(this->m_groups.size(), 0);
+
+  if (!ResultCache::isEnabled()) {
+    /* Free results cached before the limit was set to zero. */
+    ResultCache::trim();
+    return;
+  }
+
+  /* Everything operations can read from the context. */
+  const RenderData *rd = this->m_context.getRenderData();
+  const char *viewName = this->m_context.getViewName();
+  ResultHash context_hash;
+  context_hash.addInt(this->m_context.getQuality());
+  context_hash.addInt(this->m_context.isRendering());
+  context_hash.addInt(this->m_context.getHasActiveOpenCLDevices());
+  context_hash.addString(viewName ? viewName : "");
+  context_hash.addInt(rd->cfra);
+  context_hash.addInt(rd->size);
+  context_hash.addInt(rd->xsch);
+  context_hash.addInt(rd->ysch);
+  context_hash.addInt(rd->scemode);
+
+  ResultKeys keys;
+  for (unsigned int index = 0; index < this->m_groups.size(); index++) {
+    ExecutionGroup *group = this->m_groups[index];
+    NodeOperation *operation = group->getOutputOperation();
+    if (!operation->isWriteBufferOperation()) {
+      continue;
+    }
+
+    const uint64_t key = determine_result_key(context_hash, operation, keys);
+    if (key == 0) {
+      continue;
+    }
+
+    MemoryProxy *memoryProxy = ((WriteBufferOperation *)operation)->getMemoryProxy();
+    if (ResultCache::restore(key, memoryProxy->getBuffer())) {
+      group->setExecuted();
+    }
+    else {
+      this->m_resultKeys[index] = key;
+    }
+  }
+}
+
+void ExecutionSystem::storeCachedResults()
+{
+  const bNodeTree *editingtree = this->m_context.getbNodeTree();
+  if (editingtree->test_break(editingtree->tbh)) {
+    /* Buffers might only be partially written. */
+    return;
+  }
+
+  for (unsigned int index = 0; index < this->m_resultKeys.size(); index++) {
+    ExecutionGroup *group = this->m_groups[index];
+    if (this->m_resultKeys[index] == 0 || !group->isExecuted()) {
+      continue;
+    }
+
+    WriteBufferOperation *operation = (WriteBufferOperation *)group->getOutputOperation();
+    ResultCache::store(this->m_resultKeys[index], operation->getMemoryProxy()->releaseBuffer());
+  }
+}
+
 void ExecutionSystem::executeGroups(CompositorPriority priority)
 {
   unsigned int index;
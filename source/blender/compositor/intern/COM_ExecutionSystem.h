@@ -134,6 +134,11 @@ class ExecutionSystem {
    */
   Groups m_groups;
 
+  /**
+   * \brief ResultCache keys of the groups to store after execution, 0 when not stored
+   */
+  vector<uint64_t> m_resultKeys;
+
  private:  // methods
   /**
    * find all execution group with output nodes
@@ -189,6 +194,17 @@ class ExecutionSystem {
  private:
   void executeGroups(CompositorPriority priority);
 
+  /**
+   * \brief restore write buffers of which a result with the same hash is cached
+   * \see ResultCache
+   */
+  void restoreCachedResults();
+
+  /**
+   * \brief hand the fully executed write buffers over to the ResultCache
+   */
+  void storeCachedResults();
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
 
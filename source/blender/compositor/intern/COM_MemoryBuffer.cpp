@@ -23,19 +23,6 @@
 using std::max;
 using std::min;
 
-static unsigned int determine_num_channels(DataType datatype)
-{
-  switch (datatype) {
-    case COM_DT_VALUE:
-      return COM_NUM_CHANNELS_VALUE;
-    case COM_DT_VECTOR:
-      return COM_NUM_CHANNELS_VECTOR;
-    case COM_DT_COLOR:
-    default:
-      return COM_NUM_CHANNELS_COLOR;
-  }
-}
-
 unsigned int MemoryBuffer::determineBufferSize()
 {
   return getWidth() * getHeight();
@@ -57,7 +44,7 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, unsigned int chunkNumber, r
   this->m_height = BLI_rcti_size_y(&this->m_rect);
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = chunkNumber;
-  this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
+  this->m_num_channels = COM_num_channels_for_datatype(memoryProxy->getDataType());
   this->m_buffer = (float *)MEM_mallocN_aligned(
       sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
   this->m_state = COM_MB_ALLOCATED;
@@ -71,7 +58,7 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, rcti *rect)
   this->m_height = BLI_rcti_size_y(&this->m_rect);
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = -1;
-  this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
+  this->m_num_channels = COM_num_channels_for_datatype(memoryProxy->getDataType());
   this->m_buffer = (float *)MEM_mallocN_aligned(
       sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
   this->m_state = COM_MB_TEMPORARILY;
@@ -85,7 +72,7 @@ MemoryBuffer::MemoryBuffer(DataType dataType, rcti *rect)
   this->m_height = this->m_rect.ymax - this->m_rect.ymin;
   this->m_memoryProxy = NULL;
   this->m_chunkNumber = -1;
-  this->m_num_channels = determine_num_channels(dataType);
+  this->m_num_channels = COM_num_channels_for_datatype(dataType);
   this->m_buffer = (float *)MEM_mallocN_aligned(
       sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
   this->m_state = COM_MB_TEMPORARILY;
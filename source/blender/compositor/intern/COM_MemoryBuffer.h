@@ -253,6 +253,29 @@ class MemoryBuffer {
     }
   }
 
+  /**
+   * \brief read length pixels starting at x, y. pixels outside the rect are zero
+   */
+  inline void readRow(float *result, int x, int y, int length)
+  {
+    const int num_channels = this->m_num_channels;
+    const int xmin = max_ii(x, m_rect.xmin);
+    const int xmax = min_ii(x + length, m_rect.xmax);
+    if (y < m_rect.ymin || y >= m_rect.ymax || xmin >= xmax) {
+      memset(result, 0, sizeof(float) * length * num_channels);
+      return;
+    }
+
+    const int offset = (this->m_width * (y - m_rect.ymin) + (xmin - m_rect.xmin)) * num_channels;
+    memset(result, 0, sizeof(float) * (xmin - x) * num_channels);
+    memcpy(&result[(xmin - x) * num_channels],
+           &this->m_buffer[offset],
+           sizeof(float) * (xmax - xmin) * num_channels);
+    memset(&result[(xmax - x) * num_channels],
+           0,
+           sizeof(float) * (x + length - xmax) * num_channels);
+  }
+
   inline void readNoCheck(float *result,
                           int x,
                           int y,
@@ -119,6 +119,16 @@ class MemoryProxy {
     return this->m_buffer;
   }
 
+  /**
+   * \brief hand the allocated memory over to the caller, which becomes responsible for freeing it
+   */
+  MemoryBuffer *releaseBuffer()
+  {
+    MemoryBuffer *buffer = this->m_buffer;
+    this->m_buffer = NULL;
+    return buffer;
+  }
+
   inline DataType getDataType()
   {
     return this->m_datatype;
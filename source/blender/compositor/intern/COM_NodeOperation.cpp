@@ -37,6 +37,8 @@ NodeOperation::NodeOperation()
   this->m_isResolutionSet = false;
   this->m_openCL = false;
   this->m_btree = NULL;
+  this->m_nodeSettingsKey = 0;
+  this->m_nodeSettingsCacheable = true;
 }
 
 NodeOperation::~NodeOperation()
@@ -194,6 +196,12 @@ bool NodeOperation::determineDependingAreaOfInterest(rcti *input,
   }
 }
 
+bool NodeOperation::determineResultHash(ResultHash &hash)
+{
+  hash.addKey(this->m_nodeSettingsKey);
+  return this->m_nodeSettingsCacheable;
+}
+
 /*****************
  **** OpInput ****
  *****************/
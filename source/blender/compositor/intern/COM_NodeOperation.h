@@ -32,6 +32,7 @@ extern "C" {
 #include "COM_Node.h"
 #include "COM_MemoryBuffer.h"
 #include "COM_MemoryProxy.h"
+#include "COM_ResultCache.h"
 #include "COM_SocketReader.h"
 
 #include "clew.h"
@@ -126,6 +127,17 @@ class NodeOperation : public SocketReader {
    */
   bool m_isResolutionSet;
 
+  /**
+   * \brief hash of the settings of the node this operation was converted from
+   * \see determineResultHash
+   */
+  uint64_t m_nodeSettingsKey;
+
+  /**
+   * \brief does the node this operation was converted from only depend on its settings
+   */
+  bool m_nodeSettingsCacheable;
+
  public:
   virtual ~NodeOperation();
 
@@ -368,6 +380,20 @@ class NodeOperation : public SocketReader {
     return true;
   }
 
+  void setNodeSettingsKey(uint64_t key, bool cacheable)
+  {
+    this->m_nodeSettingsKey = key;
+    this->m_nodeSettingsCacheable = cacheable;
+  }
+
+  /**
+   * \brief add everything the output of this operation depends on, except for its inputs.
+   * \note called after initExecution.
+   * \return false when the output depends on data that is not hashed, it is not cached then.
+   * \see ResultCache
+   */
+  virtual bool determineResultHash(ResultHash &hash);
+
   inline bool isBraked() const
   {
     return this->m_btree->test_break(this->m_btree->tbh);
@@ -17,9 +17,17 @@
  */
 
 extern "C" {
+#include "BLI_listbase.h"
 #include "BLI_utildefines.h"
+
+#include "DNA_color_types.h"
+#include "DNA_node_types.h"
+
+#include "BKE_node.h"
 }
 
+#include "MEM_guardedalloc.h"
+
 #include "COM_NodeConverter.h"
 #include "COM_Converter.h"
 #include "COM_Debug.h"
@@ -40,7 +48,11 @@ extern "C" {
 #include "COM_NodeOperationBuilder.h" /* own include */
 
 NodeOperationBuilder::NodeOperationBuilder(const CompositorContext *context, bNodeTree *b_nodetree)
-    : m_context(context), m_current_node(NULL), m_active_viewer(NULL)
+    : m_context(context),
+      m_current_node(NULL),
+      m_current_node_cacheable(false),
+      m_current_node_operations(0),
+      m_active_viewer(NULL)
 {
   m_graph.from_bNodeTree(*context, b_nodetree);
 }
@@ -49,6 +61,71 @@ NodeOperationBuilder::~NodeOperationBuilder()
 {
 }
 
+/**
+ * Hash everything the operations converted from the node depend on, apart from their inputs.
+ * UI flags are left out, so selecting nodes does not invalidate cached results.
+ * \return false when the node depends on other data-blocks, its results are not cached then.
+ */
+static bool node_settings_hash(const bNode *b_node, ResultHash &hash)
+{
+  switch (b_node->type) {
+    case NODE_GROUP:
+      /* Converted to proxies of the nodes inside of the group. */
+    case CMP_NODE_R_LAYERS:
+    case CMP_NODE_IMAGE:
+    case CMP_NODE_DEFOCUS:
+      /* Their operations hash the render result, image or camera data they read. */
+      break;
+    default:
+      if (b_node->id) {
+        return false;
+      }
+      break;
+  }
+
+  hash.addInt(b_node->type);
+  hash.addInt(b_node->flag & NODE_MUTED);
+  hash.addInt(b_node->custom1);
+  hash.addInt(b_node->custom2);
+  hash.addFloat(b_node->custom3);
+  hash.addFloat(b_node->custom4);
+
+  if (b_node->storage) {
+    hash.add(b_node->storage, MEM_allocN_len(b_node->storage));
+
+    /* Storage pointing to more data, which can be edited in place. */
+    switch (b_node->type) {
+      case CMP_NODE_TIME:
+      case CMP_NODE_CURVE_VEC:
+      case CMP_NODE_CURVE_RGB:
+      case CMP_NODE_HUECORRECT: {
+        const CurveMapping *cumap = (const CurveMapping *)b_node->storage;
+        for (int i = 0; i < CM_TOT; i++) {
+          if (cumap->cm[i].curve) {
+            hash.add(cumap->cm[i].curve, sizeof(CurveMapPoint) * cumap->cm[i].totpoint);
+          }
+        }
+        break;
+      }
+      case CMP_NODE_CRYPTOMATTE: {
+        const NodeCryptomatte *crypto = (const NodeCryptomatte *)b_node->storage;
+        if (crypto->matte_id) {
+          hash.addString(crypto->matte_id);
+        }
+        break;
+      }
+    }
+  }
+
+  LISTBASE_FOREACH (const bNodeSocket *, sock, &b_node->inputs) {
+    if (sock->default_value) {
+      hash.add(sock->default_value, MEM_allocN_len(sock->default_value));
+    }
+  }
+
+  return true;
+}
+
 void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 {
   /* interface handle for nodes */
@@ -58,6 +135,9 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
     Node *node = (Node *)m_graph.nodes()[index];
 
     m_current_node = node;
+    m_current_node_hash = ResultHash();
+    m_current_node_cacheable = node_settings_hash(node->getbNode(), m_current_node_hash);
+    m_current_node_operations = 0;
 
     DebugInfo::node_to_operations(node);
     node->convertToOperations(converter, *m_context);
@@ -127,6 +207,11 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 
 void NodeOperationBuilder::addOperation(NodeOperation *operation)
 {
+  if (m_current_node) {
+    ResultHash hash = m_current_node_hash;
+    hash.addInt(m_current_node_operations++);
+    operation->setNodeSettingsKey(hash.getKey(), m_current_node_cacheable);
+  }
   m_operations.push_back(operation);
 }
 
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "COM_NodeGraph.h"
+#include "COM_ResultCache.h"
 
 using std::vector;
 
@@ -90,6 +91,11 @@ class NodeOperationBuilder {
 
   Node *m_current_node;
 
+  /** Settings hash of the current node, identifies its operations in the ResultCache */
+  ResultHash m_current_node_hash;
+  bool m_current_node_cacheable;
+  int m_current_node_operations;
+
   /** Operation that will be writing to the viewer image
    *  Only one operation can occupy this place at a time,
    *  to avoid race conditions
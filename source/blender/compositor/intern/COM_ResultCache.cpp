@@ -0,0 +1,157 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include <list>
+#include <map>
+#include <string.h>
+
+#include "COM_MemoryBuffer.h"
+#include "COM_ResultCache.h"
+
+#include "BLI_math_base.h"
+
+#include "DNA_userdef_types.h"
+
+ResultHash::ResultHash()
+{
+  BLI_hash_mm2a_init(&this->m_mm2[0], 0);
+  BLI_hash_mm2a_init(&this->m_mm2[1], 0x9e3779b9);
+}
+
+void ResultHash::add(const void *data, size_t len)
+{
+  BLI_hash_mm2a_add(&this->m_mm2[0], (const unsigned char *)data, len);
+  BLI_hash_mm2a_add(&this->m_mm2[1], (const unsigned char *)data, len);
+}
+
+void ResultHash::addInt(int data)
+{
+  BLI_hash_mm2a_add_int(&this->m_mm2[0], data);
+  BLI_hash_mm2a_add_int(&this->m_mm2[1], data);
+}
+
+void ResultHash::addFloat(float data)
+{
+  add(&data, sizeof(data));
+}
+
+void ResultHash::addString(const char *str)
+{
+  add(str, strlen(str) + 1);
+}
+
+void ResultHash::addKey(uint64_t key)
+{
+  add(&key, sizeof(key));
+}
+
+uint64_t ResultHash::getKey() const
+{
+  /* Finalizing modifies the state, work on a copy so hashing can continue. */
+  BLI_HashMurmur2A mm2[2] = {this->m_mm2[0], this->m_mm2[1]};
+  return ((uint64_t)BLI_hash_mm2a_end(&mm2[0]) << 32) | BLI_hash_mm2a_end(&mm2[1]);
+}
+
+typedef struct ResultCacheEntry {
+  uint64_t key;
+  MemoryBuffer *buffer;
+  size_t memory_size;
+} ResultCacheEntry;
+
+/* Entries ordered from the most to the least recently used. */
+typedef std::list<ResultCacheEntry> ResultCacheEntries;
+
+static ResultCacheEntries g_entries;
+static std::map<uint64_t, ResultCacheEntries::iterator> g_entry_map;
+static size_t g_memory_size = 0;
+
+static size_t result_buffer_memory_size(MemoryBuffer *buffer)
+{
+  return sizeof(float) * buffer->getWidth() * buffer->getHeight() * buffer->get_num_channels();
+}
+
+static size_t result_cache_limit()
+{
+  return (size_t)max_ii(U.compositor_cache_limit, 0) * 1024 * 1024;
+}
+
+static void result_cache_remove(ResultCacheEntries::iterator it)
+{
+  g_memory_size -= it->memory_size;
+  g_entry_map.erase(it->key);
+  delete it->buffer;
+  g_entries.erase(it);
+}
+
+bool ResultCache::isEnabled()
+{
+  return U.compositor_cache_limit > 0;
+}
+
+bool ResultCache::restore(uint64_t key, MemoryBuffer *buffer)
+{
+  std::map<uint64_t, ResultCacheEntries::iterator>::iterator found = g_entry_map.find(key);
+  if (found == g_entry_map.end()) {
+    return false;
+  }
+
+  ResultCacheEntries::iterator it = found->second;
+  MemoryBuffer *cached = it->buffer;
+  if (cached->getWidth() != buffer->getWidth() || cached->getHeight() != buffer->getHeight() ||
+      cached->get_num_channels() != buffer->get_num_channels()) {
+    return false;
+  }
+
+  memcpy(buffer->getBuffer(), cached->getBuffer(), it->memory_size);
+  g_entries.splice(g_entries.begin(), g_entries, it);
+  return true;
+}
+
+void ResultCache::store(uint64_t key, MemoryBuffer *buffer)
+{
+  const size_t memory_size = result_buffer_memory_size(buffer);
+  std::map<uint64_t, ResultCacheEntries::iterator>::iterator found = g_entry_map.find(key);
+  if (found != g_entry_map.end()) {
+    result_cache_remove(found->second);
+  }
+  if (memory_size > result_cache_limit()) {
+    delete buffer;
+    return;
+  }
+
+  ResultCacheEntry entry = {key, buffer, memory_size};
+  g_entries.push_front(entry);
+  g_entry_map[key] = g_entries.begin();
+  g_memory_size += memory_size;
+  trim();
+}
+
+void ResultCache::trim()
+{
+  const size_t limit = result_cache_limit();
+  while (g_memory_size > limit && !g_entries.empty()) {
+    result_cache_remove(--g_entries.end());
+  }
+}
+
+void ResultCache::clear()
+{
+  while (!g_entries.empty()) {
+    result_cache_remove(g_entries.begin());
+  }
+}
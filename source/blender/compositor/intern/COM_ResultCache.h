@@ -0,0 +1,95 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#ifndef __COM_RESULTCACHE_H__
+#define __COM_RESULTCACHE_H__
+
+#include <stddef.h>
+
+extern "C" {
+#include "BLI_hash_mm2a.h"
+}
+
+class MemoryBuffer;
+
+/**
+ * \brief 64 bit hash of everything the result of an operation depends on.
+ * \see ResultCache
+ * \ingroup Memory
+ */
+class ResultHash {
+ private:
+  /**
+   * \brief two independently seeded hashes make up the key.
+   */
+  BLI_HashMurmur2A m_mm2[2];
+
+ public:
+  ResultHash();
+
+  void add(const void *data, size_t len);
+  void addInt(int data);
+  void addFloat(float data);
+  void addString(const char *str);
+  void addKey(uint64_t key);
+
+  /**
+   * \brief get the key of everything added so far, adding can continue afterwards.
+   */
+  uint64_t getKey() const;
+};
+
+/**
+ * \brief least recently used cache of write buffer results, kept between executions.
+ *
+ * Results are identified by a ResultHash of the operations that computed them, so when only
+ * nodes downstream of a buffer change, the buffer is restored instead of being recalculated.
+ * The memory limit is the compositor cache limit user preference.
+ * \note Only accessed while holding the compositor mutex, see COM_execute.
+ * \ingroup Memory
+ */
+class ResultCache {
+ public:
+  /**
+   * \brief is caching enabled in the user preferences.
+   */
+  static bool isEnabled();
+
+  /**
+   * \brief copy the cached result with the given key into buffer.
+   * \return false when there is no result of the same size.
+   */
+  static bool restore(uint64_t key, MemoryBuffer *buffer);
+
+  /**
+   * \brief store result, the cache takes ownership of the buffer.
+   */
+  static void store(uint64_t key, MemoryBuffer *buffer);
+
+  /**
+   * \brief free results until the cache fits into its memory limit.
+   */
+  static void trim();
+
+  /**
+   * \brief free all cached results.
+   */
+  static void clear();
+};
+
+#endif
@@ -18,6 +18,8 @@
 
 #ifndef __COM_SOCKETREADER_H__
 #define __COM_SOCKETREADER_H__
+#include <string.h>
+
 #include "BLI_rect.h"
 #include "COM_defines.h"
 
@@ -94,11 +96,37 @@ class SocketReader {
   {
   }
 
+  /**
+   * \brief calculate a row of pixels
+   * \note this method is called for non-complex.
+   * Operations can override it to process many pixels at once, reading the rows of their inputs
+   * in spans of COM_ROW_SPAN_PIXELS. By default every pixel is calculated by executePixelSampled.
+   * \param output: is an array of length * num_channels floats to store the result
+   * \param num_channels: the number of channels to store for each pixel
+   * \param x: the x-coordinate of the first pixel to calculate in image space
+   * \param y: the y-coordinate of the row to calculate in image space
+   * \param length: the number of pixels to calculate
+   */
+  virtual void executeRowSampled(
+      float *output, int num_channels, int x, int y, int length, PixelSampler sampler)
+  {
+    float result[4];
+    for (int i = 0; i < length; i++) {
+      executePixelSampled(result, x + i, y, sampler);
+      memcpy(&output[i * num_channels], result, sizeof(float) * num_channels);
+    }
+  }
+
  public:
   inline void readSampled(float result[4], float x, float y, PixelSampler sampler)
   {
     executePixelSampled(result, x, y, sampler);
   }
+  inline void readRowSampled(
+      float *result, int num_channels, int x, int y, int length, PixelSampler sampler)
+  {
+    executeRowSampled(result, num_channels, x, y, length, sampler);
+  }
   inline void read(float result[4], int x, int y, void *chunkData)
   {
     executePixel(result, x, y, chunkData);
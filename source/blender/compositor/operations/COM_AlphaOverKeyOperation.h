@@ -34,6 +34,10 @@ class AlphaOverKeyOperation : public MixBaseOperation {
   /**
    * the inner loop of this program
    */
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputOverColor,
+              const float *value,
+              int length);
 };
 #endif
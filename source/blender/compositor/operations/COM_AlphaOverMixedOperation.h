@@ -37,7 +37,11 @@ class AlphaOverMixedOperation : public MixBaseOperation {
   /**
    * the inner loop of this program
    */
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputOverColor,
+              const float *value,
+              int length);
 
   void setX(float x)
   {
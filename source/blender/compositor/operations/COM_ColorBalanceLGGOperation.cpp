@@ -63,20 +63,51 @@ void ColorBalanceLGGOperation::executePixelSampled(float output[4],
   this->m_inputValueOperation->readSampled(value, x, y, sampler);
   this->m_inputColorOperation->readSampled(inputColor, x, y, sampler);
 
-  float fac = value[0];
-  fac = min(1.0f, fac);
-  const float mfac = 1.0f - fac;
-
-  output[0] = mfac * inputColor[0] +
-              fac * colorbalance_lgg(
-                        inputColor[0], this->m_lift[0], this->m_gamma_inv[0], this->m_gain[0]);
-  output[1] = mfac * inputColor[1] +
-              fac * colorbalance_lgg(
-                        inputColor[1], this->m_lift[1], this->m_gamma_inv[1], this->m_gain[1]);
-  output[2] = mfac * inputColor[2] +
-              fac * colorbalance_lgg(
-                        inputColor[2], this->m_lift[2], this->m_gamma_inv[2], this->m_gain[2]);
-  output[3] = inputColor[3];
+  balanceRow(output, inputColor, value, 1);
+}
+
+void ColorBalanceLGGOperation::executeRowSampled(
+    float *output, int num_channels, int x, int y, int length, PixelSampler sampler)
+{
+  if (num_channels != COM_NUM_CHANNELS_COLOR) {
+    NodeOperation::executeRowSampled(output, num_channels, x, y, length, sampler);
+    return;
+  }
+
+  float inputColor[COM_ROW_SPAN_PIXELS * COM_NUM_CHANNELS_COLOR];
+  float value[COM_ROW_SPAN_PIXELS];
+
+  for (int start = 0; start < length; start += COM_ROW_SPAN_PIXELS) {
+    const int span = min_ii(length - start, COM_ROW_SPAN_PIXELS);
+    this->m_inputValueOperation->readRowSampled(
+        value, COM_NUM_CHANNELS_VALUE, x + start, y, span, sampler);
+    this->m_inputColorOperation->readRowSampled(
+        inputColor, COM_NUM_CHANNELS_COLOR, x + start, y, span, sampler);
+
+    balanceRow(&output[start * COM_NUM_CHANNELS_COLOR], inputColor, value, span);
+  }
+}
+
+void ColorBalanceLGGOperation::balanceRow(float *output,
+                                          const float *inputColor,
+                                          const float *value,
+                                          int length)
+{
+  for (int i = 0; i < length; i++, output += 4, inputColor += 4) {
+    const float fac = min(1.0f, value[i]);
+    const float mfac = 1.0f - fac;
+
+    output[0] = mfac * inputColor[0] +
+                fac * colorbalance_lgg(
+                          inputColor[0], this->m_lift[0], this->m_gamma_inv[0], this->m_gain[0]);
+    output[1] = mfac * inputColor[1] +
+                fac * colorbalance_lgg(
+                          inputColor[1], this->m_lift[1], this->m_gamma_inv[1], this->m_gain[1]);
+    output[2] = mfac * inputColor[2] +
+                fac * colorbalance_lgg(
+                          inputColor[2], this->m_lift[2], this->m_gamma_inv[2], this->m_gain[2]);
+    output[3] = inputColor[3];
+  }
 }
 
 void ColorBalanceLGGOperation::deinitExecution()
@@ -36,6 +36,12 @@ class ColorBalanceLGGOperation : public NodeOperation {
   float m_lift[3];
   float m_gamma_inv[3];
 
+  /**
+   * Balance length pixels, inputColor and output have COM_NUM_CHANNELS_COLOR floats for each
+   * pixel and value has one.
+   */
+  void balanceRow(float *output, const float *inputColor, const float *value, int length);
+
  public:
   /**
    * Default constructor
@@ -47,6 +53,12 @@ class ColorBalanceLGGOperation : public NodeOperation {
    */
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
 
+  /**
+   * the inner loop of this program for spans of pixels
+   */
+  void executeRowSampled(
+      float *output, int num_channels, int x, int y, int length, PixelSampler sampler);
+
   /**
    * Initialize the execution
    */
@@ -114,3 +114,13 @@ void ConvertDepthToRadiusOperation::deinitExecution()
 {
   this->m_inputOperation = NULL;
 }
+
+bool ConvertDepthToRadiusOperation::determineResultHash(ResultHash &hash)
+{
+  /* Camera settings are not part of the node, hash what was computed from them instead. */
+  hash.addFloat(this->m_inverseFocalDistance);
+  hash.addFloat(this->m_aperture);
+  hash.addFloat(this->m_dof_sp);
+  hash.addFloat(this->m_maxRadius);
+  return NodeOperation::determineResultHash(hash);
+}
@@ -63,6 +63,8 @@ class ConvertDepthToRadiusOperation : public NodeOperation {
    */
   void deinitExecution();
 
+  bool determineResultHash(ResultHash &hash);
+
   void setfStop(float fStop)
   {
     this->m_fStop = fStop;
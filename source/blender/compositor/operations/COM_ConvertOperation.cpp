@@ -37,6 +37,36 @@ void ConvertBaseOperation::deinitExecution()
   this->m_inputOperation = NULL;
 }
 
+void ConvertBaseOperation::executePixelSampled(float output[4],
+                                               float x,
+                                               float y,
+                                               PixelSampler sampler)
+{
+  float input[4];
+  this->m_inputOperation->readSampled(input, x, y, sampler);
+  convertRow(output, input, 1);
+}
+
+void ConvertBaseOperation::executeRowSampled(
+    float *output, int num_channels, int x, int y, int length, PixelSampler sampler)
+{
+  const int input_channels = COM_num_channels_for_datatype(getInputSocket(0)->getDataType());
+  const int output_channels = COM_num_channels_for_datatype(getOutputSocket(0)->getDataType());
+  if (num_channels != output_channels) {
+    NodeOperation::executeRowSampled(output, num_channels, x, y, length, sampler);
+    return;
+  }
+
+  float input[COM_ROW_SPAN_PIXELS * COM_NUM_CHANNELS_COLOR];
+
+  for (int start = 0; start < length; start += COM_ROW_SPAN_PIXELS) {
+    const int span = min_ii(length - start, COM_ROW_SPAN_PIXELS);
+    this->m_inputOperation->readRowSampled(input, input_channels, x + start, y, span, sampler);
+
+    convertRow(&output[start * output_channels], input, span);
+  }
+}
+
 /* ******** Value to Color ******** */
 
 ConvertValueToColorOperation::ConvertValueToColorOperation() : ConvertBaseOperation()
@@ -45,15 +75,12 @@ ConvertValueToColorOperation::ConvertValueToColorOperation() : ConvertBaseOperat
   this->addOutputSocket(COM_DT_COLOR);
 }
 
-void ConvertValueToColorOperation::executePixelSampled(float output[4],
-                                                       float x,
-                                                       float y,
-                                                       PixelSampler sampler)
+void ConvertValueToColorOperation::convertRow(float *output, const float *input, int length)
 {
-  float value;
-  this->m_inputOperation->readSampled(&value, x, y, sampler);
-  output[0] = output[1] = output[2] = value;
-  output[3] = 1.0f;
+  for (int i = 0; i < length; i++, output += 4) {
+    output[0] = output[1] = output[2] = input[i];
+    output[3] = 1.0f;
+  }
 }
 
 /* ******** Color to Value ******** */
@@ -64,14 +91,11 @@ ConvertColorToValueOperation::ConvertColorToValueOperation() : ConvertBaseOperat
   this->addOutputSocket(COM_DT_VALUE);
 }
 
-void ConvertColorToValueOperation::executePixelSampled(float output[4],
-                                                       float x,
-                                                       float y,
-                                                       PixelSampler sampler)
+void ConvertColorToValueOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputColor[4];
-  this->m_inputOperation->readSampled(inputColor, x, y, sampler);
-  output[0] = (inputColor[0] + inputColor[1] + inputColor[2]) / 3.0f;
+  for (int i = 0; i < length; i++, input += 4) {
+    output[i] = (input[0] + input[1] + input[2]) / 3.0f;
+  }
 }
 
 /* ******** Color to BW ******** */
@@ -82,14 +106,11 @@ ConvertColorToBWOperation::ConvertColorToBWOperation() : ConvertBaseOperation()
   this->addOutputSocket(COM_DT_VALUE);
 }
 
-void ConvertColorToBWOperation::executePixelSampled(float output[4],
-                                                    float x,
-                                                    float y,
-                                                    PixelSampler sampler)
+void ConvertColorToBWOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputColor[4];
-  this->m_inputOperation->readSampled(inputColor, x, y, sampler);
-  output[0] = IMB_colormanagement_get_luminance(inputColor);
+  for (int i = 0; i < length; i++, input += 4) {
+    output[i] = IMB_colormanagement_get_luminance(input);
+  }
 }
 
 /* ******** Color to Vector ******** */
@@ -100,14 +121,11 @@ ConvertColorToVectorOperation::ConvertColorToVectorOperation() : ConvertBaseOper
   this->addOutputSocket(COM_DT_VECTOR);
 }
 
-void ConvertColorToVectorOperation::executePixelSampled(float output[4],
-                                                        float x,
-                                                        float y,
-                                                        PixelSampler sampler)
+void ConvertColorToVectorOperation::convertRow(float *output, const float *input, int length)
 {
-  float color[4];
-  this->m_inputOperation->readSampled(color, x, y, sampler);
-  copy_v3_v3(output, color);
+  for (int i = 0; i < length; i++, output += 3, input += 4) {
+    copy_v3_v3(output, input);
+  }
 }
 
 /* ******** Value to Vector ******** */
@@ -118,14 +136,11 @@ ConvertValueToVectorOperation::ConvertValueToVectorOperation() : ConvertBaseOper
   this->addOutputSocket(COM_DT_VECTOR);
 }
 
-void ConvertValueToVectorOperation::executePixelSampled(float output[4],
-                                                        float x,
-                                                        float y,
-                                                        PixelSampler sampler)
+void ConvertValueToVectorOperation::convertRow(float *output, const float *input, int length)
 {
-  float value;
-  this->m_inputOperation->readSampled(&value, x, y, sampler);
-  output[0] = output[1] = output[2] = value;
+  for (int i = 0; i < length; i++, output += 3) {
+    output[0] = output[1] = output[2] = input[i];
+  }
 }
 
 /* ******** Vector to Color ******** */
@@ -136,13 +151,12 @@ ConvertVectorToColorOperation::ConvertVectorToColorOperation() : ConvertBaseOper
   this->addOutputSocket(COM_DT_COLOR);
 }
 
-void ConvertVectorToColorOperation::executePixelSampled(float output[4],
-                                                        float x,
-                                                        float y,
-                                                        PixelSampler sampler)
+void ConvertVectorToColorOperation::convertRow(float *output, const float *input, int length)
 {
-  this->m_inputOperation->readSampled(output, x, y, sampler);
-  output[3] = 1.0f;
+  for (int i = 0; i < length; i++, output += 4, input += 3) {
+    copy_v3_v3(output, input);
+    output[3] = 1.0f;
+  }
 }
 
 /* ******** Vector to Value ******** */
@@ -153,14 +167,11 @@ ConvertVectorToValueOperation::ConvertVectorToValueOperation() : ConvertBaseOper
   this->addOutputSocket(COM_DT_VALUE);
 }
 
-void ConvertVectorToValueOperation::executePixelSampled(float output[4],
-                                                        float x,
-                                                        float y,
-                                                        PixelSampler sampler)
+void ConvertVectorToValueOperation::convertRow(float *output, const float *input, int length)
 {
-  float input[4];
-  this->m_inputOperation->readSampled(input, x, y, sampler);
-  output[0] = (input[0] + input[1] + input[2]) / 3.0f;
+  for (int i = 0; i < length; i++, input += 3) {
+    output[i] = (input[0] + input[1] + input[2]) / 3.0f;
+  }
 }
 
 /* ******** RGB to YCC ******** */
@@ -187,22 +198,18 @@ void ConvertRGBToYCCOperation::setMode(int mode)
   }
 }
 
-void ConvertRGBToYCCOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void ConvertRGBToYCCOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputColor[4];
-  float color[3];
+  for (int i = 0; i < length; i++, output += 4, input += 4) {
+    float color[3];
 
-  this->m_inputOperation->readSampled(inputColor, x, y, sampler);
-  rgb_to_ycc(
-      inputColor[0], inputColor[1], inputColor[2], &color[0], &color[1], &color[2], this->m_mode);
+    rgb_to_ycc(input[0], input[1], input[2], &color[0], &color[1], &color[2], this->m_mode);
 
-  /* divided by 255 to normalize for viewing in */
-  /* R,G,B --> Y,Cb,Cr */
-  mul_v3_v3fl(output, color, 1.0f / 255.0f);
-  output[3] = inputColor[3];
+    /* divided by 255 to normalize for viewing in */
+    /* R,G,B --> Y,Cb,Cr */
+    mul_v3_v3fl(output, color, 1.0f / 255.0f);
+    output[3] = input[3];
+  }
 }
 
 /* ******** YCC to RGB ******** */
@@ -229,26 +236,18 @@ void ConvertYCCToRGBOperation::setMode(int mode)
   }
 }
 
-void ConvertYCCToRGBOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void ConvertYCCToRGBOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputColor[4];
-  this->m_inputOperation->readSampled(inputColor, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, input += 4) {
+    float color[3];
 
-  /* need to un-normalize the data */
-  /* R,G,B --> Y,Cb,Cr */
-  mul_v3_fl(inputColor, 255.0f);
+    /* need to un-normalize the data */
+    /* R,G,B --> Y,Cb,Cr */
+    mul_v3_v3fl(color, input, 255.0f);
 
-  ycc_to_rgb(inputColor[0],
-             inputColor[1],
-             inputColor[2],
-             &output[0],
-             &output[1],
-             &output[2],
-             this->m_mode);
-  output[3] = inputColor[3];
+    ycc_to_rgb(color[0], color[1], color[2], &output[0], &output[1], &output[2], this->m_mode);
+    output[3] = input[3];
+  }
 }
 
 /* ******** RGB to YUV ******** */
@@ -259,21 +258,13 @@ ConvertRGBToYUVOperation::ConvertRGBToYUVOperation() : ConvertBaseOperation()
   this->addOutputSocket(COM_DT_COLOR);
 }
 
-void ConvertRGBToYUVOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void ConvertRGBToYUVOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputColor[4];
-  this->m_inputOperation->readSampled(inputColor, x, y, sampler);
-  rgb_to_yuv(inputColor[0],
-             inputColor[1],
-             inputColor[2],
-             &output[0],
-             &output[1],
-             &output[2],
-             BLI_YUV_ITU_BT709);
-  output[3] = inputColor[3];
+  for (int i = 0; i < length; i++, output += 4, input += 4) {
+    rgb_to_yuv(
+        input[0], input[1], input[2], &output[0], &output[1], &output[2], BLI_YUV_ITU_BT709);
+    output[3] = input[3];
+  }
 }
 
 /* ******** YUV to RGB ******** */
@@ -284,21 +275,13 @@ ConvertYUVToRGBOperation::ConvertYUVToRGBOperation() : ConvertBaseOperation()
   this->addOutputSocket(COM_DT_COLOR);
 }
 
-void ConvertYUVToRGBOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void ConvertYUVToRGBOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputColor[4];
-  this->m_inputOperation->readSampled(inputColor, x, y, sampler);
-  yuv_to_rgb(inputColor[0],
-             inputColor[1],
-             inputColor[2],
-             &output[0],
-             &output[1],
-             &output[2],
-             BLI_YUV_ITU_BT709);
-  output[3] = inputColor[3];
+  for (int i = 0; i < length; i++, output += 4, input += 4) {
+    yuv_to_rgb(
+        input[0], input[1], input[2], &output[0], &output[1], &output[2], BLI_YUV_ITU_BT709);
+    output[3] = input[3];
+  }
 }
 
 /* ******** RGB to HSV ******** */
@@ -309,15 +292,12 @@ ConvertRGBToHSVOperation::ConvertRGBToHSVOperation() : ConvertBaseOperation()
   this->addOutputSocket(COM_DT_COLOR);
 }
 
-void ConvertRGBToHSVOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void ConvertRGBToHSVOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputColor[4];
-  this->m_inputOperation->readSampled(inputColor, x, y, sampler);
-  rgb_to_hsv_v(inputColor, output);
-  output[3] = inputColor[3];
+  for (int i = 0; i < length; i++, output += 4, input += 4) {
+    rgb_to_hsv_v(input, output);
+    output[3] = input[3];
+  }
 }
 
 /* ******** HSV to RGB ******** */
@@ -328,18 +308,15 @@ ConvertHSVToRGBOperation::ConvertHSVToRGBOperation() : ConvertBaseOperation()
   this->addOutputSocket(COM_DT_COLOR);
 }
 
-void ConvertHSVToRGBOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void ConvertHSVToRGBOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputColor[4];
-  this->m_inputOperation->readSampled(inputColor, x, y, sampler);
-  hsv_to_rgb_v(inputColor, output);
-  output[0] = max_ff(output[0], 0.0f);
-  output[1] = max_ff(output[1], 0.0f);
-  output[2] = max_ff(output[2], 0.0f);
-  output[3] = inputColor[3];
+  for (int i = 0; i < length; i++, output += 4, input += 4) {
+    hsv_to_rgb_v(input, output);
+    output[0] = max_ff(output[0], 0.0f);
+    output[1] = max_ff(output[1], 0.0f);
+    output[2] = max_ff(output[2], 0.0f);
+    output[3] = input[3];
+  }
 }
 
 /* ******** Premul to Straight ******** */
@@ -350,26 +327,21 @@ ConvertPremulToStraightOperation::ConvertPremulToStraightOperation() : ConvertBa
   this->addOutputSocket(COM_DT_COLOR);
 }
 
-void ConvertPremulToStraightOperation::executePixelSampled(float output[4],
-                                                           float x,
-                                                           float y,
-                                                           PixelSampler sampler)
+void ConvertPremulToStraightOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputValue[4];
-  float alpha;
+  for (int i = 0; i < length; i++, output += 4, input += 4) {
+    const float alpha = input[3];
 
-  this->m_inputOperation->readSampled(inputValue, x, y, sampler);
-  alpha = inputValue[3];
+    if (fabsf(alpha) < 1e-5f) {
+      zero_v3(output);
+    }
+    else {
+      mul_v3_v3fl(output, input, 1.0f / alpha);
+    }
 
-  if (fabsf(alpha) < 1e-5f) {
-    zero_v3(output);
-  }
-  else {
-    mul_v3_v3fl(output, inputValue, 1.0f / alpha);
+    /* never touches the alpha */
+    output[3] = alpha;
   }
-
-  /* never touches the alpha */
-  output[3] = alpha;
 }
 
 /* ******** Straight to Premul ******** */
@@ -380,21 +352,16 @@ ConvertStraightToPremulOperation::ConvertStraightToPremulOperation() : ConvertBa
   this->addOutputSocket(COM_DT_COLOR);
 }
 
-void ConvertStraightToPremulOperation::executePixelSampled(float output[4],
-                                                           float x,
-                                                           float y,
-                                                           PixelSampler sampler)
+void ConvertStraightToPremulOperation::convertRow(float *output, const float *input, int length)
 {
-  float inputValue[4];
-  float alpha;
-
-  this->m_inputOperation->readSampled(inputValue, x, y, sampler);
-  alpha = inputValue[3];
+  for (int i = 0; i < length; i++, output += 4, input += 4) {
+    const float alpha = input[3];
 
-  mul_v3_v3fl(output, inputValue, alpha);
+    mul_v3_v3fl(output, input, alpha);
 
-  /* never touches the alpha */
-  output[3] = alpha;
+    /* never touches the alpha */
+    output[3] = alpha;
+  }
 }
 
 /* ******** Separate Channels ******** */
@@ -30,55 +30,65 @@ class ConvertBaseOperation : public NodeOperation {
 
   void initExecution();
   void deinitExecution();
+
+  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRowSampled(
+      float *output, int num_channels, int x, int y, int length, PixelSampler sampler);
+
+  /**
+   * Convert length pixels, input and output have the number of channels of their socket
+   * data type for each pixel.
+   */
+  virtual void convertRow(float *output, const float *input, int length) = 0;
 };
 
 class ConvertValueToColorOperation : public ConvertBaseOperation {
  public:
   ConvertValueToColorOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertColorToValueOperation : public ConvertBaseOperation {
  public:
   ConvertColorToValueOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertColorToBWOperation : public ConvertBaseOperation {
  public:
   ConvertColorToBWOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertColorToVectorOperation : public ConvertBaseOperation {
  public:
   ConvertColorToVectorOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertValueToVectorOperation : public ConvertBaseOperation {
  public:
   ConvertValueToVectorOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertVectorToColorOperation : public ConvertBaseOperation {
  public:
   ConvertVectorToColorOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertVectorToValueOperation : public ConvertBaseOperation {
  public:
   ConvertVectorToValueOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertRGBToYCCOperation : public ConvertBaseOperation {
@@ -89,7 +99,7 @@ class ConvertRGBToYCCOperation : public ConvertBaseOperation {
  public:
   ConvertRGBToYCCOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 
   /** Set the YCC mode */
   void setMode(int mode);
@@ -103,7 +113,7 @@ class ConvertYCCToRGBOperation : public ConvertBaseOperation {
  public:
   ConvertYCCToRGBOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 
   /** Set the YCC mode */
   void setMode(int mode);
@@ -113,42 +123,42 @@ class ConvertRGBToYUVOperation : public ConvertBaseOperation {
  public:
   ConvertRGBToYUVOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertYUVToRGBOperation : public ConvertBaseOperation {
  public:
   ConvertYUVToRGBOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertRGBToHSVOperation : public ConvertBaseOperation {
  public:
   ConvertRGBToHSVOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertHSVToRGBOperation : public ConvertBaseOperation {
  public:
   ConvertHSVToRGBOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertPremulToStraightOperation : public ConvertBaseOperation {
  public:
   ConvertPremulToStraightOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class ConvertStraightToPremulOperation : public ConvertBaseOperation {
  public:
   ConvertStraightToPremulOperation();
 
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void convertRow(float *output, const float *input, int length);
 };
 
 class SeparateChannelOperation : public NodeOperation {
@@ -20,6 +20,7 @@
 
 #include "COM_FastGaussianBlurOperation.h"
 #include "MEM_guardedalloc.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 FastGaussianBlurOperation::FastGaussianBlurOperation() : BlurBaseOperation(COM_DT_COLOR)
@@ -111,17 +112,120 @@ void *FastGaussianBlurOperation::initializeTileData(rcti *rect)
   return this->m_iirgaus;
 }
 
+typedef struct IIRGaussData {
+  double cf[4];
+  double tsM[9];
+  float *buffer;
+  unsigned int width;
+  unsigned int height;
+  unsigned int num_channels;
+  unsigned int chan;
+} IIRGaussData;
+
+/* Intermediate buffers of a thread, allocated for the longest line on first use. */
+typedef struct IIRGaussTLS {
+  double *X;
+  double *Y;
+  double *W;
+} IIRGaussTLS;
+
+static void iir_gauss_tls_ensure(const IIRGaussData *data, IIRGaussTLS *tls)
+{
+  if (tls->X == NULL) {
+    const unsigned int sz = max(data->width, data->height);
+    tls->X = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss X buf");
+    tls->Y = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss Y buf");
+    tls->W = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss W buf");
+  }
+}
+
+static void iir_gauss_finalize(void *__restrict /*userdata*/, void *__restrict userdata_chunk)
+{
+  IIRGaussTLS *tls = (IIRGaussTLS *)userdata_chunk;
+  if (tls->X != NULL) {
+    MEM_freeN(tls->X);
+    MEM_freeN(tls->W);
+    MEM_freeN(tls->Y);
+  }
+}
+
+/* Filter line X of length L forward into W and backward into Y. */
+static void iir_gauss_yvv(const IIRGaussData *data, IIRGaussTLS *tls, const unsigned int L)
+{
+  const double *cf = data->cf;
+  const double *tsM = data->tsM;
+  const double *X = tls->X;
+  double *W = tls->W;
+  double *Y = tls->Y;
+  double tsu[3], tsv[3];
+  unsigned int i;
+
+  W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0];
+  for (i = 3; i < L; i++) {
+    W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3];
+  }
+  tsu[0] = W[L - 1] - X[L - 1];
+  tsu[1] = W[L - 2] - X[L - 1];
+  tsu[2] = W[L - 3] - X[L - 1];
+  tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1];
+  tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1];
+  tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1];
+  Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2];
+  Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1];
+  Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0];
+  /* 'i != UINT_MAX' is really 'i >= 0', but necessary for unsigned int wrapping */
+  for (i = L - 4; i != UINT_MAX; i--) {
+    Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3];
+  }
+}
+
+static void iir_gauss_rows(void *__restrict userdata,
+                           const int y,
+                           const TaskParallelTLS *__restrict tls_v)
+{
+  const IIRGaussData *data = (const IIRGaussData *)userdata;
+  IIRGaussTLS *tls = (IIRGaussTLS *)tls_v->userdata_chunk;
+  iir_gauss_tls_ensure(data, tls);
+
+  float *buffer = data->buffer + (size_t)y * data->width * data->num_channels + data->chan;
+  for (unsigned int x = 0; x < data->width; x++) {
+    tls->X[x] = buffer[x * data->num_channels];
+  }
+  iir_gauss_yvv(data, tls, data->width);
+  for (unsigned int x = 0; x < data->width; x++) {
+    buffer[x * data->num_channels] = tls->Y[x];
+  }
+}
+
+static void iir_gauss_columns(void *__restrict userdata,
+                              const int x,
+                              const TaskParallelTLS *__restrict tls_v)
+{
+  const IIRGaussData *data = (const IIRGaussData *)userdata;
+  IIRGaussTLS *tls = (IIRGaussTLS *)tls_v->userdata_chunk;
+  iir_gauss_tls_ensure(data, tls);
+
+  const size_t add = (size_t)data->width * data->num_channels;
+  float *buffer = data->buffer + (size_t)x * data->num_channels + data->chan;
+  for (unsigned int y = 0; y < data->height; y++) {
+    tls->X[y] = buffer[y * add];
+  }
+  iir_gauss_yvv(data, tls, data->height);
+  for (unsigned int y = 0; y < data->height; y++) {
+    buffer[y * add] = tls->Y[y];
+  }
+}
+
 void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
                                           float sigma,
                                           unsigned int chan,
                                           unsigned int xy)
 {
-  double q, q2, sc, cf[4], tsM[9], tsu[3], tsv[3];
-  double *X, *Y, *W;
+  double q, q2, sc, cf[4], tsM[9];
   const unsigned int src_width = src->getWidth();
   const unsigned int src_height = src->getHeight();
-  unsigned int x, y, sz;
-  unsigned int i;
   float *buffer = src->getBuffer();
   const unsigned int num_channels = src->get_num_channels();
 
@@ -134,7 +238,7 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
     xy = 3;
   }
 
-  // XXX The YVV macro defined below explicitly expects sources of at least 3x3 pixels,
+  // XXX iir_gauss_yvv explicitly expects sources of at least 3x3 pixels,
   //     so just skipping blur along faulty direction if src's def is below that limit!
   if (src_width < 3) {
     xy &= ~1;
@@ -185,75 +289,30 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
                  cf[3] * cf[3] * cf[3] - cf[3] * cf[2] + cf[3]);
   tsM[8] = sc * (cf[3] * (cf[1] + cf[3] * cf[2]));
 
-#define YVV(L) \
-  { \
-    W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0]; \
-    for (i = 3; i < L; i++) { \
-      W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3]; \
-    } \
-    tsu[0] = W[L - 1] - X[L - 1]; \
-    tsu[1] = W[L - 2] - X[L - 1]; \
-    tsu[2] = W[L - 3] - X[L - 1]; \
-    tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1]; \
-    tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1]; \
-    tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1]; \
-    Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2]; \
-    Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1]; \
-    Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0]; \
-    /* 'i != UINT_MAX' is really 'i >= 0', but necessary for unsigned int wrapping */ \
-    for (i = L - 4; i != UINT_MAX; i--) { \
-      Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3]; \
-    } \
-  } \
-  (void)0
-
-  // intermediate buffers
-  sz = max(src_width, src_height);
-  X = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss X buf");
-  Y = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss Y buf");
-  W = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss W buf");
+  IIRGaussData data;
+  memcpy(data.cf, cf, sizeof(data.cf));
+  memcpy(data.tsM, tsM, sizeof(data.tsM));
+  data.buffer = buffer;
+  data.width = src_width;
+  data.height = src_height;
+  data.num_channels = num_channels;
+  data.chan = chan;
+
+  /* Lines are filtered independently, each thread uses its own intermediate buffers. */
+  IIRGaussTLS tls = {NULL, NULL, NULL};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &tls;
+  settings.userdata_chunk_size = sizeof(tls);
+  settings.func_finalize = iir_gauss_finalize;
+  settings.min_iter_per_thread = 8;
+
   if (xy & 1) {  // H
-    int offset;
-    for (y = 0; y < src_height; y++) {
-      const int yx = y * src_width;
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        X[x] = buffer[offset];
-        offset += num_channels;
-      }
-      YVV(src_width);
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        buffer[offset] = Y[x];
-        offset += num_channels;
-      }
-    }
+    BLI_task_parallel_range(0, src_height, &data, iir_gauss_rows, &settings);
   }
   if (xy & 2) {  // V
-    int offset;
-    const int add = src_width * num_channels;
-
-    for (x = 0; x < src_width; x++) {
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        X[y] = buffer[offset];
-        offset += add;
-      }
-      YVV(src_height);
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        buffer[offset] = Y[y];
-        offset += add;
-      }
-    }
+    BLI_task_parallel_range(0, src_width, &data, iir_gauss_columns, &settings);
   }
-
-  MEM_freeN(X);
-  MEM_freeN(W);
-  MEM_freeN(Y);
-#undef YVV
 }
 
 ///
@@ -104,6 +104,29 @@ void BaseImageOperation::deinitExecution()
   BKE_image_release_ibuf(this->m_image, this->m_buffer, NULL);
 }
 
+bool BaseImageOperation::determineResultHash(ResultHash &hash)
+{
+  /* Image pixels can change without any change to the node, hash the pixels themselves. */
+  ImBuf *ibuf = this->m_buffer;
+  if (ibuf) {
+    const size_t num_pixels = (size_t)ibuf->x * ibuf->y;
+    hash.addInt(ibuf->x);
+    hash.addInt(ibuf->y);
+    hash.addInt(ibuf->channels);
+    if (ibuf->rect_float) {
+      hash.add(ibuf->rect_float, sizeof(float) * num_pixels * ibuf->channels);
+    }
+    else if (ibuf->rect) {
+      hash.add(ibuf->rect, sizeof(unsigned int) * num_pixels);
+      hash.add(&ibuf->rect_colorspace, sizeof(ibuf->rect_colorspace));
+    }
+    if (ibuf->zbuf_float) {
+      hash.add(ibuf->zbuf_float, sizeof(float) * num_pixels);
+    }
+  }
+  return NodeOperation::determineResultHash(hash);
+}
+
 void BaseImageOperation::determineResolution(unsigned int resolution[2],
                                              unsigned int /*preferredResolution*/[2])
 {
@@ -58,6 +58,7 @@ class BaseImageOperation : public NodeOperation {
  public:
   void initExecution();
   void deinitExecution();
+  bool determineResultHash(ResultHash &hash);
   void setImage(Image *image)
   {
     this->m_image = image;
@@ -21,7 +21,7 @@ extern "C" {
 #include "BLI_math.h"
 }
 
-MathBaseOperation::MathBaseOperation() : NodeOperation()
+MathBaseOperation::MathBaseOperation(int numInputs) : NodeOperation()
 {
   this->addInputSocket(COM_DT_VALUE);
   this->addInputSocket(COM_DT_VALUE);
@@ -30,6 +30,7 @@ MathBaseOperation::MathBaseOperation() : NodeOperation()
   this->m_inputValue1Operation = NULL;
   this->m_inputValue2Operation = NULL;
   this->m_inputValue3Operation = NULL;
+  this->m_numInputs = numInputs;
   this->m_useClamp = false;
 }
 
@@ -65,689 +66,634 @@ void MathBaseOperation::determineResolution(unsigned int resolution[2],
   NodeOperation::determineResolution(resolution, preferredResolution);
 }
 
-void MathBaseOperation::clampIfNeeded(float *color)
-{
-  if (this->m_useClamp) {
-    CLAMP(color[0], 0.0f, 1.0f);
-  }
-}
-
-void MathAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
+void MathBaseOperation::executePixelSampled(float output[4],
+                                            float x,
+                                            float y,
+                                            PixelSampler sampler)
 {
   float inputValue1[4];
   float inputValue2[4];
+  float inputValue3[4];
 
   this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = inputValue1[0] + inputValue2[0];
+  if (this->m_numInputs > 1) {
+    this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  }
+  if (this->m_numInputs > 2) {
+    this->m_inputValue3Operation->readSampled(inputValue3, x, y, sampler);
+  }
 
-  clampIfNeeded(output);
+  mathRow(output, inputValue1, inputValue2, inputValue3, 1);
 }
 
-void MathSubtractOperation::executePixelSampled(float output[4],
-                                                float x,
-                                                float y,
-                                                PixelSampler sampler)
+void MathBaseOperation::executeRowSampled(
+    float *output, int num_channels, int x, int y, int length, PixelSampler sampler)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  if (num_channels != COM_NUM_CHANNELS_VALUE) {
+    NodeOperation::executeRowSampled(output, num_channels, x, y, length, sampler);
+    return;
+  }
 
-  output[0] = inputValue1[0] - inputValue2[0];
+  float inputValue1[COM_ROW_SPAN_PIXELS];
+  float inputValue2[COM_ROW_SPAN_PIXELS];
+  float inputValue3[COM_ROW_SPAN_PIXELS];
+
+  for (int start = 0; start < length; start += COM_ROW_SPAN_PIXELS) {
+    const int span = min_ii(length - start, COM_ROW_SPAN_PIXELS);
+    this->m_inputValue1Operation->readRowSampled(
+        inputValue1, COM_NUM_CHANNELS_VALUE, x + start, y, span, sampler);
+    if (this->m_numInputs > 1) {
+      this->m_inputValue2Operation->readRowSampled(
+          inputValue2, COM_NUM_CHANNELS_VALUE, x + start, y, span, sampler);
+    }
+    if (this->m_numInputs > 2) {
+      this->m_inputValue3Operation->readRowSampled(
+          inputValue3, COM_NUM_CHANNELS_VALUE, x + start, y, span, sampler);
+    }
 
-  clampIfNeeded(output);
+    mathRow(&output[start], inputValue1, inputValue2, inputValue3, span);
+  }
 }
 
-void MathMultiplyOperation::executePixelSampled(float output[4],
-                                                float x,
-                                                float y,
-                                                PixelSampler sampler)
+void MathBaseOperation::clampIfNeeded(float *color)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = inputValue1[0] * inputValue2[0];
-
-  clampIfNeeded(output);
+  if (this->m_useClamp) {
+    CLAMP(color[0], 0.0f, 1.0f);
+  }
 }
 
-void MathDivideOperation::executePixelSampled(float output[4],
-                                              float x,
-                                              float y,
-                                              PixelSampler sampler)
+void MathAddOperation::mathRow(float *output,
+                               const float *inputValue1,
+                               const float *inputValue2,
+                               const float * /*inputValue3*/,
+                               int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = inputValue1[i] + inputValue2[i];
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  if (inputValue2[0] == 0) { /* We don't want to divide by zero. */
-    output[0] = 0.0;
-  }
-  else {
-    output[0] = inputValue1[0] / inputValue2[0];
+    clampIfNeeded(&output[i]);
   }
-
-  clampIfNeeded(output);
 }
 
-void MathSineOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MathSubtractOperation::mathRow(float *output,
+                                    const float *inputValue1,
+                                    const float *inputValue2,
+                                    const float * /*inputValue3*/,
+                                    int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = inputValue1[i] - inputValue2[i];
 
-  output[0] = sin(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathCosineOperation::executePixelSampled(float output[4],
-                                              float x,
-                                              float y,
-                                              PixelSampler sampler)
+void MathMultiplyOperation::mathRow(float *output,
+                                    const float *inputValue1,
+                                    const float *inputValue2,
+                                    const float * /*inputValue3*/,
+                                    int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = cos(inputValue1[0]);
+  for (int i = 0; i < length; i++) {
+    output[i] = inputValue1[i] * inputValue2[i];
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathTangentOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MathDivideOperation::mathRow(float *output,
+                                  const float *inputValue1,
+                                  const float *inputValue2,
+                                  const float * /*inputValue3*/,
+                                  int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = tan(inputValue1[0]);
+  for (int i = 0; i < length; i++) {
+    if (inputValue2[i] == 0) { /* We don't want to divide by zero. */
+      output[i] = 0.0;
+    }
+    else {
+      output[i] = inputValue1[i] / inputValue2[i];
+    }
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathHyperbolicSineOperation::executePixelSampled(float output[4],
-                                                      float x,
-                                                      float y,
-                                                      PixelSampler sampler)
+void MathSineOperation::mathRow(float *output,
+                                const float *inputValue1,
+                                const float * /*inputValue2*/,
+                                const float * /*inputValue3*/,
+                                int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = sin(inputValue1[i]);
 
-  output[0] = sinh(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathHyperbolicCosineOperation::executePixelSampled(float output[4],
-                                                        float x,
-                                                        float y,
-                                                        PixelSampler sampler)
+void MathCosineOperation::mathRow(float *output,
+                                  const float *inputValue1,
+                                  const float * /*inputValue2*/,
+                                  const float * /*inputValue3*/,
+                                  int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = cos(inputValue1[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = cosh(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathHyperbolicTangentOperation::executePixelSampled(float output[4],
-                                                         float x,
-                                                         float y,
-                                                         PixelSampler sampler)
+void MathTangentOperation::mathRow(float *output,
+                                   const float *inputValue1,
+                                   const float * /*inputValue2*/,
+                                   const float * /*inputValue3*/,
+                                   int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = tan(inputValue1[i]);
 
-  output[0] = tanh(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathArcSineOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MathHyperbolicSineOperation::mathRow(float *output,
+                                          const float *inputValue1,
+                                          const float * /*inputValue2*/,
+                                          const float * /*inputValue3*/,
+                                          int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = sinh(inputValue1[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  if (inputValue1[0] <= 1 && inputValue1[0] >= -1) {
-    output[0] = asin(inputValue1[0]);
+    clampIfNeeded(&output[i]);
   }
-  else {
-    output[0] = 0.0;
-  }
-
-  clampIfNeeded(output);
 }
 
-void MathArcCosineOperation::executePixelSampled(float output[4],
-                                                 float x,
-                                                 float y,
-                                                 PixelSampler sampler)
+void MathHyperbolicCosineOperation::mathRow(float *output,
+                                            const float *inputValue1,
+                                            const float * /*inputValue2*/,
+                                            const float * /*inputValue3*/,
+                                            int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = cosh(inputValue1[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  if (inputValue1[0] <= 1 && inputValue1[0] >= -1) {
-    output[0] = acos(inputValue1[0]);
-  }
-  else {
-    output[0] = 0.0;
+    clampIfNeeded(&output[i]);
   }
-
-  clampIfNeeded(output);
 }
 
-void MathArcTangentOperation::executePixelSampled(float output[4],
-                                                  float x,
-                                                  float y,
-                                                  PixelSampler sampler)
+void MathHyperbolicTangentOperation::mathRow(float *output,
+                                             const float *inputValue1,
+                                             const float * /*inputValue2*/,
+                                             const float * /*inputValue3*/,
+                                             int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = atan(inputValue1[0]);
+  for (int i = 0; i < length; i++) {
+    output[i] = tanh(inputValue1[i]);
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathPowerOperation::executePixelSampled(float output[4],
-                                             float x,
-                                             float y,
-                                             PixelSampler sampler)
+void MathArcSineOperation::mathRow(float *output,
+                                   const float *inputValue1,
+                                   const float * /*inputValue2*/,
+                                   const float * /*inputValue3*/,
+                                   int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  if (inputValue1[0] >= 0) {
-    output[0] = pow(inputValue1[0], inputValue2[0]);
-  }
-  else {
-    float y_mod_1 = fmod(inputValue2[0], 1);
-    /* if input value is not nearly an integer, fall back to zero, nicer than straight rounding */
-    if (y_mod_1 > 0.999f || y_mod_1 < 0.001f) {
-      output[0] = pow(inputValue1[0], floorf(inputValue2[0] + 0.5f));
+  for (int i = 0; i < length; i++) {
+    if (inputValue1[i] <= 1 && inputValue1[i] >= -1) {
+      output[i] = asin(inputValue1[i]);
     }
     else {
-      output[0] = 0.0;
+      output[i] = 0.0;
     }
-  }
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathLogarithmOperation::executePixelSampled(float output[4],
-                                                 float x,
-                                                 float y,
-                                                 PixelSampler sampler)
+void MathArcCosineOperation::mathRow(float *output,
+                                     const float *inputValue1,
+                                     const float * /*inputValue2*/,
+                                     const float * /*inputValue3*/,
+                                     int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    if (inputValue1[i] <= 1 && inputValue1[i] >= -1) {
+      output[i] = acos(inputValue1[i]);
+    }
+    else {
+      output[i] = 0.0;
+    }
 
-  if (inputValue1[0] > 0 && inputValue2[0] > 0) {
-    output[0] = log(inputValue1[0]) / log(inputValue2[0]);
-  }
-  else {
-    output[0] = 0.0;
+    clampIfNeeded(&output[i]);
   }
-
-  clampIfNeeded(output);
 }
 
-void MathMinimumOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MathArcTangentOperation::mathRow(float *output,
+                                      const float *inputValue1,
+                                      const float * /*inputValue2*/,
+                                      const float * /*inputValue3*/,
+                                      int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = atan(inputValue1[i]);
 
-  output[0] = min(inputValue1[0], inputValue2[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathMaximumOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MathPowerOperation::mathRow(float *output,
+                                 const float *inputValue1,
+                                 const float *inputValue2,
+                                 const float * /*inputValue3*/,
+                                 int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = max(inputValue1[0], inputValue2[0]);
+  for (int i = 0; i < length; i++) {
+    if (inputValue1[i] >= 0) {
+      output[i] = pow(inputValue1[i], inputValue2[i]);
+    }
+    else {
+      float y_mod_1 = fmod(inputValue2[i], 1);
+      /* if input value is not nearly an integer,
+       * fall back to zero, nicer than straight rounding */
+      if (y_mod_1 > 0.999f || y_mod_1 < 0.001f) {
+        output[i] = pow(inputValue1[i], floorf(inputValue2[i] + 0.5f));
+      }
+      else {
+        output[i] = 0.0;
+      }
+    }
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathRoundOperation::executePixelSampled(float output[4],
-                                             float x,
-                                             float y,
-                                             PixelSampler sampler)
+void MathLogarithmOperation::mathRow(float *output,
+                                     const float *inputValue1,
+                                     const float *inputValue2,
+                                     const float * /*inputValue3*/,
+                                     int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = round(inputValue1[0]);
+  for (int i = 0; i < length; i++) {
+    if (inputValue1[i] > 0 && inputValue2[i] > 0) {
+      output[i] = log(inputValue1[i]) / log(inputValue2[i]);
+    }
+    else {
+      output[i] = 0.0;
+    }
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathLessThanOperation::executePixelSampled(float output[4],
-                                                float x,
-                                                float y,
-                                                PixelSampler sampler)
+void MathMinimumOperation::mathRow(float *output,
+                                   const float *inputValue1,
+                                   const float *inputValue2,
+                                   const float * /*inputValue3*/,
+                                   int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = min(inputValue1[i], inputValue2[i]);
 
-  output[0] = inputValue1[0] < inputValue2[0] ? 1.0f : 0.0f;
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathGreaterThanOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void MathMaximumOperation::mathRow(float *output,
+                                   const float *inputValue1,
+                                   const float *inputValue2,
+                                   const float * /*inputValue3*/,
+                                   int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = max(inputValue1[i], inputValue2[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = inputValue1[0] > inputValue2[0] ? 1.0f : 0.0f;
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathModuloOperation::executePixelSampled(float output[4],
-                                              float x,
-                                              float y,
-                                              PixelSampler sampler)
+void MathRoundOperation::mathRow(float *output,
+                                 const float *inputValue1,
+                                 const float * /*inputValue2*/,
+                                 const float * /*inputValue3*/,
+                                 int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = round(inputValue1[i]);
 
-  if (inputValue2[0] == 0) {
-    output[0] = 0.0;
-  }
-  else {
-    output[0] = fmod(inputValue1[0], inputValue2[0]);
+    clampIfNeeded(&output[i]);
   }
-
-  clampIfNeeded(output);
 }
 
-void MathAbsoluteOperation::executePixelSampled(float output[4],
-                                                float x,
-                                                float y,
-                                                PixelSampler sampler)
+void MathLessThanOperation::mathRow(float *output,
+                                    const float *inputValue1,
+                                    const float *inputValue2,
+                                    const float * /*inputValue3*/,
+                                    int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-
-  output[0] = fabs(inputValue1[0]);
+  for (int i = 0; i < length; i++) {
+    output[i] = inputValue1[i] < inputValue2[i] ? 1.0f : 0.0f;
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathRadiansOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MathGreaterThanOperation::mathRow(float *output,
+                                       const float *inputValue1,
+                                       const float *inputValue2,
+                                       const float * /*inputValue3*/,
+                                       int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = inputValue1[i] > inputValue2[i] ? 1.0f : 0.0f;
 
-  output[0] = DEG2RADF(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathDegreesOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MathModuloOperation::mathRow(float *output,
+                                  const float *inputValue1,
+                                  const float *inputValue2,
+                                  const float * /*inputValue3*/,
+                                  int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-
-  output[0] = RAD2DEGF(inputValue1[0]);
+  for (int i = 0; i < length; i++) {
+    if (inputValue2[i] == 0) {
+      output[i] = 0.0;
+    }
+    else {
+      output[i] = fmod(inputValue1[i], inputValue2[i]);
+    }
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathArcTan2Operation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MathAbsoluteOperation::mathRow(float *output,
+                                    const float *inputValue1,
+                                    const float * /*inputValue2*/,
+                                    const float * /*inputValue3*/,
+                                    int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = atan2(inputValue1[0], inputValue2[0]);
+  for (int i = 0; i < length; i++) {
+    output[i] = fabs(inputValue1[i]);
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathFloorOperation::executePixelSampled(float output[4],
-                                             float x,
-                                             float y,
-                                             PixelSampler sampler)
+void MathRadiansOperation::mathRow(float *output,
+                                   const float *inputValue1,
+                                   const float * /*inputValue2*/,
+                                   const float * /*inputValue3*/,
+                                   int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = DEG2RADF(inputValue1[i]);
 
-  output[0] = floor(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathCeilOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MathDegreesOperation::mathRow(float *output,
+                                   const float *inputValue1,
+                                   const float * /*inputValue2*/,
+                                   const float * /*inputValue3*/,
+                                   int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = RAD2DEGF(inputValue1[i]);
 
-  output[0] = ceil(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathFractOperation::executePixelSampled(float output[4],
-                                             float x,
-                                             float y,
-                                             PixelSampler sampler)
+void MathArcTan2Operation::mathRow(float *output,
+                                   const float *inputValue1,
+                                   const float *inputValue2,
+                                   const float * /*inputValue3*/,
+                                   int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = atan2(inputValue1[i], inputValue2[i]);
 
-  output[0] = inputValue1[0] - floor(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathSqrtOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MathFloorOperation::mathRow(float *output,
+                                 const float *inputValue1,
+                                 const float * /*inputValue2*/,
+                                 const float * /*inputValue3*/,
+                                 int length)
 {
-  float inputValue1[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = floor(inputValue1[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-
-  if (inputValue1[0] > 0) {
-    output[0] = sqrt(inputValue1[0]);
+    clampIfNeeded(&output[i]);
   }
-  else {
-    output[0] = 0.0f;
-  }
-
-  clampIfNeeded(output);
 }
 
-void MathInverseSqrtOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void MathCeilOperation::mathRow(float *output,
+                                const float *inputValue1,
+                                const float * /*inputValue2*/,
+                                const float * /*inputValue3*/,
+                                int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = ceil(inputValue1[i]);
 
-  if (inputValue1[0] > 0) {
-    output[0] = 1.0f / sqrt(inputValue1[0]);
-  }
-  else {
-    output[0] = 0.0f;
+    clampIfNeeded(&output[i]);
   }
-
-  clampIfNeeded(output);
 }
 
-void MathSignOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MathFractOperation::mathRow(float *output,
+                                 const float *inputValue1,
+                                 const float * /*inputValue2*/,
+                                 const float * /*inputValue3*/,
+                                 int length)
 {
-  float inputValue1[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = inputValue1[i] - floor(inputValue1[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-
-  output[0] = compatible_signf(inputValue1[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathExponentOperation::executePixelSampled(float output[4],
-                                                float x,
-                                                float y,
-                                                PixelSampler sampler)
+void MathSqrtOperation::mathRow(float *output,
+                                const float *inputValue1,
+                                const float * /*inputValue2*/,
+                                const float * /*inputValue3*/,
+                                int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-
-  output[0] = expf(inputValue1[0]);
+  for (int i = 0; i < length; i++) {
+    if (inputValue1[i] > 0) {
+      output[i] = sqrt(inputValue1[i]);
+    }
+    else {
+      output[i] = 0.0f;
+    }
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathTruncOperation::executePixelSampled(float output[4],
-                                             float x,
-                                             float y,
-                                             PixelSampler sampler)
+void MathInverseSqrtOperation::mathRow(float *output,
+                                       const float *inputValue1,
+                                       const float * /*inputValue2*/,
+                                       const float * /*inputValue3*/,
+                                       int length)
 {
-  float inputValue1[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-
-  output[0] = (inputValue1[0] >= 0.0f) ? floor(inputValue1[0]) : ceil(inputValue1[0]);
+  for (int i = 0; i < length; i++) {
+    if (inputValue1[i] > 0) {
+      output[i] = 1.0f / sqrt(inputValue1[i]);
+    }
+    else {
+      output[i] = 0.0f;
+    }
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathSnapOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MathSignOperation::mathRow(float *output,
+                                const float *inputValue1,
+                                const float * /*inputValue2*/,
+                                const float * /*inputValue3*/,
+                                int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = compatible_signf(inputValue1[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  if (inputValue1[0] == 0 || inputValue2[0] == 0) { /* We don't want to divide by zero. */
-    output[0] = 0.0f;
-  }
-  else {
-    output[0] = floorf(inputValue1[0] / inputValue2[0]) * inputValue2[0];
+    clampIfNeeded(&output[i]);
   }
-
-  clampIfNeeded(output);
 }
 
-void MathWrapOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MathExponentOperation::mathRow(float *output,
+                                    const float *inputValue1,
+                                    const float * /*inputValue2*/,
+                                    const float * /*inputValue3*/,
+                                    int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-  float inputValue3[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-  this->m_inputValue3Operation->readSampled(inputValue3, x, y, sampler);
+  for (int i = 0; i < length; i++) {
+    output[i] = expf(inputValue1[i]);
 
-  output[0] = wrapf(inputValue1[0], inputValue2[0], inputValue3[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathPingpongOperation::executePixelSampled(float output[4],
-                                                float x,
-                                                float y,
-                                                PixelSampler sampler)
+void MathTruncOperation::mathRow(float *output,
+                                 const float *inputValue1,
+                                 const float * /*inputValue2*/,
+                                 const float * /*inputValue3*/,
+                                 int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = (inputValue1[i] >= 0.0f) ? floor(inputValue1[i]) : ceil(inputValue1[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-
-  output[0] = fabsf(fractf((inputValue1[0] - inputValue2[0]) / (inputValue2[0] * 2.0f)) *
-                        inputValue2[0] * 2.0f -
-                    inputValue2[0]);
-
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathCompareOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MathSnapOperation::mathRow(float *output,
+                                const float *inputValue1,
+                                const float *inputValue2,
+                                const float * /*inputValue3*/,
+                                int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-  float inputValue3[4];
-
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-  this->m_inputValue3Operation->readSampled(inputValue3, x, y, sampler);
-
-  output[0] = (fabsf(inputValue1[0] - inputValue2[0]) <= MAX2(inputValue3[0], 1e-5f)) ? 1.0f :
-                                                                                        0.0f;
+  for (int i = 0; i < length; i++) {
+    if (inputValue1[i] == 0 || inputValue2[i] == 0) { /* We don't want to divide by zero. */
+      output[i] = 0.0f;
+    }
+    else {
+      output[i] = floorf(inputValue1[i] / inputValue2[i]) * inputValue2[i];
+    }
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathMultiplyAddOperation::executePixelSampled(float output[4],
-                                                   float x,
-                                                   float y,
-                                                   PixelSampler sampler)
+void MathWrapOperation::mathRow(float *output,
+                                const float *inputValue1,
+                                const float *inputValue2,
+                                const float *inputValue3,
+                                int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-  float inputValue3[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = wrapf(inputValue1[i], inputValue2[i], inputValue3[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-  this->m_inputValue3Operation->readSampled(inputValue3, x, y, sampler);
+    clampIfNeeded(&output[i]);
+  }
+}
 
-  output[0] = inputValue1[0] * inputValue2[0] + inputValue3[0];
+void MathPingpongOperation::mathRow(float *output,
+                                    const float *inputValue1,
+                                    const float *inputValue2,
+                                    const float * /*inputValue3*/,
+                                    int length)
+{
+  for (int i = 0; i < length; i++) {
+    output[i] = fabsf(fractf((inputValue1[i] - inputValue2[i]) / (inputValue2[i] * 2.0f)) *
+                          inputValue2[i] * 2.0f -
+                      inputValue2[i]);
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathSmoothMinOperation::executePixelSampled(float output[4],
-                                                 float x,
-                                                 float y,
-                                                 PixelSampler sampler)
+void MathCompareOperation::mathRow(float *output,
+                                   const float *inputValue1,
+                                   const float *inputValue2,
+                                   const float *inputValue3,
+                                   int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-  float inputValue3[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = (fabsf(inputValue1[i] - inputValue2[i]) <= MAX2(inputValue3[i], 1e-5f)) ? 1.0f :
+                                                                                          0.0f;
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-  this->m_inputValue3Operation->readSampled(inputValue3, x, y, sampler);
+    clampIfNeeded(&output[i]);
+  }
+}
 
-  output[0] = smoothminf(inputValue1[0], inputValue2[0], inputValue3[0]);
+void MathMultiplyAddOperation::mathRow(float *output,
+                                       const float *inputValue1,
+                                       const float *inputValue2,
+                                       const float *inputValue3,
+                                       int length)
+{
+  for (int i = 0; i < length; i++) {
+    output[i] = inputValue1[i] * inputValue2[i] + inputValue3[i];
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
 
-void MathSmoothMaxOperation::executePixelSampled(float output[4],
-                                                 float x,
-                                                 float y,
-                                                 PixelSampler sampler)
+void MathSmoothMinOperation::mathRow(float *output,
+                                     const float *inputValue1,
+                                     const float *inputValue2,
+                                     const float *inputValue3,
+                                     int length)
 {
-  float inputValue1[4];
-  float inputValue2[4];
-  float inputValue3[4];
+  for (int i = 0; i < length; i++) {
+    output[i] = smoothminf(inputValue1[i], inputValue2[i], inputValue3[i]);
 
-  this->m_inputValue1Operation->readSampled(inputValue1, x, y, sampler);
-  this->m_inputValue2Operation->readSampled(inputValue2, x, y, sampler);
-  this->m_inputValue3Operation->readSampled(inputValue3, x, y, sampler);
+    clampIfNeeded(&output[i]);
+  }
+}
 
-  output[0] = -smoothminf(-inputValue1[0], -inputValue2[0], inputValue3[0]);
+void MathSmoothMaxOperation::mathRow(float *output,
+                                     const float *inputValue1,
+                                     const float *inputValue2,
+                                     const float *inputValue3,
+                                     int length)
+{
+  for (int i = 0; i < length; i++) {
+    output[i] = -smoothminf(-inputValue1[i], -inputValue2[i], inputValue3[i]);
 
-  clampIfNeeded(output);
+    clampIfNeeded(&output[i]);
+  }
 }
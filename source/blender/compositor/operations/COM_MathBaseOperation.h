@@ -33,21 +33,41 @@ class MathBaseOperation : public NodeOperation {
   SocketReader *m_inputValue2Operation;
   SocketReader *m_inputValue3Operation;
 
+  /**
+   * Number of inputs used by the operation, unused inputs are not read.
+   */
+  int m_numInputs;
+
   bool m_useClamp;
 
  protected:
   /**
    * Default constructor
    */
-  MathBaseOperation();
+  MathBaseOperation(int numInputs = 2);
 
   void clampIfNeeded(float color[4]);
 
+  /**
+   * Calculate length values, inputs and output have one float for each pixel.
+   */
+  virtual void mathRow(float *output,
+                       const float *inputValue1,
+                       const float *inputValue2,
+                       const float *inputValue3,
+                       int length) = 0;
+
  public:
   /**
    * the inner loop of this program
    */
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler) = 0;
+  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+
+  /**
+   * the inner loop of this program for spans of pixels
+   */
+  void executeRowSampled(
+      float *output, int num_channels, int x, int y, int length, PixelSampler sampler);
 
   /**
    * Initialize the execution
@@ -75,142 +95,222 @@ class MathAddOperation : public MathBaseOperation {
   MathAddOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathSubtractOperation : public MathBaseOperation {
  public:
   MathSubtractOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathMultiplyOperation : public MathBaseOperation {
  public:
   MathMultiplyOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathDivideOperation : public MathBaseOperation {
  public:
   MathDivideOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathSineOperation : public MathBaseOperation {
  public:
-  MathSineOperation() : MathBaseOperation()
+  MathSineOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathCosineOperation : public MathBaseOperation {
  public:
-  MathCosineOperation() : MathBaseOperation()
+  MathCosineOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathTangentOperation : public MathBaseOperation {
  public:
-  MathTangentOperation() : MathBaseOperation()
+  MathTangentOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathHyperbolicSineOperation : public MathBaseOperation {
  public:
-  MathHyperbolicSineOperation() : MathBaseOperation()
+  MathHyperbolicSineOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathHyperbolicCosineOperation : public MathBaseOperation {
  public:
-  MathHyperbolicCosineOperation() : MathBaseOperation()
+  MathHyperbolicCosineOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathHyperbolicTangentOperation : public MathBaseOperation {
  public:
-  MathHyperbolicTangentOperation() : MathBaseOperation()
+  MathHyperbolicTangentOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathArcSineOperation : public MathBaseOperation {
  public:
-  MathArcSineOperation() : MathBaseOperation()
+  MathArcSineOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathArcCosineOperation : public MathBaseOperation {
  public:
-  MathArcCosineOperation() : MathBaseOperation()
+  MathArcCosineOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathArcTangentOperation : public MathBaseOperation {
  public:
-  MathArcTangentOperation() : MathBaseOperation()
+  MathArcTangentOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathPowerOperation : public MathBaseOperation {
  public:
   MathPowerOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathLogarithmOperation : public MathBaseOperation {
  public:
   MathLogarithmOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathMinimumOperation : public MathBaseOperation {
  public:
   MathMinimumOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathMaximumOperation : public MathBaseOperation {
  public:
   MathMaximumOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathRoundOperation : public MathBaseOperation {
  public:
-  MathRoundOperation() : MathBaseOperation()
+  MathRoundOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathLessThanOperation : public MathBaseOperation {
  public:
   MathLessThanOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 class MathGreaterThanOperation : public MathBaseOperation {
  public:
   MathGreaterThanOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathModuloOperation : public MathBaseOperation {
@@ -218,31 +318,47 @@ class MathModuloOperation : public MathBaseOperation {
   MathModuloOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathAbsoluteOperation : public MathBaseOperation {
  public:
-  MathAbsoluteOperation() : MathBaseOperation()
+  MathAbsoluteOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathRadiansOperation : public MathBaseOperation {
  public:
-  MathRadiansOperation() : MathBaseOperation()
+  MathRadiansOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathDegreesOperation : public MathBaseOperation {
  public:
-  MathDegreesOperation() : MathBaseOperation()
+  MathDegreesOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathArcTan2Operation : public MathBaseOperation {
@@ -250,71 +366,107 @@ class MathArcTan2Operation : public MathBaseOperation {
   MathArcTan2Operation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathFloorOperation : public MathBaseOperation {
  public:
-  MathFloorOperation() : MathBaseOperation()
+  MathFloorOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathCeilOperation : public MathBaseOperation {
  public:
-  MathCeilOperation() : MathBaseOperation()
+  MathCeilOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathFractOperation : public MathBaseOperation {
  public:
-  MathFractOperation() : MathBaseOperation()
+  MathFractOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathSqrtOperation : public MathBaseOperation {
  public:
-  MathSqrtOperation() : MathBaseOperation()
+  MathSqrtOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathInverseSqrtOperation : public MathBaseOperation {
  public:
-  MathInverseSqrtOperation() : MathBaseOperation()
+  MathInverseSqrtOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathSignOperation : public MathBaseOperation {
  public:
-  MathSignOperation() : MathBaseOperation()
+  MathSignOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathExponentOperation : public MathBaseOperation {
  public:
-  MathExponentOperation() : MathBaseOperation()
+  MathExponentOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathTruncOperation : public MathBaseOperation {
  public:
-  MathTruncOperation() : MathBaseOperation()
+  MathTruncOperation() : MathBaseOperation(1)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathSnapOperation : public MathBaseOperation {
@@ -322,15 +474,23 @@ class MathSnapOperation : public MathBaseOperation {
   MathSnapOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathWrapOperation : public MathBaseOperation {
  public:
-  MathWrapOperation() : MathBaseOperation()
+  MathWrapOperation() : MathBaseOperation(3)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathPingpongOperation : public MathBaseOperation {
@@ -338,38 +498,58 @@ class MathPingpongOperation : public MathBaseOperation {
   MathPingpongOperation() : MathBaseOperation()
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathCompareOperation : public MathBaseOperation {
  public:
-  MathCompareOperation() : MathBaseOperation()
+  MathCompareOperation() : MathBaseOperation(3)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathMultiplyAddOperation : public MathBaseOperation {
  public:
-  MathMultiplyAddOperation() : MathBaseOperation()
+  MathMultiplyAddOperation() : MathBaseOperation(3)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathSmoothMinOperation : public MathBaseOperation {
  public:
-  MathSmoothMinOperation() : MathBaseOperation()
+  MathSmoothMinOperation() : MathBaseOperation(3)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 
 class MathSmoothMaxOperation : public MathBaseOperation {
  public:
-  MathSmoothMaxOperation() : MathBaseOperation()
+  MathSmoothMaxOperation() : MathBaseOperation(3)
   {
   }
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mathRow(float *output,
+               const float *inputValue1,
+               const float *inputValue2,
+               const float *inputValue3,
+               int length);
 };
 #endif
@@ -54,15 +54,51 @@ void MixBaseOperation::executePixelSampled(float output[4], float x, float y, Pi
   this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
   this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
+  mixRow(output, inputColor1, inputColor2, inputValue, 1);
+}
+
+void MixBaseOperation::executeRowSampled(
+    float *output, int num_channels, int x, int y, int length, PixelSampler sampler)
+{
+  if (num_channels != COM_NUM_CHANNELS_COLOR) {
+    NodeOperation::executeRowSampled(output, num_channels, x, y, length, sampler);
+    return;
+  }
+
+  float inputColor1[COM_ROW_SPAN_PIXELS * COM_NUM_CHANNELS_COLOR];
+  float inputColor2[COM_ROW_SPAN_PIXELS * COM_NUM_CHANNELS_COLOR];
+  float inputValue[COM_ROW_SPAN_PIXELS];
+
+  for (int start = 0; start < length; start += COM_ROW_SPAN_PIXELS) {
+    const int span = min_ii(length - start, COM_ROW_SPAN_PIXELS);
+    this->m_inputValueOperation->readRowSampled(
+        inputValue, COM_NUM_CHANNELS_VALUE, x + start, y, span, sampler);
+    this->m_inputColor1Operation->readRowSampled(
+        inputColor1, COM_NUM_CHANNELS_COLOR, x + start, y, span, sampler);
+    this->m_inputColor2Operation->readRowSampled(
+        inputColor2, COM_NUM_CHANNELS_COLOR, x + start, y, span, sampler);
+
+    mixRow(&output[start * COM_NUM_CHANNELS_COLOR], inputColor1, inputColor2, inputValue, span);
+  }
+}
+
+void MixBaseOperation::mixRow(float *output,
+                              const float *inputColor1,
+                              const float *inputColor2,
+                              const float *inputValue,
+                              int length)
+{
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
+    output[0] = valuem * (inputColor1[0]) + value * (inputColor2[0]);
+    output[1] = valuem * (inputColor1[1]) + value * (inputColor2[1]);
+    output[2] = valuem * (inputColor1[2]) + value * (inputColor2[2]);
+    output[3] = inputColor1[3];
   }
-  float valuem = 1.0f - value;
-  output[0] = valuem * (inputColor1[0]) + value * (inputColor2[0]);
-  output[1] = valuem * (inputColor1[1]) + value * (inputColor2[1]);
-  output[2] = valuem * (inputColor1[2]) + value * (inputColor2[2]);
-  output[3] = inputColor1[3];
 }
 
 void MixBaseOperation::determineResolution(unsigned int resolution[2],
@@ -104,26 +140,24 @@ MixAddOperation::MixAddOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
+void MixAddOperation::mixRow(float *output,
+                             const float *inputColor1,
+                             const float *inputColor2,
+                             const float *inputValue,
+                             int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    output[0] = inputColor1[0] + value * inputColor2[0];
+    output[1] = inputColor1[1] + value * inputColor2[1];
+    output[2] = inputColor1[2] + value * inputColor2[2];
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
+    clampIfNeeded(output);
   }
-  output[0] = inputColor1[0] + value * inputColor2[0];
-  output[1] = inputColor1[1] + value * inputColor2[1];
-  output[2] = inputColor1[2] + value * inputColor2[2];
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Blend Operation ******** */
@@ -133,31 +167,28 @@ MixBlendOperation::MixBlendOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixBlendOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MixBlendOperation::mixRow(float *output,
+                               const float *inputColor1,
+                               const float *inputColor2,
+                               const float *inputValue,
+                               int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-  float value;
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value;
 
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
-  value = inputValue[0];
+    value = inputValue[i];
 
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  float valuem = 1.0f - value;
-  output[0] = valuem * (inputColor1[0]) + value * (inputColor2[0]);
-  output[1] = valuem * (inputColor1[1]) + value * (inputColor2[1]);
-  output[2] = valuem * (inputColor1[2]) + value * (inputColor2[2]);
-  output[3] = inputColor1[3];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
+    output[0] = valuem * (inputColor1[0]) + value * (inputColor2[0]);
+    output[1] = valuem * (inputColor1[1]) + value * (inputColor2[1]);
+    output[2] = valuem * (inputColor1[2]) + value * (inputColor2[2]);
+    output[3] = inputColor1[3];
 
-  clampIfNeeded(output);
+    clampIfNeeded(output);
+  }
 }
 
 /* ******** Mix Burn Operation ******** */
@@ -167,80 +198,76 @@ MixColorBurnOperation::MixColorBurnOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixColorBurnOperation::executePixelSampled(float output[4],
-                                                float x,
-                                                float y,
-                                                PixelSampler sampler)
+void MixColorBurnOperation::mixRow(float *output,
+                                   const float *inputColor1,
+                                   const float *inputColor2,
+                                   const float *inputValue,
+                                   int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-  float tmp;
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float tmp;
 
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
-
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  float valuem = 1.0f - value;
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
 
-  tmp = valuem + value * inputColor2[0];
-  if (tmp <= 0.0f) {
-    output[0] = 0.0f;
-  }
-  else {
-    tmp = 1.0f - (1.0f - inputColor1[0]) / tmp;
-    if (tmp < 0.0f) {
+    tmp = valuem + value * inputColor2[0];
+    if (tmp <= 0.0f) {
       output[0] = 0.0f;
     }
-    else if (tmp > 1.0f) {
-      output[0] = 1.0f;
-    }
     else {
-      output[0] = tmp;
+      tmp = 1.0f - (1.0f - inputColor1[0]) / tmp;
+      if (tmp < 0.0f) {
+        output[0] = 0.0f;
+      }
+      else if (tmp > 1.0f) {
+        output[0] = 1.0f;
+      }
+      else {
+        output[0] = tmp;
+      }
     }
-  }
 
-  tmp = valuem + value * inputColor2[1];
-  if (tmp <= 0.0f) {
-    output[1] = 0.0f;
-  }
-  else {
-    tmp = 1.0f - (1.0f - inputColor1[1]) / tmp;
-    if (tmp < 0.0f) {
+    tmp = valuem + value * inputColor2[1];
+    if (tmp <= 0.0f) {
       output[1] = 0.0f;
     }
-    else if (tmp > 1.0f) {
-      output[1] = 1.0f;
-    }
     else {
-      output[1] = tmp;
+      tmp = 1.0f - (1.0f - inputColor1[1]) / tmp;
+      if (tmp < 0.0f) {
+        output[1] = 0.0f;
+      }
+      else if (tmp > 1.0f) {
+        output[1] = 1.0f;
+      }
+      else {
+        output[1] = tmp;
+      }
     }
-  }
 
-  tmp = valuem + value * inputColor2[2];
-  if (tmp <= 0.0f) {
-    output[2] = 0.0f;
-  }
-  else {
-    tmp = 1.0f - (1.0f - inputColor1[2]) / tmp;
-    if (tmp < 0.0f) {
+    tmp = valuem + value * inputColor2[2];
+    if (tmp <= 0.0f) {
       output[2] = 0.0f;
     }
-    else if (tmp > 1.0f) {
-      output[2] = 1.0f;
-    }
     else {
-      output[2] = tmp;
+      tmp = 1.0f - (1.0f - inputColor1[2]) / tmp;
+      if (tmp < 0.0f) {
+        output[2] = 0.0f;
+      }
+      else if (tmp > 1.0f) {
+        output[2] = 1.0f;
+      }
+      else {
+        output[2] = tmp;
+      }
     }
-  }
 
-  output[3] = inputColor1[3];
+    output[3] = inputColor1[3];
 
-  clampIfNeeded(output);
+    clampIfNeeded(output);
+  }
 }
 
 /* ******** Mix Color Operation ******** */
@@ -250,42 +277,37 @@ MixColorOperation::MixColorOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixColorOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MixColorOperation::mixRow(float *output,
+                               const float *inputColor1,
+                               const float *inputColor2,
+                               const float *inputValue,
+                               int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  float valuem = 1.0f - value;
+    float colH, colS, colV;
+    rgb_to_hsv(inputColor2[0], inputColor2[1], inputColor2[2], &colH, &colS, &colV);
+    if (colS != 0.0f) {
+      float rH, rS, rV;
+      float tmpr, tmpg, tmpb;
+      rgb_to_hsv(inputColor1[0], inputColor1[1], inputColor1[2], &rH, &rS, &rV);
+      hsv_to_rgb(colH, colS, rV, &tmpr, &tmpg, &tmpb);
+      output[0] = (valuem * inputColor1[0]) + (value * tmpr);
+      output[1] = (valuem * inputColor1[1]) + (value * tmpg);
+      output[2] = (valuem * inputColor1[2]) + (value * tmpb);
+    }
+    else {
+      copy_v3_v3(output, inputColor1);
+    }
+    output[3] = inputColor1[3];
 
-  float colH, colS, colV;
-  rgb_to_hsv(inputColor2[0], inputColor2[1], inputColor2[2], &colH, &colS, &colV);
-  if (colS != 0.0f) {
-    float rH, rS, rV;
-    float tmpr, tmpg, tmpb;
-    rgb_to_hsv(inputColor1[0], inputColor1[1], inputColor1[2], &rH, &rS, &rV);
-    hsv_to_rgb(colH, colS, rV, &tmpr, &tmpg, &tmpb);
-    output[0] = (valuem * inputColor1[0]) + (value * tmpr);
-    output[1] = (valuem * inputColor1[1]) + (value * tmpg);
-    output[2] = (valuem * inputColor1[2]) + (value * tmpb);
+    clampIfNeeded(output);
   }
-  else {
-    copy_v3_v3(output, inputColor1);
-  }
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Darken Operation ******** */
@@ -295,30 +317,25 @@ MixDarkenOperation::MixDarkenOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixDarkenOperation::executePixelSampled(float output[4],
-                                             float x,
-                                             float y,
-                                             PixelSampler sampler)
+void MixDarkenOperation::mixRow(float *output,
+                                const float *inputColor1,
+                                const float *inputColor2,
+                                const float *inputValue,
+                                int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
+    output[0] = min_ff(inputColor1[0], inputColor2[0]) * value + inputColor1[0] * valuem;
+    output[1] = min_ff(inputColor1[1], inputColor2[1]) * value + inputColor1[1] * valuem;
+    output[2] = min_ff(inputColor1[2], inputColor2[2]) * value + inputColor1[2] * valuem;
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
+    clampIfNeeded(output);
   }
-  float valuem = 1.0f - value;
-  output[0] = min_ff(inputColor1[0], inputColor2[0]) * value + inputColor1[0] * valuem;
-  output[1] = min_ff(inputColor1[1], inputColor2[1]) * value + inputColor1[1] * valuem;
-  output[2] = min_ff(inputColor1[2], inputColor2[2]) * value + inputColor1[2] * valuem;
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Difference Operation ******** */
@@ -328,30 +345,25 @@ MixDifferenceOperation::MixDifferenceOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixDifferenceOperation::executePixelSampled(float output[4],
-                                                 float x,
-                                                 float y,
-                                                 PixelSampler sampler)
+void MixDifferenceOperation::mixRow(float *output,
+                                    const float *inputColor1,
+                                    const float *inputColor2,
+                                    const float *inputValue,
+                                    int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
+    output[0] = valuem * inputColor1[0] + value * fabsf(inputColor1[0] - inputColor2[0]);
+    output[1] = valuem * inputColor1[1] + value * fabsf(inputColor1[1] - inputColor2[1]);
+    output[2] = valuem * inputColor1[2] + value * fabsf(inputColor1[2] - inputColor2[2]);
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
+    clampIfNeeded(output);
   }
-  float valuem = 1.0f - value;
-  output[0] = valuem * inputColor1[0] + value * fabsf(inputColor1[0] - inputColor2[0]);
-  output[1] = valuem * inputColor1[1] + value * fabsf(inputColor1[1] - inputColor2[1]);
-  output[2] = valuem * inputColor1[2] + value * fabsf(inputColor1[2] - inputColor2[2]);
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Difference Operation ******** */
@@ -361,47 +373,42 @@ MixDivideOperation::MixDivideOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixDivideOperation::executePixelSampled(float output[4],
-                                             float x,
-                                             float y,
-                                             PixelSampler sampler)
+void MixDivideOperation::mixRow(float *output,
+                                const float *inputColor1,
+                                const float *inputColor2,
+                                const float *inputValue,
+                                int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
 
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+    if (inputColor2[0] != 0.0f) {
+      output[0] = valuem * (inputColor1[0]) + value * (inputColor1[0]) / inputColor2[0];
+    }
+    else {
+      output[0] = 0.0f;
+    }
+    if (inputColor2[1] != 0.0f) {
+      output[1] = valuem * (inputColor1[1]) + value * (inputColor1[1]) / inputColor2[1];
+    }
+    else {
+      output[1] = 0.0f;
+    }
+    if (inputColor2[2] != 0.0f) {
+      output[2] = valuem * (inputColor1[2]) + value * (inputColor1[2]) / inputColor2[2];
+    }
+    else {
+      output[2] = 0.0f;
+    }
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  float valuem = 1.0f - value;
+    output[3] = inputColor1[3];
 
-  if (inputColor2[0] != 0.0f) {
-    output[0] = valuem * (inputColor1[0]) + value * (inputColor1[0]) / inputColor2[0];
-  }
-  else {
-    output[0] = 0.0f;
-  }
-  if (inputColor2[1] != 0.0f) {
-    output[1] = valuem * (inputColor1[1]) + value * (inputColor1[1]) / inputColor2[1];
-  }
-  else {
-    output[1] = 0.0f;
+    clampIfNeeded(output);
   }
-  if (inputColor2[2] != 0.0f) {
-    output[2] = valuem * (inputColor1[2]) + value * (inputColor1[2]) / inputColor2[2];
-  }
-  else {
-    output[2] = 0.0f;
-  }
-
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Dodge Operation ******** */
@@ -411,85 +418,81 @@ MixDodgeOperation::MixDodgeOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixDodgeOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MixDodgeOperation::mixRow(float *output,
+                               const float *inputColor1,
+                               const float *inputColor2,
+                               const float *inputValue,
+                               int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-  float tmp;
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float tmp;
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-
-  if (inputColor1[0] != 0.0f) {
-    tmp = 1.0f - value * inputColor2[0];
-    if (tmp <= 0.0f) {
-      output[0] = 1.0f;
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
     }
-    else {
-      tmp = inputColor1[0] / tmp;
-      if (tmp > 1.0f) {
+
+    if (inputColor1[0] != 0.0f) {
+      tmp = 1.0f - value * inputColor2[0];
+      if (tmp <= 0.0f) {
         output[0] = 1.0f;
       }
       else {
-        output[0] = tmp;
+        tmp = inputColor1[0] / tmp;
+        if (tmp > 1.0f) {
+          output[0] = 1.0f;
+        }
+        else {
+          output[0] = tmp;
+        }
       }
     }
-  }
-  else {
-    output[0] = 0.0f;
-  }
-
-  if (inputColor1[1] != 0.0f) {
-    tmp = 1.0f - value * inputColor2[1];
-    if (tmp <= 0.0f) {
-      output[1] = 1.0f;
-    }
     else {
-      tmp = inputColor1[1] / tmp;
-      if (tmp > 1.0f) {
+      output[0] = 0.0f;
+    }
+
+    if (inputColor1[1] != 0.0f) {
+      tmp = 1.0f - value * inputColor2[1];
+      if (tmp <= 0.0f) {
         output[1] = 1.0f;
       }
       else {
-        output[1] = tmp;
+        tmp = inputColor1[1] / tmp;
+        if (tmp > 1.0f) {
+          output[1] = 1.0f;
+        }
+        else {
+          output[1] = tmp;
+        }
       }
     }
-  }
-  else {
-    output[1] = 0.0f;
-  }
-
-  if (inputColor1[2] != 0.0f) {
-    tmp = 1.0f - value * inputColor2[2];
-    if (tmp <= 0.0f) {
-      output[2] = 1.0f;
-    }
     else {
-      tmp = inputColor1[2] / tmp;
-      if (tmp > 1.0f) {
+      output[1] = 0.0f;
+    }
+
+    if (inputColor1[2] != 0.0f) {
+      tmp = 1.0f - value * inputColor2[2];
+      if (tmp <= 0.0f) {
         output[2] = 1.0f;
       }
       else {
-        output[2] = tmp;
+        tmp = inputColor1[2] / tmp;
+        if (tmp > 1.0f) {
+          output[2] = 1.0f;
+        }
+        else {
+          output[2] = tmp;
+        }
       }
     }
-  }
-  else {
-    output[2] = 0.0f;
-  }
+    else {
+      output[2] = 0.0f;
+    }
 
-  output[3] = inputColor1[3];
+    output[3] = inputColor1[3];
 
-  clampIfNeeded(output);
+    clampIfNeeded(output);
+  }
 }
 
 /* ******** Mix Glare Operation ******** */
@@ -499,38 +502,28 @@ MixGlareOperation::MixGlareOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixGlareOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MixGlareOperation::mixRow(float *output,
+                               const float *inputColor1,
+                               const float *inputColor2,
+                               const float *inputValue,
+                               int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-  float value;
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
-  value = inputValue[0];
-  float mf = 2.0f - 2.0f * fabsf(value - 0.5f);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    float mf = 2.0f - 2.0f * fabsf(value - 0.5f);
+    float color1[3];
 
-  if (inputColor1[0] < 0.0f) {
-    inputColor1[0] = 0.0f;
-  }
-  if (inputColor1[1] < 0.0f) {
-    inputColor1[1] = 0.0f;
-  }
-  if (inputColor1[2] < 0.0f) {
-    inputColor1[2] = 0.0f;
-  }
+    color1[0] = max(inputColor1[0], 0.0f);
+    color1[1] = max(inputColor1[1], 0.0f);
+    color1[2] = max(inputColor1[2], 0.0f);
 
-  output[0] = mf * max(inputColor1[0] + value * (inputColor2[0] - inputColor1[0]), 0.0f);
-  output[1] = mf * max(inputColor1[1] + value * (inputColor2[1] - inputColor1[1]), 0.0f);
-  output[2] = mf * max(inputColor1[2] + value * (inputColor2[2] - inputColor1[2]), 0.0f);
-  output[3] = inputColor1[3];
+    output[0] = mf * max(color1[0] + value * (inputColor2[0] - color1[0]), 0.0f);
+    output[1] = mf * max(color1[1] + value * (inputColor2[1] - color1[1]), 0.0f);
+    output[2] = mf * max(color1[2] + value * (inputColor2[2] - color1[2]), 0.0f);
+    output[3] = inputColor1[3];
 
-  clampIfNeeded(output);
+    clampIfNeeded(output);
+  }
 }
 
 /* ******** Mix Hue Operation ******** */
@@ -540,39 +533,37 @@ MixHueOperation::MixHueOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixHueOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
+void MixHueOperation::mixRow(float *output,
+                             const float *inputColor1,
+                             const float *inputColor2,
+                             const float *inputValue,
+                             int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  float valuem = 1.0f - value;
+    float colH, colS, colV;
+    rgb_to_hsv(inputColor2[0], inputColor2[1], inputColor2[2], &colH, &colS, &colV);
+    if (colS != 0.0f) {
+      float rH, rS, rV;
+      float tmpr, tmpg, tmpb;
+      rgb_to_hsv(inputColor1[0], inputColor1[1], inputColor1[2], &rH, &rS, &rV);
+      hsv_to_rgb(colH, rS, rV, &tmpr, &tmpg, &tmpb);
+      output[0] = valuem * (inputColor1[0]) + value * tmpr;
+      output[1] = valuem * (inputColor1[1]) + value * tmpg;
+      output[2] = valuem * (inputColor1[2]) + value * tmpb;
+    }
+    else {
+      copy_v3_v3(output, inputColor1);
+    }
+    output[3] = inputColor1[3];
 
-  float colH, colS, colV;
-  rgb_to_hsv(inputColor2[0], inputColor2[1], inputColor2[2], &colH, &colS, &colV);
-  if (colS != 0.0f) {
-    float rH, rS, rV;
-    float tmpr, tmpg, tmpb;
-    rgb_to_hsv(inputColor1[0], inputColor1[1], inputColor1[2], &rH, &rS, &rV);
-    hsv_to_rgb(colH, rS, rV, &tmpr, &tmpg, &tmpb);
-    output[0] = valuem * (inputColor1[0]) + value * tmpr;
-    output[1] = valuem * (inputColor1[1]) + value * tmpg;
-    output[2] = valuem * (inputColor1[2]) + value * tmpb;
+    clampIfNeeded(output);
   }
-  else {
-    copy_v3_v3(output, inputColor1);
-  }
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Lighten Operation ******** */
@@ -582,48 +573,43 @@ MixLightenOperation::MixLightenOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixLightenOperation::executePixelSampled(float output[4],
-                                              float x,
-                                              float y,
-                                              PixelSampler sampler)
+void MixLightenOperation::mixRow(float *output,
+                                 const float *inputColor1,
+                                 const float *inputColor2,
+                                 const float *inputValue,
+                                 int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float tmp;
+    tmp = value * inputColor2[0];
+    if (tmp > inputColor1[0]) {
+      output[0] = tmp;
+    }
+    else {
+      output[0] = inputColor1[0];
+    }
+    tmp = value * inputColor2[1];
+    if (tmp > inputColor1[1]) {
+      output[1] = tmp;
+    }
+    else {
+      output[1] = inputColor1[1];
+    }
+    tmp = value * inputColor2[2];
+    if (tmp > inputColor1[2]) {
+      output[2] = tmp;
+    }
+    else {
+      output[2] = inputColor1[2];
+    }
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  float tmp;
-  tmp = value * inputColor2[0];
-  if (tmp > inputColor1[0]) {
-    output[0] = tmp;
-  }
-  else {
-    output[0] = inputColor1[0];
-  }
-  tmp = value * inputColor2[1];
-  if (tmp > inputColor1[1]) {
-    output[1] = tmp;
-  }
-  else {
-    output[1] = inputColor1[1];
-  }
-  tmp = value * inputColor2[2];
-  if (tmp > inputColor1[2]) {
-    output[2] = tmp;
-  }
-  else {
-    output[2] = inputColor1[2];
+    clampIfNeeded(output);
   }
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Linear Light Operation ******** */
@@ -633,45 +619,40 @@ MixLinearLightOperation::MixLinearLightOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixLinearLightOperation::executePixelSampled(float output[4],
-                                                  float x,
-                                                  float y,
-                                                  PixelSampler sampler)
+void MixLinearLightOperation::mixRow(float *output,
+                                     const float *inputColor1,
+                                     const float *inputColor2,
+                                     const float *inputValue,
+                                     int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    if (inputColor2[0] > 0.5f) {
+      output[0] = inputColor1[0] + value * (2.0f * (inputColor2[0] - 0.5f));
+    }
+    else {
+      output[0] = inputColor1[0] + value * (2.0f * (inputColor2[0]) - 1.0f);
+    }
+    if (inputColor2[1] > 0.5f) {
+      output[1] = inputColor1[1] + value * (2.0f * (inputColor2[1] - 0.5f));
+    }
+    else {
+      output[1] = inputColor1[1] + value * (2.0f * (inputColor2[1]) - 1.0f);
+    }
+    if (inputColor2[2] > 0.5f) {
+      output[2] = inputColor1[2] + value * (2.0f * (inputColor2[2] - 0.5f));
+    }
+    else {
+      output[2] = inputColor1[2] + value * (2.0f * (inputColor2[2]) - 1.0f);
+    }
 
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  if (inputColor2[0] > 0.5f) {
-    output[0] = inputColor1[0] + value * (2.0f * (inputColor2[0] - 0.5f));
-  }
-  else {
-    output[0] = inputColor1[0] + value * (2.0f * (inputColor2[0]) - 1.0f);
-  }
-  if (inputColor2[1] > 0.5f) {
-    output[1] = inputColor1[1] + value * (2.0f * (inputColor2[1] - 0.5f));
-  }
-  else {
-    output[1] = inputColor1[1] + value * (2.0f * (inputColor2[1]) - 1.0f);
+    clampIfNeeded(output);
   }
-  if (inputColor2[2] > 0.5f) {
-    output[2] = inputColor1[2] + value * (2.0f * (inputColor2[2] - 0.5f));
-  }
-  else {
-    output[2] = inputColor1[2] + value * (2.0f * (inputColor2[2]) - 1.0f);
-  }
-
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Multiply Operation ******** */
@@ -681,30 +662,25 @@ MixMultiplyOperation::MixMultiplyOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixMultiplyOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MixMultiplyOperation::mixRow(float *output,
+                                  const float *inputColor1,
+                                  const float *inputColor2,
+                                  const float *inputValue,
+                                  int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
+    output[0] = inputColor1[0] * (valuem + value * inputColor2[0]);
+    output[1] = inputColor1[1] * (valuem + value * inputColor2[1]);
+    output[2] = inputColor1[2] * (valuem + value * inputColor2[2]);
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
+    clampIfNeeded(output);
   }
-  float valuem = 1.0f - value;
-  output[0] = inputColor1[0] * (valuem + value * inputColor2[0]);
-  output[1] = inputColor1[1] * (valuem + value * inputColor2[1]);
-  output[2] = inputColor1[2] * (valuem + value * inputColor2[2]);
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Ovelray Operation ******** */
@@ -714,47 +690,45 @@ MixOverlayOperation::MixOverlayOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixOverlayOperation::executePixelSampled(float output[4],
-                                              float x,
-                                              float y,
-                                              PixelSampler sampler)
+void MixOverlayOperation::mixRow(float *output,
+                                 const float *inputColor1,
+                                 const float *inputColor2,
+                                 const float *inputValue,
+                                 int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
+    float valuem = 1.0f - value;
 
-  float valuem = 1.0f - value;
+    if (inputColor1[0] < 0.5f) {
+      output[0] = inputColor1[0] * (valuem + 2.0f * value * inputColor2[0]);
+    }
+    else {
+      output[0] = 1.0f -
+                  (valuem + 2.0f * value * (1.0f - inputColor2[0])) * (1.0f - inputColor1[0]);
+    }
+    if (inputColor1[1] < 0.5f) {
+      output[1] = inputColor1[1] * (valuem + 2.0f * value * inputColor2[1]);
+    }
+    else {
+      output[1] = 1.0f -
+                  (valuem + 2.0f * value * (1.0f - inputColor2[1])) * (1.0f - inputColor1[1]);
+    }
+    if (inputColor1[2] < 0.5f) {
+      output[2] = inputColor1[2] * (valuem + 2.0f * value * inputColor2[2]);
+    }
+    else {
+      output[2] = 1.0f -
+                  (valuem + 2.0f * value * (1.0f - inputColor2[2])) * (1.0f - inputColor1[2]);
+    }
+    output[3] = inputColor1[3];
 
-  if (inputColor1[0] < 0.5f) {
-    output[0] = inputColor1[0] * (valuem + 2.0f * value * inputColor2[0]);
-  }
-  else {
-    output[0] = 1.0f - (valuem + 2.0f * value * (1.0f - inputColor2[0])) * (1.0f - inputColor1[0]);
+    clampIfNeeded(output);
   }
-  if (inputColor1[1] < 0.5f) {
-    output[1] = inputColor1[1] * (valuem + 2.0f * value * inputColor2[1]);
-  }
-  else {
-    output[1] = 1.0f - (valuem + 2.0f * value * (1.0f - inputColor2[1])) * (1.0f - inputColor1[1]);
-  }
-  if (inputColor1[2] < 0.5f) {
-    output[2] = inputColor1[2] * (valuem + 2.0f * value * inputColor2[2]);
-  }
-  else {
-    output[2] = 1.0f - (valuem + 2.0f * value * (1.0f - inputColor2[2])) * (1.0f - inputColor1[2]);
-  }
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Saturation Operation ******** */
@@ -764,39 +738,34 @@ MixSaturationOperation::MixSaturationOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixSaturationOperation::executePixelSampled(float output[4],
-                                                 float x,
-                                                 float y,
-                                                 PixelSampler sampler)
+void MixSaturationOperation::mixRow(float *output,
+                                    const float *inputColor1,
+                                    const float *inputColor2,
+                                    const float *inputValue,
+                                    int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
 
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+    float rH, rS, rV;
+    rgb_to_hsv(inputColor1[0], inputColor1[1], inputColor1[2], &rH, &rS, &rV);
+    if (rS != 0.0f) {
+      float colH, colS, colV;
+      rgb_to_hsv(inputColor2[0], inputColor2[1], inputColor2[2], &colH, &colS, &colV);
+      hsv_to_rgb(rH, (valuem * rS + value * colS), rV, &output[0], &output[1], &output[2]);
+    }
+    else {
+      copy_v3_v3(output, inputColor1);
+    }
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  float valuem = 1.0f - value;
+    output[3] = inputColor1[3];
 
-  float rH, rS, rV;
-  rgb_to_hsv(inputColor1[0], inputColor1[1], inputColor1[2], &rH, &rS, &rV);
-  if (rS != 0.0f) {
-    float colH, colS, colV;
-    rgb_to_hsv(inputColor2[0], inputColor2[1], inputColor2[2], &colH, &colS, &colV);
-    hsv_to_rgb(rH, (valuem * rS + value * colS), rV, &output[0], &output[1], &output[2]);
+    clampIfNeeded(output);
   }
-  else {
-    copy_v3_v3(output, inputColor1);
-  }
-
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Screen Operation ******** */
@@ -806,31 +775,26 @@ MixScreenOperation::MixScreenOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixScreenOperation::executePixelSampled(float output[4],
-                                             float x,
-                                             float y,
-                                             PixelSampler sampler)
+void MixScreenOperation::mixRow(float *output,
+                                const float *inputColor1,
+                                const float *inputColor2,
+                                const float *inputValue,
+                                int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
 
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+    output[0] = 1.0f - (valuem + value * (1.0f - inputColor2[0])) * (1.0f - inputColor1[0]);
+    output[1] = 1.0f - (valuem + value * (1.0f - inputColor2[1])) * (1.0f - inputColor1[1]);
+    output[2] = 1.0f - (valuem + value * (1.0f - inputColor2[2])) * (1.0f - inputColor1[2]);
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
+    clampIfNeeded(output);
   }
-  float valuem = 1.0f - value;
-
-  output[0] = 1.0f - (valuem + value * (1.0f - inputColor2[0])) * (1.0f - inputColor1[0]);
-  output[1] = 1.0f - (valuem + value * (1.0f - inputColor2[1])) * (1.0f - inputColor1[1]);
-  output[2] = 1.0f - (valuem + value * (1.0f - inputColor2[2])) * (1.0f - inputColor1[2]);
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Soft Light Operation ******** */
@@ -840,43 +804,38 @@ MixSoftLightOperation::MixSoftLightOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixSoftLightOperation::executePixelSampled(float output[4],
-                                                float x,
-                                                float y,
-                                                PixelSampler sampler)
+void MixSoftLightOperation::mixRow(float *output,
+                                   const float *inputColor1,
+                                   const float *inputColor2,
+                                   const float *inputValue,
+                                   int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
-
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
-  }
-  float valuem = 1.0f - value;
-  float scr, scg, scb;
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
+    float scr, scg, scb;
 
-  /* first calculate non-fac based Screen mix */
-  scr = 1.0f - (1.0f - inputColor2[0]) * (1.0f - inputColor1[0]);
-  scg = 1.0f - (1.0f - inputColor2[1]) * (1.0f - inputColor1[1]);
-  scb = 1.0f - (1.0f - inputColor2[2]) * (1.0f - inputColor1[2]);
+    /* first calculate non-fac based Screen mix */
+    scr = 1.0f - (1.0f - inputColor2[0]) * (1.0f - inputColor1[0]);
+    scg = 1.0f - (1.0f - inputColor2[1]) * (1.0f - inputColor1[1]);
+    scb = 1.0f - (1.0f - inputColor2[2]) * (1.0f - inputColor1[2]);
 
-  output[0] = valuem * (inputColor1[0]) +
-              value * (((1.0f - inputColor1[0]) * inputColor2[0] * (inputColor1[0])) +
-                       (inputColor1[0] * scr));
-  output[1] = valuem * (inputColor1[1]) +
-              value * (((1.0f - inputColor1[1]) * inputColor2[1] * (inputColor1[1])) +
-                       (inputColor1[1] * scg));
-  output[2] = valuem * (inputColor1[2]) +
-              value * (((1.0f - inputColor1[2]) * inputColor2[2] * (inputColor1[2])) +
-                       (inputColor1[2] * scb));
-  output[3] = inputColor1[3];
+    output[0] = valuem * (inputColor1[0]) +
+                value * (((1.0f - inputColor1[0]) * inputColor2[0] * (inputColor1[0])) +
+                         (inputColor1[0] * scr));
+    output[1] = valuem * (inputColor1[1]) +
+                value * (((1.0f - inputColor1[1]) * inputColor2[1] * (inputColor1[1])) +
+                         (inputColor1[1] * scg));
+    output[2] = valuem * (inputColor1[2]) +
+                value * (((1.0f - inputColor1[2]) * inputColor2[2] * (inputColor1[2])) +
+                         (inputColor1[2] * scb));
+    output[3] = inputColor1[3];
 
-  clampIfNeeded(output);
+    clampIfNeeded(output);
+  }
 }
 
 /* ******** Mix Subtract Operation ******** */
@@ -886,29 +845,24 @@ MixSubtractOperation::MixSubtractOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixSubtractOperation::executePixelSampled(float output[4],
-                                               float x,
-                                               float y,
-                                               PixelSampler sampler)
+void MixSubtractOperation::mixRow(float *output,
+                                  const float *inputColor1,
+                                  const float *inputColor2,
+                                  const float *inputValue,
+                                  int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
-
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    output[0] = inputColor1[0] - value * (inputColor2[0]);
+    output[1] = inputColor1[1] - value * (inputColor2[1]);
+    output[2] = inputColor1[2] - value * (inputColor2[2]);
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
+    clampIfNeeded(output);
   }
-  output[0] = inputColor1[0] - value * (inputColor2[0]);
-  output[1] = inputColor1[1] - value * (inputColor2[1]);
-  output[2] = inputColor1[2] - value * (inputColor2[2]);
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
 
 /* ******** Mix Value Operation ******** */
@@ -918,31 +872,26 @@ MixValueOperation::MixValueOperation() : MixBaseOperation()
   /* pass */
 }
 
-void MixValueOperation::executePixelSampled(float output[4],
-                                            float x,
-                                            float y,
-                                            PixelSampler sampler)
+void MixValueOperation::mixRow(float *output,
+                               const float *inputColor1,
+                               const float *inputColor2,
+                               const float *inputValue,
+                               int length)
 {
-  float inputColor1[4];
-  float inputColor2[4];
-  float inputValue[4];
+  for (int i = 0; i < length; i++, output += 4, inputColor1 += 4, inputColor2 += 4) {
+    float value = inputValue[i];
+    if (this->useValueAlphaMultiply()) {
+      value *= inputColor2[3];
+    }
+    float valuem = 1.0f - value;
 
-  this->m_inputValueOperation->readSampled(inputValue, x, y, sampler);
-  this->m_inputColor1Operation->readSampled(inputColor1, x, y, sampler);
-  this->m_inputColor2Operation->readSampled(inputColor2, x, y, sampler);
+    float rH, rS, rV;
+    float colH, colS, colV;
+    rgb_to_hsv(inputColor1[0], inputColor1[1], inputColor1[2], &rH, &rS, &rV);
+    rgb_to_hsv(inputColor2[0], inputColor2[1], inputColor2[2], &colH, &colS, &colV);
+    hsv_to_rgb(rH, rS, (valuem * rV + value * colV), &output[0], &output[1], &output[2]);
+    output[3] = inputColor1[3];
 
-  float value = inputValue[0];
-  if (this->useValueAlphaMultiply()) {
-    value *= inputColor2[3];
+    clampIfNeeded(output);
   }
-  float valuem = 1.0f - value;
-
-  float rH, rS, rV;
-  float colH, colS, colV;
-  rgb_to_hsv(inputColor1[0], inputColor1[1], inputColor1[2], &rH, &rS, &rV);
-  rgb_to_hsv(inputColor2[0], inputColor2[1], inputColor2[2], &colH, &colS, &colV);
-  hsv_to_rgb(rH, rS, (valuem * rV + value * colV), &output[0], &output[1], &output[2]);
-  output[3] = inputColor1[3];
-
-  clampIfNeeded(output);
 }
@@ -57,6 +57,23 @@ class MixBaseOperation : public NodeOperation {
    */
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
 
+  /**
+   * the inner loop of this program for spans of pixels
+   */
+  void executeRowSampled(
+      float *output, int num_channels, int x, int y, int length, PixelSampler sampler);
+
+  /**
+   * Mix length pixels of both colors, subclasses implement their blend mode here.
+   * \note inputs and output are stored with COM_NUM_CHANNELS_COLOR floats for each pixel,
+   * except inputValue which has one float for each pixel.
+   */
+  virtual void mixRow(float *output,
+                      const float *inputColor1,
+                      const float *inputColor2,
+                      const float *inputValue,
+                      int length);
+
   /**
    * Initialize the execution
    */
@@ -86,115 +103,191 @@ class MixBaseOperation : public NodeOperation {
 class MixAddOperation : public MixBaseOperation {
  public:
   MixAddOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixBlendOperation : public MixBaseOperation {
  public:
   MixBlendOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
  public:
   MixColorBurnOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixColorOperation : public MixBaseOperation {
  public:
   MixColorOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixDarkenOperation : public MixBaseOperation {
  public:
   MixDarkenOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixDifferenceOperation : public MixBaseOperation {
  public:
   MixDifferenceOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixDivideOperation : public MixBaseOperation {
  public:
   MixDivideOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixDodgeOperation : public MixBaseOperation {
  public:
   MixDodgeOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixGlareOperation : public MixBaseOperation {
  public:
   MixGlareOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixHueOperation : public MixBaseOperation {
  public:
   MixHueOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixLightenOperation : public MixBaseOperation {
  public:
   MixLightenOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixLinearLightOperation : public MixBaseOperation {
  public:
   MixLinearLightOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixMultiplyOperation : public MixBaseOperation {
  public:
   MixMultiplyOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixOverlayOperation : public MixBaseOperation {
  public:
   MixOverlayOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixSaturationOperation : public MixBaseOperation {
  public:
   MixSaturationOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixScreenOperation : public MixBaseOperation {
  public:
   MixScreenOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixSoftLightOperation : public MixBaseOperation {
  public:
   MixSoftLightOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixSubtractOperation : public MixBaseOperation {
  public:
   MixSubtractOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 class MixValueOperation : public MixBaseOperation {
  public:
   MixValueOperation();
-  void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void mixRow(float *output,
+              const float *inputColor1,
+              const float *inputColor2,
+              const float *inputValue,
+              int length);
 };
 
 #endif
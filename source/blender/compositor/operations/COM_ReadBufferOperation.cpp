@@ -74,6 +74,24 @@ void ReadBufferOperation::executePixelSampled(float output[4],
   }
 }
 
+void ReadBufferOperation::executeRowSampled(
+    float *output, int num_channels, int x, int y, int length, PixelSampler sampler)
+{
+  if (num_channels != (int)m_buffer->get_num_channels() ||
+      (!m_single_value && sampler != COM_PS_NEAREST)) {
+    NodeOperation::executeRowSampled(output, num_channels, x, y, length, sampler);
+  }
+  else if (m_single_value) {
+    /* write buffer has a single value stored at (0,0) */
+    for (int i = 0; i < length; i++) {
+      m_buffer->read(&output[i * num_channels], 0, 0);
+    }
+  }
+  else {
+    m_buffer->readRow(output, x, y, length);
+  }
+}
+
 void ReadBufferOperation::executePixelExtend(float output[4],
                                              float x,
                                              float y,
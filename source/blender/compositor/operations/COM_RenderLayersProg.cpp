@@ -182,6 +182,18 @@ void RenderLayersProg::deinitExecution()
   this->m_inputBuffer = NULL;
 }
 
+bool RenderLayersProg::determineResultHash(ResultHash &hash)
+{
+  /* The render result is not part of the node, hash the pass pixels themselves. */
+  hash.addString(this->m_passName.c_str());
+  hash.addInt(this->m_elementsize);
+  if (this->m_inputBuffer) {
+    hash.add(this->m_inputBuffer,
+             sizeof(float) * this->getWidth() * this->getHeight() * this->m_elementsize);
+  }
+  return NodeOperation::determineResultHash(hash);
+}
+
 void RenderLayersProg::determineResolution(unsigned int resolution[2],
                                            unsigned int /*preferredResolution*/[2])
 {
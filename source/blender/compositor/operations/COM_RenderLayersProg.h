@@ -122,6 +122,7 @@ class RenderLayersProg : public NodeOperation {
   }
   void initExecution();
   void deinitExecution();
+  bool determineResultHash(ResultHash &hash);
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
 };
 
@@ -31,9 +31,27 @@ void SetColorOperation::executePixelSampled(float output[4],
   copy_v4_v4(output, this->m_color);
 }
 
+void SetColorOperation::executeRowSampled(
+    float *output, int num_channels, int x, int y, int length, PixelSampler sampler)
+{
+  if (num_channels != COM_NUM_CHANNELS_COLOR) {
+    NodeOperation::executeRowSampled(output, num_channels, x, y, length, sampler);
+    return;
+  }
+  for (int i = 0; i < length; i++, output += COM_NUM_CHANNELS_COLOR) {
+    copy_v4_v4(output, this->m_color);
+  }
+}
+
 void SetColorOperation::determineResolution(unsigned int resolution[2],
                                             unsigned int preferredResolution[2])
 {
   resolution[0] = preferredResolution[0];
   resolution[1] = preferredResolution[1];
 }
+
+bool SetColorOperation::determineResultHash(ResultHash &hash)
+{
+  hash.add(this->m_color, sizeof(this->m_color));
+  return NodeOperation::determineResultHash(hash);
+}
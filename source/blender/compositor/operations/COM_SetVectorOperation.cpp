@@ -34,9 +34,30 @@ void SetVectorOperation::executePixelSampled(float output[4],
   output[2] = this->m_z;
 }
 
+void SetVectorOperation::executeRowSampled(
+    float *output, int num_channels, int x, int y, int length, PixelSampler sampler)
+{
+  if (num_channels != COM_NUM_CHANNELS_VECTOR) {
+    NodeOperation::executeRowSampled(output, num_channels, x, y, length, sampler);
+    return;
+  }
+  for (int i = 0; i < length; i++, output += COM_NUM_CHANNELS_VECTOR) {
+    output[0] = this->m_x;
+    output[1] = this->m_y;
+    output[2] = this->m_z;
+  }
+}
+
 void SetVectorOperation::determineResolution(unsigned int resolution[2],
                                              unsigned int preferredResolution[2])
 {
   resolution[0] = preferredResolution[0];
   resolution[1] = preferredResolution[1];
 }
+
+bool SetVectorOperation::determineResultHash(ResultHash &hash)
+{
+  const float vector[4] = {this->m_x, this->m_y, this->m_z, this->m_w};
+  hash.add(vector, sizeof(vector));
+  return NodeOperation::determineResultHash(hash);
+}
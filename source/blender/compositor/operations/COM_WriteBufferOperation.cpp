@@ -91,15 +91,12 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/
     int x2 = rect->xmax;
     int y2 = rect->ymax;
 
-    int x;
     int y;
     bool breaked = false;
     for (y = y1; y < y2 && (!breaked); y++) {
       int offset4 = (y * memoryBuffer->getWidth() + x1) * num_channels;
-      for (x = x1; x < x2; x++) {
-        this->m_input->readSampled(&(buffer[offset4]), x, y, COM_PS_NEAREST);
-        offset4 += num_channels;
-      }
+      this->m_input->readRowSampled(
+          &(buffer[offset4]), num_channels, x1, y, x2 - x1, COM_PS_NEAREST);
       if (isBraked()) {
         breaked = true;
       }
@@ -114,12 +111,11 @@ void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device,
                                                MemoryBuffer **inputMemoryBuffers,
                                                MemoryBuffer *outputBuffer)
 {
-  float *outputFloatBuffer = outputBuffer->getBuffer();
   cl_int error;
   /*
-   * 1. create cl_mem from outputbuffer
+   * 1. create cl_mem with the size of outputbuffer
    * 2. call NodeOperation (input) executeOpenCLChunk(.....)
-   * 3. schedule read back from opencl to main device (outputbuffer)
+   * 3. schedule read back from opencl to main device (memory proxy buffer)
    * 4. schedule native callback
    *
    * note: list of cl_mem will be filled by 2, and needs to be cleaned up by 4
@@ -130,13 +126,15 @@ void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device,
 
   const cl_image_format *imageFormat = device->determineImageFormat(outputBuffer);
 
+  /* Let the device allocate the image, the result is read back directly into the memory proxy
+   * buffer so there is no need to map outputBuffer for the device. */
   cl_mem clOutputBuffer = clCreateImage2D(device->getContext(),
-                                          CL_MEM_WRITE_ONLY | CL_MEM_USE_HOST_PTR,
+                                          CL_MEM_WRITE_ONLY,
                                           imageFormat,
                                           outputBufferWidth,
                                           outputBufferHeight,
                                           0,
-                                          outputFloatBuffer,
+                                          NULL,
                                           &error);
   if (error != CL_SUCCESS) {
     printf("CLERROR[%d]: %s\n", error, clewErrorString(error));
@@ -159,6 +157,17 @@ void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device,
   size_t origin[3] = {0, 0, 0};
   size_t region[3] = {outputBufferWidth, outputBufferHeight, 1};
 
+  /* Rows of the chunk are strided by the width of the whole buffer. */
+  MemoryBuffer *proxyBuffer = this->getMemoryProxy()->getBuffer();
+  const rcti *outputRect = outputBuffer->getRect();
+  const rcti *proxyRect = proxyBuffer->getRect();
+  const size_t num_channels = proxyBuffer->get_num_channels();
+  const size_t rowPitch = proxyBuffer->getWidth() * num_channels * sizeof(float);
+  const size_t offsetX = outputRect->xmin - proxyRect->xmin;
+  const size_t offsetY = outputRect->ymin - proxyRect->ymin;
+  float *proxyFloatBuffer = proxyBuffer->getBuffer() +
+                            (offsetY * proxyBuffer->getWidth() + offsetX) * num_channels;
+
   //  clFlush(queue);
   //  clFinish(queue);
 
@@ -171,9 +180,9 @@ void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device,
                              CL_TRUE,
                              origin,
                              region,
+                             rowPitch,
                              0,
-                             0,
-                             outputFloatBuffer,
+                             proxyFloatBuffer,
                              0,
                              NULL,
                              NULL);
@@ -181,8 +190,6 @@ void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device,
     printf("CLERROR[%d]: %s\n", error, clewErrorString(error));
   }
 
-  this->getMemoryProxy()->getBuffer()->copyContentFrom(outputBuffer);
-
   // STEP 4
   while (!clMemToCleanUp->empty()) {
     cl_mem mem = clMemToCleanUp->front();
@@ -63,6 +63,10 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* Write timeline of the operations of the last evaluation in the Trace Event
+ * JSON format. Requires evaluation timing (G_DEBUG_DEPSGRAPH_TIME). */
+void DEG_debug_stats_trace(const struct Depsgraph *graph, FILE *stream);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
@@ -62,6 +62,15 @@ eEvaluationMode DEG_get_mode(const Depsgraph *graph);
 /* Get time that depsgraph is being evaluated or was last evaluated at. */
 float DEG_get_ctime(const Depsgraph *graph);
 
+/* Allocate temporary memory for an operation which is being evaluated.
+ *
+ * The memory stays valid until the end of this evaluation of the dependency graph, so it must
+ * never be referenced by evaluated data. There is no need to free it, which makes this a cheap
+ * replacement for heap allocated arrays which only live during a modifier or constraint
+ * evaluation. Safe to call from any thread. */
+void *DEG_scratch_alloc(const Depsgraph *graph, size_t size);
+void *DEG_scratch_calloc(const Depsgraph *graph, size_t size);
+
 /* ********************* DEG evaluated data ******************* */
 
 /* Check if given ID type was tagged for update. */
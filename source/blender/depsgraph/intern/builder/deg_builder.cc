@@ -34,6 +34,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_ghash.h"
 #include "BLI_stack.h"
+#include "BLI_task.h"
 
 #include "BKE_action.h"
 
@@ -199,18 +200,40 @@ void deg_graph_build_flush_visibility(Depsgraph *graph)
   BLI_stack_free(stack);
 }
 
+void finalize_build_id_node_func(void *__restrict data_v,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict /*tls*/)
+{
+  Depsgraph *graph = (Depsgraph *)data_v;
+  /* Only touches data owned by the ID node itself, so it is safe to run
+   * for different ID nodes in parallel. */
+  graph->id_nodes[i]->finalize_build(graph);
+}
+
 }  // namespace
 
 void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
 {
   /* Make sure dependencies of visible ID datablocks are visible. */
   deg_graph_build_flush_visibility(graph);
+  /* Convert operation maps of all components to their final form. */
+  {
+    const int num_id_nodes = graph->id_nodes.size();
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, num_id_nodes, graph, finalize_build_id_node_func, &settings);
+  }
   /* Re-tag IDs for update if it was tagged before the relations
-   * update tag. */
+   * update tag. Tagging flushes to other nodes, so this is kept serial. */
   for (IDNode *id_node : graph->id_nodes) {
     ID *id_orig = id_node->id_orig;
-    id_node->finalize_build(graph);
     int flag = 0;
+    /* Paths resolved by the animation system are cached in the copied data-block, relations
+     * update is a safe point to drop them. */
+    if (deg_copy_on_write_is_expanded(id_node->id_cow)) {
+      BKE_animsys_clear_rna_path_cache(id_node->id_cow);
+    }
     /* Tag rebuild if special evaluation flags changed. */
     if (id_node->eval_flags != id_node->previous_eval_flags) {
       flag |= ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY;
@@ -0,0 +1,200 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Export of the operations timeline of the last evaluation in the Trace Event
+ * format, which is understood by chrome://tracing and Perfetto.
+ */
+
+#include "DEG_depsgraph_debug.h"
+
+#include <algorithm>
+#include <cstdarg>
+
+#include "BLI_compiler_attrs.h"
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+extern "C" {
+#include "DNA_ID.h"
+} /* extern "C" */
+
+namespace DEG {
+namespace {
+
+struct DebugContext {
+  FILE *file;
+  const Depsgraph *graph;
+  /* Separator to be written before the next event. */
+  const char *separator;
+};
+
+static void deg_debug_fprintf(const DebugContext &ctx, const char *fmt, ...)
+    ATTR_PRINTF_FORMAT(2, 3);
+static void deg_debug_fprintf(const DebugContext &ctx, const char *fmt, ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  vfprintf(ctx.file, fmt, args);
+  va_end(args);
+}
+
+string jsonify_string(const string &str)
+{
+  string result = "";
+  const int length = str.length();
+  for (int i = 0; i < length; i++) {
+    const char ch = str[i];
+    if (ch == '"' || ch == '\\') {
+      result += '\\';
+      result += ch;
+    }
+    else if ((unsigned char)ch < 0x20) {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+      result += escaped;
+    }
+    else {
+      result += ch;
+    }
+  }
+  return result;
+}
+
+/* Timestamp in microseconds relative to the start of the evaluation. */
+BLI_INLINE double get_timestamp(const DebugContext &ctx, const double time)
+{
+  return (time - ctx.graph->stats_eval_start_time) * 1e6;
+}
+
+bool operation_start_time_comparator(const OperationNode *a, const OperationNode *b)
+{
+  if (a->stats.current_thread_id != b->stats.current_thread_id) {
+    return a->stats.current_thread_id < b->stats.current_thread_id;
+  }
+  return a->stats.current_start_time < b->stats.current_start_time;
+}
+
+void write_event_begin(DebugContext &ctx)
+{
+  deg_debug_fprintf(ctx, "%s", ctx.separator);
+  ctx.separator = ",\n";
+}
+
+void write_thread_name(DebugContext &ctx, const int thread_id)
+{
+  write_event_begin(ctx);
+  deg_debug_fprintf(ctx,
+                    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+                    "\"args\":{\"name\":\"Thread %d\"}}",
+                    thread_id,
+                    thread_id);
+}
+
+void write_idle(DebugContext &ctx, const int thread_id, const double start, const double end)
+{
+  if (end <= start) {
+    return;
+  }
+  write_event_begin(ctx);
+  deg_debug_fprintf(ctx,
+                    "{\"name\":\"Idle\",\"cat\":\"Scheduler\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+                    "\"ts\":%.3f,\"dur\":%.3f}",
+                    thread_id,
+                    get_timestamp(ctx, start),
+                    (end - start) * 1e6);
+}
+
+void write_operation(DebugContext &ctx, const OperationNode *op_node)
+{
+  const ComponentNode *comp_node = op_node->owner;
+  const IDNode *id_node = comp_node->owner;
+  const double start = op_node->stats.current_start_time;
+  const double wait = (op_node->stats.current_ready_time != 0.0) ?
+                          start - op_node->stats.current_ready_time :
+                          0.0;
+  write_event_begin(ctx);
+  deg_debug_fprintf(ctx,
+                    "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+                    "\"ts\":%.3f,\"dur\":%.3f,"
+                    "\"args\":{\"id\":\"%s\",\"component\":\"%s\",\"wait\":%.3f}}",
+                    jsonify_string(op_node->identifier()).c_str(),
+                    nodeTypeAsString(comp_node->type),
+                    op_node->stats.current_thread_id,
+                    get_timestamp(ctx, start),
+                    op_node->stats.current_time * 1e6,
+                    jsonify_string(id_node->name).c_str(),
+                    jsonify_string(comp_node->name).c_str(),
+                    wait * 1e6);
+}
+
+void deg_debug_stats_trace(DebugContext &ctx)
+{
+  const Depsgraph *graph = ctx.graph;
+  /* Operations evaluated by the last evaluation, grouped by thread. */
+  vector<const OperationNode *> operations;
+  for (const OperationNode *op_node : graph->operations) {
+    if (op_node->stats.current_start_time != 0.0) {
+      operations.push_back(op_node);
+    }
+  }
+  std::sort(operations.begin(), operations.end(), operation_start_time_comparator);
+  deg_debug_fprintf(ctx, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  ctx.separator = "";
+  /* Operations of every thread, with the gaps between them. */
+  int thread_id = -1;
+  double thread_time = 0.0;
+  for (const OperationNode *op_node : operations) {
+    if (op_node->stats.current_thread_id != thread_id) {
+      if (thread_id != -1) {
+        write_idle(ctx, thread_id, thread_time, graph->stats_eval_end_time);
+      }
+      thread_id = op_node->stats.current_thread_id;
+      thread_time = graph->stats_eval_start_time;
+      write_thread_name(ctx, thread_id);
+    }
+    write_idle(ctx, thread_id, thread_time, op_node->stats.current_start_time);
+    write_operation(ctx, op_node);
+    thread_time = op_node->stats.current_start_time + op_node->stats.current_time;
+  }
+  if (thread_id != -1) {
+    write_idle(ctx, thread_id, thread_time, graph->stats_eval_end_time);
+  }
+  deg_debug_fprintf(ctx, "\n]}\n");
+}
+
+}  // namespace
+}  // namespace DEG
+
+void DEG_debug_stats_trace(const Depsgraph *depsgraph, FILE *f)
+{
+  if (depsgraph == NULL) {
+    return;
+  }
+  DEG::DebugContext ctx;
+  ctx.file = f;
+  ctx.graph = (DEG::Depsgraph *)depsgraph;
+  ctx.separator = "";
+  DEG::deg_debug_stats_trace(ctx);
+}
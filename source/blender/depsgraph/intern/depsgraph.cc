@@ -34,6 +34,8 @@
 #include "BLI_console.h"
 #include "BLI_hash.h"
 #include "BLI_ghash.h"
+#include "BLI_memarena_threaded.h"
+#include "BLI_task.h"
 
 extern "C" {
 #include "BKE_scene.h"
@@ -77,6 +79,8 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       scene_cow(NULL),
       is_active(false),
       is_evaluating(false),
+      stats_eval_start_time(0.0),
+      stats_eval_end_time(0.0),
       is_render_pipeline_depsgraph(false)
 {
   BLI_spin_init(&lock);
@@ -86,6 +90,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
   memset(id_type_updated, 0, sizeof(id_type_updated));
   memset(id_type_exist, 0, sizeof(id_type_exist));
   memset(physics_relations, 0, sizeof(physics_relations));
+  scratch_arena = BLI_memarena_threaded_new("Depsgraph scratch");
 }
 
 Depsgraph::~Depsgraph()
@@ -96,6 +101,7 @@ Depsgraph::~Depsgraph()
   if (time_source != NULL) {
     OBJECT_GUARDED_DELETE(time_source, TimeSourceNode);
   }
+  BLI_memarena_threaded_free(scratch_arena);
   BLI_spin_end(&lock);
 }
 
@@ -153,11 +159,19 @@ void Depsgraph::clear_id_nodes_conditional(const std::function<bool(ID_Type id_t
     }
     const ID_Type id_type = GS(id_node->id_cow->name);
     if (filter(id_type)) {
-      id_node->destroy();
+      id_node->destroy_copy_on_write();
     }
   }
 }
 
+static void free_id_node_func(void *__restrict data_v,
+                              const int i,
+                              const TaskParallelTLS *__restrict /*tls*/)
+{
+  Depsgraph *graph = (Depsgraph *)data_v;
+  OBJECT_GUARDED_DELETE(graph->id_nodes[i], IDNode);
+}
+
 void Depsgraph::clear_id_nodes()
 {
   /* Free memory used by ID nodes. */
@@ -166,8 +180,14 @@ void Depsgraph::clear_id_nodes()
   clear_id_nodes_conditional([](ID_Type id_type) { return id_type == ID_SCE; });
   clear_id_nodes_conditional([](ID_Type id_type) { return id_type != ID_PA; });
 
-  for (IDNode *id_node : id_nodes) {
-    OBJECT_GUARDED_DELETE(id_node, IDNode);
+  /* Copy-on-write datablocks are freed by now, so the rest of the nodes are
+   * independent from each other and can be freed in parallel. */
+  {
+    const int num_id_nodes = id_nodes.size();
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, num_id_nodes, this, free_id_node_func, &settings);
   }
   /* Clear containers. */
   BLI_ghash_clear(id_hash, NULL, NULL);
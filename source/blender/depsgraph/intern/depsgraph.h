@@ -45,6 +45,7 @@
 struct GHash;
 struct GSet;
 struct ID;
+struct MemArenaThreaded;
 struct Scene;
 struct ViewLayer;
 
@@ -200,6 +201,11 @@ struct Depsgraph {
 
   bool is_evaluating;
 
+  /* Time span of the last evaluation done with timing statistics enabled
+   * (G_DEBUG_DEPSGRAPH_TIME), base of the operations timeline. */
+  double stats_eval_start_time;
+  double stats_eval_end_time;
+
   /* Is set to truth for dependency graph which are used for post-processing (compositor and
    * sequencer).
    * Such dependency graph needs all view layers (so render pipeline can access names), but it
@@ -209,6 +215,10 @@ struct Depsgraph {
   /* Cached list of colliders/effectors for collections and the scene
    * created along with relations, for fast lookup during evaluation. */
   GHash *physics_relations[DEG_PHYSICS_RELATIONS_NUM];
+
+  /* Scratch memory for operations, freed at the end of every evaluation.
+   * See DEG_scratch_alloc(). */
+  MemArenaThreaded *scratch_arena;
 };
 
 }  // namespace DEG
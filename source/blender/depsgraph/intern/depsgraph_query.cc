@@ -31,6 +31,7 @@ extern "C" {
 #include "BLI_utildefines.h"
 #include "BLI_listbase.h"
 #include "BLI_ghash.h"
+#include "BLI_memarena_threaded.h"
 
 #include "BKE_action.h"  // XXX: BKE_pose_channel_find_name
 #include "BKE_customdata.h"
@@ -75,6 +76,18 @@ float DEG_get_ctime(const Depsgraph *graph)
   return deg_graph->ctime;
 }
 
+void *DEG_scratch_alloc(const Depsgraph *graph, size_t size)
+{
+  const DEG::Depsgraph *deg_graph = reinterpret_cast<const DEG::Depsgraph *>(graph);
+  return BLI_memarena_threaded_alloc(deg_graph->scratch_arena, size);
+}
+
+void *DEG_scratch_calloc(const Depsgraph *graph, size_t size)
+{
+  const DEG::Depsgraph *deg_graph = reinterpret_cast<const DEG::Depsgraph *>(graph);
+  return BLI_memarena_threaded_calloc(deg_graph->scratch_arena, size);
+}
+
 bool DEG_id_type_updated(const Depsgraph *graph, short id_type)
 {
   const DEG::Depsgraph *deg_graph = reinterpret_cast<const DEG::Depsgraph *>(graph);
@@ -169,6 +169,7 @@ void depsgraph_tag_to_component_opcode(const ID *id,
       *component_type = NodeType::TRANSFORM;
       break;
     case ID_RECALC_GEOMETRY:
+    case ID_RECALC_GEOMETRY_DEFORM:
       depsgraph_geometry_tag_to_component(id, component_type);
       break;
     case ID_RECALC_ANIMATION:
@@ -271,10 +272,23 @@ void depsgraph_id_tag_copy_on_write(Depsgraph *graph, IDNode *id_node, eUpdateSo
   cow_comp->tag_update(graph, update_source);
 }
 
+/* Edit mode data is referenced by the copied mesh rather than copied, see
+ * update_mesh_edit_mode_pointers(), so moving its vertices does not need a new copy. */
+bool depsgraph_tag_need_copy_on_write(const IDNode *id_node, IDRecalcFlag tag)
+{
+  if (tag == ID_RECALC_GEOMETRY_DEFORM && GS(id_node->id_orig->name) == ID_ME) {
+    const Mesh *mesh_orig = (const Mesh *)id_node->id_orig;
+    const Mesh *mesh_cow = (const Mesh *)id_node->id_cow;
+    return (mesh_orig->edit_mesh == NULL || mesh_cow->edit_mesh == NULL);
+  }
+  return true;
+}
+
 void depsgraph_tag_component(Depsgraph *graph,
                              IDNode *id_node,
                              NodeType component_type,
                              OperationCode operation_code,
+                             IDRecalcFlag tag,
                              eUpdateSource update_source)
 {
   ComponentNode *component_node = id_node->find_component(component_type);
@@ -297,7 +311,8 @@ void depsgraph_tag_component(Depsgraph *graph,
     }
   }
   /* If component depends on copy-on-write, tag it as well. */
-  if (component_node->need_tag_cow_before_update()) {
+  if (component_node->need_tag_cow_before_update() &&
+      depsgraph_tag_need_copy_on_write(id_node, tag)) {
     depsgraph_id_tag_copy_on_write(graph, id_node, update_source);
   }
 }
@@ -403,7 +418,8 @@ static void graph_id_tag_update_single_flag(Main *bmain,
     id_node->tag_update(graph, update_source);
   }
   else {
-    depsgraph_tag_component(graph, id_node, component_type, operation_code, update_source);
+    depsgraph_tag_component(
+        graph, id_node, component_type, operation_code, tag, update_source);
   }
   /* TODO(sergey): Get rid of this once all areas are using proper data ID
    * for tagging. */
@@ -727,6 +743,8 @@ const char *DEG_update_tag_as_string(IDRecalcFlag flag)
       return "TIME";
     case ID_RECALC_SOURCE:
       return "SOURCE";
+    case ID_RECALC_GEOMETRY_DEFORM:
+      return "GEOMETRY_DEFORM";
     case ID_RECALC_ALL:
       return "ALL";
   }
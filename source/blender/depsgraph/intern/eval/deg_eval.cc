@@ -28,9 +28,12 @@
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
+#include "BLI_math_base.h"
 #include "BLI_utildefines.h"
 #include "BLI_task.h"
 #include "BLI_ghash.h"
+#include "BLI_memarena_threaded.h"
+#include "BLI_trace.h"
 
 #include "BKE_global.h"
 
@@ -57,11 +60,20 @@ namespace DEG {
 /* ********************** */
 /* Evaluation Entrypoints */
 
+/* Weight of the last evaluation time in the moving average of an operation's cost. */
+#define DEG_COST_AVERAGE_FACTOR 0.25
+/* Cost of operations which were not evaluated yet (in seconds), so that the number of
+ * operations on a chain counts as well. */
+#define DEG_COST_DEFAULT 1e-6
+/* Number of ready operations which are sorted by priority before being scheduled,
+ * others are scheduled in the order they become ready. */
+#define DEG_SCHEDULE_BATCH_SIZE 64
+
 /* Forward declarations. */
-static void schedule_children(TaskPool *pool,
-                              Depsgraph *graph,
-                              OperationNode *node,
-                              const int thread_id);
+static OperationNode *schedule_children(TaskPool *pool,
+                                        Depsgraph *graph,
+                                        OperationNode *node,
+                                        const int thread_id);
 
 struct DepsgraphEvalState {
   Depsgraph *graph;
@@ -74,21 +86,34 @@ static void deg_task_run_func(TaskPool *pool, void *taskdata, int thread_id)
   void *userdata_v = BLI_task_pool_userdata(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
   OperationNode *node = (OperationNode *)taskdata;
-  /* Sanity checks. */
-  BLI_assert(!node->is_noop() && "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
-  if (state->do_stats) {
+  /* Follow the chain of operations in this task: the child which becomes ready and is on the
+   * critical path is evaluated right away instead of going through the task pool. Long chains
+   * of small operations, like the bones of a rig, would otherwise mostly cost scheduling. */
+  while (node != NULL) {
+    /* Sanity checks. */
+    BLI_assert(!node->is_noop() && "NOOP nodes should not actually be scheduled");
+    /* Perform operation, timing it so the cost is known by the next scheduling. */
     const double start_time = PIL_check_seconds_timer();
     node->evaluate((::Depsgraph *)state->graph);
-    node->stats.current_time += PIL_check_seconds_timer() - start_time;
-  }
-  else {
-    node->evaluate((::Depsgraph *)state->graph);
+    const double end_time = PIL_check_seconds_timer();
+    const double time = end_time - start_time;
+    if (BLI_trace_is_enabled()) {
+      BLI_trace_zone_add(node->full_identifier().c_str(), start_time, end_time);
+    }
+    if (state->do_stats) {
+      node->stats.current_time += time;
+      node->stats.current_start_time = start_time;
+      node->stats.current_thread_id = thread_id;
+    }
+    node->stats.average_time = (node->stats.average_time == 0.0) ?
+                                   time :
+                                   (node->stats.average_time * (1.0 - DEG_COST_AVERAGE_FACTOR) +
+                                    time * DEG_COST_AVERAGE_FACTOR);
+    /* Schedule children. */
+    BLI_task_pool_delayed_push_begin(pool, thread_id);
+    node = schedule_children(pool, state->graph, node, thread_id);
+    BLI_task_pool_delayed_push_end(pool, thread_id);
   }
-  /* Schedule children. */
-  BLI_task_pool_delayed_push_begin(pool, thread_id);
-  schedule_children(pool, state->graph, node, thread_id);
-  BLI_task_pool_delayed_push_end(pool, thread_id);
 }
 
 static bool check_operation_node_visible(OperationNode *op_node)
@@ -141,10 +166,73 @@ static void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+/* Whether the operation is to be evaluated, only valid after calculate_pending_parents(). */
+static bool check_operation_node_evaluated(OperationNode *node)
+{
+  return (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) && check_operation_node_visible(node);
+}
+
+static double operation_node_cost(const OperationNode *node)
+{
+  return node->is_noop() ? 0.0 : max_dd(node->stats.average_time, DEG_COST_DEFAULT);
+}
+
+/* Calculate the priority of all operations which are to be evaluated: their own cost plus
+ * the highest priority of the operations depending on them. This is the length of the
+ * longest chain of evaluations which can only start once the operation is done.
+ *
+ * Priorities are calculated from the leaves up, so every relation is only visited once. */
+static void calculate_priorities(Depsgraph *graph)
+{
+  vector<OperationNode *> queue;
+  for (OperationNode *node : graph->operations) {
+    node->num_children_pending = 0;
+    node->priority = 0.0;
+    if (!check_operation_node_evaluated(node)) {
+      continue;
+    }
+    for (Relation *rel : node->outlinks) {
+      OperationNode *child = (OperationNode *)rel->to;
+      if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && check_operation_node_evaluated(child)) {
+        node->num_children_pending++;
+      }
+    }
+    if (node->num_children_pending == 0) {
+      queue.push_back(node);
+    }
+  }
+  while (!queue.empty()) {
+    OperationNode *node = queue.back();
+    queue.pop_back();
+    double priority_children = 0.0;
+    for (Relation *rel : node->outlinks) {
+      const OperationNode *child = (OperationNode *)rel->to;
+      if ((rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+        priority_children = max_dd(priority_children, child->priority);
+      }
+    }
+    node->priority = operation_node_cost(node) + priority_children;
+    for (Relation *rel : node->inlinks) {
+      if (rel->from->type != NodeType::OPERATION || (rel->flag & RELATION_FLAG_CYCLIC)) {
+        continue;
+      }
+      OperationNode *parent = (OperationNode *)rel->from;
+      if (!check_operation_node_evaluated(parent)) {
+        continue;
+      }
+      BLI_assert(parent->num_children_pending > 0);
+      if (--parent->num_children_pending == 0) {
+        queue.push_back(parent);
+      }
+    }
+  }
+}
+
 static void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
+  calculate_priorities(graph);
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
     if (do_stats) {
@@ -153,12 +241,65 @@ static void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
   }
 }
 
+/* Operations which became ready for evaluation, pushed to the task pool by priority. */
+struct ScheduleBatch {
+  OperationNode *nodes[DEG_SCHEDULE_BATCH_SIZE];
+  int num_nodes;
+};
+
+static bool operation_node_priority_cmp(const OperationNode *a, const OperationNode *b)
+{
+  return a->priority > b->priority;
+}
+
+/* Push the operations of the batch, the most expensive chains first. The first pushed task
+ * is the one picked up next by the current thread, so it keeps following the critical path. */
+static void schedule_batch_flush(TaskPool *pool, ScheduleBatch *batch, const int thread_id)
+{
+  std::sort(batch->nodes, batch->nodes + batch->num_nodes, operation_node_priority_cmp);
+  for (int i = 0; i < batch->num_nodes; i++) {
+    BLI_task_pool_push_from_thread(
+        pool, deg_task_run_func, batch->nodes[i], false, TASK_PRIORITY_HIGH, thread_id);
+  }
+  batch->num_nodes = 0;
+}
+
+/* Same as above, except that the operation with the highest priority is returned for the
+ * caller to evaluate, instead of being pushed. */
+static OperationNode *schedule_batch_flush_continue(TaskPool *pool,
+                                                    ScheduleBatch *batch,
+                                                    const int thread_id)
+{
+  if (batch->num_nodes == 0) {
+    return NULL;
+  }
+  std::sort(batch->nodes, batch->nodes + batch->num_nodes, operation_node_priority_cmp);
+  for (int i = 1; i < batch->num_nodes; i++) {
+    BLI_task_pool_push_from_thread(
+        pool, deg_task_run_func, batch->nodes[i], false, TASK_PRIORITY_HIGH, thread_id);
+  }
+  OperationNode *node = batch->nodes[0];
+  batch->num_nodes = 0;
+  return node;
+}
+
+static void schedule_children_batch(TaskPool *pool,
+                                    Depsgraph *graph,
+                                    OperationNode *node,
+                                    ScheduleBatch *batch,
+                                    const int thread_id);
+
 /* Schedule a node if it needs evaluation.
  *   dec_parents: Decrement pending parents count, true when child nodes are
  *                scheduled after a task has been completed.
+ *   batch: Ready nodes are added to it, when NULL they are pushed right away.
  */
-static void schedule_node(
-    TaskPool *pool, Depsgraph *graph, OperationNode *node, bool dec_parents, const int thread_id)
+static void schedule_node(TaskPool *pool,
+                          Depsgraph *graph,
+                          OperationNode *node,
+                          bool dec_parents,
+                          ScheduleBatch *batch,
+                          const int thread_id)
 {
   /* No need to schedule nodes of invisible ID. */
   if (!check_operation_node_visible(node)) {
@@ -193,29 +334,50 @@ static void schedule_node(
   /* Actually schedule the node. */
   bool is_scheduled = atomic_fetch_and_or_uint8((uint8_t *)&node->scheduled, (uint8_t) true);
   if (!is_scheduled) {
+    if (state->do_stats) {
+      node->stats.current_ready_time = PIL_check_seconds_timer();
+    }
     if (node->is_noop()) {
       /* skip NOOP node, schedule children right away */
-      schedule_children(pool, graph, node, thread_id);
+      schedule_children_batch(pool, graph, node, batch, thread_id);
     }
-    else {
-      /* children are scheduled once this task is completed */
+    else if (batch == NULL) {
       BLI_task_pool_push_from_thread(
           pool, deg_task_run_func, node, false, TASK_PRIORITY_HIGH, thread_id);
     }
+    else {
+      /* children are scheduled once this task is completed */
+      if (batch->num_nodes == DEG_SCHEDULE_BATCH_SIZE) {
+        schedule_batch_flush(pool, batch, thread_id);
+      }
+      batch->nodes[batch->num_nodes++] = node;
+    }
   }
 }
 
 static void schedule_graph(TaskPool *pool, Depsgraph *graph)
 {
+  /* Collect the operations which can be evaluated right away. Tasks pushed to a suspended pool
+   * are started in the reverse order, so push the cheapest chains first. */
+  vector<OperationNode *> nodes;
   for (OperationNode *node : graph->operations) {
-    schedule_node(pool, graph, node, false, -1);
+    if (check_operation_node_evaluated(node) && node->num_links_pending == 0) {
+      nodes.push_back(node);
+    }
+  }
+  std::stable_sort(nodes.begin(), nodes.end(), [](const OperationNode *a, const OperationNode *b) {
+    return a->priority < b->priority;
+  });
+  for (OperationNode *node : nodes) {
+    schedule_node(pool, graph, node, false, NULL, -1);
   }
 }
 
-static void schedule_children(TaskPool *pool,
-                              Depsgraph *graph,
-                              OperationNode *node,
-                              const int thread_id)
+static void schedule_children_batch(TaskPool *pool,
+                                    Depsgraph *graph,
+                                    OperationNode *node,
+                                    ScheduleBatch *batch,
+                                    const int thread_id)
 {
   for (Relation *rel : node->outlinks) {
     OperationNode *child = (OperationNode *)rel->to;
@@ -224,10 +386,24 @@ static void schedule_children(TaskPool *pool,
       /* Happens when having cyclic dependencies. */
       continue;
     }
-    schedule_node(pool, graph, child, (rel->flag & RELATION_FLAG_CYCLIC) == 0, thread_id);
+    schedule_node(
+        pool, graph, child, (rel->flag & RELATION_FLAG_CYCLIC) == 0, batch, thread_id);
   }
 }
 
+/* Schedule the children of an evaluated node, the one to evaluate next in the same task is
+ * returned, NULL when no child became ready. */
+static OperationNode *schedule_children(TaskPool *pool,
+                                        Depsgraph *graph,
+                                        OperationNode *node,
+                                        const int thread_id)
+{
+  ScheduleBatch batch;
+  batch.num_nodes = 0;
+  schedule_children_batch(pool, graph, node, &batch, thread_id);
+  return schedule_batch_flush_continue(pool, &batch, thread_id);
+}
+
 static void depsgraph_ensure_view_layer(Depsgraph *graph)
 {
   /* We update copy-on-write scene in the following cases:
@@ -257,12 +433,16 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   }
   const bool do_time_debug = ((G.debug & G_DEBUG_DEPSGRAPH_TIME) != 0);
   const double start_time = do_time_debug ? PIL_check_seconds_timer() : 0;
+  BLI_TRACE_ZONE_BEGIN(evaluate);
   graph->is_evaluating = true;
   depsgraph_ensure_view_layer(graph);
   /* Set up evaluation state. */
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = do_time_debug;
+  if (state.do_stats) {
+    graph->stats_eval_start_time = start_time;
+  }
   /* Set up task scheduler and pull for threaded evaluation. */
   TaskScheduler *task_scheduler;
   bool need_free_scheduler;
@@ -291,14 +471,18 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    * operation timing here, without aggregating anything to avoid any extra
    * synchronization. */
   if (state.do_stats) {
+    graph->stats_eval_end_time = PIL_check_seconds_timer();
     deg_eval_stats_aggregate(graph);
   }
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
+  /* Nothing can be using scratch memory of operations anymore. */
+  BLI_memarena_threaded_clear(graph->scratch_arena);
   if (need_free_scheduler) {
     BLI_task_scheduler_free(task_scheduler);
   }
   graph->is_evaluating = false;
+  BLI_TRACE_ZONE_END(evaluate, "Depsgraph Evaluate");
   if (do_time_debug) {
     printf("Depsgraph updated in %f seconds.\n", PIL_check_seconds_timer() - start_time);
   }
@@ -41,6 +41,7 @@
 #include "BLI_string.h"
 
 #include "BKE_curve.h"
+#include "BKE_customdata.h"
 #include "BKE_global.h"
 #include "BKE_idprop.h"
 #include "BKE_layer.h"
@@ -57,6 +58,7 @@ extern "C" {
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
 #include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
@@ -277,7 +279,7 @@ struct ValidateData {
 
 /* Similar to generic BKE_id_copy() but does not require main and assumes pointer
  * is already allocated. */
-bool id_copy_inplace_no_main(const ID *id, ID *newid)
+bool id_copy_inplace_no_main(const ID *id, ID *newid, const int extra_flag = 0)
 {
   const ID *id_for_copy = id;
 
@@ -286,8 +288,10 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
   id_for_copy = nested_id_hack_get_discarded_pointers(&id_hack_storage, id);
 #endif
 
-  bool result = BKE_id_copy_ex(
-      NULL, (ID *)id_for_copy, &newid, (LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE));
+  bool result = BKE_id_copy_ex(NULL,
+                               (ID *)id_for_copy,
+                               &newid,
+                               (LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE | extra_flag));
 
 #ifdef NESTED_ID_NASTY_WORKAROUND
   if (result) {
@@ -298,6 +302,24 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
   return result;
 }
 
+/* Similar to id_copy_inplace_no_main(), but the copied mesh references custom
+ * data layers of the original one instead of duplicating them, so a CoW update
+ * does not copy all the geometry.
+ *
+ * Vertices are the exception: vertex normals are stored in them and written
+ * by the evaluation, so an own copy of them is made. Everything else is only
+ * read by the evaluation, which duplicates referenced layers before modifying
+ * them. */
+bool mesh_copy_inplace_no_main(const Mesh *mesh, Mesh *new_mesh)
+{
+  if (!id_copy_inplace_no_main(&mesh->id, &new_mesh->id, LIB_ID_COPY_CD_REFERENCE)) {
+    return false;
+  }
+  new_mesh->mvert = (MVert *)CustomData_duplicate_referenced_layer(
+      &new_mesh->vdata, CD_MVERT, new_mesh->totvert);
+  return true;
+}
+
 /* Similar to BKE_scene_copy() but does not require main and assumes pointer
  * is already allocated. */
 bool scene_copy_inplace_no_main(const Scene *scene, Scene *new_scene)
@@ -873,8 +895,6 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph,
   }
   // BLI_assert(check_datablock_expanded(id_cow) == false);
   /* Copy data from original ID to a copied version. */
-  /* TODO(sergey): Avoid doing full ID copy somehow, make Mesh to reference
-   * original geometry arrays for until those are modified. */
   /* TODO(sergey): We do some trickery with temp bmain and extra ID pointer
    * just to be able to use existing API. Ideally we need to replace this with
    * in-place copy from existing datablock to a prepared memory.
@@ -898,8 +918,13 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph,
       break;
     }
     case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
+      /* Only the active depsgraph is evaluated and used on the main thread,
+       * right after original data was modified and tagged. Other depsgraphs,
+       * like the render one, are used from threads while the original mesh
+       * is being edited, so they keep their own copy of the geometry. */
+      if (depsgraph->is_active) {
+        done = mesh_copy_inplace_no_main((Mesh *)id_orig, (Mesh *)id_cow);
+      }
       break;
     }
     default:
@@ -156,6 +156,16 @@ struct Node {
     void reset_current();
     /* Time spend on this node during current graph evaluation. */
     double current_time;
+    /* Moving average of the time spent on this node over the evaluations,
+     * only gathered for operations. */
+    double average_time;
+    /* Timeline of the node during current graph evaluation, only gathered
+     * for operations: when it became ready for evaluation, when it started
+     * being evaluated and by which thread. Start time is zero when the node
+     * was not evaluated. */
+    double current_ready_time;
+    double current_start_time;
+    int current_thread_id;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
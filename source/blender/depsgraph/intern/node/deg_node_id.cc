@@ -160,16 +160,21 @@ void IDNode::destroy()
 
   BLI_ghash_free(components, id_deps_node_hash_key_free, id_deps_node_hash_value_free);
 
-  /* Free memory used by this CoW ID. */
+  destroy_copy_on_write();
+
+  /* Tag that the node is freed. */
+  id_orig = NULL;
+}
+
+/* Free memory used by this CoW ID, keeping the rest of the node intact. */
+void IDNode::destroy_copy_on_write()
+{
   if (id_cow != id_orig && id_cow != NULL) {
     deg_free_copy_on_write_datablock(id_cow);
     MEM_freeN(id_cow);
     id_cow = NULL;
     DEG_COW_PRINT("Destroy CoW for %s: id_orig=%p id_cow=%p\n", id_orig->name, id_orig, id_cow);
   }
-
-  /* Tag that the node is freed. */
-  id_orig = NULL;
 }
 
 string IDNode::identifier() const
@@ -60,6 +60,7 @@ struct IDNode : public Node {
   void init_copy_on_write(ID *id_cow_hint = NULL);
   ~IDNode();
   void destroy();
+  void destroy_copy_on_write();
 
   virtual string identifier() const override;
 
@@ -252,6 +252,12 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated time needed to evaluate this operation and the longest chain of
+   * operations which depend on it. Used to schedule the critical path first. */
+  double priority;
+  /* How many outlinks still need their priority calculated. */
+  uint32_t num_children_pending;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -173,6 +173,10 @@ void DRW_deferred_shader_remove(struct GPUMaterial *mat);
 struct DrawDataList *DRW_drawdatalist_from_id(struct ID *id);
 void DRW_drawdata_free(struct ID *id);
 
+/* Write the timings of the last profiled viewport frame in the Trace Event format.
+ * Profiling is enabled with the debug values 21 to 29. */
+bool DRW_stats_trace_write(const char *filepath);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,8 @@
 
 #include "DRW_render.h"
 
+#include "GPU_vertex_buffer.h"
+
 #include "eevee_private.h"
 #include "eevee_lightcache.h"
 
@@ -34,6 +36,8 @@ void EEVEE_view_layer_data_free(void *storage)
   /* Lights */
   MEM_SAFE_FREE(sldata->lights);
   DRW_UBO_FREE_SAFE(sldata->light_ubo);
+  DRW_TEXTURE_FREE_SAFE(sldata->light_cluster_tx);
+  GPU_VERTBUF_DISCARD_SAFE(sldata->light_cluster_vbo);
   DRW_UBO_FREE_SAFE(sldata->shadow_ubo);
   GPU_FRAMEBUFFER_FREE_SAFE(sldata->shadow_fb);
   DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
@@ -207,6 +207,9 @@ static void eevee_draw_background(void *vedata)
     loop_len = MAX2(1, scene->eevee.taa_samples);
   }
 
+  /* The sub-pixel jitter of the samples is negligible compared to the cluster size. */
+  EEVEE_lights_cluster_update(sldata, DRW_view_default_get());
+
   while (loop_len--) {
     float clear_col[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float clear_depth = 1.0f;
@@ -150,6 +150,8 @@ typedef struct EEVEE_LightBake {
   int cube_offset;
   /** Pointer to the owner_id of the probe object. */
   LightProbe **cube_prb;
+  /** Cube data of the previous bake, used to skip the probes that did not change. */
+  EEVEE_LightProbe *cube_prev;
 
   /* Dummy Textures */
   struct GPUTexture *dummy_color, *dummy_depth;
@@ -525,6 +527,13 @@ static void eevee_lightbake_create_resources(EEVEE_LightBake *lbake)
     eevee->light_cache = lbake->lcache;
   }
 
+  /* Keep the layout of the previous bake to only re-render the cubemaps that changed.
+   * A valid cache always contains all of its cubemaps. */
+  MEM_SAFE_FREE(lbake->cube_prev);
+  if (!lbake->own_light_cache && (lbake->lcache->flag & LIGHTCACHE_BAKED)) {
+    lbake->cube_prev = MEM_dupallocN(lbake->lcache->cube_data);
+  }
+
   EEVEE_lightcache_load(eevee->light_cache);
 
   lbake->lcache->flag |= LIGHTCACHE_BAKING;
@@ -640,6 +649,7 @@ void EEVEE_lightbake_job_data_free(void *custom_data)
 
   MEM_SAFE_FREE(lbake->cube_prb);
   MEM_SAFE_FREE(lbake->grid_prb);
+  MEM_SAFE_FREE(lbake->cube_prev);
 
   BLI_mutex_free(lbake->mutex);
 
@@ -1146,6 +1156,37 @@ void EEVEE_lightbake_update(void *custom_data)
   DEG_id_tag_update(&scene_orig->id, ID_RECALC_COPY_ON_WRITE);
 }
 
+/* Returns false if the cubemap stored at the same layer by the previous bake is still valid. */
+static bool eevee_lightbake_cube_is_dirty(EEVEE_LightBake *lbake)
+{
+  if (lbake->cube_prev == NULL) {
+    return true;
+  }
+  return memcmp(lbake->cube, &lbake->cube_prev[lbake->cube_offset], sizeof(EEVEE_LightProbe)) != 0;
+}
+
+/* Keep the previous result of the current cubemap as if it was rendered. */
+static bool lightbake_skip_cube_sample(EEVEE_LightBake *lbake)
+{
+  if (G.is_break == true || *lbake->stop) {
+    return false;
+  }
+
+  LightCache *lcache = lbake->lcache;
+
+  lcache->cube_len += 1;
+
+  if (lbake->cube_offset == lbake->cube_len - 1) {
+    lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
+  }
+
+  lbake->done += 1;
+  *lbake->progress = lbake->done / (float)lbake->total;
+  *lbake->do_update = 1;
+
+  return true;
+}
+
 static bool lightbake_do_sample(EEVEE_LightBake *lbake,
                                 void (*render_callback)(void *ved, void *user_data))
 {
@@ -1202,6 +1243,12 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     PIL_sleep_ms(lbake->delay);
   }
 
+  /* Cubemaps only need to be re-rendered if their own data changed, unless the lighting they
+   * capture is updated by this bake too. */
+  if (lcache->flag & (LIGHTCACHE_UPDATE_WORLD | LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_FULL)) {
+    MEM_SAFE_FREE(lbake->cube_prev);
+  }
+
   /* Render world irradiance and reflection first */
   if (lcache->flag & LIGHTCACHE_UPDATE_WORLD) {
     lbake->probe = NULL;
@@ -1234,6 +1281,10 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
+      if (!eevee_lightbake_cube_is_dirty(lbake)) {
+        lightbake_skip_cube_sample(lbake);
+        continue;
+      }
       lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
     }
   }
@@ -1245,7 +1296,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
   eevee_lightbake_context_disable(lbake);
 
   lcache->flag |= LIGHTCACHE_BAKED;
-  lcache->flag &= ~LIGHTCACHE_BAKING;
+  lcache->flag &= ~(LIGHTCACHE_BAKING | LIGHTCACHE_UPDATE_FULL);
 
   /* Assume that if lbake->gl_context is NULL
    * we are not running in this in a job, so update
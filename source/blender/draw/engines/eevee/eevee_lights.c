@@ -26,8 +26,13 @@
 
 #include "DEG_depsgraph_query.h"
 
+#include "GPU_texture.h"
+#include "GPU_vertex_buffer.h"
+
 #include "eevee_private.h"
 
+static void light_cluster_buffer_ensure(EEVEE_ViewLayerData *sldata);
+
 /* Reconstruct local obmat from EEVEE_light. (normalized) */
 void eevee_light_matrix_get(const EEVEE_Light *evli, float r_mat[4][4])
 {
@@ -175,6 +180,7 @@ void EEVEE_lights_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   EEVEE_LightsInfo *linfo = sldata->lights;
   linfo->num_light = 0;
 
+  light_cluster_buffer_ensure(sldata);
   EEVEE_shadows_cache_init(sldata, vedata);
 }
 
@@ -218,3 +224,155 @@ void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
   EEVEE_shadows_update(sldata, vedata);
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Light Clusters
+ *
+ * The camera view is divided in a froxel grid, depth slices are distributed logarithmically in
+ * perspective views. Each cell stores the bitmask of the lights whose influence sphere overlaps
+ * it, so surface shading only evaluates the lights that can reach the fragment.
+ * \{ */
+
+BLI_STATIC_ASSERT(MAX_LIGHT % 32 == 0, "Light cluster masks are made of 32 bit words")
+
+/* The buffer texture is bound to every surface shader, create it even if no view is culled
+ * (light baking), shaders evaluate all lights as long as the clusters are disabled. */
+static void light_cluster_buffer_ensure(EEVEE_ViewLayerData *sldata)
+{
+  if (sldata->light_cluster_tx != NULL) {
+    return;
+  }
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    GPU_vertformat_attr_add(&format, "mask", GPU_COMP_U32, LIGHT_CLUSTER_WORDS, GPU_FETCH_INT);
+  }
+  sldata->light_cluster_vbo = GPU_vertbuf_create_with_format_ex(&format, GPU_USAGE_DYNAMIC);
+  GPU_vertbuf_data_alloc(sldata->light_cluster_vbo, LIGHT_CLUSTER_LEN);
+  GPU_vertbuf_attr_fill(sldata->light_cluster_vbo, 0, sldata->lights->cluster_masks);
+  GPU_vertbuf_use(sldata->light_cluster_vbo);
+  sldata->light_cluster_tx = GPU_texture_create_from_vertbuf(sldata->light_cluster_vbo);
+}
+
+typedef struct LightClusterParams {
+  float viewmat[4][4], winmat[4][4];
+  float near, far;
+  float depth_scale, depth_bias;
+  bool is_persp;
+} LightClusterParams;
+
+static int light_cluster_slice_get(const LightClusterParams *params, float dist)
+{
+  dist = clamp_f(dist, params->near, params->far);
+  float slice = (params->is_persp ? logf(dist) : dist) * params->depth_scale + params->depth_bias;
+  return clamp_i((int)slice, 0, LIGHT_CLUSTER_Z - 1);
+}
+
+/* Range of the cells overlapped by the light, returns false if the light is out of the view. */
+static bool light_cluster_bounds_get(const LightClusterParams *params,
+                                     const EEVEE_Light *evli,
+                                     int r_min[3],
+                                     int r_max[3])
+{
+  r_min[0] = r_min[1] = r_min[2] = 0;
+  r_max[0] = LIGHT_CLUSTER_X - 1;
+  r_max[1] = LIGHT_CLUSTER_Y - 1;
+  r_max[2] = LIGHT_CLUSTER_Z - 1;
+
+  if (evli->light_type == LA_SUN) {
+    return true;
+  }
+
+  const float radius = 1.0f / sqrtf(evli->invsqrdist);
+  float center[3];
+  mul_v3_m4v3(center, params->viewmat, evli->position);
+  const float dist_min = -center[2] - radius;
+  const float dist_max = -center[2] + radius;
+  if (dist_max < params->near || dist_min > params->far) {
+    return false;
+  }
+  r_min[2] = light_cluster_slice_get(params, dist_min);
+  r_max[2] = light_cluster_slice_get(params, dist_max);
+
+  /* The projection of the bounding box is unbounded if it crosses the camera plane. */
+  if (params->is_persp && dist_min <= params->near) {
+    return true;
+  }
+
+  float ndc_min[2] = {FLT_MAX, FLT_MAX}, ndc_max[2] = {-FLT_MAX, -FLT_MAX};
+  for (int i = 0; i < 8; i++) {
+    float corner[4] = {
+        center[0] + ((i & 1) ? radius : -radius),
+        center[1] + ((i & 2) ? radius : -radius),
+        center[2] + ((i & 4) ? radius : -radius),
+        1.0f,
+    };
+    mul_m4_v4(params->winmat, corner);
+    const float w = max_ff(corner[3], 1e-8f);
+    minmax_v2v2_v2(ndc_min, ndc_max, (const float[2]){corner[0] / w, corner[1] / w});
+  }
+  if (ndc_max[0] < -1.0f || ndc_max[1] < -1.0f || ndc_min[0] > 1.0f || ndc_min[1] > 1.0f) {
+    return false;
+  }
+  const int grid_size[2] = {LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y};
+  for (int i = 0; i < 2; i++) {
+    r_min[i] = clamp_i((int)((ndc_min[i] * 0.5f + 0.5f) * grid_size[i]), 0, grid_size[i] - 1);
+    r_max[i] = clamp_i((int)((ndc_max[i] * 0.5f + 0.5f) * grid_size[i]), 0, grid_size[i] - 1);
+  }
+  return true;
+}
+
+/* Cull the lights of the last cache against the given view, has to be called before drawing the
+ * surfaces with this view. Other views (probes, shadows) evaluate all lights. */
+void EEVEE_lights_cluster_update(EEVEE_ViewLayerData *sldata, const DRWView *view)
+{
+  EEVEE_LightsInfo *linfo = sldata->lights;
+  EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
+
+  LightClusterParams params;
+  DRW_view_viewmat_get(view, params.viewmat, false);
+  DRW_view_winmat_get(view, params.winmat, false);
+  params.is_persp = DRW_view_is_persp_get(view);
+  /* View space Z is negative in front of the camera. */
+  params.near = -DRW_view_near_distance_get(view);
+  params.far = -DRW_view_far_distance_get(view);
+  if (params.is_persp) {
+    params.depth_scale = LIGHT_CLUSTER_Z / logf(params.far / params.near);
+    params.depth_bias = -logf(params.near) * params.depth_scale;
+  }
+  else {
+    params.depth_scale = LIGHT_CLUSTER_Z / (params.far - params.near);
+    params.depth_bias = -params.near * params.depth_scale;
+  }
+
+  memset(linfo->cluster_masks, 0, sizeof(linfo->cluster_masks));
+  for (int i = 0; i < linfo->num_light; i++) {
+    int min[3], max[3];
+    if (!light_cluster_bounds_get(&params, &linfo->light_data[i], min, max)) {
+      continue;
+    }
+    const uint word = i / 32, bit = 1u << (i % 32);
+    for (int z = min[2]; z <= max[2]; z++) {
+      for (int y = min[1]; y <= max[1]; y++) {
+        uint(*cell)[LIGHT_CLUSTER_WORDS] = &linfo->cluster_masks[(z * LIGHT_CLUSTER_Y + y) *
+                                                                  LIGHT_CLUSTER_X];
+        for (int x = min[0]; x <= max[0]; x++) {
+          cell[x][word] |= bit;
+        }
+      }
+    }
+  }
+
+  GPU_vertbuf_attr_fill(sldata->light_cluster_vbo, 0, linfo->cluster_masks);
+  /* Upload now, the texture only references the buffer. */
+  GPU_vertbuf_use(sldata->light_cluster_vbo);
+
+  const float *viewport_size = DRW_viewport_size_get();
+  common_data->la_cluster_toggle = true;
+  common_data->la_cluster_depth_bias = params.depth_bias;
+  common_data->la_cluster_scale[0] = LIGHT_CLUSTER_X / viewport_size[0];
+  common_data->la_cluster_scale[1] = LIGHT_CLUSTER_Y / viewport_size[1];
+  common_data->la_cluster_scale[2] = params.depth_scale;
+  common_data->la_cluster_scale[3] = params.is_persp ? 1.0f : 0.0f;
+}
+
+/** \} */
@@ -47,6 +47,13 @@ extern struct DrawEngineType draw_engine_eevee_type;
 #define MAX_SHADOW_CUBE (MAX_SHADOW - MAX_CASCADE_NUM * MAX_SHADOW_CASCADE)
 #define MAX_BLOOM_STEP 16
 
+/* Froxel grid the lights are culled against, each cell stores a bitmask of MAX_LIGHT bits. */
+#define LIGHT_CLUSTER_X 16
+#define LIGHT_CLUSTER_Y 16
+#define LIGHT_CLUSTER_Z 24
+#define LIGHT_CLUSTER_LEN (LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z)
+#define LIGHT_CLUSTER_WORDS (MAX_LIGHT / 32)
+
 // #define DEBUG_SHADOW_DISTRIBUTION
 
 /* Only define one of these. */
@@ -75,6 +82,9 @@ extern struct DrawEngineType draw_engine_eevee_type;
   "#define MAX_SHADOW_CUBE " STRINGIFY(MAX_SHADOW_CUBE) "\n" \
   "#define MAX_SHADOW_CASCADE " STRINGIFY(MAX_SHADOW_CASCADE) "\n" \
   "#define MAX_CASCADE_NUM " STRINGIFY(MAX_CASCADE_NUM) "\n" \
+  "#define LIGHT_CLUSTER_X " STRINGIFY(LIGHT_CLUSTER_X) "\n" \
+  "#define LIGHT_CLUSTER_Y " STRINGIFY(LIGHT_CLUSTER_Y) "\n" \
+  "#define LIGHT_CLUSTER_Z " STRINGIFY(LIGHT_CLUSTER_Z) "\n" \
   SHADER_IRRADIANCE
 /* clang-format on */
 
@@ -402,6 +412,11 @@ typedef struct EEVEE_ShadowCascadeRender {
   float cascade_exponent;
   float cascade_fade;
   int cascade_count;
+  /* Matrices and layer the shadow map was last rendered with. Used to reuse it if the view,
+   * the light and the shadow casters did not change. */
+  float cached_projmat[MAX_CASCADE_NUM][4][4];
+  float cached_viewmat[4][4];
+  int cached_tex_id;
 } EEVEE_ShadowCascadeRender;
 
 BLI_STATIC_ASSERT_ALIGN(EEVEE_Light, 16)
@@ -442,6 +457,11 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Faces of the shadow cubes touched by a shadow caster update. */
+  BLI_bitmap sh_cube_face_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE * 6)];
+  BLI_bitmap sh_cascade_update[BLI_BITMAP_SIZE(MAX_SHADOW_CASCADE)];
+  /* Bitmask of the lights reaching each cell of the froxel grid of the camera view. */
+  uint cluster_masks[LIGHT_CLUSTER_LEN][LIGHT_CLUSTER_WORDS];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds  */
   /* List of bbox and update bitmap. Double buffered. */
@@ -675,8 +695,11 @@ typedef struct EEVEE_CommonUniformBuffer {
   float ray_depth;         /* float */
   float alpha_hash_offset; /* float */
   float alpha_hash_scale;  /* float */
-  float pad7;              /* float */
-  float pad8;              /* float */
+  /* Light clusters */
+  int la_cluster_toggle;       /* bool */
+  float la_cluster_depth_bias; /* float */
+  /* -- 16 byte aligned -- */
+  float la_cluster_scale[4]; /* vec4 */
 } EEVEE_CommonUniformBuffer;
 
 BLI_STATIC_ASSERT_ALIGN(EEVEE_CommonUniformBuffer, 16)
@@ -693,6 +716,8 @@ typedef struct EEVEE_ViewLayerData {
   struct EEVEE_LightsInfo *lights;
 
   struct GPUUniformBuffer *light_ubo;
+  struct GPUVertBuf *light_cluster_vbo;
+  struct GPUTexture *light_cluster_tx;
   struct GPUUniformBuffer *shadow_ubo;
   struct GPUUniformBuffer *shadow_samples_ubo;
 
@@ -867,6 +892,7 @@ void eevee_light_matrix_get(const EEVEE_Light *evli, float r_mat[4][4]);
 void EEVEE_lights_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_lights_cache_add(EEVEE_ViewLayerData *sldata, struct Object *ob);
 void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
+void EEVEE_lights_cluster_update(EEVEE_ViewLayerData *sldata, const struct DRWView *view);
 
 /* eevee_shadows.c */
 void eevee_contact_shadow_setup(const Light *la, EEVEE_Shadow *evsh);
@@ -886,6 +912,9 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, struct Object *o
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct Object *ob);
 bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli, int sample_ofs);
+void EEVEE_shadows_cube_caster_tag(EEVEE_LightsInfo *linfo,
+                                   int cube_index,
+                                   const struct EEVEE_BoundBox *bbox);
 void EEVEE_shadows_cascade_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct Object *ob);
 void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, struct DRWView *view);
 void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, int cube_index);
@@ -291,6 +291,8 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 
   if (!sldata->shadow_cascade_pool) {
+    /* Update all cascades. */
+    BLI_bitmap_set_all(&linfo->sh_cascade_update[0], true, MAX_SHADOW_CASCADE);
     sldata->shadow_cascade_pool = DRW_texture_create_2d_array(linfo->shadow_cascade_size,
                                                               linfo->shadow_cascade_size,
                                                               max_ii(1, linfo->num_cascade_layer),
@@ -315,14 +317,16 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   /* TODO(fclem) This part can be slow, optimize it. */
   EEVEE_BoundBox *bbox = backbuffer->bbox;
   BoundSphere *bsphere = linfo->shadow_bounds;
+  bool any_caster_update = false;
   /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadowcaster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
+      any_caster_update = true;
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+            EEVEE_shadows_cube_caster_tag(linfo, j, &bbox[i]);
           }
         }
       }
@@ -333,15 +337,20 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < frontbuffer->count; i++) {
     /* If the shadowcaster has been updated. */
     if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
+      any_caster_update = true;
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+            EEVEE_shadows_cube_caster_tag(linfo, j, &bbox[i]);
           }
         }
       }
     }
   }
+  /* Cascades cover the whole view, any caster update can affect them. */
+  if (any_caster_update) {
+    BLI_bitmap_set_all(&linfo->sh_cascade_update[0], true, MAX_SHADOW_CASCADE);
+  }
 
   /* Resize shcasters buffers if too big. */
   if (frontbuffer->alloc_count - frontbuffer->count > SH_CASTER_ALLOC_CHUNK) {
@@ -381,7 +390,14 @@ void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView
   DRW_stats_group_start("Cube Shadow Maps");
   {
     for (int cube = 0; cube < linfo->cube_len; cube++) {
-      if (BLI_BITMAP_TEST(cube_visible, cube) && BLI_BITMAP_TEST(linfo->sh_cube_update, cube)) {
+      if (!BLI_BITMAP_TEST(cube_visible, cube)) {
+        continue;
+      }
+      bool update = BLI_BITMAP_TEST(linfo->sh_cube_update, cube);
+      for (int j = 0; j < 6 && !update; j++) {
+        update = BLI_BITMAP_TEST(linfo->sh_cube_face_update, cube * 6 + j);
+      }
+      if (update) {
         EEVEE_shadows_draw_cubemap(sldata, vedata, cube);
       }
     }
@@ -40,6 +40,20 @@ void EEVEE_shadows_cascade_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, Objec
   EEVEE_ShadowCascade *csm_data = linfo->shadow_cascade_data + linfo->cascade_len;
   EEVEE_ShadowCascadeRender *csm_render = linfo->shadow_cascade_render + linfo->cascade_len;
 
+  /* Same as cube shadows, dupli lights are always updated. */
+  bool update = (ob->base_flag & BASE_FROM_DUPLI) != 0;
+  if (!update) {
+    EEVEE_LightEngineData *led = EEVEE_light_data_ensure(ob);
+    if (led->need_update) {
+      update = true;
+      led->need_update = false;
+    }
+  }
+
+  if (update) {
+    BLI_BITMAP_ENABLE(&linfo->sh_cascade_update[0], linfo->cascade_len);
+  }
+
   sh_data->bias = max_ff(la->bias * 0.00002f, 0.0f);
   eevee_contact_shadow_setup(la, sh_data);
 
@@ -419,6 +433,23 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
 
   eevee_shadow_cascade_setup(linfo, evli, view, near, far, effects->taa_current_sample - 1);
 
+  /* Keep the previous shadow map if nothing it depends on changed. Cascades follow the view
+   * so this only happens while the view is still (and without soft shadows jitter). */
+  if (!BLI_BITMAP_TEST(linfo->sh_cascade_update, cascade_index) &&
+      (csm_render->cached_tex_id == (int)csm_data->tex_id) &&
+      (memcmp(csm_render->cached_viewmat, csm_render->viewmat, sizeof(float[4][4])) == 0) &&
+      (memcmp(csm_render->cached_projmat,
+              csm_render->projmat,
+              sizeof(float[4][4]) * csm_render->cascade_count) == 0)) {
+    return;
+  }
+  BLI_BITMAP_SET(&linfo->sh_cascade_update[0], cascade_index, false);
+  csm_render->cached_tex_id = (int)csm_data->tex_id;
+  copy_m4_m4(csm_render->cached_viewmat, csm_render->viewmat);
+  memcpy(csm_render->cached_projmat,
+         csm_render->projmat,
+         sizeof(float[4][4]) * csm_render->cascade_count);
+
   /* Meh, Reusing the cube views. */
   BLI_assert(MAX_CASCADE_NUM <= 6);
   eevee_ensure_cascade_views(csm_render, g_data->cube_views);
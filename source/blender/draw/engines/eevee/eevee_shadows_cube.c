@@ -136,6 +136,57 @@ bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli,
   return update;
 }
 
+/* Tag the faces of the shadow cube that can see the given shadow caster bounds.
+ * Needs EEVEE_shadows_cube_setup to have been called for this cube. */
+void EEVEE_shadows_cube_caster_tag(EEVEE_LightsInfo *linfo,
+                                   int cube_index,
+                                   const EEVEE_BoundBox *bbox)
+{
+  const EEVEE_Light *evli = linfo->light_data + linfo->shadow_cube_light_indices[cube_index];
+  const EEVEE_Shadow *shdw_data = linfo->shadow_data + (int)evli->shadow_id;
+  const EEVEE_ShadowCube *cube_data = linfo->shadow_cube_data + (int)shdw_data->type_data_id;
+
+  /* Faces are rendered a bit wider than 90 degrees (see eevee_ensure_cube_views) and are
+   * randomly rotated by up to two texels for soft shadows. */
+  const float margin = 3.0f * DEG2RADF(90.0f) / (float)linfo->shadow_cube_size;
+  if (margin >= (float)M_PI_4) {
+    for (int j = 0; j < 6; j++) {
+      BLI_BITMAP_ENABLE(&linfo->sh_cube_face_update[0], cube_index * 6 + j);
+    }
+    return;
+  }
+  const float slope = tanf((float)M_PI_4 + margin);
+
+  /* Bounds in light space. */
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  for (int i = 0; i < 8; i++) {
+    float corner[3];
+    for (int a = 0; a < 3; a++) {
+      corner[a] = bbox->center[a] + ((i & (1 << a)) ? bbox->halfdim[a] : -bbox->halfdim[a]);
+    }
+    mul_m4_v3(cube_data->shadowmat, corner);
+    minmax_v3v3_v3(min, max, corner);
+  }
+
+  /* Distance from the light to the bounds along each axis, zero if they straddle it. */
+  float dist[3];
+  for (int a = 0; a < 3; a++) {
+    dist[a] = (min[a] > 0.0f) ? min[a] : ((max[a] < 0.0f) ? -max[a] : 0.0f);
+  }
+
+  /* Face order matches cubefacemat: +X, -X, +Y, -Y, +Z, -Z. */
+  for (int a = 0; a < 3; a++) {
+    const float dist_side = max_ff(dist[(a + 1) % 3], dist[(a + 2) % 3]);
+    if (max[a] * slope >= dist_side) {
+      BLI_BITMAP_ENABLE(&linfo->sh_cube_face_update[0], cube_index * 6 + a * 2);
+    }
+    if (-min[a] * slope >= dist_side) {
+      BLI_BITMAP_ENABLE(&linfo->sh_cube_face_update[0], cube_index * 6 + a * 2 + 1);
+    }
+  }
+}
+
 static void eevee_ensure_cube_views(
     float near, float far, int cube_res, const float viewmat[4][4], DRWView *view[6])
 {
@@ -209,6 +260,11 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
     if (evli->light_type != LA_LOCAL && j == 4) {
       continue;
     }
+    /* Only the faces seeing an updated shadow caster need to be re-rendered. */
+    if (!BLI_BITMAP_TEST(linfo->sh_cube_update, cube_index) &&
+        !BLI_BITMAP_TEST(linfo->sh_cube_face_update, cube_index * 6 + j)) {
+      continue;
+    }
     /* TODO(fclem) some cube sides can be invisible in the main views. Cull them. */
     // if (frustum_intersect(g_data->cube_views[j], main_view))
     //   continue;
@@ -222,4 +278,7 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
   }
 
   BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+  for (int j = 0; j < 6; j++) {
+    BLI_BITMAP_SET(&linfo->sh_cube_face_update[0], cube_index * 6 + j, false);
+  }
 }
@@ -45,8 +45,10 @@ layout(std140) uniform common_block
   float rayDepth;
   float alphaHashOffset;
   float alphaHashScale;
-  float pad7;
-  float pad8;
+  /* Light clusters */
+  bool laClusterToggle;
+  float laClusterDepthBias;
+  vec4 laClusterScale;
 };
 
 /* rayType (keep in sync with ray_type) */
@@ -55,6 +57,11 @@ layout(std140) uniform common_block
 #define EEVEE_RAY_DIFFUSE 2
 #define EEVEE_RAY_GLOSSY 3
 
+/* laClusterScale */
+#define laClusterTileScale laClusterScale.xy
+#define laClusterDepthScale laClusterScale.z
+#define laClusterIsPersp (laClusterScale.w != 0.0)
+
 /* aoParameters */
 #define aoDistance aoParameters[0].x
 #define aoSamples aoParameters[0].y /* UNUSED */
@@ -33,6 +33,48 @@ vec3 clip_to_aabb(vec3 color, vec3 minimum, vec3 maximum, vec3 average)
   return center + dist * t;
 }
 
+/**
+ * Bicubic Catmull-Rom filtering of the history, keeps it sharp while it is reprojected over many
+ * frames. Uses 5 bilinear taps by ignoring the corner texels, see
+ * "Filmic SMAA: Sharp Morphological and Temporal Antialiasing" by Jorge Jimenez.
+ */
+vec4 history_sample_catmull_rom(sampler2D tex, vec2 uv, vec2 tex_size)
+{
+  vec2 sample_pos = uv * tex_size;
+  vec2 tex_pos1 = floor(sample_pos - 0.5) + 0.5;
+  vec2 f = sample_pos - tex_pos1;
+
+  vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+  vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+  vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+  vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+  /* Merge the two middle taps into one bilinear tap. */
+  vec2 w12 = w1 + w2;
+  vec2 uv0 = (tex_pos1 - 1.0) / tex_size;
+  vec2 uv3 = (tex_pos1 + 2.0) / tex_size;
+  vec2 uv12 = (tex_pos1 + w2 / w12) / tex_size;
+
+  float weight_top = w12.x * w0.y;
+  float weight_left = w0.x * w12.y;
+  float weight_center = w12.x * w12.y;
+  float weight_right = w3.x * w12.y;
+  float weight_bottom = w12.x * w3.y;
+
+  vec4 color = textureLod(tex, vec2(uv12.x, uv0.y), 0.0) * weight_top;
+  color += textureLod(tex, vec2(uv0.x, uv12.y), 0.0) * weight_left;
+  color += textureLod(tex, uv12, 0.0) * weight_center;
+  color += textureLod(tex, vec2(uv3.x, uv12.y), 0.0) * weight_right;
+  color += textureLod(tex, vec2(uv12.x, uv3.y), 0.0) * weight_bottom;
+
+  /* Renormalize for the skipped corners. */
+  return color / (weight_top + weight_left + weight_center + weight_right + weight_bottom);
+}
+
+/* Size of the neighborhood color distribution box in standard deviations. Tighter than the
+ * min/max box, which reduces ghosting and the flickering of isolated bright pixels. */
+#define VARIANCE_CLIP_GAMMA 1.25
+
 /**
  * Vastly based on https://github.com/playdeadgames/temporal
  */
@@ -49,8 +91,9 @@ void main()
   vec2 uv = gl_FragCoord.xy / screen_res;
   vec2 uv_history = uv - motion;
 
-  ivec2 texel_history = ivec2(uv_history * screen_res);
-  vec4 color_history = textureLod(colorHistoryBuffer, uv_history, 0.0);
+  vec4 color_history = history_sample_catmull_rom(colorHistoryBuffer, uv_history, screen_res);
+  /* Catmull-Rom can overshoot. */
+  color_history = safe_color(color_history);
 
   /* Color bounding box clamping. 3x3 neighborhood. */
   vec4 c02 = texelFetchOffset(colorBuffer, texel, 0, ivec2(-1, 1));
@@ -78,6 +121,23 @@ void main()
   max_col = (max_col + max_center) * 0.5;
   avg_col = (avg_col + avg_center) * 0.5;
 
+  /* Variance clipping: intersect with the box of the neighborhood color distribution. It is
+   * centered on the rounded average which is always inside the min/max box, so the intersection
+   * is never empty. */
+  vec4 mean_sqr = avg9(c02 * c02,
+                       c12 * c12,
+                       c22 * c22,
+                       c01 * c01,
+                       c11 * c11,
+                       c21 * c21,
+                       c00 * c00,
+                       c10 * c10,
+                       c20 * c20);
+  vec4 mean_col = avg9(c02, c12, c22, c01, c11, c21, c00, c10, c20);
+  vec4 deviation = sqrt(abs(mean_sqr - mean_col * mean_col)) * VARIANCE_CLIP_GAMMA;
+  min_col = max(min_col, avg_col - deviation);
+  max_col = min(max_col, avg_col + deviation);
+
   /* Clip color toward the center of the neighborhood colors AABB box. */
   color_history.rgb = clip_to_aabb(color_history.rgb, min_col.rgb, max_col.rgb, avg_col.rgb);
 
@@ -16,6 +16,9 @@ layout(std140) uniform light_block
   LightData lights_data[MAX_LIGHT];
 };
 
+/* Bitmask of the lights reaching each froxel of the camera view. */
+uniform usamplerBuffer lightClusterBuf;
+
 /* type */
 #define POINT 0.0
 #define SUN 1.0
@@ -24,6 +27,26 @@ layout(std140) uniform light_block
 /* Used to define the area light shape, doesn't directly correspond to a Blender light type. */
 #define AREA_ELLIPSE 100.0
 
+/* Returns the mask of the lights which can affect the fragment.
+ * Views other than the camera are not culled and get all lights. */
+uvec4 light_cluster_mask_get(vec2 frag_co, float view_z)
+{
+  if (!laClusterToggle || rayType != EEVEE_RAY_CAMERA) {
+    return uvec4(~0u);
+  }
+  float dist = max(-view_z, 1e-8);
+  float slice = (laClusterIsPersp ? log(dist) : dist) * laClusterDepthScale + laClusterDepthBias;
+  ivec3 cell = ivec3(ivec2(frag_co * laClusterTileScale), int(slice));
+  cell = clamp(cell, ivec3(0), ivec3(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y, LIGHT_CLUSTER_Z) - 1);
+  return texelFetch(lightClusterBuf,
+                    (cell.z * LIGHT_CLUSTER_Y + cell.y) * LIGHT_CLUSTER_X + cell.x);
+}
+
+bool light_cluster_test(uvec4 mask, int light_id)
+{
+  return (mask[light_id / 32] & (1u << uint(light_id % 32))) != 0u;
+}
+
 float cubeFaceIndexEEVEE(vec3 P)
 {
   vec3 aP = abs(P);
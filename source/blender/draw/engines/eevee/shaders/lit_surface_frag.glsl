@@ -235,7 +235,13 @@ void CLOSURE_NAME(vec3 N
 
   vec3 true_normal = normalize(cross(dFdx(viewPosition), dFdy(viewPosition)));
 
+  uvec4 cluster_mask = light_cluster_mask_get(gl_FragCoord.xy, viewPosition.z);
+
   for (int i = 0; i < MAX_LIGHT && i < laNumLight; i++) {
+    if (!light_cluster_test(cluster_mask, i)) {
+      continue;
+    }
+
     LightData ld = lights_data[i];
 
     vec4 l_vector; /* Non-Normalized Light Vector with length in last component. */
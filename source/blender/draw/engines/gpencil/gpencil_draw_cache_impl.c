@@ -374,8 +374,105 @@ void gpencil_get_fill_geom(struct GpencilBatchCacheElem *be,
   }
 }
 
+/* Get the values the projection of the buffer points depends on. */
+static void gpencil_buffer_stroke_key_get(GpencilBufferStrokeKey *key,
+                                          const bGPdata *gpd,
+                                          const Object *ob,
+                                          const Scene *scene,
+                                          const ARegion *ar,
+                                          const RegionView3D *rv3d,
+                                          const float origin[3],
+                                          short thickness)
+{
+  const ToolSettings *ts = scene->toolsettings;
+
+  /* keys are compared with memcmp, padding must be cleared */
+  memset(key, 0, sizeof(*key));
+  key->gpd = gpd;
+  key->rv3d = rv3d;
+  copy_m4_m4(key->persmat, rv3d->persmat);
+  if (ob) {
+    copy_m4_m4(key->obmat, ob->obmat);
+  }
+  copy_v3_v3(key->origin, origin);
+  copy_v3_v3(key->cursor_location, scene->cursor.location);
+  copy_v3_v3(key->cursor_rotation, scene->cursor.rotation_euler);
+  copy_v4_v4(key->ink, gpd->runtime.scolor);
+  key->winx = ar->winx;
+  key->winy = ar->winy;
+  key->lock_axis = ts->gp_sculpt.lock_axis;
+  key->align = ts->gpencil_v3d_align;
+  key->thickness = thickness;
+  key->sflag = gpd->runtime.sbuffer_sflag;
+}
+
+/**
+ * Make sure the cached buffer geometry can hold \a totvertex vertices and return the index of the
+ * first buffer point which differs from the points the VBO was filled with. The vertices of the
+ * points before that index are still valid and don't need to be filled again.
+ */
+static int gpencil_buffer_stroke_cache_ensure(GpencilBufferStrokeCache *cache,
+                                              GPUVertFormat *format,
+                                              GPUPrimType prim_type,
+                                              const GpencilBufferStrokeKey *key,
+                                              const tGPspoint *points,
+                                              int totpoints,
+                                              int totvertex)
+{
+  if (cache->vbo == NULL) {
+    cache->vbo = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_DYNAMIC);
+    cache->batch = GPU_batch_create_ex(prim_type, cache->vbo, NULL, GPU_BATCH_OWNS_VBO);
+    cache->points_len = 0;
+  }
+
+  int first_changed = 0;
+  if (memcmp(&cache->key, key, sizeof(*key)) == 0) {
+    /* the operators only append points or modify the last ones (smoothing), so comparing from
+     * the start is cheap compared to projecting everything again */
+    const int len = min_ii(cache->points_len, totpoints);
+    while ((first_changed < len) &&
+           (memcmp(&cache->points[first_changed], &points[first_changed], sizeof(*points)) == 0)) {
+      first_changed++;
+    }
+  }
+  else {
+    cache->key = *key;
+  }
+
+  if (totpoints > cache->points_alloc) {
+    cache->points_alloc = power_of_2_max_i(totpoints);
+    cache->points = MEM_reallocN_id(
+        cache->points, sizeof(*cache->points) * cache->points_alloc, __func__);
+  }
+  memcpy(&cache->points[first_changed],
+         &points[first_changed],
+         sizeof(*points) * (totpoints - first_changed));
+  cache->points_len = totpoints;
+
+  /* grow in blocks so appending points does not reallocate on every redraw */
+  GPUVertBuf *vbo = cache->vbo;
+  if (vbo->data == NULL) {
+    GPU_vertbuf_data_alloc(vbo, power_of_2_max_u(totvertex));
+  }
+  else if (vbo->vertex_alloc < totvertex) {
+    GPU_vertbuf_data_resize(vbo, power_of_2_max_u(totvertex));
+  }
+  GPU_vertbuf_data_len_set(vbo, totvertex);
+
+  return first_changed;
+}
+
+void gpencil_buffer_stroke_cache_free(GpencilBufferStrokeCache *cache)
+{
+  GPU_BATCH_DISCARD_SAFE(cache->batch);
+  MEM_SAFE_FREE(cache->points);
+  memset(cache, 0, sizeof(*cache));
+}
+
 /* create batch geometry data for current buffer stroke shader */
-GPUBatch *gpencil_get_buffer_stroke_geom(bGPdata *gpd, short thickness)
+GPUBatch *gpencil_get_buffer_stroke_geom(GpencilBufferStrokeCache *cache,
+                                         bGPdata *gpd,
+                                         short thickness)
 {
   const DRWContextState *draw_ctx = DRW_context_state_get();
   Scene *scene = draw_ctx->scene;
@@ -387,6 +484,7 @@ GPUBatch *gpencil_get_buffer_stroke_geom(bGPdata *gpd, short thickness)
   tGPspoint *points = gpd->runtime.sbuffer;
   int totpoints = gpd->runtime.sbuffer_used;
   /* if cyclic needs more vertex */
+  const bool is_cyclic = (gpd->runtime.sbuffer_sflag & GP_STROKE_CYCLIC) && (totpoints > 2);
   int cyclic_add = (gpd->runtime.sbuffer_sflag & GP_STROKE_CYCLIC) ? 1 : 0;
   int totvertex = totpoints + cyclic_add + 2;
 
@@ -399,53 +497,37 @@ GPUBatch *gpencil_get_buffer_stroke_geom(bGPdata *gpd, short thickness)
     uvdata_id = GPU_vertformat_attr_add(&format, "uvdata", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
   }
 
-  GPUVertBuf *vbo = GPU_vertbuf_create_with_format(&format);
-  GPU_vertbuf_data_alloc(vbo, totvertex);
-
-  /* draw stroke curve */
-  const tGPspoint *tpt = points;
-  bGPDspoint pt, pt2, pt3;
-  int idx = 0;
-
   /* get origin to reproject point */
   float origin[3];
   bGPDlayer *gpl = BKE_gpencil_layer_getactive(gpd);
   ED_gp_get_drawing_reference(scene, ob, gpl, ts->gpencil_v3d_align, origin);
 
-  for (int i = 0; i < totpoints; i++, tpt++) {
+  GpencilBufferStrokeKey key;
+  gpencil_buffer_stroke_key_get(&key, gpd, ob, scene, ar, rv3d, origin, thickness);
+  int first_changed = gpencil_buffer_stroke_cache_ensure(
+      cache, &format, GPU_PRIM_LINE_STRIP_ADJ, &key, points, totpoints, totvertex);
+  /* the first adjacency point of cyclic strokes depends on the last point */
+  if (is_cyclic) {
+    first_changed = 0;
+  }
+  GPUVertBuf *vbo = cache->vbo;
+
+  /* draw stroke curve, vertex 0 is the first adjacency point */
+  bGPDspoint pt, pt2, pt3;
+
+  /* first point for adjacency (not drawn), only depends on the first two points */
+  if (first_changed <= 1) {
+    ED_gpencil_tpoint_to_point(ar, origin, is_cyclic ? &points[totpoints - 1] : &points[1], &pt2);
+    gpencil_set_stroke_point(
+        vbo, &pt2, 0, pos_id, color_id, thickness_id, uvdata_id, thickness, gpd->runtime.scolor);
+  }
+
+  const tGPspoint *tpt = &points[first_changed];
+  int idx = first_changed + 1;
+  for (int i = first_changed; i < totpoints; i++, tpt++) {
     ED_gpencil_tpoint_to_point(ar, origin, tpt, &pt);
     ED_gp_project_point_to_plane(scene, ob, rv3d, origin, ts->gp_sculpt.lock_axis - 1, &pt);
 
-    /* first point for adjacency (not drawn) */
-    if (i == 0) {
-      if (gpd->runtime.sbuffer_sflag & GP_STROKE_CYCLIC && totpoints > 2) {
-        ED_gpencil_tpoint_to_point(ar, origin, &points[totpoints - 1], &pt2);
-        gpencil_set_stroke_point(vbo,
-                                 &pt2,
-                                 idx,
-                                 pos_id,
-                                 color_id,
-                                 thickness_id,
-                                 uvdata_id,
-                                 thickness,
-                                 gpd->runtime.scolor);
-        idx++;
-      }
-      else {
-        ED_gpencil_tpoint_to_point(ar, origin, &points[1], &pt2);
-        gpencil_set_stroke_point(vbo,
-                                 &pt2,
-                                 idx,
-                                 pos_id,
-                                 color_id,
-                                 thickness_id,
-                                 uvdata_id,
-                                 thickness,
-                                 gpd->runtime.scolor);
-        idx++;
-      }
-    }
-
     /* set point */
     gpencil_set_stroke_point(
         vbo, &pt, idx, pos_id, color_id, thickness_id, uvdata_id, thickness, gpd->runtime.scolor);
@@ -453,7 +535,7 @@ GPUBatch *gpencil_get_buffer_stroke_geom(bGPdata *gpd, short thickness)
   }
 
   /* last adjacency point (not drawn) */
-  if (gpd->runtime.sbuffer_sflag & GP_STROKE_CYCLIC && totpoints > 2) {
+  if (is_cyclic) {
     /* draw line to first point to complete the cycle */
     ED_gpencil_tpoint_to_point(ar, origin, &points[0], &pt2);
     gpencil_set_stroke_point(
@@ -473,11 +555,16 @@ GPUBatch *gpencil_get_buffer_stroke_geom(bGPdata *gpd, short thickness)
     idx++;
   }
 
-  return GPU_batch_create_ex(GPU_PRIM_LINE_STRIP_ADJ, vbo, NULL, GPU_BATCH_OWNS_VBO);
+  /* cyclic strokes with less than three points have an unused vertex */
+  GPU_vertbuf_data_len_set(vbo, idx);
+
+  return cache->batch;
 }
 
 /* create batch geometry data for current buffer point shader */
-GPUBatch *gpencil_get_buffer_point_geom(bGPdata *gpd, short thickness)
+GPUBatch *gpencil_get_buffer_point_geom(GpencilBufferStrokeCache *cache,
+                                        bGPdata *gpd,
+                                        short thickness)
 {
   const DRWContextState *draw_ctx = DRW_context_state_get();
   Scene *scene = draw_ctx->scene;
@@ -499,20 +586,27 @@ GPUBatch *gpencil_get_buffer_point_geom(bGPdata *gpd, short thickness)
     prev_pos_id = GPU_vertformat_attr_add(&format, "prev_pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
   }
 
-  GPUVertBuf *vbo = GPU_vertbuf_create_with_format(&format);
-  GPU_vertbuf_data_alloc(vbo, totpoints);
-
-  /* draw stroke curve */
-  const tGPspoint *tpt = points;
-  bGPDspoint pt;
-  int idx = 0;
-
   /* get origin to reproject point */
   float origin[3];
   bGPDlayer *gpl = BKE_gpencil_layer_getactive(gpd);
   ED_gp_get_drawing_reference(scene, ob, gpl, ts->gpencil_v3d_align, origin);
 
-  for (int i = 0; i < totpoints; i++, tpt++) {
+  GpencilBufferStrokeKey key;
+  gpencil_buffer_stroke_key_get(&key, gpd, ob, scene, ar, rv3d, origin, thickness);
+  int first_changed = gpencil_buffer_stroke_cache_ensure(
+      cache, &format, GPU_PRIM_POINTS, &key, points, totpoints, totpoints);
+  /* every point also uses the previous one, the first point uses the second one */
+  if (first_changed <= 1) {
+    first_changed = 0;
+  }
+  GPUVertBuf *vbo = cache->vbo;
+
+  /* draw stroke curve */
+  const tGPspoint *tpt = &points[first_changed];
+  bGPDspoint pt;
+  int idx = first_changed;
+
+  for (int i = first_changed; i < totpoints; i++, tpt++) {
     ED_gpencil_tpoint_to_point(ar, origin, tpt, &pt);
     ED_gp_project_point_to_plane(scene, ob, rv3d, origin, ts->gp_sculpt.lock_axis - 1, &pt);
 
@@ -556,7 +650,7 @@ GPUBatch *gpencil_get_buffer_point_geom(bGPdata *gpd, short thickness)
     idx++;
   }
 
-  return GPU_batch_create_ex(GPU_PRIM_POINTS, vbo, NULL, GPU_BATCH_OWNS_VBO);
+  return cache->batch;
 }
 
 /* create batch geometry data for current buffer control point shader */
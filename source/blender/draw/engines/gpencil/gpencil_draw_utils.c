@@ -1561,11 +1561,14 @@ void gpencil_populate_buffer_strokes(GPENCIL_e_data *e_data,
         }
 
         /* use unit matrix because the buffer is in screen space and does not need conversion */
+        /* the batch is owned by the engine and kept between redraws */
         if (gpd->runtime.mode == GP_STYLE_MODE_LINE) {
-          stl->g_data->batch_buffer_stroke = gpencil_get_buffer_stroke_geom(gpd, lthick);
+          stl->g_data->batch_buffer_stroke = gpencil_get_buffer_stroke_geom(
+              &e_data->buffer_stroke_cache, gpd, lthick);
         }
         else {
-          stl->g_data->batch_buffer_stroke = gpencil_get_buffer_point_geom(gpd, lthick);
+          stl->g_data->batch_buffer_stroke = gpencil_get_buffer_point_geom(
+              &e_data->buffer_point_cache, gpd, lthick);
         }
 
         /* buffer strokes, must show stroke always */
@@ -301,6 +301,9 @@ static void GPENCIL_engine_free(void)
 
   DRW_TEXTURE_FREE_SAFE(e_data.gpencil_blank_texture);
 
+  gpencil_buffer_stroke_cache_free(&e_data.buffer_stroke_cache);
+  gpencil_buffer_stroke_cache_free(&e_data.buffer_point_cache);
+
   /* effects */
   GPENCIL_delete_fx_shaders(&e_data);
 }
@@ -833,9 +836,8 @@ void DRW_gpencil_free_runtime_data(void *ved)
   GPENCIL_Data *vedata = (GPENCIL_Data *)ved;
   GPENCIL_StorageList *stl = ((GPENCIL_Data *)vedata)->stl;
 
-  /* free gpu data */
-  GPU_BATCH_DISCARD_SAFE(stl->g_data->batch_buffer_stroke);
-  MEM_SAFE_FREE(stl->g_data->batch_buffer_stroke);
+  /* free gpu data, the buffer stroke batch is owned by the engine data */
+  stl->g_data->batch_buffer_stroke = NULL;
 
   GPU_BATCH_DISCARD_SAFE(stl->g_data->batch_buffer_fill);
   MEM_SAFE_FREE(stl->g_data->batch_buffer_fill);
@@ -32,8 +32,11 @@ struct GPENCIL_StorageList;
 struct MaterialGPencilStyle;
 struct Object;
 struct RenderEngine;
+struct RegionView3D;
 struct RenderLayer;
 struct bGPDstroke;
+struct bGPdata;
+struct tGPspoint;
 
 struct GPUBatch;
 struct GPUVertBuf;
@@ -298,6 +301,35 @@ typedef enum eGPsession_Flag {
   GP_DRW_PAINT_PAINTING = (1 << 4),
 } eGPsession_Flag;
 
+/* Everything the projection of the stroke buffer points depends on. */
+typedef struct GpencilBufferStrokeKey {
+  const struct bGPdata *gpd;
+  const struct RegionView3D *rv3d;
+  float persmat[4][4];
+  float obmat[4][4];
+  float origin[3];
+  float cursor_location[3];
+  float cursor_rotation[3];
+  float ink[4];
+  int winx, winy;
+  int lock_axis;
+  int align;
+  short thickness;
+  short sflag;
+} GpencilBufferStrokeKey;
+
+/* Geometry of the stroke being drawn, kept between redraws so only the points
+ * added or modified since the last redraw need to be projected again. */
+typedef struct GpencilBufferStrokeCache {
+  struct GPUBatch *batch;
+  struct GPUVertBuf *vbo;
+  /** Copy of the buffer points the VBO was filled with. */
+  struct tGPspoint *points;
+  int points_len;
+  int points_alloc;
+  GpencilBufferStrokeKey key;
+} GpencilBufferStrokeCache;
+
 typedef struct GPENCIL_e_data {
   /* textures */
   struct GPUTexture *gpencil_blank_texture;
@@ -330,6 +362,10 @@ typedef struct GPENCIL_e_data {
   struct GPUShader *gpencil_fx_swirl_sh;
   struct GPUShader *gpencil_fx_wave_sh;
 
+  /* geometry of the stroke being drawn */
+  GpencilBufferStrokeCache buffer_stroke_cache;
+  GpencilBufferStrokeCache buffer_point_cache;
+
 } GPENCIL_e_data; /* Engine data */
 
 /* GPUBatch Cache Element */
@@ -446,9 +482,14 @@ void gpencil_get_edlin_geom(struct GpencilBatchCacheElem *be,
                             float alpha,
                             const bool hide_select);
 
-struct GPUBatch *gpencil_get_buffer_stroke_geom(struct bGPdata *gpd, short thickness);
+struct GPUBatch *gpencil_get_buffer_stroke_geom(struct GpencilBufferStrokeCache *cache,
+                                                struct bGPdata *gpd,
+                                                short thickness);
 struct GPUBatch *gpencil_get_buffer_fill_geom(struct bGPdata *gpd);
-struct GPUBatch *gpencil_get_buffer_point_geom(struct bGPdata *gpd, short thickness);
+struct GPUBatch *gpencil_get_buffer_point_geom(struct GpencilBufferStrokeCache *cache,
+                                               struct bGPdata *gpd,
+                                               short thickness);
+void gpencil_buffer_stroke_cache_free(struct GpencilBufferStrokeCache *cache);
 struct GPUBatch *gpencil_get_buffer_ctrlpoint_geom(struct bGPdata *gpd);
 struct GPUBatch *gpencil_get_grid(Object *ob);
 
@@ -17,6 +17,9 @@ in vec2 uv_interp;
 #ifdef V3D_SHADING_VERTEX_COLOR
 in vec3 vertexColor;
 #endif
+#if defined(OBJECT_INFO_COLOR) || defined(OBJECT_INFO_RANDOM_COLOR)
+flat in vec3 objectColor;
+#endif
 
 #ifdef HAIR_SHADER
 flat in float hair_rand;
@@ -45,6 +48,8 @@ void main()
   }
 #  elif defined(V3D_SHADING_VERTEX_COLOR)
   color.rgb = vertexColor;
+#  elif defined(OBJECT_INFO_COLOR) || defined(OBJECT_INFO_RANDOM_COLOR)
+  color.rgb = objectColor;
 #  else
   color.rgb = materialColorAndMetal.rgb;
 #  endif
@@ -24,6 +24,9 @@ out vec2 uv_interp;
 #ifdef V3D_SHADING_VERTEX_COLOR
 out vec3 vertexColor;
 #endif
+#if defined(OBJECT_INFO_COLOR) || defined(OBJECT_INFO_RANDOM_COLOR)
+flat out vec3 objectColor;
+#endif
 
 #ifdef OBJECT_ID_PASS_ENABLED
 RESOURCE_ID_VARYING
@@ -37,6 +40,15 @@ float integer_noise(int n)
   return (float(nn) / 1073741824.0);
 }
 
+#ifdef OBJECT_INFO_RANDOM_COLOR
+vec3 hsv_to_rgb(vec3 hsv)
+{
+  vec3 nrgb = abs(hsv.x * 6.0 - vec3(3.0, 2.0, 4.0)) * vec3(1, -1, -1) + vec3(-1, 2, 2);
+  nrgb = clamp(nrgb, 0.0, 1.0);
+  return ((nrgb - 1.0) * hsv.y + 1.0) * hsv.z;
+}
+#endif
+
 #ifdef V3D_SHADING_VERTEX_COLOR
 vec3 srgb_to_linear_attr(vec3 c)
 {
@@ -94,6 +106,13 @@ void main()
 #  endif
 #endif
 
+#if defined(OBJECT_INFO_COLOR)
+  objectColor = ObjectColor.rgb;
+#elif defined(OBJECT_INFO_RANDOM_COLOR)
+  /* Same saturation and value as workbench_material_update_data(). */
+  objectColor = hsv_to_rgb(vec3(ObjectInfo.z, 0.5, 0.8));
+#endif
+
 #ifdef NORMAL_VIEWPORT_PASS_ENABLED
 #  ifndef HAIR_SHADER
   normal_viewport = normal_object_to_view(nor);
@@ -114,6 +114,7 @@ extern char datatoc_workbench_curvature_lib_glsl[];
 extern char datatoc_workbench_world_light_lib_glsl[];
 
 extern char datatoc_gpu_shader_depth_only_frag_glsl[];
+extern char datatoc_gpu_shader_common_obinfos_lib_glsl[];
 
 static char *workbench_build_composite_frag(WORKBENCH_PrivateData *wpd)
 {
@@ -162,6 +163,7 @@ static char *workbench_build_prepass_vert(bool is_hair)
     BLI_dynstr_append(ds, datatoc_common_hair_lib_glsl);
   }
   BLI_dynstr_append(ds, datatoc_common_view_lib_glsl);
+  BLI_dynstr_append(ds, datatoc_gpu_shader_common_obinfos_lib_glsl);
   BLI_dynstr_append(ds, datatoc_workbench_prepass_vert_glsl);
   char *str = BLI_dynstr_get_cstring(ds);
   BLI_dynstr_free(ds);
@@ -224,6 +226,15 @@ static GPUShader *ensure_deferred_prepass_shader(WORKBENCH_PrivateData *wpd,
     const GPUShaderConfigData *sh_cfg_data = &GPU_shader_cfg_data[sh_cfg];
     char *defines = workbench_material_build_defines(
         wpd, is_uniform_color, is_hair, color_override);
+    if (workbench_material_use_object_info_color(wpd, is_uniform_color, color_override)) {
+      const bool use_object_color = (wpd->shading.color_type == V3D_SHADING_OBJECT_COLOR);
+      char *defines_obinfo = BLI_string_joinN(defines,
+                                              use_object_color ?
+                                                  "#define OBJECT_INFO_COLOR\n" :
+                                                  "#define OBJECT_INFO_RANDOM_COLOR\n");
+      MEM_freeN(defines);
+      defines = defines_obinfo;
+    }
     char *prepass_vert = workbench_build_prepass_vert(is_hair);
     char *prepass_frag = workbench_build_prepass_frag();
     sh_data->prepass_sh_cache[index] = GPU_shader_create_from_arrays({
@@ -860,7 +871,15 @@ static WORKBENCH_MaterialData *get_or_create_material_data(WORKBENCH_Data *vedat
   const bool is_ghost = (ob->dtx & OB_DRAWXRAY);
 
   /* Solid */
-  workbench_material_update_data(wpd, ob, mat, &material_template, color_type);
+  if ((wpd->shading.color_type == color_type) &&
+      workbench_material_use_object_info_color(wpd, false, WORKBENCH_COLOR_OVERRIDE_OFF)) {
+    /* The color is read from the object infos, only the other parameters matter. */
+    workbench_material_update_data(wpd, NULL, NULL, &material_template, V3D_SHADING_SINGLE_COLOR);
+    zero_v3(material_template.base_color);
+  }
+  else {
+    workbench_material_update_data(wpd, ob, mat, &material_template, color_type);
+  }
   material_template.color_type = color_type;
   material_template.ima = ima;
   material_template.iuser = iuser;
@@ -1100,7 +1119,7 @@ void workbench_deferred_solid_cache_populate(WORKBENCH_Data *vedata, Object *ob)
           geom = DRW_cache_mesh_surface_vertpaint_get(ob);
         }
         else {
-          geom = DRW_cache_object_surface_get(ob);
+          geom = DRW_cache_object_surface_lod_get(ob);
         }
 
         if (geom) {
@@ -717,7 +717,7 @@ void workbench_forward_cache_populate(WORKBENCH_Data *vedata, Object *ob)
       else {
         struct GPUBatch *geom = (color_type == V3D_SHADING_VERTEX_COLOR) ?
                                     DRW_cache_mesh_surface_vertpaint_get(ob) :
-                                    DRW_cache_object_surface_get(ob);
+                                    DRW_cache_object_surface_lod_get(ob);
         if (geom) {
           material = workbench_forward_get_or_create_material_data(
               vedata, ob, NULL, NULL, NULL, color_type, 0);
@@ -193,6 +193,16 @@ uint workbench_material_get_hash(WORKBENCH_MaterialData *mat, bool is_ghost)
   return BLI_ghashutil_uinthash_v4((uint *)&input);
 }
 
+/* Object and random colors are read from the draw manager object infos by the deferred prepass
+ * shaders. This way all the objects of the scene share the same shading group. */
+bool workbench_material_use_object_info_color(const WORKBENCH_PrivateData *wpd,
+                                              bool is_uniform_color,
+                                              const WORKBENCH_ColorOverride color_override)
+{
+  return !is_uniform_color && (color_override == WORKBENCH_COLOR_OVERRIDE_OFF) &&
+         ELEM(wpd->shading.color_type, V3D_SHADING_OBJECT_COLOR, V3D_SHADING_RANDOM_COLOR);
+}
+
 int workbench_material_get_composite_shader_index(WORKBENCH_PrivateData *wpd)
 {
   /* NOTE: change MAX_COMPOSITE_SHADERS accordingly when modifying this function. */
@@ -239,6 +249,10 @@ int workbench_material_get_prepass_shader_index(WORKBENCH_PrivateData *wpd,
   SET_FLAG_FROM_TEST(index, MATCAP_ENABLED(wpd), 1 << 4);
   SET_FLAG_FROM_TEST(index, use_textures, 1 << 5);
   SET_FLAG_FROM_TEST(index, use_vertex_colors, 1 << 6);
+  if (workbench_material_use_object_info_color(wpd, is_uniform_color, color_override)) {
+    SET_FLAG_FROM_TEST(index, wpd->shading.color_type == V3D_SHADING_OBJECT_COLOR, 1 << 7);
+    SET_FLAG_FROM_TEST(index, wpd->shading.color_type == V3D_SHADING_RANDOM_COLOR, 1 << 8);
+  }
   BLI_assert(index < MAX_PREPASS_SHADERS);
   return index;
 }
@@ -37,7 +37,7 @@
 #define WORKBENCH_ENGINE "BLENDER_WORKBENCH"
 #define M_GOLDEN_RATION_CONJUGATE 0.618033988749895
 #define MAX_COMPOSITE_SHADERS (1 << 7)
-#define MAX_PREPASS_SHADERS (1 << 7)
+#define MAX_PREPASS_SHADERS (1 << 9)
 #define MAX_ACCUM_SHADERS (1 << 7)
 #define MAX_CAVITY_SHADERS (1 << 3)
 
@@ -523,6 +523,9 @@ void workbench_material_update_data(WORKBENCH_PrivateData *wpd,
                                     WORKBENCH_MaterialData *data,
                                     int color_type);
 uint workbench_material_get_hash(WORKBENCH_MaterialData *material_template, bool is_ghost);
+bool workbench_material_use_object_info_color(const WORKBENCH_PrivateData *wpd,
+                                              bool is_uniform_color,
+                                              const WORKBENCH_ColorOverride color_override);
 int workbench_material_get_composite_shader_index(WORKBENCH_PrivateData *wpd);
 int workbench_material_get_prepass_shader_index(WORKBENCH_PrivateData *wpd,
                                                 bool is_uniform_color,
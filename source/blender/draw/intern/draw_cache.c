@@ -26,6 +26,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_lattice_types.h"
+#include "DNA_userdef_types.h"
 
 #include "UI_resources.h"
 
@@ -824,6 +825,44 @@ GPUBatch *DRW_cache_object_surface_get(Object *ob)
   }
 }
 
+/* Diameter in pixels of the bounding sphere of the object in the default view. */
+static float drw_object_screen_size_get(Object *ob)
+{
+  const DRWView *view = DRW_view_default_get();
+  BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (view == NULL || bb == NULL) {
+    return FLT_MAX;
+  }
+  float center[3], scale[3];
+  mid_v3_v3v3(center, bb->vec[0], bb->vec[6]);
+  mul_m4_v3(ob->obmat, center);
+  mat4_to_size(scale, ob->obmat);
+  const float radius = len_v3v3(bb->vec[0], bb->vec[6]) * 0.5f *
+                       max_fff(scale[0], scale[1], scale[2]);
+
+  float persmat[4][4], winmat[4][4];
+  DRW_view_persmat_get(view, persmat, false);
+  DRW_view_winmat_get(view, winmat, false);
+  const float w = mul_project_m4_v3_zfac(persmat, center);
+  if (DRW_view_is_persp_get(view) && w <= radius) {
+    /* The view is inside or close to the object. */
+    return FLT_MAX;
+  }
+  const float *viewport_size = DRW_viewport_size_get();
+  return radius * max_ff(winmat[0][0] * viewport_size[0], winmat[1][1] * viewport_size[1]) / w;
+}
+
+/* Same as #DRW_cache_object_surface_get but simplified for objects covering only a few pixels
+ * of the viewport. Selection, depth and final renders always use the full resolution. */
+GPUBatch *DRW_cache_object_surface_lod_get(Object *ob)
+{
+  if (ob->type != OB_MESH || (U.gpu_flag & USER_GPU_FLAG_VIEWPORT_LOD) == 0 ||
+      DRW_state_is_select() || DRW_state_is_depth() || DRW_state_is_image_render()) {
+    return DRW_cache_object_surface_get(ob);
+  }
+  return DRW_mesh_batch_cache_get_surface_lod(ob->data, drw_object_screen_size_get(ob));
+}
+
 GPUBatch **DRW_cache_object_surface_material_get(struct Object *ob,
                                                  struct GPUMaterial **gpumat_array,
                                                  uint gpumat_array_len,
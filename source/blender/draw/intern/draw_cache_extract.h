@@ -116,6 +116,8 @@ typedef struct MeshBufferCache {
   struct {
     /* Indices to vloops. */
     GPUIndexBuf *tris;        /* Ordered per material. */
+    GPUIndexBuf *tris_lod1;   /* Simplified `tris`, see #MESH_LOD1_GRID_RES. */
+    GPUIndexBuf *tris_lod2;
     GPUIndexBuf *lines;       /* Loose edges last. */
     GPUIndexBuf *lines_loose; /* sub buffer of `lines` only containing the loose edges. */
     GPUIndexBuf *points;
@@ -160,8 +162,15 @@ typedef enum DRWBatchFlag {
   MBC_WIRE_LOOPS_UVS = (1 << 25),
   MBC_SURF_PER_MAT = (1 << 26),
   MBC_SKIN_ROOTS = (1 << 27),
+  MBC_SURFACE_LOD1 = (1 << 28),
+  MBC_SURFACE_LOD2 = (1 << 29),
 } DRWBatchFlag;
 
+/* Level of details of the surface: each level snaps the vertices to a grid with this many
+ * cells along the largest dimension of the mesh bounds. */
+#define MESH_LOD1_GRID_RES 64
+#define MESH_LOD2_GRID_RES 16
+
 #define MBC_EDITUV \
   (MBC_EDITUV_FACES_STRETCH_AREA | MBC_EDITUV_FACES_STRETCH_ANGLE | MBC_EDITUV_FACES | \
    MBC_EDITUV_EDGES | MBC_EDITUV_VERTS | MBC_EDITUV_FACEDOTS | MBC_WIRE_LOOPS_UVS)
@@ -180,6 +189,8 @@ typedef struct MeshBatchCache {
     /* Surfaces / Render */
     GPUBatch *surface;
     GPUBatch *surface_weights;
+    GPUBatch *surface_lod1;
+    GPUBatch *surface_lod2;
     /* Edit mode */
     GPUBatch *edit_triangles;
     GPUBatch *edit_vertices;
@@ -260,4 +271,8 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
                                         const ToolSettings *ts,
                                         const bool use_hide);
 
+/* Iterate the mesh once for all extractors instead of once per extractor, enabled by default.
+ * Only meant to compare both methods in benchmarks. */
+void mesh_buffer_cache_use_fused_extraction(const bool use_fused);
+
 #endif /* __DRAW_CACHE_EXTRACT_H__ */
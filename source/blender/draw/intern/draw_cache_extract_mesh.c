@@ -40,6 +40,7 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_bvhutils.h"
 #include "BKE_customdata.h"
@@ -66,10 +67,13 @@
 #include "ED_mesh.h"
 #include "ED_uvedit.h"
 
+#include "PIL_time.h"
+
 #include "draw_cache_inline.h"
 #include "draw_cache_impl.h"
 
 #include "draw_cache_extract.h"
+#include "draw_manager_profiling.h"
 
 // #define DEBUG_TIME
 
@@ -554,6 +558,159 @@ static const MeshExtract extract_tris = {
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Extract Simplified Triangles Indices
+ *
+ * Vertex clustering: vertices are snapped to a regular grid over the mesh bounds and every
+ * loop is replaced by the first loop found in its cell. Triangles collapsing to a line or a
+ * point are dropped. Only existing loops are referenced, so the result is drawn with the
+ * vertex buffers of the full resolution surface.
+ * \{ */
+
+typedef struct MeshExtract_TriLOD_Data {
+  GPUIndexBufBuilder elb;
+  /* Grid cell of every vertex. */
+  int *vert_cell;
+  /* First loop of every cell, -1 for empty cells. */
+  int *cell_loop;
+} MeshExtract_TriLOD_Data;
+
+static void *extract_tris_lod_init(const MeshRenderData *mr, const int grid_res)
+{
+  MeshExtract_TriLOD_Data *data = MEM_callocN(sizeof(*data), __func__);
+  GPU_indexbuf_init(&data->elb, GPU_PRIM_TRIS, mr->tri_len, mr->loop_len);
+
+  /* Edit meshes are not simplified, their topology changes too often. */
+  if (mr->extract_type == MR_EXTRACT_BMESH || mr->vert_len == 0) {
+    return data;
+  }
+
+  float min[3], max[3], size[3];
+  INIT_MINMAX(min, max);
+  for (int v = 0; v < mr->vert_len; v++) {
+    minmax_v3v3_v3(min, max, mr->mvert[v].co);
+  }
+  sub_v3_v3v3(size, max, min);
+  const float cell_size = max_fff(size[0], size[1], size[2]) / grid_res;
+  if (cell_size == 0.0f) {
+    return data;
+  }
+  const float cell_scale = 1.0f / cell_size;
+  int res[3];
+  for (int i = 0; i < 3; i++) {
+    res[i] = min_ii((int)(size[i] * cell_scale) + 1, grid_res);
+  }
+
+  data->vert_cell = MEM_mallocN(sizeof(int) * mr->vert_len, __func__);
+  for (int v = 0; v < mr->vert_len; v++) {
+    const float *co = mr->mvert[v].co;
+    int cell = 0;
+    for (int i = 2; i >= 0; i--) {
+      cell = cell * res[i] + clamp_i((int)((co[i] - min[i]) * cell_scale), 0, res[i] - 1);
+    }
+    data->vert_cell[v] = cell;
+  }
+
+  const int cell_len = res[0] * res[1] * res[2];
+  data->cell_loop = MEM_mallocN(sizeof(int) * cell_len, __func__);
+  copy_vn_i(data->cell_loop, cell_len, -1);
+  for (int l = 0; l < mr->loop_len; l++) {
+    int *cell_loop = &data->cell_loop[data->vert_cell[mr->mloop[l].v]];
+    if (*cell_loop == -1) {
+      *cell_loop = l;
+    }
+  }
+  return data;
+}
+
+static void *extract_tris_lod1_init(const MeshRenderData *mr, void *UNUSED(ibo))
+{
+  return extract_tris_lod_init(mr, MESH_LOD1_GRID_RES);
+}
+
+static void *extract_tris_lod2_init(const MeshRenderData *mr, void *UNUSED(ibo))
+{
+  return extract_tris_lod_init(mr, MESH_LOD2_GRID_RES);
+}
+
+static void extract_tris_lod_looptri_bmesh(const MeshRenderData *UNUSED(mr),
+                                           int UNUSED(t),
+                                           BMLoop **elt,
+                                           void *_data)
+{
+  if (!BM_elem_flag_test(elt[0]->f, BM_ELEM_HIDDEN)) {
+    MeshExtract_TriLOD_Data *data = _data;
+    GPU_indexbuf_add_tri_verts(&data->elb,
+                               BM_elem_index_get(elt[0]),
+                               BM_elem_index_get(elt[1]),
+                               BM_elem_index_get(elt[2]));
+  }
+}
+
+static void extract_tris_lod_looptri_mesh(const MeshRenderData *mr,
+                                          int UNUSED(t),
+                                          const MLoopTri *mlt,
+                                          void *_data)
+{
+  const MPoly *mpoly = &mr->mpoly[mlt->poly];
+  if (mr->use_hide && (mpoly->flag & ME_HIDE)) {
+    return;
+  }
+  MeshExtract_TriLOD_Data *data = _data;
+  if (data->cell_loop == NULL) {
+    GPU_indexbuf_add_tri_verts(&data->elb, mlt->tri[0], mlt->tri[1], mlt->tri[2]);
+    return;
+  }
+  int tri[3];
+  for (int i = 0; i < 3; i++) {
+    tri[i] = data->cell_loop[data->vert_cell[mr->mloop[mlt->tri[i]].v]];
+  }
+  if (tri[0] != tri[1] && tri[1] != tri[2] && tri[2] != tri[0]) {
+    GPU_indexbuf_add_tri_verts(&data->elb, tri[0], tri[1], tri[2]);
+  }
+}
+
+static void extract_tris_lod_finish(const MeshRenderData *UNUSED(mr), void *ibo, void *_data)
+{
+  MeshExtract_TriLOD_Data *data = _data;
+  GPU_indexbuf_build_in_place(&data->elb, ibo);
+  MEM_SAFE_FREE(data->vert_cell);
+  MEM_SAFE_FREE(data->cell_loop);
+  MEM_freeN(data);
+}
+
+static const MeshExtract extract_tris_lod1 = {
+    extract_tris_lod1_init,
+    extract_tris_lod_looptri_bmesh,
+    extract_tris_lod_looptri_mesh,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    extract_tris_lod_finish,
+    0,
+    false,
+};
+
+static const MeshExtract extract_tris_lod2 = {
+    extract_tris_lod2_init,
+    extract_tris_lod_looptri_bmesh,
+    extract_tris_lod_looptri_mesh,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    extract_tris_lod_finish,
+    0,
+    false,
+};
+
+/** \} */
+
 /* ---------------------------------------------------------------------- */
 /** \name Extract Edges Indices
  * \{ */
@@ -1634,10 +1791,25 @@ static const MeshExtract extract_lnor = {
 /** \name Extract UV  layers
  * \{ */
 
+/* Returns the position of the next UV in the buffer. */
+BLI_INLINE void *extract_uv_copy(void *uv_data, const float uv[2], const bool use_compact)
+{
+  if (use_compact) {
+    ushort *uv_hf = uv_data;
+    uv_hf[0] = GPU_half_convert_f32(uv[0]);
+    uv_hf[1] = GPU_half_convert_f32(uv[1]);
+    return uv_hf + 2;
+  }
+  memcpy(uv_data, uv, sizeof(float[2]));
+  return (float *)uv_data + 2;
+}
+
 static void *extract_uv_init(const MeshRenderData *mr, void *buf)
 {
   GPUVertFormat format = {0};
   GPU_vertformat_deinterleave(&format);
+  /* Half floats are precise enough for UVs in the [0..1] range of a 2K texture. */
+  const bool use_compact = (U.gpu_flag & USER_GPU_FLAG_COMPACT_VERTEX_DATA) != 0;
 
   CustomData *cd_ldata = (mr->extract_type == MR_EXTRACT_BMESH) ? &mr->bm->ldata : &mr->me->ldata;
   uint32_t uv_layers = mr->cache->cd_used.uv;
@@ -1658,7 +1830,8 @@ static void *extract_uv_init(const MeshRenderData *mr, void *buf)
       GPU_vertformat_safe_attrib_name(layer_name, attr_safe_name, GPU_MAX_SAFE_ATTRIB_NAME);
       /* UV layer name. */
       BLI_snprintf(attr_name, sizeof(attr_name), "u%s", attr_safe_name);
-      GPU_vertformat_attr_add(&format, attr_name, GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+      GPU_vertformat_attr_add(
+          &format, attr_name, use_compact ? GPU_COMP_F16 : GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
       /* Auto layer name. */
       BLI_snprintf(attr_name, sizeof(attr_name), "a%s", attr_safe_name);
       GPU_vertformat_alias_add(&format, attr_name);
@@ -1690,7 +1863,7 @@ static void *extract_uv_init(const MeshRenderData *mr, void *buf)
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, v_len);
 
-  float(*uv_data)[2] = (float(*)[2])vbo->data;
+  void *uv_data = vbo->data;
   for (int i = 0; i < MAX_MTFACE; i++) {
     if (uv_layers & (1 << i)) {
       if (mr->extract_type == MR_EXTRACT_BMESH) {
@@ -1701,15 +1874,14 @@ static void *extract_uv_init(const MeshRenderData *mr, void *buf)
         BM_ITER_MESH (efa, &f_iter, mr->bm, BM_FACES_OF_MESH) {
           BM_ITER_ELEM (loop, &l_iter, efa, BM_LOOPS_OF_FACE) {
             MLoopUV *luv = BM_ELEM_CD_GET_VOID_P(loop, cd_ofs);
-            memcpy(uv_data, luv->uv, sizeof(*uv_data));
-            uv_data++;
+            uv_data = extract_uv_copy(uv_data, luv->uv, use_compact);
           }
         }
       }
       else {
         MLoopUV *layer_data = CustomData_get_layer_n(cd_ldata, CD_MLOOPUV, i);
-        for (int l = 0; l < mr->loop_len; l++, uv_data++, layer_data++) {
-          memcpy(uv_data, layer_data->uv, sizeof(*uv_data));
+        for (int l = 0; l < mr->loop_len; l++, layer_data++) {
+          uv_data = extract_uv_copy(uv_data, layer_data->uv, use_compact);
         }
       }
     }
@@ -1739,10 +1911,33 @@ static const MeshExtract extract_uv = {
 /** \name Extract Tangent layers
  * \{ */
 
+/* Copy normalized tangents, packed as 16 bit integers when using compact vertex data. */
+static void *extract_tan_copy(void *tan_data,
+                              const float (*layer_data)[4],
+                              const int loop_len,
+                              const bool use_compact)
+{
+  if (use_compact) {
+    short(*tan_data_i16)[4] = tan_data;
+    for (int l = 0; l < loop_len; l++) {
+      for (int j = 0; j < 4; j++) {
+        tan_data_i16[l][j] = GPU_normal_convert_i16(layer_data[l][j]);
+      }
+    }
+    return tan_data_i16 + loop_len;
+  }
+  memcpy(tan_data, layer_data, sizeof(float[4]) * loop_len);
+  return (float(*)[4])tan_data + loop_len;
+}
+
 static void *extract_tan_init(const MeshRenderData *mr, void *buf)
 {
   GPUVertFormat format = {0};
   GPU_vertformat_deinterleave(&format);
+  const bool use_compact = (U.gpu_flag & USER_GPU_FLAG_COMPACT_VERTEX_DATA) != 0;
+  const GPUVertCompType tan_comp_type = use_compact ? GPU_COMP_I16 : GPU_COMP_F32;
+  const GPUVertFetchMode tan_fetch_mode = use_compact ? GPU_FETCH_INT_TO_FLOAT_UNIT :
+                                                        GPU_FETCH_FLOAT;
 
   CustomData *cd_ldata = (mr->extract_type == MR_EXTRACT_BMESH) ? &mr->bm->ldata : &mr->me->ldata;
   CustomData *cd_vdata = (mr->extract_type == MR_EXTRACT_BMESH) ? &mr->bm->vdata : &mr->me->vdata;
@@ -1761,7 +1956,7 @@ static void *extract_tan_init(const MeshRenderData *mr, void *buf)
       GPU_vertformat_safe_attrib_name(layer_name, attr_safe_name, GPU_MAX_SAFE_ATTRIB_NAME);
       /* Tangent layer name. */
       BLI_snprintf(attr_name, sizeof(attr_name), "t%s", attr_safe_name);
-      GPU_vertformat_attr_add(&format, attr_name, GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+      GPU_vertformat_attr_add(&format, attr_name, tan_comp_type, 4, tan_fetch_mode);
       /* Active render layer name. */
       if (i == CustomData_get_render_layer(cd_ldata, CD_MLOOPUV)) {
         GPU_vertformat_alias_add(&format, "t");
@@ -1837,7 +2032,7 @@ static void *extract_tan_init(const MeshRenderData *mr, void *buf)
     const char *layer_name = CustomData_get_layer_name(cd_ldata, CD_TANGENT, 0);
     GPU_vertformat_safe_attrib_name(layer_name, attr_safe_name, GPU_MAX_SAFE_ATTRIB_NAME);
     BLI_snprintf(attr_name, sizeof(*attr_name), "t%s", attr_safe_name);
-    GPU_vertformat_attr_add(&format, attr_name, GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, attr_name, tan_comp_type, 4, tan_fetch_mode);
     GPU_vertformat_alias_add(&format, "t");
     GPU_vertformat_alias_add(&format, "at");
   }
@@ -1857,15 +2052,15 @@ static void *extract_tan_init(const MeshRenderData *mr, void *buf)
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, v_len);
 
-  float(*tan_data)[4] = (float(*)[4])vbo->data;
+  void *tan_data = vbo->data;
   for (int i = 0; i < tan_len; i++) {
-    void *layer_data = CustomData_get_layer_named(cd_ldata, CD_TANGENT, tangent_names[i]);
-    memcpy(tan_data, layer_data, sizeof(*tan_data) * mr->loop_len);
-    tan_data += mr->loop_len;
+    const float(*layer_data)[4] = CustomData_get_layer_named(
+        cd_ldata, CD_TANGENT, tangent_names[i]);
+    tan_data = extract_tan_copy(tan_data, layer_data, mr->loop_len, use_compact);
   }
   if (use_orco_tan) {
-    void *layer_data = CustomData_get_layer_n(cd_ldata, CD_TANGENT, 0);
-    memcpy(tan_data, layer_data, sizeof(*tan_data) * mr->loop_len);
+    const float(*layer_data)[4] = CustomData_get_layer_n(cd_ldata, CD_TANGENT, 0);
+    extract_tan_copy(tan_data, layer_data, mr->loop_len, use_compact);
   }
 
   CustomData_free_layers(cd_ldata, CD_TANGENT, mr->loop_len);
@@ -2044,7 +2239,7 @@ static const MeshExtract extract_orco = {
 typedef struct MeshExtract_EdgeFac_Data {
   uchar *vbo_data;
   bool use_edge_render;
-  /* Number of loop per edge. */
+  /* Number of loop per edge, clamped to 3. */
   uchar edge_loop_count[0];
 } MeshExtract_EdgeFac_Data;
 
@@ -2077,7 +2272,7 @@ static void *extract_edge_fac_init(const MeshRenderData *mr, void *buf)
   MeshExtract_EdgeFac_Data *data;
 
   if (mr->extract_type == MR_EXTRACT_MESH) {
-    size_t edge_loop_count_size = sizeof(uint32_t) * mr->edge_len;
+    size_t edge_loop_count_size = sizeof(*data->edge_loop_count) * mr->edge_len;
     data = MEM_callocN(sizeof(*data) + edge_loop_count_size, __func__);
 
     /* HACK(fclem) Detecting the need for edge render.
@@ -2089,6 +2284,17 @@ static void *extract_edge_fac_init(const MeshRenderData *mr, void *buf)
         break;
       }
     }
+
+    if (!data->use_edge_render) {
+      /* Count loop per edge to detect non-manifold. Done upfront so the loops can be
+       * iterated in parallel. */
+      const MLoop *mloop = mr->mloop;
+      for (int l = 0; l < mr->loop_len; l++, mloop++) {
+        if (data->edge_loop_count[mloop->e] < 3) {
+          data->edge_loop_count[mloop->e]++;
+        }
+      }
+    }
   }
   else {
     data = MEM_callocN(sizeof(*data), __func__);
@@ -2124,10 +2330,6 @@ static void extract_edge_fac_loop_mesh(
     data->vbo_data[l] = (medge->flag & ME_EDGERENDER) ? 255 : 0;
   }
   else {
-    /* Count loop per edge to detect non-manifold. */
-    if (data->edge_loop_count[mloop->e] < 3) {
-      data->edge_loop_count[mloop->e]++;
-    }
     if (data->edge_loop_count[mloop->e] == 2) {
       /* Manifold */
       int loopend = mpoly->totloop + mpoly->loopstart - 1;
@@ -2210,7 +2412,7 @@ static const MeshExtract extract_edge_fac = {
     NULL,
     extract_edge_fac_finish,
     MR_DATA_POLY_NOR,
-    false,
+    true,
 };
 
 /** \} */
@@ -2487,6 +2689,41 @@ static void mesh_render_data_vert_flag(const MeshRenderData *mr, BMVert *eve, Ed
   }
 }
 
+typedef struct MeshExtract_EditData_Data {
+  EditLoopData *vbo_data;
+  /* Flags of the original BMesh elements, evaluated once for each element
+   * instead of once for each loop using it. */
+  uchar *vert_flags;
+  EditLoopData *edge_flags;
+  uchar *face_flags;
+} MeshExtract_EditData_Data;
+
+static void extract_edit_data_elem_flags_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MeshRenderData *mr = ((void **)userdata)[0];
+  MeshExtract_EditData_Data *data = ((void **)userdata)[1];
+  BMesh *bm = mr->bm;
+  EditLoopData eattr;
+
+  if (i < bm->totvert) {
+    memset(&eattr, 0x0, sizeof(eattr));
+    mesh_render_data_vert_flag(mr, BM_vert_at_index(bm, i), &eattr);
+    data->vert_flags[i] = eattr.e_flag;
+  }
+  if (i < bm->totedge) {
+    memset(&eattr, 0x0, sizeof(eattr));
+    mesh_render_data_edge_flag(mr, BM_edge_at_index(bm, i), &eattr);
+    data->edge_flags[i] = eattr;
+  }
+  if (i < bm->totface) {
+    memset(&eattr, 0x0, sizeof(eattr));
+    mesh_render_data_face_flag(mr, BM_face_at_index(bm, i), -1, &eattr);
+    data->face_flags[i] = eattr.v_flag;
+  }
+}
+
 static void *extract_edit_data_init(const MeshRenderData *mr, void *buf)
 {
   static GPUVertFormat format = {0};
@@ -2498,19 +2735,62 @@ static void *extract_edit_data_init(const MeshRenderData *mr, void *buf)
   GPUVertBuf *vbo = buf;
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, mr->loop_len + mr->loop_loose_len);
-  return vbo->data;
+
+  MeshExtract_EditData_Data *data = MEM_callocN(sizeof(*data), __func__);
+  data->vbo_data = (EditLoopData *)vbo->data;
+
+  BMesh *bm = mr->bm;
+  if (bm != NULL) {
+    /* Element tables are ensured by #mesh_render_data_create. */
+    data->vert_flags = MEM_mallocN(sizeof(*data->vert_flags) * bm->totvert, __func__);
+    data->edge_flags = MEM_mallocN(sizeof(*data->edge_flags) * bm->totedge, __func__);
+    data->face_flags = MEM_mallocN(sizeof(*data->face_flags) * bm->totface, __func__);
+
+    void *userdata[2] = {(void *)mr, data};
+    const int elem_len = max_iii(bm->totvert, bm->totedge, bm->totface);
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, elem_len, userdata, extract_edit_data_elem_flags_cb, &settings);
+  }
+  return data;
+}
+
+BLI_INLINE void extract_edit_data_vert_flag(const MeshExtract_EditData_Data *data,
+                                            const BMVert *eve,
+                                            EditLoopData *eattr)
+{
+  eattr->e_flag |= data->vert_flags[BM_elem_index_get(eve)];
 }
 
-static void extract_edit_data_loop_bmesh(const MeshRenderData *mr,
+BLI_INLINE void extract_edit_data_edge_flag(const MeshExtract_EditData_Data *data,
+                                            const BMEdge *eed,
+                                            EditLoopData *eattr)
+{
+  const EditLoopData *edge_attr = &data->edge_flags[BM_elem_index_get(eed)];
+  eattr->e_flag |= edge_attr->e_flag;
+  eattr->crease = edge_attr->crease;
+  eattr->bweight = edge_attr->bweight;
+}
+
+BLI_INLINE void extract_edit_data_face_flag(const MeshExtract_EditData_Data *data,
+                                            const BMFace *efa,
+                                            EditLoopData *eattr)
+{
+  eattr->v_flag |= data->face_flags[BM_elem_index_get(efa)];
+}
+
+static void extract_edit_data_loop_bmesh(const MeshRenderData *UNUSED(mr),
                                          int l,
                                          BMLoop *loop,
                                          void *_data)
 {
-  EditLoopData *data = (EditLoopData *)_data + l;
+  MeshExtract_EditData_Data *edit_data = _data;
+  EditLoopData *data = edit_data->vbo_data + l;
   memset(data, 0x0, sizeof(*data));
-  mesh_render_data_face_flag(mr, loop->f, -1, data);
-  mesh_render_data_edge_flag(mr, loop->e, data);
-  mesh_render_data_vert_flag(mr, loop->v, data);
+  extract_edit_data_face_flag(edit_data, loop->f, data);
+  extract_edit_data_edge_flag(edit_data, loop->e, data);
+  extract_edit_data_vert_flag(edit_data, loop->v, data);
 }
 
 static void extract_edit_data_loop_mesh(const MeshRenderData *mr,
@@ -2520,19 +2800,20 @@ static void extract_edit_data_loop_mesh(const MeshRenderData *mr,
                                         const MPoly *UNUSED(mpoly),
                                         void *_data)
 {
-  EditLoopData *data = (EditLoopData *)_data + l;
+  MeshExtract_EditData_Data *edit_data = _data;
+  EditLoopData *data = edit_data->vbo_data + l;
   memset(data, 0x0, sizeof(*data));
   BMFace *efa = bm_original_face_get(mr, p);
   BMEdge *eed = bm_original_edge_get(mr, mloop->e);
   BMVert *eve = bm_original_vert_get(mr, mloop->v);
   if (efa) {
-    mesh_render_data_face_flag(mr, efa, -1, data);
+    extract_edit_data_face_flag(edit_data, efa, data);
   }
   if (eed) {
-    mesh_render_data_edge_flag(mr, eed, data);
+    extract_edit_data_edge_flag(edit_data, eed, data);
   }
   if (eve) {
-    mesh_render_data_vert_flag(mr, eve, data);
+    extract_edit_data_vert_flag(edit_data, eve, data);
   }
 }
 
@@ -2541,12 +2822,13 @@ static void extract_edit_data_ledge_bmesh(const MeshRenderData *mr,
                                           BMEdge *eed,
                                           void *_data)
 {
-  EditLoopData *data = (EditLoopData *)_data + mr->loop_len + e * 2;
+  MeshExtract_EditData_Data *edit_data = _data;
+  EditLoopData *data = edit_data->vbo_data + mr->loop_len + e * 2;
   memset(data, 0x0, sizeof(*data) * 2);
-  mesh_render_data_edge_flag(mr, eed, &data[0]);
+  extract_edit_data_edge_flag(edit_data, eed, &data[0]);
   data[1] = data[0];
-  mesh_render_data_vert_flag(mr, eed->v1, &data[0]);
-  mesh_render_data_vert_flag(mr, eed->v2, &data[1]);
+  extract_edit_data_vert_flag(edit_data, eed->v1, &data[0]);
+  extract_edit_data_vert_flag(edit_data, eed->v2, &data[1]);
 }
 
 static void extract_edit_data_ledge_mesh(const MeshRenderData *mr,
@@ -2554,21 +2836,22 @@ static void extract_edit_data_ledge_mesh(const MeshRenderData *mr,
                                          const MEdge *edge,
                                          void *_data)
 {
-  EditLoopData *data = (EditLoopData *)_data + mr->loop_len + e * 2;
+  MeshExtract_EditData_Data *edit_data = _data;
+  EditLoopData *data = edit_data->vbo_data + mr->loop_len + e * 2;
   memset(data, 0x0, sizeof(*data) * 2);
   int e_idx = mr->ledges[e];
   BMEdge *eed = bm_original_edge_get(mr, e_idx);
   BMVert *eve1 = bm_original_vert_get(mr, edge->v1);
   BMVert *eve2 = bm_original_vert_get(mr, edge->v2);
   if (eed) {
-    mesh_render_data_edge_flag(mr, eed, &data[0]);
+    extract_edit_data_edge_flag(edit_data, eed, &data[0]);
     data[1] = data[0];
   }
   if (eve1) {
-    mesh_render_data_vert_flag(mr, eve1, &data[0]);
+    extract_edit_data_vert_flag(edit_data, eve1, &data[0]);
   }
   if (eve2) {
-    mesh_render_data_vert_flag(mr, eve2, &data[1]);
+    extract_edit_data_vert_flag(edit_data, eve2, &data[1]);
   }
 }
 
@@ -2577,9 +2860,10 @@ static void extract_edit_data_lvert_bmesh(const MeshRenderData *mr,
                                           BMVert *eve,
                                           void *_data)
 {
-  EditLoopData *data = (EditLoopData *)_data + mr->loop_len + mr->edge_loose_len * 2 + v;
+  MeshExtract_EditData_Data *edit_data = _data;
+  EditLoopData *data = edit_data->vbo_data + mr->loop_len + mr->edge_loose_len * 2 + v;
   memset(data, 0x0, sizeof(*data));
-  mesh_render_data_vert_flag(mr, eve, data);
+  extract_edit_data_vert_flag(edit_data, eve, data);
 }
 
 static void extract_edit_data_lvert_mesh(const MeshRenderData *mr,
@@ -2587,15 +2871,27 @@ static void extract_edit_data_lvert_mesh(const MeshRenderData *mr,
                                          const MVert *UNUSED(mvert),
                                          void *_data)
 {
-  EditLoopData *data = (EditLoopData *)_data + mr->loop_len + mr->edge_loose_len * 2 + v;
+  MeshExtract_EditData_Data *edit_data = _data;
+  EditLoopData *data = edit_data->vbo_data + mr->loop_len + mr->edge_loose_len * 2 + v;
   memset(data, 0x0, sizeof(*data));
   int v_idx = mr->lverts[v];
   BMVert *eve = bm_original_vert_get(mr, v_idx);
   if (eve) {
-    mesh_render_data_vert_flag(mr, eve, data);
+    extract_edit_data_vert_flag(edit_data, eve, data);
   }
 }
 
+static void extract_edit_data_finish(const MeshRenderData *UNUSED(mr),
+                                     void *UNUSED(buf),
+                                     void *_data)
+{
+  MeshExtract_EditData_Data *data = _data;
+  MEM_SAFE_FREE(data->vert_flags);
+  MEM_SAFE_FREE(data->edge_flags);
+  MEM_SAFE_FREE(data->face_flags);
+  MEM_freeN(data);
+}
+
 static const MeshExtract extract_edit_data = {
     extract_edit_data_init,
     NULL,
@@ -2606,7 +2902,7 @@ static const MeshExtract extract_edit_data = {
     extract_edit_data_ledge_mesh,
     extract_edit_data_lvert_bmesh,
     extract_edit_data_lvert_mesh,
-    NULL,
+    extract_edit_data_finish,
     0,
     true,
 };
@@ -4194,6 +4490,8 @@ static const MeshExtract extract_fdot_idx = {
 typedef struct ExtractTaskData {
   const MeshRenderData *mr;
   const MeshExtract *extract;
+  /** Name of the extracted buffer, for profiling. */
+  const char *name;
   eMRIterType iter_type;
   int start, end;
   /** Decremented each time a task is finished. */
@@ -4278,9 +4576,10 @@ BLI_INLINE void mesh_extract_iter(const MeshRenderData *mr,
   }
 }
 
-static void extract_run(TaskPool *__restrict UNUSED(pool), void *taskdata, int UNUSED(threadid))
+static void extract_run(TaskPool *__restrict UNUSED(pool), void *taskdata, int threadid)
 {
   ExtractTaskData *data = taskdata;
+  const double start = PIL_check_seconds_timer();
   mesh_extract_iter(
       data->mr, data->iter_type, data->start, data->end, data->extract, data->user_data);
 
@@ -4289,6 +4588,271 @@ static void extract_run(TaskPool *__restrict UNUSED(pool), void *taskdata, int U
   if (remainin_tasks == 0 && data->extract->finish != NULL) {
     data->extract->finish(data->mr, data->buf, data->user_data);
   }
+  DRW_stats_cpu_event_add(data->name, DRW_STATS_CATEGORY_EXTRACT, start, max_ii(threadid, 0));
+}
+
+/* Extractors which are iterated together in a single pass over the mesh elements, instead of
+ * each of them walking the loop, poly and edge arrays on its own. */
+typedef struct ExtractFusedItem {
+  const MeshExtract *extract;
+  const char *name;
+  eMRIterType iter_type;
+  void *buf;
+  void *user_data;
+} ExtractFusedItem;
+
+typedef struct ExtractFusedData {
+  const MeshRenderData *mr;
+  ExtractFusedItem *items;
+  int items_len;
+  eMRIterType iter_type;
+  /** Decremented each time a task is finished, the last one runs all finish functions. */
+  int32_t task_counter;
+} ExtractFusedData;
+
+typedef struct ExtractFusedTaskData {
+  ExtractFusedData *fused;
+  eMRIterType iter_type;
+  int start, end;
+} ExtractFusedTaskData;
+
+static bool use_fused_extraction = true;
+
+void mesh_buffer_cache_use_fused_extraction(const bool use_fused)
+{
+  use_fused_extraction = use_fused;
+}
+
+static ExtractFusedData *extract_fused_data_create(const MeshRenderData *mr, const int items_max)
+{
+  ExtractFusedData *fused = MEM_callocN(sizeof(*fused), __func__);
+  fused->mr = mr;
+  fused->items = MEM_mallocN(sizeof(*fused->items) * items_max, __func__);
+  return fused;
+}
+
+static void extract_fused_data_free(ExtractFusedData *fused)
+{
+  MEM_freeN(fused->items);
+  MEM_freeN(fused);
+}
+
+static void extract_fused_add(ExtractFusedData *fused,
+                              const MeshExtract *extract,
+                              const char *name,
+                              void *buf)
+{
+  const double start = PIL_check_seconds_timer();
+  ExtractFusedItem *item = &fused->items[fused->items_len++];
+  item->extract = extract;
+  item->name = name;
+  item->iter_type = mesh_extract_iter_type(extract);
+  item->buf = buf;
+  item->user_data = extract->init(fused->mr, buf);
+  fused->iter_type |= item->iter_type;
+  DRW_stats_cpu_event_add(name, DRW_STATS_CATEGORY_EXTRACT, start, 0);
+}
+
+BLI_INLINE void mesh_extract_fused_iter(const ExtractFusedData *fused,
+                                        const eMRIterType iter_type,
+                                        int start,
+                                        int end)
+{
+  const MeshRenderData *mr = fused->mr;
+  const ExtractFusedItem *items = fused->items;
+  const int items_len = fused->items_len;
+
+  switch (mr->extract_type) {
+    case MR_EXTRACT_BMESH:
+      if (iter_type & MR_ITER_LOOPTRI) {
+        int t_end = min_ii(mr->tri_len, end);
+        for (int t = start; t < t_end; t++) {
+          BMLoop **elt = &mr->edit_bmesh->looptris[t][0];
+          for (int i = 0; i < items_len; i++) {
+            if (items[i].iter_type & MR_ITER_LOOPTRI) {
+              items[i].extract->iter_looptri_bm(mr, t, elt, items[i].user_data);
+            }
+          }
+        }
+      }
+      if (iter_type & MR_ITER_LOOP) {
+        int l_end = min_ii(mr->poly_len, end);
+        for (int f = start; f < l_end; f++) {
+          BMFace *efa = BM_face_at_index(mr->bm, f);
+          BMLoop *loop;
+          BMIter l_iter;
+          BM_ITER_ELEM (loop, &l_iter, efa, BM_LOOPS_OF_FACE) {
+            const int l = BM_elem_index_get(loop);
+            for (int i = 0; i < items_len; i++) {
+              if (items[i].iter_type & MR_ITER_LOOP) {
+                items[i].extract->iter_loop_bm(mr, l, loop, items[i].user_data);
+              }
+            }
+          }
+        }
+      }
+      if (iter_type & MR_ITER_LEDGE) {
+        int le_end = min_ii(mr->edge_loose_len, end);
+        for (int e = start; e < le_end; e++) {
+          BMEdge *eed = BM_edge_at_index(mr->bm, mr->ledges[e]);
+          for (int i = 0; i < items_len; i++) {
+            if (items[i].iter_type & MR_ITER_LEDGE) {
+              items[i].extract->iter_ledge_bm(mr, e, eed, items[i].user_data);
+            }
+          }
+        }
+      }
+      if (iter_type & MR_ITER_LVERT) {
+        int lv_end = min_ii(mr->vert_loose_len, end);
+        for (int v = start; v < lv_end; v++) {
+          BMVert *eve = BM_vert_at_index(mr->bm, mr->lverts[v]);
+          for (int i = 0; i < items_len; i++) {
+            if (items[i].iter_type & MR_ITER_LVERT) {
+              items[i].extract->iter_lvert_bm(mr, v, eve, items[i].user_data);
+            }
+          }
+        }
+      }
+      break;
+    case MR_EXTRACT_MAPPED:
+    case MR_EXTRACT_MESH:
+      if (iter_type & MR_ITER_LOOPTRI) {
+        int t_end = min_ii(mr->tri_len, end);
+        for (int t = start; t < t_end; t++) {
+          const MLoopTri *mlt = &mr->mlooptri[t];
+          for (int i = 0; i < items_len; i++) {
+            if (items[i].iter_type & MR_ITER_LOOPTRI) {
+              items[i].extract->iter_looptri(mr, t, mlt, items[i].user_data);
+            }
+          }
+        }
+      }
+      if (iter_type & MR_ITER_LOOP) {
+        int l_end = min_ii(mr->poly_len, end);
+        for (int p = start; p < l_end; p++) {
+          const MPoly *mpoly = &mr->mpoly[p];
+          int l = mpoly->loopstart;
+          for (int j = 0; j < mpoly->totloop; j++, l++) {
+            const MLoop *mloop = &mr->mloop[l];
+            for (int i = 0; i < items_len; i++) {
+              if (items[i].iter_type & MR_ITER_LOOP) {
+                items[i].extract->iter_loop(mr, l, mloop, p, mpoly, items[i].user_data);
+              }
+            }
+          }
+        }
+      }
+      if (iter_type & MR_ITER_LEDGE) {
+        int le_end = min_ii(mr->edge_loose_len, end);
+        for (int e = start; e < le_end; e++) {
+          const MEdge *medge = &mr->medge[mr->ledges[e]];
+          for (int i = 0; i < items_len; i++) {
+            if (items[i].iter_type & MR_ITER_LEDGE) {
+              items[i].extract->iter_ledge(mr, e, medge, items[i].user_data);
+            }
+          }
+        }
+      }
+      if (iter_type & MR_ITER_LVERT) {
+        int lv_end = min_ii(mr->vert_loose_len, end);
+        for (int v = start; v < lv_end; v++) {
+          const MVert *mvert = &mr->mvert[mr->lverts[v]];
+          for (int i = 0; i < items_len; i++) {
+            if (items[i].iter_type & MR_ITER_LVERT) {
+              items[i].extract->iter_lvert(mr, v, mvert, items[i].user_data);
+            }
+          }
+        }
+      }
+      break;
+  }
+}
+
+static void extract_fused_finish(ExtractFusedData *fused, const int thread_id)
+{
+  for (int i = 0; i < fused->items_len; i++) {
+    const ExtractFusedItem *item = &fused->items[i];
+    if (item->extract->finish != NULL) {
+      const double start = PIL_check_seconds_timer();
+      item->extract->finish(fused->mr, item->buf, item->user_data);
+      DRW_stats_cpu_event_add(item->name, DRW_STATS_CATEGORY_EXTRACT, start, thread_id);
+    }
+  }
+  extract_fused_data_free(fused);
+}
+
+static void extract_fused_run(TaskPool *__restrict UNUSED(pool), void *taskdata, int threadid)
+{
+  ExtractFusedTaskData *data = taskdata;
+  ExtractFusedData *fused = data->fused;
+  /* The iteration is shared by all fused extractors and cannot be attributed to one of them. */
+  const double start = PIL_check_seconds_timer();
+  mesh_extract_fused_iter(fused, data->iter_type, data->start, data->end);
+  DRW_stats_cpu_event_add("Fused", DRW_STATS_CATEGORY_EXTRACT, start, threadid);
+
+  /* If this is the last task, we do the finish functions. */
+  int remainin_tasks = atomic_sub_and_fetch_int32(&fused->task_counter, 1);
+  if (remainin_tasks == 0) {
+    extract_fused_finish(fused, threadid);
+  }
+}
+
+static void extract_fused_range_task_create(TaskPool *task_pool,
+                                            ExtractFusedData *fused,
+                                            const eMRIterType type,
+                                            int start,
+                                            int length)
+{
+  ExtractFusedTaskData *taskdata = MEM_mallocN(sizeof(*taskdata), "ExtractFusedTaskData");
+  taskdata->fused = fused;
+  taskdata->iter_type = type;
+  taskdata->start = start;
+  taskdata->end = start + length;
+  BLI_task_pool_push(task_pool, extract_fused_run, taskdata, true, TASK_PRIORITY_HIGH);
+}
+
+/* Takes ownership of the fused data. */
+static void extract_fused_task_create(TaskPool *task_pool, ExtractFusedData *fused)
+{
+  const MeshRenderData *mr = fused->mr;
+  if (fused->items_len == 0) {
+    extract_fused_data_free(fused);
+    return;
+  }
+
+  const bool use_thread = (mr->loop_len + mr->loop_loose_len) > 8192;
+  if (!use_thread) {
+    /* Single threaded extraction. */
+    const double start = PIL_check_seconds_timer();
+    mesh_extract_fused_iter(fused, fused->iter_type, 0, INT_MAX);
+    DRW_stats_cpu_event_add("Fused", DRW_STATS_CATEGORY_EXTRACT, start, 0);
+    extract_fused_finish(fused, 0);
+    return;
+  }
+
+  /* Count the tasks before pushing them, the counter must not reach zero before all of them
+   * are in the pool. */
+  const int chunk_size = 8192;
+  const int elem_len[4] = {mr->tri_len, mr->poly_len, mr->edge_loose_len, mr->vert_loose_len};
+  const eMRIterType elem_type[4] = {MR_ITER_LOOPTRI, MR_ITER_LOOP, MR_ITER_LEDGE, MR_ITER_LVERT};
+  int task_len = 0;
+  for (int i = 0; i < 4; i++) {
+    if (fused->iter_type & elem_type[i]) {
+      task_len += (elem_len[i] + chunk_size - 1) / chunk_size;
+    }
+  }
+  if (task_len == 0) {
+    extract_fused_finish(fused, 0);
+    return;
+  }
+  fused->task_counter = task_len;
+  for (int i = 0; i < 4; i++) {
+    if (fused->iter_type & elem_type[i]) {
+      for (int start = 0; start < elem_len[i]; start += chunk_size) {
+        extract_fused_range_task_create(task_pool, fused, elem_type[i], start, chunk_size);
+      }
+    }
+  }
 }
 
 static void extract_range_task_create(
@@ -4305,22 +4869,35 @@ static void extract_range_task_create(
 static void extract_task_create(TaskPool *task_pool,
                                 const MeshRenderData *mr,
                                 const MeshExtract *extract,
+                                const char *name,
                                 void *buf,
+                                ExtractFusedData *fused,
                                 int32_t *task_counter)
 {
+  /* Simple heuristic. */
+  const bool use_thread = (mr->loop_len + mr->loop_loose_len) > 8192;
+
+  /* Iterate together with other extractors. Extractors which are not thread-safe still get
+   * their own task when threading, so they can run in parallel to each other. */
+  if (fused != NULL && (extract->use_threading || !use_thread)) {
+    extract_fused_add(fused, extract, name, buf);
+    return;
+  }
+
   /* Divide extraction of the VBO/IBO into sensible chunks of works. */
+  const double start = PIL_check_seconds_timer();
   ExtractTaskData *taskdata = MEM_mallocN(sizeof(*taskdata), "ExtractTaskData");
   taskdata->mr = mr;
   taskdata->extract = extract;
+  taskdata->name = name;
   taskdata->buf = buf;
   taskdata->user_data = extract->init(mr, buf);
+  DRW_stats_cpu_event_add(name, DRW_STATS_CATEGORY_EXTRACT, start, 0);
   taskdata->iter_type = mesh_extract_iter_type(extract);
   taskdata->task_counter = task_counter;
   taskdata->start = 0;
   taskdata->end = INT_MAX;
 
-  /* Simple heuristic. */
-  const bool use_thread = (mr->loop_len + mr->loop_loose_len) > 8192;
   if (use_thread && extract->use_threading) {
     /* Divide task into sensible chunks. */
     const int chunk_size = 8192;
@@ -4404,6 +4981,8 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   TEST_ASSIGN(VBO, vbo, skin_roots);
 
   TEST_ASSIGN(IBO, ibo, tris);
+  TEST_ASSIGN(IBO, ibo, tris_lod1);
+  TEST_ASSIGN(IBO, ibo, tris_lod2);
   TEST_ASSIGN(IBO, ibo, lines);
   TEST_ASSIGN(IBO, ibo, points);
   TEST_ASSIGN(IBO, ibo, fdots);
@@ -4421,8 +5000,10 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   double rdata_start = PIL_check_seconds_timer();
 #endif
 
+  const double mr_start = PIL_check_seconds_timer();
   MeshRenderData *mr = mesh_render_data_create(
       me, do_final, do_uvedit, iter_flag, data_flag, cd_layer_used, ts);
+  DRW_stats_cpu_event_add("Render Data", DRW_STATS_CATEGORY_EXTRACT, mr_start, 0);
   mr->cache = cache; /* HACK */
   mr->use_hide = use_hide;
   mr->use_subsurf_fdots = use_subsurf_fdots;
@@ -4442,10 +5023,19 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   int32_t *task_counters = MEM_callocN(counters_size, __func__);
   int counter_used = 0;
 
+  ExtractFusedData *fused = use_fused_extraction ?
+                                extract_fused_data_create(mr, sizeof(mbc) / sizeof(void *)) :
+                                NULL;
+
 #define EXTRACT(buf, name) \
   if (mbc.buf.name) { \
-    extract_task_create( \
-        task_pool, mr, &extract_##name, mbc.buf.name, &task_counters[counter_used++]); \
+    extract_task_create(task_pool, \
+                        mr, \
+                        &extract_##name, \
+                        #name, \
+                        mbc.buf.name, \
+                        fused, \
+                        &task_counters[counter_used++]); \
   } \
   ((void)0)
 
@@ -4473,6 +5063,8 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   EXTRACT(vbo, skin_roots);
 
   EXTRACT(ibo, tris);
+  EXTRACT(ibo, tris_lod1);
+  EXTRACT(ibo, tris_lod2);
   EXTRACT(ibo, lines);
   EXTRACT(ibo, points);
   EXTRACT(ibo, fdots);
@@ -4483,6 +5075,11 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   EXTRACT(ibo, edituv_points);
   EXTRACT(ibo, edituv_fdots);
 
+  if (fused != NULL) {
+    extract_fused_task_create(task_pool, fused);
+    fused = NULL;
+  }
+
   /* TODO(fclem) Ideally, we should have one global pool for all
    * objects and wait for finish only before drawing when buffers
    * need to be ready. */
@@ -558,6 +558,40 @@ static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache *cache)
   cache->batch_ready &= ~MBC_EDITUV;
 }
 
+/* Vertex positions changed: discard what depends on them, keep the index buffers and the
+ * attributes which only depend on the topology. */
+static void mesh_batch_cache_discard_deform(MeshBatchCache *cache)
+{
+  FOREACH_MESH_BUFFER_CACHE(cache, mbufcache)
+  {
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.pos_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.lnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.skin_roots);
+    /* Triangulation of n-gons and concave quads depends on vertex positions. */
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.tris);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.tris_lod1);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.tris_lod2);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.lines_adjacency);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.edituv_tris);
+  }
+  /* Almost every batch uses one of the buffers above. */
+  for (int i = 0; i < sizeof(cache->batch) / sizeof(void *); i++) {
+    GPUBatch **batch = (GPUBatch **)&cache->batch;
+    GPU_BATCH_DISCARD_SAFE(batch[i]);
+  }
+  mesh_batch_cache_discard_shaded_batches(cache);
+
+  cache->tot_area = 0.0f;
+  cache->batch_ready = 0;
+}
+
 void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
 {
   MeshBatchCache *cache = me->runtime.batch_cache;
@@ -597,6 +631,8 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
         GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.lnor);
       }
       GPU_BATCH_DISCARD_SAFE(cache->batch.surface);
+      GPU_BATCH_DISCARD_SAFE(cache->batch.surface_lod1);
+      GPU_BATCH_DISCARD_SAFE(cache->batch.surface_lod2);
       GPU_BATCH_DISCARD_SAFE(cache->batch.wire_loops);
       GPU_BATCH_DISCARD_SAFE(cache->batch.wire_edges);
       if (cache->surface_per_mat) {
@@ -604,7 +640,8 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
           GPU_BATCH_DISCARD_SAFE(cache->surface_per_mat[i]);
         }
       }
-      cache->batch_ready &= ~(MBC_SURFACE | MBC_WIRE_EDGES | MBC_WIRE_LOOPS | MBC_SURF_PER_MAT);
+      cache->batch_ready &= ~(MBC_SURFACE | MBC_SURFACE_LOD1 | MBC_SURFACE_LOD2 | MBC_WIRE_EDGES |
+                              MBC_WIRE_LOOPS | MBC_SURF_PER_MAT);
       break;
     case BKE_MESH_BATCH_DIRTY_ALL:
       cache->is_dirty = true;
@@ -616,6 +653,9 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
     case BKE_MESH_BATCH_DIRTY_UVEDIT_ALL:
       mesh_batch_cache_discard_uvedit(cache);
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      mesh_batch_cache_discard_deform(cache);
+      break;
     case BKE_MESH_BATCH_DIRTY_UVEDIT_SELECT:
       FOREACH_MESH_BUFFER_CACHE(cache, mbufcache)
       {
@@ -724,6 +764,25 @@ GPUBatch *DRW_mesh_batch_cache_get_surface(Mesh *me)
   return DRW_batch_request(&cache->batch.surface);
 }
 
+/* Simplified surface for a mesh covering screen_size pixels. The simplification is
+ * invisible while the grid cells are not larger than a couple of pixels. */
+GPUBatch *DRW_mesh_batch_cache_get_surface_lod(Mesh *me, const float screen_size)
+{
+  const float cell_pixel_size = 2.0f;
+  if (me->edit_mesh == NULL) {
+    MeshBatchCache *cache = mesh_batch_cache_get(me);
+    if (screen_size <= MESH_LOD2_GRID_RES * cell_pixel_size) {
+      mesh_batch_cache_add_request(cache, MBC_SURFACE_LOD2);
+      return DRW_batch_request(&cache->batch.surface_lod2);
+    }
+    if (screen_size <= MESH_LOD1_GRID_RES * cell_pixel_size) {
+      mesh_batch_cache_add_request(cache, MBC_SURFACE_LOD1);
+      return DRW_batch_request(&cache->batch.surface_lod1);
+    }
+  }
+  return DRW_mesh_batch_cache_get_surface(me);
+}
+
 GPUBatch *DRW_mesh_batch_cache_get_loose_edges(Mesh *me)
 {
   MeshBatchCache *cache = mesh_batch_cache_get(me);
@@ -1220,6 +1279,16 @@ void DRW_mesh_batch_cache_create_requested(
       DRW_vbo_request(cache->batch.surface, &mbufcache->vbo.vcol);
     }
   }
+  if (DRW_batch_requested(cache->batch.surface_lod1, GPU_PRIM_TRIS)) {
+    DRW_ibo_request(cache->batch.surface_lod1, &mbufcache->ibo.tris_lod1);
+    DRW_vbo_request(cache->batch.surface_lod1, &mbufcache->vbo.lnor);
+    DRW_vbo_request(cache->batch.surface_lod1, &mbufcache->vbo.pos_nor);
+  }
+  if (DRW_batch_requested(cache->batch.surface_lod2, GPU_PRIM_TRIS)) {
+    DRW_ibo_request(cache->batch.surface_lod2, &mbufcache->ibo.tris_lod2);
+    DRW_vbo_request(cache->batch.surface_lod2, &mbufcache->vbo.lnor);
+    DRW_vbo_request(cache->batch.surface_lod2, &mbufcache->vbo.pos_nor);
+  }
   if (DRW_batch_requested(cache->batch.all_verts, GPU_PRIM_POINTS)) {
     DRW_vbo_request(cache->batch.all_verts, &mbufcache->vbo.pos_nor);
   }
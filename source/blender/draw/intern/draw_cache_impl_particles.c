@@ -28,6 +28,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_utildefines.h"
+#include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
 #include "BLI_ghash.h"
@@ -37,6 +38,7 @@
 #include "DNA_modifier_types.h"
 #include "DNA_particle_types.h"
 #include "DNA_customdata_types.h"
+#include "DNA_texture_types.h"
 
 #include "BKE_mesh.h"
 #include "BKE_particle.h"
@@ -190,6 +192,9 @@ static void particle_batch_cache_clear_hair(ParticleHairCache *hair_cache)
   DRW_TEXTURE_FREE_SAFE(hair_cache->strand_tex);
   DRW_TEXTURE_FREE_SAFE(hair_cache->strand_seg_tex);
 
+  GPU_VERTBUF_DISCARD_SAFE(hair_cache->proc_child_buf);
+  DRW_TEXTURE_FREE_SAFE(hair_cache->child_tex);
+
   for (int i = 0; i < MAX_MTFACE; i++) {
     GPU_VERTBUF_DISCARD_SAFE(hair_cache->proc_uv_buf[i]);
     DRW_TEXTURE_FREE_SAFE(hair_cache->uv_tex[i]);
@@ -250,6 +255,84 @@ static void count_cache_segment_keys(ParticleCacheKey **pathcache,
   }
 }
 
+/* Interpolated children which only depend on the parent strands and on constant per child data
+ * are interpolated by the hair refine shader, only the parents are uploaded then. Children using
+ * kink, noise, effectors, parting, textures or vertex groups are still drawn from the CPU cache. */
+static bool particle_hair_use_gpu_children(ParticleSystem *psys)
+{
+  const ParticleSettings *part = psys->part;
+  const int child_vgroups[] = {PSYS_VG_LENGTH,
+                               PSYS_VG_CLUMP,
+                               PSYS_VG_KINK,
+                               PSYS_VG_ROUGH1,
+                               PSYS_VG_ROUGH2,
+                               PSYS_VG_ROUGHE,
+                               PSYS_VG_EFFECTOR,
+                               PSYS_VG_TWIST};
+
+  if (psys->pathcache == NULL || psys->childcache == NULL) {
+    return false;
+  }
+  if (psys_in_edit_mode(DRW_context_state_get()->depsgraph, psys)) {
+    return false;
+  }
+  if (part->childtype != PART_CHILD_FACES || part->parents != 0.0f || part->parting_fac != 0.0f) {
+    return false;
+  }
+  if ((part->flag & (PART_CHILD_EFFECT | PART_CHILD_LONG_HAIR)) ||
+      (part->child_flag & (PART_CHILD_USE_CLUMP_NOISE | PART_CHILD_USE_CLUMP_CURVE |
+                           PART_CHILD_USE_ROUGH_CURVE))) {
+    return false;
+  }
+  if (part->kink != PART_KINK_NO || part->rough1 != 0.0f || part->rough2 != 0.0f) {
+    return false;
+  }
+  for (int i = 0; i < ARRAY_SIZE(child_vgroups); i++) {
+    if (psys->vgroup[child_vgroups[i]] != 0) {
+      return false;
+    }
+  }
+  for (int i = 0; i < ARRAY_SIZE(part->mtex); i++) {
+    const MTex *mtex = part->mtex[i];
+    if (mtex && mtex->tex && (mtex->mapto & (PAMAP_DENS | PAMAP_CHILD))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void ensure_procedural_count(PTCacheEdit *edit,
+                                    ParticleSystem *psys,
+                                    ParticleHairCache *hair_cache)
+{
+  hair_cache->proc_parents_len = hair_cache->strands_len;
+  hair_cache->proc_point_len = hair_cache->point_len;
+  hair_cache->proc_children_len = 0;
+
+  if (edit != NULL || !particle_hair_use_gpu_children(psys)) {
+    return;
+  }
+
+  int parents_len = 0, point_len = 0, children_len = 0;
+  for (int i = 0; i < psys->totpart; i++) {
+    if (psys->pathcache[i]->segments > 0) {
+      parents_len++;
+      point_len += psys->pathcache[i]->segments + 1;
+    }
+  }
+  const int child_count = psys->totchild * psys->part->disp / 100;
+  for (int i = 0; i < child_count; i++) {
+    if (psys->childcache[i]->segments > 0) {
+      children_len++;
+    }
+  }
+  if (children_len > 0) {
+    hair_cache->proc_parents_len = parents_len;
+    hair_cache->proc_point_len = point_len;
+    hair_cache->proc_children_len = children_len;
+  }
+}
+
 static void ensure_seg_pt_count(PTCacheEdit *edit,
                                 ParticleSystem *psys,
                                 ParticleHairCache *hair_cache)
@@ -275,6 +358,8 @@ static void ensure_seg_pt_count(PTCacheEdit *edit,
       count_cache_segment_keys(psys->childcache, child_count, hair_cache);
     }
   }
+
+  ensure_procedural_count(edit, psys, hair_cache);
 }
 
 static void particle_pack_mcol(MCol *mcol, ushort r_scol[3])
@@ -762,9 +847,12 @@ static int particle_batch_cache_fill_strands_data(ParticleSystem *psys,
       continue;
     }
 
-    *(uint *)GPU_vertbuf_raw_step(data_step) = curr_point;
-    *(ushort *)GPU_vertbuf_raw_step(seg_step) = path->segments;
-    curr_point += path->segments + 1;
+    /* Children interpolated on the GPU are not in the control points. */
+    if (data_step != NULL) {
+      *(uint *)GPU_vertbuf_raw_step(data_step) = curr_point;
+      *(ushort *)GPU_vertbuf_raw_step(seg_step) = path->segments;
+      curr_point += path->segments + 1;
+    }
 
     if (psmd != NULL) {
       float(*uv)[2] = NULL;
@@ -881,11 +969,11 @@ static void particle_batch_cache_ensure_procedural_strand_data(PTCacheEdit *edit
 
   /* Strand Data */
   cache->proc_strand_buf = GPU_vertbuf_create_with_format(&format_data);
-  GPU_vertbuf_data_alloc(cache->proc_strand_buf, cache->strands_len);
+  GPU_vertbuf_data_alloc(cache->proc_strand_buf, cache->proc_parents_len);
   GPU_vertbuf_attr_get_raw_data(cache->proc_strand_buf, data_id, &data_step);
 
   cache->proc_strand_seg_buf = GPU_vertbuf_create_with_format(&format_seg);
-  GPU_vertbuf_data_alloc(cache->proc_strand_seg_buf, cache->strands_len);
+  GPU_vertbuf_data_alloc(cache->proc_strand_seg_buf, cache->proc_parents_len);
   GPU_vertbuf_attr_get_raw_data(cache->proc_strand_seg_buf, seg_id, &seg_step);
 
   /* UV layers */
@@ -964,11 +1052,14 @@ static void particle_batch_cache_ensure_procedural_strand_data(PTCacheEdit *edit
                                            cache->num_col_layers);
   }
   else {
+    const bool gpu_children = cache->proc_children_len > 0;
+    const bool draw_parents = (psys->pathcache != NULL) &&
+                              (!psys->childcache || (psys->part->draw & PART_DRAW_PARENT));
     int curr_point = 0;
-    if ((psys->pathcache != NULL) &&
-        (!psys->childcache || (psys->part->draw & PART_DRAW_PARENT))) {
+    if (draw_parents || gpu_children) {
+      /* Parents are always needed by the GPU children, without their custom data when hidden. */
       curr_point = particle_batch_cache_fill_strands_data(psys,
-                                                          psmd,
+                                                          draw_parents ? psmd : NULL,
                                                           psys->pathcache,
                                                           PARTICLE_SOURCE_PARENT,
                                                           0,
@@ -992,8 +1083,8 @@ static void particle_batch_cache_ensure_procedural_strand_data(PTCacheEdit *edit
                                                           PARTICLE_SOURCE_CHILDREN,
                                                           curr_point,
                                                           child_count,
-                                                          &data_step,
-                                                          &seg_step,
+                                                          gpu_children ? NULL : &data_step,
+                                                          gpu_children ? NULL : &seg_step,
                                                           &parent_uvs,
                                                           uv_step,
                                                           (MTFace **)mtfaces,
@@ -1100,7 +1191,7 @@ static void particle_batch_cache_ensure_procedural_pos(PTCacheEdit *edit,
   uint pos_id = GPU_vertformat_attr_add(&format, "posTime", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
 
   cache->proc_point_buf = GPU_vertbuf_create_with_format(&format);
-  GPU_vertbuf_data_alloc(cache->proc_point_buf, cache->point_len);
+  GPU_vertbuf_data_alloc(cache->proc_point_buf, cache->proc_point_len);
 
   GPUVertBufRaw pos_step;
   GPU_vertbuf_attr_get_raw_data(cache->proc_point_buf, pos_id, &pos_step);
@@ -1108,6 +1199,9 @@ static void particle_batch_cache_ensure_procedural_pos(PTCacheEdit *edit,
   if (edit != NULL && edit->pathcache != NULL) {
     particle_batch_cache_fill_segments_proc_pos(edit->pathcache, edit->totcached, &pos_step);
   }
+  else if (cache->proc_children_len > 0) {
+    particle_batch_cache_fill_segments_proc_pos(psys->pathcache, psys->totpart, &pos_step);
+  }
   else {
     if ((psys->pathcache != NULL) &&
         (!psys->childcache || (psys->part->draw & PART_DRAW_PARENT))) {
@@ -1125,6 +1219,125 @@ static void particle_batch_cache_ensure_procedural_pos(PTCacheEdit *edit,
   cache->point_tex = GPU_texture_create_from_vertbuf(cache->proc_point_buf);
 }
 
+/* Per child data used by hair_child_point() in the refine shader, gathers the same parameters
+ * as the interpolated children branch of psys_thread_create_path(). */
+static void particle_batch_cache_ensure_procedural_children(Object *object,
+                                                            ParticleSystem *psys,
+                                                            ModifierData *md,
+                                                            ParticleHairCache *cache)
+{
+  if (cache->proc_child_buf != NULL || cache->proc_children_len == 0) {
+    return;
+  }
+
+  ParticleSystemModifierData *psmd = (ParticleSystemModifierData *)md;
+  Mesh *mesh = (psmd != NULL) ? psmd->mesh_final : NULL;
+  ParticleSettings *part = psys->part;
+  const int child_count = psys->totchild * part->disp / 100;
+
+  /* Parents are stored without the ones having no segments. */
+  int *parent_strands = MEM_mallocN(sizeof(*parent_strands) * psys->totpart, __func__);
+  for (int i = 0, strand = 0; i < psys->totpart; i++) {
+    parent_strands[i] = (psys->pathcache[i]->segments > 0) ? strand++ : -1;
+  }
+
+  GPUVertFormat format = {0};
+  uint data_id = GPU_vertformat_attr_add(&format, "data", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+
+  cache->proc_child_buf = GPU_vertbuf_create_with_format(&format);
+  GPU_vertbuf_data_alloc(cache->proc_child_buf, cache->proc_children_len * 4);
+
+  GPUVertBufRaw data_step;
+  GPU_vertbuf_attr_get_raw_data(cache->proc_child_buf, data_id, &data_step);
+
+  if (mesh != NULL) {
+    BKE_mesh_tessface_ensure(mesh);
+  }
+
+  for (int i = 0; i < child_count; i++) {
+    if (psys->childcache[i]->segments <= 0) {
+      continue;
+    }
+    ChildParticle *cpa = &psys->child[i];
+    float *parents = (float *)GPU_vertbuf_raw_step(&data_step);
+    float *weights = (float *)GPU_vertbuf_raw_step(&data_step);
+    float *offset_length = (float *)GPU_vertbuf_raw_step(&data_step);
+    float *rough_clump = (float *)GPU_vertbuf_raw_step(&data_step);
+
+    float co[3] = {0.0f};
+    if (mesh != NULL) {
+      psys_particle_on_emitter(psmd,
+                               PART_FROM_FACE,
+                               cpa->num,
+                               DMCACHE_ISCHILD,
+                               cpa->fuv,
+                               cpa->foffset,
+                               co,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL);
+      mul_m4_v3(object->obmat, co);
+    }
+
+    /* Root offset: weighted sum of the distances to the parent roots. */
+    zero_v3(offset_length);
+    for (int w = 0; w < 4; w++) {
+      const int pa = cpa->pa[w];
+      if (pa >= 0 && parent_strands[pa] != -1) {
+        parents[w] = (float)parent_strands[pa];
+        weights[w] = cpa->w[w];
+        float off[3];
+        sub_v3_v3v3(off, co, psys->pathcache[pa]->co);
+        madd_v3_v3fl(offset_length, off, weights[w]);
+      }
+      else {
+        parents[w] = 0.0f;
+        weights[w] = 0.0f;
+      }
+    }
+
+    /* The child modifiers are only applied with an existing parent,
+     * see psys_thread_create_path(). */
+    int parent = cpa->parent;
+    for (int k = 0; k < 4 && parent >= 0 && (psys->particles[parent].flag & PARS_UNEXIST); k++) {
+      if (cpa->pa[k] >= 0) {
+        parent = cpa->pa[k];
+      }
+    }
+    if (parent >= 0 && (psys->particles[parent].flag & PARS_UNEXIST)) {
+      parent = -1;
+    }
+
+    offset_length[3] = 1.0f;
+    zero_v3(rough_clump);
+    rough_clump[3] = -1.0f;
+    if (parent >= 0) {
+      /* Same as the child length of get_cpa_texture(). */
+      offset_length[3] = 1.0f - part->randlength * psys_frand(psys, i + 26);
+      offset_length[3] *= part->clength_thres < psys_frand(psys, i + 27) ? part->clength : 1.0f;
+
+      /* End roughness only depends on the random vector of the child, see do_rough_end(). */
+      if (part->rough_end != 0.0f && mesh != NULL && cpa->pa[0] >= 0) {
+        float vec[3], hairmat[4][4];
+        psys_frand_vec(psys, i + 27, vec);
+        psys_mat_hair_to_global(
+            object, mesh, part->from, psys->particles + cpa->pa[0], hairmat);
+        madd_v3_v3fl(rough_clump, hairmat[0], part->rough_end * (-1.0f + 2.0f * vec[0]));
+        madd_v3_v3fl(rough_clump, hairmat[1], part->rough_end * (-1.0f + 2.0f * vec[1]));
+      }
+
+      rough_clump[3] = (float)parent_strands[parent];
+    }
+  }
+
+  MEM_freeN(parent_strands);
+
+  /* Create vbo immediately to bind to texture buffer. */
+  GPU_vertbuf_use(cache->proc_child_buf);
+  cache->child_tex = GPU_texture_create_from_vertbuf(cache->proc_child_buf);
+}
+
 static void particle_batch_cache_ensure_pos_and_seg(PTCacheEdit *edit,
                                                     ParticleSystem *psys,
                                                     ModifierData *md,
@@ -1676,6 +1889,8 @@ bool particles_ensure_procedural_data(Object *object,
   if ((*r_hair_cache)->proc_point_buf == NULL) {
     ensure_seg_pt_count(source.edit, source.psys, &cache->hair);
     particle_batch_cache_ensure_procedural_pos(source.edit, source.psys, &cache->hair);
+    particle_batch_cache_ensure_procedural_children(
+        source.object, source.psys, source.md, &cache->hair);
     need_ft_update = true;
   }
 
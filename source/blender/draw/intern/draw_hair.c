@@ -45,6 +45,8 @@
 
 typedef enum ParticleRefineShader {
   PART_REFINE_CATMULL_ROM = 0,
+  /* Also interpolates the children from their parents. */
+  PART_REFINE_CATMULL_ROM_CHILDREN,
   PART_REFINE_MAX_SHADER,
 } ParticleRefineShader;
 
@@ -77,17 +79,20 @@ static GPUShader *hair_refine_shader_get(ParticleRefineShader sh)
 
   char *vert_with_lib = BLI_string_joinN(datatoc_common_hair_lib_glsl,
                                          datatoc_common_hair_refine_vert_glsl);
+  const char *defines = (sh == PART_REFINE_CATMULL_ROM_CHILDREN) ?
+                            "#define HAIR_PHASE_SUBDIV\n"
+                            "#define HAIR_CHILDREN\n" :
+                            "#define HAIR_PHASE_SUBDIV\n";
 
 #ifdef USE_TRANSFORM_FEEDBACK
   const char *var_names[1] = {"finalColor"};
   g_refine_shaders[sh] = DRW_shader_create_with_transform_feedback(
-      vert_with_lib, NULL, "#define HAIR_PHASE_SUBDIV\n", GPU_SHADER_TFB_POINTS, var_names, 1);
+      vert_with_lib, NULL, defines, GPU_SHADER_TFB_POINTS, var_names, 1);
 #else
-  g_refine_shaders[sh] = DRW_shader_create(vert_with_lib,
-                                           NULL,
-                                           datatoc_gpu_shader_3D_smooth_color_frag_glsl,
-                                           "#define HAIR_PHASE_SUBDIV\n"
-                                           "#define TF_WORKAROUND\n");
+  char *defines_workaround = BLI_string_joinN(defines, "#define TF_WORKAROUND\n");
+  g_refine_shaders[sh] = DRW_shader_create(
+      vert_with_lib, NULL, datatoc_gpu_shader_3D_smooth_color_frag_glsl, defines_workaround);
+  MEM_freeN(defines_workaround);
 #endif
 
   MEM_freeN(vert_with_lib);
@@ -202,7 +207,9 @@ static DRWShadingGroup *drw_shgroup_create_hair_procedural_ex(Object *object,
   if (need_ft_update) {
     int final_points_len = hair_cache->final[subdiv].strands_res * hair_cache->strands_len;
     if (final_points_len) {
-      GPUShader *tf_shader = hair_refine_shader_get(PART_REFINE_CATMULL_ROM);
+      const bool gpu_children = hair_cache->proc_children_len > 0;
+      GPUShader *tf_shader = hair_refine_shader_get(
+          gpu_children ? PART_REFINE_CATMULL_ROM_CHILDREN : PART_REFINE_CATMULL_ROM);
 
 #ifdef USE_TRANSFORM_FEEDBACK
       DRWShadingGroup *tf_shgrp = DRW_shgroup_transform_feedback_create(
@@ -226,6 +233,17 @@ static DRWShadingGroup *drw_shgroup_create_hair_procedural_ex(Object *object,
       DRW_shgroup_uniform_texture(tf_shgrp, "hairStrandSegBuffer", hair_cache->strand_seg_tex);
       DRW_shgroup_uniform_int(
           tf_shgrp, "hairStrandsRes", &hair_cache->final[subdiv].strands_res, 1);
+      if (gpu_children) {
+        /* Same clump exponent as do_clump_level(). */
+        const float clump_pow = (part->clumppow < 0.0f) ? 1.0f + part->clumppow :
+                                                          1.0f + 9.0f * part->clumppow;
+        DRW_shgroup_uniform_texture(tf_shgrp, "hairChildBuffer", hair_cache->child_tex);
+        DRW_shgroup_uniform_int_copy(
+            tf_shgrp, "hairChildStart", hair_cache->strands_len - hair_cache->proc_children_len);
+        DRW_shgroup_uniform_float_copy(tf_shgrp, "hairClumpFac", part->clumpfac);
+        DRW_shgroup_uniform_float_copy(tf_shgrp, "hairClumpPow", clump_pow);
+        DRW_shgroup_uniform_float_copy(tf_shgrp, "hairRoughEndShape", part->rough_end_shape);
+      }
       DRW_shgroup_call_procedural_points(tf_shgrp, NULL, final_points_len);
     }
   }
@@ -61,6 +61,11 @@ typedef struct ParticleHairCache {
   GPUVertBuf *proc_strand_seg_buf;
   GPUTexture *strand_seg_tex;
 
+  /** Infos of children interpolated from the parent strands during the subdivision stage
+   * (parent strands, weights, root offset and length). */
+  GPUVertBuf *proc_child_buf;
+  GPUTexture *child_tex;
+
   GPUVertBuf *proc_uv_buf[MAX_MTFACE];
   GPUTexture *uv_tex[MAX_MTFACE];
   char uv_layer_names[MAX_MTFACE][MAX_LAYER_NAME_CT][MAX_LAYER_NAME_LEN];
@@ -77,6 +82,13 @@ typedef struct ParticleHairCache {
   int strands_len;
   int elems_len;
   int point_len;
+
+  /* Procedural display counts. Only differ from the ones above when the children are
+   * interpolated on the GPU, the control points are then only the ones of the parents. */
+  int proc_strands_len;  /* Strands in the final buffers. */
+  int proc_parents_len;  /* Strands in the strand buffers. */
+  int proc_point_len;    /* Control points in the point buffer. */
+  int proc_children_len; /* Children drawn after the parents, zero if computed on the CPU. */
 } ParticleHairCache;
 
 bool particles_ensure_procedural_data(struct Object *object,
@@ -28,6 +28,7 @@
 #include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLF_api.h"
 
@@ -70,6 +71,8 @@
 
 #include "IMB_colormanagement.h"
 
+#include "PIL_time.h"
+
 #include "RE_engine.h"
 #include "RE_pipeline.h"
 
@@ -1073,11 +1076,13 @@ static void drw_engines_init(void)
     }
 
     PROFILE_END_UPDATE(data->init_time, stime);
+    DRW_stats_cpu_event_add(engine->idname, DRW_STATS_CATEGORY_ENGINE, stime, 0);
   }
 }
 
 static void drw_engines_cache_init(void)
 {
+  const double cache_start = PIL_check_seconds_timer();
   DST.enabled_engine_count = BLI_listbase_count(&DST.enabled_engines);
   DST.vedata_array = MEM_mallocN(sizeof(void *) * DST.enabled_engine_count, __func__);
 
@@ -1095,10 +1100,13 @@ static void drw_engines_cache_init(void)
       DST.text_store_p = &data->text_draw_cache;
     }
 
+    const double stime = PIL_check_seconds_timer();
     if (engine->cache_init) {
       engine->cache_init(data);
     }
+    DRW_stats_engine_time_add(i, engine->idname, stime);
   }
+  DRW_stats_cpu_event_add("Cache Init", DRW_STATS_CATEGORY_CACHE, cache_start, 0);
 }
 
 static void drw_engines_world_update(Scene *scene)
@@ -1119,6 +1127,10 @@ static void drw_engines_world_update(Scene *scene)
 
 static void drw_engines_cache_populate(Object *ob)
 {
+  /* Timings are only gathered while profiling, this runs for every object. */
+  const bool do_profile = DRW_stats_is_recording();
+  const double ob_start = do_profile ? PIL_check_seconds_timer() : 0.0;
+
   DST.ob_handle = 0;
 
   /* HACK: DrawData is copied by COW from the duplicated object.
@@ -1137,6 +1149,8 @@ static void drw_engines_cache_populate(Object *ob)
     DrawEngineType *engine = link->data;
     ViewportEngineData *data = DST.vedata_array[i];
 
+    const double stime = do_profile ? PIL_check_seconds_timer() : 0.0;
+
     if (engine->id_update) {
       engine->id_update(data, &ob->id);
     }
@@ -1144,6 +1158,10 @@ static void drw_engines_cache_populate(Object *ob)
     if (engine->cache_populate) {
       engine->cache_populate(data, ob);
     }
+
+    if (do_profile) {
+      DRW_stats_engine_time_add(i, engine->idname, stime);
+    }
   }
 
   /* TODO: in the future it would be nice to generate once for all viewports.
@@ -1155,20 +1173,34 @@ static void drw_engines_cache_populate(Object *ob)
   /* ... and clearing it here too because this draw data is
    * from a mempool and must not be free individually by depsgraph. */
   drw_drawdata_unlink_dupli((ID *)ob);
+
+  if (do_profile) {
+    DRW_stats_object_time_add(ob->type, ob_start);
+  }
 }
 
 static void drw_engines_cache_finish(void)
 {
+  const double cache_start = PIL_check_seconds_timer();
   int i = 0;
   for (LinkData *link = DST.enabled_engines.first; link; link = link->next, i++) {
     DrawEngineType *engine = link->data;
     ViewportEngineData *data = DST.vedata_array[i];
 
+    const double stime = PIL_check_seconds_timer();
     if (engine->cache_finish) {
       engine->cache_finish(data);
     }
+    DRW_stats_engine_time_add(i, engine->idname, stime);
+
+    if (DRW_stats_is_recording()) {
+      const double cache_time = DRW_stats_engine_time_get(i) * 1e3;
+      data->cache_time = (data->cache_time * (1.0 - PROFILE_TIMER_FALLOFF)) +
+                         (cache_time * PROFILE_TIMER_FALLOFF);
+    }
   }
   MEM_freeN(DST.vedata_array);
+  DRW_stats_cpu_event_add("Cache Finish", DRW_STATS_CATEGORY_CACHE, cache_start, 0);
 }
 
 static bool drw_engines_draw_background(void)
@@ -1222,6 +1254,7 @@ static void drw_engines_draw_scene(void)
     }
 
     PROFILE_END_UPDATE(data->render_time, stime);
+    DRW_stats_cpu_event_add(engine->idname, DRW_STATS_CATEGORY_ENGINE, stime, 0);
   }
   /* Reset state after drawing */
   DRW_state_reset();
@@ -1496,6 +1529,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
                              GPUViewport *viewport,
                              const bContext *evil_C)
 {
+  BLI_TRACE_ZONE_BEGIN(draw);
 
   Scene *scene = DEG_get_evaluated_scene(depsgraph);
   ViewLayer *view_layer = DEG_get_evaluated_view_layer(depsgraph);
@@ -1545,6 +1579,9 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   /* No framebuffer allowed before drawing. */
   BLI_assert(GPU_framebuffer_active_get() == NULL);
 
+  /* Also records the CPU timings of the cache, queries are only issued when drawing. */
+  DRW_stats_begin();
+
   /* Init engines */
   drw_engines_init();
 
@@ -1556,6 +1593,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
     /* Only iterate over objects for internal engines or when overlays are enabled */
     if (do_populate_loop) {
+      const double populate_start = PIL_check_seconds_timer();
       DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
         if ((object_type_exclude_viewport & (1 << ob->type)) != 0) {
           continue;
@@ -1569,6 +1607,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
         drw_engines_cache_populate(ob);
       }
       DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
+      DRW_stats_cpu_event_add("Cache Populate", DRW_STATS_CATEGORY_CACHE, populate_start, 0);
     }
 
     drw_duplidata_free();
@@ -1582,8 +1621,6 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 #endif
   }
 
-  DRW_stats_begin();
-
   GPU_framebuffer_bind(DST.default_framebuffer);
 
   /* Start Drawing */
@@ -1691,6 +1728,8 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   /* Avoid accidental reuse. */
   drw_state_ensure_not_reused(&DST);
 #endif
+
+  BLI_TRACE_ZONE_END(draw, "Draw Viewport");
 }
 
 void DRW_draw_render_loop(struct Depsgraph *depsgraph,
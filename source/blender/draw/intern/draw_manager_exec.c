@@ -25,6 +25,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -585,45 +586,93 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float) * 6 * 4);
 }
 
+static void draw_compute_culling_state(DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+typedef struct DRWCullingTaskData {
+  DRWView *view;
+  /* Number of culling states in the last chunk. */
+  int last_chunk_len;
+  int chunk_len;
+} DRWCullingTaskData;
+
+static void draw_compute_culling_chunk_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DRWCullingTaskData *data = userdata;
+  const int elem_len = (chunk == data->chunk_len - 1) ? data->last_chunk_len :
+                                                        DRW_RESOURCE_CHUNK_LEN;
+  /* Culling states are allocated in chunks of DRW_RESOURCE_CHUNK_LEN (one per resource). */
+  DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, 0);
+  for (int i = 0; i < elem_len; i++, cull++) {
+    draw_compute_culling_state(data->view, cull);
+  }
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem) multithread this. */
   /* TODO(fclem) compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
-
+  /* The visibility callback modifies engine data shared by several resources. */
+  bool use_threading = (view->visibility_fn == NULL);
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  use_threading = use_threading && (G.debug_value == 0);
 #endif
 
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
-
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  if (use_threading) {
+    /* The handle is the one of the next resource, each one has a culling state. */
+    const int chunk_id = DRW_handle_chunk_get(&DST.resource_handle);
+    const int elem_id = DRW_handle_id_get(&DST.resource_handle);
+    DRWCullingTaskData data = {
+        .view = view,
+        .chunk_len = chunk_id + ((elem_id != 0) ? 1 : 0),
+        .last_chunk_len = (elem_id != 0) ? elem_id : DRW_RESOURCE_CHUNK_LEN,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    /* Not worth the overhead of threads for small scenes. */
+    settings.use_threading = (data.chunk_len > 1);
+    BLI_task_parallel_range(0, data.chunk_len, &data, draw_compute_culling_chunk_cb, &settings);
+  }
+  else {
+    BLI_memblock_iter iter;
+    BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
+    DRWCullingState *cull;
+    while ((cull = BLI_memblock_iterstep(&iter))) {
+      draw_compute_culling_state(view, cull);
     }
   }
 
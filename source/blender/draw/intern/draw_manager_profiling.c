@@ -20,18 +20,33 @@
  * \ingroup draw
  */
 
+#include <stdio.h>
+#include <string.h>
+
+#include "BLI_utildefines.h"
+
+#include "BLI_fileops.h"
+#include "BLI_math_base.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BKE_global.h"
 
+#include "DNA_object_types.h"
+
 #include "BLF_api.h"
 
 #include "MEM_guardedalloc.h"
 
 #include "draw_manager.h"
 
+#include "PIL_time.h"
+
+#include "GPU_element.h"
 #include "GPU_texture.h"
+#include "GPU_uniformbuffer.h"
 
 #include "UI_resources.h"
 
@@ -41,6 +56,9 @@
 #define MAX_NESTED_TIMER 8
 #define CHUNK_SIZE 8
 #define GPU_TIMER_FALLOFF 0.1
+#define MAX_CPU_EVENTS 4096
+#define MAX_PROFILED_ENGINES 16
+#define MAX_EXTRACT_NAMES 64
 
 typedef struct DRWTimer {
   GLuint query[2];
@@ -60,6 +78,35 @@ static struct DRWTimerPool {
   bool is_querying;    /* Keep track of bad usage. */
 } DTP = {NULL};
 
+typedef struct DRWCPUEvent {
+  /* Static strings, not owned by the event. */
+  const char *name;
+  const char *category;
+  double start, end;
+  int thread_id;
+} DRWCPUEvent;
+
+/* CPU side of the last recorded frame, raw values in seconds. */
+static struct DRWCPUProfile {
+  DRWCPUEvent *events;
+  int events_len;
+  int events_dropped;
+  double frame_start, frame_end;
+  /* Cache init, populate and finish time of each enabled engine. */
+  const char *engine_names[MAX_PROFILED_ENGINES];
+  double engine_time[MAX_PROFILED_ENGINES];
+  int engines_len;
+  /* Populate time of the objects, including the batch extraction, per object type. */
+  double object_time[OB_TYPE_MAX];
+  int object_count[OB_TYPE_MAX];
+  /* Bytes uploaded during the frame. At the start of the frame these are the totals of the
+   * GPU module, the difference is taken at the end. */
+  size_t vbo_upload, ibo_upload, ubo_upload;
+} DCP = {NULL};
+
+/* Events are added by the extraction tasks too. */
+static ThreadMutex drw_stats_cpu_lock = BLI_MUTEX_INITIALIZER;
+
 void DRW_stats_free(void)
 {
   if (DTP.timers != NULL) {
@@ -69,13 +116,136 @@ void DRW_stats_free(void)
     }
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
+    DTP.timer_increment = 0;
+  }
+  MEM_SAFE_FREE(DCP.events);
+  DCP.events_len = 0;
+}
+
+static void drw_stats_cpu_begin(void)
+{
+  if (DCP.events == NULL) {
+    DCP.events = MEM_mallocN(sizeof(DRWCPUEvent) * MAX_CPU_EVENTS, "DRWCPUEvent stack");
+  }
+  DCP.events_len = 0;
+  DCP.events_dropped = 0;
+  DCP.engines_len = 0;
+  memset(DCP.object_time, 0, sizeof(DCP.object_time));
+  memset(DCP.object_count, 0, sizeof(DCP.object_count));
+  DCP.vbo_upload = GPU_vertbuf_upload_bytes_get();
+  DCP.ibo_upload = GPU_indexbuf_upload_bytes_get();
+  DCP.ubo_upload = GPU_uniformbuffer_upload_bytes_get();
+  DCP.frame_start = PIL_check_seconds_timer();
+}
+
+static void drw_stats_cpu_end(void)
+{
+  DCP.frame_end = PIL_check_seconds_timer();
+  DCP.vbo_upload = GPU_vertbuf_upload_bytes_get() - DCP.vbo_upload;
+  DCP.ibo_upload = GPU_indexbuf_upload_bytes_get() - DCP.ibo_upload;
+  DCP.ubo_upload = GPU_uniformbuffer_upload_bytes_get() - DCP.ubo_upload;
+}
+
+bool DRW_stats_is_recording(void)
+{
+  return DTP.is_recording;
+}
+
+/* The event ends now. */
+void DRW_stats_cpu_event_add(const char *name,
+                             const char *category,
+                             const double start,
+                             const int thread_id)
+{
+  if (!DTP.is_recording && !BLI_trace_is_enabled()) {
+    return;
   }
+  const double end = PIL_check_seconds_timer();
+  BLI_trace_zone_add(name, start, end);
+  if (!DTP.is_recording) {
+    return;
+  }
+  BLI_mutex_lock(&drw_stats_cpu_lock);
+  if (DCP.events_len < MAX_CPU_EVENTS) {
+    DRWCPUEvent *event = &DCP.events[DCP.events_len++];
+    event->name = name;
+    event->category = category;
+    event->start = start;
+    event->end = end;
+    event->thread_id = thread_id;
+  }
+  else {
+    DCP.events_dropped++;
+  }
+  BLI_mutex_unlock(&drw_stats_cpu_lock);
+}
+
+void DRW_stats_engine_time_add(const int engine_index, const char *name, const double start)
+{
+  if (!DTP.is_recording || engine_index >= MAX_PROFILED_ENGINES) {
+    return;
+  }
+  while (DCP.engines_len <= engine_index) {
+    DCP.engine_names[DCP.engines_len] = NULL;
+    DCP.engine_time[DCP.engines_len] = 0.0;
+    DCP.engines_len++;
+  }
+  DCP.engine_names[engine_index] = name;
+  DCP.engine_time[engine_index] += PIL_check_seconds_timer() - start;
+}
+
+double DRW_stats_engine_time_get(const int engine_index)
+{
+  return (engine_index < DCP.engines_len) ? DCP.engine_time[engine_index] : 0.0;
+}
+
+void DRW_stats_object_time_add(const int ob_type, const double start)
+{
+  if (!DTP.is_recording || ob_type < 0 || ob_type >= OB_TYPE_MAX) {
+    return;
+  }
+  DCP.object_time[ob_type] += PIL_check_seconds_timer() - start;
+  DCP.object_count[ob_type]++;
+}
+
+static const char *drw_stats_object_type_name(const int ob_type)
+{
+  switch (ob_type) {
+    case OB_EMPTY:
+      return "Empty";
+    case OB_MESH:
+      return "Mesh";
+    case OB_CURVE:
+      return "Curve";
+    case OB_SURF:
+      return "Surface";
+    case OB_FONT:
+      return "Text";
+    case OB_MBALL:
+      return "Metaball";
+    case OB_LAMP:
+      return "Light";
+    case OB_CAMERA:
+      return "Camera";
+    case OB_SPEAKER:
+      return "Speaker";
+    case OB_LIGHTPROBE:
+      return "Light Probe";
+    case OB_LATTICE:
+      return "Lattice";
+    case OB_ARMATURE:
+      return "Armature";
+    case OB_GPENCIL:
+      return "Grease Pencil";
+  }
+  return "Other";
 }
 
 void DRW_stats_begin(void)
 {
   if (G.debug_value > 20 && G.debug_value < 30) {
     DTP.is_recording = true;
+    drw_stats_cpu_begin();
   }
 
   if (DTP.is_recording && DTP.timers == NULL) {
@@ -196,10 +366,41 @@ void DRW_stats_reset(void)
       lvl_time[timer->lvl] += timer->time_average;
     }
 
+    drw_stats_cpu_end();
     DTP.is_recording = false;
   }
 }
 
+/* Sum the events of the batch extraction by extractor, returns the number of extractors. */
+static int drw_stats_extract_totals_get(const char *r_names[MAX_EXTRACT_NAMES],
+                                        double r_time[MAX_EXTRACT_NAMES],
+                                        int r_count[MAX_EXTRACT_NAMES])
+{
+  int len = 0;
+  for (int i = 0; i < DCP.events_len; i++) {
+    const DRWCPUEvent *event = &DCP.events[i];
+    if (!STREQ(event->category, DRW_STATS_CATEGORY_EXTRACT)) {
+      continue;
+    }
+    int index = 0;
+    while (index < len && !STREQ(r_names[index], event->name)) {
+      index++;
+    }
+    if (index == len) {
+      if (len == MAX_EXTRACT_NAMES) {
+        continue;
+      }
+      r_names[len] = event->name;
+      r_time[len] = 0.0;
+      r_count[len] = 0;
+      len++;
+    }
+    r_time[index] += event->end - event->start;
+    r_count[index]++;
+  }
+  return len;
+}
+
 static void draw_stat_5row(const rcti *rect, int u, int v, const char *txt, const int size)
 {
   BLF_draw_default_ascii(rect->xmin + (1 + u * 5) * U.widget_unit,
@@ -221,7 +422,8 @@ void DRW_stats_draw(const rcti *rect)
   int lvl_index[MAX_NESTED_TIMER];
   int v = 0, u = 0;
 
-  double init_tot_time = 0.0, background_tot_time = 0.0, render_tot_time = 0.0, tot_time = 0.0;
+  double init_tot_time = 0.0, cache_tot_time = 0.0, background_tot_time = 0.0;
+  double render_tot_time = 0.0, tot_time = 0.0;
 
   int fontid = BLF_default();
   UI_FontThemeColor(fontid, TH_TEXT_HI);
@@ -240,11 +442,13 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   sprintf(col_label, "Init");
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+  sprintf(col_label, "Cache");
+  draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   sprintf(col_label, "Background");
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   sprintf(col_label, "Render");
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
-  sprintf(col_label, "Total (w/o cache)");
+  sprintf(col_label, "Total");
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   v++;
 
@@ -261,6 +465,10 @@ void DRW_stats_draw(const rcti *rect)
     sprintf(time_to_txt, "%.2fms", data->init_time);
     draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
 
+    cache_tot_time += data->cache_time;
+    sprintf(time_to_txt, "%.2fms", data->cache_time);
+    draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
+
     background_tot_time += data->background_time;
     sprintf(time_to_txt, "%.2fms", data->background_time);
     draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
@@ -269,8 +477,10 @@ void DRW_stats_draw(const rcti *rect)
     sprintf(time_to_txt, "%.2fms", data->render_time);
     draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
 
-    tot_time += data->init_time + data->background_time + data->render_time;
-    sprintf(time_to_txt, "%.2fms", data->init_time + data->background_time + data->render_time);
+    const double engine_time = data->init_time + data->cache_time + data->background_time +
+                               data->render_time;
+    tot_time += engine_time;
+    sprintf(time_to_txt, "%.2fms", engine_time);
     draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
     v++;
   }
@@ -281,6 +491,8 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   sprintf(time_to_txt, "%.2fms", init_tot_time);
   draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
+  sprintf(time_to_txt, "%.2fms", cache_tot_time);
+  draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
   sprintf(time_to_txt, "%.2fms", background_tot_time);
   draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
   sprintf(time_to_txt, "%.2fms", render_tot_time);
@@ -297,6 +509,57 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
   v += 2;
 
+  /* Object types rows, last frame only. */
+  u = 0;
+  sprintf(col_label, "Object Type");
+  draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+  sprintf(col_label, "Count");
+  draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+  sprintf(col_label, "Populate");
+  draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+  v++;
+  for (int type = 0; type < OB_TYPE_MAX; type++) {
+    if (DCP.object_count[type] == 0) {
+      continue;
+    }
+    u = 0;
+    sprintf(col_label, "%s", drw_stats_object_type_name(type));
+    draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+    sprintf(col_label, "%d", DCP.object_count[type]);
+    draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+    sprintf(time_to_txt, "%.2fms", DCP.object_time[type] * 1e3);
+    draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
+    v++;
+  }
+  v++;
+
+  /* Batch extraction rows, summed over all meshes and tasks of the last frame. */
+  const char *extract_names[MAX_EXTRACT_NAMES];
+  double extract_time[MAX_EXTRACT_NAMES];
+  int extract_count[MAX_EXTRACT_NAMES];
+  int extract_len = drw_stats_extract_totals_get(extract_names, extract_time, extract_count);
+  if (extract_len > 0) {
+    u = 0;
+    sprintf(col_label, "Extraction");
+    draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+    sprintf(col_label, "Calls");
+    draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+    sprintf(col_label, "Time");
+    draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+    v++;
+    for (int i = 0; i < extract_len; i++) {
+      u = 0;
+      BLI_strncpy(col_label, extract_names[i], sizeof(col_label));
+      draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+      sprintf(col_label, "%d", extract_count[i]);
+      draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+      sprintf(time_to_txt, "%.2fms", extract_time[i] * 1e3);
+      draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
+      v++;
+    }
+    v++;
+  }
+
   /* ------------------------------------------ */
   /* ---------------- GPU stats --------------- */
   /* ------------------------------------------ */
@@ -319,6 +582,27 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
   v += 1;
 
+  /* Uploads of the last frame. */
+  sprintf(stat_string, "GPU Uploads");
+  draw_stat(rect, 0, v, stat_string, sizeof(stat_string));
+  sprintf(stat_string,
+          "%.2fKB",
+          (double)(DCP.vbo_upload + DCP.ibo_upload + DCP.ubo_upload) / 1000.0);
+  draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
+  sprintf(stat_string, "Vertex Buffers");
+  draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
+  sprintf(stat_string, "%.2fKB", (double)DCP.vbo_upload / 1000.0);
+  draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
+  sprintf(stat_string, "Index Buffers");
+  draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
+  sprintf(stat_string, "%.2fKB", (double)DCP.ibo_upload / 1000.0);
+  draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
+  sprintf(stat_string, "Uniform Buffers");
+  draw_stat(rect, 1, v, stat_string, sizeof(stat_string));
+  sprintf(stat_string, "%.2fKB", (double)DCP.ubo_upload / 1000.0);
+  draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
+  v += 1;
+
   /* GPU Timings */
   BLI_strncpy(stat_string, "GPU Render Timings", sizeof(stat_string));
   draw_stat(rect, 0, v++, stat_string, sizeof(stat_string));
@@ -361,3 +645,141 @@ void DRW_stats_draw(const rcti *rect)
   BLF_batch_draw_end();
   BLF_disable(fontid, BLF_SHADOW);
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Trace Export
+ *
+ * Timeline of the last recorded frame in the Trace Event format, which is understood by
+ * chrome://tracing and Perfetto. The GPU timers are only known as averaged durations, they are
+ * laid out one after the other on their own track.
+ * \{ */
+
+/* Timestamp in microseconds relative to the start of the frame. */
+BLI_INLINE double drw_stats_trace_timestamp(const double time)
+{
+  return (time - DCP.frame_start) * 1e6;
+}
+
+static void drw_stats_trace_string(FILE *f, const char *str)
+{
+  fputc('"', f);
+  for (const char *ch = str; *ch; ch++) {
+    if (*ch == '"' || *ch == '\\') {
+      fputc('\\', f);
+      fputc(*ch, f);
+    }
+    else if ((unsigned char)*ch < 0x20) {
+      fprintf(f, "\\u%04x", *ch);
+    }
+    else {
+      fputc(*ch, f);
+    }
+  }
+  fputc('"', f);
+}
+
+static void drw_stats_trace_thread_name(FILE *f, const int pid, const int tid, const char *name)
+{
+  fprintf(f,
+          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+          pid,
+          tid);
+  drw_stats_trace_string(f, name);
+  fprintf(f, "}},\n");
+}
+
+static void drw_stats_trace_write_ex(FILE *f)
+{
+  fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CPU\"}},\n");
+  fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}},\n");
+
+  /* CPU events, each thread is named on its first event. */
+  bool thread_used[BLENDER_MAX_THREADS + 1] = {false};
+  for (int i = 0; i < DCP.events_len; i++) {
+    const DRWCPUEvent *event = &DCP.events[i];
+    const int tid = min_ii(event->thread_id, BLENDER_MAX_THREADS);
+    if (!thread_used[tid]) {
+      char thread_name[32] = "Main";
+      if (tid != 0) {
+        BLI_snprintf(thread_name, sizeof(thread_name), "Worker %d", tid);
+      }
+      drw_stats_trace_thread_name(f, 0, tid, thread_name);
+      thread_used[tid] = true;
+    }
+    fprintf(f, "{\"name\":");
+    drw_stats_trace_string(f, event->name);
+    fprintf(f, ",\"cat\":");
+    drw_stats_trace_string(f, event->category);
+    fprintf(f,
+            ",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f},\n",
+            tid,
+            drw_stats_trace_timestamp(event->start),
+            (event->end - event->start) * 1e6);
+  }
+
+  /* GPU timers, each level starts where its parent starts. */
+  drw_stats_trace_thread_name(f, 1, 0, "Passes (averaged)");
+  double lvl_start[MAX_NESTED_TIMER + 1] = {0.0};
+  for (int i = 0; i < DTP.timer_increment; i++) {
+    const DRWTimer *timer = &DTP.timers[i];
+    const double duration = timer->time_average / 1e3;
+    lvl_start[timer->lvl + 1] = lvl_start[timer->lvl];
+    fprintf(f, "{\"name\":");
+    drw_stats_trace_string(f, timer->name);
+    fprintf(f,
+            ",\"cat\":\"GPU\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f},\n",
+            lvl_start[timer->lvl],
+            duration);
+    lvl_start[timer->lvl] += duration;
+  }
+
+  /* Totals of the frame, as counters at the end of the frame. */
+  const double end = drw_stats_trace_timestamp(DCP.frame_end);
+  for (int i = 0; i < DCP.engines_len; i++) {
+    if (DCP.engine_names[i] == NULL) {
+      continue;
+    }
+    fprintf(f,
+            "{\"name\":\"Engine Cache (ms)\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,\"args\":{",
+            end);
+    drw_stats_trace_string(f, DCP.engine_names[i]);
+    fprintf(f, ":%.3f}},\n", DCP.engine_time[i] * 1e3);
+  }
+  for (int type = 0; type < OB_TYPE_MAX; type++) {
+    if (DCP.object_count[type] == 0) {
+      continue;
+    }
+    fprintf(f,
+            "{\"name\":\"Object Populate (ms)\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,"
+            "\"args\":{\"%s\":%.3f}},\n",
+            end,
+            drw_stats_object_type_name(type),
+            DCP.object_time[type] * 1e3);
+  }
+  fprintf(f,
+          "{\"name\":\"Upload (bytes)\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,"
+          "\"args\":{\"vertex\":%zu,\"index\":%zu,\"uniform\":%zu}}",
+          end,
+          DCP.vbo_upload,
+          DCP.ibo_upload,
+          DCP.ubo_upload);
+  fprintf(f, "\n]}\n");
+}
+
+bool DRW_stats_trace_write(const char *filepath)
+{
+  /* Nothing was recorded yet, or profiling was disabled. */
+  if (DCP.events == NULL || DTP.is_recording) {
+    return false;
+  }
+  FILE *f = BLI_fopen(filepath, "w");
+  if (f == NULL) {
+    return false;
+  }
+  drw_stats_trace_write_ex(f);
+  fclose(f);
+  return true;
+}
+
+/** \} */
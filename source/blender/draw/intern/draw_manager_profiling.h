@@ -37,4 +37,19 @@ void DRW_stats_query_end(void);
 
 void DRW_stats_draw(const rcti *rect);
 
+/* Categories of the CPU events. */
+#define DRW_STATS_CATEGORY_ENGINE "Engine"
+#define DRW_STATS_CATEGORY_CACHE "Cache"
+#define DRW_STATS_CATEGORY_EXTRACT "Extract"
+
+/* CPU timings, only stored while recording. Names and categories must be static strings. */
+bool DRW_stats_is_recording(void);
+void DRW_stats_cpu_event_add(const char *name,
+                             const char *category,
+                             const double start,
+                             const int thread_id);
+void DRW_stats_engine_time_add(const int engine_index, const char *name, const double start);
+double DRW_stats_engine_time_get(const int engine_index);
+void DRW_stats_object_time_add(const int ob_type, const double start);
+
 #endif /* __DRAW_MANAGER_PROFILING_H__ */
@@ -44,7 +44,8 @@ uniform usamplerBuffer hairStrandSegBuffer; /* R16UI */
 /* -- Subdivision stage -- */
 /**
  * We use a transform feedback to preprocess the strands and add more subdivision to it.
- * For the moment these are simple smooth interpolation but one could hope to see the full
+ * For the moment these are simple smooth interpolation, and interpolated children with
+ * clumping and end roughness (see HAIR_CHILDREN), but one could hope to see the full
  * children particle modifiers being evaluated at this stage.
  *
  * If no more subdivision is needed, we can skip this step.
@@ -61,12 +62,14 @@ int hair_get_base_id(float local_time, int strand_segments, out float interp_tim
   return int(ratio);
 }
 
-void hair_get_interp_attrs(
-    out vec4 data0, out vec4 data1, out vec4 data2, out vec4 data3, out float interp_time)
+void hair_get_strand_interp_attrs(int hair_id,
+                                  float local_time,
+                                  out vec4 data0,
+                                  out vec4 data1,
+                                  out vec4 data2,
+                                  out vec4 data3,
+                                  out float interp_time)
 {
-  float local_time = float(gl_VertexID % hairStrandsRes) / float(hairStrandsRes - 1);
-
-  int hair_id = gl_VertexID / hairStrandsRes;
   int strand_offset = int(texelFetch(hairStrandBuffer, hair_id).x);
   int strand_segments = int(texelFetch(hairStrandSegBuffer, hair_id).x);
 
@@ -88,6 +91,19 @@ void hair_get_interp_attrs(
     data3 = data2 * 2.0 - data1;
   }
 }
+
+float hair_get_local_time(void)
+{
+  return float(gl_VertexID % hairStrandsRes) / float(hairStrandsRes - 1);
+}
+
+void hair_get_interp_attrs(
+    out vec4 data0, out vec4 data1, out vec4 data2, out vec4 data3, out float interp_time)
+{
+  int hair_id = gl_VertexID / hairStrandsRes;
+  hair_get_strand_interp_attrs(
+      hair_id, hair_get_local_time(), data0, data1, data2, data3, interp_time);
+}
 #endif
 
 /* -- Drawing stage -- */
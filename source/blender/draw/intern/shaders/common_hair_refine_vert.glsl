@@ -44,6 +44,66 @@ vec4 interp_data(vec4 v0, vec4 v1, vec4 v2, vec4 v3, vec4 w)
   return v0 * w.x + v1 * w.y + v2 * w.z + v3 * w.w;
 }
 
+#ifdef HAIR_CHILDREN
+/**
+ * Interpolated children, evaluated from their parents strands.
+ * 4 texels per child: parent strands, parent weights, root offset and length,
+ * end roughness offset and clump parent strand.
+ */
+uniform samplerBuffer hairChildBuffer; /* RGBA32F */
+/* Strands before this one are parents, read as is from the control points. */
+uniform int hairChildStart;
+uniform float hairClumpFac;
+uniform float hairClumpPow;
+uniform float hairRoughEndShape;
+
+vec3 hair_parent_position(int strand_id, float local_time)
+{
+  float interp_time;
+  vec4 data0, data1, data2, data3;
+  hair_get_strand_interp_attrs(strand_id, local_time, data0, data1, data2, data3, interp_time);
+
+  vec4 weights = get_weights_cardinal(interp_time);
+  return interp_data(data0, data1, data2, data3, weights).point_position;
+}
+
+vec4 hair_child_point(int child_id, float local_time)
+{
+  vec4 parents = texelFetch(hairChildBuffer, child_id * 4);
+  vec4 weights = texelFetch(hairChildBuffer, child_id * 4 + 1);
+  vec4 offset_length = texelFetch(hairChildBuffer, child_id * 4 + 2);
+  vec4 rough_clump = texelFetch(hairChildBuffer, child_id * 4 + 3);
+
+  /* Shorter children are cut, same as the CPU path length check. */
+  float time = local_time * offset_length.w;
+
+  /* Weighted sum of the parents, offset by the distance of the roots. */
+  vec3 parent0 = hair_parent_position(int(parents.x), time);
+  vec3 pos = offset_length.xyz + parent0 * weights.x;
+  for (int i = 1; i < 4; i++) {
+    if (weights[i] > 0.0) {
+      pos += hair_parent_position(int(parents[i]), time) * weights[i];
+    }
+  }
+
+  int clump_parent = int(rough_clump.w);
+  if (hairClumpFac != 0.0 && clump_parent >= 0) {
+    vec3 clump_pos = (clump_parent == int(parents.x)) ?
+                         parent0 :
+                         hair_parent_position(clump_parent, time);
+    /* Clumping the roots instead of the tips for negative values, see do_clump_level(). */
+    float clump = (hairClumpFac < 0.0) ? -hairClumpFac * pow(1.0 - time, hairClumpPow) :
+                                         hairClumpFac * pow(time, hairClumpPow);
+    pos = mix(pos, clump_pos, clump);
+  }
+
+  /* Avoid undefined pow(0, 0) at the root. */
+  pos += rough_clump.xyz * pow(max(time, 1e-8), hairRoughEndShape);
+
+  return vec4(pos, local_time);
+}
+#endif
+
 #ifdef TF_WORKAROUND
 uniform int targetWidth;
 uniform int targetHeight;
@@ -52,12 +112,21 @@ uniform int idOffset;
 
 void main(void)
 {
-  float interp_time;
-  vec4 data0, data1, data2, data3;
-  hair_get_interp_attrs(data0, data1, data2, data3, interp_time);
+#ifdef HAIR_CHILDREN
+  int hair_id = gl_VertexID / hairStrandsRes;
+  if (hair_id >= hairChildStart) {
+    finalColor = hair_child_point(hair_id - hairChildStart, hair_get_local_time());
+  }
+  else
+#endif
+  {
+    float interp_time;
+    vec4 data0, data1, data2, data3;
+    hair_get_interp_attrs(data0, data1, data2, data3, interp_time);
 
-  vec4 weights = get_weights_cardinal(interp_time);
-  finalColor = interp_data(data0, data1, data2, data3, weights);
+    vec4 weights = get_weights_cardinal(interp_time);
+    finalColor = interp_data(data0, data1, data2, data3, weights);
+  }
 
 #ifdef TF_WORKAROUND
   int id = gl_VertexID - idOffset;
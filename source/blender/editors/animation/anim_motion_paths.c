@@ -32,6 +32,7 @@
 
 #include "BKE_animsys.h"
 #include "BKE_action.h"
+#include "BKE_callbacks.h"
 #include "BKE_main.h"
 #include "BKE_scene.h"
 
@@ -74,6 +75,28 @@ static void motionpaths_calc_update_scene(Main *bmain, struct Depsgraph *depsgra
   BKE_scene_graph_update_for_newframe(depsgraph, bmain);
 }
 
+/* Update scene for a frame of the path being baked. Compared to a regular frame change, images,
+ * sound and editors are not updated on every frame, only the transforms of the targets are used
+ * here. Frame change handlers still run, since they can affect those transforms. */
+static void motionpaths_calc_update_frame(Main *bmain, struct Depsgraph *depsgraph)
+{
+  Scene *scene = DEG_get_input_scene(depsgraph);
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+
+  BKE_callback_exec_id(bmain, &scene->id, BKE_CB_EVT_FRAME_CHANGE_PRE);
+  DEG_graph_relations_update(depsgraph, bmain, scene, view_layer);
+  DEG_evaluate_on_framechange(bmain, depsgraph, BKE_scene_frame_get(scene));
+  BKE_callback_exec_id_depsgraph(bmain, &scene->id, depsgraph, BKE_CB_EVT_FRAME_CHANGE_POST);
+
+  /* Take changes made by the handlers into account, like a regular frame change. */
+  if (!DEG_is_fully_evaluated(depsgraph)) {
+    DEG_graph_relations_update(depsgraph, bmain, scene, view_layer);
+    DEG_evaluate_on_refresh(bmain, depsgraph);
+  }
+
+  DEG_ids_clear_recalc(bmain, depsgraph);
+}
+
 Depsgraph *animviz_depsgraph_build(Main *bmain,
                                    Scene *scene,
                                    ViewLayer *view_layer,
@@ -471,7 +494,7 @@ void animviz_calc_motionpaths(Depsgraph *depsgraph,
     }
     else {
       /* Update relevant data for new frame. */
-      motionpaths_calc_update_scene(bmain, depsgraph);
+      motionpaths_calc_update_frame(bmain, depsgraph);
     }
 
     /* perform baking for targets */
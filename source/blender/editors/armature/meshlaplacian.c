@@ -31,6 +31,7 @@
 #include "BLI_memarena.h"
 #include "BLI_string.h"
 #include "BLI_alloca.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -912,7 +913,7 @@ typedef struct MeshDeformBind {
   MDefBoundIsect *(*boundisect)[6];
   int *semibound;
   int *tag;
-  float *phi, *totalphi;
+  float *totalphi;
 
   /* mesh stuff */
   int *inside;
@@ -999,42 +1000,53 @@ static void harmonic_ray_callback(void *userdata,
   }
 }
 
-static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
-                                                     const float co1[3],
-                                                     const float co2[3])
+/* Cast a ray from co1 to co2 against the cage, only reads mdb so it's thread safe. */
+static bool meshdeform_ray_tree_cast(MeshDeformBind *mdb,
+                                     const float co1[3],
+                                     const float co2[3],
+                                     MeshDeformIsect *r_isect_mdef,
+                                     BVHTreeRayHit *r_hit)
 {
-  BVHTreeRayHit hit;
-  MeshDeformIsect isect_mdef;
   struct MeshRayCallbackData data = {
       mdb,
-      &isect_mdef,
+      r_isect_mdef,
   };
   float end[3], vec_normal[3];
 
   /* happens binding when a cage has no faces */
   if (UNLIKELY(mdb->bvhtree == NULL)) {
-    return NULL;
+    return false;
   }
 
   /* setup isec */
-  memset(&isect_mdef, 0, sizeof(isect_mdef));
-  isect_mdef.lambda = 1e10f;
+  memset(r_isect_mdef, 0, sizeof(*r_isect_mdef));
+  r_isect_mdef->lambda = 1e10f;
 
-  copy_v3_v3(isect_mdef.start, co1);
+  copy_v3_v3(r_isect_mdef->start, co1);
   copy_v3_v3(end, co2);
-  sub_v3_v3v3(isect_mdef.vec, end, isect_mdef.start);
-  isect_mdef.vec_length = normalize_v3_v3(vec_normal, isect_mdef.vec);
+  sub_v3_v3v3(r_isect_mdef->vec, end, r_isect_mdef->start);
+  r_isect_mdef->vec_length = normalize_v3_v3(vec_normal, r_isect_mdef->vec);
+
+  r_hit->index = -1;
+  r_hit->dist = BVH_RAYCAST_DIST_MAX;
+  return (BLI_bvhtree_ray_cast_ex(mdb->bvhtree,
+                                  r_isect_mdef->start,
+                                  vec_normal,
+                                  0.0,
+                                  r_hit,
+                                  harmonic_ray_callback,
+                                  &data,
+                                  BVH_RAYCAST_WATERTIGHT) != -1);
+}
 
-  hit.index = -1;
-  hit.dist = BVH_RAYCAST_DIST_MAX;
-  if (BLI_bvhtree_ray_cast_ex(mdb->bvhtree,
-                              isect_mdef.start,
-                              vec_normal,
-                              0.0,
-                              &hit,
-                              harmonic_ray_callback,
-                              &data,
-                              BVH_RAYCAST_WATERTIGHT) != -1) {
+static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
+                                                     const float co1[3],
+                                                     const float co2[3])
+{
+  BVHTreeRayHit hit;
+  MeshDeformIsect isect_mdef;
+
+  if (meshdeform_ray_tree_cast(mdb, co1, co2, &isect_mdef, &hit)) {
     const MLoop *mloop = mdb->cagemesh_cache.mloop;
     const MLoopTri *lt = &mdb->cagemesh_cache.looptri[hit.index];
     const MPoly *mp = &mdb->cagemesh_cache.mpoly[lt->poly];
@@ -1072,7 +1084,8 @@ static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
 
 static int meshdeform_inside_cage(MeshDeformBind *mdb, float *co)
 {
-  MDefBoundIsect *isect;
+  BVHTreeRayHit hit;
+  MeshDeformIsect isect_mdef;
   float outside[3], start[3], dir[3];
   int i;
 
@@ -1085,8 +1098,8 @@ static int meshdeform_inside_cage(MeshDeformBind *mdb, float *co)
     sub_v3_v3v3(dir, outside, start);
     normalize_v3(dir);
 
-    isect = meshdeform_ray_tree_intersect(mdb, start, outside);
-    if (isect && !isect->facing) {
+    /* only the facing of the intersection is needed, no MDefBoundIsect has to be allocated */
+    if (meshdeform_ray_tree_cast(mdb, start, outside, &isect_mdef, &hit) && !isect_mdef.isect) {
       return 1;
     }
   }
@@ -1239,6 +1252,7 @@ static float meshdeform_boundary_phi(const MeshDeformBind *mdb,
 }
 
 static float meshdeform_interp_w(MeshDeformBind *mdb,
+                                 const float *phi,
                                  float *gridvec,
                                  float *UNUSED(vec),
                                  int UNUSED(cagevert))
@@ -1286,7 +1300,7 @@ static float meshdeform_interp_w(MeshDeformBind *mdb,
 
     a = meshdeform_index(mdb, x, y, z, 0);
     weight = wx * wy * wz;
-    result += weight * mdb->phi[a];
+    result += weight * phi[a];
     totweight += weight;
   }
 
@@ -1372,7 +1386,7 @@ static void meshdeform_matrix_add_cell(
 }
 
 static void meshdeform_matrix_add_rhs(
-    MeshDeformBind *mdb, LinearSolver *context, int x, int y, int z, int cagevert)
+    MeshDeformBind *mdb, double *rhs_vec, int x, int y, int z, int cagevert)
 {
   MDefBoundIsect *isect;
   float rhs, weight, totweight;
@@ -1395,13 +1409,13 @@ static void meshdeform_matrix_add_rhs(
     if (isect) {
       weight = (1.0f / isect->len) / totweight;
       rhs = weight * meshdeform_boundary_phi(mdb, isect, cagevert);
-      EIG_linear_solver_right_hand_side_add(context, 0, mdb->varidx[acenter], rhs);
+      rhs_vec[mdb->varidx[acenter]] += rhs;
     }
   }
 }
 
 static void meshdeform_matrix_add_semibound_phi(
-    MeshDeformBind *mdb, int x, int y, int z, int cagevert)
+    MeshDeformBind *mdb, float *phi, int x, int y, int z, int cagevert)
 {
   MDefBoundIsect *isect;
   float rhs, weight, totweight;
@@ -1412,7 +1426,7 @@ static void meshdeform_matrix_add_semibound_phi(
     return;
   }
 
-  mdb->phi[a] = 0.0f;
+  phi[a] = 0.0f;
 
   totweight = meshdeform_boundary_total_weight(mdb, x, y, z);
   for (i = 1; i <= 6; i++) {
@@ -1421,15 +1435,15 @@ static void meshdeform_matrix_add_semibound_phi(
     if (isect) {
       weight = (1.0f / isect->len) / totweight;
       rhs = weight * meshdeform_boundary_phi(mdb, isect, cagevert);
-      mdb->phi[a] += rhs;
+      phi[a] += rhs;
     }
   }
 }
 
 static void meshdeform_matrix_add_exterior_phi(
-    MeshDeformBind *mdb, int x, int y, int z, int UNUSED(cagevert))
+    MeshDeformBind *mdb, float *phi, int x, int y, int z, int UNUSED(cagevert))
 {
-  float phi, totweight;
+  float totphi, totweight;
   int i, a, acenter;
 
   acenter = meshdeform_index(mdb, x, y, z, 0);
@@ -1437,27 +1451,107 @@ static void meshdeform_matrix_add_exterior_phi(
     return;
   }
 
-  phi = 0.0f;
+  totphi = 0.0f;
   totweight = 0.0f;
   for (i = 1; i <= 6; i++) {
     a = meshdeform_index(mdb, x, y, z, i);
 
     if (a != -1 && mdb->semibound[a]) {
-      phi += mdb->phi[a];
+      totphi += phi[a];
       totweight += 1.0f;
     }
   }
 
   if (totweight != 0.0f) {
-    mdb->phi[acenter] = phi / totweight;
+    phi[acenter] = totphi / totweight;
+  }
+}
+
+/* Cage vertices solved at the same time, each needs its own phi grid. */
+#define MESHDEFORM_SOLVE_CHUNK_SIZE 64
+
+typedef struct MeshDeformSolveData {
+  MeshDeformBind *mdb;
+  const LinearSolver *context;
+  int totvar;
+
+  /* first cage vertex of the chunk, and per cage vertex of the chunk: phi grid and success */
+  int cagevert_start;
+  float **phi;
+  bool *success;
+} MeshDeformSolveData;
+
+static void meshdeform_matrix_solve_cagevert(void *__restrict userdata,
+                                             const int index,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshDeformSolveData *data = userdata;
+  MeshDeformBind *mdb = data->mdb;
+  const int a = data->cagevert_start + index;
+  float *phi = data->phi[index];
+  float vec[3], gridvec[3];
+  int b, x, y, z;
+
+  double *rhs = MEM_calloc_arrayN(data->totvar, sizeof(double), __func__);
+  double *result = MEM_calloc_arrayN(data->totvar, sizeof(double), __func__);
+
+  /* fill in right hand side and solve */
+  for (z = 0; z < mdb->size; z++) {
+    for (y = 0; y < mdb->size; y++) {
+      for (x = 0; x < mdb->size; x++) {
+        meshdeform_matrix_add_rhs(mdb, rhs, x, y, z, a);
+      }
+    }
+  }
+
+  data->success[index] = EIG_linear_solver_solve_array(data->context, rhs, result);
+
+  if (data->success[index]) {
+    for (z = 0; z < mdb->size; z++) {
+      for (y = 0; y < mdb->size; y++) {
+        for (x = 0; x < mdb->size; x++) {
+          meshdeform_matrix_add_semibound_phi(mdb, phi, x, y, z, a);
+        }
+      }
+    }
+
+    for (z = 0; z < mdb->size; z++) {
+      for (y = 0; y < mdb->size; y++) {
+        for (x = 0; x < mdb->size; x++) {
+          meshdeform_matrix_add_exterior_phi(mdb, phi, x, y, z, a);
+        }
+      }
+    }
+
+    for (b = 0; b < mdb->size3; b++) {
+      if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
+        phi[b] = result[mdb->varidx[b]];
+      }
+    }
+
+    if (mdb->weights) {
+      /* static bind : compute weights for each vertex */
+      for (b = 0; b < mdb->totvert; b++) {
+        if (mdb->inside[b]) {
+          copy_v3_v3(vec, mdb->vertexcos[b]);
+          gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
+          gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
+          gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
+
+          mdb->weights[b * mdb->totcagevert + a] = meshdeform_interp_w(mdb, phi, gridvec, vec, a);
+        }
+      }
+    }
   }
+
+  MEM_freeN(rhs);
+  MEM_freeN(result);
 }
 
 static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind *mdb)
 {
   LinearSolver *context;
-  float vec[3], gridvec[3];
-  int a, b, x, y, z, totvar;
+  int a, b, x, y, z, totvar, chunk_size;
   char message[256];
 
   /* setup variable indices */
@@ -1485,80 +1579,83 @@ static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind
     }
   }
 
-  /* solve for each cage vert */
-  for (a = 0; a < mdb->totcagevert; a++) {
-    /* fill in right hand side and solve */
-    for (z = 0; z < mdb->size; z++) {
-      for (y = 0; y < mdb->size; y++) {
-        for (x = 0; x < mdb->size; x++) {
-          meshdeform_matrix_add_rhs(mdb, context, x, y, z, a);
-        }
-      }
-    }
+  /* The matrix is the same for every cage vertex, so it's factorized once, after which the
+   * right hand sides of multiple cage vertices are solved in parallel. Results are gathered in
+   * cage vertex order, so the bind result doesn't depend on the number of threads. */
+  bool success = EIG_linear_solver_factorize(context);
 
-    if (EIG_linear_solver_solve(context)) {
-      for (z = 0; z < mdb->size; z++) {
-        for (y = 0; y < mdb->size; y++) {
-          for (x = 0; x < mdb->size; x++) {
-            meshdeform_matrix_add_semibound_phi(mdb, x, y, z, a);
-          }
-        }
-      }
+  chunk_size = min_ii(mdb->totcagevert, MESHDEFORM_SOLVE_CHUNK_SIZE);
 
-      for (z = 0; z < mdb->size; z++) {
-        for (y = 0; y < mdb->size; y++) {
-          for (x = 0; x < mdb->size; x++) {
-            meshdeform_matrix_add_exterior_phi(mdb, x, y, z, a);
-          }
-        }
+  MeshDeformSolveData data = {
+      .mdb = mdb,
+      .context = context,
+      .totvar = totvar,
+      .phi = MEM_calloc_arrayN(chunk_size, sizeof(float *), "MeshDeformSolvePhi"),
+      .success = MEM_calloc_arrayN(chunk_size, sizeof(bool), "MeshDeformSolveSuccess"),
+  };
+  for (a = 0; a < chunk_size; a++) {
+    data.phi[a] = MEM_calloc_arrayN(mdb->size3, sizeof(float), "MeshDeformBindPhi");
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  for (data.cagevert_start = 0; success && data.cagevert_start < mdb->totcagevert;
+       data.cagevert_start += chunk_size) {
+    const int totchunk = min_ii(chunk_size, mdb->totcagevert - data.cagevert_start);
+
+    BLI_task_parallel_range(0, totchunk, &data, meshdeform_matrix_solve_cagevert, &settings);
+
+    for (int i = 0; i < totchunk; i++) {
+      const float *phi = data.phi[i];
+
+      a = data.cagevert_start + i;
+
+      if (!data.success[i]) {
+        success = false;
+        break;
       }
 
       for (b = 0; b < mdb->size3; b++) {
-        if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
-          mdb->phi[b] = EIG_linear_solver_variable_get(context, 0, mdb->varidx[b]);
-        }
-        mdb->totalphi[b] += mdb->phi[b];
+        mdb->totalphi[b] += phi[b];
       }
 
-      if (mdb->weights) {
-        /* static bind : compute weights for each vertex */
-        for (b = 0; b < mdb->totvert; b++) {
-          if (mdb->inside[b]) {
-            copy_v3_v3(vec, mdb->vertexcos[b]);
-            gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
-            gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
-            gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
-
-            mdb->weights[b * mdb->totcagevert + a] = meshdeform_interp_w(mdb, gridvec, vec, a);
-          }
-        }
-      }
-      else {
+      if (!mdb->weights) {
         MDefBindInfluence *inf;
 
         /* dynamic bind */
         for (b = 0; b < mdb->size3; b++) {
-          if (mdb->phi[b] >= MESHDEFORM_MIN_INFLUENCE) {
+          if (phi[b] >= MESHDEFORM_MIN_INFLUENCE) {
             inf = BLI_memarena_alloc(mdb->memarena, sizeof(*inf));
             inf->vertex = a;
-            inf->weight = mdb->phi[b];
+            inf->weight = phi[b];
             inf->next = mdb->dyngrid[b];
             mdb->dyngrid[b] = inf;
           }
         }
       }
+
+      BLI_snprintf(message,
+                   sizeof(message),
+                   "Mesh deform solve %d / %d       |||",
+                   a + 1,
+                   mdb->totcagevert);
+      progress_bar((float)(a + 1) / (float)(mdb->totcagevert), message);
     }
-    else {
-      modifier_setError(&mmd->modifier, "Failed to find bind solution (increase precision?)");
-      error("Mesh Deform: failed to find bind solution.");
-      break;
-    }
+  }
 
-    BLI_snprintf(
-        message, sizeof(message), "Mesh deform solve %d / %d       |||", a + 1, mdb->totcagevert);
-    progress_bar((float)(a + 1) / (float)(mdb->totcagevert), message);
+  if (!success) {
+    modifier_setError(&mmd->modifier, "Failed to find bind solution (increase precision?)");
+    error("Mesh Deform: failed to find bind solution.");
   }
 
+  for (a = 0; a < chunk_size; a++) {
+    MEM_freeN(data.phi[a]);
+  }
+  MEM_freeN(data.phi);
+  MEM_freeN(data.success);
+
 #if 0
   /* sanity check */
   for (b = 0; b < mdb->size3; b++) {
@@ -1580,13 +1677,24 @@ static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind
   EIG_linear_solver_delete(context);
 }
 
+static void meshdeform_inside_cage_cb(void *__restrict userdata,
+                                      const int a,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshDeformBind *mdb = userdata;
+  float vec[3];
+
+  copy_v3_v3(vec, mdb->vertexcos[a]);
+  mdb->inside[a] = meshdeform_inside_cage(mdb, vec);
+}
+
 static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBind *mdb)
 {
   MDefBindInfluence *inf;
   MDefInfluence *mdinf;
   MDefCell *cell;
-  float center[3], vec[3], maxwidth, totweight;
-  int a, b, x, y, z, totinside, offset;
+  float center[3], maxwidth, totweight;
+  int a, b, x, y, z, offset;
 
   /* compute bounding box of the cage mesh */
   INIT_MINMAX(mdb->min, mdb->max);
@@ -1599,7 +1707,6 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   mdb->size = (2 << (mmd->gridsize - 1)) + 2;
   mdb->size3 = mdb->size * mdb->size * mdb->size;
   mdb->tag = MEM_callocN(sizeof(int) * mdb->size3, "MeshDeformBindTag");
-  mdb->phi = MEM_callocN(sizeof(float) * mdb->size3, "MeshDeformBindPhi");
   mdb->totalphi = MEM_callocN(sizeof(float) * mdb->size3, "MeshDeformBindTotalPhi");
   mdb->boundisect = MEM_callocN(sizeof(*mdb->boundisect) * mdb->size3, "MDefBoundIsect");
   mdb->semibound = MEM_callocN(sizeof(int) * mdb->size3, "MDefSemiBound");
@@ -1650,19 +1757,13 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
 
   progress_bar(0, "Setting up mesh deform system");
 
-  totinside = 0;
-  for (a = 0; a < mdb->totvert; a++) {
-    copy_v3_v3(vec, mdb->vertexcos[a]);
-    mdb->inside[a] = meshdeform_inside_cage(mdb, vec);
-    if (mdb->inside[a]) {
-      totinside++;
-    }
+  {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+    BLI_task_parallel_range(0, mdb->totvert, mdb, meshdeform_inside_cage_cb, &settings);
   }
 
-  /* free temporary MDefBoundIsects */
-  BLI_memarena_free(mdb->memarena);
-  mdb->memarena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "harmonic coords arena");
-
   /* start with all cells untyped */
   for (a = 0; a < mdb->size3; a++) {
     mdb->tag[a] = MESHDEFORM_TAG_UNTYPED;
@@ -1739,7 +1840,6 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   }
 
   MEM_freeN(mdb->tag);
-  MEM_freeN(mdb->phi);
   MEM_freeN(mdb->totalphi);
   MEM_freeN(mdb->boundisect);
   MEM_freeN(mdb->semibound);
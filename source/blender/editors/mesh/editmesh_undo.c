@@ -64,6 +64,8 @@
 #  define ARRAY_CHUNK_SIZE 256
 
 #  define USE_ARRAY_STORE_THREAD
+/* total size of the arrays worth de-duplicating in parallel */
+#  define ARRAY_STORE_PARALLEL_MIN_SIZE (1 << 20)
 #endif
 
 #ifdef USE_ARRAY_STORE_THREAD
@@ -133,12 +135,118 @@ static struct {
 
 } um_arraystore = {{NULL}};
 
+/**
+ * Arrays are added to the store once all of them are known,
+ * so arrays with different strides (which use separate stores) can be de-duplicated in parallel.
+ */
+typedef struct UMArrayStoreAdd {
+  BArrayStore *bs;
+  const void *data;
+  size_t data_len;
+  BArrayState *state_reference;
+  BArrayState **r_state;
+} UMArrayStoreAdd;
+
+typedef struct UMArrayStoreAddList {
+  UMArrayStoreAdd *adds;
+  int adds_len;
+} UMArrayStoreAddList;
+
+static void um_arraystore_add_defer(UMArrayStoreAddList *add_list,
+                                    BArrayStore *bs,
+                                    const void *data,
+                                    const size_t data_len,
+                                    BArrayState *state_reference,
+                                    BArrayState **r_state)
+{
+  UMArrayStoreAdd *add = &add_list->adds[add_list->adds_len++];
+  add->bs = bs;
+  add->data = data;
+  add->data_len = data_len;
+  add->state_reference = state_reference;
+  add->r_state = r_state;
+}
+
+typedef struct UMArrayStoreAddData {
+  const UMArrayStoreAddList *add_list;
+  BArrayStore **stores;
+} UMArrayStoreAddData;
+
+static void um_arraystore_add_for_store(const UMArrayStoreAddList *add_list, BArrayStore *bs)
+{
+  for (int i = 0; i < add_list->adds_len; i++) {
+    const UMArrayStoreAdd *add = &add_list->adds[i];
+    if (add->bs == bs) {
+      *add->r_state = BLI_array_store_state_add(
+          bs, add->data, add->data_len, add->state_reference);
+    }
+  }
+}
+
+#  ifdef USE_ARRAY_STORE_THREAD
+static void um_arraystore_add_for_store_cb(void *__restrict userdata,
+                                           const int store_index,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const UMArrayStoreAddData *data = userdata;
+  um_arraystore_add_for_store(data->add_list, data->stores[store_index]);
+}
+#  endif
+
+static void um_arraystore_add_all(const UMArrayStoreAddList *add_list)
+{
+  if (add_list->adds_len == 0) {
+    return;
+  }
+
+  /* A store is not thread safe, all arrays of one store are added by the same thread. */
+  BArrayStore **stores = MEM_mallocN(sizeof(*stores) * (size_t)add_list->adds_len, __func__);
+  int stores_len = 0;
+  size_t data_len_total = 0;
+  for (int i = 0; i < add_list->adds_len; i++) {
+    const UMArrayStoreAdd *add = &add_list->adds[i];
+    int store_index = 0;
+    while ((store_index < stores_len) && (stores[store_index] != add->bs)) {
+      store_index++;
+    }
+    if (store_index == stores_len) {
+      stores[stores_len++] = add->bs;
+    }
+    data_len_total += add->data_len;
+  }
+
+#  ifdef USE_ARRAY_STORE_THREAD
+  UMArrayStoreAddData data = {
+      .add_list = add_list,
+      .stores = stores,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (stores_len > 1) && (data_len_total >= ARRAY_STORE_PARALLEL_MIN_SIZE);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, stores_len, &data, um_arraystore_add_for_store_cb, &settings);
+#  else
+  UNUSED_VARS(data_len_total);
+  for (int store_index = 0; store_index < stores_len; store_index++) {
+    um_arraystore_add_for_store(add_list, stores[store_index]);
+  }
+#  endif
+
+  MEM_freeN(stores);
+}
+
+/**
+ * \param add_list: When NULL, only free the arrays, otherwise states are added to it
+ * and the arrays must be freed once the states are created.
+ */
 static void um_arraystore_cd_compact(struct CustomData *cdata,
                                      const size_t data_len,
-                                     bool create,
+                                     UMArrayStoreAddList *add_list,
                                      const BArrayCustomData *bcd_reference,
                                      BArrayCustomData **r_bcd_first)
 {
+  const bool create = (add_list != NULL);
+
   if (data_len == 0) {
     if (create) {
       *r_bcd_first = NULL;
@@ -206,15 +314,18 @@ static void um_arraystore_cd_compact(struct CustomData *cdata,
                                           i < bcd_reference_current->states_len) ?
                                              bcd_reference_current->states[i] :
                                              NULL;
-          bcd->states[i] = BLI_array_store_state_add(
-              bs, layer->data, (size_t)data_len * stride, state_reference);
+          um_arraystore_add_defer(add_list,
+                                  bs,
+                                  layer->data,
+                                  (size_t)data_len * stride,
+                                  state_reference,
+                                  &bcd->states[i]);
         }
         else {
           bcd->states[i] = NULL;
         }
       }
-
-      if (layer->data) {
+      else if (layer->data) {
         MEM_freeN(layer->data);
         layer->data = NULL;
       }
@@ -284,15 +395,25 @@ static void um_arraystore_cd_free(BArrayCustomData *bcd)
 static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool create)
 {
   Mesh *me = &um->me;
+  UMArrayStoreAddList add_list_data = {NULL, 0};
+  UMArrayStoreAddList *add_list = NULL;
+
+  if (create) {
+    const int adds_len_max = me->vdata.totlayer + me->edata.totlayer + me->ldata.totlayer +
+                             me->pdata.totlayer + (me->key ? me->key->totkey : 0) + 1;
+    add_list_data.adds = MEM_mallocN(sizeof(*add_list_data.adds) * (size_t)adds_len_max,
+                                     __func__);
+    add_list = &add_list_data;
+  }
 
   um_arraystore_cd_compact(
-      &me->vdata, me->totvert, create, um_ref ? um_ref->store.vdata : NULL, &um->store.vdata);
+      &me->vdata, me->totvert, add_list, um_ref ? um_ref->store.vdata : NULL, &um->store.vdata);
   um_arraystore_cd_compact(
-      &me->edata, me->totedge, create, um_ref ? um_ref->store.edata : NULL, &um->store.edata);
+      &me->edata, me->totedge, add_list, um_ref ? um_ref->store.edata : NULL, &um->store.edata);
   um_arraystore_cd_compact(
-      &me->ldata, me->totloop, create, um_ref ? um_ref->store.ldata : NULL, &um->store.ldata);
+      &me->ldata, me->totloop, add_list, um_ref ? um_ref->store.ldata : NULL, &um->store.ldata);
   um_arraystore_cd_compact(
-      &me->pdata, me->totpoly, create, um_ref ? um_ref->store.pdata : NULL, &um->store.pdata);
+      &me->pdata, me->totpoly, add_list, um_ref ? um_ref->store.pdata : NULL, &um->store.pdata);
 
   if (me->key && me->key->totkey) {
     const size_t stride = me->key->elemsize;
@@ -308,11 +429,14 @@ static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool
         BArrayState *state_reference = (um_ref && um_ref->me.key && (i < um_ref->me.key->totkey)) ?
                                            um_ref->store.keyblocks[i] :
                                            NULL;
-        um->store.keyblocks[i] = BLI_array_store_state_add(
-            bs, keyblock->data, (size_t)keyblock->totelem * stride, state_reference);
+        um_arraystore_add_defer(add_list,
+                                bs,
+                                keyblock->data,
+                                (size_t)keyblock->totelem * stride,
+                                state_reference,
+                                &um->store.keyblocks[i]);
       }
-
-      if (keyblock->data) {
+      else if (keyblock->data) {
         MEM_freeN(keyblock->data);
         keyblock->data = NULL;
       }
@@ -326,17 +450,29 @@ static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool
       const size_t stride = sizeof(*me->mselect);
       BArrayStore *bs = BLI_array_store_at_size_ensure(
           &um_arraystore.bs_stride, stride, ARRAY_CHUNK_SIZE);
-      um->store.mselect = BLI_array_store_state_add(
-          bs, me->mselect, (size_t)me->totselect * stride, state_reference);
+      um_arraystore_add_defer(add_list,
+                              bs,
+                              me->mselect,
+                              (size_t)me->totselect * stride,
+                              state_reference,
+                              &um->store.mselect);
+    }
+    else {
+      /* keep me->totselect for validation */
+      MEM_freeN(me->mselect);
+      me->mselect = NULL;
     }
-
-    /* keep me->totselect for validation */
-    MEM_freeN(me->mselect);
-    me->mselect = NULL;
   }
 
   if (create) {
+    um_arraystore_add_all(add_list);
+    MEM_freeN(add_list_data.adds);
+
     um_arraystore.users += 1;
+
+    /* The states now hold the data, free the arrays. */
+    um_arraystore_compact_ex(um, NULL, false);
+    return;
   }
 
   BKE_mesh_update_customdata_pointers(me, false);
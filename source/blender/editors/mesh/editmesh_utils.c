@@ -29,7 +29,6 @@
 
 #include "BLI_math.h"
 #include "BLI_alloca.h"
-#include "BLI_buffer.h"
 #include "BLI_kdtree.h"
 #include "BLI_listbase.h"
 
@@ -529,7 +528,9 @@ UvVertMap *BM_uv_vert_map_create(BMesh *bm,
   int totverts, i, totuv, totfaces;
   const int cd_loop_uv_offset = CustomData_get_offset(&bm->ldata, CD_MLOOPUV);
   bool *winding = NULL;
-  BLI_buffer_declare_static(vec2f, tf_uv_buf, BLI_BUFFER_NOP, BM_DEFAULT_NGON_STACK_SIZE);
+  /* UV coordinates in the order of the map buffer, avoids looking up
+   * the loops and their custom-data blocks while sorting. */
+  float(*uvs)[2];
 
   BM_mesh_elem_index_ensure(bm, BM_VERT | BM_FACE);
 
@@ -563,13 +564,11 @@ UvVertMap *BM_uv_vert_map_create(BMesh *bm,
     return NULL;
   }
 
+  uvs = MEM_mallocN(sizeof(*uvs) * totuv, __func__);
+
   BM_ITER_MESH_INDEX (efa, &iter, bm, BM_FACES_OF_MESH, a) {
     if ((use_select == false) || BM_elem_flag_test(efa, BM_ELEM_SELECT)) {
-      float(*tf_uv)[2] = NULL;
-
-      if (use_winding) {
-        tf_uv = (float(*)[2])BLI_buffer_reinit_data(&tf_uv_buf, vec2f, efa->len);
-      }
+      float(*tf_uv)[2] = &uvs[buf - vmap->buf];
 
       BM_ITER_ELEM_INDEX (l, &liter, efa, BM_LOOPS_OF_FACE, i) {
         buf->loop_of_poly_index = i;
@@ -580,10 +579,8 @@ UvVertMap *BM_uv_vert_map_create(BMesh *bm,
         vmap->vert[BM_elem_index_get(l->v)] = buf;
         buf++;
 
-        if (use_winding) {
-          luv = BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
-          copy_v2_v2(tf_uv[i], luv->uv);
-        }
+        luv = BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
+        copy_v2_v2(tf_uv[i], luv->uv);
       }
 
       if (use_winding) {
@@ -604,21 +601,14 @@ UvVertMap *BM_uv_vert_map_create(BMesh *bm,
       v->next = newvlist;
       newvlist = v;
 
-      efa = BM_face_at_index(bm, v->poly_index);
-
-      l = BM_iter_at_index(bm, BM_LOOPS_OF_FACE, efa, v->loop_of_poly_index);
-      luv = BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
-      uv = luv->uv;
+      uv = uvs[v - vmap->buf];
 
       lastv = NULL;
       iterv = vlist;
 
       while (iterv) {
         next = iterv->next;
-        efa = BM_face_at_index(bm, iterv->poly_index);
-        l = BM_iter_at_index(bm, BM_LOOPS_OF_FACE, efa, iterv->loop_of_poly_index);
-        luv = BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
-        uv2 = luv->uv;
+        uv2 = uvs[iterv - vmap->buf];
 
         sub_v2_v2v2(uvdiff, uv2, uv);
 
@@ -650,7 +640,7 @@ UvVertMap *BM_uv_vert_map_create(BMesh *bm,
     MEM_freeN(winding);
   }
 
-  BLI_buffer_free(&tf_uv_buf);
+  MEM_freeN(uvs);
 
   return vmap;
 }
@@ -674,7 +664,8 @@ UvElementMap *BM_uv_element_map_create(BMesh *bm,
   UvElementMap *element_map;
   UvElement *buf;
   bool *winding = NULL;
-  BLI_buffer_declare_static(vec2f, tf_uv_buf, BLI_BUFFER_NOP, BM_DEFAULT_NGON_STACK_SIZE);
+  /* UV coordinates in the order of the element buffer, see #BM_uv_vert_map_create. */
+  float(*uvs)[2];
 
   MLoopUV *luv;
   int totverts, totfaces, i, totuv, j;
@@ -709,6 +700,8 @@ UvElementMap *BM_uv_element_map_create(BMesh *bm,
     winding = MEM_mallocN(sizeof(*winding) * totfaces, "winding");
   }
 
+  uvs = MEM_mallocN(sizeof(*uvs) * totuv, __func__);
+
   BM_ITER_MESH_INDEX (efa, &iter, bm, BM_FACES_OF_MESH, j) {
 
     if (use_winding) {
@@ -716,11 +709,7 @@ UvElementMap *BM_uv_element_map_create(BMesh *bm,
     }
 
     if (!selected || BM_elem_flag_test(efa, BM_ELEM_SELECT)) {
-      float(*tf_uv)[2] = NULL;
-
-      if (use_winding) {
-        tf_uv = (float(*)[2])BLI_buffer_reinit_data(&tf_uv_buf, vec2f, efa->len);
-      }
+      float(*tf_uv)[2] = &uvs[buf - element_map->buf];
 
       BM_ITER_ELEM_INDEX (l, &liter, efa, BM_LOOPS_OF_FACE, i) {
         buf->l = l;
@@ -731,10 +720,8 @@ UvElementMap *BM_uv_element_map_create(BMesh *bm,
         buf->next = element_map->vert[BM_elem_index_get(l->v)];
         element_map->vert[BM_elem_index_get(l->v)] = buf;
 
-        if (use_winding) {
-          luv = BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
-          copy_v2_v2(tf_uv[i], luv->uv);
-        }
+        luv = BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
+        copy_v2_v2(tf_uv[i], luv->uv);
 
         buf++;
       }
@@ -757,9 +744,7 @@ UvElementMap *BM_uv_element_map_create(BMesh *bm,
       v->next = newvlist;
       newvlist = v;
 
-      l = v->l;
-      luv = BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
-      uv = luv->uv;
+      uv = uvs[v - element_map->buf];
 
       lastv = NULL;
       iterv = vlist;
@@ -767,9 +752,7 @@ UvElementMap *BM_uv_element_map_create(BMesh *bm,
       while (iterv) {
         next = iterv->next;
 
-        l = iterv->l;
-        luv = BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
-        uv2 = luv->uv;
+        uv2 = uvs[iterv - element_map->buf];
 
         sub_v2_v2v2(uvdiff, uv2, uv);
 
@@ -802,6 +785,8 @@ UvElementMap *BM_uv_element_map_create(BMesh *bm,
     MEM_freeN(winding);
   }
 
+  MEM_freeN(uvs);
+
   if (do_islands) {
     unsigned int *map;
     BMFace **stack;
@@ -906,8 +891,6 @@ UvElementMap *BM_uv_element_map_create(BMesh *bm,
     MEM_freeN(map);
   }
 
-  BLI_buffer_free(&tf_uv_buf);
-
   return element_map;
 }
 
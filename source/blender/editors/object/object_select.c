@@ -435,7 +435,7 @@ static int object_select_by_type_exec(bContext *C, wmOperator *op)
 
   Scene *scene = CTX_data_scene(C);
   DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-  WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+  WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
 
   ED_outliner_select_sync_from_object_tag(C);
 
@@ -640,7 +640,7 @@ void ED_object_select_linked_by_id(bContext *C, ID *id)
   if (changed) {
     Scene *scene = CTX_data_scene(C);
     DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
   }
 }
 
@@ -719,7 +719,7 @@ static int object_select_linked_exec(bContext *C, wmOperator *op)
 
   if (changed) {
     DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
     ED_outliner_select_sync_from_object_tag(C);
     return OPERATOR_FINISHED;
   }
@@ -1103,7 +1103,7 @@ static int object_select_grouped_exec(bContext *C, wmOperator *op)
 
   if (changed) {
     DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
     ED_outliner_select_sync_from_object_tag(C);
     return OPERATOR_FINISHED;
   }
@@ -1153,7 +1153,7 @@ static int object_select_all_exec(bContext *C, wmOperator *op)
   if (changed) {
     Scene *scene = CTX_data_scene(C);
     DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
 
     ED_outliner_select_sync_from_object_tag(C);
 
@@ -1223,7 +1223,7 @@ static int object_select_same_collection_exec(bContext *C, wmOperator *op)
 
   Scene *scene = CTX_data_scene(C);
   DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-  WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+  WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
 
   ED_outliner_select_sync_from_object_tag(C);
 
@@ -1288,7 +1288,7 @@ static int object_select_mirror_exec(bContext *C, wmOperator *op)
 
   /* undo? */
   DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-  WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+  WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
 
   ED_outliner_select_sync_from_object_tag(C);
 
@@ -1379,7 +1379,7 @@ static int object_select_more_exec(bContext *C, wmOperator *UNUSED(op))
   if (changed) {
     Scene *scene = CTX_data_scene(C);
     DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
 
     ED_outliner_select_sync_from_object_tag(C);
 
@@ -1412,7 +1412,7 @@ static int object_select_less_exec(bContext *C, wmOperator *UNUSED(op))
   if (changed) {
     Scene *scene = CTX_data_scene(C);
     DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
 
     ED_outliner_select_sync_from_object_tag(C);
 
@@ -1463,7 +1463,7 @@ static int object_select_random_exec(bContext *C, wmOperator *op)
 
   Scene *scene = CTX_data_scene(C);
   DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-  WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+  WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
 
   ED_outliner_select_sync_from_object_tag(C);
 
@@ -869,13 +869,14 @@ static void light_cache_bake_tag_cache(Scene *scene, wmOperator *op)
     int subset = RNA_enum_get(op->ptr, "subset");
     switch (subset) {
       case LIGHTCACHE_SUBSET_ALL:
-        scene->eevee.light_cache->flag |= LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_CUBE;
+        scene->eevee.light_cache->flag |= LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_CUBE |
+                                          LIGHTCACHE_UPDATE_FULL;
         break;
       case LIGHTCACHE_SUBSET_CUBE:
-        scene->eevee.light_cache->flag |= LIGHTCACHE_UPDATE_CUBE;
+        scene->eevee.light_cache->flag |= LIGHTCACHE_UPDATE_CUBE | LIGHTCACHE_UPDATE_FULL;
         break;
       case LIGHTCACHE_SUBSET_DIRTY:
-        /* Leave tag untouched. */
+        /* Leave tag untouched, only the probes that changed are re-rendered. */
         break;
     }
   }
@@ -5760,9 +5760,10 @@ static void paint_proj_stroke_ps(const bContext *UNUSED(C),
     }
   }
 
+  /* Updating the textures is deferred to #paint_proj_redraw, so the dirty regions of all
+   * dabs since the last redraw are uploaded once. */
   if (project_paint_op(ps, prev_pos, pos)) {
     ps_handle->need_redraw = true;
-    project_image_refresh_tagged(ps);
   }
 }
 
@@ -6021,6 +6022,10 @@ void paint_proj_redraw(const bContext *C, void *ps_handle_p, bool final)
 {
   ProjStrokeHandle *ps_handle = ps_handle_p;
 
+  for (int i = 0; i < ps_handle->ps_views_tot; i++) {
+    project_image_refresh_tagged(ps_handle->ps_views[i]);
+  }
+
   if (ps_handle->need_redraw) {
     ps_handle->need_redraw = false;
   }
@@ -1832,6 +1832,31 @@ static float brush_strength(const Sculpt *sd,
   }
 }
 
+static void sculpt_falloff_table_init(StrokeCache *cache, const Brush *br)
+{
+  for (int i = 0; i <= SCULPT_FALLOFF_TABLE_SIZE; i++) {
+    /* The curve is zero beyond the radius, sample the last entry just inside of it. */
+    const float len = min_ff((float)i / SCULPT_FALLOFF_TABLE_SIZE, 1.0f - FLT_EPSILON);
+    cache->falloff_table[i] = BKE_brush_curve_strength(br, len, 1.0f);
+  }
+  cache->falloff_table_brush = br;
+}
+
+/* Same as #BKE_brush_curve_strength with the stroke radius, interpolated from the table. */
+static float sculpt_falloff_strength(const StrokeCache *cache, const Brush *br, const float len)
+{
+  if (br != cache->falloff_table_brush) {
+    return BKE_brush_curve_strength(br, len, cache->radius);
+  }
+  if (len >= cache->radius) {
+    return 0.0f;
+  }
+
+  const float fi = len / cache->radius * SCULPT_FALLOFF_TABLE_SIZE;
+  const int i = min_ii((int)fi, SCULPT_FALLOFF_TABLE_SIZE - 1);
+  return interpf(cache->falloff_table[i + 1], cache->falloff_table[i], fi - (float)i);
+}
+
 /* Return a multiplier for brush strength on a particular vertex. */
 float tex_strength(SculptSession *ss,
                    const Brush *br,
@@ -1905,7 +1930,7 @@ float tex_strength(SculptSession *ss,
   }
 
   /* Falloff curve */
-  avg *= BKE_brush_curve_strength(br, len, cache->radius);
+  avg *= sculpt_falloff_strength(cache, br, len);
   avg *= frontface(br, cache->view_normal, vno, fno);
 
   /* Paint mask */
@@ -6442,6 +6467,9 @@ static void sculpt_update_cache_invariants(
 
   cache->brush = brush;
 
+  BKE_curvemapping_initialize(brush->curve);
+  sculpt_falloff_table_init(cache, brush);
+
   /* cache projection matrix */
   ED_view3d_ob_project_mat_get(cache->vc->rv3d, ob, cache->projection_mat);
 
@@ -7299,6 +7327,8 @@ static void sculpt_flush_update_done(const bContext *C, Object *ob, SculptUpdate
   }
 
   if (need_tag) {
+    /* The stroke did not change the topology, the PBVH tessellation stays valid. */
+    ss->keep_looptri = true;
     DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
   }
 }
@@ -9082,6 +9112,22 @@ static EnumPropertyItem prop_mask_filter_types[] = {
     {0, NULL, 0, NULL, NULL},
 };
 
+/* Nodes with the same mask value on all of their vertices can be left out by filters which
+ * keep that value. Every vertex of such a node has neighbors with the same value in the node's
+ * faces, so growing a fully masked node or shrinking a fully unmasked one does not change it. */
+static bool mask_filter_node_is_unchanged(PBVHNode *node, const int mode)
+{
+  switch (mode) {
+    case MASK_FILTER_GROW:
+      return BKE_pbvh_node_fully_masked_get(node);
+    case MASK_FILTER_SHRINK:
+      return BKE_pbvh_node_fully_unmasked_get(node);
+    case MASK_FILTER_CONTRAST_INCREASE:
+      return BKE_pbvh_node_fully_masked_get(node) || BKE_pbvh_node_fully_unmasked_get(node);
+  }
+  return false;
+}
+
 static void mask_filter_task_cb(void *__restrict userdata,
                                 const int i,
                                 const TaskParallelTLS *__restrict UNUSED(tls))
@@ -9096,6 +9142,10 @@ static void mask_filter_task_cb(void *__restrict userdata,
 
   PBVHVertexIter vd;
 
+  if (mask_filter_node_is_unchanged(node, mode)) {
+    return;
+  }
+
   if (mode == MASK_FILTER_CONTRAST_INCREASE) {
     contrast = 0.1f;
   }
@@ -9256,6 +9306,9 @@ static int sculpt_mask_filter_exec(bContext *C, wmOperator *op)
     BKE_pbvh_parallel_range_settings(&settings, (sd->flags & SCULPT_USE_OPENMP), totnode);
     BKE_pbvh_parallel_range(0, totnode, &data, mask_filter_task_cb, &settings);
 
+    /* Update the fully masked and unmasked flags of modified nodes for the next iteration. */
+    BKE_pbvh_update_vertex_data(pbvh, PBVH_UpdateMask);
+
     if (ELEM(filter_type, MASK_FILTER_GROW, MASK_FILTER_SHRINK)) {
       MEM_freeN(prev_mask);
     }
@@ -148,6 +148,9 @@ typedef struct SculptUndoNode {
  * (could be configurable but this is reasonable default). */
 #define SCULPT_RAKE_BRUSH_FACTOR 0.25f
 
+/* Number of samples of the brush falloff curve cached for a stroke. */
+#define SCULPT_FALLOFF_TABLE_SIZE 1024
+
 struct SculptRakeData {
   float follow_dist;
   float follow_co[3];
@@ -342,6 +345,11 @@ typedef struct StrokeCache {
   struct ViewContext *vc;
   const struct Brush *brush;
 
+  /* Falloff curve of falloff_table_brush sampled over the distance to the brush center relative
+   * to the radius, instead of evaluating the curve for every vertex. */
+  const struct Brush *falloff_table_brush;
+  float falloff_table[SCULPT_FALLOFF_TABLE_SIZE + 1];
+
   float special_rotation;
   float grab_delta[3], grab_delta_symmetry[3];
   float old_grab_location[3], orig_grab_location[3];
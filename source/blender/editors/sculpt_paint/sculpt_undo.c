@@ -46,6 +46,7 @@
 #include "BKE_multires.h"
 #include "BKE_paint.h"
 #include "BKE_key.h"
+#include "BKE_library.h"
 #include "BKE_mesh.h"
 #include "BKE_scene.h"
 #include "BKE_subsurf.h"
@@ -796,7 +797,7 @@ static SculptUndoNode *sculpt_undo_alloc_node(Object *ob, PBVHNode *node, Sculpt
       unode->co = MEM_mapallocN(sizeof(float[3]) * allvert, "SculptUndoNode.co");
       unode->no = MEM_mapallocN(sizeof(short[3]) * allvert, "SculptUndoNode.no");
 
-      usculpt->undo_size = (sizeof(float[3]) + sizeof(short[3]) + sizeof(int)) * allvert;
+      usculpt->undo_size += (sizeof(float[3]) + sizeof(short[3]) + sizeof(int)) * allvert;
       break;
     case SCULPT_UNDO_HIDDEN:
       if (maxgrid) {
@@ -810,7 +811,7 @@ static SculptUndoNode *sculpt_undo_alloc_node(Object *ob, PBVHNode *node, Sculpt
     case SCULPT_UNDO_MASK:
       unode->mask = MEM_mapallocN(sizeof(float) * allvert, "SculptUndoNode.mask");
 
-      usculpt->undo_size += (sizeof(float) * sizeof(int)) * allvert;
+      usculpt->undo_size += (sizeof(float) + sizeof(int)) * allvert;
 
       break;
     case SCULPT_UNDO_DYNTOPO_BEGIN:
@@ -1108,10 +1109,84 @@ void sculpt_undo_push_begin(const char *name)
   BKE_undosys_step_push_init_with_type(ustack, C, name, BKE_UNDOSYS_TYPE_SCULPT);
 }
 
+/* Remove the vertices which were not modified since the node was pushed from a regular mesh
+ * undo node, swapping them on undo and redo does nothing. Strokes usually only modify a part of
+ * every node they touch, so this keeps the undo memory close to the size of the brush area.
+ *
+ * Only done once the stroke ended, while painting the node is indexed by its vertices. Returns
+ * the number of bytes freed. */
+static size_t sculpt_undo_node_compact(SculptSession *ss, SculptUndoNode *unode)
+{
+  if (unode->node == NULL || unode->maxvert == 0 || unode->maxvert != ss->totvert ||
+      unode->orig_co != NULL || BKE_pbvh_type(ss->pbvh) != PBVH_FACES) {
+    return 0;
+  }
+
+  const int *index = unode->index;
+  int totvert = 0;
+
+  if (unode->type == SCULPT_UNDO_COORDS && unode->co) {
+    MVert *mvert;
+    BKE_pbvh_node_get_verts(ss->pbvh, unode->node, NULL, &mvert);
+
+    for (int i = 0; i < unode->totvert; i++) {
+      /* no need for float comparison here (memory is exactly equal or not) */
+      if (memcmp(mvert[index[i]].co, unode->co[i], sizeof(float[3])) != 0) {
+        copy_v3_v3(unode->co[totvert], unode->co[i]);
+        unode->index[totvert] = index[i];
+        totvert++;
+      }
+    }
+  }
+  else if (unode->type == SCULPT_UNDO_MASK && unode->mask && ss->vmask) {
+    for (int i = 0; i < unode->totvert; i++) {
+      if (ss->vmask[index[i]] != unode->mask[i]) {
+        unode->mask[totvert] = unode->mask[i];
+        unode->index[totvert] = index[i];
+        totvert++;
+      }
+    }
+  }
+  else {
+    return 0;
+  }
+
+  if (totvert == unode->totvert) {
+    return 0;
+  }
+
+  /* Reallocate, the arrays were allocated for all vertices of the node. */
+  const size_t elem_size = (unode->type == SCULPT_UNDO_COORDS) ? sizeof(float[3]) :
+                                                                 sizeof(float);
+  void **data_p = (unode->type == SCULPT_UNDO_COORDS) ? (void **)&unode->co :
+                                                        (void **)&unode->mask;
+  int *index_compact = NULL;
+  void *data_compact = NULL;
+  if (totvert != 0) {
+    index_compact = MEM_mallocN(sizeof(int) * totvert, "SculptUndoNode.index");
+    data_compact = MEM_mallocN(elem_size * totvert, "SculptUndoNode.data");
+    memcpy(index_compact, unode->index, sizeof(int) * totvert);
+    memcpy(data_compact, *data_p, elem_size * totvert);
+  }
+  MEM_freeN(unode->index);
+  MEM_freeN(*data_p);
+  unode->index = index_compact;
+  *data_p = data_compact;
+
+  const size_t size_freed = (elem_size + sizeof(int)) * (size_t)(unode->totvert - totvert);
+  unode->totvert = totvert;
+
+  /* The node data is not valid for the original coordinates of the PBVH node anymore. */
+  unode->node = NULL;
+
+  return size_freed;
+}
+
 void sculpt_undo_push_end(void)
 {
   UndoSculpt *usculpt = sculpt_undo_get_nodes();
   SculptUndoNode *unode;
+  Object *ob = NULL;
 
   /* we don't need normals in the undo stack */
   for (unode = usculpt->nodes.first; unode; unode = unode->next) {
@@ -1123,6 +1198,14 @@ void sculpt_undo_push_end(void)
     if (unode->node) {
       BKE_pbvh_node_layer_disp_free(unode->node);
     }
+
+    if (ob == NULL || !STREQ(ob->id.name, unode->idname)) {
+      ob = (Object *)BKE_libblock_find_name(G_MAIN, ID_OB, unode->idname + 2);
+    }
+    if (ob && ob->sculpt && ob->sculpt->pbvh) {
+      const size_t size_freed = sculpt_undo_node_compact(ob->sculpt, unode);
+      usculpt->undo_size -= min_zz(size_freed, usculpt->undo_size);
+    }
   }
 
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
@@ -2423,6 +2423,100 @@ static int filelist_readjob_list_dir(const char *root,
   return nbr_entries;
 }
 
+/**
+ * Session cache of the names listed inside .blend files, keyed by the library path (including
+ * the group), so browsing the same libraries again does not re-open every file.
+ * Entries are validated against the modification time and size of the .blend file.
+ */
+typedef struct FileListLibCacheEntry {
+  int64_t mtime;
+  int64_t size;
+  LinkNode *names;
+  int nnames;
+} FileListLibCacheEntry;
+
+#define FILELIST_LIB_CACHE_MAX_ENTRIES 4096
+
+static GHash *filelist_lib_cache = NULL;
+static ThreadMutex filelist_lib_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static LinkNode *filelist_lib_cache_names_copy(LinkNode *names)
+{
+  LinkNodePair names_copy = {NULL, NULL};
+  for (LinkNode *ln = names; ln; ln = ln->next) {
+    BLI_linklist_append(&names_copy, strdup(ln->link));
+  }
+  return names_copy.list;
+}
+
+static void filelist_lib_cache_entry_free(void *entry_v)
+{
+  FileListLibCacheEntry *entry = entry_v;
+  BLI_linklist_free(entry->names, free);
+  MEM_freeN(entry);
+}
+
+static bool filelist_lib_cache_lookup(const char *root,
+                                      const BLI_stat_t *st,
+                                      LinkNode **r_names,
+                                      int *r_nnames)
+{
+  bool found = false;
+
+  BLI_mutex_lock(&filelist_lib_cache_lock);
+  FileListLibCacheEntry *entry = filelist_lib_cache ? BLI_ghash_lookup(filelist_lib_cache, root) :
+                                                      NULL;
+  if (entry && entry->mtime == (int64_t)st->st_mtime && entry->size == (int64_t)st->st_size) {
+    *r_names = filelist_lib_cache_names_copy(entry->names);
+    *r_nnames = entry->nnames;
+    found = true;
+  }
+  BLI_mutex_unlock(&filelist_lib_cache_lock);
+
+  return found;
+}
+
+static void filelist_lib_cache_store(const char *root,
+                                     const BLI_stat_t *st,
+                                     LinkNode *names,
+                                     const int nnames)
+{
+  FileListLibCacheEntry *entry = MEM_mallocN(sizeof(*entry), __func__);
+  entry->mtime = (int64_t)st->st_mtime;
+  entry->size = (int64_t)st->st_size;
+  entry->names = filelist_lib_cache_names_copy(names);
+  entry->nnames = nnames;
+
+  BLI_mutex_lock(&filelist_lib_cache_lock);
+  if (filelist_lib_cache == NULL) {
+    filelist_lib_cache = BLI_ghash_str_new(__func__);
+  }
+  else if (BLI_ghash_len(filelist_lib_cache) >= FILELIST_LIB_CACHE_MAX_ENTRIES) {
+    /* Simple but good enough, browsing that many libraries in one session is rare. */
+    BLI_ghash_clear(filelist_lib_cache, MEM_freeN, filelist_lib_cache_entry_free);
+  }
+
+  void **key_p, **val_p;
+  if (BLI_ghash_ensure_p_ex(filelist_lib_cache, root, &key_p, &val_p)) {
+    filelist_lib_cache_entry_free(*val_p);
+  }
+  else {
+    *key_p = BLI_strdup(root);
+  }
+  *val_p = entry;
+  BLI_mutex_unlock(&filelist_lib_cache_lock);
+}
+
+void filelist_free_lib_cache(void)
+{
+  BLI_mutex_lock(&filelist_lib_cache_lock);
+  if (filelist_lib_cache) {
+    BLI_ghash_free(filelist_lib_cache, MEM_freeN, filelist_lib_cache_entry_free);
+    filelist_lib_cache = NULL;
+  }
+  BLI_mutex_unlock(&filelist_lib_cache_lock);
+}
+
 static int filelist_readjob_list_lib(const char *root, ListBase *entries, const bool skip_currpar)
 {
   FileListInternEntry *entry;
@@ -2430,6 +2524,7 @@ static int filelist_readjob_list_lib(const char *root, ListBase *entries, const
   int i, nnames, idcode = 0, nbr_entries = 0;
   char dir[FILE_MAX_LIBEXTRA], *group;
   bool ok;
+  BLI_stat_t st;
 
   struct BlendHandle *libfiledata = NULL;
 
@@ -2439,24 +2534,35 @@ static int filelist_readjob_list_lib(const char *root, ListBase *entries, const
     return nbr_entries;
   }
 
-  /* there we go */
-  libfiledata = BLO_blendhandle_from_file(dir, NULL);
-  if (libfiledata == NULL) {
+  if (BLI_stat(dir, &st) == -1) {
     return nbr_entries;
   }
 
-  /* memory for strings is passed into filelist[i].entry->relpath
-   * and freed in filelist_entry_free. */
   if (group) {
     idcode = groupname_to_code(group);
-    names = BLO_blendhandle_get_datablock_names(libfiledata, idcode, &nnames);
-  }
-  else {
-    names = BLO_blendhandle_get_linkable_groups(libfiledata);
-    nnames = BLI_linklist_count(names);
   }
 
-  BLO_blendhandle_close(libfiledata);
+  /* memory for strings is passed into filelist[i].entry->relpath
+   * and freed in filelist_entry_free. */
+  if (!filelist_lib_cache_lookup(root, &st, &names, &nnames)) {
+    /* there we go */
+    libfiledata = BLO_blendhandle_from_file(dir, NULL);
+    if (libfiledata == NULL) {
+      return nbr_entries;
+    }
+
+    if (group) {
+      names = BLO_blendhandle_get_datablock_names(libfiledata, idcode, &nnames);
+    }
+    else {
+      names = BLO_blendhandle_get_linkable_groups(libfiledata);
+      nnames = BLI_linklist_count(names);
+    }
+
+    BLO_blendhandle_close(libfiledata);
+
+    filelist_lib_cache_store(root, &st, names, nnames);
+  }
 
   if (!skip_currpar) {
     entry = MEM_callocN(sizeof(*entry), __func__);
@@ -2660,6 +2766,59 @@ static void filelist_readjob_main_rec(Main *bmain, FileList *filelist)
 }
 #endif
 
+/* Directories listed together by #filelist_readjob_do. */
+#define FILELIST_READJOB_MAX_LIST_DIRS 256
+
+typedef struct FileListReadJobListData {
+  bool do_lib;
+  const char *main_name;
+  const char *filter_glob;
+  short *stop;
+} FileListReadJobListData;
+
+typedef struct FileListReadJobListDir {
+  char *dir;
+  int level;
+
+  /* Result of the listing. */
+  ListBase entries;
+  int nbr_entries;
+  bool is_lib;
+} FileListReadJobListDir;
+
+static void filelist_readjob_list_dir_any(const FileListReadJobListData *data,
+                                          FileListReadJobListDir *list_dir)
+{
+  const bool skip_currpar = (list_dir->level > 1);
+
+  if (*data->stop) {
+    return;
+  }
+
+  list_dir->is_lib = data->do_lib;
+  if (data->do_lib) {
+    list_dir->nbr_entries = filelist_readjob_list_lib(
+        list_dir->dir, &list_dir->entries, skip_currpar);
+  }
+  if (!list_dir->nbr_entries) {
+    list_dir->is_lib = false;
+    list_dir->nbr_entries = filelist_readjob_list_dir(list_dir->dir,
+                                                      &list_dir->entries,
+                                                      data->filter_glob,
+                                                      data->do_lib,
+                                                      data->main_name,
+                                                      skip_currpar);
+  }
+}
+
+static void filelist_readjob_list_dir_task(TaskPool *__restrict pool,
+                                           void *taskdata,
+                                           int UNUSED(threadid))
+{
+  const FileListReadJobListData *data = BLI_task_pool_userdata(pool);
+  filelist_readjob_list_dir_any(data, taskdata);
+}
+
 static void filelist_readjob_do(const bool do_lib,
                                 FileList *filelist,
                                 const char *main_name,
@@ -2668,7 +2827,6 @@ static void filelist_readjob_do(const bool do_lib,
                                 float *progress,
                                 ThreadMutex *lock)
 {
-  ListBase entries = {0};
   BLI_Stack *todo_dirs;
   TodoDir *td_dir;
   char dir[FILE_MAX_LIBEXTRA];
@@ -2692,93 +2850,113 @@ static void filelist_readjob_do(const bool do_lib,
   td_dir->dir = BLI_strdup(dir);
 
   while (!BLI_stack_is_empty(todo_dirs) && !(*stop)) {
-    FileListInternEntry *entry;
-    int nbr_entries = 0;
-    bool is_lib = do_lib;
-
-    char *subdir;
-    char rel_subdir[FILE_MAX_LIBEXTRA];
-    int recursion_level;
-    bool skip_currpar;
-
-    td_dir = BLI_stack_peek(todo_dirs);
-    subdir = td_dir->dir;
-    recursion_level = td_dir->level;
-    skip_currpar = (recursion_level > 1);
-
-    BLI_stack_discard(todo_dirs);
+    /* List all pending directories at once, in parallel when there are several of them
+     * (e.g. all .blend files of a directory when recursing into libraries). */
+    const int nbr_list_dirs = (int)min_zz(BLI_stack_count(todo_dirs),
+                                          FILELIST_READJOB_MAX_LIST_DIRS);
+    FileListReadJobListDir *list_dirs = MEM_callocN(sizeof(*list_dirs) * (size_t)nbr_list_dirs,
+                                                    __func__);
+    for (int i = 0; i < nbr_list_dirs; i++) {
+      td_dir = BLI_stack_peek(todo_dirs);
+      list_dirs[i].dir = td_dir->dir;
+      list_dirs[i].level = td_dir->level;
+      BLI_stack_discard(todo_dirs);
+    }
+
+    FileListReadJobListData list_data = {
+        .do_lib = do_lib,
+        .main_name = main_name,
+        .filter_glob = filter_glob,
+        .stop = stop,
+    };
+    if (nbr_list_dirs > 1) {
+      TaskPool *task_pool = BLI_task_pool_create(BLI_task_scheduler_get(), &list_data);
+      for (int i = 0; i < nbr_list_dirs; i++) {
+        BLI_task_pool_push(
+            task_pool, filelist_readjob_list_dir_task, &list_dirs[i], false, TASK_PRIORITY_HIGH);
+      }
+      BLI_task_pool_work_and_wait(task_pool);
+      BLI_task_pool_free(task_pool);
+    }
+    else {
+      filelist_readjob_list_dir_any(&list_data, &list_dirs[0]);
+    }
 
-    /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
-     * entry->relpath itself (nor any path containing it), since it may actually be a datablock
-     * name inside .blend file, which can have slashes and backslashes! See T46827.
-     * Note that in the end, this means we 'cache' valid relative subdir once here,
-     * this is actually better. */
-    BLI_strncpy(rel_subdir, subdir, sizeof(rel_subdir));
-    BLI_cleanup_dir(root, rel_subdir);
-    BLI_path_rel(rel_subdir, root);
-
-    if (do_lib) {
-      nbr_entries = filelist_readjob_list_lib(subdir, &entries, skip_currpar);
-    }
-    if (!nbr_entries) {
-      is_lib = false;
-      nbr_entries = filelist_readjob_list_dir(
-          subdir, &entries, filter_glob, do_lib, main_name, skip_currpar);
-    }
-
-    for (entry = entries.first; entry; entry = entry->next) {
-      BLI_join_dirfile(dir, sizeof(dir), rel_subdir, entry->relpath);
-
-      /* Generate our entry uuid. Abusing uuid as an uint32, shall be more than enough here,
-       * things would crash way before we overflow that counter!
-       * Using an atomic operation to avoid having to lock thread...
-       * Note that we do not really need this here currently,
-       * since there is a single listing thread, but better
-       * remain consistent about threading! */
-      *((uint32_t *)entry->uuid) = atomic_add_and_fetch_uint32(
-          (uint32_t *)filelist->filelist_intern.curr_uuid, 1);
-
-      /* Only thing we change in direntry here, so we need to free it first. */
-      MEM_freeN(entry->relpath);
-      entry->relpath = BLI_strdup(dir + 2); /* + 2 to remove '//'
-                                             * added by BLI_path_rel to rel_subdir. */
-      entry->name = BLI_strdup(fileentry_uiname(root, entry->relpath, entry->typeflag, dir));
-
-      /* Here we decide whether current filedirentry is to be listed too, or not. */
-      if (max_recursion && (is_lib || (recursion_level <= max_recursion))) {
-        if (((entry->typeflag & FILE_TYPE_DIR) == 0) || FILENAME_IS_CURRPAR(entry->relpath)) {
-          /* Skip... */
-        }
-        else if (!is_lib && (recursion_level >= max_recursion) &&
-                 ((entry->typeflag & (FILE_TYPE_BLENDER | FILE_TYPE_BLENDER_BACKUP)) == 0)) {
-          /* Do not recurse in real directories in this case, only in .blend libs. */
-        }
-        else {
-          /* We have a directory we want to list, add it to todo list! */
-          BLI_join_dirfile(dir, sizeof(dir), root, entry->relpath);
-          BLI_cleanup_dir(main_name, dir);
-          td_dir = BLI_stack_push_r(todo_dirs);
-          td_dir->level = recursion_level + 1;
-          td_dir->dir = BLI_strdup(dir);
-          nbr_todo_dirs++;
+    for (int list_dir_index = 0; list_dir_index < nbr_list_dirs; list_dir_index++) {
+      FileListReadJobListDir *list_dir = &list_dirs[list_dir_index];
+      FileListInternEntry *entry;
+      ListBase entries = list_dir->entries;
+      const int nbr_entries = list_dir->nbr_entries;
+      const bool is_lib = list_dir->is_lib;
+      char *subdir = list_dir->dir;
+      const int recursion_level = list_dir->level;
+      char rel_subdir[FILE_MAX_LIBEXTRA];
+
+      /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
+       * entry->relpath itself (nor any path containing it), since it may actually be a datablock
+       * name inside .blend file, which can have slashes and backslashes! See T46827.
+       * Note that in the end, this means we 'cache' valid relative subdir once here,
+       * this is actually better. */
+      BLI_strncpy(rel_subdir, subdir, sizeof(rel_subdir));
+      BLI_cleanup_dir(root, rel_subdir);
+      BLI_path_rel(rel_subdir, root);
+
+      for (entry = entries.first; entry; entry = entry->next) {
+        BLI_join_dirfile(dir, sizeof(dir), rel_subdir, entry->relpath);
+
+        /* Generate our entry uuid. Abusing uuid as an uint32, shall be more than enough here,
+         * things would crash way before we overflow that counter!
+         * Using an atomic operation to avoid having to lock thread...
+         * Note that we do not really need this here currently,
+         * since there is a single listing thread, but better
+         * remain consistent about threading! */
+        *((uint32_t *)entry->uuid) = atomic_add_and_fetch_uint32(
+            (uint32_t *)filelist->filelist_intern.curr_uuid, 1);
+
+        /* Only thing we change in direntry here, so we need to free it first. */
+        MEM_freeN(entry->relpath);
+        entry->relpath = BLI_strdup(dir + 2); /* + 2 to remove '//'
+                                               * added by BLI_path_rel to rel_subdir. */
+        entry->name = BLI_strdup(fileentry_uiname(root, entry->relpath, entry->typeflag, dir));
+
+        /* Here we decide whether current filedirentry is to be listed too, or not. */
+        if (max_recursion && (is_lib || (recursion_level <= max_recursion))) {
+          if (((entry->typeflag & FILE_TYPE_DIR) == 0) || FILENAME_IS_CURRPAR(entry->relpath)) {
+            /* Skip... */
+          }
+          else if (!is_lib && (recursion_level >= max_recursion) &&
+                   ((entry->typeflag & (FILE_TYPE_BLENDER | FILE_TYPE_BLENDER_BACKUP)) == 0)) {
+            /* Do not recurse in real directories in this case, only in .blend libs. */
+          }
+          else {
+            /* We have a directory we want to list, add it to todo list! */
+            BLI_join_dirfile(dir, sizeof(dir), root, entry->relpath);
+            BLI_cleanup_dir(main_name, dir);
+            td_dir = BLI_stack_push_r(todo_dirs);
+            td_dir->level = recursion_level + 1;
+            td_dir->dir = BLI_strdup(dir);
+            nbr_todo_dirs++;
+          }
         }
       }
-    }
 
-    if (nbr_entries) {
-      BLI_mutex_lock(lock);
+      if (nbr_entries) {
+        BLI_mutex_lock(lock);
 
-      *do_update = true;
+        *do_update = true;
 
-      BLI_movelisttolist(&filelist->filelist.entries, &entries);
-      filelist->filelist.nbr_entries += nbr_entries;
+        BLI_movelisttolist(&filelist->filelist.entries, &entries);
+        filelist->filelist.nbr_entries += nbr_entries;
+
+        BLI_mutex_unlock(lock);
+      }
 
-      BLI_mutex_unlock(lock);
+      nbr_done_dirs++;
+      *progress = (float)nbr_done_dirs / (float)nbr_todo_dirs;
+      MEM_freeN(subdir);
     }
 
-    nbr_done_dirs++;
-    *progress = (float)nbr_done_dirs / (float)nbr_todo_dirs;
-    MEM_freeN(subdir);
+    MEM_freeN(list_dirs);
   }
 
   /* If we were interrupted by stop, stack may not be empty and we need to free
@@ -70,6 +70,7 @@ void filelist_filter(struct FileList *filelist);
 
 void filelist_init_icons(void);
 void filelist_free_icons(void);
+void filelist_free_lib_cache(void);
 void filelist_imgsize(struct FileList *filelist, short w, short h);
 struct ImBuf *filelist_getimage(struct FileList *filelist, const int index);
 struct ImBuf *filelist_geticon_image(struct FileList *filelist, const int index);
@@ -785,6 +785,7 @@ void ED_file_init(void)
 void ED_file_exit(void)
 {
   fsmenu_free();
+  filelist_free_lib_cache();
 
   if (G.background == false) {
     filelist_free_icons();
@@ -28,6 +28,9 @@
  *
  * When the undo system manages an image, there will always be a full copy (as a #UndoImageBuf)
  * each new undo step only stores modified tiles.
+ *
+ * Once a step is encoded, its tiles are compressed in a background task,
+ * which must be finished before tiles are accessed again (see #utile_compress_tasks_wait).
  */
 
 #include "CLG_log.h"
@@ -37,6 +40,7 @@
 #include "BLI_math.h"
 #include "BLI_blenlib.h"
 #include "BLI_utildefines.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "DNA_image_types.h"
@@ -64,6 +68,8 @@
 
 #include "WM_api.h"
 
+#include "zlib.h"
+
 static CLG_LogRef LOG = {"ed.image.undo"};
 
 /* -------------------------------------------------------------------- */
@@ -321,30 +327,130 @@ static uint index_from_xy(uint tile_x, uint tile_y, const uint tiles_dims[2])
 }
 
 typedef struct UndoImageTile {
+  /** NULL once the tile is compressed. */
   union {
     float *fp;
     uint *uint;
     void *pt;
   } rect;
+  /** Size of the uncompressed rect in bytes. */
+  uint rect_size;
+
+  void *rect_compressed;
+  uint rect_compressed_size;
+  /** Compression was tried but didn't save enough memory. */
+  bool use_uncompressed;
+
   int users;
 } UndoImageTile;
 
+#define UTILE_RECT_SIZE_MAX (sizeof(float[4]) * SQUARE(ED_IMAGE_UNDO_TILE_SIZE))
+
 static UndoImageTile *utile_alloc(bool has_float)
 {
   UndoImageTile *utile = MEM_callocN(sizeof(*utile), "ImageUndoTile");
   if (has_float) {
-    utile->rect.fp = MEM_mallocN(sizeof(float[4]) * SQUARE(ED_IMAGE_UNDO_TILE_SIZE), __func__);
+    utile->rect_size = sizeof(float[4]) * SQUARE(ED_IMAGE_UNDO_TILE_SIZE);
   }
   else {
-    utile->rect.uint = MEM_mallocN(sizeof(uint) * SQUARE(ED_IMAGE_UNDO_TILE_SIZE), __func__);
+    utile->rect_size = sizeof(uint) * SQUARE(ED_IMAGE_UNDO_TILE_SIZE);
   }
+  utile->rect.pt = MEM_mallocN(utile->rect_size, __func__);
   return utile;
 }
 
+/**
+ * Scratch memory for compressing and expanding tiles, one per thread.
+ */
+typedef struct UndoImageTileBuffers {
+  uchar *rect_shuffle;
+  uchar *rect_compressed;
+  uchar *rect;
+  uLong rect_compressed_size_max;
+} UndoImageTileBuffers;
+
+static void utile_buffers_init(UndoImageTileBuffers *buffers)
+{
+  buffers->rect_compressed_size_max = compressBound(UTILE_RECT_SIZE_MAX);
+  buffers->rect_shuffle = MEM_mallocN(UTILE_RECT_SIZE_MAX, __func__);
+  buffers->rect_compressed = MEM_mallocN(buffers->rect_compressed_size_max, __func__);
+  buffers->rect = MEM_mallocN(UTILE_RECT_SIZE_MAX, __func__);
+}
+
+static void utile_buffers_free(UndoImageTileBuffers *buffers)
+{
+  MEM_freeN(buffers->rect_shuffle);
+  MEM_freeN(buffers->rect_compressed);
+  MEM_freeN(buffers->rect);
+}
+
+/**
+ * Compress the tile, the bytes of every 4 byte value are stored in separate planes first.
+ * These compress much better for both byte and float images,
+ * since the bytes in one plane (channels, exponents) tend to be similar.
+ */
+static void utile_compress(UndoImageTile *utile, UndoImageTileBuffers *buffers)
+{
+  if ((utile->rect.pt == NULL) || utile->use_uncompressed) {
+    return;
+  }
+
+  const uint values_len = utile->rect_size / 4;
+  const uchar *rect = utile->rect.pt;
+  for (uint i = 0; i < values_len; i++) {
+    for (uint b = 0; b < 4; b++) {
+      buffers->rect_shuffle[(b * values_len) + i] = rect[(i * 4) + b];
+    }
+  }
+
+  uLongf compressed_size = buffers->rect_compressed_size_max;
+  if ((compress2(buffers->rect_compressed,
+                 &compressed_size,
+                 buffers->rect_shuffle,
+                 utile->rect_size,
+                 Z_BEST_SPEED) != Z_OK) ||
+      (compressed_size > (utile->rect_size / 4) * 3)) {
+    utile->use_uncompressed = true;
+    return;
+  }
+
+  utile->rect_compressed = MEM_mallocN(compressed_size, __func__);
+  memcpy(utile->rect_compressed, buffers->rect_compressed, compressed_size);
+  utile->rect_compressed_size = (uint)compressed_size;
+  MEM_freeN(utile->rect.pt);
+  utile->rect.pt = NULL;
+}
+
+/**
+ * 
+eturn The uncompressed rect of the tile, which may be expanded into  buffers.
+ */
+static const void *utile_rect_get(const UndoImageTile *utile, UndoImageTileBuffers *buffers)
+{
+  if (utile->rect.pt != NULL) {
+    return utile->rect.pt;
+  }
+
+  uLongf size = utile->rect_size;
+  const int ret = uncompress(
+      buffers->rect_shuffle, &size, utile->rect_compressed, utile->rect_compressed_size);
+  BLI_assert((ret == Z_OK) && (size == utile->rect_size));
+  UNUSED_VARS_NDEBUG(ret);
+
+  const uint values_len = utile->rect_size / 4;
+  for (uint i = 0; i < values_len; i++) {
+    for (uint b = 0; b < 4; b++) {
+      buffers->rect[(i * 4) + b] = buffers->rect_shuffle[(b * values_len) + i];
+    }
+  }
+  return buffers->rect;
+}
+
 static void utile_init_from_imbuf(
     UndoImageTile *utile, const uint x, const uint y, const ImBuf *ibuf, ImBuf *tmpibuf)
 {
   const bool has_float = ibuf->rect_float;
+  BLI_assert(utile->rect.pt != NULL);
 
   if (has_float) {
     SWAP(float *, utile->rect.fp, tmpibuf->rect_float);
@@ -363,18 +469,23 @@ static void utile_init_from_imbuf(
   }
 }
 
-static void utile_restore(
-    const UndoImageTile *utile, const uint x, const uint y, ImBuf *ibuf, ImBuf *tmpibuf)
+static void utile_restore(const UndoImageTile *utile,
+                          const uint x,
+                          const uint y,
+                          ImBuf *ibuf,
+                          ImBuf *tmpibuf,
+                          UndoImageTileBuffers *buffers)
 {
   const bool has_float = ibuf->rect_float;
   float *prev_rect_float = tmpibuf->rect_float;
   uint *prev_rect = tmpibuf->rect;
+  void *rect = (void *)utile_rect_get(utile, buffers);
 
   if (has_float) {
-    tmpibuf->rect_float = utile->rect.fp;
+    tmpibuf->rect_float = rect;
   }
   else {
-    tmpibuf->rect = utile->rect.uint;
+    tmpibuf->rect = rect;
   }
 
   IMB_rectcpy(ibuf, tmpibuf, x, y, 0, 0, ED_IMAGE_UNDO_TILE_SIZE, ED_IMAGE_UNDO_TILE_SIZE);
@@ -383,12 +494,32 @@ static void utile_restore(
   tmpibuf->rect = prev_rect;
 }
 
+/**
+ * \return True when the tile holds the same pixels as the image at this location.
+ */
+static bool utile_equals_imbuf(
+    const UndoImageTile *utile, const uint x, const uint y, const ImBuf *ibuf, ImBuf *tmpibuf)
+{
+  if (utile->rect.pt == NULL) {
+    return false;
+  }
+  const bool has_float = ibuf->rect_float;
+  IMB_rectcpy(tmpibuf, ibuf, 0, 0, x, y, ED_IMAGE_UNDO_TILE_SIZE, ED_IMAGE_UNDO_TILE_SIZE);
+  const void *rect = has_float ? (void *)tmpibuf->rect_float : (void *)tmpibuf->rect;
+  return memcmp(utile->rect.pt, rect, utile->rect_size) == 0;
+}
+
 static void utile_decref(UndoImageTile *utile)
 {
   utile->users -= 1;
   BLI_assert(utile->users >= 0);
   if (utile->users == 0) {
-    MEM_freeN(utile->rect.pt);
+    if (utile->rect.pt) {
+      MEM_freeN(utile->rect.pt);
+    }
+    if (utile->rect_compressed) {
+      MEM_freeN(utile->rect_compressed);
+    }
     MEM_freeN(utile);
   }
 }
@@ -539,6 +670,8 @@ typedef struct UndoImageHandle {
 static void uhandle_restore_list(ListBase *undo_handles, bool use_init)
 {
   ImBuf *tmpibuf = imbuf_alloc_temp_tile();
+  UndoImageTileBuffers buffers;
+  utile_buffers_init(&buffers);
 
   for (UndoImageHandle *uh = undo_handles->first; uh; uh = uh->next) {
     /* Tiles only added to second set of tiles. */
@@ -559,7 +692,7 @@ static void uhandle_restore_list(ListBase *undo_handles, bool use_init)
         uint y = y_tile << ED_IMAGE_UNDO_TILE_BITS;
         for (uint x_tile = 0; x_tile < ubuf->tiles_dims[0]; x_tile += 1) {
           uint x = x_tile << ED_IMAGE_UNDO_TILE_BITS;
-          utile_restore(ubuf->tiles[i], x, y, ibuf, tmpibuf);
+          utile_restore(ubuf->tiles[i], x, y, ibuf, tmpibuf, &buffers);
           changed = true;
           i += 1;
         }
@@ -583,6 +716,7 @@ static void uhandle_restore_list(ListBase *undo_handles, bool use_init)
     BKE_image_release_ibuf(image, ibuf, NULL);
   }
 
+  utile_buffers_free(&buffers);
   IMB_freeImBuf(tmpibuf);
 }
 
@@ -681,6 +815,73 @@ static UndoImageHandle *uhandle_ensure(ListBase *undo_handles, Image *image, int
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Tile Compression
+ * \{ */
+
+static struct {
+  TaskPool *task_pool;
+  /** Steps which compressed tiles, the pool is freed once they are all freed. */
+  int users;
+} utile_compress_data = {NULL};
+
+/**
+ * Tiles must not be accessed while they may be compressed.
+ */
+static void utile_compress_tasks_wait(void)
+{
+  if (utile_compress_data.task_pool) {
+    BLI_task_pool_work_and_wait(utile_compress_data.task_pool);
+  }
+}
+
+static void ubuf_compress_cb(TaskPool *__restrict UNUSED(pool),
+                             void *taskdata,
+                             int UNUSED(threadid))
+{
+  /* Tiles are only shared between the buffers before and after the step,
+   * or with previous steps (which have already been compressed). */
+  UndoImageBuf *ubuf_pre = taskdata;
+  UndoImageTileBuffers buffers;
+  utile_buffers_init(&buffers);
+  for (UndoImageBuf *ubuf = ubuf_pre; ubuf; ubuf = (ubuf == ubuf_pre) ? ubuf_pre->post : NULL) {
+    for (uint i = 0; i < ubuf->tiles_len; i++) {
+      if (ubuf->tiles[i]) {
+        utile_compress(ubuf->tiles[i], &buffers);
+      }
+    }
+  }
+  utile_buffers_free(&buffers);
+}
+
+static void utile_compress_tasks_push(ListBase *undo_handles)
+{
+  if (utile_compress_data.task_pool == NULL) {
+    TaskScheduler *scheduler = BLI_task_scheduler_get();
+    utile_compress_data.task_pool = BLI_task_pool_create_background(scheduler, NULL);
+  }
+  utile_compress_data.users += 1;
+
+  for (UndoImageHandle *uh = undo_handles->first; uh; uh = uh->next) {
+    for (UndoImageBuf *ubuf_pre = uh->buffers.first; ubuf_pre; ubuf_pre = ubuf_pre->next) {
+      BLI_task_pool_push(
+          utile_compress_data.task_pool, ubuf_compress_cb, ubuf_pre, false, TASK_PRIORITY_LOW);
+    }
+  }
+}
+
+static void utile_compress_users_decref(void)
+{
+  utile_compress_data.users -= 1;
+  BLI_assert(utile_compress_data.users >= 0);
+  if (utile_compress_data.users == 0) {
+    BLI_task_pool_free(utile_compress_data.task_pool);
+    utile_compress_data.task_pool = NULL;
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -698,6 +899,8 @@ typedef struct ImageUndoStep {
   ListBase paint_tiles;
 
   bool is_encode_init;
+  /** Tiles are compressed, see #utile_compress_tasks_push. */
+  bool use_tile_compress;
   ePaintMode paint_mode;
 
 } ImageUndoStep;
@@ -771,6 +974,9 @@ static bool image_undosys_step_encode(struct bContext *C,
 
     ImBuf *tmpibuf = imbuf_alloc_temp_tile();
 
+    /* Tiles of the reference step are re-used. */
+    utile_compress_tasks_wait();
+
     ImageUndoStep *us_reference = (ImageUndoStep *)ED_undo_stack_get()->step_active;
     while (us_reference && us_reference->step.type != BKE_UNDOSYS_TYPE_IMAGE) {
       us_reference = (ImageUndoStep *)us_reference->step.prev;
@@ -784,6 +990,8 @@ static bool image_undosys_step_encode(struct bContext *C,
 
         UndoImageTile *utile = MEM_callocN(sizeof(*utile), "UndoImageTile");
         utile->users = 1;
+        utile->rect_size = (ptile->use_float ? sizeof(float[4]) : sizeof(uint)) *
+                           SQUARE(ED_IMAGE_UNDO_TILE_SIZE);
         utile->rect.pt = ptile->rect.pt;
         ptile->rect.pt = NULL;
         const uint tile_index = index_from_xy(ptile->x_tile, ptile->y_tile, ubuf_pre->tiles_dims);
@@ -829,11 +1037,20 @@ static bool image_undosys_step_encode(struct bContext *C,
                                                 * which we have a duplicate reference available. */
                                                (ubuf_pre->tiles[i]->users == 1))) {
                 if (ubuf_pre->tiles[i] != NULL) {
-                  /* If we have a reference, re-use this single use tile for the post state. */
                   BLI_assert(ubuf_pre->tiles[i]->users == 1);
-                  ubuf_post->tiles[i] = ubuf_pre->tiles[i];
+                  if (utile_equals_imbuf(ubuf_pre->tiles[i], x, y, ibuf, tmpibuf)) {
+                    /* The tile was touched without changing it,
+                     * the reference is used for both states. */
+                    utile_decref(ubuf_pre->tiles[i]);
+                    ubuf_post->tiles[i] = ubuf_reference->tiles[i];
+                    ubuf_post->tiles[i]->users += 1;
+                  }
+                  else {
+                    /* If we have a reference, re-use this single use tile for the post state. */
+                    ubuf_post->tiles[i] = ubuf_pre->tiles[i];
+                    utile_init_from_imbuf(ubuf_post->tiles[i], x, y, ibuf, tmpibuf);
+                  }
                   ubuf_pre->tiles[i] = NULL;
-                  utile_init_from_imbuf(ubuf_post->tiles[i], x, y, ibuf, tmpibuf);
                 }
                 else {
                   BLI_assert(ubuf_post->tiles[i] == NULL);
@@ -847,6 +1064,12 @@ static bool image_undosys_step_encode(struct bContext *C,
                 BLI_assert(ubuf_pre->tiles[i] != NULL);
                 BLI_assert(ubuf_post->tiles[i] != NULL);
               }
+              else if ((ubuf_pre->tiles[i] != NULL) &&
+                       utile_equals_imbuf(ubuf_pre->tiles[i], x, y, ibuf, tmpibuf)) {
+                /* Share the tile when the stroke didn't change it. */
+                ubuf_post->tiles[i] = ubuf_pre->tiles[i];
+                ubuf_post->tiles[i]->users += 1;
+              }
               else {
                 UndoImageTile *utile = utile_alloc(has_float);
                 utile_init_from_imbuf(utile, x, y, ibuf, tmpibuf);
@@ -879,6 +1102,9 @@ static bool image_undosys_step_encode(struct bContext *C,
     if (false) {
       uhandle_restore_list(&us->handles, false);
     }
+
+    utile_compress_tasks_push(&us->handles);
+    us->use_tile_compress = true;
   }
   else {
     /* Happens when switching modes. */
@@ -895,6 +1121,7 @@ static bool image_undosys_step_encode(struct bContext *C,
 static void image_undosys_step_decode_undo_impl(ImageUndoStep *us, bool is_final)
 {
   BLI_assert(us->step.is_applied == true);
+  utile_compress_tasks_wait();
   uhandle_restore_list(&us->handles, !is_final);
   us->step.is_applied = false;
 }
@@ -902,6 +1129,7 @@ static void image_undosys_step_decode_undo_impl(ImageUndoStep *us, bool is_final
 static void image_undosys_step_decode_redo_impl(ImageUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
+  utile_compress_tasks_wait();
   uhandle_restore_list(&us->handles, false);
   us->step.is_applied = true;
 }
@@ -965,8 +1193,14 @@ static void image_undosys_step_decode(
 static void image_undosys_step_free(UndoStep *us_p)
 {
   ImageUndoStep *us = (ImageUndoStep *)us_p;
+  /* Tiles may be shared with steps being compressed. */
+  utile_compress_tasks_wait();
   uhandle_free_list(&us->handles);
 
+  if (us->use_tile_compress) {
+    utile_compress_users_decref();
+  }
+
   /* Typically this list will have been cleared. */
   ptile_free_list(&us->paint_tiles);
 }
@@ -1051,6 +1285,9 @@ void ED_image_undo_push_begin_with_image(const char *name,
 {
   ImageUndoStep *us = image_undo_push_begin(name, PAINT_MODE_TEXTURE_2D);
 
+  /* Tiles of the reference step are re-used. */
+  utile_compress_tasks_wait();
+
   BLI_assert(BKE_image_get_tile(image, tile_number));
   UndoImageHandle *uh = uhandle_ensure(&us->handles, image, tile_number);
   UndoImageBuf *ubuf_pre = uhandle_ensure_ubuf(uh, image, ibuf);
@@ -40,6 +40,8 @@
 #include "BLI_utildefines.h"
 #include "BLI_mempool.h"
 
+#include "BLF_api.h"
+
 #include "BLT_translation.h"
 
 #include "BKE_context.h"
@@ -3522,9 +3524,10 @@ static void outliner_draw_tree(bContext *C,
   startx = UI_UNIT_X / 2 - (U.pixelsize + 1) / 2;
   outliner_draw_hierarchy_lines(soops, &soops->tree, startx, &starty);
 
-  // items themselves
+  // items themselves, names are batched and drawn before the scissor is reset
   starty = (int)ar->v2d.tot.ymax - UI_UNIT_Y - OL_Y_OFFSET;
   startx = 0;
+  BLF_batch_draw_begin();
   for (TreeElement *te = soops->tree.first; te; te = te->next) {
     outliner_draw_tree_element(C,
                                block,
@@ -3539,6 +3542,7 @@ static void outliner_draw_tree(bContext *C,
                                restrict_column_width,
                                te_edit);
   }
+  BLF_batch_draw_end();
 
   if (restrict_column_width > 0.0f) {
     /* reset scissor */
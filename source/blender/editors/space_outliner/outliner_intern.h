@@ -230,6 +230,7 @@ void outliner_build_tree(struct Main *mainvar,
                          struct ViewLayer *view_layer,
                          struct SpaceOutliner *soops,
                          struct ARegion *ar);
+bool outliner_requires_rebuild_on_select_or_active_change(const struct SpaceOutliner *soops);
 
 typedef struct IDsSelectedData {
   struct ListBase selected_array;
@@ -1984,7 +1984,7 @@ static void outliner_store_scrolling_position(SpaceOutliner *soops,
   }
 }
 
-static int outliner_exclude_filter_get(SpaceOutliner *soops)
+static int outliner_exclude_filter_get(const SpaceOutliner *soops)
 {
   int exclude_filter = soops->filter & ~SO_FILTER_OB_STATE;
 
@@ -2254,6 +2254,16 @@ static void outliner_filter_tree(SpaceOutliner *soops, ViewLayer *view_layer)
 /* ======================================================= */
 /* Main Tree Building API */
 
+/**
+ * Selection and active state are synced into the existing tree when drawing, the tree only needs
+ * to be rebuilt when they are used to filter elements.
+ */
+bool outliner_requires_rebuild_on_select_or_active_change(const SpaceOutliner *soops)
+{
+  const int exclude_filter = outliner_exclude_filter_get(soops);
+  return (exclude_filter & (SO_FILTER_OB_STATE_SELECTED | SO_FILTER_OB_STATE_ACTIVE)) != 0;
+}
+
 /* Main entry point for building the tree data-structure that the outliner represents */
 // TODO: split each mode into its own function?
 void outliner_build_tree(
@@ -2274,12 +2284,15 @@ void outliner_build_tree(
     soops->search_flags &= ~SO_SEARCH_RECURSIVE;
   }
 
+  bool treestore_remapped = false;
   if (soops->treehash && (soops->storeflag & SO_TREESTORE_REBUILD) && soops->treestore) {
     soops->storeflag &= ~SO_TREESTORE_REBUILD;
     BKE_outliner_treehash_rebuild_from_treestore(soops->treehash, soops->treestore);
+    treestore_remapped = true;
   }
 
-  if (ar->do_draw & RGN_DRAW_NO_REBUILD) {
+  /* Tree elements may still point to remapped IDs, never reuse the tree in that case. */
+  if ((ar->do_draw & RGN_DRAW_NO_REBUILD) && !treestore_remapped) {
     return;
   }
 
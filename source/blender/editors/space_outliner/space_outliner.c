@@ -106,17 +106,28 @@ static void outliner_main_region_free(ARegion *UNUSED(ar))
 }
 
 static void outliner_main_region_listener(wmWindow *UNUSED(win),
-                                          ScrArea *UNUSED(sa),
+                                          ScrArea *sa,
                                           ARegion *ar,
                                           wmNotifier *wmn,
                                           const Scene *UNUSED(scene))
 {
+  SpaceOutliner *soops = sa->spacedata.first;
+
   /* context changes */
   switch (wmn->category) {
     case NC_SCENE:
       switch (wmn->data) {
         case ND_OB_ACTIVE:
         case ND_OB_SELECT:
+          /* Pure selection changes don't add or remove elements, skip rebuilding the tree. */
+          if (wmn->action == NA_SELECTED &&
+              !outliner_requires_rebuild_on_select_or_active_change(soops)) {
+            ED_region_tag_redraw_no_rebuild(ar);
+          }
+          else {
+            ED_region_tag_redraw(ar);
+          }
+          break;
         case ND_OB_VISIBLE:
         case ND_OB_RENDER:
         case ND_MODE:
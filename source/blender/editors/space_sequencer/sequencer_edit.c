@@ -27,12 +27,17 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_timecode.h"
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 #include "BLT_translation.h"
 
 #include "DNA_scene_types.h"
@@ -143,22 +148,87 @@ static void proxy_freejob(void *pjv)
   MEM_freeN(pj);
 }
 
+typedef struct ProxyBuildTask {
+  struct SeqIndexBuildContext *context;
+  short *stop;
+  short do_update;
+  float progress;
+  uint32_t *tot_done;
+} ProxyBuildTask;
+
+static void proxy_build_task_func(TaskPool *__restrict UNUSED(pool),
+                                  void *taskdata,
+                                  int UNUSED(threadid))
+{
+  ProxyBuildTask *task = taskdata;
+
+  BKE_sequencer_proxy_rebuild(task->context, task->stop, &task->do_update, &task->progress);
+
+  task->progress = 1.0f;
+  atomic_add_and_fetch_uint32(task->tot_done, 1);
+}
+
+/* Build all movie proxies of the queue at once, reporting their average progress. */
+static void proxy_build_movies_threaded(ProxyJob *pj,
+                                        short *stop,
+                                        short *do_update,
+                                        float *progress)
+{
+  TaskScheduler *task_scheduler = BLI_task_scheduler_get();
+  TaskPool *task_pool = BLI_task_pool_create(task_scheduler, NULL);
+  const int num_tasks = BLI_listbase_count(&pj->queue);
+  ProxyBuildTask *tasks = MEM_callocN(sizeof(ProxyBuildTask) * num_tasks, "proxy build tasks");
+  uint32_t tot_done = 0;
+  int tot_tasks = 0;
+
+  LISTBASE_FOREACH (LinkData *, link, &pj->queue) {
+    if (BKE_sequencer_proxy_rebuild_is_threadsafe(link->data)) {
+      ProxyBuildTask *task = &tasks[tot_tasks++];
+      task->context = link->data;
+      task->stop = stop;
+      task->tot_done = &tot_done;
+      BLI_task_pool_push(task_pool, proxy_build_task_func, task, false, TASK_PRIORITY_LOW);
+    }
+  }
+
+  while (atomic_add_and_fetch_uint32(&tot_done, 0) < (uint32_t)tot_tasks) {
+    float progress_sum = 0.0f;
+
+    PIL_sleep_ms(100);
+
+    for (int i = 0; i < tot_tasks; i++) {
+      progress_sum += tasks[i].progress;
+    }
+    *progress = progress_sum / tot_tasks;
+    *do_update = true;
+  }
+
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+  MEM_freeN(tasks);
+}
+
 /* only this runs inside thread */
 static void proxy_startjob(void *pjv, short *stop, short *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
   LinkData *link;
 
-  for (link = pj->queue.first; link; link = link->next) {
+  proxy_build_movies_threaded(pj, stop, do_update, progress);
+
+  for (link = pj->queue.first; link && !*stop; link = link->next) {
     struct SeqIndexBuildContext *context = link->data;
 
+    if (BKE_sequencer_proxy_rebuild_is_threadsafe(context)) {
+      continue;
+    }
+
     BKE_sequencer_proxy_rebuild(context, stop, do_update, progress);
+  }
 
-    if (*stop) {
-      pj->stop = 1;
-      fprintf(stderr, "Canceling proxy rebuild on users request...\n");
-      break;
-    }
+  if (*stop) {
+    pj->stop = 1;
+    fprintf(stderr, "Canceling proxy rebuild on users request...\n");
   }
 }
 
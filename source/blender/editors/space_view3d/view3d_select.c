@@ -602,7 +602,7 @@ static bool do_lasso_select_objects(ViewContext *vc,
 
   if (changed) {
     DEG_id_tag_update(&vc->scene->id, ID_RECALC_SELECT);
-    WM_main_add_notifier(NC_SCENE | ND_OB_SELECT, vc->scene);
+    WM_main_add_notifier(NC_SCENE | ND_OB_SELECT | NA_SELECTED, vc->scene);
   }
   return changed;
 }
@@ -701,7 +701,7 @@ static bool do_lasso_select_pose(ViewContext *vc,
   const bool changed_multi = do_pose_tag_select_op_exec(bases, bases_len, sel_op);
   if (changed_multi) {
     DEG_id_tag_update(&vc->scene->id, ID_RECALC_SELECT);
-    WM_main_add_notifier(NC_SCENE | ND_OB_SELECT, vc->scene);
+    WM_main_add_notifier(NC_SCENE | ND_OB_SELECT | NA_SELECTED, vc->scene);
   }
 
   MEM_freeN(bases);
@@ -1499,7 +1499,7 @@ static int object_select_menu_exec(bContext *C, wmOperator *op)
   if (changed) {
     Scene *scene = CTX_data_scene(C);
     DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
 
     ED_outliner_select_sync_from_object_tag(C);
 
@@ -2445,7 +2445,7 @@ static int view3d_select_exec(bContext *C, wmOperator *op)
    * FINISHED to signal one operator worked
    * */
   if (retval) {
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, scene);
     return OPERATOR_PASS_THROUGH | OPERATOR_FINISHED;
   }
   else {
@@ -3125,7 +3125,7 @@ finally:
 
   if (changed) {
     DEG_id_tag_update(&vc->scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, vc->scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, vc->scene);
   }
   return changed;
 }
@@ -3195,7 +3195,7 @@ static bool do_pose_box_select(bContext *C, ViewContext *vc, rcti *rect, const e
   const bool changed_multi = do_pose_tag_select_op_exec(bases, bases_len, sel_op);
   if (changed_multi) {
     DEG_id_tag_update(&vc->scene->id, ID_RECALC_SELECT);
-    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, vc->scene);
+    WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, vc->scene);
   }
 
   if (bases != NULL) {
@@ -4072,7 +4072,7 @@ static int view3d_circle_select_exec(bContext *C, wmOperator *op)
   else {
     if (object_circle_select(&vc, sel_op, mval, (float)radius)) {
       DEG_id_tag_update(&vc.scene->id, ID_RECALC_SELECT);
-      WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, vc.scene);
+      WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT | NA_SELECTED, vc.scene);
 
       ED_outliner_select_sync_from_object_tag(C);
     }
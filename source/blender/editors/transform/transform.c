@@ -48,6 +48,7 @@
 #include "BLI_ghash.h"
 #include "BLI_utildefines_stack.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_nla.h"
 #include "BKE_editmesh.h"
@@ -4957,17 +4958,152 @@ static void headerTranslation(TransInfo *t, const float vec[3], char str[UI_MAX_
   }
 }
 
+static void applyTranslationValue_element(TransInfo *t,
+                                          TransDataContainer *tc,
+                                          TransData *td,
+                                          const float vec[3],
+                                          const bool apply_snap_align_rotation,
+                                          const float pivot[3])
+{
+  float tvec[3];
+  float rotate_offset[3] = {0};
+  bool use_rotate_offset = false;
+
+  /* handle snapping rotation before doing the translation */
+  if (apply_snap_align_rotation) {
+    float mat[3][3];
+
+    if (validSnappingNormal(t)) {
+      const float *original_normal;
+
+      /* In pose mode, we want to align normals with Y axis of bones... */
+      if (t->flag & T_POSE) {
+        original_normal = td->axismtx[1];
+      }
+      else {
+        original_normal = td->axismtx[2];
+      }
+
+      rotation_between_vecs_to_mat3(mat, original_normal, t->tsnap.snapNormal);
+    }
+    else {
+      unit_m3(mat);
+    }
+
+    ElementRotation_ex(t, tc, td, mat, pivot);
+
+    if (td->loc) {
+      use_rotate_offset = true;
+      sub_v3_v3v3(rotate_offset, td->loc, td->iloc);
+    }
+  }
+
+  if (t->con.applyVec) {
+    float pvec[3];
+    t->con.applyVec(t, tc, td, vec, tvec, pvec);
+  }
+  else {
+    copy_v3_v3(tvec, vec);
+  }
+
+  mul_m3_v3(td->smtx, tvec);
+
+  if (use_rotate_offset) {
+    add_v3_v3(tvec, rotate_offset);
+  }
+
+  if (t->options & CTX_GPENCIL_STROKES) {
+    /* grease pencil multiframe falloff */
+    bGPDstroke *gps = (bGPDstroke *)td->extra;
+    if (gps != NULL) {
+      mul_v3_fl(tvec, td->factor * gps->runtime.multi_frame_falloff);
+    }
+    else {
+      mul_v3_fl(tvec, td->factor);
+    }
+  }
+  else {
+    /* proportional editing falloff */
+    mul_v3_fl(tvec, td->factor);
+  }
+
+  protectedTransBits(td->protectflag, tvec);
+
+  if (td->loc) {
+    add_v3_v3v3(td->loc, td->iloc, tvec);
+  }
+
+  constraintTransLim(t, td);
+}
+
+/* Minimum number of elements to apply the transform from multiple threads. */
+#define TRANS_DATA_PARALLEL_THRESHOLD 4096
+
+typedef struct TransTranslationData {
+  TransInfo *t;
+  TransDataContainer *tc;
+  const float *vec;
+} TransTranslationData;
+
+static void applyTranslationValue_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TransTranslationData *data = userdata;
+  TransData *td = &data->tc->data[i];
+
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+
+  applyTranslationValue_element(data->t, data->tc, td, data->vec, false, NULL);
+}
+
+/**
+ * Elements are only independent of each other without constraints (which may apply numeric
+ * input and snapping per element), without aligning to the snapped normal and when there are
+ * no object or bone limit constraints to evaluate.
+ */
+static bool applyTranslationValue_use_threading(const TransInfo *t,
+                                                const bool apply_snap_align_rotation)
+{
+  return (apply_snap_align_rotation == false) && (t->con.applyVec == NULL) &&
+         ((t->flag & (T_OBJECT | T_POSE)) == 0);
+}
+
 static void applyTranslationValue(TransInfo *t, const float vec[3])
 {
   const bool apply_snap_align_rotation = usingSnappingNormal(
       t);  // && (t->tsnap.status & POINT_INIT);
-  float tvec[3];
+  const bool use_threading = applyTranslationValue_use_threading(t, apply_snap_align_rotation);
 
   /* The ideal would be "apply_snap_align_rotation" only when a snap point is found
    * so, maybe inside this function is not the best place to apply this rotation.
    * but you need "handle snapping rotation before doing the translation" (really?) */
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
 
+    if (use_threading && tc->data_len >= TRANS_DATA_PARALLEL_THRESHOLD) {
+      /* Elements which don't take part in the transform are sorted last. */
+      int data_len = tc->data_len;
+      for (int i = 0; i < data_len; i++) {
+        if (tc->data[i].flag & TD_NOACTION) {
+          data_len = i;
+          break;
+        }
+      }
+
+      TransTranslationData data = {
+          .t = t,
+          .tc = tc,
+          .vec = vec,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = TRANS_DATA_PARALLEL_THRESHOLD / 2;
+      BLI_task_parallel_range(0, data_len, &data, applyTranslationValue_cb, &settings);
+      continue;
+    }
+
     float pivot[3];
     if (apply_snap_align_rotation) {
       copy_v3_v3(pivot, t->tsnap.snapTarget);
@@ -4987,74 +5123,7 @@ static void applyTranslationValue(TransInfo *t, const float vec[3])
         continue;
       }
 
-      float rotate_offset[3] = {0};
-      bool use_rotate_offset = false;
-
-      /* handle snapping rotation before doing the translation */
-      if (apply_snap_align_rotation) {
-        float mat[3][3];
-
-        if (validSnappingNormal(t)) {
-          const float *original_normal;
-
-          /* In pose mode, we want to align normals with Y axis of bones... */
-          if (t->flag & T_POSE) {
-            original_normal = td->axismtx[1];
-          }
-          else {
-            original_normal = td->axismtx[2];
-          }
-
-          rotation_between_vecs_to_mat3(mat, original_normal, t->tsnap.snapNormal);
-        }
-        else {
-          unit_m3(mat);
-        }
-
-        ElementRotation_ex(t, tc, td, mat, pivot);
-
-        if (td->loc) {
-          use_rotate_offset = true;
-          sub_v3_v3v3(rotate_offset, td->loc, td->iloc);
-        }
-      }
-
-      if (t->con.applyVec) {
-        float pvec[3];
-        t->con.applyVec(t, tc, td, vec, tvec, pvec);
-      }
-      else {
-        copy_v3_v3(tvec, vec);
-      }
-
-      mul_m3_v3(td->smtx, tvec);
-
-      if (use_rotate_offset) {
-        add_v3_v3(tvec, rotate_offset);
-      }
-
-      if (t->options & CTX_GPENCIL_STROKES) {
-        /* grease pencil multiframe falloff */
-        bGPDstroke *gps = (bGPDstroke *)td->extra;
-        if (gps != NULL) {
-          mul_v3_fl(tvec, td->factor * gps->runtime.multi_frame_falloff);
-        }
-        else {
-          mul_v3_fl(tvec, td->factor);
-        }
-      }
-      else {
-        /* proportional editing falloff */
-        mul_v3_fl(tvec, td->factor);
-      }
-
-      protectedTransBits(td->protectflag, tvec);
-
-      if (td->loc) {
-        add_v3_v3v3(td->loc, td->iloc, tvec);
-      }
-
-      constraintTransLim(t, td);
+      applyTranslationValue_element(t, tc, td, vec, apply_snap_align_rotation, pivot);
     }
   }
 }
@@ -255,6 +255,17 @@ static void transform_apply_to_mirror(TransInfo *t)
   }
 }
 
+/* Transform of vertex positions only, which leaves edge data, custom data and topology of the
+ * edit mesh untouched, so the draw cache can keep all buffers which do not depend on positions. */
+static bool trans_mesh_is_deform_only(const TransInfo *t, const TransDataContainer *tc)
+{
+  if (ELEM(t->mode, TFM_CREASE, TFM_BWEIGHT, TFM_SKIN_RESIZE, TFM_NORMAL_ROTATION)) {
+    return false;
+  }
+  /* UVs and other loop layers are corrected, see trans_mesh_customdata_correction_init(). */
+  return (tc->custom.type.data == NULL);
+}
+
 /* for the realtime animation recording feature, handle overlapping data */
 static void animrecord_check_state(Scene *scene, ID *id, wmTimer *animtimer)
 {
@@ -903,7 +914,12 @@ static void recalcData_objects(TransInfo *t)
       }
 
       FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-        DEG_id_tag_update(tc->obedit->data, 0); /* sets recalc flags */
+        if (trans_mesh_is_deform_only(t, tc)) {
+          DEG_id_tag_update(tc->obedit->data, ID_RECALC_GEOMETRY_DEFORM);
+        }
+        else {
+          DEG_id_tag_update(tc->obedit->data, 0); /* sets recalc flags */
+        }
         BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
         EDBM_mesh_normals_update(em);
         BKE_editmesh_looptri_calc(em);
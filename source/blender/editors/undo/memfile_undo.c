@@ -91,10 +91,19 @@ static bool memfile_undosys_step_encode(struct bContext *UNUSED(C),
 static void memfile_undosys_step_decode(
     struct bContext *C, struct Main *bmain, UndoStep *us_p, int UNUSED(dir), bool UNUSED(is_final))
 {
+  /* Data-blocks which didn't change can be kept when the current state is the one stored
+   * in the active memfile step, not when other steps (edit-mode...) were applied since. */
+  UndoStack *ustack = ED_undo_stack_get();
+  MemFileUndoStep *us_current = NULL;
+  if ((ustack->step_active != NULL) && (ustack->step_active == ustack->step_active_memfile) &&
+      (bmain->is_memfile_undo_flush_needed == false)) {
+    us_current = (MemFileUndoStep *)ustack->step_active;
+  }
+
   ED_editors_exit(bmain, false);
 
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
-  BKE_memfile_undo_decode(us->data, C);
+  BKE_memfile_undo_decode(us->data, us_current ? us_current->data : NULL, C);
 
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
     if (BKE_UNDOSYS_TYPE_IS_MEMFILE_SKIP(us_iter->type)) {
@@ -89,8 +89,9 @@ void ViewMap::Clean()
 
 ViewShape *ViewMap::viewShape(unsigned id)
 {
-  int index = _shapeIdToIndex[id];
-  return _VShapes[index];
+  /* Called from the parallel visibility computation, so don't insert missing ids. */
+  id_to_index_map::const_iterator it = _shapeIdToIndex.find(id);
+  return _VShapes[(it != _shapeIdToIndex.end()) ? it->second : 0];
 }
 
 void ViewMap::AddViewShape(ViewShape *iVShape)
@@ -99,6 +99,9 @@ void GPU_indexbuf_discard(GPUIndexBuf *);
 
 int GPU_indexbuf_primitive_len(GPUPrimType prim_type);
 
+/* Metrics */
+size_t GPU_indexbuf_upload_bytes_get(void);
+
 /* Macros */
 
 #define GPU_INDEXBUF_DISCARD_SAFE(elem) \
@@ -44,6 +44,9 @@ int GPU_uniformbuffer_bindpoint(GPUUniformBuffer *ubo);
 bool GPU_uniformbuffer_is_empty(GPUUniformBuffer *ubo);
 bool GPU_uniformbuffer_is_dirty(GPUUniformBuffer *ubo);
 
+/* Metrics */
+size_t GPU_uniformbuffer_upload_bytes_get(void);
+
 #define GPU_UBO_BLOCK_NAME "nodeTree"
 
 #endif /* __GPU_UNIFORMBUFFER_H__ */
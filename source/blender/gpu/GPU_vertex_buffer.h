@@ -128,6 +128,8 @@ void GPU_vertbuf_use(GPUVertBuf *);
 
 /* Metrics */
 uint GPU_vertbuf_get_memory_usage(void);
+/* Bytes uploaded since startup, callers measure the difference between two calls. */
+size_t GPU_vertbuf_upload_bytes_get(void);
 
 /* Macros */
 #define GPU_VERTBUF_DISCARD_SAFE(verts) \
@@ -45,6 +45,7 @@ typedef enum {
   GPU_COMP_I32,
   GPU_COMP_U32,
 
+  GPU_COMP_F16,
   GPU_COMP_F32,
 
   GPU_COMP_I10,
@@ -59,7 +60,7 @@ typedef enum {
 
 typedef struct GPUVertAttr {
   uint fetch_mode : 2;
-  uint comp_type : 3;
+  uint comp_type : 4;
   /* 1 to 4 or 8 or 12 or 16 */
   uint comp_len : 5;
   /* size in bytes, 1 to 64 */
@@ -185,4 +186,47 @@ BLI_INLINE GPUPackedNormal GPU_normal_convert_i10_s3(const short data[3])
   return n;
 }
 
+BLI_INLINE short GPU_normal_convert_i16(float x)
+{
+  int qx = x * 32767.0f;
+  return (short)clampi(qx, -32767, 32767);
+}
+
+/* IEEE 754 half float, rounded to nearest. Overflow gives infinity. */
+BLI_INLINE ushort GPU_half_convert_f32(float x)
+{
+  union {
+    float f;
+    uint u;
+  } v = {x};
+  const ushort sign = (v.u >> 16) & 0x8000;
+  const int exp = (int)((v.u >> 23) & 0xff) - 127 + 15;
+  uint mant = v.u & 0x7fffff;
+
+  if (exp >= 31) {
+    /* Keep NaN a NaN, everything else becomes infinity. */
+    const bool is_nan = (v.u & 0x7fffffff) > 0x7f800000;
+    return sign | (is_nan ? 0x7e00 : 0x7c00);
+  }
+  if (exp <= 0) {
+    /* Denormalized half float, or zero. */
+    if (exp < -10) {
+      return sign;
+    }
+    mant |= 0x800000;
+    const uint shift = 14 - exp;
+    uint half = mant >> shift;
+    if ((mant >> (shift - 1)) & 1) {
+      half++;
+    }
+    return sign | half;
+  }
+  uint half = ((uint)exp << 10) | (mant >> 13);
+  /* Rounding can overflow into the exponent, which is still correct. */
+  if (mant & 0x1000) {
+    half++;
+  }
+  return sign | half;
+}
+
 #endif /* __GPU_VERTEX_FORMAT_H__ */
@@ -85,6 +85,7 @@ typedef struct ViewportEngineData {
 
   /* Profiling data */
   double init_time;
+  double cache_time;
   double render_time;
   double background_time;
 } ViewportEngineData;
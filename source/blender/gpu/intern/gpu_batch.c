@@ -810,6 +810,9 @@ struct GPUDrawList {
   uint cmd_len;     /* Number of used command for the next call. */
   uint buffer_size; /* in bytes, size of indirect command buffer. */
   GLuint buffer_id; /* Draw Indirect Buffer id */
+  /* Commands are always written to CPU memory. They are only uploaded to the indirect buffer
+   * when there are enough of them, so single draw-calls don't pay for the buffer upload and
+   * the fallback never reads from mapped GPU memory. */
   union {
     GPUDrawCommand *commands;
     GPUDrawCommandIndexed *commands_indexed;
@@ -821,14 +824,12 @@ GPUDrawList *GPU_draw_list_create(int length)
   GPUDrawList *list = MEM_callocN(sizeof(GPUDrawList), "GPUDrawList");
   /* Alloc the biggest possible command list which is indexed. */
   list->buffer_size = sizeof(GPUDrawCommandIndexed) * length;
+  list->commands = MEM_mallocN(list->buffer_size, "GPUDrawList data");
   if (USE_MULTI_DRAW_INDIRECT) {
     list->buffer_id = GPU_buf_alloc();
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list->buffer_id);
     glBufferData(GL_DRAW_INDIRECT_BUFFER, list->buffer_size, NULL, GL_DYNAMIC_DRAW);
   }
-  else {
-    list->commands = MEM_mallocN(list->buffer_size, "GPUDrawList data");
-  }
   return list;
 }
 
@@ -837,9 +838,7 @@ void GPU_draw_list_discard(GPUDrawList *list)
   if (list->buffer_id) {
     GPU_buf_free(list->buffer_id);
   }
-  else {
-    MEM_SAFE_FREE(list->commands);
-  }
+  MEM_SAFE_FREE(list->commands);
   MEM_freeN(list);
 }
 
@@ -849,23 +848,6 @@ void GPU_draw_list_init(GPUDrawList *list, GPUBatch *batch)
   list->batch = batch;
   list->base_index = batch->elem ? BASE_INDEX(batch->elem) : UINT_MAX;
   list->cmd_len = 0;
-
-  if (USE_MULTI_DRAW_INDIRECT) {
-    if (list->commands == NULL) {
-      glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list->buffer_id);
-      if (list->cmd_offset >= list->buffer_size) {
-        /* Orphan buffer data and start fresh. */
-        glBufferData(GL_DRAW_INDIRECT_BUFFER, list->buffer_size, NULL, GL_DYNAMIC_DRAW);
-        list->cmd_offset = 0;
-      }
-      GLenum flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
-      list->commands = glMapBufferRange(
-          GL_DRAW_INDIRECT_BUFFER, list->cmd_offset, list->buffer_size - list->cmd_offset, flags);
-    }
-  }
-  else {
-    list->cmd_offset = 0;
-  }
 }
 
 void GPU_draw_list_command_add(
@@ -894,9 +876,8 @@ void GPU_draw_list_command_add(
   }
 
   list->cmd_len++;
-  uint offset = list->cmd_offset + list->cmd_len * sizeof(GPUDrawCommandIndexed);
 
-  if (offset == list->buffer_size) {
+  if (list->cmd_len * sizeof(GPUDrawCommandIndexed) == list->buffer_size) {
     GPU_draw_list_submit(list);
     GPU_draw_list_init(list, list->batch);
   }
@@ -910,26 +891,28 @@ void GPU_draw_list_submit(GPUDrawList *list)
     return;
   }
 
-  BLI_assert(list->commands);
   BLI_assert(batch->program_in_use);
   /* TODO could assert that VAO is bound. */
 
-  /* TODO We loose a bit of memory here if we only draw arrays. Fix that. */
-  uintptr_t offset = list->cmd_offset;
   uint cmd_len = list->cmd_len;
-  size_t bytes_used = cmd_len * sizeof(GPUDrawCommandIndexed);
+  size_t bytes_used = cmd_len * ((batch->elem) ? sizeof(GPUDrawCommandIndexed) :
+                                                 sizeof(GPUDrawCommand));
   list->cmd_len = 0; /* Avoid reuse. */
 
   /* Only do multi-draw indirect if doing more than 2 drawcall.
-   * This avoids the overhead of buffer mapping if scene is
+   * This avoids the overhead of the buffer upload if scene is
    * not very instance friendly. */
   if (USE_MULTI_DRAW_INDIRECT && cmd_len > 2) {
     GLenum prim = batch->gl_prim_type;
 
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list->buffer_id);
-    glFlushMappedBufferRange(GL_DRAW_INDIRECT_BUFFER, 0, bytes_used);
-    glUnmapBuffer(GL_DRAW_INDIRECT_BUFFER);
-    list->commands = NULL; /* Unmapped */
+    if (list->cmd_offset + bytes_used > list->buffer_size) {
+      /* Orphan buffer data and start fresh, previous commands may still be in use. */
+      glBufferData(GL_DRAW_INDIRECT_BUFFER, list->buffer_size, NULL, GL_DYNAMIC_DRAW);
+      list->cmd_offset = 0;
+    }
+    uintptr_t offset = list->cmd_offset;
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, offset, bytes_used, list->commands);
     list->cmd_offset += bytes_used;
 
     if (batch->elem) {
@@ -33,6 +33,7 @@
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 #include "BLI_ghash.h"
+#include "BLI_openhash.h"
 
 #include "DNA_meshdata_types.h"
 
@@ -895,7 +896,7 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
     GPU_indexbuf_init(&elb, GPU_PRIM_TRIS, tottri, totvert);
     GPU_indexbuf_init(&elb_lines, GPU_PRIM_LINES, tottri * 3, totvert);
 
-    GHash *bm_vert_to_index = BLI_ghash_int_new_ex("bm_vert_to_index", totvert);
+    PtrMap *bm_vert_to_index = BLI_ptrmap_new_ex("bm_vert_to_index", totvert);
 
     GSetIterator gs_iter;
     GSET_ITER (gs_iter, bm_faces) {
@@ -908,7 +909,7 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
         uint idx[3];
         for (int i = 0; i < 3; i++) {
           void **idx_p;
-          if (!BLI_ghash_ensure_p(bm_vert_to_index, v[i], &idx_p)) {
+          if (!BLI_ptrmap_ensure_p(bm_vert_to_index, v[i], &idx_p)) {
             /* Add vertex to the vertex buffer each time a new one is encountered */
             *idx_p = POINTER_FROM_UINT(v_index);
 
@@ -939,7 +940,7 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
       }
     }
 
-    BLI_ghash_free(bm_vert_to_index, NULL, NULL);
+    BLI_ptrmap_free(bm_vert_to_index, NULL);
 
     buffers->tot_tri = tottri;
     if (buffers->index_buf == NULL) {
@@ -29,6 +29,7 @@
 #include "DNA_image_types.h"
 #include "DNA_material_types.h"
 #include "DNA_node_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_blenlib.h"
 #include "BLI_hash_mm2a.h"
@@ -36,8 +37,11 @@
 #include "BLI_utildefines.h"
 #include "BLI_dynstr.h"
 #include "BLI_ghash.h"
+#include "BLI_openhash.h"
 #include "BLI_threads.h"
 
+#include "BKE_appdir.h"
+
 #include "PIL_time.h"
 
 #include "GPU_extensions.h"
@@ -130,6 +134,147 @@ static GPUPass *gpu_pass_cache_resolve_collision(GPUPass *pass,
   return NULL;
 }
 
+/* -------------------- GPUPass Disk Cache ------------------ */
+/**
+ * Program binaries of compiled passes are stored on disk so the same materials don't need to be
+ * compiled again in later sessions. Files are named after a hash of all the shader sources and
+ * of the OpenGL driver, updating Blender or the driver simply misses the cache.
+ */
+
+#define PASS_DISK_CACHE_MAGIC 0x50475042 /* "BPGP" */
+
+typedef struct GPUPassDiskCacheHeader {
+  uint32_t magic;
+  uint32_t binary_format;
+  int32_t binary_len;
+} GPUPassDiskCacheHeader;
+
+/* Empty when the disk cache is not available. */
+static char pass_disk_cache_dir[FILE_MAX] = "";
+static uint32_t pass_disk_cache_driver_hash = 0;
+
+static void gpu_pass_disk_cache_init(void)
+{
+  pass_disk_cache_dir[0] = '\0';
+
+  GLint binary_formats_len = 0;
+  if (GLEW_ARB_get_program_binary) {
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats_len);
+  }
+  if (binary_formats_len == 0) {
+    return;
+  }
+
+  const char *dir = BKE_appdir_folder_id_create(BLENDER_USER_DATAFILES, "shader_cache");
+  if (dir == NULL) {
+    return;
+  }
+  BLI_strncpy(pass_disk_cache_dir, dir, sizeof(pass_disk_cache_dir));
+
+  const char *driver_strings[] = {(const char *)glGetString(GL_VENDOR),
+                                  (const char *)glGetString(GL_RENDERER),
+                                  (const char *)glGetString(GL_VERSION)};
+  BLI_HashMurmur2A hm2a;
+  BLI_hash_mm2a_init(&hm2a, 0);
+  for (int i = 0; i < ARRAY_SIZE(driver_strings); i++) {
+    if (driver_strings[i]) {
+      BLI_hash_mm2a_add(&hm2a, (const uchar *)driver_strings[i], strlen(driver_strings[i]));
+    }
+  }
+  pass_disk_cache_driver_hash = BLI_hash_mm2a_end(&hm2a);
+}
+
+static bool gpu_pass_disk_cache_is_enabled(void)
+{
+  return (pass_disk_cache_dir[0] != '\0') && !(U.gpu_flag & USER_GPU_FLAG_NO_SHADER_CACHE);
+}
+
+static uint32_t gpu_pass_disk_cache_hash(const GPUPass *pass, const uint32_t seed)
+{
+  const char *sources[] = {
+      pass->vertexcode, pass->geometrycode, pass->fragmentcode, pass->defines};
+  BLI_HashMurmur2A hm2a;
+  BLI_hash_mm2a_init(&hm2a, pass_disk_cache_driver_hash ^ seed);
+  for (int i = 0; i < ARRAY_SIZE(sources); i++) {
+    if (sources[i]) {
+      BLI_hash_mm2a_add(&hm2a, (const uchar *)sources[i], strlen(sources[i]));
+    }
+    /* Separator, so moving code from one stage to the next changes the hash. */
+    BLI_hash_mm2a_add_int(&hm2a, i);
+  }
+  return BLI_hash_mm2a_end(&hm2a);
+}
+
+static void gpu_pass_disk_cache_filepath(const GPUPass *pass, char r_filepath[FILE_MAX])
+{
+  /* 64 bits of hash, collisions are not a concern. */
+  char filename[32];
+  BLI_snprintf(filename,
+               sizeof(filename),
+               "%08x%08x.bin",
+               gpu_pass_disk_cache_hash(pass, 0),
+               gpu_pass_disk_cache_hash(pass, 0x9e3779b9));
+  BLI_join_dirfile(r_filepath, FILE_MAX, pass_disk_cache_dir, filename);
+}
+
+static GPUShader *gpu_pass_disk_cache_load(const GPUPass *pass, const char *shname)
+{
+  if (!gpu_pass_disk_cache_is_enabled()) {
+    return NULL;
+  }
+
+  char filepath[FILE_MAX];
+  gpu_pass_disk_cache_filepath(pass, filepath);
+
+  size_t size;
+  char *data = BLI_file_read_binary_as_mem(filepath, 0, &size);
+  if (data == NULL) {
+    return NULL;
+  }
+
+  GPUShader *shader = NULL;
+  const GPUPassDiskCacheHeader *header = (const GPUPassDiskCacheHeader *)data;
+  if ((size >= sizeof(*header)) && (header->magic == PASS_DISK_CACHE_MAGIC) &&
+      (header->binary_len > 0) && (size == sizeof(*header) + (size_t)header->binary_len)) {
+    /* Fails if the binary is not compatible, compiling the sources again replaces it. */
+    shader = GPU_shader_load_from_binary(
+        data + sizeof(*header), header->binary_format, header->binary_len, shname);
+  }
+  MEM_freeN(data);
+
+  return shader;
+}
+
+static void gpu_pass_disk_cache_store(const GPUPass *pass, GPUShader *shader)
+{
+  if (!gpu_pass_disk_cache_is_enabled()) {
+    return;
+  }
+
+  GPUPassDiskCacheHeader header = {PASS_DISK_CACHE_MAGIC};
+  char *binary = GPU_shader_get_binary(shader, &header.binary_format, &header.binary_len);
+  if (header.binary_len <= 0) {
+    MEM_freeN(binary);
+    return;
+  }
+
+  char filepath[FILE_MAX], filepath_tmp[FILE_MAX];
+  gpu_pass_disk_cache_filepath(pass, filepath);
+  /* Write to a temporary file first, so other threads or instances never read partial files. */
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%p.tmp", filepath, (void *)pass);
+
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file != NULL) {
+    const bool written = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+                         (fwrite(binary, header.binary_len, 1, file) == 1);
+    fclose(file);
+    if (!written || (BLI_rename(filepath_tmp, filepath) != 0)) {
+      BLI_delete(filepath_tmp, false, false);
+    }
+  }
+  MEM_freeN(binary);
+}
+
 /* -------------------- GPU Codegen ------------------ */
 
 /* type definitions and constants */
@@ -175,7 +320,7 @@ static const char *GPU_DATATYPE_STR[17] = {
 /* GLSL code parsing for finding function definitions.
  * These are stored in a hash for lookup when creating a material. */
 
-static GHash *FUNCTION_HASH = NULL;
+static StrMap *FUNCTION_HASH = NULL;
 #if 0
 static char *FUNCTION_PROTOTYPES = NULL;
 static GPUShader *FUNCTION_LIB = NULL;
@@ -232,7 +377,7 @@ static char *gpu_str_skip_token(char *str, char *token, int max)
   return str;
 }
 
-static void gpu_parse_material_library(GHash *hash, GPUMaterialLibrary *library)
+static void gpu_parse_material_library(StrMap *hash, GPUMaterialLibrary *library)
 {
   GPUFunction *function;
   eGPUType type;
@@ -310,7 +455,7 @@ static void gpu_parse_material_library(GHash *hash, GPUMaterialLibrary *library)
       break;
     }
 
-    BLI_ghash_insert(hash, function->name, function);
+    BLI_strmap_insert(hash, function->name, function);
   }
 }
 
@@ -371,7 +516,7 @@ static char *gpu_generate_function_prototyps(GHash *hash)
 
 static GPUFunction *gpu_lookup_function(const char *name)
 {
-  return BLI_ghash_lookup(FUNCTION_HASH, (const void *)name);
+  return BLI_strmap_lookup(FUNCTION_HASH, name);
 }
 
 void gpu_codegen_init(void)
@@ -388,7 +533,7 @@ void gpu_codegen_exit(void)
   }
 
   if (FUNCTION_HASH) {
-    BLI_ghash_free(FUNCTION_HASH, NULL, MEM_freeN);
+    BLI_strmap_free(FUNCTION_HASH, MEM_freeN);
     FUNCTION_HASH = NULL;
   }
 
@@ -1412,7 +1557,7 @@ void GPU_code_generate_glsl_lib(void)
     return;
   }
 
-  FUNCTION_HASH = BLI_ghash_str_new("GPU_lookup_function gh");
+  FUNCTION_HASH = BLI_strmap_new("GPU_lookup_function gh");
   for (int i = 0; gpu_material_libraries[i]; i++) {
     gpu_parse_material_library(FUNCTION_HASH, gpu_material_libraries[i]);
   }
@@ -2216,8 +2361,12 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
   if (!pass->compiled) {
-    GPUShader *shader = GPU_shader_create(
-        pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
+    GPUShader *shader = gpu_pass_disk_cache_load(pass, shname);
+    const bool is_cached = (shader != NULL);
+    if (!is_cached) {
+      shader = GPU_shader_create(
+          pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
+    }
 
     /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
      * We need to make sure to count active samplers to avoid undefined behavior. */
@@ -2229,11 +2378,16 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
         shader = NULL;
       }
     }
-    else if (!BLI_thread_is_main() && GPU_context_local_shaders_workaround()) {
-      pass->binary.content = GPU_shader_get_binary(
-          shader, &pass->binary.format, &pass->binary.len);
-      GPU_shader_free(shader);
-      shader = NULL;
+    else {
+      if (!is_cached) {
+        gpu_pass_disk_cache_store(pass, shader);
+      }
+      if (!BLI_thread_is_main() && GPU_context_local_shaders_workaround()) {
+        pass->binary.content = GPU_shader_get_binary(
+            shader, &pass->binary.format, &pass->binary.len);
+        GPU_shader_free(shader);
+        shader = NULL;
+      }
     }
 
     pass->shader = shader;
@@ -2306,6 +2460,7 @@ void GPU_pass_cache_garbage_collect(void)
 void GPU_pass_cache_init(void)
 {
   BLI_spin_init(&pass_cache_spin);
+  gpu_pass_disk_cache_init();
 }
 
 void GPU_pass_cache_free(void)
@@ -1004,11 +1004,69 @@ void GPU_free_images_anim(Main *bmain)
   }
 }
 
+static uint gpu_image_texture_memory(Image *ima)
+{
+  uint memory = 0;
+
+  LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
+    for (int i = 0; i < TEXTARGET_COUNT; i++) {
+      if (tile->gputexture[i]) {
+        memory += GPU_texture_memory_footprint_get(tile->gputexture[i]);
+      }
+    }
+  }
+
+  return memory;
+}
+
+/* Free least recently used image textures until they fit into the texture memory limit.
+ * Textures used within the last second are kept, so the images of the current redraw are
+ * not uploaded again for every redraw when the limit is too small for them. */
+static void gpu_free_images_over_limit(Main *bmain, int ctime)
+{
+  const size_t limit = (size_t)U.texture_memory_limit * 1024 * 1024;
+  size_t memory = 0;
+
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    memory += gpu_image_texture_memory(ima);
+  }
+
+  while (memory > limit) {
+    Image *oldest = NULL;
+    uint oldest_memory = 0;
+
+    LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+      if ((ima->flag & IMA_NOCOLLECT) || ctime - ima->lastused < 1) {
+        continue;
+      }
+      if (oldest && ima->lastused >= oldest->lastused) {
+        continue;
+      }
+      const uint ima_memory = gpu_image_texture_memory(ima);
+      if (ima_memory != 0) {
+        oldest = ima;
+        oldest_memory = ima_memory;
+      }
+    }
+
+    if (oldest == NULL) {
+      break;
+    }
+
+    GPU_free_image(oldest);
+    memory -= oldest_memory;
+  }
+}
+
 void GPU_free_images_old(Main *bmain)
 {
   static int lasttime = 0;
   int ctime = (int)PIL_check_seconds_timer();
 
+  if (U.texture_memory_limit > 0 && !G.is_rendering) {
+    gpu_free_images_over_limit(bmain, ctime);
+  }
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
@@ -35,6 +35,9 @@
 
 #define RESTART_INDEX 0xFFFFFFFF
 
+/* Total of the bytes sent to the GPU, for profiling. */
+static size_t ibo_upload_bytes;
+
 static GLenum convert_index_type_to_gl(GPUIndexBufType type)
 {
   static const GLenum table[] = {
@@ -371,8 +374,10 @@ void GPU_indexbuf_build_in_place(GPUIndexBufBuilder *builder, GPUIndexBuf *elem)
 
 static void indexbuf_upload_data(GPUIndexBuf *elem)
 {
+  const uint size = GPU_indexbuf_size_get(elem);
   /* send data to GPU */
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, GPU_indexbuf_size_get(elem), elem->data, GL_STATIC_DRAW);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, elem->data, GL_STATIC_DRAW);
+  ibo_upload_bytes += size;
   /* No need to keep copy of data in system memory. */
   MEM_freeN(elem->data);
   elem->data = NULL;
@@ -393,6 +398,11 @@ void GPU_indexbuf_use(GPUIndexBuf *elem)
   }
 }
 
+size_t GPU_indexbuf_upload_bytes_get(void)
+{
+  return ibo_upload_bytes;
+}
+
 void GPU_indexbuf_discard(GPUIndexBuf *elem)
 {
   if (elem->ibo_id) {
@@ -78,6 +78,8 @@ static struct GPUGlobal {
   /* Some Intel drivers have limited support for `GLEW_ARB_base_instance` so in
    * these cases it is best to indicate that it is not supported. See T67951 */
   bool glew_arb_base_instance_is_supported;
+  /* Persistently mapped buffers, see gpu_ring_buffer.c */
+  bool glew_arb_buffer_storage_is_supported;
   /* Some Intel drivers have issues with using mips as framebuffer targets if
    * GL_TEXTURE_MAX_LEVEL is higher than the target mip.
    * We need a workaround in this cases. */
@@ -196,6 +198,11 @@ bool GPU_arb_base_instance_is_supported(void)
   return GG.glew_arb_base_instance_is_supported;
 }
 
+bool GPU_arb_buffer_storage_is_supported(void)
+{
+  return GG.glew_arb_buffer_storage_is_supported;
+}
+
 bool GPU_mip_render_workaround(void)
 {
   return GG.mip_render_workaround;
@@ -279,6 +286,7 @@ void gpu_extensions_init(void)
   }
 
   GG.glew_arb_base_instance_is_supported = GLEW_ARB_base_instance;
+  GG.glew_arb_buffer_storage_is_supported = GLEW_ARB_buffer_storage;
   gpu_detect_mip_render_workaround();
 
   if (G.debug & G_DEBUG_GPU_FORCE_WORKAROUNDS) {
@@ -292,6 +300,7 @@ void gpu_extensions_init(void)
     GG.depth_blitting_workaround = true;
     GG.unused_fb_slot_workaround = true;
     GG.context_local_shaders_workaround = GLEW_ARB_get_program_binary;
+    GG.glew_arb_buffer_storage_is_supported = false;
   }
 
   /* df/dy calculation factors, those are dependent on driver */
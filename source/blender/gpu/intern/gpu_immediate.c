@@ -31,6 +31,7 @@
 #include "gpu_attr_binding_private.h"
 #include "gpu_context_private.h"
 #include "gpu_primitive_private.h"
+#include "gpu_ring_buffer_private.h"
 #include "gpu_shader_private.h"
 #include "gpu_vertex_format_private.h"
 
@@ -66,6 +67,11 @@ typedef struct {
   GLuint vbo_id;
   GLuint vao_id;
 
+  /* Used instead of vbo_id when supported and the draw call fits in. */
+  GPURingBuffer *ring;
+  uint ring_offset;
+  bool ring_mapped;
+
   GLuint bound_program;
   const GPUShaderInterface *shader_interface;
   GPUAttrBinding attr_binding;
@@ -90,6 +96,8 @@ void immInit(void)
   glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
   glBufferData(GL_ARRAY_BUFFER, imm_buffer_size, NULL, GL_DYNAMIC_DRAW);
 
+  imm.ring = gpu_ring_buffer_create(GL_ARRAY_BUFFER, DEFAULT_INTERNAL_BUFFER_SIZE);
+
   imm.prim_type = GPU_PRIM_NONE;
   imm.strict_vertex_len = true;
 
@@ -123,6 +131,9 @@ void immDeactivate(void)
 void immDestroy(void)
 {
   GPU_buf_free(imm.vbo_id);
+  if (imm.ring) {
+    gpu_ring_buffer_free(imm.ring);
+  }
   initialized = false;
 }
 
@@ -212,6 +223,18 @@ void immBegin(GPUPrimType prim_type, uint vertex_len)
   /* how many bytes do we need for this draw call? */
   const uint bytes_needed = vertex_buffer_size(&imm.vertex_format, vertex_len);
 
+  if (imm.ring) {
+    imm.buffer_data = gpu_ring_buffer_map(
+        imm.ring, bytes_needed, imm.vertex_format.stride, &imm.ring_offset);
+    if (imm.buffer_data != NULL) {
+      glBindBuffer(GL_ARRAY_BUFFER, gpu_ring_buffer_id_get(imm.ring));
+      imm.ring_mapped = true;
+      imm.buffer_bytes_mapped = bytes_needed;
+      imm.vertex_data = imm.buffer_data;
+      return;
+    }
+  }
+
   glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
 
   /* does the current buffer have enough room? */
@@ -324,11 +347,12 @@ static void immDrawSetup(void)
   }
 
   const uint stride = imm.vertex_format.stride;
+  const uint buffer_offset = imm.ring_mapped ? imm.ring_offset : imm.buffer_offset;
 
   for (uint a_idx = 0; a_idx < imm.vertex_format.attr_len; a_idx++) {
     const GPUVertAttr *a = &imm.vertex_format.attrs[a_idx];
 
-    const uint offset = imm.buffer_offset + a->offset;
+    const uint offset = buffer_offset + a->offset;
     const GLvoid *pointer = (const GLubyte *)0 + offset;
 
     const uint loc = read_attr_location(&imm.attr_binding, a_idx);
@@ -381,7 +405,9 @@ void immEnd(void)
       /* unused buffer bytes are available to the next immBegin */
     }
     /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    if (!imm.ring_mapped) {
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    }
   }
 
   if (imm.batch) {
@@ -394,7 +420,9 @@ void immEnd(void)
     imm.batch = NULL; /* don't free, batch belongs to caller */
   }
   else {
-    glUnmapBuffer(GL_ARRAY_BUFFER);
+    if (!imm.ring_mapped) {
+      glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
 
     if (imm.vertex_len > 0) {
       immDrawSetup();
@@ -411,7 +439,13 @@ void immEnd(void)
     // glBindBuffer(GL_ARRAY_BUFFER, 0);
     // glBindVertexArray(0);
     /* prep for next immBegin */
-    imm.buffer_offset += buffer_bytes_used;
+    if (imm.ring_mapped) {
+      gpu_ring_buffer_unmap(imm.ring, buffer_bytes_used);
+      imm.ring_mapped = false;
+    }
+    else {
+      imm.buffer_offset += buffer_bytes_used;
+    }
   }
 
   /* prep for next immBegin */
@@ -0,0 +1,139 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup gpu
+ *
+ * The buffer is mapped once for its whole lifetime and split in segments which are written
+ * one after the other. A fence is placed when leaving a segment and waited on before
+ * writing to it again, so the CPU only stalls when the GPU lags more than
+ * RING_BUFFER_SEGMENT_LEN - 1 segments behind. This avoids the driver synchronization of
+ * mapping or orphaning a buffer for each upload.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "GPU_extensions.h"
+
+#include "gpu_context_private.h"
+#include "gpu_ring_buffer_private.h"
+#include "gpu_vertex_format_private.h"
+
+#define RING_BUFFER_SEGMENT_LEN 3
+
+struct GPURingBuffer {
+  GLenum target;
+  GLuint buffer_id;
+  GLubyte *data;
+  uint segment_size;
+  /* Segment being written and write position in the whole buffer. */
+  uint segment;
+  uint offset;
+  /* Set for the segments the GPU might still be reading from. */
+  GLsync fences[RING_BUFFER_SEGMENT_LEN];
+};
+
+GPURingBuffer *gpu_ring_buffer_create(GLenum target, uint segment_size)
+{
+  if (!GPU_arb_buffer_storage_is_supported()) {
+    return NULL;
+  }
+  const uint size = segment_size * RING_BUFFER_SEGMENT_LEN;
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  GPURingBuffer *ring = MEM_callocN(sizeof(GPURingBuffer), __func__);
+  ring->target = target;
+  ring->segment_size = segment_size;
+  ring->buffer_id = GPU_buf_alloc();
+  glBindBuffer(target, ring->buffer_id);
+  glBufferStorage(target, size, NULL, flags);
+  ring->data = glMapBufferRange(target, 0, size, flags);
+  glBindBuffer(target, 0);
+
+  if (ring->data == NULL) {
+    gpu_ring_buffer_free(ring);
+    return NULL;
+  }
+  return ring;
+}
+
+void gpu_ring_buffer_free(GPURingBuffer *ring)
+{
+  for (int i = 0; i < RING_BUFFER_SEGMENT_LEN; i++) {
+    if (ring->fences[i] != NULL) {
+      glDeleteSync(ring->fences[i]);
+    }
+  }
+  if (ring->data != NULL) {
+    glBindBuffer(ring->target, ring->buffer_id);
+    glUnmapBuffer(ring->target);
+    glBindBuffer(ring->target, 0);
+  }
+  GPU_buf_free(ring->buffer_id);
+  MEM_freeN(ring);
+}
+
+GLuint gpu_ring_buffer_id_get(const GPURingBuffer *ring)
+{
+  return ring->buffer_id;
+}
+
+static void ring_buffer_segment_next(GPURingBuffer *ring)
+{
+  /* All the draw calls reading the current segment have been issued. */
+  ring->fences[ring->segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  ring->segment = (ring->segment + 1) % RING_BUFFER_SEGMENT_LEN;
+  ring->offset = ring->segment * ring->segment_size;
+
+  GLsync fence = ring->fences[ring->segment];
+  if (fence != NULL) {
+    GLbitfield wait_flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (glClientWaitSync(fence, wait_flags, 1000000000) == GL_TIMEOUT_EXPIRED) {
+      wait_flags = 0;
+    }
+    glDeleteSync(fence);
+    ring->fences[ring->segment] = NULL;
+  }
+}
+
+void *gpu_ring_buffer_map(GPURingBuffer *ring, uint len, uint alignment, uint *r_offset)
+{
+  /* Worst case padding at the start of a segment. */
+  if (len + alignment > ring->segment_size) {
+    return NULL;
+  }
+  const uint segment_end = (ring->segment + 1) * ring->segment_size;
+  uint offset = ring->offset + padding(ring->offset, alignment);
+  if (offset + len > segment_end) {
+    ring_buffer_segment_next(ring);
+    offset = ring->offset + padding(ring->offset, alignment);
+  }
+  ring->offset = offset;
+  *r_offset = offset;
+  return ring->data + offset;
+}
+
+void gpu_ring_buffer_unmap(GPURingBuffer *ring, uint used_len)
+{
+  BLI_assert(ring->offset + used_len <= (ring->segment + 1) * ring->segment_size);
+  ring->offset += used_len;
+}
@@ -0,0 +1,46 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup gpu
+ *
+ * Persistently mapped buffer for streaming data which is only used by the draw calls
+ * following its upload.
+ */
+
+#ifndef __GPU_RING_BUFFER_PRIVATE_H__
+#define __GPU_RING_BUFFER_PRIVATE_H__
+
+#include "GPU_glew.h"
+
+typedef struct GPURingBuffer GPURingBuffer;
+
+/* Returns NULL if persistent mapping is not supported. */
+GPURingBuffer *gpu_ring_buffer_create(GLenum target, uint segment_size);
+void gpu_ring_buffer_free(GPURingBuffer *ring);
+
+GLuint gpu_ring_buffer_id_get(const GPURingBuffer *ring);
+
+/* Returns a pointer to write len bytes to, starting at r_offset in the buffer object,
+ * or NULL if len does not fit in a segment. Only one range can be mapped at a time. */
+void *gpu_ring_buffer_map(GPURingBuffer *ring, uint len, uint alignment, uint *r_offset);
+/* Release the mapped range, the bytes past used_len are available to the next map. */
+void gpu_ring_buffer_unmap(GPURingBuffer *ring, uint used_len);
+
+#endif /* __GPU_RING_BUFFER_PRIVATE_H__ */
@@ -36,6 +36,7 @@
 
 #include "BLI_rect.h"
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "gpu_select_private.h"
@@ -119,74 +120,6 @@ static DepthBufCache *depth_buf_malloc(uint rect_len)
   return rect;
 }
 
-static bool depth_buf_rect_depth_any(const DepthBufCache *rect_depth, uint rect_len)
-{
-  const depth_t *curr = rect_depth->buf;
-  for (uint i = 0; i < rect_len; i++, curr++) {
-    if (*curr != DEPTH_MAX) {
-      return true;
-    }
-  }
-  return false;
-}
-
-static bool depth_buf_subrect_depth_any(const DepthBufCache *rect_depth,
-                                        const SubRectStride *sub_rect)
-{
-  const depth_t *curr = rect_depth->buf + sub_rect->start;
-  for (uint i = 0; i < sub_rect->span_len; i++) {
-    const depth_t *curr_end = curr + sub_rect->span;
-    for (; curr < curr_end; curr++, curr++) {
-      if (*curr != DEPTH_MAX) {
-        return true;
-      }
-    }
-    curr += sub_rect->skip;
-  }
-  return false;
-}
-
-static bool depth_buf_rect_depth_any_filled(const DepthBufCache *rect_prev,
-                                            const DepthBufCache *rect_curr,
-                                            uint rect_len)
-{
-#if 0
-  return memcmp(rect_depth_a->buf, rect_depth_b->buf, rect_len * sizeof(depth_t)) != 0;
-#else
-  const depth_t *prev = rect_prev->buf;
-  const depth_t *curr = rect_curr->buf;
-  for (uint i = 0; i < rect_len; i++, curr++, prev++) {
-    if (depth_is_filled(prev, curr)) {
-      return true;
-    }
-  }
-  return false;
-#endif
-}
-
-/**
- * Both buffers are the same size, just check if the sub-rect contains any differences.
- */
-static bool depth_buf_subrect_depth_any_filled(const DepthBufCache *rect_src,
-                                               const DepthBufCache *rect_dst,
-                                               const SubRectStride *sub_rect)
-{
-  /* same as above but different rect sizes */
-  const depth_t *prev = rect_src->buf + sub_rect->start;
-  const depth_t *curr = rect_dst->buf + sub_rect->start;
-  for (uint i = 0; i < sub_rect->span_len; i++) {
-    const depth_t *curr_end = curr + sub_rect->span;
-    for (; curr < curr_end; prev++, curr++) {
-      if (depth_is_filled(prev, curr)) {
-        return true;
-      }
-    }
-    prev += sub_rect->skip;
-    curr += sub_rect->skip;
-  }
-  return false;
-}
-
 /* ----------------------------------------------------------------------------
  * DepthID
  *
@@ -258,14 +191,14 @@ typedef struct GPUPickState {
     uint rect_len;
   } src, dst;
 
+  /* Used for iterating over both source and destination buffers:
+   * src.clip_rect -> dst.clip_rect, covers the whole source when not cached. */
+  SubRectStride sub_rect;
+
   /* Store cache between `GPU_select_cache_begin/end` */
   bool use_cache;
   bool is_cached;
   struct {
-    /* Cleanup used for iterating over both source and destination buffers:
-     * src.clip_rect -> dst.clip_rect */
-    SubRectStride sub_rect;
-
     /* List of DepthBufCache, sized of 'src.clip_rect' */
     ListBase bufs;
   } cache;
@@ -363,11 +296,11 @@ void gpu_select_pick_begin(uint (*buffer)[4], uint bufsize, const rcti *input, c
   }
   else {
     /* Using cache (ps->is_cached == true) */
-    /* src.clip_rect -> dst.clip_rect */
-    rect_subregion_stride_calc(&ps->src.clip_rect, &ps->dst.clip_rect, &ps->cache.sub_rect);
     BLI_assert(ps->gl.rect_depth == NULL);
     BLI_assert(ps->gl.rect_depth_test == NULL);
   }
+  /* src.clip_rect -> dst.clip_rect */
+  rect_subregion_stride_calc(&ps->src.clip_rect, &ps->dst.clip_rect, &ps->sub_rect);
 
   if (mode == GPU_SELECT_PICK_ALL) {
     ps->all.hits = MEM_mallocN(sizeof(*ps->all.hits) * ALLOC_DEPTHS, __func__);
@@ -381,44 +314,124 @@ void gpu_select_pick_begin(uint (*buffer)[4], uint bufsize, const rcti *input, c
   }
 }
 
-/**
- * Given 2x depths, we know are different - update the depth information
- * use for both cached/uncached depth buffers.
+/* ----------------------------------------------------------------------------
+ * ID Passes
+ *
+ * Compare the depth buffer of an ID pass with the previous one, large regions are split
+ * by rows over multiple threads.
  */
-static void gpu_select_load_id_pass_all(const DepthBufCache *rect_curr)
-{
-  GPUPickState *ps = &g_pick_state;
-  const uint id = rect_curr->id;
-  /* find the best depth for this pass and store in 'all.hits' */
-  depth_t depth_best = DEPTH_MAX;
 
-#define EVAL_TEST() \
-  if (depth_best > *curr) { \
-    depth_best = *curr; \
-  } \
-  ((void)0)
+/* Minimum number of pixels of a region to use threads. */
+#define THREADED_RECT_LEN (256 * 256)
 
-  if (ps->is_cached == false) {
-    const depth_t *curr = rect_curr->buf;
-    BLI_assert(ps->src.rect_len == ps->dst.rect_len);
-    const uint rect_len = ps->src.rect_len;
-    for (uint i = 0; i < rect_len; i++, curr++) {
-      EVAL_TEST();
+typedef struct DepthPassData {
+  const SubRectStride *sub_rect;
+  const depth_t *prev;
+  const depth_t *curr;
+  /* Only for GPU_SELECT_PICK_NEAREST: ID of each pixel of 'dst.clip_rect'. */
+  uint *rect_id;
+  uint id;
+} DepthPassData;
+
+typedef struct DepthPassChunk {
+  depth_t depth_best;
+  bool is_filled;
+} DepthPassChunk;
+
+static void depth_pass_all_cb(void *__restrict userdata,
+                              const int row,
+                              const TaskParallelTLS *__restrict tls)
+{
+  const DepthPassData *data = userdata;
+  DepthPassChunk *chunk = tls->userdata_chunk;
+  const SubRectStride *sub_rect = data->sub_rect;
+  const uint ofs = sub_rect->start + (uint)row * (sub_rect->span + sub_rect->skip);
+  const depth_t *curr = data->curr + ofs;
+  const depth_t *curr_end = curr + sub_rect->span;
+  for (; curr < curr_end; curr++) {
+    if (chunk->depth_best > *curr) {
+      chunk->depth_best = *curr;
     }
   }
-  else {
-    /* same as above but different rect sizes */
-    const depth_t *curr = rect_curr->buf + ps->cache.sub_rect.start;
-    for (uint i = 0; i < ps->cache.sub_rect.span_len; i++) {
-      const depth_t *curr_end = curr + ps->cache.sub_rect.span;
-      for (; curr < curr_end; curr++) {
-        EVAL_TEST();
+}
+
+static void depth_pass_all_reduce(const void *__restrict UNUSED(userdata),
+                                  void *__restrict chunk_join,
+                                  void *__restrict chunk)
+{
+  DepthPassChunk *join = chunk_join;
+  const DepthPassChunk *other = chunk;
+  join->depth_best = MIN2(join->depth_best, other->depth_best);
+}
+
+static void depth_pass_nearest_cb(void *__restrict userdata,
+                                  const int row,
+                                  const TaskParallelTLS *__restrict tls)
+{
+  const DepthPassData *data = userdata;
+  DepthPassChunk *chunk = tls->userdata_chunk;
+  const SubRectStride *sub_rect = data->sub_rect;
+  const uint ofs = sub_rect->start + (uint)row * (sub_rect->span + sub_rect->skip);
+  const depth_t *prev = data->prev + ofs;
+  const depth_t *curr = data->curr + ofs;
+  uint *id_ptr = data->rect_id + (uint)row * sub_rect->span;
+  for (uint i = 0; i < sub_rect->span; i++) {
+    /* Check against DEPTH_MAX because XRAY will clear the buffer,
+     * so previously set values will become unset.
+     * In this case just leave those id's left as-is. */
+    if (depth_is_filled(&prev[i], &curr[i])) {
+      chunk->is_filled = true;
+      if (data->id != SELECT_ID_NONE) {
+        id_ptr[i] = data->id;
       }
-      curr += ps->cache.sub_rect.skip;
     }
   }
+}
 
-#undef EVAL_TEST
+static void depth_pass_nearest_reduce(const void *__restrict UNUSED(userdata),
+                                      void *__restrict chunk_join,
+                                      void *__restrict chunk)
+{
+  DepthPassChunk *join = chunk_join;
+  const DepthPassChunk *other = chunk;
+  join->is_filled |= other->is_filled;
+}
+
+static void depth_pass_run(DepthPassData *data,
+                           DepthPassChunk *chunk,
+                           TaskParallelRangeFunc func,
+                           TaskParallelReduceFunc func_reduce)
+{
+  const SubRectStride *sub_rect = data->sub_rect;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (sub_rect->span * sub_rect->span_len) >= THREADED_RECT_LEN;
+  settings.userdata_chunk = chunk;
+  settings.userdata_chunk_size = sizeof(*chunk);
+  settings.func_reduce = func_reduce;
+  BLI_task_parallel_range(0, (int)sub_rect->span_len, data, func, &settings);
+}
+
+/**
+ * Store the best depth of the pass in 'all.hits',
+ * use for both cached/uncached depth buffers.
+ *
+ * \return false when nothing was drawn in the region.
+ */
+static bool gpu_select_load_id_pass_all(const DepthBufCache *rect_curr)
+{
+  GPUPickState *ps = &g_pick_state;
+  DepthPassData data = {
+      .sub_rect = &ps->sub_rect,
+      .curr = rect_curr->buf,
+  };
+  DepthPassChunk chunk = {
+      .depth_best = DEPTH_MAX,
+  };
+  depth_pass_run(&data, &chunk, depth_pass_all_cb, depth_pass_all_reduce);
+  if (chunk.depth_best == DEPTH_MAX) {
+    return false;
+  }
 
   /* ensure enough space */
   if (UNLIKELY(ps->all.hits_len == ps->all.hits_len_alloc)) {
@@ -426,53 +439,33 @@ static void gpu_select_load_id_pass_all(const DepthBufCache *rect_curr)
     ps->all.hits = MEM_reallocN(ps->all.hits, ps->all.hits_len_alloc * sizeof(*ps->all.hits));
   }
   DepthID *d = &ps->all.hits[ps->all.hits_len++];
-  d->id = id;
-  d->depth = depth_best;
+  d->id = rect_curr->id;
+  d->depth = chunk.depth_best;
+  return true;
 }
 
-static void gpu_select_load_id_pass_nearest(const DepthBufCache *rect_prev,
+/**
+ * Keep track each pixels ID in 'nearest.rect_id',
+ * use for both cached/uncached depth buffers.
+ *
+ * \return false when no depth changed in the region.
+ */
+static bool gpu_select_load_id_pass_nearest(const DepthBufCache *rect_prev,
                                             const DepthBufCache *rect_curr)
 {
   GPUPickState *ps = &g_pick_state;
-  const uint id = rect_curr->id;
-  /* keep track each pixels ID in 'nearest.rect_id' */
-  if (id != SELECT_ID_NONE) {
-    uint *id_ptr = ps->nearest.rect_id;
-
-    /* Check against DEPTH_MAX because XRAY will clear the buffer,
-     * so previously set values will become unset.
-     * In this case just leave those id's left as-is. */
-#define EVAL_TEST() \
-  if (depth_is_filled(prev, curr)) { \
-    *id_ptr = id; \
-  } \
-  ((void)0)
-
-    if (ps->is_cached == false) {
-      const depth_t *prev = rect_prev->buf;
-      const depth_t *curr = rect_curr->buf;
-      BLI_assert(ps->src.rect_len == ps->dst.rect_len);
-      const uint rect_len = ps->src.rect_len;
-      for (uint i = 0; i < rect_len; i++, curr++, prev++, id_ptr++) {
-        EVAL_TEST();
-      }
-    }
-    else {
-      /* same as above but different rect sizes */
-      const depth_t *prev = rect_prev->buf + ps->cache.sub_rect.start;
-      const depth_t *curr = rect_curr->buf + ps->cache.sub_rect.start;
-      for (uint i = 0; i < ps->cache.sub_rect.span_len; i++) {
-        const depth_t *curr_end = curr + ps->cache.sub_rect.span;
-        for (; curr < curr_end; prev++, curr++, id_ptr++) {
-          EVAL_TEST();
-        }
-        prev += ps->cache.sub_rect.skip;
-        curr += ps->cache.sub_rect.skip;
-      }
-    }
-
-#undef EVAL_TEST
-  }
+  DepthPassData data = {
+      .sub_rect = &ps->sub_rect,
+      .prev = rect_prev->buf,
+      .curr = rect_curr->buf,
+      .rect_id = ps->nearest.rect_id,
+      .id = rect_curr->id,
+  };
+  DepthPassChunk chunk = {
+      .depth_best = DEPTH_MAX,
+  };
+  depth_pass_run(&data, &chunk, depth_pass_nearest_cb, depth_pass_nearest_reduce);
+  return chunk.is_filled;
 }
 
 bool gpu_select_pick_load_id(uint id, bool end)
@@ -486,27 +479,19 @@ bool gpu_select_pick_load_id(uint id, bool end)
       return true;
     }
 
-    const uint rect_len = ps->src.rect_len;
     glReadPixels(UNPACK4(ps->gl.clip_readpixels),
                  GL_DEPTH_COMPONENT,
                  GL_UNSIGNED_INT,
                  ps->gl.rect_depth_test->buf);
-    /* perform initial check since most cases the array remains unchanged  */
+    /* In most cases the array remains unchanged, then the pass is skipped. */
+    ps->gl.rect_depth_test->id = ps->gl.prev_id;
 
-    bool do_pass = false;
+    bool do_pass;
     if (g_pick_state.mode == GPU_SELECT_PICK_ALL) {
-      if (depth_buf_rect_depth_any(ps->gl.rect_depth_test, rect_len)) {
-        ps->gl.rect_depth_test->id = ps->gl.prev_id;
-        gpu_select_load_id_pass_all(ps->gl.rect_depth_test);
-        do_pass = true;
-      }
+      do_pass = gpu_select_load_id_pass_all(ps->gl.rect_depth_test);
     }
     else {
-      if (depth_buf_rect_depth_any_filled(ps->gl.rect_depth, ps->gl.rect_depth_test, rect_len)) {
-        ps->gl.rect_depth_test->id = ps->gl.prev_id;
-        gpu_select_load_id_pass_nearest(ps->gl.rect_depth, ps->gl.rect_depth_test);
-        do_pass = true;
-      }
+      do_pass = gpu_select_load_id_pass_nearest(ps->gl.rect_depth, ps->gl.rect_depth_test);
     }
 
     if (do_pass) {
@@ -614,13 +599,13 @@ uint gpu_select_pick_end(void)
       }
       else {
         /* same as above but different rect sizes */
-        uint i_src = ps->cache.sub_rect.start, i_dst = 0;
-        for (uint j = 0; j < ps->cache.sub_rect.span_len; j++) {
-          const uint i_src_end = i_src + ps->cache.sub_rect.span;
+        uint i_src = ps->sub_rect.start, i_dst = 0;
+        for (uint j = 0; j < ps->sub_rect.span_len; j++) {
+          const uint i_src_end = i_src + ps->sub_rect.span;
           for (; i_src < i_src_end; i_src++, i_dst++) {
             EVAL_TEST(i_src, i_dst);
           }
-          i_src += ps->cache.sub_rect.skip;
+          i_src += ps->sub_rect.skip;
         }
       }
     }
@@ -733,18 +718,13 @@ void gpu_select_pick_cache_load_id(void)
   for (DepthBufCache *rect_depth = ps->cache.bufs.first; rect_depth;
        rect_depth = rect_depth->next) {
     if (rect_depth->next != NULL) {
-      /* we know the buffers differ, but this sub-region may not.
-       * double check before adding an id-pass */
+      /* we know the buffers differ, but this sub-region may not,
+       * the passes only add an id when it does. */
       if (g_pick_state.mode == GPU_SELECT_PICK_ALL) {
-        if (depth_buf_subrect_depth_any(rect_depth->next, &ps->cache.sub_rect)) {
-          gpu_select_load_id_pass_all(rect_depth->next);
-        }
+        gpu_select_load_id_pass_all(rect_depth->next);
       }
       else {
-        if (depth_buf_subrect_depth_any_filled(
-                rect_depth, rect_depth->next, &ps->cache.sub_rect)) {
-          gpu_select_load_id_pass_nearest(rect_depth, rect_depth->next);
-        }
+        gpu_select_load_id_pass_nearest(rect_depth, rect_depth->next);
       }
     }
   }
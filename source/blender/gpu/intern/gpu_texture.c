@@ -93,7 +93,7 @@ struct GPUTexture {
  * to estimate the Texture Pool Memory consumption */
 static uint memory_usage;
 
-static uint gpu_texture_memory_footprint_compute(GPUTexture *tex)
+static uint gpu_texture_memory_footprint_compute(const GPUTexture *tex)
 {
   int samp = max_ii(tex->samples, 1);
   switch (tex->target_base) {
@@ -129,6 +129,11 @@ uint GPU_texture_memory_usage_get(void)
   return memory_usage;
 }
 
+uint GPU_texture_memory_footprint_get(const GPUTexture *tex)
+{
+  return gpu_texture_memory_footprint_compute(tex);
+}
+
 /* -------------------------------- */
 
 static const char *gl_enum_to_str(GLenum e)
@@ -1050,7 +1055,7 @@ GPUTexture *GPU_texture_from_bindcode(int textarget, int bindcode)
     GPU_print_error_debug("Blender Texture Not Loaded");
   }
   else {
-    GLint w, h;
+    GLint w, h, internal_format;
 
     GLenum gettarget;
 
@@ -1064,9 +1069,28 @@ GPUTexture *GPU_texture_from_bindcode(int textarget, int bindcode)
     glBindTexture(textarget, tex->bindcode);
     glGetTexLevelParameteriv(gettarget, 0, GL_TEXTURE_WIDTH, &w);
     glGetTexLevelParameteriv(gettarget, 0, GL_TEXTURE_HEIGHT, &h);
+    glGetTexLevelParameteriv(gettarget, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_format);
     tex->w = w;
     tex->h = h;
     glBindTexture(textarget, 0);
+
+    /* Account for the formats image textures are created with, see GPU_create_gl_tex. */
+    switch (internal_format) {
+      case GL_RGBA8:
+      case GL_SRGB8_ALPHA8:
+        tex->bytesize = 4;
+        break;
+      case GL_RGBA16F:
+        tex->bytesize = 8;
+        break;
+      case GL_RGBA32F:
+        tex->bytesize = 16;
+        break;
+      default:
+        tex->bytesize = 0;
+        break;
+    }
+    gpu_texture_memory_footprint_add(tex);
   }
 
   return tex;
@@ -1236,14 +1260,14 @@ GPUTexture *GPU_texture_create_from_vertbuf(GPUVertBuf *vert)
     case GPU_FETCH_FLOAT:
       switch (attr->comp_len) {
         case 1:
-          data_type = GPU_R32F;
+          data_type = (byte_per_comp == 2) ? GPU_R16F : GPU_R32F;
           break;
         case 2:
-          data_type = GPU_RG32F;
+          data_type = (byte_per_comp == 2) ? GPU_RG16F : GPU_RG32F;
           break;
         // case 3: data_type = GPU_RGB32F; break; /* Not supported */
         default:
-          data_type = GPU_RGBA32F;
+          data_type = (byte_per_comp == 2) ? GPU_RGBA16F : GPU_RGBA32F;
           break;
       }
       break;
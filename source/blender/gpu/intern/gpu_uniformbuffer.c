@@ -67,10 +67,16 @@ static void gpu_uniformbuffer_inputs_sort(struct ListBase *inputs);
  * padding logic is correct for the new types. */
 #define MAX_UBO_GPU_TYPE GPU_MAT4
 
+/* Total of the bytes sent to the GPU, for profiling. */
+static size_t ubo_upload_bytes;
+
 static void gpu_uniformbuffer_initialize(GPUUniformBuffer *ubo, const void *data)
 {
   glBindBuffer(GL_UNIFORM_BUFFER, ubo->bindcode);
   glBufferData(GL_UNIFORM_BUFFER, ubo->size, data, GL_DYNAMIC_DRAW);
+  if (data != NULL) {
+    ubo_upload_bytes += ubo->size;
+  }
   glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
@@ -201,6 +207,7 @@ static void gpu_uniformbuffer_update(GPUUniformBuffer *ubo, const void *data)
 {
   glBindBuffer(GL_UNIFORM_BUFFER, ubo->bindcode);
   glBufferSubData(GL_UNIFORM_BUFFER, 0, ubo->size, data);
+  ubo_upload_bytes += ubo->size;
   glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
@@ -352,4 +359,9 @@ int GPU_uniformbuffer_bindpoint(GPUUniformBuffer *ubo)
   return ubo->bindpoint;
 }
 
+size_t GPU_uniformbuffer_upload_bytes_get(void)
+{
+  return ubo_upload_bytes;
+}
+
 #undef MAX_UBO_GPU_TYPE
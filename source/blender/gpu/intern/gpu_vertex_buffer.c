@@ -36,6 +36,8 @@
 #define KEEP_SINGLE_COPY 1
 
 static uint vbo_memory_usage;
+/* Total of the bytes sent to the GPU, for profiling. */
+static size_t vbo_upload_bytes;
 
 static GLenum convert_usage_type_to_gl(GPUUsageType type)
 {
@@ -264,6 +266,7 @@ static void VertBuffer_upload_data(GPUVertBuf *verts)
   glBufferData(GL_ARRAY_BUFFER, buffer_sz, NULL, convert_usage_type_to_gl(verts->usage));
   /* upload data */
   glBufferSubData(GL_ARRAY_BUFFER, 0, buffer_sz, verts->data);
+  vbo_upload_bytes += buffer_sz;
 
   if (verts->usage == GPU_USAGE_STATIC) {
     MEM_freeN(verts->data);
@@ -288,3 +291,8 @@ uint GPU_vertbuf_get_memory_usage(void)
 {
   return vbo_memory_usage;
 }
+
+size_t GPU_vertbuf_upload_bytes_get(void)
+{
+  return vbo_upload_bytes;
+}
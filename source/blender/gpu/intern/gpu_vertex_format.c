@@ -72,6 +72,7 @@ static GLenum convert_comp_type_to_gl(GPUVertCompType type)
       [GPU_COMP_I32] = GL_INT,
       [GPU_COMP_U32] = GL_UNSIGNED_INT,
 
+      [GPU_COMP_F16] = GL_HALF_FLOAT,
       [GPU_COMP_F32] = GL_FLOAT,
 
       [GPU_COMP_I10] = GL_INT_2_10_10_10_REV,
@@ -84,7 +85,7 @@ static uint comp_sz(GPUVertCompType type)
 #if TRUST_NO_ONE
   assert(type <= GPU_COMP_F32); /* other types have irregular sizes (not bytes) */
 #endif
-  const GLubyte sizes[] = {1, 1, 2, 2, 4, 4, 4};
+  const GLubyte sizes[] = {1, 1, 2, 2, 4, 4, 2, 4};
   return sizes[type];
 }
 
@@ -157,6 +158,7 @@ uint GPU_vertformat_attr_add(GPUVertFormat *format,
   assert((comp_len >= 1 && comp_len <= 4) || comp_len == 8 || comp_len == 12 || comp_len == 16);
 
   switch (comp_type) {
+    case GPU_COMP_F16:
     case GPU_COMP_F32:
       /* float type can only kept as float */
       assert(fetch_mode == GPU_FETCH_FLOAT);
@@ -81,6 +81,10 @@
 
 #define MAXNUMSTREAMS 50
 
+/* Frames kept from decoding towards the target of a backward seek. */
+#define ANIM_DECODE_CACHE_SIZE 32
+#define ANIM_DECODE_CACHE_MEMORY (256 * 1024 * 1024)
+
 struct IDProperty;
 struct _AviMovie;
 struct anim_index;
@@ -137,6 +141,13 @@ struct anim {
   int64_t last_pts;
   int64_t next_pts;
   AVPacket next_packet;
+
+  /* Ring of decoded frames, so stepping backwards doesn't decode the GOP again for every frame. */
+  struct ImBuf *decode_cache[ANIM_DECODE_CACHE_SIZE];
+  int64_t decode_cache_pts[ANIM_DECODE_CACHE_SIZE];
+  int decode_cache_next;
+  /* The decoder isn't positioned after curposition, because it was served from the cache. */
+  int decode_cache_hit;
 #endif
 
   char index_dir[768];
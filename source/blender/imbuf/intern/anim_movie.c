@@ -61,6 +61,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_string.h"
 #include "BLI_path_util.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -558,6 +559,10 @@ static int startffmpeg(struct anim *anim)
   }
 
   pCodecCtx->workaround_bugs = 1;
+  /* Decoders only use a single thread unless asked otherwise. Frames delayed by frame threading
+   * are drained like any other decoder delay, see ffmpeg_decode_video_frame. */
+  pCodecCtx->thread_count = BLI_system_thread_count();
+  pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
 
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
@@ -735,13 +740,12 @@ static int startffmpeg(struct anim *anim)
 /* postprocess the image in anim->pFrame and do color conversion
  * and deinterlacing stuff.
  *
- * Output is anim->last_frame
+ * Output is ibuf
  */
 
-static void ffmpeg_postprocess(struct anim *anim)
+static void ffmpeg_postprocess(struct anim *anim, ImBuf *ibuf)
 {
   AVFrame *input = anim->pFrame;
-  ImBuf *ibuf = anim->last_frame;
   int filter_y = 0;
 
   if (!anim->pFrameComplete) {
@@ -954,7 +958,60 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
   return (rval >= 0);
 }
 
-static void ffmpeg_decode_video_frame_scan(struct anim *anim, int64_t pts_to_search)
+static int ffmpeg_decode_cache_capacity(struct anim *anim)
+{
+  const size_t frame_size = (size_t)anim->x * anim->y * 4;
+  const size_t capacity = ANIM_DECODE_CACHE_MEMORY / (frame_size ? frame_size : 1);
+
+  return (int)CLAMPIS(capacity, 1, ANIM_DECODE_CACHE_SIZE);
+}
+
+/* Keep the frame in anim->pFrame, overwriting the oldest frame when the cache is full. */
+static void ffmpeg_decode_cache_add(struct anim *anim)
+{
+  const int index = anim->decode_cache_next;
+  ImBuf *ibuf;
+
+  if (!anim->pFrameComplete || anim->next_pts < 0) {
+    return;
+  }
+
+  ibuf = IMB_allocImBuf(anim->x, anim->y, 32, IB_rect);
+  if (ibuf == NULL) {
+    return;
+  }
+  ibuf->rect_colorspace = colormanage_colorspace_get_named(anim->colorspace);
+  ffmpeg_postprocess(anim, ibuf);
+
+  IMB_freeImBuf(anim->decode_cache[index]);
+  anim->decode_cache[index] = ibuf;
+  anim->decode_cache_pts[index] = anim->next_pts;
+  anim->decode_cache_next = (index + 1) % ffmpeg_decode_cache_capacity(anim);
+}
+
+static ImBuf *ffmpeg_decode_cache_lookup(struct anim *anim, int64_t pts)
+{
+  for (int i = 0; i < ANIM_DECODE_CACHE_SIZE; i++) {
+    if (anim->decode_cache[i] && anim->decode_cache_pts[i] == pts) {
+      return anim->decode_cache[i];
+    }
+  }
+  return NULL;
+}
+
+static void ffmpeg_decode_cache_free(struct anim *anim)
+{
+  for (int i = 0; i < ANIM_DECODE_CACHE_SIZE; i++) {
+    IMB_freeImBuf(anim->decode_cache[i]);
+    anim->decode_cache[i] = NULL;
+  }
+  anim->decode_cache_next = 0;
+}
+
+/* Decode until the frame with pts_to_search, optionally keeping the frames before it. */
+static void ffmpeg_decode_video_frame_scan(struct anim *anim,
+                                           int64_t pts_to_search,
+                                           bool keep_frames)
 {
   /* there seem to exist *very* silly GOP lengths out in the wild... */
   int count = 1000;
@@ -971,6 +1028,9 @@ static void ffmpeg_decode_video_frame_scan(struct anim *anim, int64_t pts_to_sea
            "  WHILE: pts=%lld in search of %lld\n",
            (long long int)anim->next_pts,
            (long long int)pts_to_search);
+    if (keep_frames) {
+      ffmpeg_decode_cache_add(anim);
+    }
     if (!ffmpeg_decode_video_frame(anim)) {
       break;
     }
@@ -1095,11 +1155,27 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
     return anim->last_frame;
   }
 
-  if (position > anim->curposition + 1 && anim->preseek && !tc_index &&
-      position - (anim->curposition + 1) < anim->preseek) {
+  ImBuf *cached_frame = ffmpeg_decode_cache_lookup(anim, pts_to_search);
+  if (cached_frame) {
+    av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: decoded before\n");
+    IMB_refImBuf(cached_frame);
+    anim->curposition = position;
+    anim->decode_cache_hit = true;
+    return cached_frame;
+  }
+
+  /* Stepping backwards needs a seek to the previous key frame for every frame, keep the frames
+   * decoded on the way to the target, so the following steps are served from the cache. */
+  const bool keep_frames = position < anim->curposition;
+
+  if (anim->decode_cache_hit) {
+    /* The decoder position is unknown, seek. */
+  }
+  else if (position > anim->curposition + 1 && anim->preseek && !tc_index &&
+           position - (anim->curposition + 1) < anim->preseek) {
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: within preseek interval (no index)\n");
 
-    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+    ffmpeg_decode_video_frame_scan(anim, pts_to_search, false);
   }
   else if (tc_index && IMB_indexer_can_scan(tc_index, old_frame_index, new_frame_index)) {
     av_log(anim->pFormatCtx,
@@ -1107,9 +1183,10 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
            "FETCH: within preseek interval "
            "(index tells us)\n");
 
-    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+    ffmpeg_decode_video_frame_scan(anim, pts_to_search, false);
   }
-  else if (position != anim->curposition + 1) {
+
+  if (anim->decode_cache_hit || position != anim->curposition + 1) {
     long long pos;
     int ret;
 
@@ -1178,8 +1255,10 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
 
     /* memset(anim->pFrame, ...) ?? */
 
+    anim->decode_cache_hit = false;
+
     if (ret >= 0) {
-      ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+      ffmpeg_decode_video_frame_scan(anim, pts_to_search, keep_frames);
     }
   }
   else if (position == 0 && anim->curposition == -1) {
@@ -1194,7 +1273,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
   anim->last_frame = IMB_allocImBuf(anim->x, anim->y, 32, IB_rect);
   anim->last_frame->rect_colorspace = colormanage_colorspace_get_named(anim->colorspace);
 
-  ffmpeg_postprocess(anim);
+  ffmpeg_postprocess(anim, anim->last_frame);
 
   anim->last_pts = anim->next_pts;
 
@@ -1237,6 +1316,7 @@ static void free_anim_ffmpeg(struct anim *anim)
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->last_frame);
+    ffmpeg_decode_cache_free(anim);
     if (anim->next_packet.stream_index != -1) {
       av_free_packet(&anim->next_packet);
     }
@@ -124,6 +124,20 @@ static struct global_glsl_state {
   struct OCIO_GLSLDrawState *transform_ocio_glsl_state;
 } global_glsl_state = {NULL};
 
+static struct global_display_buffer_state {
+  /* Processor of the last display buffer, only accessed with LOCK_COLORMANAGE held. */
+  ColormanageProcessor *cm_processor;
+
+  /* Settings of processor for comparison. */
+  char look[MAX_COLORSPACE_NAME];
+  char view[MAX_COLORSPACE_NAME];
+  char display[MAX_COLORSPACE_NAME];
+  float exposure, gamma;
+
+  CurveMapping *orig_curve_mapping;
+  int curve_mapping_timestamp;
+} global_display_buffer_state = {NULL};
+
 static struct global_color_picking_state {
   /* Cached processor for color picking conversion. */
   OCIO_ConstProcessorRcPtr *processor_to;
@@ -731,6 +745,10 @@ void colormanagement_exit(void)
     OCIO_freeOGLState(global_glsl_state.transform_ocio_glsl_state);
   }
 
+  if (global_display_buffer_state.cm_processor) {
+    IMB_colormanagement_processor_free(global_display_buffer_state.cm_processor);
+  }
+
   if (global_color_picking_state.processor_to) {
     OCIO_processorRelease(global_color_picking_state.processor_to);
   }
@@ -740,6 +758,7 @@ void colormanagement_exit(void)
   }
 
   memset(&global_glsl_state, 0, sizeof(global_glsl_state));
+  memset(&global_display_buffer_state, 0, sizeof(global_display_buffer_state));
   memset(&global_color_picking_state, 0, sizeof(global_color_picking_state));
 
   colormanage_free_config();
@@ -1407,6 +1426,8 @@ bool IMB_colormanagement_space_name_is_data(const char *name)
 
 typedef struct DisplayBufferThread {
   ColormanageProcessor *cm_processor;
+  /* Conversion of the image buffer to scene linear, NULL when not needed. */
+  ColormanageProcessor *linear_processor;
 
   const float *buffer;
   unsigned char *byte_buffer;
@@ -1430,6 +1451,7 @@ typedef struct DisplayBufferThread {
 typedef struct DisplayBufferInitData {
   ImBuf *ibuf;
   ColormanageProcessor *cm_processor;
+  ColormanageProcessor *linear_processor;
   const float *buffer;
   unsigned char *byte_buffer;
 
@@ -1461,6 +1483,7 @@ static void display_buffer_init_handle(void *handle_v,
   memset(handle, 0, sizeof(DisplayBufferThread));
 
   handle->cm_processor = init_data->cm_processor;
+  handle->linear_processor = init_data->linear_processor;
 
   if (init_data->buffer) {
     handle->buffer = init_data->buffer + offset;
@@ -1502,16 +1525,12 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
 
   size_t buffer_size = ((size_t)channels) * width * height;
 
-  bool is_data = handle->is_data;
-  bool is_data_display = handle->cm_processor->is_data_result;
+  ColormanageProcessor *linear_processor = handle->linear_processor;
   bool predivide = handle->predivide;
 
   if (!handle->buffer) {
     unsigned char *byte_buffer = handle->byte_buffer;
 
-    const char *from_colorspace = handle->byte_colorspace;
-    const char *to_colorspace = global_role_scene_linear;
-
     float *fp;
     unsigned char *cp;
     const size_t i_last = ((size_t)width) * height;
@@ -1531,10 +1550,10 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
       }
     }
 
-    if (!is_data && !is_data_display) {
+    if (linear_processor) {
       /* convert float buffer to scene linear space */
-      IMB_colormanagement_transform(
-          linear_buffer, width, height, channels, from_colorspace, to_colorspace, false);
+      IMB_colormanagement_processor_apply(
+          linear_processor, linear_buffer, width, height, channels, false);
     }
 
     *is_straight_alpha = true;
@@ -1546,14 +1565,11 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
      * Need to convert float buffer to linear space before applying display transform
      */
 
-    const char *from_colorspace = handle->float_colorspace;
-    const char *to_colorspace = global_role_scene_linear;
-
     memcpy(linear_buffer, handle->buffer, buffer_size * sizeof(float));
 
-    if (!is_data && !is_data_display) {
-      IMB_colormanagement_transform(
-          linear_buffer, width, height, channels, from_colorspace, to_colorspace, predivide);
+    if (linear_processor) {
+      IMB_colormanagement_processor_apply(
+          linear_processor, linear_buffer, width, height, channels, predivide);
     }
 
     *is_straight_alpha = false;
@@ -1698,11 +1714,29 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
     init_data.float_colorspace = NULL;
   }
 
+  /* Create the conversion to scene linear once, instead of for every slice. */
+  init_data.linear_processor = NULL;
+  if (cm_processor && !cm_processor->is_data_result &&
+      (ibuf->colormanage_flag & IMB_COLORMANAGE_IS_DATA) == 0) {
+    const char *from_colorspace = (buffer == NULL) ? init_data.byte_colorspace :
+                                                     init_data.float_colorspace;
+
+    if (from_colorspace && from_colorspace[0] != '\0' &&
+        !STREQ(from_colorspace, global_role_scene_linear)) {
+      init_data.linear_processor = IMB_colormanagement_colorspace_processor_new(
+          from_colorspace, global_role_scene_linear);
+    }
+  }
+
   IMB_processor_apply_threaded(ibuf->y,
                                sizeof(DisplayBufferThread),
                                &init_data,
                                display_buffer_init_handle,
                                do_display_buffer_apply_thread);
+
+  if (init_data.linear_processor) {
+    IMB_colormanagement_processor_free(init_data.linear_processor);
+  }
 }
 
 static bool is_ibuf_rect_in_display_space(ImBuf *ibuf,
@@ -1727,12 +1761,53 @@ static bool is_ibuf_rect_in_display_space(ImBuf *ibuf,
   return false;
 }
 
+/* Get display processor for the given settings, re-using the one of the previous display buffer
+ * when settings did not change. Must be called with LOCK_COLORMANAGE held, the processor is owned
+ * by the cache and must not be freed. */
+static ColormanageProcessor *display_buffer_processor_get_cached(
+    const ColorManagedViewSettings *view_settings,
+    const ColorManagedDisplaySettings *display_settings)
+{
+  struct global_display_buffer_state *state = &global_display_buffer_state;
+  CurveMapping *curve_mapping = (view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) ?
+                                    view_settings->curve_mapping :
+                                    NULL;
+
+  if (state->cm_processor && state->exposure == view_settings->exposure &&
+      state->gamma == view_settings->gamma && STREQ(state->look, view_settings->look) &&
+      STREQ(state->view, view_settings->view_transform) &&
+      STREQ(state->display, display_settings->display_device) &&
+      state->orig_curve_mapping == curve_mapping &&
+      (curve_mapping == NULL ||
+       state->curve_mapping_timestamp == curve_mapping->changed_timestamp)) {
+    return state->cm_processor;
+  }
+
+  if (state->cm_processor) {
+    IMB_colormanagement_processor_free(state->cm_processor);
+  }
+
+  state->cm_processor = IMB_colormanagement_display_processor_new(view_settings,
+                                                                  display_settings);
+
+  BLI_strncpy(state->look, view_settings->look, MAX_COLORSPACE_NAME);
+  BLI_strncpy(state->view, view_settings->view_transform, MAX_COLORSPACE_NAME);
+  BLI_strncpy(state->display, display_settings->display_device, MAX_COLORSPACE_NAME);
+  state->exposure = view_settings->exposure;
+  state->gamma = view_settings->gamma;
+  state->orig_curve_mapping = curve_mapping;
+  state->curve_mapping_timestamp = curve_mapping ? curve_mapping->changed_timestamp : 0;
+
+  return state->cm_processor;
+}
+
 static void colormanage_display_buffer_process_ex(
     ImBuf *ibuf,
     float *display_buffer,
     unsigned char *display_buffer_byte,
     const ColorManagedViewSettings *view_settings,
-    const ColorManagedDisplaySettings *display_settings)
+    const ColorManagedDisplaySettings *display_settings,
+    bool use_cached_processor)
 {
   ColormanageProcessor *cm_processor = NULL;
   bool skip_transform = false;
@@ -1747,7 +1822,12 @@ static void colormanage_display_buffer_process_ex(
   }
 
   if (skip_transform == false) {
-    cm_processor = IMB_colormanagement_display_processor_new(view_settings, display_settings);
+    if (use_cached_processor) {
+      cm_processor = display_buffer_processor_get_cached(view_settings, display_settings);
+    }
+    else {
+      cm_processor = IMB_colormanagement_display_processor_new(view_settings, display_settings);
+    }
   }
 
   display_buffer_apply_threaded(ibuf,
@@ -1757,18 +1837,19 @@ static void colormanage_display_buffer_process_ex(
                                 display_buffer_byte,
                                 cm_processor);
 
-  if (cm_processor) {
+  if (cm_processor && !use_cached_processor) {
     IMB_colormanagement_processor_free(cm_processor);
   }
 }
 
+/* Must be called with LOCK_COLORMANAGE held. */
 static void colormanage_display_buffer_process(ImBuf *ibuf,
                                                unsigned char *display_buffer,
                                                const ColorManagedViewSettings *view_settings,
                                                const ColorManagedDisplaySettings *display_settings)
 {
   colormanage_display_buffer_process_ex(
-      ibuf, NULL, display_buffer, view_settings, display_settings);
+      ibuf, NULL, display_buffer, view_settings, display_settings, true);
 }
 
 /*********************** Threaded processor transform routines *************************/
@@ -2429,8 +2510,12 @@ static void colormanagement_imbuf_make_display_space(
     imb_addrectImBuf(ibuf);
   }
 
-  colormanage_display_buffer_process_ex(
-      ibuf, ibuf->rect_float, (unsigned char *)ibuf->rect, view_settings, display_settings);
+  colormanage_display_buffer_process_ex(ibuf,
+                                        ibuf->rect_float,
+                                        (unsigned char *)ibuf->rect,
+                                        view_settings,
+                                        display_settings,
+                                        false);
 }
 
 void IMB_colormanagement_imbuf_make_display_space(
@@ -38,6 +38,7 @@
 #include "IMB_imbuf.h"
 #include "IMB_metadata.h"
 #include "IMB_filetype.h"
+#include "IMB_thumbs.h"
 #include "jpeglib.h"
 #include "jerror.h"
 
@@ -264,6 +265,7 @@ static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int fla
   JSAMPLE *buffer = NULL;
   int row_stride;
   int x, y, depth, r, g, b, k;
+  int scale_denom = 1;
   struct ImBuf *ibuf = NULL;
   uchar *rect;
   jpeg_saved_marker_ptr marker;
@@ -284,8 +286,24 @@ static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int fla
       cinfo->out_color_space = JCS_CMYK;
     }
 
+    if ((flags & IB_thumbnail) && !(flags & IB_test)) {
+      /* Let the decoder scale down (by up to 8) while the image stays larger than the largest
+       * thumbnail, decoding at full resolution only to scale down afterwards is wasted. */
+      const int thumb_size = PREVIEW_RENDER_DEFAULT_HEIGHT * 2;
+      while (scale_denom < 8 && MAX2(x, y) / (scale_denom * 2) >= thumb_size) {
+        scale_denom *= 2;
+      }
+      cinfo->scale_num = 1;
+      cinfo->scale_denom = scale_denom;
+    }
+
     jpeg_start_decompress(cinfo);
 
+    if (scale_denom != 1) {
+      x = cinfo->output_width;
+      y = cinfo->output_height;
+    }
+
     if (flags & IB_test) {
       jpeg_abort_decompress(cinfo);
       ibuf = IMB_allocImBuf(x, y, 8 * depth, 0);
@@ -294,6 +312,17 @@ static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int fla
       jpeg_abort_decompress(cinfo);
     }
     else {
+      if (scale_denom != 1 && (flags & IB_metadata)) {
+        /* The thumbnail keeps the resolution of the file. */
+        char size_str[16];
+
+        IMB_metadata_ensure(&ibuf->metadata);
+        BLI_snprintf(size_str, sizeof(size_str), "%u", (uint)cinfo->image_width);
+        IMB_metadata_set_field(ibuf->metadata, "Thumb::Image::Width", size_str);
+        BLI_snprintf(size_str, sizeof(size_str), "%u", (uint)cinfo->image_height);
+        IMB_metadata_set_field(ibuf->metadata, "Thumb::Image::Height", size_str);
+      }
+
       row_stride = cinfo->output_width * depth;
 
       row_pointer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo, JPOOL_IMAGE, row_stride, 1);
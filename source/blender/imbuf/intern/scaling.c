@@ -906,54 +906,43 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+/* Scaling passes run over independent lines (rows for x, columns for y) in threads. */
+typedef struct ScaleLinesData {
+  ImBuf *ibuf;
+  uchar *newrect;
+  float *newrectf;
+  /* New size along the scaled axis. */
+  int newsize;
+  float add;
+} ScaleLinesData;
+
+static void scaledownx_lines(void *data_v, int start_line, int num_lines)
 {
-  const int do_rect = (ibuf->rect != NULL);
-  const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
+  const ScaleLinesData *data = data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int newx = data->newsize;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+
+  uchar *rect = NULL, *newrect = NULL;
+  float *rectf = NULL, *newrectf = NULL;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
   int x, y;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
   nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
   nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
 
-  if (!do_rect && !do_float) {
-    return (ibuf);
-  }
-
-  if (do_rect) {
-    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(uchar) * 4, "scaledownx");
-    if (_newrect == NULL) {
-      return (ibuf);
+  for (y = start_line; y < start_line + num_lines; y++) {
+    if (do_rect) {
+      rect = (uchar *)ibuf->rect + (size_t)4 * ibuf->x * y;
+      newrect = data->newrect + (size_t)4 * newx * y;
     }
-  }
-  if (do_float) {
-    _newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaledownxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return (ibuf);
+    if (do_float) {
+      rectf = ibuf->rect_float + (size_t)4 * ibuf->x * y;
+      newrectf = data->newrectf + (size_t)4 * newx * y;
     }
-  }
-
-  add = (ibuf->x - 0.01) / newx;
-
-  if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
-  }
-  if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
-  }
 
-  for (y = ibuf->y; y > 0; y--) {
     sample = 0.0f;
     val[0] = val[1] = val[2] = val[3] = 0.0f;
     valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
@@ -1025,56 +1014,33 @@ static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
 
       sample -= 1.0f;
     }
-  }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug [#26502] */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug [#26502] */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
+    /* see bug [#26502] */
+    BLI_assert(!do_rect || (rect - (uchar *)ibuf->rect) == (size_t)4 * ibuf->x * (y + 1));
+    BLI_assert(!do_float || (rectf - ibuf->rect_float) == (size_t)4 * ibuf->x * (y + 1));
   }
-  (void)rect_size; /* UNUSED in release builds */
-
-  ibuf->x = newx;
-  return (ibuf);
 }
 
-static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
 {
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
 
   if (!do_rect && !do_float) {
     return (ibuf);
   }
 
   if (do_rect) {
-    _newrect = MEM_mallocN(newy * ibuf->x * sizeof(uchar) * 4, "scaledowny");
+    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(uchar) * 4, "scaledownx");
     if (_newrect == NULL) {
       return (ibuf);
     }
   }
   if (do_float) {
-    _newrectf = MEM_mallocN(newy * ibuf->x * sizeof(float) * 4, "scaledownyf");
+    _newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaledownxf");
     if (_newrectf == NULL) {
       if (_newrect) {
         MEM_freeN(_newrect);
@@ -1083,17 +1049,50 @@ static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
     }
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
+  ScaleLinesData data = {ibuf, _newrect, _newrectf, newx, (ibuf->x - 0.01) / newx};
+  IMB_processor_apply_threaded_scanlines(ibuf->y, scaledownx_lines, &data);
+
+  if (do_rect) {
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (unsigned int *)_newrect;
+  }
+  if (do_float) {
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = _newrectf;
+  }
+
+  ibuf->x = newx;
+  return (ibuf);
+}
+
+static void scaledowny_lines(void *data_v, int start_column, int num_columns)
+{
+  const ScaleLinesData *data = data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int newy = data->newsize;
+  const float add = data->add;
+  const int skipx = 4 * ibuf->x;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+
+  uchar *rect = NULL, *newrect = NULL;
+  float *rectf = NULL, *newrectf = NULL;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
+  int x, y;
 
-  for (x = skipx - 4; x >= 0; x -= 4) {
+  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
+  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+
+  for (x = 4 * start_column; x < 4 * (start_column + num_columns); x += 4) {
     if (do_rect) {
       rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
+      newrect = data->newrect + x;
     }
     if (do_float) {
       rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
+      newrectf = data->newrectf + x;
     }
 
     sample = 0.0f;
@@ -1167,33 +1166,71 @@ static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
 
       sample -= 1.0f;
     }
+
+    /* see bug [#26502] */
+    BLI_assert(!do_rect || (rect - (uchar *)ibuf->rect) == (size_t)skipx * ibuf->y + x);
+    BLI_assert(!do_float || (rectf - ibuf->rect_float) == (size_t)skipx * ibuf->y + x);
+  }
+}
+
+static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+{
+  const int do_rect = (ibuf->rect != NULL);
+  const int do_float = (ibuf->rect_float != NULL);
+
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
+
+  if (!do_rect && !do_float) {
+    return (ibuf);
+  }
+
+  if (do_rect) {
+    _newrect = MEM_mallocN(newy * ibuf->x * sizeof(uchar) * 4, "scaledowny");
+    if (_newrect == NULL) {
+      return (ibuf);
+    }
+  }
+  if (do_float) {
+    _newrectf = MEM_mallocN(newy * ibuf->x * sizeof(float) * 4, "scaledownyf");
+    if (_newrectf == NULL) {
+      if (_newrect) {
+        MEM_freeN(_newrect);
+      }
+      return (ibuf);
+    }
   }
 
+  ScaleLinesData data = {ibuf, _newrect, _newrectf, newy, (ibuf->y - 0.01) / newy};
+  IMB_processor_apply_threaded_scanlines(ibuf->x, scaledowny_lines, &data);
+
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug [#26502] */
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
     ibuf->rect = (unsigned int *)_newrect;
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug [#26502] */
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
     ibuf->rect_float = (float *)_newrectf;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
   ibuf->y = newy;
   return (ibuf);
 }
 
-static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
+static void scaleupx_lines(void *data_v, int start_line, int num_lines)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  float sample, add;
+  const ScaleLinesData *data = data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int newx = data->newsize;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+
+  uchar *rect = NULL, *newrect = NULL;
+  float *rectf = NULL, *newrectf = NULL;
+  float sample;
   float val_a, nval_a, diff_a;
   float val_b, nval_b, diff_b;
   float val_g, nval_g, diff_g;
@@ -1203,45 +1240,21 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
   float val_gf, nval_gf, diff_gf;
   float val_rf, nval_rf, diff_rf;
   int x, y;
-  bool do_rect = false, do_float = false;
 
   val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
   val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
   val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
   val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-  if (ibuf == NULL) {
-    return (NULL);
-  }
-  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
-    return (ibuf);
-  }
 
-  if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(int), "scaleupx");
-    if (_newrect == NULL) {
-      return (ibuf);
+  for (y = start_line; y < start_line + num_lines; y++) {
+    if (do_rect) {
+      rect = (uchar *)ibuf->rect + (size_t)4 * ibuf->x * y;
+      newrect = data->newrect + (size_t)4 * newx * y;
     }
-  }
-  if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaleupxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return (ibuf);
+    if (do_float) {
+      rectf = ibuf->rect_float + (size_t)4 * ibuf->x * y;
+      newrectf = data->newrectf + (size_t)4 * newx * y;
     }
-  }
-
-  add = (ibuf->x - 1.001) / (newx - 1.0);
-
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
-  for (y = ibuf->y; y > 0; y--) {
 
     sample = 0;
 
@@ -1349,6 +1362,41 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
       sample += add;
     }
   }
+}
+
+static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
+{
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
+  bool do_rect = false, do_float = false;
+
+  if (ibuf == NULL) {
+    return (NULL);
+  }
+  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
+    return (ibuf);
+  }
+
+  if (ibuf->rect) {
+    do_rect = true;
+    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(int), "scaleupx");
+    if (_newrect == NULL) {
+      return (ibuf);
+    }
+  }
+  if (ibuf->rect_float) {
+    do_float = true;
+    _newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaleupxf");
+    if (_newrectf == NULL) {
+      if (_newrect) {
+        MEM_freeN(_newrect);
+      }
+      return (ibuf);
+    }
+  }
+
+  ScaleLinesData data = {ibuf, _newrect, _newrectf, newx, (ibuf->x - 1.001) / (newx - 1.0)};
+  IMB_processor_apply_threaded_scanlines(ibuf->y, scaleupx_lines, &data);
 
   if (do_rect) {
     imb_freerectImBuf(ibuf);
@@ -1365,11 +1413,19 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
   return (ibuf);
 }
 
-static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
+static void scaleupy_lines(void *data_v, int start_column, int num_columns)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  float sample, add;
+  const ScaleLinesData *data = data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int newy = data->newsize;
+  const float add = data->add;
+  const int skipx = 4 * ibuf->x;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+
+  uchar *rect = NULL, *newrect = NULL;
+  float *rectf = NULL, *newrectf = NULL;
+  float sample;
   float val_a, nval_a, diff_a;
   float val_b, nval_b, diff_b;
   float val_g, nval_g, diff_g;
@@ -1378,52 +1434,19 @@ static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
   float val_bf, nval_bf, diff_bf;
   float val_gf, nval_gf, diff_gf;
   float val_rf, nval_rf, diff_rf;
-  int x, y, skipx;
-  bool do_rect = false, do_float = false;
+  int x, y;
 
   val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
   val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
   val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
   val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-  if (ibuf == NULL) {
-    return (NULL);
-  }
-  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
-    return (ibuf);
-  }
-
-  if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(ibuf->x * newy * sizeof(int), "scaleupy");
-    if (_newrect == NULL) {
-      return (ibuf);
-    }
-  }
-  if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(ibuf->x * newy * sizeof(float) * 4, "scaleupyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return (ibuf);
-    }
-  }
-
-  add = (ibuf->y - 1.001) / (newy - 1.0);
-  skipx = 4 * ibuf->x;
 
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
-  for (x = ibuf->x; x > 0; x--) {
+  for (x = start_column + 1; x <= start_column + num_columns; x++) {
 
     sample = 0;
     if (do_rect) {
       rect = ((uchar *)ibuf->rect) + 4 * (x - 1);
-      newrect = _newrect + 4 * (x - 1);
+      newrect = data->newrect + 4 * (x - 1);
 
       val_a = rect[0];
       nval_a = rect[skipx];
@@ -1449,7 +1472,7 @@ static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
     }
     if (do_float) {
       rectf = ibuf->rect_float + 4 * (x - 1);
-      newrectf = _newrectf + 4 * (x - 1);
+      newrectf = data->newrectf + 4 * (x - 1);
 
       val_af = rectf[0];
       nval_af = rectf[skipx];
@@ -1532,6 +1555,41 @@ static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
       sample += add;
     }
   }
+}
+
+static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
+{
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
+  bool do_rect = false, do_float = false;
+
+  if (ibuf == NULL) {
+    return (NULL);
+  }
+  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
+    return (ibuf);
+  }
+
+  if (ibuf->rect) {
+    do_rect = true;
+    _newrect = MEM_mallocN(ibuf->x * newy * sizeof(int), "scaleupy");
+    if (_newrect == NULL) {
+      return (ibuf);
+    }
+  }
+  if (ibuf->rect_float) {
+    do_float = true;
+    _newrectf = MEM_mallocN(ibuf->x * newy * sizeof(float) * 4, "scaleupyf");
+    if (_newrectf == NULL) {
+      if (_newrect) {
+        MEM_freeN(_newrect);
+      }
+      return (ibuf);
+    }
+  }
+
+  ScaleLinesData data = {ibuf, _newrect, _newrectf, newy, (ibuf->y - 1.001) / (newy - 1.0)};
+  IMB_processor_apply_threaded_scanlines(ibuf->x, scaleupy_lines, &data);
 
   if (do_rect) {
     imb_freerectImBuf(ibuf);
@@ -471,7 +471,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
         if (img == NULL) {
           switch (source) {
             case THB_SOURCE_IMAGE:
-              img = IMB_loadiffname(file_path, IB_rect | IB_metadata, NULL);
+              img = IMB_loadiffname(file_path, IB_rect | IB_metadata | IB_thumbnail, NULL);
               break;
             case THB_SOURCE_BLEND:
               img = IMB_thumb_load_blend(file_path, blen_group, blen_id);
@@ -488,8 +488,15 @@ static ImBuf *thumb_create_ex(const char *file_path,
           if (BLI_stat(file_path, &info) != -1) {
             BLI_snprintf(mtime, sizeof(mtime), "%ld", (long int)info.st_mtime);
           }
-          BLI_snprintf(cwidth, sizeof(cwidth), "%d", img->x);
-          BLI_snprintf(cheight, sizeof(cheight), "%d", img->y);
+          /* Loaders decoding at reduced size for thumbnails store the size of the file. */
+          if (!img->metadata ||
+              !IMB_metadata_get_field(
+                  img->metadata, "Thumb::Image::Width", cwidth, sizeof(cwidth)) ||
+              !IMB_metadata_get_field(
+                  img->metadata, "Thumb::Image::Height", cheight, sizeof(cheight))) {
+            BLI_snprintf(cwidth, sizeof(cwidth), "%d", img->x);
+            BLI_snprintf(cheight, sizeof(cheight), "%d", img->y);
+          }
         }
       }
       else if (THB_SOURCE_MOVIE == source) {
@@ -558,6 +558,10 @@ enum {
   /* Datablock was not allocated by standard system (BKE_libblock_alloc), do not free its memory
    * (usual type-specific freeing is called though). */
   LIB_TAG_NOT_ALLOCATED = 1 << 18,
+
+  /* RESET_AFTER_USE Used by undo to mark data-blocks which are kept as is from the old main,
+   * instead of being read again. */
+  LIB_TAG_UNDO_OLD_ID_REUSED = 1 << 19,
 };
 
 /* Tag given ID for an update in all the dependency graphs. */
@@ -644,6 +648,13 @@ typedef enum IDRecalcFlag {
    * input file or for color space changes. */
   ID_RECALC_SOURCE = (1 << 23),
 
+  /* ** Only vertex positions of the edit mode mesh changed. **
+   *
+   * Used by transform in mesh edit mode. Unlike ID_RECALC_GEOMETRY the copy-on-write component
+   * is not tagged: the edit mesh is shared with the original and the topology did not change, so
+   * the draw cache only needs to update the buffers which depend on vertex positions. */
+  ID_RECALC_GEOMETRY_DEFORM = (1 << 24),
+
   /***************************************************************************
    * Pseudonyms, to have more semantic meaning in the actual code without
    * using too much low-level and implementation specific tags. */
@@ -591,7 +591,8 @@ typedef struct FCurve {
   /* value cache + settings */
   /** Value stored from last time curve was evaluated (not threadsafe, debug display only!). */
   float curval;
-  char _pad2[4];
+  /** Runtime: keyframe ending the segment found by the last evaluation, a lookup hint only. */
+  int segment_hint;
   /** User-editable settings for this curve. */
   short flag;
   /** Value-extending mode for this curve (does not cover). */
@@ -1079,6 +1080,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime data, resolved RNA paths of animated F-Curves, see #BKE_animsys_eval_animdata. */
+  struct GHash *rna_path_cache;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
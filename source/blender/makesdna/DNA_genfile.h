@@ -94,12 +94,23 @@ int DNA_struct_find_nr_ex(const struct SDNA *sdna, const char *str, unsigned int
 int DNA_struct_find_nr(const struct SDNA *sdna, const char *str);
 void DNA_struct_switch_endian(const struct SDNA *oldsdna, int oldSDNAnr, char *data);
 const char *DNA_struct_get_compareflags(const struct SDNA *sdna, const struct SDNA *newsdna);
-void *DNA_struct_reconstruct(const struct SDNA *newsdna,
-                             const struct SDNA *oldsdna,
-                             const char *compflags,
+
+/** Precomputed conversion of the structs of one SDNA to another, see #DNA_struct_reconstruct. */
+typedef struct DNA_ReconstructInfo DNA_ReconstructInfo;
+
+struct DNA_ReconstructInfo *DNA_reconstruct_info_create(const struct SDNA *oldsdna,
+                                                        const struct SDNA *newsdna,
+                                                        const char *compflags,
+                                                        const bool do_endian_swap);
+void DNA_reconstruct_info_free(struct DNA_ReconstructInfo *info);
+void *DNA_struct_reconstruct(const struct DNA_ReconstructInfo *info,
                              int oldSDNAnr,
                              int blocks,
                              const void *data);
+void DNA_struct_switch_endian_blocks(const struct DNA_ReconstructInfo *info,
+                                     int oldSDNAnr,
+                                     int blocks,
+                                     char *data);
 
 int DNA_elem_offset(struct SDNA *sdna, const char *stype, const char *vartype, const char *name);
 
@@ -192,6 +192,8 @@ enum {
   LIGHTCACHE_UPDATE_GRID = (1 << 5),
   LIGHTCACHE_UPDATE_WORLD = (1 << 6),
   LIGHTCACHE_UPDATE_AUTO = (1 << 7),
+  /** Re-render all tagged probes, even the ones whose data did not change. */
+  LIGHTCACHE_UPDATE_FULL = (1 << 8),
 };
 
 /* EEVEE_LightCacheTexture->data_type */
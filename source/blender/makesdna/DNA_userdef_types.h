@@ -716,10 +716,12 @@ typedef struct UserDef {
   short gp_manhattendist, gp_euclideandist, gp_eraser;
   /** #eGP_UserdefSettings. */
   short gp_settings;
-  char _pad13[4];
+  /** Graphics memory limit for image textures (in megabytes). */
+  int texture_memory_limit;
   struct SolidLight light_param[4];
   float light_ambient[3];
-  char _pad3[4];
+  /** Compositor result cache limit (in megabytes). */
+  int compositor_cache_limit;
   short gizmo_flag, gizmo_size;
   short edit_studio_light;
   short lookdev_sphere_size;
@@ -729,7 +731,8 @@ typedef struct UserDef {
   int prefetchframes;
   /** Control the rotation step of the view when PAD2, PAD4, PAD6&PAD8 is use. */
   float pad_rot_angle;
-  char _pad12[4];
+  /** Modifier stack result cache limit (in megabytes). */
+  int modifier_cache_limit;
   /** Rotating view icon size. */
   short rvisize;
   /** Rotating view icon brightness. */
@@ -853,7 +856,15 @@ typedef struct UserDef {
 
   char render_display_type;      /* eUserpref_RenderDisplayType */
   char filebrowser_display_type; /* eUserpref_TempSpaceDisplayType */
-  char _pad5[4];
+  /** #eUserpref_SeqDiskCacheCompression. */
+  char sequencer_disk_cache_compression;
+  char _pad5[3];
+
+  /** Sequencer disk cache size limit (in gigabytes). */
+  int sequencer_disk_cache_size_limit;
+  /** Sequencer disk cache directory, uses the temporary directory when empty. 1024 = FILE_MAX. */
+  char sequencer_disk_cache_dir[1024];
+  char _pad6[4];
 
   struct WalkNavigation walk_navigation;
 
@@ -1038,6 +1049,9 @@ typedef enum eUserpref_GPU_Flag {
   USER_GPU_FLAG_NO_DEPT_PICK = (1 << 0),
   USER_GPU_FLAG_NO_EDIT_MODE_SMOOTH_WIRE = (1 << 1),
   USER_GPU_FLAG_OVERLAY_SMOOTH_WIRE = (1 << 2),
+  USER_GPU_FLAG_COMPACT_VERTEX_DATA = (1 << 3),
+  USER_GPU_FLAG_NO_SHADER_CACHE = (1 << 4),
+  USER_GPU_FLAG_VIEWPORT_LOD = (1 << 5),
 } eUserpref_GPU_Flag;
 
 /** #UserDef.tablet_api */
@@ -1279,6 +1293,12 @@ typedef enum eUserpref_TempSpaceDisplayType {
   USER_TEMP_SPACE_DISPLAY_WINDOW,
 } eUserpref_TempSpaceDisplayType;
 
+typedef enum eUserpref_SeqDiskCacheCompression {
+  USER_SEQ_DISK_CACHE_COMPRESSION_NONE = 0,
+  USER_SEQ_DISK_CACHE_COMPRESSION_LOW = 1,
+  USER_SEQ_DISK_CACHE_COMPRESSION_HIGH = 2,
+} eUserpref_SeqDiskCacheCompression;
+
 typedef enum eUserpref_EmulateMMBMod {
   USER_EMU_MMB_MOD_ALT = 0,
   USER_EMU_MMB_MOD_OSKEY = 1,
@@ -799,24 +799,21 @@ static eSDNA_Type sdna_type_nr(const char *dna_type)
  * Note there is no optimization for the case where otype and ctype are the same:
  * assumption is that caller will handle this case.
  *
- * \param ctype: Name of type to convert to
- * \param otype: Name of type to convert from
+ * \param ctypenr: Type to convert to
+ * \param otypenr: Type to convert from
  * \param name_array_len: Result of #DNA_elem_array_size for this element.
  * \param curdata: Where to put converted data
  * \param olddata: Data of type otype to convert
  */
-static void cast_elem(
-    const char *ctype, const char *otype, int name_array_len, char *curdata, const char *olddata)
+static void cast_elem(const eSDNA_Type ctypenr,
+                      const eSDNA_Type otypenr,
+                      int name_array_len,
+                      char *curdata,
+                      const char *olddata)
 {
   double val = 0.0;
   int curlen = 1, oldlen = 1;
 
-  eSDNA_Type ctypenr, otypenr;
-
-  if ((otypenr = sdna_type_nr(otype)) == -1 || (ctypenr = sdna_type_nr(ctype)) == -1) {
-    return;
-  }
-
   /* define lengths */
   oldlen = DNA_elem_type_size(otypenr);
   curlen = DNA_elem_type_size(ctypenr);
@@ -850,6 +847,8 @@ static void cast_elem(
       case SDNA_TYPE_UINT64:
         val = *((uint64_t *)olddata);
         break;
+      default:
+        break;
     }
 
     switch (ctypenr) {
@@ -886,6 +885,8 @@ static void cast_elem(
       case SDNA_TYPE_UINT64:
         *((uint64_t *)curdata) = val;
         break;
+      default:
+        break;
     }
 
     olddata += oldlen;
@@ -1077,25 +1078,175 @@ static const char *find_elem(const SDNA *sdna,
   return NULL;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Struct Reconstruction Plans
+ *
+ * Converting a struct from the file SDNA to the current SDNA only depends on the pair
+ * of struct definitions, so the member lookups are done once per file, creating a flat list of
+ * steps for every struct that differs. Nested structs are expanded in place and neighboring
+ * steps are merged, so reading a block only runs a few memory copies and casts per element.
+ * \{ */
+
+typedef enum eReconstructStepType {
+  /** Copy bytes unchanged. */
+  RECONSTRUCT_STEP_MEMCPY = 0,
+  /** Convert an array of one primitive type into another. */
+  RECONSTRUCT_STEP_CAST_PRIMITIVE = 1,
+  /** Convert an array of pointers saved with a different pointer size. */
+  RECONSTRUCT_STEP_CAST_POINTER = 2,
+  /** Null-terminate a string which was truncated. */
+  RECONSTRUCT_STEP_STRING_TERMINATE = 3,
+} eReconstructStepType;
+
+typedef struct ReconstructStep {
+  /** #eReconstructStepType. */
+  char type;
+  /** #eSDNA_Type, only for #RECONSTRUCT_STEP_CAST_PRIMITIVE. */
+  char old_type, new_type;
+  char _pad[1];
+  int old_offset;
+  int new_offset;
+  /** Number of bytes for #RECONSTRUCT_STEP_MEMCPY, number of array elements for casts. */
+  int len;
+} ReconstructStep;
+
+typedef struct EndianSwapStep {
+  int offset;
+  /** Number of consecutive values. */
+  int len;
+  /** Size of each value in bytes: 2, 4 or 8. */
+  int size;
+} EndianSwapStep;
+
+struct DNA_ReconstructInfo {
+  const SDNA *oldsdna;
+  const SDNA *newsdna;
+  const char *compflags;
+
+  /** Per struct in `oldsdna`, the size of the struct in `newsdna` (zero when removed). */
+  int *new_struct_size;
+  /** Per struct in `oldsdna`, the steps to convert it (only for #SDNA_CMP_NOT_EQUAL). */
+  ReconstructStep **steps;
+  int *steps_len;
+
+  /** Per struct in `oldsdna`, the values to swap (only when the endian differs). */
+  EndianSwapStep **endian_steps;
+  int *endian_steps_len;
+};
+
+/** Growing array of steps, used while creating the plan of a single struct. */
+typedef struct StepBuilder {
+  void *steps;
+  int steps_len;
+  int steps_len_alloc;
+} StepBuilder;
+
+static void *step_builder_append(StepBuilder *builder, const size_t step_size)
+{
+  if (builder->steps_len == builder->steps_len_alloc) {
+    builder->steps_len_alloc = builder->steps_len_alloc ? builder->steps_len_alloc * 2 : 16;
+    builder->steps = MEM_reallocN(builder->steps, step_size * (size_t)builder->steps_len_alloc);
+  }
+  return (char *)builder->steps + (step_size * (size_t)builder->steps_len++);
+}
+
 /**
- * Converts the contents of a single field of a struct, of a non-struct type,
+ * Add a step, extending the previous one instead when it continues it in both structs.
+ */
+static void reconstruct_step_add(const DNA_ReconstructInfo *info,
+                                 StepBuilder *builder,
+                                 const eReconstructStepType type,
+                                 const int old_offset,
+                                 const int new_offset,
+                                 const int len,
+                                 const eSDNA_Type old_type,
+                                 const eSDNA_Type new_type)
+{
+  if (builder->steps_len != 0) {
+    ReconstructStep *step_prev = &((ReconstructStep *)builder->steps)[builder->steps_len - 1];
+    if (step_prev->type == type) {
+      int old_elem_size = 0, new_elem_size = 0;
+      switch (type) {
+        case RECONSTRUCT_STEP_MEMCPY:
+          old_elem_size = new_elem_size = 1;
+          break;
+        case RECONSTRUCT_STEP_CAST_PRIMITIVE:
+          if (step_prev->old_type == old_type && step_prev->new_type == new_type) {
+            old_elem_size = DNA_elem_type_size(old_type);
+            new_elem_size = DNA_elem_type_size(new_type);
+          }
+          break;
+        case RECONSTRUCT_STEP_CAST_POINTER:
+          old_elem_size = info->oldsdna->pointer_size;
+          new_elem_size = info->newsdna->pointer_size;
+          break;
+        case RECONSTRUCT_STEP_STRING_TERMINATE:
+          break;
+      }
+      if (old_elem_size != 0 &&
+          step_prev->old_offset + (step_prev->len * old_elem_size) == old_offset &&
+          step_prev->new_offset + (step_prev->len * new_elem_size) == new_offset) {
+        step_prev->len += len;
+        return;
+      }
+    }
+  }
+
+  ReconstructStep *step = step_builder_append(builder, sizeof(*step));
+  step->type = type;
+  step->old_type = old_type;
+  step->new_type = new_type;
+  step->old_offset = old_offset;
+  step->new_offset = new_offset;
+  step->len = len;
+}
+
+/**
+ * Same as #find_elem, returning the offset of the field within the struct or -1 when
+ * no such field can be found.
+ */
+static int find_elem_offset(const SDNA *sdna,
+                            const char *type,
+                            const char *name,
+                            const short *old,
+                            const short **sppo)
+{
+  int a, elemcount, offset = 0;
+
+  elemcount = old[1];
+  old += 2;
+  for (a = 0; a < elemcount; a++, old += 2) {
+    if (elem_strcmp(name, sdna->names[old[1]]) == 0) { /* name equal */
+      if (strcmp(type, sdna->types[old[0]]) == 0) {    /* type equal */
+        if (sppo) {
+          *sppo = old;
+        }
+        return offset;
+      }
+      return -1;
+    }
+    offset += DNA_elem_size_nr(sdna, old[0], old[1]);
+  }
+  return -1;
+}
+
+/**
+ * Adds the steps converting a single field of a struct, of a non-struct type,
  * from oldsdna to newsdna format.
  *
- * \param newsdna: SDNA of current Blender
- * \param oldsdna: SDNA of Blender that saved file
- * \param type: current field type name
- * \param new_name_nr: current field name number.
- * \param curdata: put field data converted to newsdna here
- * \param old: pointer to struct info in oldsdna
- * \param olddata: struct contents laid out according to oldsdna
+ * \param new_type_nr: Current field type number.
+ * \param new_name_nr: Current field name number.
+ * \param new_offset: Offset of the field in the current struct.
+ * \param old: Pointer to struct info in oldsdna.
+ * \param old_offset: Offset of the old struct.
  */
-static void reconstruct_elem(const SDNA *newsdna,
-                             const SDNA *oldsdna,
-                             const char *type,
-                             const int new_name_nr,
-                             char *curdata,
-                             const short *old,
-                             const char *olddata)
+static void reconstruct_elem_build(const DNA_ReconstructInfo *info,
+                                   StepBuilder *builder,
+                                   const int new_type_nr,
+                                   const int new_name_nr,
+                                   const int new_offset,
+                                   const short *old,
+                                   int old_offset)
 {
   /* rules: test for NAME:
    *      - name equal:
@@ -1106,10 +1257,13 @@ static void reconstruct_elem(const SDNA *newsdna,
    * (nzc 2-4-2001 I want the 'unsigned' bit to be parsed as well. Where
    * can I force this?)
    */
+  const SDNA *newsdna = info->newsdna;
+  const SDNA *oldsdna = info->oldsdna;
   int a, elemcount, len, countpos, mul;
   const char *otype, *oname, *cp;
 
   /* is 'name' an array? */
+  const char *type = newsdna->types[new_type_nr];
   const char *name = newsdna->names[new_name_nr];
   cp = name;
   countpos = 0;
@@ -1130,90 +1284,112 @@ static void reconstruct_elem(const SDNA *newsdna,
     oname = oldsdna->names[old[1]];
     len = DNA_elem_size_nr(oldsdna, old[0], old[1]);
 
+    int array_len = 0;
     if (strcmp(name, oname) == 0) { /* name equal */
-
-      if (ispointer(name)) { /* pointer of functionpointer afhandelen */
-        cast_pointer(newsdna->pointer_size,
-                     oldsdna->pointer_size,
-                     newsdna->names_array_len[new_name_nr],
-                     curdata,
-                     olddata);
-      }
-      else if (strcmp(type, otype) == 0) { /* type equal */
-        memcpy(curdata, olddata, len);
-      }
-      else {
-        cast_elem(type, otype, newsdna->names_array_len[new_name_nr], curdata, olddata);
-      }
-
-      return;
+      array_len = newsdna->names_array_len[new_name_nr];
+      mul = len;
     }
     else if (countpos != 0) { /* name is an array */
-
       if (oname[countpos] == '[' && strncmp(name, oname, countpos) == 0) { /* basis equal */
         const int new_name_array_len = newsdna->names_array_len[new_name_nr];
         const int old_name_array_len = oldsdna->names_array_len[old_name_nr];
-        const int min_name_array_len = MIN2(new_name_array_len, old_name_array_len);
+        array_len = MIN2(new_name_array_len, old_name_array_len);
 
-        if (ispointer(name)) { /* handle pointer or functionpointer */
-          cast_pointer(
-              newsdna->pointer_size, oldsdna->pointer_size, min_name_array_len, curdata, olddata);
-        }
-        else if (strcmp(type, otype) == 0) { /* type equal */
-          /* size of single old array element */
-          mul = len / old_name_array_len;
-          /* smaller of sizes of old and new arrays */
-          mul *= min_name_array_len;
-
-          memcpy(curdata, olddata, mul);
+        /* size of single old array element, times the smaller of the array sizes */
+        mul = (len / old_name_array_len) * array_len;
 
+        if (!ispointer(name) && strcmp(type, otype) == 0) {
+          reconstruct_step_add(
+              info, builder, RECONSTRUCT_STEP_MEMCPY, old_offset, new_offset, mul, 0, 0);
           if (old_name_array_len > new_name_array_len && strcmp(type, "char") == 0) {
             /* string had to be truncated, ensure it's still null-terminated */
-            curdata[mul - 1] = '\0';
+            reconstruct_step_add(info,
+                                 builder,
+                                 RECONSTRUCT_STEP_STRING_TERMINATE,
+                                 old_offset,
+                                 new_offset + mul - 1,
+                                 1,
+                                 0,
+                                 0);
           }
+          return;
+        }
+      }
+    }
+
+    if (array_len != 0) {
+      if (ispointer(name)) { /* handle pointer or functionpointer */
+        if (newsdna->pointer_size == oldsdna->pointer_size) {
+          reconstruct_step_add(info,
+                               builder,
+                               RECONSTRUCT_STEP_MEMCPY,
+                               old_offset,
+                               new_offset,
+                               array_len * newsdna->pointer_size,
+                               0,
+                               0);
         }
         else {
-          cast_elem(type, otype, min_name_array_len, curdata, olddata);
+          reconstruct_step_add(info,
+                               builder,
+                               RECONSTRUCT_STEP_CAST_POINTER,
+                               old_offset,
+                               new_offset,
+                               array_len,
+                               0,
+                               0);
         }
-        return;
       }
+      else if (strcmp(type, otype) == 0) { /* type equal */
+        reconstruct_step_add(
+            info, builder, RECONSTRUCT_STEP_MEMCPY, old_offset, new_offset, mul, 0, 0);
+      }
+      else {
+        const eSDNA_Type otypenr = sdna_type_nr(otype);
+        const eSDNA_Type ctypenr = sdna_type_nr(type);
+        if (otypenr != -1 && ctypenr != -1) {
+          reconstruct_step_add(info,
+                               builder,
+                               RECONSTRUCT_STEP_CAST_PRIMITIVE,
+                               old_offset,
+                               new_offset,
+                               array_len,
+                               otypenr,
+                               ctypenr);
+        }
+      }
+      return;
     }
-    olddata += len;
+    old_offset += len;
   }
 }
 
 /**
- * Converts the contents of an entire struct from oldsdna to newsdna format.
- *
- * \param newsdna: SDNA of current Blender
- * \param oldsdna: SDNA of Blender that saved file
- * \param compflags:
+ * Adds the steps converting the contents of an entire struct from oldsdna to newsdna format.
  *
- * Result from DNA_struct_get_compareflags to avoid needless conversions.
  * \param oldSDNAnr: Index of old struct definition in oldsdna
- * \param data: Struct contents laid out according to oldsdna
+ * \param old_offset: Offset of the old struct in the data being converted
  * \param curSDNAnr: Index of current struct definition in newsdna
- * \param cur: Where to put converted struct contents
+ * \param new_offset: Offset of the current struct in the data being converted
  */
-static void reconstruct_struct(const SDNA *newsdna,
-                               const SDNA *oldsdna,
-                               const char *compflags,
-
-                               int oldSDNAnr,
-                               const char *data,
-                               int curSDNAnr,
-                               char *cur)
+static void reconstruct_struct_build(const DNA_ReconstructInfo *info,
+                                     StepBuilder *builder,
+                                     int oldSDNAnr,
+                                     const int old_offset,
+                                     int curSDNAnr,
+                                     const int new_offset)
 {
   /* Recursive!
    * Per element from cur_struct, read data from old_struct.
    * If element is a struct, call recursive.
    */
+  const SDNA *newsdna = info->newsdna;
+  const SDNA *oldsdna = info->oldsdna;
   int a, elemcount, elen, eleno, mul, mulo, firststructtypenr;
   const short *spo, *spc, *sppo;
   const char *type;
-  const char *cpo;
-  char *cpc;
   const char *name;
+  int cpo, cpc;
 
   unsigned int oldsdna_index_last = UINT_MAX;
   unsigned int cursdna_index_last = UINT_MAX;
@@ -1225,12 +1401,12 @@ static void reconstruct_struct(const SDNA *newsdna,
     return;
   }
 
-  if (compflags[oldSDNAnr] == SDNA_CMP_EQUAL) {
+  if (info->compflags[oldSDNAnr] == SDNA_CMP_EQUAL) {
     /* if recursive: test for equal */
     spo = oldsdna->structs[oldSDNAnr];
     elen = oldsdna->types_size[spo[0]];
-    memcpy(cur, data, elen);
-
+    reconstruct_step_add(
+        info, builder, RECONSTRUCT_STEP_MEMCPY, old_offset, new_offset, elen, 0, 0);
     return;
   }
 
@@ -1242,7 +1418,7 @@ static void reconstruct_struct(const SDNA *newsdna,
   elemcount = spc[1];
 
   spc += 2;
-  cpc = cur;
+  cpc = new_offset;
   for (a = 0; a < elemcount; a++, spc += 2) { /* convert each field */
     type = newsdna->types[spc[0]];
     name = newsdna->names[spc[1]];
@@ -1259,11 +1435,13 @@ static void reconstruct_struct(const SDNA *newsdna,
       /* struct field type */
 
       /* where does the old struct data start (and is there an old one?) */
-      cpo = (char *)find_elem(oldsdna, type, name, spo, data, &sppo);
+      cpo = find_elem_offset(oldsdna, type, name, spo, &sppo);
 
-      if (cpo) {
-        oldSDNAnr = DNA_struct_find_nr_ex(oldsdna, type, &oldsdna_index_last);
-        curSDNAnr = DNA_struct_find_nr_ex(newsdna, type, &cursdna_index_last);
+      if (cpo != -1) {
+        const int oldSDNAnr_elem = DNA_struct_find_nr_ex(oldsdna, type, &oldsdna_index_last);
+        const int curSDNAnr_elem = DNA_struct_find_nr_ex(newsdna, type, &cursdna_index_last);
+        const int cpc_next = cpc + elen;
+        cpo += old_offset;
 
         /* array! */
         mul = newsdna->names_array_len[spc[1]];
@@ -1274,17 +1452,14 @@ static void reconstruct_struct(const SDNA *newsdna,
         elen /= mul;
         eleno /= mulo;
 
+        /* new struct array may be larger than old */
+        mul = MIN2(mul, mulo);
         while (mul--) {
-          reconstruct_struct(newsdna, oldsdna, compflags, oldSDNAnr, cpo, curSDNAnr, cpc);
+          reconstruct_struct_build(info, builder, oldSDNAnr_elem, cpo, curSDNAnr_elem, cpc);
           cpo += eleno;
           cpc += elen;
-
-          /* new struct array larger than old */
-          mulo--;
-          if (mulo <= 0) {
-            break;
-          }
         }
+        cpc = cpc_next;
       }
       else {
         cpc += elen; /* skip field no longer present */
@@ -1292,12 +1467,48 @@ static void reconstruct_struct(const SDNA *newsdna,
     }
     else {
       /* non-struct field type */
-      reconstruct_elem(newsdna, oldsdna, type, spc[1], cpc, spo, data);
+      reconstruct_elem_build(info, builder, spc[0], spc[1], cpc, spo, old_offset);
       cpc += elen;
     }
   }
 }
 
+/**
+ * Runs the steps from #reconstruct_struct_build on a single struct.
+ */
+static void reconstruct_struct_apply(const DNA_ReconstructInfo *info,
+                                     const ReconstructStep *steps,
+                                     const int steps_len,
+                                     const char *olddata,
+                                     char *curdata)
+{
+  for (int i = 0; i < steps_len; i++) {
+    const ReconstructStep *step = &steps[i];
+    switch ((eReconstructStepType)step->type) {
+      case RECONSTRUCT_STEP_MEMCPY:
+        memcpy(curdata + step->new_offset, olddata + step->old_offset, (size_t)step->len);
+        break;
+      case RECONSTRUCT_STEP_CAST_PRIMITIVE:
+        cast_elem(step->new_type,
+                  step->old_type,
+                  step->len,
+                  curdata + step->new_offset,
+                  olddata + step->old_offset);
+        break;
+      case RECONSTRUCT_STEP_CAST_POINTER:
+        cast_pointer(info->newsdna->pointer_size,
+                     info->oldsdna->pointer_size,
+                     step->len,
+                     curdata + step->new_offset,
+                     olddata + step->old_offset);
+        break;
+      case RECONSTRUCT_STEP_STRING_TERMINATE:
+        curdata[step->new_offset] = '\0';
+        break;
+    }
+  }
+}
+
 /**
  * Does endian swapping on the fields of a struct value.
  *
@@ -1392,49 +1603,256 @@ void DNA_struct_switch_endian(const SDNA *oldsdna, int oldSDNAnr, char *data)
 }
 
 /**
- * \param newsdna: SDNA of current Blender
- * \param oldsdna: SDNA of Blender that saved file
- * \param compflags:
+ * Add an endian swap, extending the previous one when the values follow each other.
+ */
+static void endian_swap_step_add(StepBuilder *builder,
+                                 const int offset,
+                                 const int len,
+                                 const int size)
+{
+  if (builder->steps_len != 0) {
+    EndianSwapStep *step_prev = &((EndianSwapStep *)builder->steps)[builder->steps_len - 1];
+    if (step_prev->size == size && step_prev->offset + (step_prev->len * size) == offset) {
+      step_prev->len += len;
+      return;
+    }
+  }
+
+  EndianSwapStep *step = step_builder_append(builder, sizeof(*step));
+  step->offset = offset;
+  step->len = len;
+  step->size = size;
+}
+
+/**
+ * Adds the endian swaps of a struct, matching #DNA_struct_switch_endian.
  *
- * Result from DNA_struct_get_compareflags to avoid needless conversions
  * \param oldSDNAnr: Index of struct info within oldsdna
+ * \param offset: Offset of the struct in the data being converted
+ */
+static void switch_endian_struct_build(const SDNA *oldsdna,
+                                       StepBuilder *builder,
+                                       int oldSDNAnr,
+                                       const int offset)
+{
+  /* Recursive!
+   * If element is a struct, call recursive.
+   */
+  int a, mul, elemcount, elen, elena, firststructtypenr;
+  const short *spo, *spc;
+  int cur;
+  const char *type, *name;
+  unsigned int oldsdna_index_last = UINT_MAX;
+
+  if (oldSDNAnr == -1) {
+    return;
+  }
+  firststructtypenr = *(oldsdna->structs[0]);
+
+  spo = spc = oldsdna->structs[oldSDNAnr];
+
+  elemcount = spo[1];
+
+  spc += 2;
+  cur = offset;
+
+  for (a = 0; a < elemcount; a++, spc += 2) {
+    type = oldsdna->types[spc[0]];
+    name = oldsdna->names[spc[1]];
+    const int old_name_array_len = oldsdna->names_array_len[spc[1]];
+
+    /* DNA_elem_size_nr = including arraysize */
+    elen = DNA_elem_size_nr(oldsdna, spc[0], spc[1]);
+
+    /* test: is type a struct? */
+    if (spc[0] >= firststructtypenr && !ispointer(name)) {
+      /* struct field type */
+      /* where does the old data start (is there one?) */
+      int cpo = find_elem_offset(oldsdna, type, name, spo, NULL);
+      if (cpo != -1) {
+        const int oldSDNAnr_elem = DNA_struct_find_nr_ex(oldsdna, type, &oldsdna_index_last);
+        cpo += offset;
+
+        mul = old_name_array_len;
+        elena = elen / mul;
+
+        while (mul--) {
+          switch_endian_struct_build(oldsdna, builder, oldSDNAnr_elem, cpo);
+          cpo += elena;
+        }
+      }
+    }
+    else {
+      /* non-struct field type */
+      if (ispointer(name)) {
+        if (oldsdna->pointer_size == 8) {
+          endian_swap_step_add(builder, cur, old_name_array_len, 8);
+        }
+      }
+      else {
+        if (ELEM(spc[0], SDNA_TYPE_SHORT, SDNA_TYPE_USHORT)) {
+          /* exception: variable called blocktype: derived from ID_  */
+          if (!STREQ(name, "blocktype")) {
+            endian_swap_step_add(builder, cur, old_name_array_len, 2);
+          }
+        }
+        else if (ELEM(spc[0], SDNA_TYPE_INT, SDNA_TYPE_FLOAT)) {
+          /* note, intentionally ignore long/ulong, see #DNA_struct_switch_endian. */
+          endian_swap_step_add(builder, cur, old_name_array_len, 4);
+        }
+        else if (ELEM(spc[0], SDNA_TYPE_INT64, SDNA_TYPE_UINT64, SDNA_TYPE_DOUBLE)) {
+          endian_swap_step_add(builder, cur, old_name_array_len, 8);
+        }
+      }
+    }
+    cur += elen;
+  }
+}
+
+/**
+ * Create the conversion plans of all the structs of \a oldsdna which differ from \a newsdna.
+ * Once created the plans are only read, so blocks can be converted from multiple threads.
+ *
+ * \param compflags: Result from #DNA_struct_get_compareflags.
+ * \param do_endian_swap: Also create the plans for #DNA_struct_switch_endian_blocks.
+ */
+DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
+                                                 const SDNA *newsdna,
+                                                 const char *compflags,
+                                                 const bool do_endian_swap)
+{
+  DNA_ReconstructInfo *info = MEM_callocN(sizeof(*info), __func__);
+  const int structs_len = oldsdna->structs_len;
+
+  info->oldsdna = oldsdna;
+  info->newsdna = newsdna;
+  info->compflags = compflags;
+
+  info->new_struct_size = MEM_callocN(sizeof(*info->new_struct_size) * structs_len, __func__);
+  info->steps = MEM_callocN(sizeof(*info->steps) * structs_len, __func__);
+  info->steps_len = MEM_callocN(sizeof(*info->steps_len) * structs_len, __func__);
+
+  unsigned int cursdna_index_last = UINT_MAX;
+  for (int old_struct_nr = 0; old_struct_nr < structs_len; old_struct_nr++) {
+    if (compflags[old_struct_nr] != SDNA_CMP_NOT_EQUAL) {
+      continue;
+    }
+    const short *spo = oldsdna->structs[old_struct_nr];
+    const int new_struct_nr = DNA_struct_find_nr_ex(
+        newsdna, oldsdna->types[spo[0]], &cursdna_index_last);
+    if (new_struct_nr == -1) {
+      continue;
+    }
+    info->new_struct_size[old_struct_nr] = newsdna->types_size[newsdna->structs[new_struct_nr][0]];
+
+    StepBuilder builder = {NULL};
+    reconstruct_struct_build(info, &builder, old_struct_nr, 0, new_struct_nr, 0);
+    info->steps[old_struct_nr] = builder.steps;
+    info->steps_len[old_struct_nr] = builder.steps_len;
+  }
+
+  if (do_endian_swap) {
+    info->endian_steps = MEM_callocN(sizeof(*info->endian_steps) * structs_len, __func__);
+    info->endian_steps_len = MEM_callocN(sizeof(*info->endian_steps_len) * structs_len, __func__);
+    for (int old_struct_nr = 0; old_struct_nr < structs_len; old_struct_nr++) {
+      StepBuilder builder = {NULL};
+      switch_endian_struct_build(oldsdna, &builder, old_struct_nr, 0);
+      info->endian_steps[old_struct_nr] = builder.steps;
+      info->endian_steps_len[old_struct_nr] = builder.steps_len;
+    }
+  }
+
+  return info;
+}
+
+void DNA_reconstruct_info_free(DNA_ReconstructInfo *info)
+{
+  const int structs_len = info->oldsdna->structs_len;
+  for (int i = 0; i < structs_len; i++) {
+    MEM_SAFE_FREE(info->steps[i]);
+  }
+  MEM_freeN(info->steps);
+  MEM_freeN(info->steps_len);
+  MEM_freeN(info->new_struct_size);
+
+  if (info->endian_steps) {
+    for (int i = 0; i < structs_len; i++) {
+      MEM_SAFE_FREE(info->endian_steps[i]);
+    }
+    MEM_freeN(info->endian_steps);
+    MEM_freeN(info->endian_steps_len);
+  }
+
+  MEM_freeN(info);
+}
+
+/**
+ * Does endian swapping on an array of struct values,
+ * using the plans created by #DNA_reconstruct_info_create.
+ *
+ * \param oldSDNAnr: Index of struct info within the old SDNA
+ * \param blocks: The number of array elements
+ * \param data: Array of struct data
+ */
+void DNA_struct_switch_endian_blocks(const DNA_ReconstructInfo *info,
+                                     int oldSDNAnr,
+                                     int blocks,
+                                     char *data)
+{
+  BLI_assert(info->endian_steps != NULL);
+  const EndianSwapStep *steps = info->endian_steps[oldSDNAnr];
+  const int steps_len = info->endian_steps_len[oldSDNAnr];
+  const int oldlen = info->oldsdna->types_size[info->oldsdna->structs[oldSDNAnr][0]];
+
+  for (int a = 0; a < blocks; a++, data += oldlen) {
+    for (int i = 0; i < steps_len; i++) {
+      const EndianSwapStep *step = &steps[i];
+      switch (step->size) {
+        case 2:
+          BLI_endian_switch_int16_array((int16_t *)(data + step->offset), step->len);
+          break;
+        case 4:
+          BLI_endian_switch_int32_array((int32_t *)(data + step->offset), step->len);
+          break;
+        case 8:
+          BLI_endian_switch_int64_array((int64_t *)(data + step->offset), step->len);
+          break;
+      }
+    }
+  }
+}
+
+/**
+ * \param info: Conversion plans, from #DNA_reconstruct_info_create.
+ * \param oldSDNAnr: Index of struct info within the old SDNA
  * \param blocks: The number of array elements
  * \param data: Array of struct data
  * \return An allocated reconstructed struct
  */
-void *DNA_struct_reconstruct(const SDNA *newsdna,
-                             const SDNA *oldsdna,
-                             const char *compflags,
+void *DNA_struct_reconstruct(const DNA_ReconstructInfo *info,
                              int oldSDNAnr,
                              int blocks,
                              const void *data)
 {
-  int a, curSDNAnr, curlen = 0, oldlen;
-  const short *spo, *spc;
+  int a, curlen, oldlen;
   char *cur, *cpc;
   const char *cpo;
-  const char *type;
-
-  /* oldSDNAnr == structnr, we're looking for the corresponding 'cur' number */
-  spo = oldsdna->structs[oldSDNAnr];
-  type = oldsdna->types[spo[0]];
-  oldlen = oldsdna->types_size[spo[0]];
-  curSDNAnr = DNA_struct_find_nr(newsdna, type);
 
-  /* init data and alloc */
-  if (curSDNAnr != -1) {
-    spc = newsdna->structs[curSDNAnr];
-    curlen = newsdna->types_size[spc[0]];
-  }
+  curlen = info->new_struct_size[oldSDNAnr];
   if (curlen == 0) {
     return NULL;
   }
+  oldlen = info->oldsdna->types_size[info->oldsdna->structs[oldSDNAnr][0]];
+
+  const ReconstructStep *steps = info->steps[oldSDNAnr];
+  const int steps_len = info->steps_len[oldSDNAnr];
 
+  /* init data and alloc */
   cur = MEM_callocN(blocks * curlen, "reconstruct");
   cpc = cur;
   cpo = data;
   for (a = 0; a < blocks; a++) {
-    reconstruct_struct(newsdna, oldsdna, compflags, oldSDNAnr, cpo, curSDNAnr, cpc);
+    reconstruct_struct_apply(info, steps, steps_len, cpo, cpc);
     cpc += curlen;
     cpo += oldlen;
   }
@@ -1442,6 +1860,8 @@ void *DNA_struct_reconstruct(const SDNA *newsdna,
   return cur;
 }
 
+/** \} */
+
 /**
  * Returns the offset of the field with the specified name and type within the specified
  * struct type in sdna.
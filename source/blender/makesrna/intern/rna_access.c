@@ -4483,6 +4483,18 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        /* items are tightly packed, copy all of them at once */
+        if (out.stride == size) {
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -4498,8 +4510,30 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* could also be faster with non-matching types,
-       * for now we just do slower loop .. */
+      /* non-matching raw types, convert while still accessing the raw array
+       * instead of going through the property of every item */
+      if (in.type != PROP_RAW_UNSET && out.type != PROP_RAW_UNSET) {
+        RawArray item = out;
+        int a, j, i = 0;
+
+        for (a = 0; a < out.len; a++) {
+          item.array = (char *)out.array + (size_t)out.stride * a;
+
+          for (j = 0; j < arraylen; j++, i++) {
+            double value;
+            if (set) {
+              RAW_GET(double, value, in, i);
+              RAW_SET(double, item, j, value);
+            }
+            else {
+              RAW_GET(double, value, item, j);
+              RAW_SET(double, in, i, value);
+            }
+          }
+        }
+
+        return 1;
+      }
     }
   }
 
@@ -173,6 +173,7 @@ static const EnumPropertyItem rna_enum_userdef_viewport_aa_items[] = {
 
 #  include "BLI_math_vector.h"
 
+#  include "DNA_mesh_types.h"
 #  include "DNA_object_types.h"
 #  include "DNA_screen_types.h"
 
@@ -181,6 +182,7 @@ static const EnumPropertyItem rna_enum_userdef_viewport_aa_items[] = {
 #  include "BKE_idprop.h"
 #  include "BKE_main.h"
 #  include "BKE_mesh_runtime.h"
+#  include "BKE_modifier_cache.h"
 #  include "BKE_pbvh.h"
 #  include "BKE_paint.h"
 #  include "BKE_screen.h"
@@ -536,6 +538,26 @@ static void rna_Userdef_memcache_update(Main *UNUSED(bmain),
   USERDEF_TAG_DIRTY;
 }
 
+static void rna_Userdef_modifier_cache_update(Main *UNUSED(bmain),
+                                              Scene *UNUSED(scene),
+                                              PointerRNA *UNUSED(ptr))
+{
+  BKE_modifier_cache_limit_update();
+  USERDEF_TAG_DIRTY;
+}
+
+static void rna_userdef_compact_vertex_data_update(Main *bmain,
+                                                   Scene *UNUSED(scene),
+                                                   PointerRNA *UNUSED(ptr))
+{
+  /* Vertex buffers are created in the new format on the next update of the meshes. */
+  for (Mesh *me = bmain->meshes.first; me; me = me->id.next) {
+    DEG_id_tag_update(&me->id, ID_RECALC_GEOMETRY);
+  }
+  WM_main_add_notifier(NC_WINDOW, NULL);
+  USERDEF_TAG_DIRTY;
+}
+
 static void rna_UserDef_weight_color_update(Main *bmain, Scene *scene, PointerRNA *ptr)
 {
   Object *ob;
@@ -4947,6 +4969,25 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       {0, NULL, 0, NULL, NULL},
   };
 
+  static const EnumPropertyItem seq_disk_cache_compression_levels[] = {
+      {USER_SEQ_DISK_CACHE_COMPRESSION_NONE,
+       "NONE",
+       0,
+       "None",
+       "Requires fast storage, but uses minimum CPU resources"},
+      {USER_SEQ_DISK_CACHE_COMPRESSION_LOW,
+       "LOW",
+       0,
+       "Low",
+       "Doesn't require fast storage and uses less CPU resources"},
+      {USER_SEQ_DISK_CACHE_COMPRESSION_HIGH,
+       "HIGH",
+       0,
+       "High",
+       "Works on slower storage devices and uses most CPU resources"},
+      {0, NULL, 0, NULL, NULL},
+  };
+
   static const EnumPropertyItem audio_mixing_samples_items[] = {
       {256, "SAMPLES_256", 0, "256", "Set audio mixing buffer size to 256 samples"},
       {512, "SAMPLES_512", 0, "512", "Set audio mixing buffer size to 512 samples"},
@@ -5074,6 +5115,49 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Memory Cache Limit", "Memory cache limit (in megabytes)");
   RNA_def_property_update(prop, 0, "rna_Userdef_memcache_update");
 
+  prop = RNA_def_property(srna, "sequencer_disk_cache_dir", PROP_STRING, PROP_DIRPATH);
+  RNA_def_property_string_sdna(prop, NULL, "sequencer_disk_cache_dir");
+  RNA_def_property_ui_text(prop,
+                           "Sequencer Disk Cache Directory",
+                           "Directory of the persistent sequencer disk cache "
+                           "(uses the temporary directory when empty)");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "sequencer_disk_cache_size_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "sequencer_disk_cache_size_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 1000, 1, -1);
+  RNA_def_property_ui_text(prop,
+                           "Sequencer Disk Cache Limit",
+                           "Disk space used by the sequencer disk cache (in gigabytes)");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "sequencer_disk_cache_compression", PROP_ENUM, PROP_NONE);
+  RNA_def_property_enum_items(prop, seq_disk_cache_compression_levels);
+  RNA_def_property_enum_sdna(prop, NULL, "sequencer_disk_cache_compression");
+  RNA_def_property_ui_text(prop,
+                           "Sequencer Disk Cache Compression",
+                           "Compression level of images stored in the sequencer disk cache");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "modifier_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "modifier_cache_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Modifier Cache Limit",
+                           "Memory limit for reusing modifier results of objects whose inputs "
+                           "did not change (in megabytes, 0 to disable)");
+  RNA_def_property_update(prop, 0, "rna_Userdef_modifier_cache_update");
+
+  prop = RNA_def_property(srna, "compositor_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "compositor_cache_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Compositor Cache Limit",
+                           "Memory limit for reusing compositor results of nodes whose inputs "
+                           "did not change (in megabytes, 0 to disable)");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -5097,6 +5181,30 @@ static void rna_def_userdef_system(BlenderRNA *brna)
                            "Enable Edit-Mode edge smoothing, reducing aliasing, requires restart");
   RNA_def_property_update(prop, 0, "rna_userdef_dpi_update");
 
+  prop = RNA_def_property(srna, "use_compact_vertex_data", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "gpu_flag", USER_GPU_FLAG_COMPACT_VERTEX_DATA);
+  RNA_def_property_ui_text(prop,
+                           "Compact Vertex Data",
+                           "Store UV maps as half floats and tangents as 16 bit integers on the "
+                           "GPU, reducing video memory usage at the cost of precision");
+  RNA_def_property_update(prop, 0, "rna_userdef_compact_vertex_data_update");
+
+  prop = RNA_def_property(srna, "use_viewport_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "gpu_flag", USER_GPU_FLAG_VIEWPORT_LOD);
+  RNA_def_property_ui_text(prop,
+                           "Level of Detail",
+                           "Draw simplified meshes for objects covering only a few pixels of the "
+                           "viewport in Solid shading mode");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "use_shader_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_negative_sdna(prop, NULL, "gpu_flag", USER_GPU_FLAG_NO_SHADER_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "Shader Cache",
+                           "Store compiled material shaders on disk, so they don't need to be "
+                           "compiled again when used in a later session");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   /* grease pencil anti-aliasing */
   prop = RNA_def_property(srna, "gpencil_multi_sample", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_bitflag_sdna(prop, NULL, "gpencil_multisamples");
@@ -5173,6 +5281,16 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       prop, "GL Texture Limit", "Limit the texture size to save graphics memory");
   RNA_def_property_update(prop, 0, "rna_userdef_gl_texture_limit_update");
 
+  prop = RNA_def_property(srna, "texture_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "texture_memory_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 256, -1);
+  RNA_def_property_ui_text(
+      prop,
+      "Texture Memory Limit",
+      "Graphics memory in megabytes image textures may use, least recently used textures "
+      "are freed when it is exceeded (set to 0 to disable)");
+
   prop = RNA_def_property(srna, "texture_time_out", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "textimeout");
   RNA_def_property_range(prop, 0, 3600);
@@ -27,6 +27,8 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_path_util.h"
+
 #include "RNA_define.h"
 #include "RNA_enum_types.h"
 
@@ -72,6 +74,8 @@ const EnumPropertyItem rna_enum_window_cursor_items[] = {
 
 #  include "WM_types.h"
 
+#  include "DRW_engine.h"
+
 static void rna_KeyMapItem_to_string(wmKeyMapItem *kmi, bool compact, char *result)
 {
   WM_keymap_item_to_string(kmi, compact, result, UI_MAX_SHORTCUT_STR);
@@ -151,6 +155,16 @@ static void rna_gizmo_group_type_unlink_delayed(ReportList *reports, const char
   }
 }
 
+static void rna_draw_stats_trace(ReportList *reports, const char *filename)
+{
+  if (!DRW_stats_trace_write(filename)) {
+    BKE_reportf(reports,
+                RPT_ERROR,
+                "Could not write viewport profile to '%s', is profiling enabled?",
+                filename);
+  }
+}
+
 /* placeholder data for final implementation of a true progressbar */
 static struct wmStaticProgress {
   float min;
@@ -747,6 +761,15 @@ void RNA_api_wm(StructRNA *srna)
   parm = RNA_def_string(func, "identifier", NULL, 0, "", "Gizmo group type name");
   RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 
+  func = RNA_def_function(srna, "draw_stats_trace", "rna_draw_stats_trace");
+  RNA_def_function_ui_description(func,
+                                  "Write the CPU and GPU timings of the last profiled viewport "
+                                  "frame in the Trace Event format (needs debug value 21 to 29)");
+  RNA_def_function_flag(func, FUNC_NO_SELF | FUNC_USE_REPORTS);
+  parm = RNA_def_string_file_path(
+      func, "filename", NULL, FILE_MAX, "File Name", "Output path for the trace JSON file");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+
   /* Progress bar interface */
   func = RNA_def_function(srna, "progress_begin", "rna_progress_begin");
   RNA_def_function_ui_description(func, "Start progress report");
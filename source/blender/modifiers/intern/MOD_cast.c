@@ -21,6 +21,8 @@
  * \ingroup modifiers
  */
 
+#include <string.h>
+
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
@@ -97,6 +99,88 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
   }
 }
 
+typedef struct CastUserdata {
+  bool use_ctrl_ob;
+  bool has_radius;
+  short flag;
+  short type;
+  float radius;
+  float len;
+  float fac;
+  float center[3];
+  float mat[4][4], imat[4][4];
+  float bb[8][3];
+} CastUserdata;
+
+static void cast_co_to_ctrl_space(const CastUserdata *data, float co[3])
+{
+  if (data->use_ctrl_ob) {
+    if (data->flag & MOD_CAST_USE_OB_TRANSFORM) {
+      mul_m4_v3(data->mat, co);
+    }
+    else {
+      sub_v3_v3(co, data->center);
+    }
+  }
+}
+
+static void cast_co_from_ctrl_space(const CastUserdata *data, float co[3])
+{
+  if (data->use_ctrl_ob) {
+    if (data->flag & MOD_CAST_USE_OB_TRANSFORM) {
+      mul_m4_v3(data->imat, co);
+    }
+    else {
+      add_v3_v3(co, data->center);
+    }
+  }
+}
+
+static void sphere_do_vert(void *__restrict userdata,
+                           const DeformVertsParallelParams *UNUSED(params),
+                           const int UNUSED(index),
+                           float co[3],
+                           const float weight)
+{
+  const CastUserdata *data = userdata;
+  const short flag = data->flag;
+  const float fac = data->fac * weight;
+  const float facm = 1.0f - fac;
+  const float len = data->len;
+  float tmp_co[3], vec[3];
+
+  copy_v3_v3(tmp_co, co);
+  cast_co_to_ctrl_space(data, tmp_co);
+
+  copy_v3_v3(vec, tmp_co);
+
+  if (data->type == MOD_CAST_TYPE_CYLINDER) {
+    vec[2] = 0.0f;
+  }
+
+  if (data->has_radius) {
+    if (len_v3(vec) > data->radius) {
+      return;
+    }
+  }
+
+  normalize_v3(vec);
+
+  if (flag & MOD_CAST_X) {
+    tmp_co[0] = fac * vec[0] * len + facm * tmp_co[0];
+  }
+  if (flag & MOD_CAST_Y) {
+    tmp_co[1] = fac * vec[1] * len + facm * tmp_co[1];
+  }
+  if (flag & MOD_CAST_Z) {
+    tmp_co[2] = fac * vec[2] * len + facm * tmp_co[2];
+  }
+
+  cast_co_from_ctrl_space(data, tmp_co);
+
+  copy_v3_v3(co, tmp_co);
+}
+
 static void sphere_do(CastModifierData *cmd,
                       const ModifierEvalContext *UNUSED(ctx),
                       Object *ob,
@@ -112,10 +196,7 @@ static void sphere_do(CastModifierData *cmd,
   bool has_radius = false;
   short flag, type;
   float len = 0.0f;
-  float fac = cmd->fac;
-  float facm = 1.0f - fac;
-  const float fac_orig = fac;
-  float vec[3], center[3] = {0.0f, 0.0f, 0.0f};
+  float center[3] = {0.0f, 0.0f, 0.0f};
   float mat[4][4], imat[4][4];
 
   flag = cmd->flag;
@@ -172,64 +253,116 @@ static void sphere_do(CastModifierData *cmd,
     }
   }
 
-  for (i = 0; i < numVerts; i++) {
-    float tmp_co[3];
-
-    copy_v3_v3(tmp_co, vertexCos[i]);
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(mat, tmp_co);
-      }
-      else {
-        sub_v3_v3(tmp_co, center);
-      }
-    }
+  CastUserdata data = {
+      .use_ctrl_ob = ctrl_ob != NULL,
+      .has_radius = has_radius,
+      .flag = flag,
+      .type = type,
+      .radius = cmd->radius,
+      .len = len,
+      .fac = cmd->fac,
+  };
+  copy_v3_v3(data.center, center);
+  if (ctrl_ob && (flag & MOD_CAST_USE_OB_TRANSFORM)) {
+    copy_m4_m4(data.mat, mat);
+    copy_m4_m4(data.imat, imat);
+  }
 
-    copy_v3_v3(vec, tmp_co);
+  DeformVertsParallelParams params = {
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+  };
+  MOD_deform_verts_parallel(vertexCos, numVerts, &params, sphere_do_vert, &data);
+}
 
-    if (type == MOD_CAST_TYPE_CYLINDER) {
-      vec[2] = 0.0f;
+static void cuboid_do_vert(void *__restrict userdata,
+                           const DeformVertsParallelParams *UNUSED(params),
+                           const int UNUSED(index),
+                           float co[3],
+                           const float weight)
+{
+  const CastUserdata *data = userdata;
+  const short flag = data->flag;
+  const float fac = data->fac * weight;
+  const float facm = 1.0f - fac;
+  int octant, coord;
+  float d[3], dmax, apex[3], fbb;
+  float tmp_co[3];
+
+  copy_v3_v3(tmp_co, co);
+  cast_co_to_ctrl_space(data, tmp_co);
+
+  if (data->has_radius) {
+    if (fabsf(tmp_co[0]) > data->radius || fabsf(tmp_co[1]) > data->radius ||
+        fabsf(tmp_co[2]) > data->radius) {
+      return;
     }
+  }
 
-    if (has_radius) {
-      if (len_v3(vec) > cmd->radius) {
-        continue;
-      }
-    }
+  /* The algo used to project the vertices to their
+   * bounding box (bb) is pretty simple:
+   * for each vertex v:
+   * 1) find in which octant v is in;
+   * 2) find which outer "wall" of that octant is closer to v;
+   * 3) calculate factor (var fbb) to project v to that wall;
+   * 4) project. */
+
+  /* find in which octant this vertex is in */
+  octant = 0;
+  if (tmp_co[0] > 0.0f) {
+    octant += 1;
+  }
+  if (tmp_co[1] > 0.0f) {
+    octant += 2;
+  }
+  if (tmp_co[2] > 0.0f) {
+    octant += 4;
+  }
 
-    if (dvert) {
-      const float weight = defvert_find_weight(&dvert[i], defgrp_index);
-      if (weight == 0.0f) {
-        continue;
-      }
+  /* apex is the bb's vertex at the chosen octant */
+  copy_v3_v3(apex, data->bb[octant]);
 
-      fac = fac_orig * weight;
-      facm = 1.0f - fac;
-    }
+  /* find which bb plane is closest to this vertex ... */
+  d[0] = tmp_co[0] / apex[0];
+  d[1] = tmp_co[1] / apex[1];
+  d[2] = tmp_co[2] / apex[2];
 
-    normalize_v3(vec);
+  /* ... (the closest has the higher (closer to 1) d value) */
+  dmax = d[0];
+  coord = 0;
+  if (d[1] > dmax) {
+    dmax = d[1];
+    coord = 1;
+  }
+  if (d[2] > dmax) {
+    /* dmax = d[2]; */ /* commented, we don't need it */
+    coord = 2;
+  }
 
-    if (flag & MOD_CAST_X) {
-      tmp_co[0] = fac * vec[0] * len + facm * tmp_co[0];
-    }
-    if (flag & MOD_CAST_Y) {
-      tmp_co[1] = fac * vec[1] * len + facm * tmp_co[1];
-    }
-    if (flag & MOD_CAST_Z) {
-      tmp_co[2] = fac * vec[2] * len + facm * tmp_co[2];
-    }
+  /* ok, now we know which coordinate of the vertex to use */
 
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(imat, tmp_co);
-      }
-      else {
-        add_v3_v3(tmp_co, center);
-      }
-    }
+  if (fabsf(tmp_co[coord]) < FLT_EPSILON) { /* avoid division by zero */
+    return;
+  }
 
-    copy_v3_v3(vertexCos[i], tmp_co);
+  /* finally, this is the factor we wanted, to project the vertex
+   * to its bounding box (bb) */
+  fbb = apex[coord] / tmp_co[coord];
+
+  /* calculate the new vertex position */
+  if (flag & MOD_CAST_X) {
+    tmp_co[0] = facm * tmp_co[0] + fac * tmp_co[0] * fbb;
+  }
+  if (flag & MOD_CAST_Y) {
+    tmp_co[1] = facm * tmp_co[1] + fac * tmp_co[1] * fbb;
   }
+  if (flag & MOD_CAST_Z) {
+    tmp_co[2] = facm * tmp_co[2] + fac * tmp_co[2] * fbb;
+  }
+
+  cast_co_from_ctrl_space(data, tmp_co);
+
+  copy_v3_v3(co, tmp_co);
 }
 
 static void cuboid_do(CastModifierData *cmd,
@@ -245,9 +378,6 @@ static void cuboid_do(CastModifierData *cmd,
   int i, defgrp_index;
   bool has_radius = false;
   short flag;
-  float fac = cmd->fac;
-  float facm = 1.0f - fac;
-  const float fac_orig = fac;
   float min[3], max[3], bb[8][3];
   float center[3] = {0.0f, 0.0f, 0.0f};
   float mat[4][4], imat[4][4];
@@ -301,21 +431,15 @@ static void cuboid_do(CastModifierData *cmd,
     /* Cast's center is the ob's own center in its local space,
      * by default, but if the user defined a control object, we use
      * its location, transformed to ob's local space. */
+    minmax_v3v3_v3_array(min, max, vertexCos, numVerts);
     if (ctrl_ob) {
-      float vec[3];
-
+      /* Bounds of the coordinates relative to the center. */
+      if (numVerts != 0) {
+        sub_v3_v3(min, center);
+        sub_v3_v3(max, center);
+      }
       /* let the center of the ctrl_ob be part of the bound box: */
       minmax_v3v3_v3(min, max, center);
-
-      for (i = 0; i < numVerts; i++) {
-        sub_v3_v3v3(vec, vertexCos[i], center);
-        minmax_v3v3_v3(min, max, vec);
-      }
-    }
-    else {
-      for (i = 0; i < numVerts; i++) {
-        minmax_v3v3_v3(min, max, vertexCos[i]);
-      }
     }
 
     /* we want a symmetric bound box around the origin */
@@ -342,110 +466,25 @@ static void cuboid_do(CastModifierData *cmd,
   bb[4][2] = bb[5][2] = bb[6][2] = bb[7][2] = max[2];
 
   /* ready to apply the effect, one vertex at a time */
-  for (i = 0; i < numVerts; i++) {
-    int octant, coord;
-    float d[3], dmax, apex[3], fbb;
-    float tmp_co[3];
-
-    copy_v3_v3(tmp_co, vertexCos[i]);
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(mat, tmp_co);
-      }
-      else {
-        sub_v3_v3(tmp_co, center);
-      }
-    }
-
-    if (has_radius) {
-      if (fabsf(tmp_co[0]) > cmd->radius || fabsf(tmp_co[1]) > cmd->radius ||
-          fabsf(tmp_co[2]) > cmd->radius) {
-        continue;
-      }
-    }
-
-    if (dvert) {
-      const float weight = defvert_find_weight(&dvert[i], defgrp_index);
-      if (weight == 0.0f) {
-        continue;
-      }
-
-      fac = fac_orig * weight;
-      facm = 1.0f - fac;
-    }
-
-    /* The algo used to project the vertices to their
-     * bounding box (bb) is pretty simple:
-     * for each vertex v:
-     * 1) find in which octant v is in;
-     * 2) find which outer "wall" of that octant is closer to v;
-     * 3) calculate factor (var fbb) to project v to that wall;
-     * 4) project. */
-
-    /* find in which octant this vertex is in */
-    octant = 0;
-    if (tmp_co[0] > 0.0f) {
-      octant += 1;
-    }
-    if (tmp_co[1] > 0.0f) {
-      octant += 2;
-    }
-    if (tmp_co[2] > 0.0f) {
-      octant += 4;
-    }
-
-    /* apex is the bb's vertex at the chosen octant */
-    copy_v3_v3(apex, bb[octant]);
-
-    /* find which bb plane is closest to this vertex ... */
-    d[0] = tmp_co[0] / apex[0];
-    d[1] = tmp_co[1] / apex[1];
-    d[2] = tmp_co[2] / apex[2];
-
-    /* ... (the closest has the higher (closer to 1) d value) */
-    dmax = d[0];
-    coord = 0;
-    if (d[1] > dmax) {
-      dmax = d[1];
-      coord = 1;
-    }
-    if (d[2] > dmax) {
-      /* dmax = d[2]; */ /* commented, we don't need it */
-      coord = 2;
-    }
-
-    /* ok, now we know which coordinate of the vertex to use */
-
-    if (fabsf(tmp_co[coord]) < FLT_EPSILON) { /* avoid division by zero */
-      continue;
-    }
-
-    /* finally, this is the factor we wanted, to project the vertex
-     * to its bounding box (bb) */
-    fbb = apex[coord] / tmp_co[coord];
-
-    /* calculate the new vertex position */
-    if (flag & MOD_CAST_X) {
-      tmp_co[0] = facm * tmp_co[0] + fac * tmp_co[0] * fbb;
-    }
-    if (flag & MOD_CAST_Y) {
-      tmp_co[1] = facm * tmp_co[1] + fac * tmp_co[1] * fbb;
-    }
-    if (flag & MOD_CAST_Z) {
-      tmp_co[2] = facm * tmp_co[2] + fac * tmp_co[2] * fbb;
-    }
-
-    if (ctrl_ob) {
-      if (flag & MOD_CAST_USE_OB_TRANSFORM) {
-        mul_m4_v3(imat, tmp_co);
-      }
-      else {
-        add_v3_v3(tmp_co, center);
-      }
-    }
-
-    copy_v3_v3(vertexCos[i], tmp_co);
+  CastUserdata data = {
+      .use_ctrl_ob = ctrl_ob != NULL,
+      .has_radius = has_radius,
+      .flag = flag,
+      .radius = cmd->radius,
+      .fac = cmd->fac,
+  };
+  copy_v3_v3(data.center, center);
+  if (ctrl_ob && (flag & MOD_CAST_USE_OB_TRANSFORM)) {
+    copy_m4_m4(data.mat, mat);
+    copy_m4_m4(data.imat, imat);
   }
+  memcpy(data.bb, bb, sizeof(data.bb));
+
+  DeformVertsParallelParams params = {
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+  };
+  MOD_deform_verts_parallel(vertexCos, numVerts, &params, cuboid_do_vert, &data);
 }
 
 static void deformVerts(ModifierData *md,
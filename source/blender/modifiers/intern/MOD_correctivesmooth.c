@@ -26,6 +26,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_meshdata_types.h"
@@ -36,6 +37,7 @@
 
 #include "BKE_deform.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_editmesh.h"
 #include "BKE_library.h"
 
@@ -168,6 +170,135 @@ static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
   MEM_freeN(boundaries);
 }
 
+/* -------------------------------------------------------------------- */
+/* Smoothing Iterations
+ *
+ * Every iteration first gathers the delta of each vertex from its edges, then applies it.
+ * Gathering per vertex instead of scattering per edge means vertices can be processed in
+ * parallel, and since the vertex edge map is in edge order, the deltas are summed in the same
+ * order as when looping over edges.
+ */
+
+struct SmoothingData_Simple {
+  float delta[3];
+};
+
+struct SmoothingData_Weighted {
+  float delta[3];
+  float edge_length_sum;
+};
+
+typedef struct SmoothIterData {
+  const MeshElemMap *vert_edges;
+  const MEdge *edges;
+  float (*vertexCos)[3];
+  const float *smooth_weights;
+  /* simple: lambda and weight divided by the edge count, weighted: edge count */
+  const float *vertex_edge_count;
+  float lambda;
+
+  struct SmoothingData_Simple *smooth_data_simple;
+  struct SmoothingData_Weighted *smooth_data_weighted;
+} SmoothIterData;
+
+static void smooth_iter_settings(TaskParallelSettings *settings, uint numVerts)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->use_threading = (numVerts > 10000);
+  settings->min_iter_per_thread = 1024;
+}
+
+static void smooth_iter__simple_gather_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothIterData *data = userdata;
+  const MeshElemMap *map = &data->vert_edges[i];
+  struct SmoothingData_Simple *sd = &data->smooth_data_simple[i];
+
+  zero_v3(sd->delta);
+
+  for (int j = 0; j < map->count; j++) {
+    const MEdge *edge = &data->edges[map->indices[j]];
+    float edge_dir[3];
+
+    sub_v3_v3v3(edge_dir, data->vertexCos[edge->v2], data->vertexCos[edge->v1]);
+
+    if (edge->v1 == (uint)i) {
+      add_v3_v3(sd->delta, edge_dir);
+    }
+    if (edge->v2 == (uint)i) {
+      sub_v3_v3(sd->delta, edge_dir);
+    }
+  }
+}
+
+static void smooth_iter__simple_apply_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothIterData *data = userdata;
+  const struct SmoothingData_Simple *sd = &data->smooth_data_simple[i];
+
+  madd_v3_v3fl(data->vertexCos[i], sd->delta, data->vertex_edge_count[i]);
+}
+
+static void smooth_iter__length_weight_gather_cb(void *__restrict userdata,
+                                                 const int i,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothIterData *data = userdata;
+  const MeshElemMap *map = &data->vert_edges[i];
+  struct SmoothingData_Weighted *sd = &data->smooth_data_weighted[i];
+
+  zero_v3(sd->delta);
+  sd->edge_length_sum = 0.0f;
+
+  for (int j = 0; j < map->count; j++) {
+    const MEdge *edge = &data->edges[map->indices[j]];
+    float edge_dir[3];
+    float edge_dist;
+
+    sub_v3_v3v3(edge_dir, data->vertexCos[edge->v2], data->vertexCos[edge->v1]);
+    edge_dist = len_v3(edge_dir);
+
+    /* weight by distance */
+    mul_v3_fl(edge_dir, edge_dist);
+
+    if (edge->v1 == (uint)i) {
+      add_v3_v3(sd->delta, edge_dir);
+      sd->edge_length_sum += edge_dist;
+    }
+    if (edge->v2 == (uint)i) {
+      sub_v3_v3(sd->delta, edge_dir);
+      sd->edge_length_sum += edge_dist;
+    }
+  }
+}
+
+static void smooth_iter__length_weight_apply_cb(void *__restrict userdata,
+                                                const int i,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const float eps = FLT_EPSILON * 10.0f;
+  const SmoothIterData *data = userdata;
+  const struct SmoothingData_Weighted *sd = &data->smooth_data_weighted[i];
+
+  /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
+   * (mean average). */
+  const float div = sd->edge_length_sum * data->vertex_edge_count[i];
+  if (div > eps) {
+    if (data->smooth_weights == NULL) {
+      /* first calculate the new location and then interpolate, in one step */
+      madd_v3_v3fl(data->vertexCos[i], sd->delta, data->lambda / div);
+    }
+    else {
+      const float lambda_w = data->lambda * data->smooth_weights[i];
+      madd_v3_v3fl(data->vertexCos[i], sd->delta, lambda_w / div);
+    }
+  }
+}
+
 /* -------------------------------------------------------------------- */
 /* Simple Weighted Smoothing
  *
@@ -186,10 +317,11 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
   const uint numEdges = (uint)mesh->totedge;
   const MEdge *edges = mesh->medge;
   float *vertex_edge_count_div;
+  MeshElemMap *vert_edges;
+  int *vert_edges_mem;
 
-  struct SmoothingData_Simple {
-    float delta[3];
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  struct SmoothingData_Simple *smooth_data = MEM_calloc_arrayN(
+      numVerts, sizeof(*smooth_data), __func__);
 
   vertex_edge_count_div = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
 
@@ -219,29 +351,26 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
-  while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Simple *sd_v1;
-      struct SmoothingData_Simple *sd_v2;
-      float edge_dir[3];
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
+  BKE_mesh_vert_edge_map_create(&vert_edges, &vert_edges_mem, edges, (int)numVerts, (int)numEdges);
 
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
+  SmoothIterData data = {
+      .vert_edges = vert_edges,
+      .edges = edges,
+      .vertexCos = vertexCos,
+      .vertex_edge_count = vertex_edge_count_div,
+      .smooth_data_simple = smooth_data,
+  };
 
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-    }
+  TaskParallelSettings settings;
+  smooth_iter_settings(&settings, numVerts);
 
-    for (i = 0; i < numVerts; i++) {
-      struct SmoothingData_Simple *sd = &smooth_data[i];
-      madd_v3_v3fl(vertexCos[i], sd->delta, vertex_edge_count_div[i]);
-      /* zero for the next iteration (saves memset on entire array) */
-      memset(sd, 0, sizeof(*sd));
-    }
+  while (iterations--) {
+    BLI_task_parallel_range(0, (int)numVerts, &data, smooth_iter__simple_gather_cb, &settings);
+    BLI_task_parallel_range(0, (int)numVerts, &data, smooth_iter__simple_apply_cb, &settings);
   }
 
+  MEM_freeN(vert_edges);
+  MEM_freeN(vert_edges_mem);
   MEM_freeN(vertex_edge_count_div);
   MEM_freeN(smooth_data);
 }
@@ -256,19 +385,18 @@ static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
                                        const float *smooth_weights,
                                        uint iterations)
 {
-  const float eps = FLT_EPSILON * 10.0f;
   const uint numEdges = (uint)mesh->totedge;
   /* note: the way this smoothing method works, its approx half as strong as the simple-smooth,
    * and 2.0 rarely spikes, double the value for consistent behavior. */
   const float lambda = csmd->lambda * 2.0f;
   const MEdge *edges = mesh->medge;
   float *vertex_edge_count;
+  MeshElemMap *vert_edges;
+  int *vert_edges_mem;
   uint i;
 
-  struct SmoothingData_Weighted {
-    float delta[3];
-    float edge_length_sum;
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  struct SmoothingData_Weighted *smooth_data = MEM_calloc_arrayN(
+      numVerts, sizeof(*smooth_data), __func__);
 
   /* calculate as floats to avoid int->float conversion in #smooth_iter */
   vertex_edge_count = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
@@ -277,68 +405,35 @@ static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
     vertex_edge_count[edges[i].v2] += 1.0f;
   }
 
+  BKE_mesh_vert_edge_map_create(&vert_edges, &vert_edges_mem, edges, (int)numVerts, (int)numEdges);
+
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
-  while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Weighted *sd_v1;
-      struct SmoothingData_Weighted *sd_v2;
-      float edge_dir[3];
-      float edge_dist;
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
-      edge_dist = len_v3(edge_dir);
-
-      /* weight by distance */
-      mul_v3_fl(edge_dir, edge_dist);
+  SmoothIterData data = {
+      .vert_edges = vert_edges,
+      .edges = edges,
+      .vertexCos = vertexCos,
+      .smooth_weights = smooth_weights,
+      .vertex_edge_count = vertex_edge_count,
+      .lambda = lambda,
+      .smooth_data_weighted = smooth_data,
+  };
 
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
+  TaskParallelSettings settings;
+  smooth_iter_settings(&settings, numVerts);
 
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
+  while (iterations--) {
 
-      sd_v1->edge_length_sum += edge_dist;
-      sd_v2->edge_length_sum += edge_dist;
-    }
+    BLI_task_parallel_range(
+        0, (int)numVerts, &data, smooth_iter__length_weight_gather_cb, &settings);
 
-    if (smooth_weights == NULL) {
-      /* fast-path */
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
-         * (mean average). */
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-#if 0
-          /* first calculate the new location */
-          mul_v3_fl(sd->delta, 1.0f / div);
-          /* then interpolate */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda);
-#else
-          /* do this in one step */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda / div);
-#endif
-        }
-        /* zero for the next iteration (saves memset on entire array) */
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
-    else {
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-          const float lambda_w = lambda * smooth_weights[i];
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda_w / div);
-        }
-
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
+    BLI_task_parallel_range(
+        0, (int)numVerts, &data, smooth_iter__length_weight_apply_cb, &settings);
   }
 
+  MEM_freeN(vert_edges);
+  MEM_freeN(vert_edges_mem);
   MEM_freeN(vertex_edge_count);
   MEM_freeN(smooth_data);
 }
@@ -623,6 +718,7 @@ static void correctivesmooth_modifier_do(ModifierData *md,
   /* If the number of verts has changed, the bind is invalid, so we do nothing */
   if (csmd->rest_source == MOD_CORRECTIVESMOOTH_RESTSOURCE_BIND) {
     if (csmd->bind_coords_num != numVerts) {
+
       modifier_setError(
           md, "Bind vertex count mismatch: %u to %u", csmd->bind_coords_num, numVerts);
       goto error;
@@ -736,6 +832,7 @@ static void deformVerts(ModifierData *md,
 {
   Mesh *mesh_src = MOD_deform_mesh_eval_get(ctx->object, NULL, mesh, NULL, numVerts, false, false);
 
+
   correctivesmooth_modifier_do(
       md, ctx->depsgraph, ctx->object, mesh_src, vertexCos, (uint)numVerts, NULL);
 
@@ -754,6 +851,7 @@ static void deformVertsEM(ModifierData *md,
   Mesh *mesh_src = MOD_deform_mesh_eval_get(
       ctx->object, editData, mesh, NULL, numVerts, false, false);
 
+
   correctivesmooth_modifier_do(
       md, ctx->depsgraph, ctx->object, mesh_src, vertexCos, (uint)numVerts, editData);
 
@@ -24,7 +24,6 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
-#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -34,7 +33,6 @@
 #include "BKE_editmesh.h"
 #include "BKE_library.h"
 #include "BKE_library_query.h"
-#include "BKE_image.h"
 #include "BKE_mesh.h"
 #include "BKE_modifier.h"
 #include "BKE_texture.h"
@@ -152,34 +150,23 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
 
 typedef struct DisplaceUserdata {
   /*const*/ DisplaceModifierData *dmd;
-  struct Scene *scene;
-  struct ImagePool *pool;
-  MDeformVert *dvert;
-  float weight;
-  int defgrp_index;
   int direction;
   bool use_global_direction;
-  Tex *tex_target;
-  float (*tex_co)[3];
-  float (*vertexCos)[3];
   float local_mat[4][4];
   MVert *mvert;
   float (*vert_clnors)[3];
 } DisplaceUserdata;
 
-static void displaceModifier_do_task(void *__restrict userdata,
+static void displaceModifier_do_vert(void *__restrict userdata,
+                                     const DeformVertsParallelParams *params,
                                      const int iter,
-                                     const TaskParallelTLS *__restrict UNUSED(tls))
+                                     float co[3],
+                                     const float weight)
 {
   DisplaceUserdata *data = (DisplaceUserdata *)userdata;
   DisplaceModifierData *dmd = data->dmd;
-  MDeformVert *dvert = data->dvert;
-  float weight = data->weight;
-  int defgrp_index = data->defgrp_index;
   int direction = data->direction;
   bool use_global_direction = data->use_global_direction;
-  float(*tex_co)[3] = data->tex_co;
-  float(*vertexCos)[3] = data->vertexCos;
   MVert *mvert = data->mvert;
   float(*vert_clnors)[3] = data->vert_clnors;
 
@@ -187,63 +174,50 @@ static void displaceModifier_do_task(void *__restrict userdata,
                             dmd->midlevel; /* when no texture is used, we fallback to white */
 
   TexResult texres;
-  float strength = dmd->strength;
+  float strength = dmd->strength * weight;
   float delta;
   float local_vec[3];
 
-  if (dvert) {
-    weight = defvert_find_weight(dvert + iter, defgrp_index);
-    if (weight == 0.0f) {
-      return;
-    }
-  }
-
-  if (data->tex_target) {
-    texres.nor = NULL;
-    BKE_texture_get_value_ex(
-        data->scene, data->tex_target, tex_co[iter], &texres, data->pool, false);
+  if (params->texture) {
+    MOD_deform_verts_texture_get(params, iter, &texres);
     delta = texres.tin - dmd->midlevel;
   }
   else {
     delta = delta_fixed; /* (1.0f - dmd->midlevel) */ /* never changes */
   }
 
-  if (dvert) {
-    strength *= weight;
-  }
-
   delta *= strength;
   CLAMP(delta, -10000, 10000);
 
   switch (direction) {
     case MOD_DISP_DIR_X:
       if (use_global_direction) {
-        vertexCos[iter][0] += delta * data->local_mat[0][0];
-        vertexCos[iter][1] += delta * data->local_mat[1][0];
-        vertexCos[iter][2] += delta * data->local_mat[2][0];
+        co[0] += delta * data->local_mat[0][0];
+        co[1] += delta * data->local_mat[1][0];
+        co[2] += delta * data->local_mat[2][0];
       }
       else {
-        vertexCos[iter][0] += delta;
+        co[0] += delta;
       }
       break;
     case MOD_DISP_DIR_Y:
       if (use_global_direction) {
-        vertexCos[iter][0] += delta * data->local_mat[0][1];
-        vertexCos[iter][1] += delta * data->local_mat[1][1];
-        vertexCos[iter][2] += delta * data->local_mat[2][1];
+        co[0] += delta * data->local_mat[0][1];
+        co[1] += delta * data->local_mat[1][1];
+        co[2] += delta * data->local_mat[2][1];
       }
       else {
-        vertexCos[iter][1] += delta;
+        co[1] += delta;
       }
       break;
     case MOD_DISP_DIR_Z:
       if (use_global_direction) {
-        vertexCos[iter][0] += delta * data->local_mat[0][2];
-        vertexCos[iter][1] += delta * data->local_mat[1][2];
-        vertexCos[iter][2] += delta * data->local_mat[2][2];
+        co[0] += delta * data->local_mat[0][2];
+        co[1] += delta * data->local_mat[1][2];
+        co[2] += delta * data->local_mat[2][2];
       }
       else {
-        vertexCos[iter][2] += delta;
+        co[2] += delta;
       }
       break;
     case MOD_DISP_DIR_RGB_XYZ:
@@ -254,15 +228,15 @@ static void displaceModifier_do_task(void *__restrict userdata,
         mul_transposed_mat3_m4_v3(data->local_mat, local_vec);
       }
       mul_v3_fl(local_vec, strength);
-      add_v3_v3(vertexCos[iter], local_vec);
+      add_v3_v3(co, local_vec);
       break;
     case MOD_DISP_DIR_NOR:
-      vertexCos[iter][0] += delta * (mvert[iter].no[0] / 32767.0f);
-      vertexCos[iter][1] += delta * (mvert[iter].no[1] / 32767.0f);
-      vertexCos[iter][2] += delta * (mvert[iter].no[2] / 32767.0f);
+      co[0] += delta * (mvert[iter].no[0] / 32767.0f);
+      co[1] += delta * (mvert[iter].no[1] / 32767.0f);
+      co[2] += delta * (mvert[iter].no[2] / 32767.0f);
       break;
     case MOD_DISP_DIR_CLNOR:
-      madd_v3_v3fl(vertexCos[iter], vert_clnors[iter], delta);
+      madd_v3_v3fl(co, vert_clnors[iter], delta);
       break;
   }
 }
@@ -279,7 +253,6 @@ static void displaceModifier_do(DisplaceModifierData *dmd,
   int direction = dmd->direction;
   int defgrp_index;
   float(*tex_co)[3];
-  float weight = 1.0f; /* init value unused but some compilers may complain */
   float(*vert_clnors)[3] = NULL;
   float local_mat[4][4] = {{0}};
   const bool use_global_direction = dmd->space == MOD_DISP_SPACE_GLOBAL;
@@ -336,31 +309,21 @@ static void displaceModifier_do(DisplaceModifierData *dmd,
   }
 
   DisplaceUserdata data = {NULL};
-  data.scene = DEG_get_evaluated_scene(ctx->depsgraph);
   data.dmd = dmd;
-  data.dvert = dvert;
-  data.weight = weight;
-  data.defgrp_index = defgrp_index;
   data.direction = direction;
   data.use_global_direction = use_global_direction;
-  data.tex_target = tex_target;
-  data.tex_co = tex_co;
-  data.vertexCos = vertexCos;
   copy_m4_m4(data.local_mat, local_mat);
   data.mvert = mvert;
   data.vert_clnors = vert_clnors;
-  if (tex_target != NULL) {
-    data.pool = BKE_image_pool_new();
-    BKE_texture_fetch_images_for_pool(tex_target, data.pool);
-  }
-  TaskParallelSettings settings;
-  BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (numVerts > 512);
-  BLI_task_parallel_range(0, numVerts, &data, displaceModifier_do_task, &settings);
 
-  if (data.pool != NULL) {
-    BKE_image_pool_free(data.pool);
-  }
+  DeformVertsParallelParams params = {
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .scene = DEG_get_evaluated_scene(ctx->depsgraph),
+      .texture = tex_target,
+      .tex_co = (const float(*)[3])tex_co,
+  };
+  MOD_deform_verts_parallel(vertexCos, numVerts, &params, displaceModifier_do_vert, &data);
 
   if (tex_co) {
     MEM_freeN(tex_co);
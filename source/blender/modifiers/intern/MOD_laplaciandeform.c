@@ -304,8 +304,8 @@ static void computeImplictRotations(LaplacianSystem *sys)
   float minj, mjt, qj[3], vj[3];
   int i, j, ln;
 
+  normalize_v3_array(sys->no, sys->total_verts);
   for (i = 0; i < sys->total_verts; i++) {
-    normalize_v3(sys->no[i]);
     vidn = sys->ringv_map[i].indices;
     ln = sys->ringv_map[i].count;
     minj = 1000000.0f;
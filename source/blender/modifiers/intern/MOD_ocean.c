@@ -382,7 +382,12 @@ static Mesh *doOcean(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mes
     BKE_mesh_ensure_normals(result);
   }
   else if (omd->geometry_mode == MOD_OCEAN_GEOM_DISPLACE) {
-    BKE_id_copy_ex(NULL, &mesh->id, (ID **)&result, LIB_ID_COPY_LOCALIZE);
+    /* Only vertices are modified (and a new foam layer added),
+     * no need to duplicate the other layers. */
+    result = mesh;
+    result->mvert = CustomData_duplicate_referenced_layer(
+        &result->vdata, CD_MVERT, result->totvert);
+    result->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
   }
 
   cfra_for_cache = cfra_scene;
@@ -21,8 +21,6 @@
  * \ingroup modifiers
  */
 
-#include "MEM_guardedalloc.h"
-
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
@@ -36,6 +34,8 @@
 #include "BKE_particle.h"
 #include "BKE_deform.h"
 
+#include "DEG_depsgraph_query.h"
+
 #include "MOD_modifiertypes.h"
 #include "MOD_util.h"
 
@@ -77,30 +77,61 @@ static void requiredDataMask(Object *UNUSED(ob),
   }
 }
 
-static void smoothModifier_do(
-    SmoothModifierData *smd, Object *ob, Mesh *mesh, float (*vertexCos)[3], int numVerts)
+typedef struct SmoothUserdata {
+  float (*accumulated_vecs)[3];
+  const uint *num_accumulated_vecs;
+  float fac;
+  short flag;
+} SmoothUserdata;
+
+static void smoothModifier_do_vert(void *__restrict userdata,
+                                   const DeformVertsParallelParams *params,
+                                   const int i,
+                                   float vco_orig[3],
+                                   const float weight)
 {
-  if (mesh == NULL) {
+  const SmoothUserdata *data = userdata;
+  const short flag = data->flag;
+
+  const float f_new = weight * data->fac;
+  if (params->dvert && f_new <= 0.0f) {
     return;
   }
+  const float f_orig = 1.0f - f_new;
 
-  float(*accumulated_vecs)[3] = MEM_calloc_arrayN(
-      (size_t)numVerts, sizeof(*accumulated_vecs), __func__);
-  if (!accumulated_vecs) {
-    return;
+  if (data->num_accumulated_vecs[0] > 0) {
+    mul_v3_fl(data->accumulated_vecs[i], 1.0f / (float)data->num_accumulated_vecs[i]);
   }
+  const float *vco_new = data->accumulated_vecs[i];
 
-  uint *num_accumulated_vecs = MEM_calloc_arrayN(
-      (size_t)numVerts, sizeof(*num_accumulated_vecs), __func__);
-  if (!num_accumulated_vecs) {
-    if (accumulated_vecs) {
-      MEM_freeN(accumulated_vecs);
-    }
+  if (flag & MOD_SMOOTH_X) {
+    vco_orig[0] = f_orig * vco_orig[0] + f_new * vco_new[0];
+  }
+  if (flag & MOD_SMOOTH_Y) {
+    vco_orig[1] = f_orig * vco_orig[1] + f_new * vco_new[1];
+  }
+  if (flag & MOD_SMOOTH_Z) {
+    vco_orig[2] = f_orig * vco_orig[2] + f_new * vco_new[2];
+  }
+}
+
+static void smoothModifier_do(SmoothModifierData *smd,
+                              const ModifierEvalContext *ctx,
+                              Mesh *mesh,
+                              float (*vertexCos)[3],
+                              int numVerts)
+{
+  if (mesh == NULL) {
     return;
   }
 
-  const float fac_new = smd->fac;
-  const float fac_orig = 1.0f - fac_new;
+  Object *ob = ctx->object;
+
+  /* Scratch memory is freed by the dependency graph at the end of the evaluation. */
+  float(*accumulated_vecs)[3] = DEG_scratch_calloc(ctx->depsgraph,
+                                                   sizeof(*accumulated_vecs) * (size_t)numVerts);
+  uint *num_accumulated_vecs = DEG_scratch_calloc(
+      ctx->depsgraph, sizeof(*num_accumulated_vecs) * (size_t)numVerts);
 
   MEdge *medges = mesh->medge;
   const int num_edges = mesh->totedge;
@@ -109,6 +140,17 @@ static void smoothModifier_do(
   int defgrp_index;
   MOD_get_vgroup(ob, mesh, smd->defgrp_name, &dvert, &defgrp_index);
 
+  SmoothUserdata data = {
+      .accumulated_vecs = accumulated_vecs,
+      .num_accumulated_vecs = num_accumulated_vecs,
+      .fac = smd->fac,
+      .flag = smd->flag,
+  };
+  DeformVertsParallelParams params = {
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+  };
+
   for (int j = 0; j < smd->repeat; j++) {
     if (j != 0) {
       memset(accumulated_vecs, 0, sizeof(*accumulated_vecs) * (size_t)numVerts);
@@ -129,56 +171,10 @@ static void smoothModifier_do(
       add_v3_v3(accumulated_vecs[idx2], fvec);
     }
 
-    const short flag = smd->flag;
-    if (dvert) {
-      MDeformVert *dv = dvert;
-      for (int i = 0; i < numVerts; i++, dv++) {
-        float *vco_orig = vertexCos[i];
-        if (num_accumulated_vecs[0] > 0) {
-          mul_v3_fl(accumulated_vecs[i], 1.0f / (float)num_accumulated_vecs[i]);
-        }
-        float *vco_new = accumulated_vecs[i];
-
-        const float f_new = defvert_find_weight(dv, defgrp_index) * fac_new;
-        if (f_new <= 0.0f) {
-          continue;
-        }
-        const float f_orig = 1.0f - f_new;
-
-        if (flag & MOD_SMOOTH_X) {
-          vco_orig[0] = f_orig * vco_orig[0] + f_new * vco_new[0];
-        }
-        if (flag & MOD_SMOOTH_Y) {
-          vco_orig[1] = f_orig * vco_orig[1] + f_new * vco_new[1];
-        }
-        if (flag & MOD_SMOOTH_Z) {
-          vco_orig[2] = f_orig * vco_orig[2] + f_new * vco_new[2];
-        }
-      }
-    }
-    else { /* no vertex group */
-      for (int i = 0; i < numVerts; i++) {
-        float *vco_orig = vertexCos[i];
-        if (num_accumulated_vecs[0] > 0) {
-          mul_v3_fl(accumulated_vecs[i], 1.0f / (float)num_accumulated_vecs[i]);
-        }
-        float *vco_new = accumulated_vecs[i];
-
-        if (flag & MOD_SMOOTH_X) {
-          vco_orig[0] = fac_orig * vco_orig[0] + fac_new * vco_new[0];
-        }
-        if (flag & MOD_SMOOTH_Y) {
-          vco_orig[1] = fac_orig * vco_orig[1] + fac_new * vco_new[1];
-        }
-        if (flag & MOD_SMOOTH_Z) {
-          vco_orig[2] = fac_orig * vco_orig[2] + fac_new * vco_new[2];
-        }
-      }
-    }
+    /* Accumulating the edge midpoints above scatters to both vertices of every edge,
+     * only blending towards the averages is independent per vertex. */
+    MOD_deform_verts_parallel(vertexCos, numVerts, &params, smoothModifier_do_vert, &data);
   }
-
-  MEM_freeN(accumulated_vecs);
-  MEM_freeN(num_accumulated_vecs);
 }
 
 static void deformVerts(ModifierData *md,
@@ -193,7 +189,7 @@ static void deformVerts(ModifierData *md,
   /* mesh_src is needed for vgroups, and taking edges into account. */
   mesh_src = MOD_deform_mesh_eval_get(ctx->object, NULL, mesh, NULL, numVerts, false, false);
 
-  smoothModifier_do(smd, ctx->object, mesh_src, vertexCos, numVerts);
+  smoothModifier_do(smd, ctx, mesh_src, vertexCos, numVerts);
 
   if (!ELEM(mesh_src, NULL, mesh)) {
     BKE_id_free(NULL, mesh_src);
@@ -213,7 +209,7 @@ static void deformVertsEM(ModifierData *md,
   /* mesh_src is needed for vgroups, and taking edges into account. */
   mesh_src = MOD_deform_mesh_eval_get(ctx->object, editData, mesh, NULL, numVerts, false, false);
 
-  smoothModifier_do(smd, ctx->object, mesh_src, vertexCos, numVerts);
+  smoothModifier_do(smd, ctx, mesh_src, vertexCos, numVerts);
 
   if (!ELEM(mesh_src, NULL, mesh)) {
     BKE_id_free(NULL, mesh_src);
@@ -1076,9 +1076,11 @@ static bool surfacedeformBind(SurfaceDeformModifierData *smd,
     mul_v3_m4v3(data.targetCos[i], smd->mat, mvert[i].co);
   }
 
+  /* Binding a vertex does a nearest lookup and computes weights for all nearby polygons, this is
+   * expensive enough to always use threading, unlike deforming. */
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (numverts > 10000);
+  settings.min_iter_per_thread = 16;
   BLI_task_parallel_range(0, numverts, &data, bindVert, &settings);
 
   MEM_freeN(data.targetCos);
@@ -28,6 +28,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.h"
 
 #include "DNA_image_types.h"
 #include "DNA_meshdata_types.h"
@@ -43,6 +44,7 @@
 #include "BKE_library.h"
 #include "BKE_mesh.h"
 #include "BKE_object.h"
+#include "BKE_texture.h"
 
 #include "BKE_modifier.h"
 
@@ -54,6 +56,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "RE_shader_ext.h"
+
 #include "bmesh.h"
 
 void MOD_init_texture(MappingInfoModifierData *dmd, const ModifierEvalContext *ctx)
@@ -248,6 +252,83 @@ void MOD_get_vgroup(
   }
 }
 
+typedef struct DeformVertsParallelData {
+  float (*vertexCos)[3];
+  const DeformVertsParallelParams *params;
+  DeformVertFunc func;
+  void *userdata;
+} DeformVertsParallelData;
+
+static void deform_verts_parallel_task(void *__restrict userdata,
+                                       const int iter,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DeformVertsParallelData *data = userdata;
+  const DeformVertsParallelParams *params = data->params;
+  float weight = 1.0f;
+
+  if (params->dvert) {
+    weight = defvert_find_weight(&params->dvert[iter], params->defgrp_index);
+    if (params->invert_vgroup) {
+      weight = 1.0f - weight;
+    }
+    if (weight == 0.0f) {
+      return;
+    }
+  }
+
+  data->func(data->userdata, params, iter, data->vertexCos[iter], weight);
+}
+
+/**
+ * Run \a func for every vertex with a non-zero vertex group weight, in parallel for big meshes.
+ * Takes care of the image pool needed to sample \a params->texture from multiple threads,
+ * see #MOD_deform_verts_texture_get.
+ */
+void MOD_deform_verts_parallel(float (*vertexCos)[3],
+                               const int numVerts,
+                               DeformVertsParallelParams *params,
+                               DeformVertFunc func,
+                               void *userdata)
+{
+  DeformVertsParallelData data = {
+      .vertexCos = vertexCos,
+      .params = params,
+      .func = func,
+      .userdata = userdata,
+  };
+
+  params->pool = NULL;
+  if (params->texture != NULL) {
+    params->pool = BKE_image_pool_new();
+    BKE_texture_fetch_images_for_pool(params->texture, params->pool);
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numVerts > 512);
+  BLI_task_parallel_range(0, numVerts, &data, deform_verts_parallel_task, &settings);
+
+  if (params->pool != NULL) {
+    BKE_image_pool_free(params->pool);
+    params->pool = NULL;
+  }
+}
+
+/* Sample the texture of a #MOD_deform_verts_parallel call at the coordinates of a vertex. */
+void MOD_deform_verts_texture_get(const DeformVertsParallelParams *params,
+                                  const int index,
+                                  struct TexResult *r_texres)
+{
+  r_texres->nor = NULL;
+  BKE_texture_get_value_ex(params->scene,
+                           params->texture,
+                           (float *)params->tex_co[index],
+                           r_texres,
+                           params->pool,
+                           false);
+}
+
 /* only called by BKE_modifier.h/modifier.c */
 void modifier_type_init(ModifierTypeInfo *types[])
 {
@@ -26,11 +26,15 @@
 
 #include "DEG_depsgraph_build.h"
 
+struct ImagePool;
 struct MDeformVert;
 struct Mesh;
 struct ModifierData;
 struct ModifierEvalContext;
 struct Object;
+struct Scene;
+struct Tex;
+struct TexResult;
 
 void MOD_init_texture(struct MappingInfoModifierData *dmd, const struct ModifierEvalContext *ctx);
 void MOD_get_texture_coords(struct MappingInfoModifierData *dmd,
@@ -56,4 +60,33 @@ void MOD_get_vgroup(struct Object *ob,
                     struct MDeformVert **dvert,
                     int *defgrp_index);
 
+typedef struct DeformVertsParallelParams {
+  /* Optional vertex group, vertices with a zero weight are skipped. */
+  const struct MDeformVert *dvert;
+  int defgrp_index;
+  bool invert_vgroup;
+
+  /* Optional texture, sampled with #MOD_deform_verts_texture_get. */
+  struct Scene *scene;
+  struct Tex *texture;
+  const float (*tex_co)[3];
+  struct ImagePool *pool;
+} DeformVertsParallelParams;
+
+/* Deform a single vertex, weight is 1.0 when no vertex group is used. */
+typedef void (*DeformVertFunc)(void *__restrict userdata,
+                               const DeformVertsParallelParams *params,
+                               const int index,
+                               float co[3],
+                               const float weight);
+
+void MOD_deform_verts_parallel(float (*vertexCos)[3],
+                               const int numVerts,
+                               DeformVertsParallelParams *params,
+                               DeformVertFunc func,
+                               void *userdata);
+void MOD_deform_verts_texture_get(const DeformVertsParallelParams *params,
+                                  const int index,
+                                  struct TexResult *r_texres);
+
 #endif /* __MOD_UTIL_H__ */
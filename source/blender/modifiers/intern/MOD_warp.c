@@ -153,6 +153,100 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
   }
 }
 
+typedef struct WarpUserdata {
+  const WarpModifierData *wmd;
+  float falloff_radius_sq;
+  float strength;
+  float mat_from[4][4];
+  float mat_from_inv[4][4];
+  float mat_unit[4][4];
+  float mat_final[4][4];
+} WarpUserdata;
+
+static void warpModifier_do_vert(void *__restrict userdata,
+                                 const DeformVertsParallelParams *params,
+                                 const int i,
+                                 float co[3],
+                                 const float vgroup_weight)
+{
+  const WarpUserdata *data = userdata;
+  const WarpModifierData *wmd = data->wmd;
+  float fac = 1.0f;
+
+  if (wmd->falloff_type == eWarp_Falloff_None ||
+      ((fac = len_squared_v3v3(co, data->mat_from[3])) < data->falloff_radius_sq &&
+       (fac = (wmd->falloff_radius - sqrtf(fac)) / wmd->falloff_radius))) {
+    const float weight = vgroup_weight * data->strength;
+    if (params->dvert && weight <= 0.0f) {
+      return;
+    }
+
+    /* closely match PROP_SMOOTH and similar */
+    switch (wmd->falloff_type) {
+      case eWarp_Falloff_None:
+        fac = 1.0f;
+        break;
+      case eWarp_Falloff_Curve:
+        fac = BKE_curvemapping_evaluateF(wmd->curfalloff, 0, fac);
+        break;
+      case eWarp_Falloff_Sharp:
+        fac = fac * fac;
+        break;
+      case eWarp_Falloff_Smooth:
+        fac = 3.0f * fac * fac - 2.0f * fac * fac * fac;
+        break;
+      case eWarp_Falloff_Root:
+        fac = sqrtf(fac);
+        break;
+      case eWarp_Falloff_Linear:
+        /* pass */
+        break;
+      case eWarp_Falloff_Const:
+        fac = 1.0f;
+        break;
+      case eWarp_Falloff_Sphere:
+        fac = sqrtf(2 * fac - fac * fac);
+        break;
+      case eWarp_Falloff_InvSquare:
+        fac = fac * (2.0f - fac);
+        break;
+    }
+
+    fac *= weight;
+
+    if (params->texture) {
+      TexResult texres;
+      MOD_deform_verts_texture_get(params, i, &texres);
+      fac *= texres.tin;
+    }
+
+    if (fac != 0.0f) {
+      /* into the 'from' objects space */
+      mul_m4_v3(data->mat_from_inv, co);
+
+      if (fac == 1.0f) {
+        mul_m4_v3(data->mat_final, co);
+      }
+      else {
+        if (wmd->flag & MOD_WARP_VOLUME_PRESERVE) {
+          /* interpolate the matrix for nicer locations */
+          float tmat[4][4];
+          blend_m4_m4m4(tmat, data->mat_unit, data->mat_final, fac);
+          mul_m4_v3(tmat, co);
+        }
+        else {
+          float tvec[3];
+          mul_v3_m4v3(tvec, data->mat_final, co);
+          interp_v3_v3v3(co, co, tvec, fac);
+        }
+      }
+
+      /* out of the 'from' objects space */
+      mul_m4_v3(data->mat_from, co);
+    }
+  }
+}
+
 static void warpModifier_do(WarpModifierData *wmd,
                             const ModifierEvalContext *ctx,
                             Mesh *mesh,
@@ -161,23 +255,19 @@ static void warpModifier_do(WarpModifierData *wmd,
 {
   Object *ob = ctx->object;
   float obinv[4][4];
-  float mat_from[4][4];
-  float mat_from_inv[4][4];
   float mat_to[4][4];
-  float mat_unit[4][4];
-  float mat_final[4][4];
-
   float tmat[4][4];
-
-  const float falloff_radius_sq = SQUARE(wmd->falloff_radius);
-  float strength = wmd->strength;
-  float fac = 1.0f, weight;
-  int i;
   int defgrp_index;
-  MDeformVert *dvert, *dv = NULL;
+  MDeformVert *dvert;
 
   float(*tex_co)[3] = NULL;
 
+  WarpUserdata data = {
+      .wmd = wmd,
+      .falloff_radius_sq = SQUARE(wmd->falloff_radius),
+      .strength = wmd->strength,
+  };
+
   if (!(wmd->object_from && wmd->object_to)) {
     return;
   }
@@ -197,26 +287,25 @@ static void warpModifier_do(WarpModifierData *wmd,
 
   invert_m4_m4(obinv, ob->obmat);
 
-  mul_m4_m4m4(mat_from, obinv, wmd->object_from->obmat);
+  mul_m4_m4m4(data.mat_from, obinv, wmd->object_from->obmat);
   mul_m4_m4m4(mat_to, obinv, wmd->object_to->obmat);
 
-  invert_m4_m4(tmat, mat_from);  // swap?
-  mul_m4_m4m4(mat_final, tmat, mat_to);
+  invert_m4_m4(tmat, data.mat_from);  // swap?
+  mul_m4_m4m4(data.mat_final, tmat, mat_to);
 
-  invert_m4_m4(mat_from_inv, mat_from);
+  invert_m4_m4(data.mat_from_inv, data.mat_from);
 
-  unit_m4(mat_unit);
+  unit_m4(data.mat_unit);
 
-  if (strength < 0.0f) {
+  if (data.strength < 0.0f) {
     float loc[3];
-    strength = -strength;
+    data.strength = -data.strength;
 
     /* inverted location is not useful, just use the negative */
-    copy_v3_v3(loc, mat_final[3]);
-    invert_m4(mat_final);
-    negate_v3_v3(mat_final[3], loc);
+    copy_v3_v3(loc, data.mat_final[3]);
+    invert_m4(data.mat_final);
+    negate_v3_v3(data.mat_final[3], loc);
   }
-  weight = strength;
 
   Tex *tex_target = wmd->texture;
   if (mesh != NULL && tex_target != NULL) {
@@ -226,87 +315,14 @@ static void warpModifier_do(WarpModifierData *wmd,
     MOD_init_texture((MappingInfoModifierData *)wmd, ctx);
   }
 
-  for (i = 0; i < numVerts; i++) {
-    float *co = vertexCos[i];
-
-    if (wmd->falloff_type == eWarp_Falloff_None ||
-        ((fac = len_squared_v3v3(co, mat_from[3])) < falloff_radius_sq &&
-         (fac = (wmd->falloff_radius - sqrtf(fac)) / wmd->falloff_radius))) {
-      /* skip if no vert group found */
-      if (defgrp_index != -1) {
-        dv = &dvert[i];
-        weight = defvert_find_weight(dv, defgrp_index) * strength;
-        if (weight <= 0.0f) {
-          continue;
-        }
-      }
-
-      /* closely match PROP_SMOOTH and similar */
-      switch (wmd->falloff_type) {
-        case eWarp_Falloff_None:
-          fac = 1.0f;
-          break;
-        case eWarp_Falloff_Curve:
-          fac = BKE_curvemapping_evaluateF(wmd->curfalloff, 0, fac);
-          break;
-        case eWarp_Falloff_Sharp:
-          fac = fac * fac;
-          break;
-        case eWarp_Falloff_Smooth:
-          fac = 3.0f * fac * fac - 2.0f * fac * fac * fac;
-          break;
-        case eWarp_Falloff_Root:
-          fac = sqrtf(fac);
-          break;
-        case eWarp_Falloff_Linear:
-          /* pass */
-          break;
-        case eWarp_Falloff_Const:
-          fac = 1.0f;
-          break;
-        case eWarp_Falloff_Sphere:
-          fac = sqrtf(2 * fac - fac * fac);
-          break;
-        case eWarp_Falloff_InvSquare:
-          fac = fac * (2.0f - fac);
-          break;
-      }
-
-      fac *= weight;
-
-      if (tex_co) {
-        struct Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
-        TexResult texres;
-        texres.nor = NULL;
-        BKE_texture_get_value(scene, tex_target, tex_co[i], &texres, false);
-        fac *= texres.tin;
-      }
-
-      if (fac != 0.0f) {
-        /* into the 'from' objects space */
-        mul_m4_v3(mat_from_inv, co);
-
-        if (fac == 1.0f) {
-          mul_m4_v3(mat_final, co);
-        }
-        else {
-          if (wmd->flag & MOD_WARP_VOLUME_PRESERVE) {
-            /* interpolate the matrix for nicer locations */
-            blend_m4_m4m4(tmat, mat_unit, mat_final, fac);
-            mul_m4_v3(tmat, co);
-          }
-          else {
-            float tvec[3];
-            mul_v3_m4v3(tvec, mat_final, co);
-            interp_v3_v3v3(co, co, tvec, fac);
-          }
-        }
-
-        /* out of the 'from' objects space */
-        mul_m4_v3(mat_from, co);
-      }
-    }
-  }
+  DeformVertsParallelParams params = {
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .scene = DEG_get_evaluated_scene(ctx->depsgraph),
+      .texture = tex_co ? tex_target : NULL,
+      .tex_co = (const float(*)[3])tex_co,
+  };
+  MOD_deform_verts_parallel(vertexCos, numVerts, &params, warpModifier_do_vert, &data);
 
   if (tex_co) {
     MEM_freeN(tex_co);
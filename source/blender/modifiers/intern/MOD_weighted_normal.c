@@ -565,8 +565,11 @@ static Mesh *applyModifier(ModifierData *md, const ModifierEvalContext *ctx, Mes
     return mesh;
   }
 
-  Mesh *result;
-  BKE_id_copy_ex(NULL, &mesh->id, (ID **)&result, LIB_ID_COPY_LOCALIZE);
+  /* The mesh is modified in place. Only the layers written below are un-shared in case they
+   * reference another mesh, all other layers (UV's, colors, weights...) are left untouched. */
+  Mesh *result = mesh;
+  result->mvert = CustomData_duplicate_referenced_layer(&result->vdata, CD_MVERT, result->totvert);
+  result->medge = CustomData_duplicate_referenced_layer(&result->edata, CD_MEDGE, result->totedge);
 
   const int numVerts = result->totvert;
   const int numEdges = result->totedge;
@@ -596,7 +599,7 @@ static Mesh *applyModifier(ModifierData *md, const ModifierEvalContext *ctx, Mes
   }
 
   CustomData *pdata = &result->pdata;
-  float(*polynors)[3] = CustomData_get_layer(pdata, CD_NORMAL);
+  float(*polynors)[3] = CustomData_duplicate_referenced_layer(pdata, CD_NORMAL, numPolys);
   if (!polynors) {
     polynors = CustomData_add_layer(pdata, CD_NORMAL, CD_CALLOC, NULL, numPolys);
     CustomData_set_layer_flag(pdata, CD_NORMAL, CD_FLAG_TEMPORARY);
@@ -607,7 +610,7 @@ static Mesh *applyModifier(ModifierData *md, const ModifierEvalContext *ctx, Mes
   const float split_angle = mesh->smoothresh;
   short(*clnors)[2];
   CustomData *ldata = &result->ldata;
-  clnors = CustomData_get_layer(ldata, CD_CUSTOMLOOPNORMAL);
+  clnors = CustomData_duplicate_referenced_layer(ldata, CD_CUSTOMLOOPNORMAL, numLoops);
 
   /* Keep info  whether we had clnors,
    * it helps when generating clnor spaces and default normals. */
@@ -144,6 +144,7 @@ void weightvg_do_mask(const ModifierEvalContext *ctx,
   if (texture != NULL) {
     /* The texture coordinates. */
     float(*tex_co)[3];
+    TexResult *texres_all;
     /* See mapping note below... */
     MappingInfoModifierData t_map;
     const int numVerts = mesh->totvert;
@@ -163,17 +164,29 @@ void weightvg_do_mask(const ModifierEvalContext *ctx,
 
     MOD_init_texture(&t_map, ctx);
 
+    /* Only sample the texture at the affected vertices. */
+    if (indices) {
+      float(*tex_co_indices)[3] = MEM_malloc_arrayN(num, sizeof(*tex_co), __func__);
+      for (i = 0; i < num; i++) {
+        copy_v3_v3(tex_co_indices[i], tex_co[indices[i]]);
+      }
+      MEM_freeN(tex_co);
+      tex_co = tex_co_indices;
+    }
+
+    texres_all = MEM_malloc_arrayN(num, sizeof(*texres_all), __func__);
+    BKE_texture_get_values(scene,
+                           texture,
+                           (const float(*)[3])tex_co,
+                           num,
+                           texres_all,
+                           tex_use_channel != MOD_WVG_MASK_TEX_USE_INT);
+
     /* For each weight (vertex), make the mix between org and new weights. */
     for (i = 0; i < num; i++) {
-      int idx = indices ? indices[i] : i;
-      TexResult texres;
+      TexResult texres = texres_all[i];
       float hsv[3]; /* For HSV color space. */
-      bool do_color_manage;
-
-      do_color_manage = tex_use_channel != MOD_WVG_MASK_TEX_USE_INT;
 
-      texres.nor = NULL;
-      BKE_texture_get_value(scene, texture, tex_co[idx], &texres, do_color_manage);
       /* Get the good channel value... */
       switch (tex_use_channel) {
         case MOD_WVG_MASK_TEX_USE_INT:
@@ -209,6 +222,7 @@ void weightvg_do_mask(const ModifierEvalContext *ctx,
       }
     }
 
+    MEM_freeN(texres_all);
     MEM_freeN(tex_co);
   }
   else if ((ref_didx = defgroup_name_index(ob, defgrp_name)) != -1) {
@@ -25,6 +25,7 @@
 
 extern "C" {
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_texture_types.h"
@@ -717,6 +718,185 @@ BLI_INLINE float hair_volume_density_divergence(float density,
   }
 }
 
+#define MARGIN_i0 (i < 1)
+#define MARGIN_j0 (j < 1)
+#define MARGIN_k0 (k < 1)
+#define MARGIN_i1 (i >= resA[0] - 1)
+#define MARGIN_j1 (j >= resA[1] - 1)
+#define MARGIN_k1 (k >= resA[2] - 1)
+
+#define NEIGHBOR_MARGIN_i0 (i < 2)
+#define NEIGHBOR_MARGIN_j0 (j < 2)
+#define NEIGHBOR_MARGIN_k0 (k < 2)
+#define NEIGHBOR_MARGIN_i1 (i >= resA[0] - 2)
+#define NEIGHBOR_MARGIN_j1 (j >= resA[1] - 2)
+#define NEIGHBOR_MARGIN_k1 (k >= resA[2] - 2)
+
+/* Shared by the divergence and pressure gradient passes, which run in parallel over the grid
+ * slices along the z axis. */
+struct HairVolumeSolveData {
+  HairGrid *grid;
+  HairGridVert *vert_start;
+  const int *resA;
+  int stride1, stride2;
+  int strideA1, strideA2;
+
+  float flowfac, inv_flowfac;
+  float target_density, target_strength;
+  lVector *B;
+  const lVector *p;
+};
+
+/* Local names used by the margin macros. */
+#define HAIR_VOLUME_SOLVE_DATA_LOCALS(data) \
+  HairGridVert *vert_start = (data)->vert_start; \
+  const int *resA = (data)->resA; \
+  const int stride0 = 1, stride1 = (data)->stride1, stride2 = (data)->stride2; \
+  const int strideA0 = 1, strideA1 = (data)->strideA1, strideA2 = (data)->strideA2
+
+static void hair_volume_divergence_cb(void *__restrict userdata,
+                                      const int k,
+                                      const TaskParallelTLS *__restrict /*tls*/)
+{
+  HairVolumeSolveData *data = (HairVolumeSolveData *)userdata;
+  HAIR_VOLUME_SOLVE_DATA_LOCALS(data);
+  const float flowfac = data->flowfac;
+  const float target_density = data->target_density;
+  const float target_strength = data->target_strength;
+  lVector &B = *data->B;
+
+  for (int j = 0; j < resA[1]; j++) {
+    for (int i = 0; i < resA[0]; i++) {
+      int u = i * strideA0 + j * strideA1 + k * strideA2;
+      bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
+                       MARGIN_k1;
+
+      if (is_margin) {
+        B[u] = 0.0f;
+        continue;
+      }
+
+      HairGridVert *vert = vert_start + i * stride0 + j * stride1 + k * stride2;
+
+      const float *v0 = vert->velocity;
+      float dx = 0.0f, dy = 0.0f, dz = 0.0f;
+      if (!NEIGHBOR_MARGIN_i0) {
+        dx += v0[0] - (vert - stride0)->velocity[0];
+      }
+      if (!NEIGHBOR_MARGIN_i1) {
+        dx += (vert + stride0)->velocity[0] - v0[0];
+      }
+      if (!NEIGHBOR_MARGIN_j0) {
+        dy += v0[1] - (vert - stride1)->velocity[1];
+      }
+      if (!NEIGHBOR_MARGIN_j1) {
+        dy += (vert + stride1)->velocity[1] - v0[1];
+      }
+      if (!NEIGHBOR_MARGIN_k0) {
+        dz += v0[2] - (vert - stride2)->velocity[2];
+      }
+      if (!NEIGHBOR_MARGIN_k1) {
+        dz += (vert + stride2)->velocity[2] - v0[2];
+      }
+
+      float divergence = -0.5f * flowfac * (dx + dy + dz);
+
+      /* adjustment term for target density */
+      float target = hair_volume_density_divergence(
+          vert->density, target_density, target_strength);
+
+      /* B vector contains the finite difference approximation of the velocity divergence.
+       * Note: according to the discretized Navier-Stokes equation the rhs vector
+       * and resulting pressure gradient should be multiplied by the (inverse) density;
+       * however, this is already included in the weighting of hair velocities on the grid!
+       */
+      B[u] = divergence - target;
+
+#if 0
+      {
+        float wloc[3], loc[3];
+        float col0[3] = {0.0, 0.0, 0.0};
+        float colp[3] = {0.0, 1.0, 1.0};
+        float coln[3] = {1.0, 0.0, 1.0};
+        float col[3];
+        float fac;
+
+        loc[0] = (float)(i - 1);
+        loc[1] = (float)(j - 1);
+        loc[2] = (float)(k - 1);
+        grid_to_world(data->grid, wloc, loc);
+
+        if (divergence > 0.0f) {
+          fac = CLAMPIS(divergence * target_strength, 0.0, 1.0);
+          interp_v3_v3v3(col, col0, colp, fac);
+        }
+        else {
+          fac = CLAMPIS(-divergence * target_strength, 0.0, 1.0);
+          interp_v3_v3v3(col, col0, coln, fac);
+        }
+        if (fac > 0.05f) {
+          BKE_sim_debug_data_add_circle(data->grid->debug_data,
+                                        wloc,
+                                        0.01f,
+                                        col[0],
+                                        col[1],
+                                        col[2],
+                                        "grid",
+                                        5522,
+                                        i,
+                                        j,
+                                        k);
+        }
+      }
+#endif
+    }
+  }
+}
+
+static void hair_volume_pressure_gradient_cb(void *__restrict userdata,
+                                             const int k,
+                                             const TaskParallelTLS *__restrict /*tls*/)
+{
+  HairVolumeSolveData *data = (HairVolumeSolveData *)userdata;
+  HAIR_VOLUME_SOLVE_DATA_LOCALS(data);
+  const float inv_flowfac = data->inv_flowfac;
+  const lVector &p = *data->p;
+
+  for (int j = 0; j < resA[1]; j++) {
+    for (int i = 0; i < resA[0]; i++) {
+      int u = i * strideA0 + j * strideA1 + k * strideA2;
+      bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
+                       MARGIN_k1;
+      if (is_margin) {
+        continue;
+      }
+
+      HairGridVert *vert = vert_start + i * stride0 + j * stride1 + k * stride2;
+      if (vert->density > density_threshold) {
+        float p_left = p[u - strideA0];
+        float p_right = p[u + strideA0];
+        float p_down = p[u - strideA1];
+        float p_up = p[u + strideA1];
+        float p_bottom = p[u - strideA2];
+        float p_top = p[u + strideA2];
+
+        /* finite difference estimate of pressure gradient */
+        float dvel[3];
+        dvel[0] = p_right - p_left;
+        dvel[1] = p_up - p_down;
+        dvel[2] = p_top - p_bottom;
+        mul_v3_fl(dvel, -0.5f * inv_flowfac);
+
+        /* pressure gradient describes velocity delta */
+        add_v3_v3v3(vert->velocity_smooth, vert->velocity, dvel);
+      }
+      else {
+        zero_v3(vert->velocity_smooth);
+      }
+    }
+  }
+}
+
 bool BPH_hair_volume_solve_divergence(HairGrid *grid,
                                       float /*dt*/,
                                       float target_density,
@@ -743,102 +923,21 @@ bool BPH_hair_volume_solve_divergence(HairGrid *grid,
   HairGridVert *vert;
   int i, j, k;
 
-#define MARGIN_i0 (i < 1)
-#define MARGIN_j0 (j < 1)
-#define MARGIN_k0 (k < 1)
-#define MARGIN_i1 (i >= resA[0] - 1)
-#define MARGIN_j1 (j >= resA[1] - 1)
-#define MARGIN_k1 (k >= resA[2] - 1)
-
-#define NEIGHBOR_MARGIN_i0 (i < 2)
-#define NEIGHBOR_MARGIN_j0 (j < 2)
-#define NEIGHBOR_MARGIN_k0 (k < 2)
-#define NEIGHBOR_MARGIN_i1 (i >= resA[0] - 2)
-#define NEIGHBOR_MARGIN_j1 (j >= resA[1] - 2)
-#define NEIGHBOR_MARGIN_k1 (k >= resA[2] - 2)
-
   BLI_assert(num_cells >= 1);
 
   /* Calculate divergence */
   lVector B(num_cellsA);
-  for (k = 0; k < resA[2]; k++) {
-    for (j = 0; j < resA[1]; j++) {
-      for (i = 0; i < resA[0]; i++) {
-        int u = i * strideA0 + j * strideA1 + k * strideA2;
-        bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
-                         MARGIN_k1;
-
-        if (is_margin) {
-          B[u] = 0.0f;
-          continue;
-        }
-
-        vert = vert_start + i * stride0 + j * stride1 + k * stride2;
-
-        const float *v0 = vert->velocity;
-        float dx = 0.0f, dy = 0.0f, dz = 0.0f;
-        if (!NEIGHBOR_MARGIN_i0) {
-          dx += v0[0] - (vert - stride0)->velocity[0];
-        }
-        if (!NEIGHBOR_MARGIN_i1) {
-          dx += (vert + stride0)->velocity[0] - v0[0];
-        }
-        if (!NEIGHBOR_MARGIN_j0) {
-          dy += v0[1] - (vert - stride1)->velocity[1];
-        }
-        if (!NEIGHBOR_MARGIN_j1) {
-          dy += (vert + stride1)->velocity[1] - v0[1];
-        }
-        if (!NEIGHBOR_MARGIN_k0) {
-          dz += v0[2] - (vert - stride2)->velocity[2];
-        }
-        if (!NEIGHBOR_MARGIN_k1) {
-          dz += (vert + stride2)->velocity[2] - v0[2];
-        }
-
-        float divergence = -0.5f * flowfac * (dx + dy + dz);
-
-        /* adjustment term for target density */
-        float target = hair_volume_density_divergence(
-            vert->density, target_density, target_strength);
-
-        /* B vector contains the finite difference approximation of the velocity divergence.
-         * Note: according to the discretized Navier-Stokes equation the rhs vector
-         * and resulting pressure gradient should be multiplied by the (inverse) density;
-         * however, this is already included in the weighting of hair velocities on the grid!
-         */
-        B[u] = divergence - target;
-
-#if 0
-        {
-          float wloc[3], loc[3];
-          float col0[3] = {0.0, 0.0, 0.0};
-          float colp[3] = {0.0, 1.0, 1.0};
-          float coln[3] = {1.0, 0.0, 1.0};
-          float col[3];
-          float fac;
-
-          loc[0] = (float)(i - 1);
-          loc[1] = (float)(j - 1);
-          loc[2] = (float)(k - 1);
-          grid_to_world(grid, wloc, loc);
-
-          if (divergence > 0.0f) {
-            fac = CLAMPIS(divergence * target_strength, 0.0, 1.0);
-            interp_v3_v3v3(col, col0, colp, fac);
-          }
-          else {
-            fac = CLAMPIS(-divergence * target_strength, 0.0, 1.0);
-            interp_v3_v3v3(col, col0, coln, fac);
-          }
-          if (fac > 0.05f) {
-            BKE_sim_debug_data_add_circle(
-                grid->debug_data, wloc, 0.01f, col[0], col[1], col[2], "grid", 5522, i, j, k);
-          }
-        }
-#endif
-      }
-    }
+  {
+    HairVolumeSolveData data = {grid, vert_start, resA, stride1, stride2, strideA1, strideA2};
+    data.flowfac = flowfac;
+    data.target_density = target_density;
+    data.target_strength = target_strength;
+    data.B = &B;
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 2;
+    BLI_task_parallel_range(0, resA[2], &data, hair_volume_divergence_cb, &settings);
   }
 
   /* Main Poisson equation system:
@@ -852,8 +951,10 @@ bool BPH_hair_volume_solve_divergence(HairGrid *grid,
   /* Reserve space for the base equation system (without boundary conditions).
    * Each column contains a factor 6 on the diagonal
    * and up to 6 factors -1 on other places.
+   * Only the lower triangle is read by the (symmetric) conjugate gradient solver,
+   * so only the diagonal and the factors below it are stored.
    */
-  A.reserve(Eigen::VectorXi::Constant(num_cellsA, 7));
+  A.reserve(Eigen::VectorXi::Constant(num_cellsA, 4));
 
   for (k = 0; k < resA[2]; k++) {
     for (j = 0; j < resA[1]; j++) {
@@ -864,26 +965,11 @@ bool BPH_hair_volume_solve_divergence(HairGrid *grid,
 
         vert = vert_start + i * stride0 + j * stride1 + k * stride2;
         if (!is_margin && vert->density > density_threshold) {
-          int neighbors_lo = 0;
           int neighbors_hi = 0;
           int non_solid_neighbors = 0;
-          int neighbor_lo_index[3];
           int neighbor_hi_index[3];
           int n;
 
-          /* check for upper bounds in advance
-           * to get the correct number of neighbors,
-           * needed for the diagonal element
-           */
-          if (!NEIGHBOR_MARGIN_k0 && (vert - stride2)->density > density_threshold) {
-            neighbor_lo_index[neighbors_lo++] = u - strideA2;
-          }
-          if (!NEIGHBOR_MARGIN_j0 && (vert - stride1)->density > density_threshold) {
-            neighbor_lo_index[neighbors_lo++] = u - strideA1;
-          }
-          if (!NEIGHBOR_MARGIN_i0 && (vert - stride0)->density > density_threshold) {
-            neighbor_lo_index[neighbors_lo++] = u - strideA0;
-          }
           if (!NEIGHBOR_MARGIN_i1 && (vert + stride0)->density > density_threshold) {
             neighbor_hi_index[neighbors_hi++] = u + strideA0;
           }
@@ -897,9 +983,6 @@ bool BPH_hair_volume_solve_divergence(HairGrid *grid,
           /*int liquid_neighbors = neighbors_lo + neighbors_hi;*/
           non_solid_neighbors = 6;
 
-          for (n = 0; n < neighbors_lo; n++) {
-            A.insert(neighbor_lo_index[n], u) = -1.0f;
-          }
           A.insert(u, u) = (float)non_solid_neighbors;
           for (n = 0; n < neighbors_hi; n++) {
             A.insert(neighbor_hi_index[n], u) = -1.0f;
@@ -922,41 +1005,14 @@ bool BPH_hair_volume_solve_divergence(HairGrid *grid,
 
   if (cg.info() == Eigen::Success) {
     /* Calculate velocity = grad(p) */
-    for (k = 0; k < resA[2]; k++) {
-      for (j = 0; j < resA[1]; j++) {
-        for (i = 0; i < resA[0]; i++) {
-          int u = i * strideA0 + j * strideA1 + k * strideA2;
-          bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
-                           MARGIN_k1;
-          if (is_margin) {
-            continue;
-          }
-
-          vert = vert_start + i * stride0 + j * stride1 + k * stride2;
-          if (vert->density > density_threshold) {
-            float p_left = p[u - strideA0];
-            float p_right = p[u + strideA0];
-            float p_down = p[u - strideA1];
-            float p_up = p[u + strideA1];
-            float p_bottom = p[u - strideA2];
-            float p_top = p[u + strideA2];
-
-            /* finite difference estimate of pressure gradient */
-            float dvel[3];
-            dvel[0] = p_right - p_left;
-            dvel[1] = p_up - p_down;
-            dvel[2] = p_top - p_bottom;
-            mul_v3_fl(dvel, -0.5f * inv_flowfac);
-
-            /* pressure gradient describes velocity delta */
-            add_v3_v3v3(vert->velocity_smooth, vert->velocity, dvel);
-          }
-          else {
-            zero_v3(vert->velocity_smooth);
-          }
-        }
-      }
-    }
+    HairVolumeSolveData data = {grid, vert_start, resA, stride1, stride2, strideA1, strideA2};
+    data.inv_flowfac = inv_flowfac;
+    data.p = &p;
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 2;
+    BLI_task_parallel_range(0, resA[2], &data, hair_volume_pressure_gradient_cb, &settings);
 
 #if 0
     {
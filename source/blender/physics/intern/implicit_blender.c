@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -638,6 +639,105 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/* Blocks of a sparse symmetric big matrix sorted by the row of the product they contribute to,
+ * so rows of a product can be computed in parallel. Per row, the blocks are in the same order
+ * as in mul_bfmatrix_lfvector, which keeps the results identical. */
+typedef struct BlockRowIndex {
+  unsigned int *transposed_start, *transposed_blocks; /* Lower triangle blocks, transposed. */
+  unsigned int *blocks_start, *blocks;
+} BlockRowIndex;
+
+static void block_row_index_build(BlockRowIndex *rows, fmatrix3x3 *matrix)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int tot_blocks = matrix[0].vcount + matrix[0].scount;
+  unsigned int *transposed_fill = MEM_calloc_arrayN(vcount, sizeof(unsigned int), __func__);
+  unsigned int *blocks_fill = MEM_calloc_arrayN(vcount, sizeof(unsigned int), __func__);
+  unsigned int i;
+
+  rows->transposed_start = MEM_calloc_arrayN(vcount + 1, sizeof(unsigned int), __func__);
+  rows->blocks_start = MEM_calloc_arrayN(vcount + 1, sizeof(unsigned int), __func__);
+
+  for (i = vcount; i < tot_blocks; i++) {
+    rows->transposed_start[matrix[i].c + 1]++;
+  }
+  for (i = 0; i < tot_blocks; i++) {
+    rows->blocks_start[matrix[i].r + 1]++;
+  }
+  for (i = 0; i < vcount; i++) {
+    rows->transposed_start[i + 1] += rows->transposed_start[i];
+    rows->blocks_start[i + 1] += rows->blocks_start[i];
+  }
+
+  rows->transposed_blocks = MEM_malloc_arrayN(
+      max_ii(matrix[0].scount, 1), sizeof(unsigned int), __func__);
+  rows->blocks = MEM_malloc_arrayN(tot_blocks, sizeof(unsigned int), __func__);
+
+  for (i = vcount; i < tot_blocks; i++) {
+    const unsigned int c = matrix[i].c;
+    rows->transposed_blocks[rows->transposed_start[c] + transposed_fill[c]++] = i;
+  }
+  for (i = 0; i < tot_blocks; i++) {
+    const unsigned int r = matrix[i].r;
+    rows->blocks[rows->blocks_start[r] + blocks_fill[r]++] = i;
+  }
+
+  MEM_freeN(transposed_fill);
+  MEM_freeN(blocks_fill);
+}
+
+static void block_row_index_free(BlockRowIndex *rows)
+{
+  MEM_freeN(rows->transposed_start);
+  MEM_freeN(rows->transposed_blocks);
+  MEM_freeN(rows->blocks_start);
+  MEM_freeN(rows->blocks);
+}
+
+typedef struct MulBFMatrixData {
+  float (*to)[3];
+  fmatrix3x3 *from;
+  const BlockRowIndex *rows;
+  lfVector *fLongVector;
+} MulBFMatrixData;
+
+static void mul_bfmatrix_lfvector_row_cb(void *__restrict userdata,
+                                         const int row,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MulBFMatrixData *data = userdata;
+  fmatrix3x3 *from = data->from;
+  const BlockRowIndex *rows = data->rows;
+  float transposed[3] = {0.0f, 0.0f, 0.0f};
+  float temp[3] = {0.0f, 0.0f, 0.0f};
+  unsigned int j;
+
+  for (j = rows->transposed_start[row]; j < rows->transposed_start[row + 1]; j++) {
+    const fmatrix3x3 *block = &from[rows->transposed_blocks[j]];
+    muladd_fmatrixT_fvector(transposed, (float(*)[3])block->m, data->fLongVector[block->r]);
+  }
+  for (j = rows->blocks_start[row]; j < rows->blocks_start[row + 1]; j++) {
+    const fmatrix3x3 *block = &from[rows->blocks[j]];
+    muladd_fmatrix_fvector(temp, (float(*)[3])block->m, data->fLongVector[block->c]);
+  }
+
+  add_v3_v3v3(data->to[row], transposed, temp);
+}
+
+/* Same as mul_bfmatrix_lfvector, threaded over rows using an index of the matrix blocks. */
+static void mul_bfmatrix_lfvector_rows(float (*to)[3],
+                                       fmatrix3x3 *from,
+                                       const BlockRowIndex *rows,
+                                       lfVector *fLongVector)
+{
+  MulBFMatrixData data = {to, from, rows, fLongVector};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, from[0].vcount, &data, mul_bfmatrix_lfvector_row_cb, &settings);
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix*/
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -840,6 +940,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BlockRowIndex *rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -867,7 +968,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_rows(AdV, lA, rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -890,7 +991,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_rows(q, lA, rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1150,7 +1251,11 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* A and dFdX share the block layout of the springs added for this step. */
+  BlockRowIndex rows;
+  block_row_index_build(&rows, data->A);
+
+  mul_bfmatrix_lfvector_rows(dFdXmV, data->dFdX, &rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1159,7 +1264,7 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &rows, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -1171,6 +1276,7 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
   // advance velocities
   add_lfvector_lfvector(data->Vnew, data->V, data->dV, numverts);
 
+  block_row_index_free(&rows);
   del_lfvector(dFdXmV);
 
   return result->status == BPH_SOLVER_SUCCESS;
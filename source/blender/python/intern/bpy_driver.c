@@ -96,6 +96,26 @@ int bpy_pydriver_create_dict(void)
   PyObject *mod_math = mod;
 #endif
 
+  /* Functions the simple expression evaluator supports as well (see BLI_expr_pylike_eval.c),
+   * so expressions give the same result whichever way they are evaluated. */
+  {
+    PyObject *ret = PyRun_String(
+        "def clamp(value, min_value=0.0, max_value=1.0):\n"
+        "    return min(max(value, min_value), max_value)\n"
+        "def lerp(from_value, to_value, factor):\n"
+        "    return from_value + (to_value - from_value) * factor\n",
+        Py_file_input,
+        d,
+        d);
+    if (ret) {
+      Py_DECREF(ret);
+    }
+    else {
+      PyErr_Print();
+      PyErr_Clear();
+    }
+  }
+
   /* add bpy to global namespace */
   mod = PyImport_ImportModuleLevel("bpy", NULL, NULL, NULL, 0);
   if (mod) {
@@ -126,6 +146,9 @@ int bpy_pydriver_create_dict(void)
         "pow",
         "round",
         "sum",
+        /* driver namespace (numeric) */
+        "clamp",
+        "lerp",
         /* types */
         "bool",
         "float",
@@ -117,6 +117,9 @@ struct Render {
 
   /* render engine */
   struct RenderEngine *engine;
+  /* Depsgraph of the render engine kept between the frames of an animation render, so that only
+   * the data tagged by the frame change is evaluated again. */
+  Depsgraph *engine_depsgraph;
 
   /* NOTE: This is a minimal dependency graph and evaluated scene which is enough to access view
    * layer visibility and use for post-precessing (compositor and sequencer). */
@@ -66,6 +66,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -308,11 +309,59 @@ static void barycentric_differentials_from_position(const float co[3],
   }
 }
 
+/* Number of pixels of which the rays are cast together. */
+#define BAKE_RAY_BATCH_SIZE (1 << 16)
+
+/**
+ * Cast the rays of a batch of pixels against all highpoly objects,
+ * \a hits holds \a rays_num hits for every highpoly object.
+ */
+static void cast_rays_highpoly(BVHTreeFromMesh *treeData,
+                               BakeHighPolyData *highpoly,
+                               const float (*co)[3],
+                               const float (*dir)[3],
+                               float (*co_high)[3],
+                               float (*dir_high)[3],
+                               const int rays_num,
+                               BVHTreeRayHit *hits,
+                               const int tot_highpoly)
+{
+  for (int i = 0; i < tot_highpoly; i++) {
+    BVHTreeRayHit *hits_high = &hits[i * rays_num];
+
+    for (int j = 0; j < rays_num; j++) {
+      hits_high[j].index = -1;
+      /* TODO: we should use FLT_MAX here, but sweepsphere code isn't prepared for that */
+      hits_high[j].dist = BVH_RAYCAST_DIST_MAX;
+
+      /* transform the ray from the world space to the highpoly space */
+      mul_v3_m4v3(co_high[j], highpoly[i].imat, co[j]);
+
+      /* rotates */
+      mul_v3_mat3_m4v3(dir_high[j], highpoly[i].imat, dir[j]);
+      normalize_v3(dir_high[j]);
+    }
+
+    /* cast rays */
+    if (treeData[i].tree) {
+      BLI_bvhtree_ray_cast_batch(treeData[i].tree,
+                                 co_high,
+                                 dir_high,
+                                 rays_num,
+                                 0.0f,
+                                 hits_high,
+                                 treeData[i].raycast_callback,
+                                 &treeData[i],
+                                 BVH_RAYCAST_DEFAULT | BVH_RAYCAST_USE_THREADING);
+    }
+  }
+}
+
 /**
  * This function populates pixel_array and returns TRUE if things are correct
+ * \param hits: The hits of this pixel's ray, for every highpoly object \a hits_stride apart.
  */
-static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
-                              TriTessFace *triangle_low,
+static bool cast_ray_highpoly(TriTessFace *triangle_low,
                               TriTessFace *triangles[],
                               BakePixel *pixel_array_low,
                               BakePixel *pixel_array,
@@ -320,6 +369,8 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
                               BakeHighPolyData *highpoly,
                               const float co[3],
                               const float dir[3],
+                              const BVHTreeRayHit *hits,
+                              const int hits_stride,
                               const int pixel_id,
                               const int tot_highpoly)
 {
@@ -327,40 +378,15 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
   int hit_mesh = -1;
   float hit_distance = FLT_MAX;
 
-  BVHTreeRayHit *hits;
-  hits = MEM_mallocN(sizeof(BVHTreeRayHit) * tot_highpoly, "Bake Highpoly to Lowpoly: BVH Rays");
-
   for (i = 0; i < tot_highpoly; i++) {
-    float co_high[3], dir_high[3];
+    const BVHTreeRayHit *hit = &hits[i * hits_stride];
 
-    hits[i].index = -1;
-    /* TODO: we should use FLT_MAX here, but sweepsphere code isn't prepared for that */
-    hits[i].dist = BVH_RAYCAST_DIST_MAX;
-
-    /* transform the ray from the world space to the highpoly space */
-    mul_v3_m4v3(co_high, highpoly[i].imat, co);
-
-    /* rotates */
-    mul_v3_mat3_m4v3(dir_high, highpoly[i].imat, dir);
-    normalize_v3(dir_high);
-
-    /* cast ray */
-    if (treeData[i].tree) {
-      BLI_bvhtree_ray_cast(treeData[i].tree,
-                           co_high,
-                           dir_high,
-                           0.0f,
-                           &hits[i],
-                           treeData[i].raycast_callback,
-                           &treeData[i]);
-    }
-
-    if (hits[i].index != -1) {
+    if (hit->index != -1) {
       float distance;
       float hit_world[3];
 
       /* distance comparison in world space */
-      mul_v3_m4v3(hit_world, highpoly[i].obmat, hits[i].co);
+      mul_v3_m4v3(hit_world, highpoly[i].obmat, hit->co);
       distance = len_squared_v3v3(hit_world, co);
 
       if (distance < hit_distance) {
@@ -371,7 +397,8 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
   }
 
   if (hit_mesh != -1) {
-    int primitive_id_high = hits[hit_mesh].index;
+    const BVHTreeRayHit *hit = &hits[hit_mesh * hits_stride];
+    int primitive_id_high = hit->index;
     TriTessFace *triangle_high = &triangles[hit_mesh][primitive_id_high];
     BakePixel *pixel_low = &pixel_array_low[pixel_id];
     BakePixel *pixel_high = &pixel_array[pixel_id];
@@ -407,7 +434,7 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
     madd_v3_v3fl(dyco, tmp, -dot_v3v3(dyco, triangle_high->normal));
 
     /* compute barycentric differentials from position differentials */
-    barycentric_differentials_from_position(hits[hit_mesh].co,
+    barycentric_differentials_from_position(hit->co,
                                             triangle_high->mverts[0]->co,
                                             triangle_high->mverts[1]->co,
                                             triangle_high->mverts[2]->co,
@@ -431,10 +458,108 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
     pixel_array[pixel_id].object_id = -1;
   }
 
-  MEM_freeN(hits);
   return hit_mesh != -1;
 }
 
+/* Rays of a batch of pixels, shared by the threads setting up rays and processing hits. */
+typedef struct BakeRayBatch {
+  BakePixel *pixel_array_from;
+  BakePixel *pixel_array_to;
+  BakeHighPolyData *highpoly;
+  int tot_highpoly;
+  TriTessFace *tris_low;
+  TriTessFace *tris_cage;
+  TriTessFace **tris_high;
+  float (*mat_low)[4];
+  float (*imat_low)[4];
+  float (*mat_cage)[4];
+  bool is_custom_cage;
+  bool is_cage;
+  float cage_extrusion;
+
+  int rays_num;
+  const size_t *pixel;
+  float (*co)[3];
+  float (*dir)[3];
+  TriTessFace **tri_low;
+  const BVHTreeRayHit *hits;
+} BakeRayBatch;
+
+static void bake_ray_batch_setup_cb(void *__restrict userdata,
+                                    const int j,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BakeRayBatch *batch = userdata;
+  const BakePixel *pixel_from = &batch->pixel_array_from[batch->pixel[j]];
+  const int primitive_id = pixel_from->primitive_id;
+  const float u = pixel_from->uv[0];
+  const float v = pixel_from->uv[1];
+
+  /* calculate from low poly mesh cage */
+  if (batch->is_custom_cage) {
+    calc_point_from_barycentric_cage(batch->tris_low,
+                                     batch->tris_cage,
+                                     batch->mat_low,
+                                     batch->mat_cage,
+                                     primitive_id,
+                                     u,
+                                     v,
+                                     batch->co[j],
+                                     batch->dir[j]);
+    batch->tri_low[j] = &batch->tris_cage[primitive_id];
+  }
+  else if (batch->is_cage) {
+    calc_point_from_barycentric_extrusion(batch->tris_cage,
+                                          batch->mat_low,
+                                          batch->imat_low,
+                                          primitive_id,
+                                          u,
+                                          v,
+                                          batch->cage_extrusion,
+                                          batch->co[j],
+                                          batch->dir[j],
+                                          true);
+    batch->tri_low[j] = &batch->tris_cage[primitive_id];
+  }
+  else {
+    calc_point_from_barycentric_extrusion(batch->tris_low,
+                                          batch->mat_low,
+                                          batch->imat_low,
+                                          primitive_id,
+                                          u,
+                                          v,
+                                          batch->cage_extrusion,
+                                          batch->co[j],
+                                          batch->dir[j],
+                                          false);
+    batch->tri_low[j] = &batch->tris_low[primitive_id];
+  }
+}
+
+static void bake_ray_batch_hits_cb(void *__restrict userdata,
+                                   const int j,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BakeRayBatch *batch = userdata;
+  const size_t pixel_id = batch->pixel[j];
+
+  if (!cast_ray_highpoly(batch->tri_low[j],
+                         batch->tris_high,
+                         batch->pixel_array_from,
+                         batch->pixel_array_to,
+                         batch->mat_low,
+                         batch->highpoly,
+                         batch->co[j],
+                         batch->dir[j],
+                         &batch->hits[j],
+                         batch->rays_num,
+                         pixel_id,
+                         batch->tot_highpoly)) {
+    /* if it fails mask out the original pixel array */
+    batch->pixel_array_from[pixel_id].primitive_id = -1;
+  }
+}
+
 /**
  * This function populates an array of verts for the triangles of a mesh
  * Tangent and Normals are also stored
@@ -525,8 +650,6 @@ bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
                                           struct Mesh *me_cage)
 {
   size_t i;
-  int primitive_id;
-  float u, v;
   float imat_low[4][4];
   bool is_cage = me_cage != NULL;
   bool result = true;
@@ -580,55 +703,81 @@ bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
     }
   }
 
-  for (i = 0; i < num_pixels; i++) {
-    float co[3];
-    float dir[3];
-    TriTessFace *tri_low;
-
-    primitive_id = pixel_array_from[i].primitive_id;
-
-    if (primitive_id == -1) {
-      pixel_array_to[i].primitive_id = -1;
-      continue;
-    }
+  /* Rays of a batch of pixels are cast together, which is faster than one at a time. */
+  const size_t batch_size = min_zz(num_pixels, BAKE_RAY_BATCH_SIZE);
+  float(*batch_co)[3] = MEM_mallocN(sizeof(*batch_co) * batch_size, __func__);
+  float(*batch_dir)[3] = MEM_mallocN(sizeof(*batch_dir) * batch_size, __func__);
+  float(*batch_co_high)[3] = MEM_mallocN(sizeof(*batch_co_high) * batch_size, __func__);
+  float(*batch_dir_high)[3] = MEM_mallocN(sizeof(*batch_dir_high) * batch_size, __func__);
+  TriTessFace **batch_tri_low = MEM_mallocN(sizeof(*batch_tri_low) * batch_size, __func__);
+  size_t *batch_pixel = MEM_mallocN(sizeof(*batch_pixel) * batch_size, __func__);
+  BVHTreeRayHit *batch_hits = MEM_mallocN(sizeof(*batch_hits) * batch_size * (size_t)tot_highpoly,
+                                          "Bake Highpoly to Lowpoly: BVH Rays");
+
+  BakeRayBatch batch = {
+      .pixel_array_from = pixel_array_from,
+      .pixel_array_to = pixel_array_to,
+      .highpoly = highpoly,
+      .tot_highpoly = tot_highpoly,
+      .tris_low = tris_low,
+      .tris_cage = tris_cage,
+      .tris_high = tris_high,
+      .mat_low = mat_low,
+      .imat_low = imat_low,
+      .mat_cage = mat_cage,
+      .is_custom_cage = is_custom_cage,
+      .is_cage = is_cage,
+      .cage_extrusion = cage_extrusion,
+      .pixel = batch_pixel,
+      .co = batch_co,
+      .dir = batch_dir,
+      .tri_low = batch_tri_low,
+      .hits = batch_hits,
+  };
 
-    u = pixel_array_from[i].uv[0];
-    v = pixel_array_from[i].uv[1];
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
 
-    /* calculate from low poly mesh cage */
-    if (is_custom_cage) {
-      calc_point_from_barycentric_cage(
-          tris_low, tris_cage, mat_low, mat_cage, primitive_id, u, v, co, dir);
-      tri_low = &tris_cage[primitive_id];
-    }
-    else if (is_cage) {
-      calc_point_from_barycentric_extrusion(
-          tris_cage, mat_low, imat_low, primitive_id, u, v, cage_extrusion, co, dir, true);
-      tri_low = &tris_cage[primitive_id];
-    }
-    else {
-      calc_point_from_barycentric_extrusion(
-          tris_low, mat_low, imat_low, primitive_id, u, v, cage_extrusion, co, dir, false);
-      tri_low = &tris_low[primitive_id];
-    }
+  for (size_t batch_start = 0; batch_start < num_pixels; batch_start += batch_size) {
+    const size_t batch_end = min_zz(batch_start + batch_size, num_pixels);
+    int rays_num = 0;
 
-    /* cast ray */
-    if (!cast_ray_highpoly(treeData,
-                           tri_low,
-                           tris_high,
-                           pixel_array_from,
-                           pixel_array_to,
-                           mat_low,
-                           highpoly,
-                           co,
-                           dir,
-                           i,
-                           tot_highpoly)) {
-      /* if it fails mask out the original pixel array */
-      pixel_array_from[i].primitive_id = -1;
+    for (i = batch_start; i < batch_end; i++) {
+      if (pixel_array_from[i].primitive_id == -1) {
+        pixel_array_to[i].primitive_id = -1;
+        continue;
+      }
+      batch_pixel[rays_num++] = i;
     }
+    batch.rays_num = rays_num;
+
+    /* Ray setup and hit processing are independent per pixel, so they are threaded like the
+     * ray casts themselves. */
+    BLI_task_parallel_range(0, rays_num, &batch, bake_ray_batch_setup_cb, &settings);
+
+    /* cast rays */
+    cast_rays_highpoly(treeData,
+                       highpoly,
+                       batch_co,
+                       batch_dir,
+                       batch_co_high,
+                       batch_dir_high,
+                       rays_num,
+                       batch_hits,
+                       tot_highpoly);
+
+    BLI_task_parallel_range(0, rays_num, &batch, bake_ray_batch_hits_cb, &settings);
   }
 
+  MEM_freeN(batch_co);
+  MEM_freeN(batch_dir);
+  MEM_freeN(batch_co_high);
+  MEM_freeN(batch_dir_high);
+  MEM_freeN(batch_tri_low);
+  MEM_freeN(batch_pixel);
+  MEM_freeN(batch_hits);
+
   /* garbage collection */
 cleanup:
   for (i = 0; i < tot_highpoly; i++) {
@@ -681,15 +830,78 @@ static void bake_differentials(BakeDataZSpan *bd,
   }
 }
 
+typedef struct BakeRasterizeData {
+  const Mesh *me;
+  const MLoopTri *looptri;
+  int tottri;
+  const MLoopUV *mloopuv;
+  const BakeImages *bake_images;
+  BakePixel *pixel_array;
+} BakeRasterizeData;
+
+/* Rasterize the triangles of one image, the pixels of every image are stored apart so images
+ * are rasterized in parallel. */
+static void bake_rasterize_image_cb(void *__restrict userdata,
+                                    const int image_id,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BakeRasterizeData *data = userdata;
+  const BakeImages *bake_images = data->bake_images;
+  BakeDataZSpan bd;
+  ZSpan zspan;
+  int a, p_id;
+
+  bd.pixel_array = data->pixel_array;
+  bd.bk_image = &bake_images->data[image_id];
+  bd.zspan = &zspan;
+
+  zbuf_alloc_span(&zspan, bd.bk_image->width, bd.bk_image->height);
+
+  p_id = -1;
+  for (int i = 0; i < data->tottri; i++) {
+    const MLoopTri *lt = &data->looptri[i];
+    const MPoly *mp = &data->me->mpoly[lt->poly];
+    float vec[3][2];
+    int mat_nr = mp->mat_nr;
+
+    if (bake_images->lookup[mat_nr] < 0) {
+      continue;
+    }
+
+    /* primitive ids count the triangles of all images */
+    ++p_id;
+
+    if (bake_images->lookup[mat_nr] != image_id) {
+      continue;
+    }
+
+    bd.primitive_id = p_id;
+
+    for (a = 0; a < 3; a++) {
+      const float *uv = data->mloopuv[lt->tri[a]].uv;
+
+      /* Note, workaround for pixel aligned UVs which are common and can screw up our
+       * intersection tests where a pixel gets in between 2 faces or the middle of a quad,
+       * camera aligned quads also have this problem but they are less common.
+       * Add a small offset to the UVs, fixes bug #18685 - Campbell */
+      vec[a][0] = uv[0] * (float)bd.bk_image->width - (0.5f + 0.001f);
+      vec[a][1] = uv[1] * (float)bd.bk_image->height - (0.5f + 0.002f);
+    }
+
+    bake_differentials(&bd, vec[0], vec[1], vec[2]);
+    zspan_scanconvert(&zspan, (void *)&bd, vec[0], vec[1], vec[2], store_bake_pixel);
+  }
+
+  zbuf_free_span(&zspan);
+}
+
 void RE_bake_pixels_populate(Mesh *me,
                              BakePixel pixel_array[],
                              const size_t num_pixels,
                              const BakeImages *bake_images,
                              const char *uv_layer)
 {
-  BakeDataZSpan bd;
   size_t i;
-  int a, p_id;
 
   const MLoopUV *mloopuv;
   const int tottri = poly_to_tri_count(me->totpoly, me->totloop);
@@ -707,59 +919,31 @@ void RE_bake_pixels_populate(Mesh *me,
     return;
   }
 
-  bd.pixel_array = pixel_array;
-  bd.zspan = MEM_callocN(sizeof(ZSpan) * bake_images->size, "bake zspan");
-
   /* initialize all pixel arrays so we know which ones are 'blank' */
   for (i = 0; i < num_pixels; i++) {
     pixel_array[i].primitive_id = -1;
     pixel_array[i].object_id = 0;
   }
 
-  for (i = 0; i < bake_images->size; i++) {
-    zbuf_alloc_span(&bd.zspan[i], bake_images->data[i].width, bake_images->data[i].height);
-  }
-
   looptri = MEM_mallocN(sizeof(*looptri) * tottri, __func__);
 
   BKE_mesh_recalc_looptri(me->mloop, me->mpoly, me->mvert, me->totloop, me->totpoly, looptri);
 
-  p_id = -1;
-  for (i = 0; i < tottri; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const MPoly *mp = &me->mpoly[lt->poly];
-    float vec[3][2];
-    int mat_nr = mp->mat_nr;
-    int image_id = bake_images->lookup[mat_nr];
-
-    if (image_id < 0) {
-      continue;
-    }
-
-    bd.bk_image = &bake_images->data[image_id];
-    bd.primitive_id = ++p_id;
-
-    for (a = 0; a < 3; a++) {
-      const float *uv = mloopuv[lt->tri[a]].uv;
-
-      /* Note, workaround for pixel aligned UVs which are common and can screw up our
-       * intersection tests where a pixel gets in between 2 faces or the middle of a quad,
-       * camera aligned quads also have this problem but they are less common.
-       * Add a small offset to the UVs, fixes bug #18685 - Campbell */
-      vec[a][0] = uv[0] * (float)bd.bk_image->width - (0.5f + 0.001f);
-      vec[a][1] = uv[1] * (float)bd.bk_image->height - (0.5f + 0.002f);
-    }
-
-    bake_differentials(&bd, vec[0], vec[1], vec[2]);
-    zspan_scanconvert(&bd.zspan[image_id], (void *)&bd, vec[0], vec[1], vec[2], store_bake_pixel);
-  }
+  BakeRasterizeData data = {
+      .me = me,
+      .looptri = looptri,
+      .tottri = tottri,
+      .mloopuv = mloopuv,
+      .bake_images = bake_images,
+      .pixel_array = pixel_array,
+  };
 
-  for (i = 0; i < bake_images->size; i++) {
-    zbuf_free_span(&bd.zspan[i]);
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (bake_images->size > 1);
+  BLI_task_parallel_range(0, bake_images->size, &data, bake_rasterize_image_cb, &settings);
 
   MEM_freeN(looptri);
-  MEM_freeN(bd.zspan);
 }
 
 /* ******************** NORMALS ************************ */
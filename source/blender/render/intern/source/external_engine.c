@@ -34,6 +34,7 @@
 #include "BLI_listbase.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_system.h"
 
 #include "DNA_object_types.h"
 
@@ -504,10 +505,41 @@ RenderData *RE_engine_get_render_data(Render *re)
 }
 
 /* Depsgraph */
+/* Draw engines keep the evaluated data and its GPU batches between the frames of an animation,
+ * objects which are not changed by the frame change are not extracted again. Other engines keep
+ * it with persistent data, and can then only synchronize IDs which were updated. */
+static bool engine_depsgraph_keep(RenderEngine *engine)
+{
+  Render *re = engine->re;
+  return (re->flag & R_ANIMATION) && !(re->r.scemode & R_BUTS_PREVIEW) &&
+         ((engine->type->draw_engine != NULL) || (re->r.mode & R_PERSISTENT_DATA));
+}
+
+/* Leave the update flags of the frame change for the engine to query, they are cleared once the
+ * engine is done with the depsgraph. */
+static bool engine_depsgraph_keep_recalc(RenderEngine *engine)
+{
+  return engine_depsgraph_keep(engine) && (engine->type->draw_engine == NULL);
+}
+
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
   Main *bmain = engine->re->main;
   Scene *scene = engine->re->scene;
+  Render *re = engine->re;
+
+  if (re->engine_depsgraph != NULL) {
+    if (engine_depsgraph_keep(engine) &&
+        (DEG_get_input_view_layer(re->engine_depsgraph) == view_layer)) {
+      engine->depsgraph = re->engine_depsgraph;
+      re->engine_depsgraph = NULL;
+      BKE_scene_graph_update_for_newframe_ex(
+          engine->depsgraph, bmain, !engine_depsgraph_keep_recalc(engine));
+      return;
+    }
+    DEG_graph_free(re->engine_depsgraph);
+    re->engine_depsgraph = NULL;
+  }
 
   engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
   DEG_debug_name_set(engine->depsgraph, "RENDER");
@@ -520,13 +552,27 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
     DEG_ids_clear_recalc(bmain, depsgraph);
   }
   else {
-    BKE_scene_graph_update_for_newframe(engine->depsgraph, bmain);
+    BKE_scene_graph_update_for_newframe_ex(
+        engine->depsgraph, bmain, !engine_depsgraph_keep_recalc(engine));
   }
 }
 
 static void engine_depsgraph_free(RenderEngine *engine)
 {
-  DEG_graph_free(engine->depsgraph);
+  if (engine->depsgraph == NULL) {
+    return;
+  }
+
+  if (engine_depsgraph_keep(engine)) {
+    BLI_assert(engine->re->engine_depsgraph == NULL);
+    if (engine_depsgraph_keep_recalc(engine)) {
+      DEG_ids_clear_recalc(engine->re->main, engine->depsgraph);
+    }
+    engine->re->engine_depsgraph = engine->depsgraph;
+  }
+  else {
+    DEG_graph_free(engine->depsgraph);
+  }
 
   engine->depsgraph = NULL;
 }
@@ -655,6 +701,34 @@ bool RE_bake_engine(Render *re,
 
 /* Render */
 
+/* Check whether the full frame render result would take a large part of the system memory,
+ * in that case finished tiles are written to disk as with Save Buffers. The estimate only
+ * counts a 4 channel pass per layer and view, actual results usually have more passes. */
+static bool engine_render_result_exceeds_memory(Render *re)
+{
+#ifdef WITH_OPENEXR
+  const size_t num_pixels = (size_t)BLI_rcti_size_x(&re->disprect) *
+                            (size_t)BLI_rcti_size_y(&re->disprect);
+  const size_t num_views = BKE_scene_multiview_num_views_get(&re->r);
+  size_t num_layers = 0;
+
+  FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer) {
+    num_layers++;
+  }
+  FOREACH_VIEW_LAYER_TO_RENDER_END;
+
+  const size_t memory_in_megabytes = num_pixels * num_views * MAX2(num_layers, 1) * 4 *
+                                     sizeof(float) / (1024 * 1024);
+  if (memory_in_megabytes > BLI_system_memory_max_in_megabytes() / 4) {
+    printf("Render result needs %dMB, saving buffers to disk\n", (int)memory_in_megabytes);
+    return true;
+  }
+#else
+  UNUSED_VARS(re);
+#endif
+  return false;
+}
+
 int RE_engine_render(Render *re, int do_all)
 {
   RenderEngineType *type = RE_engines_find(re->r.engine);
@@ -695,7 +769,8 @@ int RE_engine_render(Render *re, int do_all)
       render_result_free(re->result);
     }
 
-    if ((type->flag & RE_USE_SAVE_BUFFERS) && (re->r.scemode & R_EXR_TILE_FILE)) {
+    if ((type->flag & RE_USE_SAVE_BUFFERS) &&
+        ((re->r.scemode & R_EXR_TILE_FILE) || engine_render_result_exceeds_memory(re))) {
       savebuffers = RR_USE_EXR;
     }
     re->result = render_result_new(re, &re->disprect, 0, savebuffers, RR_ALL_LAYERS, RR_ALL_VIEWS);
@@ -882,6 +957,10 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
   if (DRW_render_check_grease_pencil(engine->depsgraph)) {
     return;
   }
+  /* The depsgraph is reused for the next frame. */
+  if (engine_depsgraph_keep(engine)) {
+    return;
+  }
   DEG_graph_free(engine->depsgraph);
   engine->depsgraph = NULL;
 }
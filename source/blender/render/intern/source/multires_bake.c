@@ -80,6 +80,8 @@ typedef struct {
   const float *precomputed_normals;
   int w, h;
   int tri_index;
+  /* Vertex normals of the triangle being rasterized. */
+  float tri_normals[3][3];
   DerivedMesh *lores_dm, *hires_dm;
   int lvl;
   void *thread_data;
@@ -100,15 +102,27 @@ typedef struct {
   short *do_update;
 } MBakeRast;
 
+/* Grids of a CCG derived mesh, looked up once instead of for every pixel. */
+typedef struct {
+  int grid_size;
+  CCGElem **grid_data;
+  int *grid_offset;
+  CCGKey key;
+} MGridData;
+
 typedef struct {
   float *heights;
   Image *ima;
   DerivedMesh *ssdm;
   const int *orig_index_mp_to_orig;
+  const MLoopTri *mlooptri;
+  MGridData hires_grids, ssdm_grids;
 } MHeightBakeData;
 
 typedef struct {
   const int *orig_index_mp_to_orig;
+  const MLoopTri *mlooptri;
+  MGridData hires_grids;
 } MNormalBakeData;
 
 static void multiresbake_get_normal(const MResolvePixelData *data,
@@ -169,9 +183,9 @@ static void flush_pixel(const MResolvePixelData *data, const int x, const int y)
   st1 = data->mloopuv[data->mlooptri[data->tri_index].tri[1]].uv;
   st2 = data->mloopuv[data->mlooptri[data->tri_index].tri[2]].uv;
 
-  multiresbake_get_normal(data, no0, data->tri_index, 0); /* can optimize these 3 into one call */
-  multiresbake_get_normal(data, no1, data->tri_index, 1);
-  multiresbake_get_normal(data, no2, data->tri_index, 2);
+  copy_v3_v3(no0, data->tri_normals[0]);
+  copy_v3_v3(no1, data->tri_normals[1]);
+  copy_v3_v3(no2, data->tri_normals[2]);
 
   resolve_tri_uv_v2(fUV, st, st0, st1, st2);
 
@@ -404,6 +418,11 @@ static void *do_multires_bake_thread(void *data_v)
 
     data->tri_index = tri_index;
 
+    /* Normals only depend on the triangle, so they are computed once for all its pixels. */
+    for (int i = 0; i < 3; i++) {
+      multiresbake_get_normal(data, data->tri_normals[i], tri_index, i);
+    }
+
     bake_rasterize(
         bake_rast, mloopuv[lt->tri[0]].uv, mloopuv[lt->tri[1]].uv, mloopuv[lt->tri[2]].uv);
 
@@ -578,7 +597,7 @@ static void do_multires_bake(MultiresBakeRender *bkr,
 /* mode = 0: interpolate normals,
  * mode = 1: interpolate coord */
 static void interp_bilinear_grid(
-    CCGKey *key, CCGElem *grid, float crn_x, float crn_y, int mode, float res[3])
+    const CCGKey *key, CCGElem *grid, float crn_x, float crn_y, int mode, float res[3])
 {
   int x0, x1, y0, y1;
   float u, v;
@@ -609,8 +628,16 @@ static void interp_bilinear_grid(
   interp_bilinear_quad_v3(data, u, v, res);
 }
 
+static void init_grid_data(MGridData *grids, DerivedMesh *hidm)
+{
+  grids->grid_size = hidm->getGridSize(hidm);
+  grids->grid_data = hidm->getGridData(hidm);
+  grids->grid_offset = hidm->getGridOffset(hidm);
+  hidm->getGridKey(hidm, &grids->key);
+}
+
 static void get_ccgdm_data(DerivedMesh *lodm,
-                           DerivedMesh *hidm,
+                           const MGridData *grids,
                            const int *index_mp_to_orig,
                            const int lvl,
                            const MLoopTri *lt,
@@ -619,18 +646,13 @@ static void get_ccgdm_data(DerivedMesh *lodm,
                            float co[3],
                            float n[3])
 {
-  CCGElem **grid_data;
-  CCGKey key;
+  CCGElem **grid_data = grids->grid_data;
+  const CCGKey *key = &grids->key;
   float crn_x, crn_y;
-  int grid_size, S, face_side;
-  int *grid_offset, g_index;
+  int grid_size = grids->grid_size, S, face_side;
+  int *grid_offset = grids->grid_offset, g_index;
   int poly_index = lt->poly;
 
-  grid_size = hidm->getGridSize(hidm);
-  grid_data = hidm->getGridData(hidm);
-  grid_offset = hidm->getGridOffset(hidm);
-  hidm->getGridKey(hidm, &key);
-
   if (lvl == 0) {
     MPoly *mpoly;
     face_side = (grid_size << 1) - 1;
@@ -675,11 +697,11 @@ static void get_ccgdm_data(DerivedMesh *lodm,
   CLAMP(crn_y, 0.0f, grid_size);
 
   if (n != NULL) {
-    interp_bilinear_grid(&key, grid_data[g_index + S], crn_x, crn_y, 0, n);
+    interp_bilinear_grid(key, grid_data[g_index + S], crn_x, crn_y, 0, n);
   }
 
   if (co != NULL) {
-    interp_bilinear_grid(&key, grid_data[g_index + S], crn_x, crn_y, 1, co);
+    interp_bilinear_grid(key, grid_data[g_index + S], crn_x, crn_y, 1, co);
   }
 }
 
@@ -773,10 +795,13 @@ static void *init_heights_data(MultiresBakeRender *bkr, Image *ima)
       height_data->ssdm = subsurf_make_derived_from_derived(
           bkr->lores_dm, &smd, bkr->scene, NULL, 0);
       init_ccgdm_arrays(height_data->ssdm);
+      init_grid_data(&height_data->ssdm_grids, height_data->ssdm);
     }
   }
 
   height_data->orig_index_mp_to_orig = lodm->getPolyDataArray(lodm, CD_ORIGINDEX);
+  height_data->mlooptri = lodm->getLoopTriArray(lodm);
+  init_grid_data(&height_data->hires_grids, bkr->hires_dm);
 
   BKE_image_release_ibuf(ima, ibuf, NULL);
 
@@ -801,7 +826,7 @@ static void free_heights_data(void *bake_data)
  *     mesh to make texture smoother) let's call this point p0 and n.
  *   - height wound be dot(n, p1-p0) */
 static void apply_heights_callback(DerivedMesh *lores_dm,
-                                   DerivedMesh *hires_dm,
+                                   DerivedMesh *UNUSED(hires_dm),
                                    void *thread_data_v,
                                    void *bake_data,
                                    ImBuf *ibuf,
@@ -812,11 +837,11 @@ static void apply_heights_callback(DerivedMesh *lores_dm,
                                    const int x,
                                    const int y)
 {
-  const MLoopTri *lt = lores_dm->getLoopTriArray(lores_dm) + tri_index;
+  MHeightBakeData *height_data = (MHeightBakeData *)bake_data;
+  const MLoopTri *lt = height_data->mlooptri + tri_index;
   MLoop *mloop = lores_dm->getLoopArray(lores_dm);
   MPoly *mpoly = lores_dm->getPolyArray(lores_dm) + lt->poly;
   MLoopUV *mloopuv = lores_dm->getLoopDataArray(lores_dm, CD_MLOOPUV);
-  MHeightBakeData *height_data = (MHeightBakeData *)bake_data;
   MultiresBakeThread *thread_data = (MultiresBakeThread *)thread_data_v;
   float uv[2], *st0, *st1, *st2, *st3;
   int pixel = ibuf->x * y + x;
@@ -841,12 +866,19 @@ static void apply_heights_callback(DerivedMesh *lores_dm,
   CLAMP(uv[0], 0.0f, 1.0f);
   CLAMP(uv[1], 0.0f, 1.0f);
 
-  get_ccgdm_data(
-      lores_dm, hires_dm, height_data->orig_index_mp_to_orig, lvl, lt, uv[0], uv[1], p1, NULL);
+  get_ccgdm_data(lores_dm,
+                 &height_data->hires_grids,
+                 height_data->orig_index_mp_to_orig,
+                 lvl,
+                 lt,
+                 uv[0],
+                 uv[1],
+                 p1,
+                 NULL);
 
   if (height_data->ssdm) {
     get_ccgdm_data(lores_dm,
-                   height_data->ssdm,
+                   &height_data->ssdm_grids,
                    height_data->orig_index_mp_to_orig,
                    0,
                    lt,
@@ -896,6 +928,8 @@ static void *init_normal_data(MultiresBakeRender *bkr, Image *UNUSED(ima))
   normal_data = MEM_callocN(sizeof(MNormalBakeData), "MultiresBake normalData");
 
   normal_data->orig_index_mp_to_orig = lodm->getPolyDataArray(lodm, CD_ORIGINDEX);
+  normal_data->mlooptri = lodm->getLoopTriArray(lodm);
+  init_grid_data(&normal_data->hires_grids, bkr->hires_dm);
 
   return (void *)normal_data;
 }
@@ -916,7 +950,7 @@ static void free_normal_data(void *bake_data)
  * - Vector in color space would be `norm(vec) / 2 + (0.5, 0.5, 0.5)`.
  */
 static void apply_tangmat_callback(DerivedMesh *lores_dm,
-                                   DerivedMesh *hires_dm,
+                                   DerivedMesh *UNUSED(hires_dm),
                                    void *UNUSED(thread_data),
                                    void *bake_data,
                                    ImBuf *ibuf,
@@ -927,10 +961,10 @@ static void apply_tangmat_callback(DerivedMesh *lores_dm,
                                    const int x,
                                    const int y)
 {
-  const MLoopTri *lt = lores_dm->getLoopTriArray(lores_dm) + tri_index;
+  MNormalBakeData *normal_data = (MNormalBakeData *)bake_data;
+  const MLoopTri *lt = normal_data->mlooptri + tri_index;
   MPoly *mpoly = lores_dm->getPolyArray(lores_dm) + lt->poly;
   MLoopUV *mloopuv = lores_dm->getLoopDataArray(lores_dm, CD_MLOOPUV);
-  MNormalBakeData *normal_data = (MNormalBakeData *)bake_data;
   float uv[2], *st0, *st1, *st2, *st3;
   int pixel = ibuf->x * y + x;
   float n[3], vec[3], tmp[3] = {0.5, 0.5, 0.5};
@@ -954,8 +988,15 @@ static void apply_tangmat_callback(DerivedMesh *lores_dm,
   CLAMP(uv[0], 0.0f, 1.0f);
   CLAMP(uv[1], 0.0f, 1.0f);
 
-  get_ccgdm_data(
-      lores_dm, hires_dm, normal_data->orig_index_mp_to_orig, lvl, lt, uv[0], uv[1], NULL, n);
+  get_ccgdm_data(lores_dm,
+                 &normal_data->hires_grids,
+                 normal_data->orig_index_mp_to_orig,
+                 lvl,
+                 lt,
+                 uv[0],
+                 uv[1],
+                 NULL,
+                 n);
 
   mul_v3_m3v3(vec, tangmat, n);
   normalize_v3_length(vec, 0.5);
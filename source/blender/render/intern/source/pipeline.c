@@ -653,6 +653,9 @@ void RE_FreeRender(Render *re)
   if (re->engine) {
     RE_engine_free(re->engine);
   }
+  if (re->engine_depsgraph != NULL) {
+    DEG_graph_free(re->engine_depsgraph);
+  }
 
   BLI_rw_mutex_end(&re->resultmutex);
   BLI_rw_mutex_end(&re->partsmutex);
@@ -2786,6 +2789,10 @@ void RE_PreviewRender(Render *re, Main *bmain, Scene *sce)
 
 void RE_CleanAfterRender(Render *re)
 {
+  if (re->engine_depsgraph != NULL) {
+    DEG_graph_free(re->engine_depsgraph);
+    re->engine_depsgraph = NULL;
+  }
   /* Destroy the opengl context in the correct thread. */
   RE_gl_context_destroy(re);
   if (re->pipeline_depsgraph != NULL) {
@@ -26,6 +26,7 @@
 extern "C" {
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_anim.h"
 #include "BKE_customdata.h"
@@ -149,9 +150,10 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
         primvar_name, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
 
     MLoopUV *mloopuv = static_cast<MLoopUV *>(layer->data);
-    pxr::VtArray<pxr::GfVec2f> uv_coords;
+    pxr::VtArray<pxr::GfVec2f> uv_coords(mesh->totloop);
+    pxr::GfVec2f *uv_coord = uv_coords.data();
     for (int loop_idx = 0; loop_idx < mesh->totloop; loop_idx++) {
-      uv_coords.push_back(pxr::GfVec2f(mloopuv[loop_idx].uv));
+      uv_coord[loop_idx] = pxr::GfVec2f(mloopuv[loop_idx].uv);
     }
 
     if (!uv_coords_primvar.HasValue()) {
@@ -260,14 +262,32 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 }
 
+struct GetVerticesData {
+  const MVert *verts;
+  pxr::GfVec3f *points;
+};
+
+static void get_vertices_cb(void *__restrict userdata,
+                            const int i,
+                            const TaskParallelTLS *__restrict /*tls*/)
+{
+  GetVerticesData *data = static_cast<GetVerticesData *>(userdata);
+  data->points[i] = pxr::GfVec3f(data->verts[i].co);
+}
+
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
+  /* Write into the array directly, appending checks whether the array is shared every time. */
+  usd_mesh_data.points.resize(mesh->totvert);
 
-  const MVert *verts = mesh->mvert;
-  for (int i = 0; i < mesh->totvert; ++i) {
-    usd_mesh_data.points.push_back(pxr::GfVec3f(verts[i].co));
-  }
+  GetVerticesData data;
+  data.verts = mesh->mvert;
+  data.points = usd_mesh_data.points.data();
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4096;
+  BLI_task_parallel_range(0, mesh->totvert, &data, get_vertices_cb, &settings);
 }
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -276,16 +296,18 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
    * assignments. */
   bool construct_face_groups = mesh->totcol > 1;
 
-  usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
-  usd_mesh_data.face_indices.reserve(mesh->totloop);
+  usd_mesh_data.face_vertex_counts.resize(mesh->totpoly);
+  usd_mesh_data.face_indices.resize(mesh->totloop);
+  int *face_vertex_count = usd_mesh_data.face_vertex_counts.data();
+  int *face_index = usd_mesh_data.face_indices.data();
 
   MLoop *mloop = mesh->mloop;
   MPoly *mpoly = mesh->mpoly;
   for (int i = 0; i < mesh->totpoly; ++i, ++mpoly) {
     MLoop *loop = mloop + mpoly->loopstart;
-    usd_mesh_data.face_vertex_counts.push_back(mpoly->totloop);
+    *face_vertex_count++ = mpoly->totloop;
     for (int j = 0; j < mpoly->totloop; ++j, ++loop) {
-      usd_mesh_data.face_indices.push_back(loop->v);
+      *face_index++ = loop->v;
     }
 
     if (construct_face_groups) {
@@ -392,13 +414,13 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
   pxr::UsdTimeCode timecode = get_export_time_code();
   const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
 
-  pxr::VtVec3fArray loop_normals;
-  loop_normals.reserve(mesh->totloop);
+  pxr::VtVec3fArray loop_normals(mesh->totloop);
+  pxr::GfVec3f *loop_normal = loop_normals.data();
 
   if (lnors != nullptr) {
     /* Export custom loop normals. */
     for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
-      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
+      loop_normal[loop_idx] = pxr::GfVec3f(lnors[loop_idx]);
     }
   }
   else {
@@ -414,14 +436,14 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
         BKE_mesh_calc_poly_normal(mpoly, mloop, mvert, normal);
         pxr::GfVec3f pxr_normal(normal);
         for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx) {
-          loop_normals.push_back(pxr_normal);
+          *loop_normal++ = pxr_normal;
         }
       }
       else {
         /* Smooth shaded, use individual vert normals. */
         for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx, ++mloop) {
           normal_short_to_float_v3(normal, mvert[mloop->v].no);
-          loop_normals.push_back(pxr::GfVec3f(normal));
+          *loop_normal++ = pxr::GfVec3f(normal);
         }
       }
     }
@@ -464,17 +486,21 @@ void USDGenericMeshWriter::write_surface_velocity(Object *object,
   }
 
   /* Export per-vertex velocity vectors. */
-  pxr::VtVec3fArray usd_velocities;
-  usd_velocities.reserve(mesh->totvert);
+  pxr::VtVec3fArray usd_velocities(mesh->totvert);
+  pxr::GfVec3f *usd_velocity = usd_velocities.data();
 
   FluidVertexVelocity *mesh_velocities = fss->meshVelocities;
   for (int vertex_idx = 0, totvert = mesh->totvert; vertex_idx < totvert;
        ++vertex_idx, ++mesh_velocities) {
-    usd_velocities.push_back(pxr::GfVec3f(mesh_velocities->vel));
+    usd_velocity[vertex_idx] = pxr::GfVec3f(mesh_velocities->vel);
   }
 
   pxr::UsdTimeCode timecode = get_export_time_code();
-  usd_mesh.CreateVelocitiesAttr().Set(usd_velocities, timecode);
+  pxr::UsdAttribute attr_velocities = usd_mesh.CreateVelocitiesAttr(pxr::VtValue(), true);
+  if (!attr_velocities.HasValue()) {
+    attr_velocities.Set(usd_velocities, pxr::UsdTimeCode::Default());
+  }
+  usd_value_writer_.SetAttribute(attr_velocities, pxr::VtValue(usd_velocities), timecode);
 }
 
 USDMeshWriter::USDMeshWriter(const USDExporterContext &ctx) : USDGenericMeshWriter(ctx)
@@ -36,6 +36,7 @@
 
 #include "BLI_utildefines.h"
 #include "BLI_blenlib.h"
+#include "BLI_trace.h"
 
 #include "BKE_context.h"
 #include "BKE_global.h"
@@ -406,7 +407,9 @@ void WM_main(bContext *C)
 {
   /* Single refresh before handling events.
    * This ensures we don't run operators before the depsgraph has been evaluated. */
+  BLI_TRACE_ZONE_BEGIN(startup);
   wm_event_do_refresh_wm_and_depsgraph(C);
+  bool is_startup = true;
 
   while (1) {
 
@@ -421,5 +424,11 @@ void WM_main(bContext *C)
 
     /* execute cached changes draw */
     wm_draw_update(C);
+
+    if (is_startup) {
+      /* The windows are interactive from here on. */
+      BLI_TRACE_ZONE_END(startup, "Startup Refresh and Draw");
+      is_startup = false;
+    }
   }
 }
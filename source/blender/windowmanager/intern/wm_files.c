@@ -1491,6 +1491,52 @@ void WM_autosave_init(wmWindowManager *wm)
   }
 }
 
+typedef struct AutosaveJob {
+  /** Copy of the undo memfile, owned by the job. */
+  struct MemFile *memfile;
+  char filepath[FILE_MAX];
+  bool use_compress;
+} AutosaveJob;
+
+static void wm_autosave_job_startjob(void *customdata,
+                                     short *stop,
+                                     short *UNUSED(do_update),
+                                     float *UNUSED(progress))
+{
+  AutosaveJob *job = customdata;
+  BLO_memfile_write_file_ex(job->memfile, job->filepath, job->use_compress, stop);
+}
+
+static void wm_autosave_job_free(void *customdata)
+{
+  AutosaveJob *job = customdata;
+  BLO_memfile_free(job->memfile);
+  MEM_freeN(job->memfile);
+  MEM_freeN(job);
+}
+
+/**
+ * Write the undo memfile from a job, so only copying it stalls the main thread.
+ */
+static void wm_autosave_job_start(wmWindowManager *wm,
+                                  const struct MemFile *memfile,
+                                  const char *filepath)
+{
+  AutosaveJob *job = MEM_callocN(sizeof(*job), __func__);
+  /* The undo stack may free the chunks while writing. */
+  job->memfile = BLO_memfile_copy(memfile);
+  BLI_strncpy(job->filepath, filepath, sizeof(job->filepath));
+  /* Compression doesn't stall the interface when written in the background. */
+  job->use_compress = (G.fileflags & G_FILE_COMPRESS) != 0;
+
+  wmJob *wm_job = WM_jobs_get(wm, NULL, wm, "Auto-Saving...", 0, WM_JOB_TYPE_AUTOSAVE);
+  WM_jobs_customdata_set(wm_job, job, wm_autosave_job_free);
+  WM_jobs_timer(wm_job, 1.0, 0, 0);
+  WM_jobs_callbacks(wm_job, wm_autosave_job_startjob, NULL, NULL, NULL);
+
+  WM_jobs_start(wm, wm_job);
+}
+
 void wm_autosave_timer(const bContext *C, wmWindowManager *wm, wmTimer *UNUSED(wt))
 {
   char filepath[FILE_MAX];
@@ -1513,13 +1559,19 @@ void wm_autosave_timer(const bContext *C, wmWindowManager *wm, wmTimer *UNUSED(w
     }
   }
 
+  /* The previous auto-save is still being written, try again in 10 seconds. */
+  if (WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    wm->autosavetimer = WM_event_add_timer(wm, NULL, TIMERAUTOSAVE, 10.0);
+    return;
+  }
+
   wm_autosave_location(filepath);
 
   if (U.uiflag & USER_GLOBALUNDO) {
     /* fast save of last undobuffer, now with UI */
     struct MemFile *memfile = ED_undosys_stack_memfile_get_active(wm->undo_stack);
     if (memfile) {
-      BLO_memfile_write_file(memfile, filepath);
+      wm_autosave_job_start(wm, memfile, filepath);
     }
   }
   else {
@@ -2543,6 +2595,13 @@ static void save_set_compress(wmOperator *op)
       RNA_property_boolean_set(op->ptr, prop, (U.flag & USER_FILECOMPRESS) != 0);
     }
   }
+
+  prop = RNA_struct_find_property(op->ptr, "compress_fast");
+  if (!RNA_property_is_set(op->ptr, prop)) {
+    if (G.save_over) { /* keep flag for existing file */
+      RNA_property_boolean_set(op->ptr, prop, (G.fileflags & G_FILE_COMPRESS_FAST) != 0);
+    }
+  }
 }
 
 static void save_set_filepath(bContext *C, wmOperator *op)
@@ -2600,6 +2659,8 @@ static int wm_save_as_mainfile_exec(bContext *C, wmOperator *op)
 
   /* set compression flag */
   SET_FLAG_FROM_TEST(fileflags, RNA_boolean_get(op->ptr, "compress"), G_FILE_COMPRESS);
+  SET_FLAG_FROM_TEST(
+      fileflags, RNA_boolean_get(op->ptr, "compress_fast"), G_FILE_COMPRESS_FAST);
   SET_FLAG_FROM_TEST(fileflags, RNA_boolean_get(op->ptr, "relative_remap"), G_FILE_RELATIVE_REMAP);
   SET_FLAG_FROM_TEST(
       fileflags,
@@ -2664,6 +2725,12 @@ void WM_OT_save_as_mainfile(wmOperatorType *ot)
                                  FILE_DEFAULTDISPLAY,
                                  FILE_SORT_ALPHA);
   RNA_def_boolean(ot->srna, "compress", false, "Compress", "Write compressed .blend file");
+  RNA_def_boolean(ot->srna,
+                  "compress_fast",
+                  false,
+                  "Fast Compression",
+                  "Compress using multiple threads, "
+                  "faster but the file can't be opened by older Blender versions");
   RNA_def_boolean(ot->srna,
                   "relative_remap",
                   true,
@@ -2736,6 +2803,12 @@ void WM_OT_save_mainfile(wmOperatorType *ot)
                                  FILE_DEFAULTDISPLAY,
                                  FILE_SORT_ALPHA);
   RNA_def_boolean(ot->srna, "compress", false, "Compress", "Write compressed .blend file");
+  RNA_def_boolean(ot->srna,
+                  "compress_fast",
+                  false,
+                  "Fast Compression",
+                  "Compress using multiple threads, "
+                  "faster but the file can't be opened by older Blender versions");
   RNA_def_boolean(ot->srna,
                   "relative_remap",
                   false,
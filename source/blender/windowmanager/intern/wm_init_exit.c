@@ -47,6 +47,7 @@
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #include "BLI_timer.h"
+#include "BLI_trace.h"
 
 #include "BLO_writefile.h"
 #include "BLO_undofile.h"
@@ -226,6 +227,7 @@ static void sound_jack_sync_callback(Main *bmain, int mode, float time)
 /* only called once, for startup */
 void WM_init(bContext *C, int argc, const char **argv)
 {
+  BLI_TRACE_ZONE_BEGIN(init);
 
   if (!G.background) {
     wm_ghost_init(C); /* note: it assigns C to ghost! */
@@ -292,6 +294,7 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   BLI_assert((G.fileflags & G_FILE_NO_UI) == 0);
 
+  BLI_TRACE_ZONE_BEGIN(homefile);
   wm_homefile_read(C,
                    NULL,
                    G.factory_startup,
@@ -301,6 +304,7 @@ void WM_init(bContext *C, int argc, const char **argv)
                    NULL,
                    WM_init_state_app_template_get(),
                    &is_factory_startup);
+  BLI_TRACE_ZONE_END(homefile, "Startup Read Home File");
 
   /* Call again to set from userpreferences... */
   BLT_lang_set(NULL);
@@ -317,13 +321,17 @@ void WM_init(bContext *C, int argc, const char **argv)
     /* sets 3D mouse deadzone */
     WM_ndof_deadzone_set(U.ndof_deadzone);
 #endif
+    BLI_TRACE_ZONE_BEGIN(opengl);
     WM_init_opengl(G_MAIN);
+    BLI_TRACE_ZONE_END(opengl, "Startup OpenGL");
 
     if (!WM_platform_support_perform_checks()) {
       exit(-1);
     }
 
+    BLI_TRACE_ZONE_BEGIN(ui);
     UI_init();
+    BLI_TRACE_ZONE_END(ui, "Startup UI");
   }
 
   ED_spacemacros_init();
@@ -338,9 +346,14 @@ void WM_init(bContext *C, int argc, const char **argv)
 
 #ifdef WITH_PYTHON
   BPY_context_set(C); /* necessary evil */
+  BLI_TRACE_ZONE_BEGIN(python);
   BPY_python_start(argc, argv);
+  BLI_TRACE_ZONE_END(python, "Startup Python");
 
+  /* Registers the scripts and enables the add-ons. */
+  BLI_TRACE_ZONE_BEGIN(scripts);
   BPY_python_reset(C);
+  BLI_TRACE_ZONE_END(scripts, "Startup Scripts and Add-ons");
 #else
   (void)argc; /* unused */
   (void)argv; /* unused */
@@ -397,6 +410,8 @@ void WM_init(bContext *C, int argc, const char **argv)
       CTX_wm_window_set(C, NULL);
     }
   }
+
+  BLI_TRACE_ZONE_END(init, "Startup Init");
 }
 
 void WM_init_splash(bContext *C)
@@ -564,6 +579,7 @@ void WM_exit_ex(bContext *C, const bool do_python)
   }
 
   BKE_sequencer_free_clipboard(); /* sequencer.c */
+  BKE_sequencer_disk_cache_free(); /* seqcache.c */
   BKE_tracking_clipboard_free();
   BKE_mask_clipboard_free();
   BKE_vfont_clipboard_free();
@@ -649,6 +665,9 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   BLI_threadapi_exit();
 
+  /* Write the trace once no thread is working anymore. */
+  BLI_trace_exit();
+
   /* No need to call this early, rather do it late so that other
    * pieces of Blender using sound may exit cleanly, see also T50676. */
   BKE_sound_exit();
@@ -290,6 +290,11 @@ int main(int argc,
     }
   }
 
+#ifdef WITH_MEM_THREAD_CACHE
+  /* Does nothing when switched to the guarded allocator above. */
+  MEM_use_thread_cache();
+#endif
+
 #ifdef BUILD_DATE
   {
     time_t temp_time = build_commit_timestamp;
@@ -102,6 +102,8 @@ TEST_PARSE_FAIL(BadArgCount2, "sqrt(1,2)")
 TEST_PARSE_FAIL(BadArgCount3, "pi()")
 TEST_PARSE_FAIL(BadArgCount4, "max()")
 TEST_PARSE_FAIL(BadArgCount5, "min()")
+TEST_PARSE_FAIL(BadArgCount6, "clamp(1,2)")
+TEST_PARSE_FAIL(BadArgCount7, "lerp(1,2)")
 
 TEST_PARSE_FAIL(Truncated1, "(1+2")
 TEST_PARSE_FAIL(Truncated2, "1 if 2")
@@ -157,6 +159,14 @@ TEST_EVAL(FMod, "fmod(x, 2)", 3.5, 1.5)
 TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
+TEST_CONST(Clamp1, "clamp(1.5)", 1.0)
+TEST_CONST(Clamp2, "clamp(-1, 0, 2)", 0.0)
+TEST_CONST(Clamp3, "clamp(1.5, 0, 2)", 1.5)
+TEST_EVAL(Clamp, "clamp(x, 0, 2)", 3.0, 2.0)
+
+TEST_CONST(Lerp, "lerp(1, 3, 0.25)", 1.5)
+TEST_EVAL(Lerp, "lerp(1, 3, x)", 0.75, 2.5)
+
 TEST_RESULT(Min1, "min(3,1,2)", 1.0)
 TEST_RESULT(Max1, "max(3,1,2)", 3.0)
 TEST_RESULT(Min2, "min(1,2,3)", 1.0)
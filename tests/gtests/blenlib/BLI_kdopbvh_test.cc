@@ -135,3 +135,137 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+/* Large enough for the bounds of the top levels to be computed in parallel. */
+TEST(kdopbvh, FindNearest_20000)
+{
+  find_nearest_points_test(20000, 1.0, 100000, 12);
+}
+
+/**
+ * Move the points of a balanced tree and update it in place,
+ * the result should be the same as a tree built from the moved points.
+ */
+static void update_tree_test(int points_len, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 4, 6);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 100000, 1.0f);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  for (int i = 0; i < points_len; i++) {
+    points[i][0] = -points[i][0] * 2.0f;
+    points[i][2] += 1.0f;
+    EXPECT_TRUE(BLI_bvhtree_update_node(tree, i, points[i], NULL, 1));
+  }
+  BLI_bvhtree_update_tree(tree);
+
+  for (int i = 0; i < points_len; i++) {
+    const int j = BLI_bvhtree_find_nearest(tree, points[i], NULL, NULL, NULL);
+    EXPECT_GE(j, 0);
+    EXPECT_LT(j, points_len);
+    EXPECT_EQ_ARRAY(points[i], points[j], 3);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+}
+
+TEST(kdopbvh, UpdateTree_1)
+{
+  update_tree_test(1, 1234);
+}
+TEST(kdopbvh, UpdateTree_500)
+{
+  update_tree_test(500, 12);
+}
+TEST(kdopbvh, UpdateTree_20000)
+{
+  update_tree_test(20000, 12);
+}
+
+/**
+ * Casting rays as a batch should find the same hits as casting them one at a time.
+ */
+static void ray_cast_batch_test(int boxes_len, int rays_len, float radius, int flag, int seed)
+{
+  struct RNG *rng = BLI_rng_new(seed);
+  BVHTree *tree = BLI_bvhtree_new(boxes_len, 0.0, 4, 6);
+
+  for (int i = 0; i < boxes_len; i++) {
+    float co[2][3];
+    rng_v3_round(co[0], 3, rng, 100000, 1.0f);
+    rng_v3_round(co[1], 3, rng, 100000, 0.05f);
+    add_v3_v3(co[1], co[0]);
+    BLI_bvhtree_insert(tree, i, co[0], 2);
+  }
+  BLI_bvhtree_balance(tree);
+
+  float(*ray_co)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  float(*ray_dir)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  BVHTreeRayHit *hits = (BVHTreeRayHit *)MEM_mallocN(sizeof(*hits) * rays_len, __func__);
+
+  for (int i = 0; i < rays_len; i++) {
+    rng_v3_round(ray_co[i], 3, rng, 100000, 2.0f);
+    rng_v3_round(ray_dir[i], 3, rng, 100000, 1.0f);
+    /* Some rays are axis aligned. */
+    if (i % 5 == 0) {
+      ray_dir[i][i % 3] = 0.0f;
+    }
+    if (normalize_v3(ray_dir[i]) == 0.0f) {
+      ray_dir[i][0] = 1.0f;
+    }
+    hits[i].index = -1;
+    hits[i].dist = (i % 3 == 0) ? 1.0f : BVH_RAYCAST_DIST_MAX;
+  }
+
+  BLI_bvhtree_ray_cast_batch(tree, ray_co, ray_dir, rays_len, radius, hits, NULL, NULL, flag);
+
+  int hits_found = 0;
+  for (int i = 0; i < rays_len; i++) {
+    BVHTreeRayHit hit;
+    hit.index = -1;
+    hit.dist = (i % 3 == 0) ? 1.0f : BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast_ex(tree, ray_co[i], ray_dir[i], radius, &hit, NULL, NULL, flag);
+    EXPECT_EQ(hits[i].index, hit.index);
+    if (hit.index != -1) {
+      hits_found++;
+      EXPECT_EQ(hits[i].dist, hit.dist);
+      EXPECT_EQ_ARRAY(hits[i].co, hit.co, 3);
+    }
+  }
+  /* Make sure the test checks something, a single small box may not be hit at all. */
+  if (boxes_len > 1) {
+    EXPECT_GT(hits_found, 0);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(ray_co);
+  MEM_freeN(ray_dir);
+  MEM_freeN(hits);
+}
+
+TEST(kdopbvh, RayCastBatch_1)
+{
+  ray_cast_batch_test(1, 7, 0.0f, BVH_RAYCAST_DEFAULT, 1234);
+}
+TEST(kdopbvh, RayCastBatch_500)
+{
+  ray_cast_batch_test(500, 1001, 0.0f, BVH_RAYCAST_DEFAULT, 12);
+}
+TEST(kdopbvh, RayCastBatch_Threaded_500)
+{
+  ray_cast_batch_test(500, 1001, 0.0f, BVH_RAYCAST_DEFAULT | BVH_RAYCAST_USE_THREADING, 123);
+}
+TEST(kdopbvh, RayCastBatch_Radius_500)
+{
+  ray_cast_batch_test(500, 1001, 0.01f, BVH_RAYCAST_DEFAULT | BVH_RAYCAST_USE_THREADING, 1);
+}
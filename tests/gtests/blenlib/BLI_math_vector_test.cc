@@ -0,0 +1,105 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_math.h"
+#include "BLI_rand.h"
+
+/* Array functions are compared against calling the single vector function on every item.
+ * Odd lengths make sure the remainder after the blocks of four is handled too. */
+#define ARRAY_LEN 67
+
+static void random_v3_array(float (*r)[3], const int len, const unsigned int seed)
+{
+  RNG *rng = BLI_rng_new(seed);
+  for (int i = 0; i < len; i++) {
+    for (int j = 0; j < 3; j++) {
+      r[i][j] = BLI_rng_get_float(rng) * 20.0f - 10.0f;
+    }
+  }
+  BLI_rng_free(rng);
+}
+
+TEST(math_vector, MinMaxArray)
+{
+  float vecs[ARRAY_LEN][3];
+  random_v3_array(vecs, ARRAY_LEN, 1);
+
+  for (int len = 0; len <= ARRAY_LEN; len++) {
+    float min[3], max[3], min_ref[3], max_ref[3];
+    INIT_MINMAX(min, max);
+    INIT_MINMAX(min_ref, max_ref);
+    minmax_v3v3_v3_array(min, max, vecs, len);
+    for (int i = 0; i < len; i++) {
+      minmax_v3v3_v3(min_ref, max_ref, vecs[i]);
+    }
+    EXPECT_V3_NEAR(min, min_ref, 0.0f);
+    EXPECT_V3_NEAR(max, max_ref, 0.0f);
+  }
+}
+
+TEST(math_vector, NormalizeArray)
+{
+  float vecs[ARRAY_LEN][3], vecs_ref[ARRAY_LEN][3];
+  random_v3_array(vecs, ARRAY_LEN, 2);
+  /* Too short vectors are zeroed. */
+  zero_v3(vecs[1]);
+  copy_v3_fl(vecs[6], 1e-20f);
+  memcpy(vecs_ref, vecs, sizeof(vecs));
+
+  normalize_v3_array(vecs, ARRAY_LEN);
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    normalize_v3(vecs_ref[i]);
+    EXPECT_V3_NEAR(vecs[i], vecs_ref[i], 1e-6f);
+  }
+  const float zero[3] = {0.0f, 0.0f, 0.0f};
+  EXPECT_V3_NEAR(vecs[1], zero, 0.0f);
+  EXPECT_V3_NEAR(vecs[6], zero, 0.0f);
+}
+
+TEST(math_vector, InterpArray)
+{
+  float a[ARRAY_LEN][3], b[ARRAY_LEN][3], r[ARRAY_LEN][3];
+  float t[ARRAY_LEN];
+  random_v3_array(a, ARRAY_LEN, 3);
+  random_v3_array(b, ARRAY_LEN, 4);
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    t[i] = (float)i / ARRAY_LEN;
+  }
+
+  interp_v3_v3v3_array(r, a, b, t, ARRAY_LEN);
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    float r_ref[3];
+    interp_v3_v3v3(r_ref, a[i], b[i], t[i]);
+    EXPECT_V3_NEAR(r[i], r_ref, 1e-6f);
+  }
+
+  /* In place. */
+  interp_v3_v3v3_array(a, a, b, t, ARRAY_LEN);
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    EXPECT_V3_NEAR(a[i], r[i], 0.0f);
+  }
+}
+
+TEST(math_vector, TransformArray)
+{
+  float vecs[ARRAY_LEN][3], r[ARRAY_LEN][3];
+  float mat[4][4];
+  random_v3_array(vecs, ARRAY_LEN, 5);
+  random_v3_array((float(*)[3])mat, 5, 6);
+  mat[0][3] = mat[1][3] = mat[2][3] = 0.0f;
+  mat[3][3] = 1.0f;
+
+  mul_v3_m4v3_array(r, mat, vecs, ARRAY_LEN);
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    float r_ref[3];
+    mul_v3_m4v3(r_ref, mat, vecs[i]);
+    EXPECT_V3_NEAR(r[i], r_ref, 1e-5f);
+  }
+
+  /* In place. */
+  mul_v3_m4v3_array(vecs, mat, vecs, ARRAY_LEN);
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    EXPECT_V3_NEAR(vecs[i], r[i], 0.0f);
+  }
+}
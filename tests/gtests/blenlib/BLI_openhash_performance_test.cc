@@ -0,0 +1,185 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+#include "BLI_ressource_strings.h"
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_ghash.h"
+#include "BLI_openhash.h"
+#include "BLI_string.h"
+#include "PIL_time_utildefines.h"
+}
+
+/* Compare the open addressing maps against GHash, using the same keys. */
+
+#define TESTCASE_SIZE 1000000
+#define LOOKUP_PASSES 10
+
+/* Pointer keys, spaced like mempool elements. */
+
+TEST(openhash, PtrGHash)
+{
+  char *data = (char *)MEM_mallocN(TESTCASE_SIZE * 32, __func__);
+  GHash *ghash = BLI_ghash_ptr_new(__func__);
+
+  TIMEIT_START(ghash_ptr_insert);
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ghash_insert(ghash, &data[i * 32], POINTER_FROM_INT(i));
+  }
+  TIMEIT_END(ghash_ptr_insert);
+
+  TIMEIT_START(ghash_ptr_lookup);
+  for (int pass = 0; pass < LOOKUP_PASSES; pass++) {
+    for (int i = 0; i < TESTCASE_SIZE; i++) {
+      EXPECT_EQ(BLI_ghash_lookup(ghash, &data[i * 32]), POINTER_FROM_INT(i));
+    }
+  }
+  TIMEIT_END(ghash_ptr_lookup);
+
+  BLI_ghash_free(ghash, NULL, NULL);
+  MEM_freeN(data);
+}
+
+TEST(openhash, PtrMap)
+{
+  char *data = (char *)MEM_mallocN(TESTCASE_SIZE * 32, __func__);
+  PtrMap *map = BLI_ptrmap_new(__func__);
+
+  TIMEIT_START(ptrmap_insert);
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ptrmap_insert(map, &data[i * 32], POINTER_FROM_INT(i));
+  }
+  TIMEIT_END(ptrmap_insert);
+
+  TIMEIT_START(ptrmap_lookup);
+  for (int pass = 0; pass < LOOKUP_PASSES; pass++) {
+    for (int i = 0; i < TESTCASE_SIZE; i++) {
+      EXPECT_EQ(BLI_ptrmap_lookup(map, &data[i * 32]), POINTER_FROM_INT(i));
+    }
+  }
+  TIMEIT_END(ptrmap_lookup);
+
+  BLI_ptrmap_free(map, NULL);
+  MEM_freeN(data);
+}
+
+/* Integer keys, in a scattered order. */
+
+#define INT_KEY(i) ((int)(((unsigned int)(i)*2654435761u) >> 1))
+
+TEST(openhash, IntGHash)
+{
+  GHash *ghash = BLI_ghash_int_new(__func__);
+
+  TIMEIT_START(ghash_int_insert);
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ghash_insert(ghash, POINTER_FROM_INT(INT_KEY(i)), POINTER_FROM_INT(i));
+  }
+  TIMEIT_END(ghash_int_insert);
+
+  TIMEIT_START(ghash_int_lookup);
+  for (int pass = 0; pass < LOOKUP_PASSES; pass++) {
+    for (int i = 0; i < TESTCASE_SIZE; i++) {
+      EXPECT_EQ(BLI_ghash_lookup(ghash, POINTER_FROM_INT(INT_KEY(i))), POINTER_FROM_INT(i));
+    }
+  }
+  TIMEIT_END(ghash_int_lookup);
+
+  BLI_ghash_free(ghash, NULL, NULL);
+}
+
+TEST(openhash, IntMap)
+{
+  IntMap *map = BLI_intmap_new(__func__);
+
+  TIMEIT_START(intmap_insert);
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_intmap_insert(map, INT_KEY(i), POINTER_FROM_INT(i));
+  }
+  TIMEIT_END(intmap_insert);
+
+  TIMEIT_START(intmap_lookup);
+  for (int pass = 0; pass < LOOKUP_PASSES; pass++) {
+    for (int i = 0; i < TESTCASE_SIZE; i++) {
+      EXPECT_EQ(BLI_intmap_lookup(map, INT_KEY(i)), POINTER_FROM_INT(i));
+    }
+  }
+  TIMEIT_END(intmap_lookup);
+
+  BLI_intmap_free(map, NULL);
+}
+
+/* String keys, words of the test text (duplicates are skipped). */
+
+static char **str_words_get(char *data, int *r_words_len)
+{
+  int words_len = 0;
+  char **words = (char **)MEM_mallocN(sizeof(*words) * (strlen(data) / 2 + 1), __func__);
+
+  for (char *p = data, *w = data; *p; p++) {
+    if (ELEM(*p, ' ', '\n', '.', ',')) {
+      *p = '\0';
+      if (*w) {
+        words[words_len++] = w;
+      }
+      w = p + 1;
+    }
+  }
+
+  *r_words_len = words_len;
+  return words;
+}
+
+TEST(openhash, StrGHash)
+{
+  char *data = BLI_strdup(words10k);
+  int words_len;
+  char **words = str_words_get(data, &words_len);
+  GHash *ghash = BLI_ghash_str_new(__func__);
+
+  TIMEIT_START(ghash_str_insert);
+  for (int i = 0; i < words_len; i++) {
+    BLI_ghash_reinsert(ghash, words[i], words[i], NULL, NULL);
+  }
+  TIMEIT_END(ghash_str_insert);
+
+  TIMEIT_START(ghash_str_lookup);
+  for (int pass = 0; pass < LOOKUP_PASSES * 10; pass++) {
+    for (int i = 0; i < words_len; i++) {
+      EXPECT_STREQ((const char *)BLI_ghash_lookup(ghash, words[i]), words[i]);
+    }
+  }
+  TIMEIT_END(ghash_str_lookup);
+
+  BLI_ghash_free(ghash, NULL, NULL);
+  MEM_freeN(words);
+  MEM_freeN(data);
+}
+
+TEST(openhash, StrMap)
+{
+  char *data = BLI_strdup(words10k);
+  int words_len;
+  char **words = str_words_get(data, &words_len);
+  StrMap *map = BLI_strmap_new(__func__);
+
+  TIMEIT_START(strmap_insert);
+  for (int i = 0; i < words_len; i++) {
+    BLI_strmap_reinsert(map, words[i], words[i]);
+  }
+  TIMEIT_END(strmap_insert);
+
+  TIMEIT_START(strmap_lookup);
+  for (int pass = 0; pass < LOOKUP_PASSES * 10; pass++) {
+    for (int i = 0; i < words_len; i++) {
+      EXPECT_STREQ((const char *)BLI_strmap_lookup(map, words[i]), words[i]);
+    }
+  }
+  TIMEIT_END(strmap_lookup);
+
+  BLI_strmap_free(map, NULL);
+  MEM_freeN(words);
+  MEM_freeN(data);
+}
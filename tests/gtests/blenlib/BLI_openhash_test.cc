@@ -0,0 +1,153 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+#include "BLI_openhash.h"
+#include "BLI_string.h"
+#include "MEM_guardedalloc.h"
+}
+
+#define TESTCASE_SIZE 10000
+
+TEST(openhash, PtrMapInsertLookup)
+{
+  PtrMap *map = BLI_ptrmap_new(__func__);
+  int *data = (int *)MEM_mallocN(sizeof(int) * TESTCASE_SIZE, __func__);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ptrmap_insert(map, &data[i], POINTER_FROM_INT(i));
+  }
+  EXPECT_EQ(BLI_ptrmap_len(map), TESTCASE_SIZE);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_ptrmap_lookup(map, &data[i])), i);
+  }
+  EXPECT_FALSE(BLI_ptrmap_haskey(map, NULL));
+  EXPECT_EQ(BLI_ptrmap_lookup_default(map, NULL, POINTER_FROM_INT(-1)), POINTER_FROM_INT(-1));
+
+  BLI_ptrmap_free(map, NULL);
+  MEM_freeN(data);
+}
+
+TEST(openhash, IntMapEnsureReinsert)
+{
+  IntMap *map = BLI_intmap_new(__func__);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    void **val_p;
+    EXPECT_FALSE(BLI_intmap_ensure_p(map, i * 7, &val_p));
+    *val_p = POINTER_FROM_INT(i);
+  }
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    void **val_p;
+    EXPECT_TRUE(BLI_intmap_ensure_p(map, i * 7, &val_p));
+    EXPECT_EQ(POINTER_AS_INT(*val_p), i);
+  }
+
+  EXPECT_FALSE(BLI_intmap_reinsert(map, 7, POINTER_FROM_INT(-1)));
+  EXPECT_TRUE(BLI_intmap_reinsert(map, -7, POINTER_FROM_INT(-1)));
+  EXPECT_EQ(BLI_intmap_len(map), TESTCASE_SIZE + 1);
+  EXPECT_EQ(BLI_intmap_lookup(map, 7), POINTER_FROM_INT(-1));
+  EXPECT_EQ(BLI_intmap_lookup(map, -7), POINTER_FROM_INT(-1));
+
+  BLI_intmap_free(map, NULL);
+}
+
+/* Remove every other key, then add them back, checking the other keys stay valid. */
+TEST(openhash, IntMapRemove)
+{
+  IntMap *map = BLI_intmap_new_ex(__func__, TESTCASE_SIZE);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_intmap_insert(map, i, POINTER_FROM_INT(i + 1));
+  }
+  for (int i = 0; i < TESTCASE_SIZE; i += 2) {
+    EXPECT_EQ(BLI_intmap_popkey(map, i), POINTER_FROM_INT(i + 1));
+    EXPECT_FALSE(BLI_intmap_remove(map, i, NULL));
+  }
+  EXPECT_EQ(BLI_intmap_len(map), TESTCASE_SIZE / 2);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(BLI_intmap_haskey(map, i), (i % 2) == 1);
+  }
+
+  for (int i = 0; i < TESTCASE_SIZE; i += 2) {
+    BLI_intmap_insert(map, i, POINTER_FROM_INT(i + 1));
+  }
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(BLI_intmap_lookup(map, i), POINTER_FROM_INT(i + 1));
+  }
+
+  BLI_intmap_clear(map, NULL);
+  EXPECT_EQ(BLI_intmap_len(map), 0);
+  EXPECT_FALSE(BLI_intmap_haskey(map, 1));
+
+  BLI_intmap_free(map, NULL);
+}
+
+/* Many removals and insertions at a stable size, reusing the removed slots. */
+TEST(openhash, IntMapChurn)
+{
+  IntMap *map = BLI_intmap_new(__func__);
+  for (int i = 0; i < 100; i++) {
+    BLI_intmap_insert(map, i, POINTER_FROM_INT(i));
+  }
+  for (int i = 100; i < TESTCASE_SIZE * 10; i++) {
+    const int key = i - 100;
+    EXPECT_EQ(BLI_intmap_popkey(map, key), POINTER_FROM_INT(key));
+    BLI_intmap_insert(map, i, POINTER_FROM_INT(i));
+  }
+  EXPECT_EQ(BLI_intmap_len(map), 100);
+
+  BLI_intmap_free(map, NULL);
+}
+
+TEST(openhash, StrMapIter)
+{
+  StrMap *map = BLI_strmap_new(__func__);
+  char keys[100][16];
+
+  for (int i = 0; i < 100; i++) {
+    BLI_snprintf(keys[i], sizeof(keys[i]), "key_%d", i);
+    BLI_strmap_insert(map, keys[i], POINTER_FROM_INT(i));
+  }
+
+  /* Lookup with a copy of the string, not the same pointer. */
+  EXPECT_EQ(BLI_strmap_lookup(map, "key_42"), POINTER_FROM_INT(42));
+  EXPECT_FALSE(BLI_strmap_haskey(map, "key_100"));
+
+  /* Iteration follows the order of insertion. */
+  StrMapIterator iter;
+  int i = 0;
+  STRMAP_ITER (iter, map) {
+    EXPECT_STREQ(BLI_strmap_iter_key(&iter), keys[i]);
+    EXPECT_EQ(BLI_strmap_iter_value(&iter), POINTER_FROM_INT(i));
+    i++;
+  }
+  EXPECT_EQ(i, 100);
+
+  BLI_strmap_free(map, NULL);
+}
+
+static void openhash_test_free_value(void *value)
+{
+  MEM_freeN(value);
+}
+
+TEST(openhash, FreeValues)
+{
+  PtrMap *map = BLI_ptrmap_new(__func__);
+  int keys[10];
+
+  for (int i = 0; i < 10; i++) {
+    BLI_ptrmap_insert(map, &keys[i], MEM_mallocN(16, __func__));
+  }
+  EXPECT_TRUE(BLI_ptrmap_remove(map, &keys[0], openhash_test_free_value));
+  BLI_ptrmap_clear_ex(map, openhash_test_free_value, 100);
+  EXPECT_EQ(BLI_ptrmap_len(map), 0);
+
+  BLI_ptrmap_insert(map, &keys[0], MEM_mallocN(16, __func__));
+  BLI_ptrmap_free(map, openhash_test_free_value);
+}
@@ -9,6 +9,7 @@ extern "C" {
 #include "BLI_utildefines.h"
 
 #include "BLI_listbase.h"
+#include "BLI_memarena_threaded.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
 
@@ -137,6 +138,145 @@ TEST(task, RangeIterPool)
   BLI_threadapi_exit();
 }
 
+/* *** Parallel reduction of range chunks. *** */
+
+static void task_range_reduce_iter_func(void *userdata,
+                                        int index,
+                                        const TaskParallelTLS *__restrict tls)
+{
+  const int *data = (const int *)userdata;
+  *((int *)tls->userdata_chunk) += data[index];
+}
+
+static void task_range_reduce_func(const void *__restrict UNUSED(userdata),
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  *(int *)chunk_join += *(int *)chunk;
+}
+
+TEST(task, RangeReduce)
+{
+  int data[NUM_ITEMS];
+  int sum = 0;
+  int expected_sum = 0;
+
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    data[i] = i % 17;
+    expected_sum += data[i];
+  }
+
+  BLI_threadapi_init();
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  settings.userdata_chunk = &sum;
+  settings.userdata_chunk_size = sizeof(sum);
+  settings.func_reduce = task_range_reduce_func;
+
+  BLI_task_parallel_range(0, NUM_ITEMS, data, task_range_reduce_iter_func, &settings);
+
+  EXPECT_EQ(sum, expected_sum);
+
+  BLI_threadapi_exit();
+}
+
+/* *** Parallel prefix sum and compaction. *** */
+
+#define NUM_SCAN_ITEMS 100000
+
+TEST(task, PrefixSum)
+{
+  int *src = (int *)MEM_mallocN(sizeof(int) * NUM_SCAN_ITEMS, __func__);
+  int *dst = (int *)MEM_mallocN(sizeof(int) * NUM_SCAN_ITEMS, __func__);
+
+  for (int i = 0; i < NUM_SCAN_ITEMS; i++) {
+    src[i] = i % 7;
+  }
+
+  BLI_threadapi_init();
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  for (int use_threading = 0; use_threading < 2; use_threading++) {
+    settings.use_threading = use_threading;
+
+    int total = BLI_task_parallel_prefix_sum_int(src, dst, NUM_SCAN_ITEMS, true, &settings);
+    int sum = 0;
+    for (int i = 0; i < NUM_SCAN_ITEMS; i++) {
+      EXPECT_EQ(dst[i], sum);
+      sum += src[i];
+    }
+    EXPECT_EQ(total, sum);
+
+    total = BLI_task_parallel_prefix_sum_int(src, dst, NUM_SCAN_ITEMS, false, &settings);
+    sum = 0;
+    for (int i = 0; i < NUM_SCAN_ITEMS; i++) {
+      sum += src[i];
+      EXPECT_EQ(dst[i], sum);
+    }
+    EXPECT_EQ(total, sum);
+  }
+
+  /* In-place scan. */
+  memcpy(dst, src, sizeof(int) * NUM_SCAN_ITEMS);
+  const int total = BLI_task_parallel_prefix_sum_int(dst, dst, NUM_SCAN_ITEMS, true, &settings);
+  int sum = 0;
+  for (int i = 0; i < NUM_SCAN_ITEMS; i++) {
+    EXPECT_EQ(dst[i], sum);
+    sum += src[i];
+  }
+  EXPECT_EQ(total, sum);
+
+  MEM_freeN(src);
+  MEM_freeN(dst);
+  BLI_threadapi_exit();
+}
+
+static bool task_filter_func(void *__restrict userdata, const int iter)
+{
+  const int *data = (const int *)userdata;
+  return (data[iter] % 3) == 0;
+}
+
+TEST(task, FilterIndices)
+{
+  int *data = (int *)MEM_mallocN(sizeof(int) * NUM_SCAN_ITEMS, __func__);
+  int *indices = (int *)MEM_mallocN(sizeof(int) * NUM_SCAN_ITEMS, __func__);
+
+  for (int i = 0; i < NUM_SCAN_ITEMS; i++) {
+    data[i] = (i * 7919) % 101;
+  }
+
+  BLI_threadapi_init();
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  for (int use_threading = 0; use_threading < 2; use_threading++) {
+    settings.use_threading = use_threading;
+
+    const int num_indices = BLI_task_parallel_filter_indices(
+        0, NUM_SCAN_ITEMS, data, task_filter_func, indices, &settings);
+
+    int expected_num_indices = 0;
+    for (int i = 0; i < NUM_SCAN_ITEMS; i++) {
+      if ((data[i] % 3) == 0) {
+        EXPECT_EQ(indices[expected_num_indices], i);
+        expected_num_indices++;
+      }
+    }
+    EXPECT_EQ(num_indices, expected_num_indices);
+  }
+
+  MEM_freeN(data);
+  MEM_freeN(indices);
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over mempool items. *** */
 
 static void task_mempool_iter_func(void *userdata, MempoolIterData *item)
@@ -206,6 +346,153 @@ TEST(task, MempoolIter)
   BLI_threadapi_exit();
 }
 
+/* *** Parallel allocation from a mempool. *** */
+
+typedef struct MempoolAllocChunk {
+  BLI_mempool_thread_cache *cache;
+} MempoolAllocChunk;
+
+typedef struct MempoolAllocData {
+  BLI_mempool *mempool;
+  int **elems;
+} MempoolAllocData;
+
+static void task_mempool_alloc_func(void *__restrict userdata,
+                                    const int index,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  MempoolAllocData *data = (MempoolAllocData *)userdata;
+  MempoolAllocChunk *chunk = (MempoolAllocChunk *)tls->userdata_chunk;
+
+  if (chunk->cache == NULL) {
+    chunk->cache = BLI_mempool_thread_cache_create(data->mempool);
+  }
+
+  /* Free some of the elements allocated before, to exercise the cache free list. */
+  if (data->elems[index] != NULL) {
+    BLI_mempool_thread_cache_free(chunk->cache, data->elems[index]);
+  }
+
+  data->elems[index] = (int *)BLI_mempool_thread_cache_alloc(chunk->cache);
+  *data->elems[index] = index;
+}
+
+static void task_mempool_alloc_finalize(void *__restrict UNUSED(userdata),
+                                        void *__restrict userdata_chunk)
+{
+  MempoolAllocChunk *chunk = (MempoolAllocChunk *)userdata_chunk;
+
+  if (chunk->cache != NULL) {
+    BLI_mempool_thread_cache_merge(chunk->cache);
+  }
+}
+
+TEST(task, MempoolThreadCache)
+{
+  int *elems[NUM_ITEMS] = {NULL};
+  BLI_threadapi_init();
+  BLI_mempool *mempool = BLI_mempool_create(sizeof(int), 0, 32, BLI_MEMPOOL_ALLOW_ITER);
+
+  for (int i = 0; i < NUM_ITEMS; i += 5) {
+    elems[i] = (int *)BLI_mempool_alloc(mempool);
+    *elems[i] = -1;
+  }
+
+  MempoolAllocData data = {mempool, elems};
+  MempoolAllocChunk chunk = {NULL};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.userdata_chunk = &chunk;
+  settings.userdata_chunk_size = sizeof(chunk);
+  settings.func_finalize = task_mempool_alloc_finalize;
+
+  BLI_task_parallel_range(0, NUM_ITEMS, &data, task_mempool_alloc_func, &settings);
+
+  EXPECT_EQ(BLI_mempool_len(mempool), NUM_ITEMS);
+
+  /* Every element is found exactly once when iterating over the merged pool. */
+  int *visited = (int *)MEM_callocN(sizeof(*visited) * NUM_ITEMS, __func__);
+  BLI_mempool_iter iter;
+  int *elem;
+  BLI_mempool_iternew(mempool, &iter);
+  while ((elem = (int *)BLI_mempool_iterstep(&iter))) {
+    ASSERT_TRUE(*elem >= 0 && *elem < NUM_ITEMS);
+    EXPECT_EQ(elems[*elem], elem);
+    visited[*elem]++;
+  }
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    EXPECT_EQ(visited[i], 1);
+  }
+
+  /* The pool is usable as before after merging. */
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    BLI_mempool_free(mempool, elems[i]);
+  }
+  EXPECT_EQ(BLI_mempool_len(mempool), 0);
+
+  MEM_freeN(visited);
+  BLI_mempool_destroy(mempool);
+  BLI_threadapi_exit();
+}
+
+/* *** Allocating from a threaded memory arena. *** */
+
+typedef struct ArenaAllocData {
+  MemArenaThreaded *arena;
+  int **elems;
+} ArenaAllocData;
+
+static void task_arena_alloc_func(void *__restrict userdata,
+                                  const int index,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ArenaAllocData *data = (ArenaAllocData *)userdata;
+  /* Vary the size, so allocations from one thread don't all line up. */
+  const int len = 1 + index % 7;
+  int *elem = (int *)BLI_memarena_threaded_alloc(data->arena, sizeof(int) * len);
+  for (int i = 0; i < len; i++) {
+    elem[i] = index;
+  }
+  data->elems[index] = elem;
+}
+
+TEST(task, MemArenaThreaded)
+{
+  int *elems[NUM_ITEMS] = {NULL};
+  BLI_threadapi_init();
+  MemArenaThreaded *arena = BLI_memarena_threaded_new(__func__);
+
+  ArenaAllocData data = {arena, elems};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  for (int pass = 0; pass < 2; pass++) {
+    BLI_task_parallel_range(0, NUM_ITEMS, &data, task_arena_alloc_func, &settings);
+
+    /* No allocation was overwritten by another thread. */
+    size_t size = 0;
+    for (int i = 0; i < NUM_ITEMS; i++) {
+      const int len = 1 + i % 7;
+      for (int j = 0; j < len; j++) {
+        EXPECT_EQ(elems[i][j], i);
+      }
+      EXPECT_EQ((uintptr_t)elems[i] % 16, 0);
+      size += sizeof(int) * len;
+    }
+    EXPECT_EQ(BLI_memarena_threaded_allocated_size(arena), size);
+
+    BLI_memarena_threaded_clear(arena);
+    EXPECT_EQ(BLI_memarena_threaded_allocated_size(arena), 0);
+  }
+
+  BLI_memarena_threaded_free(arena);
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over double-linked list items. *** */
 
 static void task_listbase_iter_func(void *userdata,
@@ -253,3 +540,105 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** Task pool, tasks pushing more tasks from worker threads. *** */
+
+#define TREE_DEPTH 10
+#define TREE_NUM_ROOTS 8
+
+static void task_pool_tree_func(TaskPool *__restrict pool, void *taskdata, int threadid)
+{
+  int *count = (int *)BLI_task_pool_userdata(pool);
+  const int depth = POINTER_AS_INT(taskdata);
+
+  atomic_add_and_fetch_uint32((uint32_t *)count, 1);
+
+  if (depth > 0) {
+    for (int i = 0; i < 2; i++) {
+      BLI_task_pool_push_from_thread(pool,
+                                     task_pool_tree_func,
+                                     POINTER_FROM_INT(depth - 1),
+                                     false,
+                                     TASK_PRIORITY_LOW,
+                                     threadid);
+    }
+  }
+}
+
+TEST(task, PoolPushFromThread)
+{
+  int count = 0;
+
+  BLI_threadapi_init();
+  /* Use explicit amount of threads, so work stealing is used on any machine. */
+  TaskScheduler *scheduler = BLI_task_scheduler_create(4);
+  TaskPool *pool = BLI_task_pool_create(scheduler, &count);
+
+  for (int i = 0; i < TREE_NUM_ROOTS; i++) {
+    BLI_task_pool_push(
+        pool, task_pool_tree_func, POINTER_FROM_INT(TREE_DEPTH), false, TASK_PRIORITY_LOW);
+  }
+  BLI_task_pool_work_and_wait(pool);
+
+  EXPECT_EQ(count, TREE_NUM_ROOTS * ((1 << (TREE_DEPTH + 1)) - 1));
+
+  BLI_task_pool_free(pool);
+  BLI_task_scheduler_free(scheduler);
+  BLI_threadapi_exit();
+}
+
+/* *** Task pools created and waited for from within tasks of another pool. *** */
+
+#define NESTED_NUM_OUTER 64
+#define NESTED_NUM_INNER 16
+
+typedef struct NestedPoolData {
+  TaskScheduler *scheduler;
+  int num_inner_done;
+  int num_outer_done;
+} NestedPoolData;
+
+static void task_pool_nested_inner_func(TaskPool *__restrict pool,
+                                        void *UNUSED(taskdata),
+                                        int UNUSED(threadid))
+{
+  NestedPoolData *data = (NestedPoolData *)BLI_task_pool_userdata(pool);
+  atomic_add_and_fetch_uint32((uint32_t *)&data->num_inner_done, 1);
+}
+
+static void task_pool_nested_outer_func(TaskPool *__restrict pool,
+                                        void *UNUSED(taskdata),
+                                        int UNUSED(threadid))
+{
+  NestedPoolData *data = (NestedPoolData *)BLI_task_pool_userdata(pool);
+  TaskPool *inner_pool = BLI_task_pool_create(data->scheduler, data);
+
+  for (int i = 0; i < NESTED_NUM_INNER; i++) {
+    BLI_task_pool_push(inner_pool, task_pool_nested_inner_func, NULL, false, TASK_PRIORITY_LOW);
+  }
+  BLI_task_pool_work_and_wait(inner_pool);
+  BLI_task_pool_free(inner_pool);
+
+  atomic_add_and_fetch_uint32((uint32_t *)&data->num_outer_done, 1);
+}
+
+TEST(task, NestedPools)
+{
+  NestedPoolData data = {NULL, 0, 0};
+
+  BLI_threadapi_init();
+  data.scheduler = BLI_task_scheduler_create(4);
+  TaskPool *pool = BLI_task_pool_create(data.scheduler, &data);
+
+  for (int i = 0; i < NESTED_NUM_OUTER; i++) {
+    BLI_task_pool_push(pool, task_pool_nested_outer_func, NULL, false, TASK_PRIORITY_LOW);
+  }
+  BLI_task_pool_work_and_wait(pool);
+
+  EXPECT_EQ(data.num_outer_done, NESTED_NUM_OUTER);
+  EXPECT_EQ(data.num_inner_done, NESTED_NUM_OUTER * NESTED_NUM_INNER);
+
+  BLI_task_pool_free(pool);
+  BLI_task_scheduler_free(data.scheduler);
+  BLI_threadapi_exit();
+}
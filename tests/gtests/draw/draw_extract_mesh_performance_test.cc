@@ -0,0 +1,51 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "draw_extract_mesh_test_util.h"
+
+extern "C" {
+#include "PIL_time.h"
+}
+
+#define NUM_RUN_AVERAGED 20
+
+static void extract_performance_test_do(const char *id, const int grid_size)
+{
+  BLI_threadapi_init();
+  Mesh *me = extract_test_grid_mesh_create(grid_size);
+
+  for (int use_fused = 0; use_fused < 2; use_fused++) {
+    double averaged_timing = 0.0;
+    for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+      MeshBufferCache mbc;
+      const double init_time = PIL_check_seconds_timer();
+      extract_test_buffers_create(me, &mbc, use_fused);
+      averaged_timing += PIL_check_seconds_timer() - init_time;
+      extract_test_buffers_free(&mbc);
+    }
+    printf("\t%s: %s extraction done in %fs on average over %d runs\n",
+           id,
+           use_fused ? "fused" : "separate",
+           averaged_timing / NUM_RUN_AVERAGED,
+           NUM_RUN_AVERAGED);
+  }
+
+  BKE_id_free(NULL, me);
+  BLI_threadapi_exit();
+}
+
+TEST(draw_extract_mesh, Grid10K)
+{
+  extract_performance_test_do("Mesh extraction - 10K faces", 100);
+}
+
+TEST(draw_extract_mesh, Grid250K)
+{
+  extract_performance_test_do("Mesh extraction - 250K faces", 500);
+}
+
+TEST(draw_extract_mesh, Grid1M)
+{
+  extract_performance_test_do("Mesh extraction - 1M faces", 1000);
+}
@@ -0,0 +1,157 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "draw_extract_mesh_test_util.h"
+
+#include <math.h>
+
+extern "C" {
+#include "DNA_userdef_types.h"
+
+#include "BKE_customdata.h"
+}
+
+static void extract_test_compare(const int grid_size)
+{
+  BLI_threadapi_init();
+  Mesh *me = extract_test_grid_mesh_create(grid_size);
+
+  MeshBufferCache mbc_fused, mbc_separate;
+  extract_test_buffers_create(me, &mbc_fused, true);
+  extract_test_buffers_create(me, &mbc_separate, false);
+
+  GPUVertBuf **vbos_fused = (GPUVertBuf **)&mbc_fused.vbo;
+  GPUVertBuf **vbos_separate = (GPUVertBuf **)&mbc_separate.vbo;
+  for (int i = 0; i < sizeof(mbc_fused.vbo) / sizeof(void *); i++) {
+    if (vbos_fused[i] == NULL) {
+      continue;
+    }
+    const uint size = GPU_vertbuf_size_get(vbos_fused[i]);
+    ASSERT_NE(vbos_fused[i]->data, nullptr);
+    ASSERT_EQ(size, GPU_vertbuf_size_get(vbos_separate[i]));
+    EXPECT_EQ(memcmp(vbos_fused[i]->data, vbos_separate[i]->data, size), 0);
+  }
+
+  GPUIndexBuf **ibos_fused = (GPUIndexBuf **)&mbc_fused.ibo;
+  GPUIndexBuf **ibos_separate = (GPUIndexBuf **)&mbc_separate.ibo;
+  for (int i = 0; i < sizeof(mbc_fused.ibo) / sizeof(void *); i++) {
+    if (ibos_fused[i] == NULL) {
+      continue;
+    }
+    const uint size = GPU_indexbuf_size_get(ibos_fused[i]);
+    ASSERT_NE(ibos_fused[i]->data, nullptr);
+    ASSERT_EQ(size, GPU_indexbuf_size_get(ibos_separate[i]));
+    EXPECT_EQ(memcmp(ibos_fused[i]->data, ibos_separate[i]->data, size), 0);
+  }
+
+  extract_test_buffers_free(&mbc_fused);
+  extract_test_buffers_free(&mbc_separate);
+  BKE_id_free(NULL, me);
+  BLI_threadapi_exit();
+}
+
+TEST(draw_extract_mesh, FusedMatchesSeparateNoThread)
+{
+  /* Below the threading threshold of the extraction. */
+  extract_test_compare(16);
+}
+
+TEST(draw_extract_mesh, FusedMatchesSeparate)
+{
+  extract_test_compare(200);
+}
+
+static float extract_test_half_to_float(const ushort h)
+{
+  const int exp = (h >> 10) & 0x1f;
+  const int mant = h & 0x3ff;
+  const float value = (exp == 0) ? ldexpf((float)mant, -24) :
+                                   ldexpf((float)(mant | 0x400), exp - 25);
+  return (h & 0x8000) ? -value : value;
+}
+
+TEST(draw_extract_mesh, HalfConvert)
+{
+  EXPECT_EQ(GPU_half_convert_f32(0.0f), 0x0000);
+  EXPECT_EQ(GPU_half_convert_f32(-0.0f), 0x8000);
+  EXPECT_EQ(GPU_half_convert_f32(1.0f), 0x3c00);
+  EXPECT_EQ(GPU_half_convert_f32(-2.0f), 0xc000);
+  EXPECT_EQ(GPU_half_convert_f32(0.5f), 0x3800);
+  EXPECT_EQ(GPU_half_convert_f32(65504.0f), 0x7bff);
+  EXPECT_EQ(GPU_half_convert_f32(1e6f), 0x7c00);
+  EXPECT_EQ(GPU_half_convert_f32(ldexpf(1.0f, -24)), 0x0001);
+  EXPECT_EQ(GPU_half_convert_f32(ldexpf(1.0f, -14)), 0x0400);
+  EXPECT_EQ(GPU_half_convert_f32(NAN) & 0x7c00, 0x7c00);
+  EXPECT_NE(GPU_half_convert_f32(NAN) & 0x03ff, 0);
+  /* Rounded to the nearest half float. */
+  EXPECT_EQ(GPU_half_convert_f32(1.0f + ldexpf(1.0f, -11)), 0x3c01);
+  EXPECT_EQ(GPU_half_convert_f32(1.0f + ldexpf(1.0f, -12) - ldexpf(1.0f, -20)), 0x3c00);
+  for (float f = -4.0f; f <= 4.0f; f += 0.01f) {
+    EXPECT_NEAR(extract_test_half_to_float(GPU_half_convert_f32(f)), f, ldexpf(1.0f, -10));
+  }
+}
+
+TEST(draw_extract_mesh, CompactUV)
+{
+  BLI_threadapi_init();
+  const int grid_size = 16;
+  Mesh *me = extract_test_grid_mesh_create(grid_size);
+  MLoopUV *mloopuv = (MLoopUV *)CustomData_add_layer(
+      &me->ldata, CD_MLOOPUV, CD_CALLOC, NULL, me->totloop);
+  for (int l = 0; l < me->totloop; l++) {
+    const MVert *mv = &me->mvert[me->mloop[l].v];
+    mloopuv[l].uv[0] = mv->co[0] / grid_size;
+    mloopuv[l].uv[1] = mv->co[1] / grid_size;
+  }
+  BKE_mesh_update_customdata_pointers(me, false);
+
+  MeshBatchCache cache;
+  memset(&cache, 0, sizeof(cache));
+  DRW_MeshCDMask cd_used;
+  memset(&cd_used, 0, sizeof(cd_used));
+  cache.cd_used.uv = 1;
+
+  const char gpu_flag = U.gpu_flag;
+  U.gpu_flag |= USER_GPU_FLAG_COMPACT_VERTEX_DATA;
+  MeshBufferCache mbc;
+  memset(&mbc, 0, sizeof(mbc));
+  mbc.vbo.uv = (GPUVertBuf *)MEM_callocN(sizeof(GPUVertBuf), __func__);
+  mesh_buffer_cache_create_requested(&cache, mbc, me, true, false, false, &cd_used, NULL, false);
+  U.gpu_flag = gpu_flag;
+
+  ASSERT_EQ(mbc.vbo.uv->format.attrs[0].comp_type, GPU_COMP_F16);
+  ASSERT_EQ(GPU_vertbuf_size_get(mbc.vbo.uv), sizeof(ushort[2]) * me->totloop);
+  const ushort(*uv_data)[2] = (const ushort(*)[2])mbc.vbo.uv->data;
+  for (int l = 0; l < me->totloop; l++) {
+    EXPECT_NEAR(extract_test_half_to_float(uv_data[l][0]), mloopuv[l].uv[0], 1e-3f);
+    EXPECT_NEAR(extract_test_half_to_float(uv_data[l][1]), mloopuv[l].uv[1], 1e-3f);
+  }
+
+  GPU_VERTBUF_DISCARD_SAFE(mbc.vbo.uv);
+  BKE_id_free(NULL, me);
+  BLI_threadapi_exit();
+}
+
+TEST(draw_extract_mesh, SurfaceLOD)
+{
+  BLI_threadapi_init();
+  const int grid_size = 200;
+  Mesh *me = extract_test_grid_mesh_create(grid_size);
+  MeshBufferCache mbc;
+  extract_test_buffers_create(me, &mbc, true);
+
+  /* Every cell of the simplified grid keeps at most two triangles. */
+  const uint tris_len = mbc.ibo.tris->index_len / 3;
+  const uint lod1_len = mbc.ibo.tris_lod1->index_len / 3;
+  const uint lod2_len = mbc.ibo.tris_lod2->index_len / 3;
+  EXPECT_EQ(tris_len, grid_size * grid_size * 2);
+  EXPECT_GT(lod1_len, 0);
+  EXPECT_LE(lod1_len, MESH_LOD1_GRID_RES * MESH_LOD1_GRID_RES * 2);
+  EXPECT_GT(lod2_len, 0);
+  EXPECT_LE(lod2_len, MESH_LOD2_GRID_RES * MESH_LOD2_GRID_RES * 2);
+
+  extract_test_buffers_free(&mbc);
+  BKE_id_free(NULL, me);
+  BLI_threadapi_exit();
+}
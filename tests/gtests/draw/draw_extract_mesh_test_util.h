@@ -0,0 +1,105 @@
+/* Apache License, Version 2.0 */
+
+#ifndef __DRAW_EXTRACT_MESH_TEST_UTIL_H__
+#define __DRAW_EXTRACT_MESH_TEST_UTIL_H__
+
+#include <string.h>
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_threads.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_library.h"
+#include "BKE_mesh.h"
+
+#include "GPU_batch.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "draw_cache_extract.h"
+}
+
+/* Grid of quads in the XY plane, with a wave along Z so the normals differ. */
+static Mesh *extract_test_grid_mesh_create(const int size)
+{
+  const int verts_len = (size + 1) * (size + 1);
+  const int polys_len = size * size;
+  Mesh *me = BKE_mesh_new_nomain(verts_len, 0, 0, polys_len * 4, polys_len);
+
+  for (int y = 0; y <= size; y++) {
+    for (int x = 0; x <= size; x++) {
+      MVert *mv = &me->mvert[y * (size + 1) + x];
+      mv->co[0] = (float)x;
+      mv->co[1] = (float)y;
+      mv->co[2] = (float)((x * 7 + y * 3) % 5) * 0.1f;
+    }
+  }
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      const int p = y * size + x;
+      const int v = y * (size + 1) + x;
+      MPoly *mp = &me->mpoly[p];
+      mp->loopstart = p * 4;
+      mp->totloop = 4;
+      mp->flag = ME_SMOOTH;
+      me->mloop[p * 4 + 0].v = v;
+      me->mloop[p * 4 + 1].v = v + 1;
+      me->mloop[p * 4 + 2].v = v + size + 2;
+      me->mloop[p * 4 + 3].v = v + size + 1;
+    }
+  }
+  BKE_mesh_calc_edges(me, false, false);
+  BKE_mesh_calc_normals(me);
+  return me;
+}
+
+/* Request the buffers of the solid and wireframe drawing. */
+static void extract_test_buffers_request(MeshBufferCache *mbc)
+{
+  memset(mbc, 0, sizeof(*mbc));
+  mbc->vbo.pos_nor = (GPUVertBuf *)MEM_callocN(sizeof(GPUVertBuf), __func__);
+  mbc->vbo.lnor = (GPUVertBuf *)MEM_callocN(sizeof(GPUVertBuf), __func__);
+  mbc->vbo.edge_fac = (GPUVertBuf *)MEM_callocN(sizeof(GPUVertBuf), __func__);
+  mbc->vbo.poly_idx = (GPUVertBuf *)MEM_callocN(sizeof(GPUVertBuf), __func__);
+  mbc->vbo.edge_idx = (GPUVertBuf *)MEM_callocN(sizeof(GPUVertBuf), __func__);
+  mbc->vbo.vert_idx = (GPUVertBuf *)MEM_callocN(sizeof(GPUVertBuf), __func__);
+  mbc->vbo.fdots_pos = (GPUVertBuf *)MEM_callocN(sizeof(GPUVertBuf), __func__);
+  mbc->ibo.tris = (GPUIndexBuf *)MEM_callocN(sizeof(GPUIndexBuf), __func__);
+  mbc->ibo.tris_lod1 = (GPUIndexBuf *)MEM_callocN(sizeof(GPUIndexBuf), __func__);
+  mbc->ibo.tris_lod2 = (GPUIndexBuf *)MEM_callocN(sizeof(GPUIndexBuf), __func__);
+  mbc->ibo.lines = (GPUIndexBuf *)MEM_callocN(sizeof(GPUIndexBuf), __func__);
+  mbc->ibo.points = (GPUIndexBuf *)MEM_callocN(sizeof(GPUIndexBuf), __func__);
+  mbc->ibo.lines_adjacency = (GPUIndexBuf *)MEM_callocN(sizeof(GPUIndexBuf), __func__);
+}
+
+static void extract_test_buffers_free(MeshBufferCache *mbc)
+{
+  GPUVertBuf **vbos = (GPUVertBuf **)&mbc->vbo;
+  GPUIndexBuf **ibos = (GPUIndexBuf **)&mbc->ibo;
+  for (int i = 0; i < sizeof(mbc->vbo) / sizeof(void *); i++) {
+    GPU_VERTBUF_DISCARD_SAFE(vbos[i]);
+  }
+  for (int i = 0; i < sizeof(mbc->ibo) / sizeof(void *); i++) {
+    GPU_INDEXBUF_DISCARD_SAFE(ibos[i]);
+  }
+}
+
+static void extract_test_buffers_create(Mesh *me, MeshBufferCache *mbc, const bool use_fused)
+{
+  MeshBatchCache cache;
+  memset(&cache, 0, sizeof(cache));
+  DRW_MeshCDMask cd_used;
+  memset(&cd_used, 0, sizeof(cd_used));
+
+  extract_test_buffers_request(mbc);
+  mesh_buffer_cache_use_fused_extraction(use_fused);
+  mesh_buffer_cache_create_requested(&cache, *mbc, me, true, false, false, &cd_used, NULL, false);
+  mesh_buffer_cache_use_fused_extraction(true);
+}
+
+#endif /* __DRAW_EXTRACT_MESH_TEST_UTIL_H__ */
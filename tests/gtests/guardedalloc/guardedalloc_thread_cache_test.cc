@@ -0,0 +1,111 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#define NUM_THREADS 4
+#define NUM_ALLOCS 20000
+
+namespace {
+
+void AllocFreeMany(const int seed)
+{
+  std::vector<void *> blocks(NUM_ALLOCS / 10, nullptr);
+  unsigned int rand = (unsigned int)seed;
+
+  for (int i = 0; i < NUM_ALLOCS; i++) {
+    rand = rand * 1103515245u + 12345u;
+    const size_t index = (rand >> 8) % blocks.size();
+    const size_t len = (rand >> 20) % 1200;
+
+    if (blocks[index] != nullptr) {
+      MEM_freeN(blocks[index]);
+    }
+    blocks[index] = MEM_mallocN(len, __func__);
+    EXPECT_EQ(MEM_allocN_len(blocks[index]), (len + 3) & ~(size_t)3);
+    memset(blocks[index], 0xAB, len);
+  }
+
+  for (void *block : blocks) {
+    if (block != nullptr) {
+      MEM_freeN(block);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(guardedalloc, ThreadCacheAllocFree)
+{
+  MEM_use_thread_cache();
+
+  const size_t mem_in_use = MEM_get_memory_in_use();
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < NUM_THREADS; i++) {
+    threads.push_back(std::thread(AllocFreeMany, i));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+}
+
+/* Blocks allocated in one thread and freed in another. */
+TEST(guardedalloc, ThreadCacheCrossThreadFree)
+{
+  MEM_use_thread_cache();
+
+  const size_t mem_in_use = MEM_get_memory_in_use();
+  std::vector<void *> blocks;
+
+  for (int i = 0; i < NUM_ALLOCS; i++) {
+    blocks.push_back(MEM_callocN((size_t)(i % 300), __func__));
+  }
+  EXPECT_GT(MEM_get_memory_in_use(), mem_in_use);
+
+  std::thread thread([&blocks]() {
+    for (void *block : blocks) {
+      MEM_freeN(block);
+    }
+  });
+  thread.join();
+
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+}
+
+TEST(guardedalloc, ThreadCacheReallocDup)
+{
+  MEM_use_thread_cache();
+
+  const size_t mem_in_use = MEM_get_memory_in_use();
+
+  char *data = (char *)MEM_callocN(10, __func__);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(data[i], 0);
+    data[i] = (char)i;
+  }
+
+  char *copy = (char *)MEM_dupallocN(data);
+  EXPECT_EQ(MEM_allocN_len(copy), 12);
+  EXPECT_EQ(memcmp(copy, data, 10), 0);
+
+  /* Grow out of the cached sizes and back. */
+  data = (char *)MEM_recallocN(data, 4000);
+  EXPECT_EQ(data[9], 9);
+  EXPECT_EQ(data[3999], 0);
+  data = (char *)MEM_reallocN(data, 20);
+  EXPECT_EQ(data[9], 9);
+
+  MEM_freeN(copy);
+  MEM_freeN(data);
+
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+}
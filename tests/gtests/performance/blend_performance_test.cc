@@ -0,0 +1,170 @@
+/* Apache License, Version 2.0 */
+
+#include "performance_test_util.h"
+
+#include "blenloader/blendfile_loading_base_test.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_fileops.h"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+
+#include "DNA_curve_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_appdir.h"
+#include "BKE_curve.h"
+#include "BKE_displist.h"
+#include "BKE_layer.h"
+#include "BKE_main.h"
+#include "BKE_object.h"
+#include "BKE_scene.h"
+
+#include "BLO_readfile.h"
+#include "BLO_writefile.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "MEM_guardedalloc.h"
+}
+
+#define NUM_RUN_AVERAGED 10
+
+/* Chains of controls hooked into a mesh each, roughly the size of a character rig. */
+#define RIG_CHAINS 50
+#define RIG_CHAIN_LENGTH 20
+#define RIG_GRID_SIZE 100
+
+/* Cables: many bevelled bezier splines in one curve. */
+#define CURVE_SPLINES 200
+#define CURVE_SPLINE_POINTS 20
+
+class BlendPerformanceTest : public BlendfileLoadingBaseTest {
+ public:
+  static void SetUpTestCase()
+  {
+    BlendfileLoadingBaseTest::SetUpTestCase();
+    BKE_tempdir_init(NULL);
+  }
+
+ protected:
+  struct Main *bmain = nullptr;
+  struct Scene *scene = nullptr;
+
+  virtual void SetUp()
+  {
+    bmain = BKE_main_new();
+    scene = perf_rig_scene_create(bmain, RIG_CHAINS, RIG_CHAIN_LENGTH, RIG_GRID_SIZE);
+  }
+
+  virtual void TearDown()
+  {
+    /* Frees the depsgraph, which uses the main database. */
+    BlendfileLoadingBaseTest::TearDown();
+
+    BKE_main_free(bmain);
+    bmain = nullptr;
+    scene = nullptr;
+  }
+};
+
+TEST_F(BlendPerformanceTest, blendfile_write_read)
+{
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), BKE_tempdir_session(), "perf_test.blend");
+
+  perf_measure("write", NUM_RUN_AVERAGED, [&]() {
+    EXPECT_TRUE(BLO_write_file(bmain, filepath, 0, NULL, NULL));
+  });
+
+  BlendFileData *bfile_read = NULL;
+  perf_measure(
+      "read",
+      NUM_RUN_AVERAGED,
+      [&]() { bfile_read = BLO_read_from_file(filepath, BLO_READ_SKIP_NONE, NULL); },
+      [&]() {
+        EXPECT_NE(bfile_read, nullptr);
+        if (bfile_read) {
+          BLO_blendfiledata_free(bfile_read);
+        }
+      });
+
+  BLI_delete(filepath, false, false);
+}
+
+TEST_F(BlendPerformanceTest, depsgraph_rig)
+{
+  ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+
+  perf_measure(
+      "build",
+      NUM_RUN_AVERAGED,
+      [&]() {
+        depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+        DEG_graph_build_from_view_layer(depsgraph, bmain, scene, view_layer);
+      },
+      [&]() { depsgraph_free(); });
+
+  depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+  DEG_graph_build_from_view_layer(depsgraph, bmain, scene, view_layer);
+  BKE_scene_graph_update_tagged(depsgraph, bmain);
+
+  /* Moving the root controls re-evaluates every control and deformed mesh. */
+  perf_measure("evaluate", NUM_RUN_AVERAGED, [&]() {
+    LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+      if (ob->type == OB_EMPTY && ob->parent == NULL) {
+        ob->loc[2] += 0.1f;
+        DEG_id_tag_update_ex(bmain, &ob->id, ID_RECALC_TRANSFORM);
+      }
+    }
+    BKE_scene_graph_update_tagged(depsgraph, bmain);
+  });
+}
+
+TEST_F(BlendPerformanceTest, curve_bevel)
+{
+  ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+  Object *ob = BKE_object_add(bmain, scene, view_layer, OB_CURVE, "Cables");
+  Curve *cu = (Curve *)ob->data;
+  cu->flag |= CU_3D;
+  cu->ext2 = 0.1f;
+  cu->bevresol = 4;
+
+  for (int spline = 0; spline < CURVE_SPLINES; spline++) {
+    Nurb *nu = (Nurb *)MEM_callocN(sizeof(Nurb), __func__);
+    nu->type = CU_BEZIER;
+    nu->resolu = 12;
+    nu->orderu = 4;
+    nu->flag = CU_SMOOTH;
+    BKE_nurb_bezierPoints_add(nu, CURVE_SPLINE_POINTS);
+    for (int i = 0; i < CURVE_SPLINE_POINTS; i++) {
+      BezTriple *bezt = &nu->bezt[i];
+      for (int j = 0; j < 3; j++) {
+        bezt->vec[j][0] = (float)i + (float)(j - 1) * 0.3f;
+        bezt->vec[j][1] = (float)spline * 0.5f;
+        bezt->vec[j][2] = (float)((i * 7 + spline * 3) % 5) * 0.2f;
+      }
+      bezt->h1 = bezt->h2 = HD_AUTO;
+      bezt->radius = 1.0f;
+    }
+    BKE_nurb_handles_calc(nu);
+    BLI_addtail(&cu->nurb, nu);
+  }
+
+  depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+  DEG_graph_build_from_view_layer(depsgraph, bmain, scene, view_layer);
+
+  perf_measure("tessellate", NUM_RUN_AVERAGED, [&]() {
+    BKE_displist_make_curveTypes(depsgraph, scene, ob, false, false);
+  });
+
+  int totvert, totface, tottri;
+  BKE_displist_count(&ob->runtime.curve_cache->disp, &totvert, &totface, &tottri);
+  EXPECT_GT(totface, 0);
+
+  BKE_object_free_derived_caches(ob);
+}
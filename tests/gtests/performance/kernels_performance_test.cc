@@ -0,0 +1,450 @@
+/* Apache License, Version 2.0 */
+
+#include "performance_test_util.h"
+
+#include "draw/draw_extract_mesh_test_util.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_kdopbvh.h"
+#include "BLI_math.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_texture_types.h"
+
+#include "BKE_bvhutils.h"
+#include "BKE_library.h"
+#include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
+#include "BKE_mesh_remap.h"
+#include "BKE_mesh_runtime.h"
+#include "BKE_subdiv.h"
+#include "BKE_subdiv_mesh.h"
+#include "BKE_texture.h"
+
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "RE_shader_ext.h"
+
+#include "bmesh.h"
+#include "bmesh_tools.h"
+}
+
+#define NUM_RUN_AVERAGED 10
+
+/* -------------------------------------------------------------------- */
+/** \name Mesh Normals
+ * \{ */
+
+TEST_F(PerformanceTest, mesh_calc_normals_poly)
+{
+  Mesh *me = perf_grid_mesh_create(1000);
+  float(*vert_normals)[3] = (float(*)[3])MEM_malloc_arrayN(
+      me->totvert, sizeof(*vert_normals), __func__);
+  float(*poly_normals)[3] = (float(*)[3])MEM_malloc_arrayN(
+      me->totpoly, sizeof(*poly_normals), __func__);
+
+  perf_measure("1M faces", NUM_RUN_AVERAGED, [&]() {
+    BKE_mesh_calc_normals_poly(me->mvert,
+                               vert_normals,
+                               me->totvert,
+                               me->mloop,
+                               me->mpoly,
+                               me->totloop,
+                               me->totpoly,
+                               poly_normals,
+                               false);
+  });
+
+  MEM_freeN(vert_normals);
+  MEM_freeN(poly_normals);
+  BKE_id_free(NULL, me);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Mesh to BMesh
+ * \{ */
+
+TEST_F(PerformanceTest, bm_mesh_bm_from_me)
+{
+  Mesh *me = perf_grid_mesh_create(1000);
+  BMesh *bm = NULL;
+
+  BMAllocTemplate allocsize = {me->totvert, me->totedge, me->totloop, me->totpoly};
+  BMeshCreateParams create_params = {0};
+  BMeshFromMeshParams convert_params = {0};
+  convert_params.calc_face_normal = true;
+
+  perf_measure(
+      "1M faces",
+      NUM_RUN_AVERAGED,
+      [&]() {
+        bm = BM_mesh_create(&allocsize, &create_params);
+        BM_mesh_bm_from_me(bm, me, &convert_params);
+      },
+      [&]() { BM_mesh_free(bm); });
+
+  BKE_id_free(NULL, me);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Decimate
+ * \{ */
+
+static BMesh *perf_bm_from_me(const Mesh *me)
+{
+  BMAllocTemplate allocsize = {me->totvert, me->totedge, me->totloop, me->totpoly};
+  BMeshCreateParams create_params = {0};
+  BMeshFromMeshParams convert_params = {0};
+  convert_params.calc_face_normal = true;
+
+  BMesh *bm = BM_mesh_create(&allocsize, &create_params);
+  BM_mesh_bm_from_me(bm, me, &convert_params);
+  return bm;
+}
+
+TEST_F(PerformanceTest, bm_mesh_decimate_collapse)
+{
+  Mesh *me = perf_grid_mesh_create(250);
+  BMesh *bm = perf_bm_from_me(me);
+
+  /* Converting is done outside of the timing. */
+  perf_measure(
+      "62K faces to 10%",
+      NUM_RUN_AVERAGED,
+      [&]() { BM_mesh_decimate_collapse(bm, 0.1f, NULL, 0.0f, false, -1, 0.0f); },
+      [&]() {
+        EXPECT_LT(bm->totface, me->totpoly);
+        BM_mesh_free(bm);
+        bm = perf_bm_from_me(me);
+      });
+
+  BM_mesh_free(bm);
+  BKE_id_free(NULL, me);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Draw Cache Extraction
+ * \{ */
+
+TEST_F(PerformanceTest, mesh_buffer_cache_create_requested)
+{
+  Mesh *me = extract_test_grid_mesh_create(1000);
+  MeshBufferCache mbc;
+
+  perf_measure(
+      "1M faces",
+      NUM_RUN_AVERAGED,
+      [&]() { extract_test_buffers_create(me, &mbc, true); },
+      [&]() { extract_test_buffers_free(&mbc); });
+
+  BKE_id_free(NULL, me);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Subdivision
+ * \{ */
+
+TEST_F(PerformanceTest, subdiv_to_mesh)
+{
+  Mesh *me = perf_grid_mesh_create(100);
+
+  SubdivSettings settings = {0};
+  settings.level = 3;
+  settings.vtx_boundary_interpolation = SUBDIV_VTX_BOUNDARY_EDGE_ONLY;
+  settings.fvar_linear_interpolation = SUBDIV_FVAR_LINEAR_INTERPOLATION_BOUNDARIES;
+
+  Subdiv *subdiv = BKE_subdiv_new_from_mesh(&settings, me);
+  if (subdiv->topology_refiner == NULL) {
+    /* Built without OpenSubdiv. */
+    printf("\tSubdivision benchmark skipped, no OpenSubdiv\n");
+    BKE_subdiv_free(subdiv);
+    BKE_id_free(NULL, me);
+    return;
+  }
+
+  SubdivToMeshSettings mesh_settings;
+  mesh_settings.resolution = (1 << settings.level) + 1;
+  mesh_settings.use_optimal_display = false;
+  Mesh *result = NULL;
+
+  perf_measure(
+      "10K faces, level 3",
+      NUM_RUN_AVERAGED,
+      [&]() { result = BKE_subdiv_to_mesh(subdiv, &mesh_settings, me); },
+      [&]() { BKE_id_free(NULL, result); });
+
+  BKE_subdiv_free(subdiv);
+  BKE_id_free(NULL, me);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name BVH Tree
+ * \{ */
+
+TEST_F(PerformanceTest, bvhtree_looptri)
+{
+  Mesh *me = perf_grid_mesh_create(1000);
+  const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(me);
+  const int looptri_len = BKE_mesh_runtime_looptri_len(me);
+  BVHTreeFromMesh data;
+
+  /* Build without the mesh BVH cache, so every run builds a new tree. */
+  perf_measure(
+      "build 2M triangles",
+      NUM_RUN_AVERAGED,
+      [&]() {
+        bvhtree_from_mesh_looptri_ex(&data,
+                                     me->mvert,
+                                     false,
+                                     me->mloop,
+                                     false,
+                                     looptri,
+                                     looptri_len,
+                                     false,
+                                     NULL,
+                                     -1,
+                                     0.0f,
+                                     4,
+                                     6,
+                                     BVHTREE_FROM_LOOPTRI,
+                                     NULL);
+      },
+      [&]() { free_bvhtree_from_mesh(&data); });
+
+  bvhtree_from_mesh_looptri_ex(&data,
+                               me->mvert,
+                               false,
+                               me->mloop,
+                               false,
+                               looptri,
+                               looptri_len,
+                               false,
+                               NULL,
+                               -1,
+                               0.0f,
+                               4,
+                               6,
+                               BVHTREE_FROM_LOOPTRI,
+                               NULL);
+
+  /* Rays from above onto a regular grid of points, every ray hits. */
+  const int rays_size = 1000;
+  const float dir[3] = {0.0f, 0.0f, -1.0f};
+  int hits = 0;
+
+  perf_measure("raycast 1M rays", NUM_RUN_AVERAGED, [&]() {
+    hits = 0;
+    for (int y = 0; y < rays_size; y++) {
+      for (int x = 0; x < rays_size; x++) {
+        const float co[3] = {(float)x + 0.5f, (float)y + 0.5f, 10.0f};
+        BVHTreeRayHit hit;
+        hit.index = -1;
+        hit.dist = BVH_RAYCAST_DIST_MAX;
+        if (BLI_bvhtree_ray_cast(
+                data.tree, co, dir, 0.0f, &hit, data.raycast_callback, &data) != -1) {
+          hits++;
+        }
+      }
+    }
+  });
+  EXPECT_EQ(hits, rays_size * rays_size);
+
+  free_bvhtree_from_mesh(&data);
+  BKE_id_free(NULL, me);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Mesh Remap
+ * \{ */
+
+static void perf_mesh_remap_verts_measure(const char *name,
+                                          const int mode,
+                                          const Mesh *me_dst,
+                                          Mesh *me_src)
+{
+  MeshPairRemap map = {0};
+
+  perf_measure(
+      name,
+      NUM_RUN_AVERAGED,
+      [&]() {
+        BKE_mesh_remap_calc_verts_from_mesh(
+            mode, NULL, FLT_MAX, 0.0f, me_dst->mvert, me_dst->totvert, false, me_src, &map);
+      },
+      [&]() {
+        EXPECT_EQ(map.items_num, me_dst->totvert);
+        EXPECT_GT(map.items[map.items_num / 2].sources_num, 0);
+        BKE_mesh_remap_free(&map);
+      });
+}
+
+TEST_F(PerformanceTest, mesh_remap)
+{
+  /* Destination covers the source, with twice the spacing and slightly above it. */
+  Mesh *me_src = perf_grid_mesh_create(1000);
+  Mesh *me_dst = perf_grid_mesh_create(500);
+  for (int i = 0; i < me_dst->totvert; i++) {
+    mul_v2_fl(me_dst->mvert[i].co, 2.0f);
+    me_dst->mvert[i].co[2] += 1.0f;
+  }
+
+  perf_mesh_remap_verts_measure("verts nearest", MREMAP_MODE_VERT_NEAREST, me_dst, me_src);
+  perf_mesh_remap_verts_measure(
+      "verts poly interpolated", MREMAP_MODE_VERT_POLYINTERP_NEAREST, me_dst, me_src);
+  perf_mesh_remap_verts_measure(
+      "verts normal projection", MREMAP_MODE_VERT_POLYINTERP_VNORPROJ, me_dst, me_src);
+
+  MeshPairRemap map = {0};
+  perf_measure(
+      "polys nearest",
+      NUM_RUN_AVERAGED,
+      [&]() {
+        BKE_mesh_remap_calc_polys_from_mesh(MREMAP_MODE_POLY_NEAREST,
+                                            NULL,
+                                            FLT_MAX,
+                                            0.0f,
+                                            me_dst->mvert,
+                                            me_dst->totvert,
+                                            me_dst->mloop,
+                                            me_dst->totloop,
+                                            me_dst->mpoly,
+                                            me_dst->totpoly,
+                                            &me_dst->pdata,
+                                            false,
+                                            me_src,
+                                            &map);
+      },
+      [&]() {
+        EXPECT_EQ(map.items_num, me_dst->totpoly);
+        BKE_mesh_remap_free(&map);
+      });
+
+  BKE_id_free(NULL, me_dst);
+  BKE_id_free(NULL, me_src);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Image Scaling
+ * \{ */
+
+static ImBuf *perf_imbuf_create(const int size, const bool use_float)
+{
+  ImBuf *ibuf = IMB_allocImBuf(size, size, 32, use_float ? IB_rectfloat : IB_rect);
+
+  for (int i = 0; i < size * size; i++) {
+    const int x = i % size, y = i / size;
+    const float color[4] = {
+        (float)x / size, (float)y / size, (float)((x ^ y) & 255) / 255.0f, 1.0f};
+    if (use_float) {
+      copy_v4_v4(&ibuf->rect_float[i * 4], color);
+    }
+    else {
+      rgba_float_to_uchar((unsigned char *)&ibuf->rect[i], color);
+    }
+  }
+
+  return ibuf;
+}
+
+/* Scale copies of the image, copying is done outside of the timing. */
+static void perf_imbuf_scale_measure(const char *name,
+                                     const ImBuf *ibuf_orig,
+                                     const int size,
+                                     const bool use_threaded)
+{
+  ImBuf *ibuf = IMB_dupImBuf(ibuf_orig);
+
+  perf_measure(
+      name,
+      NUM_RUN_AVERAGED,
+      [&]() {
+        if (use_threaded) {
+          IMB_scaleImBuf_threaded(ibuf, size, size);
+        }
+        else {
+          IMB_scaleImBuf(ibuf, size, size);
+        }
+      },
+      [&]() {
+        IMB_freeImBuf(ibuf);
+        ibuf = IMB_dupImBuf(ibuf_orig);
+      });
+
+  IMB_freeImBuf(ibuf);
+}
+
+TEST_F(PerformanceTest, imb_scale)
+{
+  ImBuf *ibuf = perf_imbuf_create(2048, false);
+  perf_imbuf_scale_measure("byte 2048 to 512", ibuf, 512, false);
+  perf_imbuf_scale_measure("byte 2048 to 3000", ibuf, 3000, false);
+  perf_imbuf_scale_measure("byte threaded 2048 to 3000", ibuf, 3000, true);
+  IMB_freeImBuf(ibuf);
+
+  ibuf = perf_imbuf_create(2048, true);
+  perf_imbuf_scale_measure("float 2048 to 512", ibuf, 512, false);
+  perf_imbuf_scale_measure("float 2048 to 3000", ibuf, 3000, false);
+  perf_imbuf_scale_measure("float threaded 2048 to 3000", ibuf, 3000, true);
+  IMB_freeImBuf(ibuf);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Textures
+ * \{ */
+
+TEST_F(PerformanceTest, texture_get_values)
+{
+  const int size = 500;
+  const int tex_co_len = size * size;
+  float(*tex_co)[3] = (float(*)[3])MEM_malloc_arrayN(tex_co_len, sizeof(*tex_co), __func__);
+  TexResult *texres = (TexResult *)MEM_malloc_arrayN(tex_co_len, sizeof(*texres), __func__);
+  for (int i = 0; i < tex_co_len; i++) {
+    tex_co[i][0] = (float)(i % size) / (float)size;
+    tex_co[i][1] = (float)(i / size) / (float)size;
+    tex_co[i][2] = 0.5f;
+  }
+
+  Tex tex = {{NULL}};
+  BKE_texture_default(&tex);
+  tex.type = TEX_CLOUDS;
+  tex.noisedepth = 4;
+
+  perf_measure("clouds 250K", NUM_RUN_AVERAGED, [&]() {
+    BKE_texture_get_values(NULL, &tex, tex_co, tex_co_len, texres, false);
+  });
+
+  /* Same result as evaluating the points one by one. */
+  for (int i = 0; i < tex_co_len; i += 997) {
+    TexResult texres_single;
+    texres_single.nor = NULL;
+    BKE_texture_get_value(NULL, &tex, tex_co[i], &texres_single, false);
+    EXPECT_EQ(texres[i].tin, texres_single.tin);
+  }
+
+  MEM_freeN(tex_co);
+  MEM_freeN(texres);
+}
+
+/** \} */
@@ -0,0 +1,212 @@
+/* Apache License, Version 2.0 */
+
+#include "performance_test_util.h"
+
+#include <float.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math.h"
+#include "BLI_string.h"
+#include "BLI_threads.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_layer.h"
+#include "BKE_mesh.h"
+#include "BKE_modifier.h"
+#include "BKE_object.h"
+#include "BKE_scene.h"
+
+#include "PIL_time.h"
+}
+
+DEFINE_string(perf_output, "", "Write the timings of all benchmarks to this JSON file.");
+
+/* -------------------------------------------------------------------- */
+/** \name Timing
+ * \{ */
+
+struct PerfResult {
+  std::string name;
+  int runs;
+  double average;
+  double best;
+};
+
+static std::vector<PerfResult> perf_results;
+
+void perf_measure(const char *name,
+                  const int runs,
+                  const std::function<void()> &func,
+                  const std::function<void()> &cleanup)
+{
+  const testing::TestInfo *test_info = testing::UnitTest::GetInstance()->current_test_info();
+  PerfResult result;
+  result.name = std::string(test_info->test_case_name()) + "." + test_info->name() + "/" + name;
+  result.runs = runs;
+  result.average = 0.0;
+  result.best = DBL_MAX;
+
+  for (int i = 0; i < runs; i++) {
+    const double start_time = PIL_check_seconds_timer();
+    func();
+    const double run_time = PIL_check_seconds_timer() - start_time;
+
+    result.average += run_time;
+    result.best = min_dd(result.best, run_time);
+
+    if (cleanup) {
+      cleanup();
+    }
+  }
+  result.average /= runs;
+
+  printf("\t%s: %fs on average, %fs at best over %d runs\n",
+         result.name.c_str(),
+         result.average,
+         result.best,
+         runs);
+
+  perf_results.push_back(result);
+}
+
+/* Writes the results of all tests once they are done. */
+class PerfOutputEnvironment : public testing::Environment {
+ public:
+  virtual void TearDown()
+  {
+    if (FLAGS_perf_output.empty()) {
+      return;
+    }
+
+    FILE *file = fopen(FLAGS_perf_output.c_str(), "w");
+    if (file == NULL) {
+      fprintf(stderr, "Unable to write '%s'\n", FLAGS_perf_output.c_str());
+      return;
+    }
+
+    fprintf(file, "{\n  \"threads\": %d,\n  \"benchmarks\": [", BLI_system_thread_count());
+    for (size_t i = 0; i < perf_results.size(); i++) {
+      const PerfResult &result = perf_results[i];
+      fprintf(file,
+              "%s\n    {\"name\": \"%s\", \"runs\": %d, \"average\": %.9f, \"best\": %.9f}",
+              (i == 0) ? "" : ",",
+              result.name.c_str(),
+              result.runs,
+              result.average,
+              result.best);
+    }
+    fprintf(file, "\n  ]\n}\n");
+    fclose(file);
+  }
+};
+
+static testing::Environment *const perf_output_environment = testing::AddGlobalTestEnvironment(
+    new PerfOutputEnvironment);
+
+void PerformanceTest::SetUpTestCase()
+{
+  testing::Test::SetUpTestCase();
+  BLI_threadapi_init();
+}
+
+void PerformanceTest::TearDownTestCase()
+{
+  BLI_threadapi_exit();
+  testing::Test::TearDownTestCase();
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Generated Data
+ *
+ * Everything is generated deterministically, so timings of different builds can be compared.
+ * \{ */
+
+Mesh *perf_grid_mesh_create(const int size)
+{
+  const int verts_len = (size + 1) * (size + 1);
+  const int polys_len = size * size;
+  Mesh *me = BKE_mesh_new_nomain(verts_len, 0, 0, polys_len * 4, polys_len);
+
+  for (int y = 0; y <= size; y++) {
+    for (int x = 0; x <= size; x++) {
+      MVert *mv = &me->mvert[y * (size + 1) + x];
+      mv->co[0] = (float)x;
+      mv->co[1] = (float)y;
+      mv->co[2] = (float)((x * 7 + y * 3) % 5) * 0.1f;
+    }
+  }
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      const int p = y * size + x;
+      const int v = y * (size + 1) + x;
+      MPoly *mp = &me->mpoly[p];
+      mp->loopstart = p * 4;
+      mp->totloop = 4;
+      mp->flag = ME_SMOOTH;
+      me->mloop[p * 4 + 0].v = v;
+      me->mloop[p * 4 + 1].v = v + 1;
+      me->mloop[p * 4 + 2].v = v + size + 2;
+      me->mloop[p * 4 + 3].v = v + size + 1;
+    }
+  }
+  BKE_mesh_calc_edges(me, false, false);
+  BKE_mesh_calc_normals(me);
+  return me;
+}
+
+Scene *perf_rig_scene_create(Main *bmain,
+                             const int chains_len,
+                             const int chain_length,
+                             const int grid_size)
+{
+  Scene *scene = BKE_scene_add(bmain, "Scene");
+  ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+  char name[MAX_NAME];
+
+  for (int chain = 0; chain < chains_len; chain++) {
+    BLI_snprintf(name, sizeof(name), "Mesh.%d", chain);
+    Object *ob_mesh = BKE_object_add(bmain, scene, view_layer, OB_MESH, name);
+    Mesh *me = perf_grid_mesh_create(grid_size);
+    BKE_mesh_nomain_to_mesh(me, (Mesh *)ob_mesh->data, ob_mesh, &CD_MASK_MESH, true);
+    ob_mesh->loc[0] = (float)(chain * (grid_size + 1));
+
+    Object *ob_parent = NULL;
+    for (int i = 0; i < chain_length; i++) {
+      BLI_snprintf(name, sizeof(name), "Control.%d.%d", chain, i);
+      Object *ob_empty = BKE_object_add(bmain, scene, view_layer, OB_EMPTY, name);
+      ob_empty->parent = ob_parent;
+      ob_empty->loc[0] = (ob_parent == NULL) ? ob_mesh->loc[0] : 1.0f;
+      ob_empty->rot[2] = 0.1f;
+
+      HookModifierData *hmd = (HookModifierData *)modifier_new(eModifierType_Hook);
+      BLI_snprintf(hmd->modifier.name, sizeof(hmd->modifier.name), "Hook.%d", i);
+      hmd->object = ob_empty;
+      hmd->falloff_type = eHook_Falloff_Linear;
+      hmd->falloff = (float)grid_size * 0.5f;
+      hmd->force = 0.5f;
+      hmd->cent[0] = (float)(i * grid_size) / (float)chain_length;
+      unit_m4(hmd->parentinv);
+      BLI_addtail(&ob_mesh->modifiers, hmd);
+
+      ob_parent = ob_empty;
+    }
+  }
+
+  return scene;
+}
+
+/** \} */
@@ -0,0 +1,40 @@
+/* Apache License, Version 2.0 */
+
+#ifndef __PERFORMANCE_TEST_UTIL_H__
+#define __PERFORMANCE_TEST_UTIL_H__
+
+#include "testing/testing.h"
+
+#include <functional>
+
+struct Main;
+struct Mesh;
+struct Scene;
+
+/* Run `func` the given number of times and report the average and best time, on stdout and in
+ * the JSON file given with `--perf-output`. When given, `cleanup` runs after every run, outside
+ * of the timing. Results are named after the current test and `name`. */
+void perf_measure(const char *name,
+                  const int runs,
+                  const std::function<void()> &func,
+                  const std::function<void()> &cleanup = nullptr);
+
+/* Grid of size * size quads in the XY plane, with a wave along Z so the normals differ. The mesh
+ * is not in `Main`, free with `BKE_id_free(NULL, me)`. */
+struct Mesh *perf_grid_mesh_create(const int size);
+
+/* Synthetic rig: chains of parented empties, where every empty drives a hook modifier on a grid
+ * mesh of its chain. Returns the scene, its default view layer contains all objects. */
+struct Scene *perf_rig_scene_create(struct Main *bmain,
+                                    const int chains_len,
+                                    const int chain_length,
+                                    const int grid_size);
+
+/* Test case for kernels that only need the task scheduler. */
+class PerformanceTest : public testing::Test {
+ public:
+  static void SetUpTestCase();
+  static void TearDownTestCase();
+};
+
+#endif /* __PERFORMANCE_TEST_UTIL_H__ */